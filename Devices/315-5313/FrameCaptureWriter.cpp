@@ -0,0 +1,296 @@
+#include "FrameCaptureWriter.h"
+#include <functional>
+#include <thread>
+#include <chrono>
+#include <sstream>
+#include <cstring>
+
+//----------------------------------------------------------------------------------------------------------------------
+// Constructors
+//----------------------------------------------------------------------------------------------------------------------
+FrameCaptureWriter::FrameCaptureWriter()
+:_open(false), _outputFormat(OutputFormat::Y4M), _outputStream(0), _frameRateNumerator(0), _frameRateDenominator(1), _streamHeaderWritten(false), _streamImageWidth(0), _streamImageHeight(0), _writtenFrameCount(0), _frameBufferWriteCount(0), _frameBufferReadCount(0), _droppedFrameCount(0), _workerThreadActive(false), _workerThreadRunning(false)
+{
+	// Allocate the frame buffer ring up front at the maximum frame size, so that no
+	// allocation is required when frames are received.
+	_frameBuffer.resize(FrameBufferEntryCount);
+	for (unsigned int i = 0; i < FrameBufferEntryCount; ++i)
+	{
+		_frameBuffer[i].frameNo = 0;
+		_frameBuffer[i].imageWidth = 0;
+		_frameBuffer[i].imageHeight = 0;
+		_frameBuffer[i].imageData.resize(MaxFrameWidth * MaxFrameHeight * 4);
+	}
+	_outputRowBuffer.resize(MaxFrameWidth * 3);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+FrameCaptureWriter::~FrameCaptureWriter()
+{
+	Close();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Capture functions
+//----------------------------------------------------------------------------------------------------------------------
+bool FrameCaptureWriter::Open(Stream::IStream& outputStream, OutputFormat outputFormat, unsigned int frameRateNumerator, unsigned int frameRateDenominator)
+{
+	// Close any currently open output
+	Close();
+
+	// Since each frame of an image sequence is written to a separate file, image
+	// sequences can't be written to a single target stream.
+	if (outputFormat == OutputFormat::PNG)
+	{
+		return false;
+	}
+
+	// Begin writing the stream to the target
+	StartCapture(&outputStream, outputFormat, frameRateNumerator, frameRateDenominator);
+	return true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void FrameCaptureWriter::StartCapture(Stream::IStream* outputStream, OutputFormat outputFormat, unsigned int frameRateNumerator, unsigned int frameRateDenominator)
+{
+	// Reset the capture state
+	_outputStream = outputStream;
+	_outputFormat = outputFormat;
+	_frameRateNumerator = frameRateNumerator;
+	_frameRateDenominator = frameRateDenominator;
+	_streamHeaderWritten = false;
+	_streamImageWidth = 0;
+	_streamImageHeight = 0;
+	_writtenFrameCount = 0;
+	_frameBufferWriteCount = 0;
+	_frameBufferReadCount = 0;
+	_droppedFrameCount = 0;
+	_open = true;
+
+	// Start the worker thread
+	_workerThreadActive = true;
+	_workerThreadRunning = true;
+	std::thread workerThread(std::bind(std::mem_fn(&FrameCaptureWriter::WorkerThread), this));
+	workerThread.detach();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void FrameCaptureWriter::Close()
+{
+	// Stop the worker thread, and wait for it to terminate. The worker thread writes out
+	// any frames remaining in the ring before it terminates.
+	std::unique_lock<std::mutex> lock(_workerThreadMutex);
+	if (_workerThreadActive)
+	{
+		_workerThreadActive = false;
+		_workerThreadUpdate.notify_all();
+	}
+	while (_workerThreadRunning)
+	{
+		_workerThreadStopped.wait(lock);
+	}
+
+	// Close the output file
+	if (_open)
+	{
+		if (_outputFile.IsOpen())
+		{
+			_outputFile.Close();
+		}
+		_outputStream = 0;
+		_imageFrameWriter = nullptr;
+		_open = false;
+	}
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool FrameCaptureWriter::IsOpen() const
+{
+	return _open;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+unsigned int FrameCaptureWriter::GetWrittenFrameCount() const
+{
+	return _writtenFrameCount.load(std::memory_order_relaxed);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+unsigned int FrameCaptureWriter::GetDroppedFrameCount() const
+{
+	return _droppedFrameCount.load(std::memory_order_relaxed);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Frame functions
+//----------------------------------------------------------------------------------------------------------------------
+void FrameCaptureWriter::FrameCompleted(const FrameInfo& frameInfo)
+{
+	// If the ring is full, drop this frame. We never wait for the worker thread here,
+	// since we're being called from the render thread of the device.
+	unsigned int writeCount = _frameBufferWriteCount.load(std::memory_order_relaxed);
+	if ((writeCount - _frameBufferReadCount.load(std::memory_order_acquire)) >= FrameBufferEntryCount)
+	{
+		_droppedFrameCount.fetch_add(1, std::memory_order_relaxed);
+		return;
+	}
+
+	// Copy the active image area into the next free entry in the ring
+	FrameBufferEntry& entry = _frameBuffer[writeCount % FrameBufferEntryCount];
+	entry.frameNo = frameInfo.frameNo;
+	entry.imageWidth = (frameInfo.activeImageWidth < MaxFrameWidth)? frameInfo.activeImageWidth: MaxFrameWidth;
+	entry.imageHeight = (frameInfo.activeImageHeight < MaxFrameHeight)? frameInfo.activeImageHeight: MaxFrameHeight;
+	unsigned int rowByteSize = entry.imageWidth * 4;
+	for (unsigned int ypos = 0; ypos < entry.imageHeight; ++ypos)
+	{
+		memcpy(&entry.imageData[ypos * rowByteSize], frameInfo.imageData + (ypos * frameInfo.imageDataStride), rowByteSize);
+	}
+
+	// Publish the new entry to the worker thread. Note that we notify the worker thread
+	// without obtaining its lock, so that we can never block here. If the notification is
+	// missed because the worker thread is between checking the ring and going to sleep,
+	// it'll pick up the frame when its wait times out.
+	_frameBufferWriteCount.store(writeCount + 1, std::memory_order_release);
+	_workerThreadUpdate.notify_one();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Worker thread functions
+//----------------------------------------------------------------------------------------------------------------------
+void FrameCaptureWriter::WorkerThread()
+{
+	std::unique_lock<std::mutex> lock(_workerThreadMutex);
+	bool done = false;
+	while (!done)
+	{
+		// Latch whether we've been asked to stop before we drain the ring, so that all
+		// frames received before Close was called are written out before we terminate.
+		done = !_workerThreadActive;
+
+		// Write out each frame which is currently waiting in the ring. We release our lock
+		// while writing, since writing out a frame can take some time, and the lock is only
+		// required to coordinate stopping this thread with Close.
+		lock.unlock();
+		unsigned int readCount = _frameBufferReadCount.load(std::memory_order_relaxed);
+		while (readCount != _frameBufferWriteCount.load(std::memory_order_acquire))
+		{
+			if (WriteFrame(_frameBuffer[readCount % FrameBufferEntryCount]))
+			{
+				_writtenFrameCount.fetch_add(1, std::memory_order_relaxed);
+			}
+			else
+			{
+				_droppedFrameCount.fetch_add(1, std::memory_order_relaxed);
+			}
+			++readCount;
+			_frameBufferReadCount.store(readCount, std::memory_order_release);
+		}
+		lock.lock();
+
+		// Wait for another frame to be received
+		if (!done && _workerThreadActive)
+		{
+			_workerThreadUpdate.wait_for(lock, std::chrono::milliseconds(WorkerThreadWakeIntervalInMilliseconds));
+		}
+	}
+	_workerThreadRunning = false;
+	_workerThreadStopped.notify_all();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Output functions
+//----------------------------------------------------------------------------------------------------------------------
+bool FrameCaptureWriter::WriteFrame(const FrameBufferEntry& entry)
+{
+	switch (_outputFormat)
+	{
+	case OutputFormat::Y4M:
+		return WriteY4MFrame(entry);
+	case OutputFormat::RGB:
+		return WriteRGBFrame(entry);
+	case OutputFormat::PNG:
+		return _imageFrameWriter && _imageFrameWriter(entry);
+	}
+	return false;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void FrameCaptureWriter::LatchStreamFrameSize(const FrameBufferEntry& entry)
+{
+	// The frame size of the stream is fixed by the first frame we receive, but is never
+	// smaller than the largest active image the VDP can output, so that frames received
+	// after a change to the screen mode still fit within the stream frame.
+	_streamImageWidth = (entry.imageWidth > MinStreamFrameWidth)? entry.imageWidth: MinStreamFrameWidth;
+	_streamImageHeight = (entry.imageHeight > MinStreamFrameHeight)? entry.imageHeight: MinStreamFrameHeight;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool FrameCaptureWriter::WriteY4MFrame(const FrameBufferEntry& entry)
+{
+	// Write the stream header if this is the first frame
+	if (!_streamHeaderWritten)
+	{
+		LatchStreamFrameSize(entry);
+		std::stringstream header;
+		header << "YUV4MPEG2 W" << _streamImageWidth << " H" << _streamImageHeight << " F" << _frameRateNumerator << ':' << _frameRateDenominator << " Ip A1:1 C444 XCOLORRANGE=FULL\n";
+		std::string headerString = header.str();
+		_outputStream->WriteData(headerString.c_str(), (Stream::IStream::SizeType)headerString.size());
+		_streamHeaderWritten = true;
+	}
+
+	// Write the frame header
+	const std::string frameHeader = "FRAME\n";
+	_outputStream->WriteData(frameHeader.c_str(), (Stream::IStream::SizeType)frameHeader.size());
+
+	// Convert the frame to full range BT.601 YCbCr, and write out the Y, Cb, and Cr planes
+	// in turn. The conversion is performed in 16.16 fixed point. Any area of the stream
+	// frame outside the image is converted from black.
+	const unsigned char blackPixelData[4] = {0, 0, 0, 0};
+	const unsigned int planeCount = 3;
+	const int planeCoefficients[planeCount][3] = {{19595, 38470, 7471}, {-11059, -21709, 32768}, {32768, -27439, -5329}};
+	const int planeOffsets[planeCount] = {0, 128 << 16, 128 << 16};
+	bool result = true;
+	for (unsigned int planeNo = 0; planeNo < planeCount; ++planeNo)
+	{
+		for (unsigned int ypos = 0; ypos < _streamImageHeight; ++ypos)
+		{
+			const unsigned char* rowData = (ypos < entry.imageHeight)? &entry.imageData[ypos * entry.imageWidth * 4]: 0;
+			for (unsigned int xpos = 0; xpos < _streamImageWidth; ++xpos)
+			{
+				const unsigned char* pixelData = ((rowData != 0) && (xpos < entry.imageWidth))? rowData + (xpos * 4): blackPixelData;
+				int value = ((planeCoefficients[planeNo][0] * (int)pixelData[0]) + (planeCoefficients[planeNo][1] * (int)pixelData[1]) + (planeCoefficients[planeNo][2] * (int)pixelData[2]) + planeOffsets[planeNo] + (1 << 15)) >> 16;
+				_outputRowBuffer[xpos] = (unsigned char)((value < 0)? 0: ((value > 0xFF)? 0xFF: value));
+			}
+			result &= _outputStream->WriteData(&_outputRowBuffer[0], _streamImageWidth);
+		}
+	}
+	return result;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool FrameCaptureWriter::WriteRGBFrame(const FrameBufferEntry& entry)
+{
+	// Latch the frame size of the stream if this is the first frame
+	if (!_streamHeaderWritten)
+	{
+		LatchStreamFrameSize(entry);
+		_streamHeaderWritten = true;
+	}
+
+	// Write out the frame as packed 24-bit RGB data. Any area of the stream frame outside
+	// the image is filled with black.
+	bool result = true;
+	for (unsigned int ypos = 0; ypos < _streamImageHeight; ++ypos)
+	{
+		const unsigned char* rowData = (ypos < entry.imageHeight)? &entry.imageData[ypos * entry.imageWidth * 4]: 0;
+		for (unsigned int xpos = 0; xpos < _streamImageWidth; ++xpos)
+		{
+			bool pixelInImage = (rowData != 0) && (xpos < entry.imageWidth);
+			_outputRowBuffer[(xpos * 3) + 0] = pixelInImage? rowData[(xpos * 4) + 0]: 0;
+			_outputRowBuffer[(xpos * 3) + 1] = pixelInImage? rowData[(xpos * 4) + 1]: 0;
+			_outputRowBuffer[(xpos * 3) + 2] = pixelInImage? rowData[(xpos * 4) + 2]: 0;
+		}
+		result &= _outputStream->WriteData(&_outputRowBuffer[0], _streamImageWidth * 3);
+	}
+	return result;
+}
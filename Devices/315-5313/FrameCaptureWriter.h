@@ -0,0 +1,115 @@
+#ifndef __FRAMECAPTUREWRITER_H__
+#define __FRAMECAPTUREWRITER_H__
+#include "IS315_5313FrameSink.h"
+#include "Stream/Stream.pkg"
+#include <string>
+#include <vector>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+
+// This frame sink writes each frame it receives to a file in a lossless format. The output
+// format is selected based on the extension of the target file path:
+// -y4m: A YUV4MPEG2 stream using 4:4:4 chroma sampling, suitable for input to most video
+// encoders.
+// -rgb: A headerless stream of packed 24-bit RGB frames.
+// -png: A sequence of separate PNG images, with the frame number appended to the name of
+// each file.
+// For the stream formats, the frame size of the stream is fixed when the first frame is
+// written, as the larger of the size of that frame and the largest active image size the
+// VDP can output. Since the active image size changes whenever the game changes the
+// screen mode, each frame is written at the top-left of the stream frame, with any
+// remaining area filled with black, so that no frames are lost on a mode change.
+//
+// Stream formats can also be written to any caller supplied stream rather than a file.
+// The image sequence format requires a target file path, and is only available through
+// the file based Open function.
+//
+// Frames are copied into a fixed ring of preallocated buffers by FrameCompleted, and
+// written out by a separate worker thread. If the worker thread falls behind and the ring
+// is full, incoming frames are dropped rather than stalling the caller, and the number of
+// dropped frames is recorded.
+class FrameCaptureWriter :public IS315_5313FrameSink
+{
+public:
+	// Enumerations
+	enum class OutputFormat;
+
+	// Structures
+	struct FrameBufferEntry;
+
+public:
+	// Constructors
+	FrameCaptureWriter();
+	virtual ~FrameCaptureWriter();
+
+	// Capture functions
+	bool Open(const std::wstring& filePath, unsigned int frameRateNumerator, unsigned int frameRateDenominator);
+	bool Open(Stream::IStream& outputStream, OutputFormat outputFormat, unsigned int frameRateNumerator, unsigned int frameRateDenominator);
+	void Close();
+	bool IsOpen() const;
+	unsigned int GetWrittenFrameCount() const;
+	unsigned int GetDroppedFrameCount() const;
+	static OutputFormat GetOutputFormatForFilePath(const std::wstring& filePath);
+
+	// Frame functions
+	virtual void FrameCompleted(const FrameInfo& frameInfo);
+
+private:
+	// Constants
+	static const unsigned int FrameBufferEntryCount = 8;
+	static const unsigned int MaxFrameWidth = 512;
+	static const unsigned int MaxFrameHeight = 512;
+	static const unsigned int MinStreamFrameWidth = 320;
+	static const unsigned int MinStreamFrameHeight = 240;
+	static const unsigned int WorkerThreadWakeIntervalInMilliseconds = 20;
+
+private:
+	// Capture functions
+	void StartCapture(Stream::IStream* outputStream, OutputFormat outputFormat, unsigned int frameRateNumerator, unsigned int frameRateDenominator);
+
+	// Worker thread functions
+	void WorkerThread();
+
+	// Output functions
+	bool WriteFrame(const FrameBufferEntry& entry);
+	void LatchStreamFrameSize(const FrameBufferEntry& entry);
+	bool WriteY4MFrame(const FrameBufferEntry& entry);
+	bool WriteRGBFrame(const FrameBufferEntry& entry);
+	bool WritePNGFrame(const FrameBufferEntry& entry);
+
+private:
+	// Output file state
+	bool _open;
+	OutputFormat _outputFormat;
+	std::wstring _filePath;
+	Stream::File _outputFile;
+	Stream::IStream* _outputStream;
+	std::function<bool(const FrameBufferEntry&)> _imageFrameWriter;
+	unsigned int _frameRateNumerator;
+	unsigned int _frameRateDenominator;
+	bool _streamHeaderWritten;
+	unsigned int _streamImageWidth;
+	unsigned int _streamImageHeight;
+	std::vector<unsigned char> _outputRowBuffer;
+	std::atomic<unsigned int> _writtenFrameCount;
+
+	// Frame buffer ring. The caller of FrameCompleted is the only writer of
+	// _frameBufferWriteCount, and the worker thread is the only writer of
+	// _frameBufferReadCount, so no lock is required to hand off entries.
+	std::vector<FrameBufferEntry> _frameBuffer;
+	std::atomic<unsigned int> _frameBufferWriteCount;
+	std::atomic<unsigned int> _frameBufferReadCount;
+	std::atomic<unsigned int> _droppedFrameCount;
+
+	// Worker thread state
+	std::mutex _workerThreadMutex;
+	std::condition_variable _workerThreadUpdate;
+	std::condition_variable _workerThreadStopped;
+	volatile bool _workerThreadActive;
+	volatile bool _workerThreadRunning;
+};
+
+#include "FrameCaptureWriter.inl"
+#endif
@@ -0,0 +1,20 @@
+//----------------------------------------------------------------------------------------------------------------------
+// Enumerations
+//----------------------------------------------------------------------------------------------------------------------
+enum class FrameCaptureWriter::OutputFormat
+{
+	Y4M,
+	RGB,
+	PNG
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+// Structures
+//----------------------------------------------------------------------------------------------------------------------
+struct FrameCaptureWriter::FrameBufferEntry
+{
+	unsigned int frameNo;
+	unsigned int imageWidth;
+	unsigned int imageHeight;
+	std::vector<unsigned char> imageData;
+};
@@ -0,0 +1,83 @@
+#include "FrameCaptureWriter.h"
+#include "Image/Image.pkg"
+#include "WindowsSupport/WindowsSupport.pkg"
+#include "DataConversion/DataConversion.pkg"
+#include <functional>
+#include <sstream>
+#include <iomanip>
+
+//----------------------------------------------------------------------------------------------------------------------
+// Capture functions
+//----------------------------------------------------------------------------------------------------------------------
+bool FrameCaptureWriter::Open(const std::wstring& filePath, unsigned int frameRateNumerator, unsigned int frameRateDenominator)
+{
+	// Close any currently open output
+	Close();
+
+	// If we're writing a PNG image sequence, each frame is written to a separate file as
+	// it is received, so there's no file to open here.
+	OutputFormat outputFormat = GetOutputFormatForFilePath(filePath);
+	_filePath = filePath;
+	if (outputFormat == OutputFormat::PNG)
+	{
+		_imageFrameWriter = std::bind(std::mem_fn(&FrameCaptureWriter::WritePNGFrame), this, std::placeholders::_1);
+		StartCapture(0, outputFormat, frameRateNumerator, frameRateDenominator);
+		return true;
+	}
+
+	// Open the target output file, and begin writing the stream to it
+	if (!_outputFile.Open(filePath, Stream::File::OpenMode::WriteOnly, Stream::File::CreateMode::Create))
+	{
+		return false;
+	}
+	StartCapture(&_outputFile, outputFormat, frameRateNumerator, frameRateDenominator);
+	return true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+FrameCaptureWriter::OutputFormat FrameCaptureWriter::GetOutputFormatForFilePath(const std::wstring& filePath)
+{
+	std::wstring fileExtension = StringToLower(PathGetFileExtension(filePath));
+	if (fileExtension == L"png")
+	{
+		return OutputFormat::PNG;
+	}
+	else if (fileExtension == L"rgb")
+	{
+		return OutputFormat::RGB;
+	}
+	return OutputFormat::Y4M;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Output functions
+//----------------------------------------------------------------------------------------------------------------------
+bool FrameCaptureWriter::WritePNGFrame(const FrameBufferEntry& entry)
+{
+	// Build the path for this frame by appending the frame number to the target path
+	std::wstring fileExtension = PathGetFileExtension(_filePath);
+	std::wstring filePathBase = fileExtension.empty()? _filePath: _filePath.substr(0, _filePath.size() - (fileExtension.size() + 1));
+	std::wstringstream framePath;
+	framePath << filePathBase << L" - " << std::setw(6) << std::setfill(L'0') << entry.frameNo << L".png";
+
+	// Build an image from the frame data
+	Image image(entry.imageWidth, entry.imageHeight, IImage::PIXELFORMAT_RGB, IImage::DATAFORMAT_8BIT);
+	for (unsigned int ypos = 0; ypos < entry.imageHeight; ++ypos)
+	{
+		const unsigned char* rowData = &entry.imageData[ypos * entry.imageWidth * 4];
+		for (unsigned int xpos = 0; xpos < entry.imageWidth; ++xpos)
+		{
+			image.WritePixelData(xpos, ypos, 0, rowData[(xpos * 4) + 0]);
+			image.WritePixelData(xpos, ypos, 1, rowData[(xpos * 4) + 1]);
+			image.WritePixelData(xpos, ypos, 2, rowData[(xpos * 4) + 2]);
+		}
+	}
+
+	// Save the image to the target file
+	Stream::File file;
+	if (!file.Open(framePath.str(), Stream::File::OpenMode::WriteOnly, Stream::File::CreateMode::Create))
+	{
+		return false;
+	}
+	return image.SavePNGImage(file);
+}
@@ -4,6 +4,7 @@
 #include "DeviceInterface/DeviceInterface.pkg"
 #include "TimedBuffers/TimedBuffers.pkg"
 #include "MarshalSupport/MarshalSupport.pkg"
+#include "IS315_5313FrameSink.h"
 #include <list>
 using namespace MarshalSupport::Operators;
 
@@ -39,7 +40,7 @@ public:
 
 public:
 	// Interface version functions
-	static inline unsigned int ThisIS315_5313Version() { return 1; }
+	static inline unsigned int ThisIS315_5313Version() { return 2; }
 	virtual unsigned int GetIS315_5313Version() const = 0;
 
 	// Device access functions
@@ -57,8 +58,6 @@ public:
 	virtual unsigned int GetImageLastRenderedFrameToken() const = 0;
 	virtual unsigned int GetImageCompletedBufferPlaneNo() const = 0;
 	virtual unsigned int GetImageDrawingBufferPlaneNo() const = 0;
-	virtual void LockImageBufferData(unsigned int planeNo) = 0;
-	virtual void UnlockImageBufferData(unsigned int planeNo) = 0;
 	virtual const unsigned char* GetImageBufferData(unsigned int planeNo) const = 0;
 	virtual const ImageBufferInfo* GetImageBufferInfo(unsigned int planeNo) const = 0;
 	virtual const ImageBufferInfo* GetImageBufferInfo(unsigned int planeNo, unsigned int lineNo, unsigned int pixelNo) const = 0;
@@ -99,6 +98,14 @@ public:
 	virtual unsigned int GetPortMonitorLogLastModifiedToken() const = 0;
 	virtual void ClearPortMonitorLog() = 0;
 
+	// Frame sink functions
+	virtual void AddFrameSink(IS315_5313FrameSink& frameSink, unsigned int frameInterval) = 0;
+	virtual void RemoveFrameSink(IS315_5313FrameSink& frameSink) = 0;
+
+	// Image buffer locking functions
+	virtual unsigned int LockCompletedImageBufferPlane() const = 0;
+	virtual void UnlockImageBufferPlane(unsigned int planeNo) const = 0;
+
 	// Debug output
 	inline bool GetOutputPortAccessDebugMessages() const;
 	inline void SetOutputPortAccessDebugMessages(bool data);
@@ -139,6 +146,14 @@ public:
 	inline bool GetGensKModDebuggingEnabled() const;
 	inline void SetGensKModDebuggingEnabled(bool data);
 
+	// Video capture
+	inline bool GetVideoCaptureEnabled() const;
+	inline void SetVideoCaptureEnabled(bool data);
+	inline std::wstring GetVideoCapturePath() const;
+	inline void SetVideoCapturePath(const std::wstring& data);
+	inline unsigned int GetVideoCaptureFrameInterval() const;
+	inline void SetVideoCaptureFrameInterval(unsigned int data);
+
 	// Layer removal
 	inline bool GetEnableLayerA() const;
 	inline void SetEnableLayerA(bool data);
@@ -147,6 +147,9 @@ enum class IS315_5313::IS315_5313DataSource
 	SettingsVideoEnableSpriteHigh,
 	SettingsVideoEnableSpriteLow,
 	SettingsGensKModDebuggingEnabled,
+	SettingsVideoCaptureEnabled,
+	SettingsVideoCapturePath,
+	SettingsVideoCaptureFrameInterval,
 };
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -578,6 +581,53 @@ void IS315_5313::SetGensKModDebuggingEnabled(bool data)
 	WriteGenericData((unsigned int)IS315_5313DataSource::SettingsGensKModDebuggingEnabled, 0, genericData);
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+// Video capture
+//----------------------------------------------------------------------------------------------------------------------
+bool IS315_5313::GetVideoCaptureEnabled() const
+{
+	GenericAccessDataValueBool genericData;
+	ReadGenericData((unsigned int)IS315_5313DataSource::SettingsVideoCaptureEnabled, 0, genericData);
+	return genericData.GetValue();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void IS315_5313::SetVideoCaptureEnabled(bool data)
+{
+	GenericAccessDataValueBool genericData(data);
+	WriteGenericData((unsigned int)IS315_5313DataSource::SettingsVideoCaptureEnabled, 0, genericData);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+std::wstring IS315_5313::GetVideoCapturePath() const
+{
+	GenericAccessDataValueFilePath genericData;
+	ReadGenericData((unsigned int)IS315_5313DataSource::SettingsVideoCapturePath, 0, genericData);
+	return genericData.GetValue();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void IS315_5313::SetVideoCapturePath(const std::wstring& data)
+{
+	GenericAccessDataValueFilePath genericData(data);
+	WriteGenericData((unsigned int)IS315_5313DataSource::SettingsVideoCapturePath, 0, genericData);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+unsigned int IS315_5313::GetVideoCaptureFrameInterval() const
+{
+	GenericAccessDataValueUInt genericData;
+	ReadGenericData((unsigned int)IS315_5313DataSource::SettingsVideoCaptureFrameInterval, 0, genericData);
+	return genericData.GetValue();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void IS315_5313::SetVideoCaptureFrameInterval(unsigned int data)
+{
+	GenericAccessDataValueUInt genericData(data);
+	WriteGenericData((unsigned int)IS315_5313DataSource::SettingsVideoCaptureFrameInterval, 0, genericData);
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 // Layer removal
 //----------------------------------------------------------------------------------------------------------------------
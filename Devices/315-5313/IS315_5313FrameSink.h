@@ -0,0 +1,26 @@
+#ifndef __IS315_5313FRAMESINK_H__
+#define __IS315_5313FRAMESINK_H__
+
+// This interface allows an external object to receive each frame completed by the VDP.
+// Frames are delivered from the render thread of the VDP at the point the frame is
+// completed, so implementations must return promptly without waiting on any other
+// thread. Any lengthy processing of the frame data, such as compression or file output,
+// should be deferred to another thread. The image data passed to FrameCompleted is only
+// valid until the call returns.
+class IS315_5313FrameSink
+{
+public:
+	// Structures
+	struct FrameInfo;
+
+public:
+	// Constructors
+	inline virtual ~IS315_5313FrameSink() = 0;
+
+	// Frame functions
+	virtual void FrameCompleted(const FrameInfo& frameInfo) = 0;
+};
+IS315_5313FrameSink::~IS315_5313FrameSink() { }
+
+#include "IS315_5313FrameSink.inl"
+#endif
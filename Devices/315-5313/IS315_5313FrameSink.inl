@@ -0,0 +1,21 @@
+//----------------------------------------------------------------------------------------------------------------------
+// Structures
+//----------------------------------------------------------------------------------------------------------------------
+struct IS315_5313FrameSink::FrameInfo
+{
+	// The number of the frame since the sink was added, counting every frame completed
+	// by the VDP, whether or not it was delivered to this sink.
+	unsigned int frameNo;
+
+	// The image data for the frame in 8-bit RGBA format, starting at the top-left pixel
+	// of the active display area. Each row is imageDataStride bytes apart.
+	const unsigned char* imageData;
+	unsigned int imageDataStride;
+
+	// The size in pixels of the active display area of the frame
+	unsigned int activeImageWidth;
+	unsigned int activeImageHeight;
+
+	// The odd interlace frame flag for this frame
+	bool oddInterlaceFrame;
+};
@@ -48,6 +48,8 @@ _renderPatternDataCacheLayerB(maxCellsPerRow, Data(32)),
 _renderPatternDataCacheRowNoLayerA(maxCellsPerRow, 0),
 _renderPatternDataCacheRowNoLayerB(maxCellsPerRow, 0),
 _renderSpriteDisplayCache(maxSpriteDisplayCacheSize),
+_renderSpriteCacheDecode(spriteCacheDecodeEntryCount),
+_renderSpriteCacheDecodeGeneration(1),
 _renderSpriteDisplayCellCache(maxSpriteDisplayCellCacheSize)
 {
 	_fifoBuffer.resize(FifoBufferSize);
@@ -89,9 +91,12 @@ _renderSpriteDisplayCellCache(maxSpriteDisplayCellCacheSize)
 	// initialization the first time the system is booted.
 	_renderThreadActive = false;
 	_drawingImageBufferPlane = 0;
+	_completedImageBufferPlane = ImageBufferPlanes - 1;
 	_lastRenderedFrameToken = 0;
 	for (unsigned int bufferPlaneNo = 0; bufferPlaneNo < ImageBufferPlanes; ++bufferPlaneNo)
 	{
+		_imageBufferPlaneReaderCount[bufferPlaneNo] = 0;
+		_imageBufferOddInterlaceFrame[bufferPlaneNo] = false;
 		_imageBufferLineCount[bufferPlaneNo] = 0;
 		for (unsigned int lineNo = 0; lineNo < ImageBufferHeight; ++lineNo)
 		{
@@ -138,6 +143,10 @@ _renderSpriteDisplayCellCache(maxSpriteDisplayCellCacheSize)
 	_enableSpriteHigh = true;
 	_enableSpriteLow = true;
 
+	_videoCaptureEnabled = false;
+	_videoCaptureFrameInterval = 1;
+	_frameSinksPresent = false;
+
 	_gensKmodDebugActive = false;
 	_gensKmodIgnoreNextDebugStop = false;
 	_gensKmodDebugTimerRunning = false;
@@ -202,6 +211,13 @@ bool S315_5313::BuildDevice()
 		_layerPriorityLookupTable[i] = layerIndex;
 	}
 
+	// Initialize the video capture state
+	std::wstring captureFolder = GetSystemInterface().GetCapturePath();
+	_videoCaptureEnabled = false;
+	_videoCapturePath = PathCombinePaths(captureFolder, GetDeviceInstanceName() + L".y4m");
+	std::wstring videoCaptureExtensionFilter = L"YUV4MPEG2 video|y4m;Raw RGB video|rgb;PNG image sequence|png";
+	std::wstring videoCaptureDefaultExtension = L"y4m";
+
 	// Register each data source with the generic data access base class
 	bool result = true;
 	result &= AddGenericDataInfo((new GenericAccessDataInfo(IS315_5313DataSource::SettingsVideoSingleBuffering, IGenericAccessDataValue::DataType::Bool)));
@@ -232,6 +248,9 @@ bool S315_5313::BuildDevice()
 	result &= AddGenericDataInfo((new GenericAccessDataInfo(IS315_5313DataSource::SettingsVideoEnableSprite, IGenericAccessDataValue::DataType::Bool)));
 	result &= AddGenericDataInfo((new GenericAccessDataInfo(IS315_5313DataSource::SettingsVideoEnableSpriteHigh, IGenericAccessDataValue::DataType::Bool)));
 	result &= AddGenericDataInfo((new GenericAccessDataInfo(IS315_5313DataSource::SettingsVideoEnableSpriteLow, IGenericAccessDataValue::DataType::Bool)));
+	result &= AddGenericDataInfo((new GenericAccessDataInfo(IS315_5313DataSource::SettingsVideoCaptureEnabled, IGenericAccessDataValue::DataType::Bool)));
+	result &= AddGenericDataInfo((new GenericAccessDataInfo(IS315_5313DataSource::SettingsVideoCapturePath, IGenericAccessDataValue::DataType::FilePath))->SetFilePathExtensionFilter(videoCaptureExtensionFilter)->SetFilePathDefaultExtension(videoCaptureDefaultExtension)->SetFilePathCreatingTarget(true));
+	result &= AddGenericDataInfo((new GenericAccessDataInfo(IS315_5313DataSource::SettingsVideoCaptureFrameInterval, IGenericAccessDataValue::DataType::UInt))->SetUIntMinValue(1));
 
 	// Register page layouts for generic access to this device
 	GenericAccessPage* systemSettingsPage = new GenericAccessPage(L"SystemSettings", L"System Settings", IGenericAccessPage::Type::Settings);
@@ -276,6 +295,12 @@ bool S315_5313::BuildDevice()
 	                    ->AddEntry(new GenericAccessGroupDataEntry(IS315_5313DataSource::SettingsVideoEnableSpriteHigh, L"High Priority"))
 	                    ->AddEntry(new GenericAccessGroupDataEntry(IS315_5313DataSource::SettingsVideoEnableSpriteLow, L"Low Priority")));
 	result &= AddGenericAccessPage(layerRemovalPage);
+	GenericAccessPage* videoCapturePage = new GenericAccessPage(L"VideoCapture", L"Video Capture");
+	videoCapturePage->AddEntry((new GenericAccessGroup(L"Frame Capture"))
+	                    ->AddEntry(new GenericAccessGroupDataEntry(IS315_5313DataSource::SettingsVideoCaptureEnabled, L"Capture Enabled"))
+	                    ->AddEntry(new GenericAccessGroupDataEntry(IS315_5313DataSource::SettingsVideoCapturePath, L"Capture Path"))
+	                    ->AddEntry(new GenericAccessGroupDataEntry(IS315_5313DataSource::SettingsVideoCaptureFrameInterval, L"Frame Interval")));
+	result &= AddGenericAccessPage(videoCapturePage);
 
 	return result;
 }
@@ -491,6 +516,9 @@ void S315_5313::Initialize()
 	_lineCAS0SavedStateRMW = false;
 	_lineRAS0SavedStateRMW = false;
 	_lineOE0SavedStateRMW = false;
+
+	// Flag that our state has been reset for any debugger views
+	AllGenericDataModified();
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -1262,6 +1290,9 @@ void S315_5313::ExecuteRollback()
 			           << "*************************************************************\n";
 		}
 	}
+
+	// Flag that our state has been rolled back for any debugger views
+	AllGenericDataModified();
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -1477,6 +1508,9 @@ void S315_5313::ExecuteCommit()
 			           << "*************************************************************\n";
 		}
 	}
+
+	// Flag that our committed state may have changed for any debugger views
+	AllGenericDataModified();
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -1787,44 +1821,7 @@ void S315_5313::UpdateInternalState(unsigned int mclkCyclesTarget, bool checkFif
 		// Advance a DMA transfer operation while the write FIFO or read cache is not full,
 		// and there has been enough time since the read cache became empty to fully read
 		// another value from external memory.
-		//##TODO## We assume here that a read operation is performed immediately, whether
-		// there is room in the FIFO or not currently to save it, and that the data then
-		// gets held as pending until a FIFO slot opens up, at which time, the pending data
-		// write then gets moved into the FIFO, and a new read operation begins
-		// immediately. Do some hardware tests to confirm this is the way the real VDP
-		// behaves, and confirm the timing of everything.
-		//##FIX## This has been shown to be incorrect. When we do this, the refresh cycles
-		// in our frame are swallowed up by the caching operation. That said, we do know
-		// that DMA transfers use the FIFO, and we've observed DMA transfers to VRAM
-		// correctly filling the FIFO at the start of the operation. Wait, hang on a
-		// second, a write should take 4SC cycles, not 2. What's happening is that we're
-		// moving data out of the FIFO too quickly. Once a write has been allowed out of
-		// the FIFO, there's a 4SC cycle delay before another value can be released, or in
-		// other words, we need to skip the next hcounter location when an access slot has
-		// just been used. We need to emulate that when detecting the next access slot.
-		while (_commandCode.GetBit(5) && !_dmd1 && _busGranted && (!_dmaTransferReadDataCached || !IsWriteFIFOFull())
-		  && ((_dmaTransferNextReadMclk + (dmaTransferReadTimeInMclkCycles - _dmaTransferLastTimesliceUsedReadDelay)) <= GetProcessorStateMclkCurrent()))
-		{
-			// If there is space in the DMA transfer read cache, read a new data value into
-			// the read cache.
-			if (!_dmaTransferReadDataCached)
-			{
-				CacheDMATransferReadData(_dmaTransferNextReadMclk);
-			}
-
-			// Advance the dmaTransferLastReadMclk counter, and clear the count of used
-			// read delay cycles from the last timeslice, which have just been consumed.
-			_dmaTransferNextReadMclk += (dmaTransferReadTimeInMclkCycles - _dmaTransferLastTimesliceUsedReadDelay);
-			_dmaTransferLastTimesliceUsedReadDelay = 0;
-
-			// If there is space in the write FIFO to store another write value, empty the
-			// DMA transfer read cache data into the FIFO.
-			if (!IsWriteFIFOFull())
-			{
-				PerformDMATransferOperation();
-				AdvanceDMAState();
-			}
-		}
+		PerformDMATransferReadOperations(GetProcessorStateMclkCurrent());
 
 		// Advance a DMA fill operation if fill data has been latched to trigger the fill,
 		// and the write FIFO is empty. If a data port write has been made during an active
@@ -1832,14 +1829,14 @@ void S315_5313::UpdateInternalState(unsigned int mclkCyclesTarget, bool checkFif
 		// fill once the FIFO returns to an empty state.
 		if (_commandCode.GetBit(5) && _dmd1 && !_dmd0 && _dmaFillOperationRunning && IsWriteFIFOEmpty())
 		{
-			PerformDMAFillOperation();
+			PerformDMAFillOperation(GetProcessorStateMclkCurrent());
 			AdvanceDMAState();
 		}
 
 		// Advance a DMA copy operation
 		if (_commandCode.GetBit(5) && _dmd1 && _dmd0)
 		{
-			PerformDMACopyOperation();
+			PerformDMACopyOperation(GetProcessorStateMclkCurrent());
 			AdvanceDMAState();
 		}
 
@@ -1856,7 +1853,7 @@ void S315_5313::UpdateInternalState(unsigned int mclkCyclesTarget, bool checkFif
 		// Perform a VRAM write operation
 		if (!IsWriteFIFOEmpty() && !readOperationPerformed)
 		{
-			PerformFIFOWriteOperation();
+			PerformFIFOWriteOperation(GetProcessorStateMclkCurrent());
 		}
 
 		// If a DMA transfer operation is in progress, and there's a read value held in the
@@ -1874,6 +1871,16 @@ void S315_5313::UpdateInternalState(unsigned int mclkCyclesTarget, bool checkFif
 			AdvanceDMAState();
 		}
 
+		// If a DMA operation is in progress, and we haven't been asked to stop on a change
+		// in the FIFO or read cache state, run the operation forward through the following
+		// access slots on the current line as a single block. This avoids stepping the
+		// entire processor state forward one access slot at a time over the course of a
+		// long DMA operation.
+		if (!stopWhenFifoEmpty && !stopWhenFifoFull && !stopWhenFifoNotFull && !stopWhenReadDataAvailable)
+		{
+			AdvanceDMAOperationBlock(mclkCyclesTarget, allowAdvancePastCycleTarget);
+		}
+
 		// Update the FIFO full and empty flags in the status register
 		SetStatusFlagFIFOEmpty(IsWriteFIFOEmpty());
 		SetStatusFlagFIFOFull(IsWriteFIFOFull());
@@ -2334,6 +2341,140 @@ bool S315_5313::AdvanceProcessorState(unsigned int mclkCyclesTarget, bool stopAt
 	return !stoppedAtAccessSlot;
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+// This function advances a DMA operation through a block of access slots in a single
+// step. Since fill and copy operations work entirely within the VDP, once the write FIFO
+// is empty and no read operation is pending, the only thing which determines when each
+// step of the operation occurs is the location of the access slots themselves. We can
+// therefore calculate the position of each access slot directly from the current
+// hcounter position, and perform each fill or copy step at the MCLK time of its slot,
+// without advancing the rest of the processor state between each step. Once the block is
+// complete, the processor state is advanced to the last access slot which was used in a
+// single update step.
+//
+// DMA transfer operations are advanced in the same way. The external memory reads for a
+// transfer are timed independently of the access slots, so at each access slot in the
+// block we first perform any reads which have completed by the time of that slot, then
+// perform the FIFO write for the slot, then refill the FIFO from the read cache, exactly
+// as is done when the processor state is stepped to each access slot individually. Each
+// external memory read is still made at its own MCLK time, and each write is still
+// performed through the FIFO, so the result is the same, but the rest of the processor
+// state only needs to be advanced once per block.
+//
+// Note that the block is limited to the access slots which occur before the vcounter is
+// next incremented, since the access slot layout depends on whether the current line
+// lies within the active display region. The block is also not attempted if a change to
+// the horizontal screen mode settings is waiting to be latched, since the access slot
+// layout of the line will change when the new settings are applied. In these cases, the
+// caller advances the operation by individual access slots as normal. Returns true if at
+// least one step of the DMA operation was performed.
+//----------------------------------------------------------------------------------------------------------------------
+bool S315_5313::AdvanceDMAOperationBlock(unsigned int mclkCyclesTarget, bool allowAdvancePastCycleTarget)
+{
+	// Ensure that a DMA operation is the only work pending which requires an access slot.
+	// Fill and copy operations also require the write FIFO to be empty, while transfer
+	// operations perform their own FIFO writes as part of the block.
+	bool dmaFillOperationWillRun = _commandCode.GetBit(5) && _dmd1 && !_dmd0 && _dmaFillOperationRunning;
+	bool dmaCopyOperationWillRun = _commandCode.GetBit(5) && _dmd1 && _dmd0;
+	bool dmaTransferOperationWillRun = _commandCode.GetBit(5) && !_dmd1 && _busGranted;
+	if ((!dmaFillOperationWillRun && !dmaCopyOperationWillRun && !dmaTransferOperationWillRun) || (ValidReadTargetInCommandCode() && !_readDataAvailable))
+	{
+		return false;
+	}
+	if ((dmaFillOperationWillRun || dmaCopyOperationWillRun) && !IsWriteFIFOEmpty())
+	{
+		return false;
+	}
+
+	// If new horizontal screen mode settings are waiting to be latched, the access slot
+	// layout may change partway through this line, so we leave the caller to step through
+	// each access slot individually.
+	if ((_screenModeRS0 != _screenModeRS0Cached) || (_screenModeRS1 != _screenModeRS1Cached))
+	{
+		return false;
+	}
+
+	// Calculate the number of pixel clock ticks until the vcounter is next incremented.
+	// All access slots in this block must fall before this point.
+	const HScanSettings& hscanSettings = GetHScanSettings(_screenModeRS0, _screenModeRS1);
+	const VScanSettings& vscanSettings = GetVScanSettings(_screenModeV30, _palMode, _interlaceEnabled);
+	unsigned int hcounterInitial = _hcounter.GetData();
+	unsigned int vcounterInitial = _vcounter.GetData();
+	unsigned int pixelClockTicksBeforeVCounterIncrement = GetPixelClockStepsBetweenHCounterValues(hscanSettings, hcounterInitial, hscanSettings.vcounterIncrementPoint);
+
+	// Calculate the MCLK time the current pixel clock tick began at. Access slot times are
+	// calculated relative to this point.
+	unsigned int mclkTimeInitial = GetProcessorStateMclkCurrent() - _stateLastUpdateMclkUnused;
+
+	// Perform each step of the DMA operation at the time of its access slot, until the DMA
+	// operation is complete, or we reach the end of the block.
+	unsigned int pixelClockTicksAdvanced = 0;
+	unsigned int hcounterCurrent = hcounterInitial;
+	unsigned int lastAccessSlotMclkTime = 0;
+	bool dmaOperationAdvanced = false;
+	while (dmaFillOperationWillRun || dmaCopyOperationWillRun || dmaTransferOperationWillRun)
+	{
+		// Locate the next access slot, and stop if it lies outside this block.
+		unsigned int pixelClockTicksBeforeAccessSlot = pixelClockTicksAdvanced + GetPixelClockTicksUntilNextAccessSlot(hscanSettings, vscanSettings, hcounterCurrent, _screenModeRS0, _screenModeRS1, _displayEnabledCached, vcounterInitial);
+		if (pixelClockTicksBeforeAccessSlot >= pixelClockTicksBeforeVCounterIncrement)
+		{
+			break;
+		}
+		unsigned int accessSlotMclkTime = mclkTimeInitial + GetMclkTicksForPixelClockTicks(hscanSettings, pixelClockTicksBeforeAccessSlot, hcounterInitial, _screenModeRS0, _screenModeRS1);
+		if (!allowAdvancePastCycleTarget && (accessSlotMclkTime > mclkCyclesTarget))
+		{
+			break;
+		}
+		pixelClockTicksAdvanced = pixelClockTicksBeforeAccessSlot;
+		hcounterCurrent = AddStepsToHCounter(hscanSettings, hcounterInitial, pixelClockTicksAdvanced);
+
+		// Perform the next step of the DMA operation
+		if (dmaTransferOperationWillRun)
+		{
+			PerformDMATransferReadOperations(accessSlotMclkTime);
+			if (!IsWriteFIFOEmpty())
+			{
+				PerformFIFOWriteOperation(accessSlotMclkTime);
+			}
+			if (_commandCode.GetBit(5) && !_dmd1 && _dmaTransferReadDataCached && !IsWriteFIFOFull())
+			{
+				PerformDMATransferOperation();
+				AdvanceDMAState();
+			}
+		}
+		else
+		{
+			if (dmaFillOperationWillRun)
+			{
+				PerformDMAFillOperation(accessSlotMclkTime);
+			}
+			else
+			{
+				PerformDMACopyOperation(accessSlotMclkTime);
+			}
+			AdvanceDMAState();
+		}
+		lastAccessSlotMclkTime = accessSlotMclkTime;
+		dmaOperationAdvanced = true;
+
+		// Determine if the DMA operation is still running. Note that once a transfer
+		// operation completes, any data still held in the write FIFO is left for the
+		// caller to process at the following access slots as normal.
+		dmaFillOperationWillRun = dmaFillOperationWillRun && _commandCode.GetBit(5) && _dmaFillOperationRunning;
+		dmaCopyOperationWillRun = dmaCopyOperationWillRun && _commandCode.GetBit(5);
+		dmaTransferOperationWillRun = dmaTransferOperationWillRun && _commandCode.GetBit(5);
+	}
+
+	// Advance the processor state up to the last access slot we used. Since this is the
+	// exact MCLK time of an access slot, we'll end up with no unused MCLK cycles, which is
+	// the same state we'd be in if we'd stopped at each access slot individually.
+	if (dmaOperationAdvanced)
+	{
+		AdvanceProcessorState(lastAccessSlotMclkTime, false, false);
+	}
+	return dmaOperationAdvanced;
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 void S315_5313::PerformReadCacheOperation()
 {
@@ -2469,7 +2610,7 @@ void S315_5313::PerformReadCacheOperation()
 }
 
 //----------------------------------------------------------------------------------------------------------------------
-void S315_5313::PerformFIFOWriteOperation()
+void S315_5313::PerformFIFOWriteOperation(unsigned int mclkTime)
 {
 	//##TODO## Update all the comments here
 	FIFOBufferEntry& fifoBufferEntry = _fifoBuffer[_fifoNextReadEntry];
@@ -2494,7 +2635,7 @@ void S315_5313::PerformFIFOWriteOperation()
 	// All possible combinations of the code flags and data port writes have been tested
 	// on the hardware. Writes are decoded based on the lower 4 bits of the code data.
 	RAMAccessTarget ramAccessTarget;
-	ramAccessTarget.AccessTime(GetProcessorStateMclkCurrent());
+	ramAccessTarget.AccessTime(mclkTime);
 	switch (fifoBufferEntry.codeRegData.GetDataSegment(0, 4))
 	{
 	case 0x01:{ //??0001 VRAM Write
@@ -2600,19 +2741,18 @@ void S315_5313::PerformFIFOWriteOperation()
 		// read for the DMA transfer operation will start no sooner than this time.
 		if (_commandCode.GetBit(5) && !_dmd1 && _dmaTransferReadDataCached)
 		{
-			unsigned int processorStateMclkCurrent = GetProcessorStateMclkCurrent();
 			if (_dmaTransferLastTimesliceUsedReadDelay == 0)
 			{
-				_dmaTransferNextReadMclk = processorStateMclkCurrent;
+				_dmaTransferNextReadMclk = mclkTime;
 			}
-			else if (_dmaTransferLastTimesliceUsedReadDelay >= processorStateMclkCurrent)
+			else if (_dmaTransferLastTimesliceUsedReadDelay >= mclkTime)
 			{
 				_dmaTransferNextReadMclk = 0;
-				_dmaTransferLastTimesliceUsedReadDelay -= processorStateMclkCurrent;
+				_dmaTransferLastTimesliceUsedReadDelay -= mclkTime;
 			}
 			else
 			{
-				_dmaTransferNextReadMclk = (processorStateMclkCurrent - _dmaTransferLastTimesliceUsedReadDelay);
+				_dmaTransferNextReadMclk = (mclkTime - _dmaTransferLastTimesliceUsedReadDelay);
 				_dmaTransferLastTimesliceUsedReadDelay = 0;
 			}
 		}
@@ -2620,7 +2760,7 @@ void S315_5313::PerformFIFOWriteOperation()
 }
 
 //----------------------------------------------------------------------------------------------------------------------
-void S315_5313::PerformDMACopyOperation()
+void S315_5313::PerformDMACopyOperation(unsigned int mclkTime)
 {
 	// Get the current source address
 	unsigned int sourceAddress = (_dmaSourceAddressByte1) | (_dmaSourceAddressByte2 << 8);
@@ -2660,7 +2800,7 @@ void S315_5313::PerformDMACopyOperation()
 	// Perform the copy. Note that hardware tests have shown that DMA copy operations
 	// always target VRAM, regardless of the state of CD0-CD3.
 	RAMAccessTarget ramAccessTarget;
-	ramAccessTarget.AccessTime(GetProcessorStateMclkCurrent());
+	ramAccessTarget.AccessTime(mclkTime);
 	unsigned char data;
 	data = _vram->Read(sourceAddressByteswapped.GetData(), ramAccessTarget);
 	_vram->Write(targetAddressByteswapped.GetData(), data, ramAccessTarget);
@@ -2670,7 +2810,7 @@ void S315_5313::PerformDMACopyOperation()
 }
 
 //----------------------------------------------------------------------------------------------------------------------
-void S315_5313::PerformDMAFillOperation()
+void S315_5313::PerformDMAFillOperation(unsigned int mclkTime)
 {
 	//##FIX## We need to determine how the VDP knows a write has been made to the data
 	// port. VSRAM and CRAM fill targets grab the next available entry in the FIFO, after
@@ -2783,7 +2923,7 @@ void S315_5313::PerformDMAFillOperation()
 	//##TODO## Test on hardware to determine what happens when the data port is written to
 	// while a DMA fill operation is in progress.
 	RAMAccessTarget ramAccessTarget;
-	ramAccessTarget.AccessTime(GetProcessorStateMclkCurrent());
+	ramAccessTarget.AccessTime(mclkTime);
 	switch (_commandCode.GetDataSegment(0, 4))
 	{
 	case 0x01: //??0001 VRAM Write
@@ -2831,6 +2971,51 @@ void S315_5313::CacheDMATransferReadData(unsigned int mclkTime)
 	_dmaTransferReadDataCached = true;
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+void S315_5313::PerformDMATransferReadOperations(unsigned int mclkTime)
+{
+	// Perform each external memory read for the DMA transfer operation which completes
+	// by the target time, and load the data into the write FIFO while a slot is free.
+	//##TODO## We assume here that a read operation is performed immediately, whether
+	// there is room in the FIFO or not currently to save it, and that the data then
+	// gets held as pending until a FIFO slot opens up, at which time, the pending data
+	// write then gets moved into the FIFO, and a new read operation begins
+	// immediately. Do some hardware tests to confirm this is the way the real VDP
+	// behaves, and confirm the timing of everything.
+	//##FIX## This has been shown to be incorrect. When we do this, the refresh cycles
+	// in our frame are swallowed up by the caching operation. That said, we do know
+	// that DMA transfers use the FIFO, and we've observed DMA transfers to VRAM
+	// correctly filling the FIFO at the start of the operation. Wait, hang on a
+	// second, a write should take 4SC cycles, not 2. What's happening is that we're
+	// moving data out of the FIFO too quickly. Once a write has been allowed out of
+	// the FIFO, there's a 4SC cycle delay before another value can be released, or in
+	// other words, we need to skip the next hcounter location when an access slot has
+	// just been used. We need to emulate that when detecting the next access slot.
+	while (_commandCode.GetBit(5) && !_dmd1 && _busGranted && (!_dmaTransferReadDataCached || !IsWriteFIFOFull())
+	  && ((_dmaTransferNextReadMclk + (dmaTransferReadTimeInMclkCycles - _dmaTransferLastTimesliceUsedReadDelay)) <= mclkTime))
+	{
+		// If there is space in the DMA transfer read cache, read a new data value into
+		// the read cache.
+		if (!_dmaTransferReadDataCached)
+		{
+			CacheDMATransferReadData(_dmaTransferNextReadMclk);
+		}
+
+		// Advance the dmaTransferLastReadMclk counter, and clear the count of used
+		// read delay cycles from the last timeslice, which have just been consumed.
+		_dmaTransferNextReadMclk += (dmaTransferReadTimeInMclkCycles - _dmaTransferLastTimesliceUsedReadDelay);
+		_dmaTransferLastTimesliceUsedReadDelay = 0;
+
+		// If there is space in the write FIFO to store another write value, empty the
+		// DMA transfer read cache data into the FIFO.
+		if (!IsWriteFIFOFull())
+		{
+			PerformDMATransferOperation();
+			AdvanceDMAState();
+		}
+	}
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 void S315_5313::PerformDMATransferOperation()
 {
@@ -3192,11 +3377,9 @@ void S315_5313::M5WriteVSRAM(const Data& address, const Data& data, const RAMAcc
 //----------------------------------------------------------------------------------------------------------------------
 bool S315_5313::GetScreenshot(IImage& targetImage) const
 {
-	// Determine the index of the current image plane that is being used for display
-	unsigned int displayingImageBufferPlane = GetImageCompletedBufferPlaneNo();
-
-	// Obtain a read lock on the image buffer
-	_imageBufferLock[displayingImageBufferPlane].ObtainReadLock();
+	// Lock the most recently completed image plane, so that it can't be reused for
+	// drawing while we're reading from it.
+	unsigned int displayingImageBufferPlane = LockCompletedImageBufferPlane();
 
 	// Calculate the width and height of the output image. We take the line width of the
 	// first line as the width of the output image, but it should be noted that the width
@@ -3221,7 +3404,7 @@ bool S315_5313::GetScreenshot(IImage& targetImage) const
 			Image lineImage(lineWidth, 1, IImage::PIXELFORMAT_RGB, IImage::DATAFORMAT_8BIT);
 			for (unsigned int xpos = 0; xpos < lineWidth; ++xpos)
 			{
-				const ImageBufferColorEntry& imageBufferEntry = *((const ImageBufferColorEntry*)&_imageBuffer[_drawingImageBufferPlane][((ypos * ImageBufferWidth) + xpos) * 4]);
+				const ImageBufferColorEntry& imageBufferEntry = *((const ImageBufferColorEntry*)&_imageBuffer[displayingImageBufferPlane][((ypos * ImageBufferWidth) + xpos) * 4]);
 				lineImage.WritePixelData(xpos, 0, 0, imageBufferEntry.r);
 				lineImage.WritePixelData(xpos, 0, 1, imageBufferEntry.g);
 				lineImage.WritePixelData(xpos, 0, 2, imageBufferEntry.b);
@@ -3244,7 +3427,7 @@ bool S315_5313::GetScreenshot(IImage& targetImage) const
 		{
 			for (unsigned int xpos = 0; xpos < imageWidth; ++xpos)
 			{
-				const ImageBufferColorEntry& imageBufferEntry = *((const ImageBufferColorEntry*)&_imageBuffer[_drawingImageBufferPlane][((ypos * ImageBufferWidth) + xpos) * 4]);
+				const ImageBufferColorEntry& imageBufferEntry = *((const ImageBufferColorEntry*)&_imageBuffer[displayingImageBufferPlane][((ypos * ImageBufferWidth) + xpos) * 4]);
 				targetImage.WritePixelData(xpos, ypos, 0, imageBufferEntry.r);
 				targetImage.WritePixelData(xpos, ypos, 1, imageBufferEntry.g);
 				targetImage.WritePixelData(xpos, ypos, 2, imageBufferEntry.b);
@@ -3252,8 +3435,8 @@ bool S315_5313::GetScreenshot(IImage& targetImage) const
 		}
 	}
 
-	// Release the read lock on the image buffer
-	_imageBufferLock[displayingImageBufferPlane].ReleaseReadLock();
+	// Release our lock on the image buffer plane
+	UnlockImageBufferPlane(displayingImageBufferPlane);
 
 	return true;
 }
@@ -3502,6 +3685,9 @@ void S315_5313::LoadState(IHierarchicalStorageNode& node)
 	}
 
 	Device::LoadState(node);
+
+	// Flag that our state has been replaced for any debugger views
+	AllGenericDataModified();
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -4090,12 +4276,18 @@ bool S315_5313::ReadGenericData(unsigned int dataID, const DataContext* dataCont
 		return dataValue.SetValue(_enableSpriteHigh);
 	case IS315_5313DataSource::SettingsVideoEnableSpriteLow:
 		return dataValue.SetValue(_enableSpriteLow);
+	case IS315_5313DataSource::SettingsVideoCaptureEnabled:
+		return dataValue.SetValue(_videoCaptureEnabled);
+	case IS315_5313DataSource::SettingsVideoCapturePath:
+		return dataValue.SetValue(_videoCapturePath);
+	case IS315_5313DataSource::SettingsVideoCaptureFrameInterval:
+		return dataValue.SetValue(_videoCaptureFrameInterval);
 	}
 	return false;
 }
 
 //----------------------------------------------------------------------------------------------------------------------
-bool S315_5313::WriteGenericData(unsigned int dataID, const DataContext* dataContext, IGenericAccessDataValue& dataValue)
+bool S315_5313::WriteGenericDataInternal(unsigned int dataID, const DataContext* dataContext, IGenericAccessDataValue& dataValue)
 {
 	// Note that if you update this logic, you also need to update the corresponding logic
 	// in RegisterSpecialUpdateFunction and TransparentRegisterSpecialUpdateFunction.
@@ -4848,6 +5040,21 @@ bool S315_5313::WriteGenericData(unsigned int dataID, const DataContext* dataCon
 		IGenericAccessDataValueBool& dataValueAsBool = (IGenericAccessDataValueBool&)dataValue;
 		_enableSpriteLow = dataValueAsBool.GetValue();
 		return true;}
+	case IS315_5313DataSource::SettingsVideoCaptureEnabled:{
+		if (dataType != IGenericAccessDataValue::DataType::Bool) return false;
+		IGenericAccessDataValueBool& dataValueAsBool = (IGenericAccessDataValueBool&)dataValue;
+		SetVideoCaptureEnabled(dataValueAsBool.GetValue());
+		return true;}
+	case IS315_5313DataSource::SettingsVideoCapturePath:{
+		if (dataType != IGenericAccessDataValue::DataType::FilePath) return false;
+		IGenericAccessDataValueFilePath& dataValueAsFilePath = (IGenericAccessDataValueFilePath&)dataValue;
+		_videoCapturePath = dataValueAsFilePath.GetValue();
+		return true;}
+	case IS315_5313DataSource::SettingsVideoCaptureFrameInterval:{
+		if (dataType != IGenericAccessDataValue::DataType::UInt) return false;
+		IGenericAccessDataValueUInt& dataValueAsUInt = (IGenericAccessDataValueUInt&)dataValue;
+		_videoCaptureFrameInterval = (dataValueAsUInt.GetValue() > 0)? dataValueAsUInt.GetValue(): 1;
+		return true;}
 	}
 	return false;
 }
@@ -66,8 +66,7 @@ unsigned int S315_5313::GetImageLastRenderedFrameToken() const
 //----------------------------------------------------------------------------------------------------------------------
 unsigned int S315_5313::GetImageCompletedBufferPlaneNo() const
 {
-	unsigned int displayingImageBufferPlane = _videoSingleBuffering? _drawingImageBufferPlane: ((_drawingImageBufferPlane + ImageBufferPlanes) - 1) % ImageBufferPlanes;
-	return displayingImageBufferPlane;
+	return _completedImageBufferPlane.load(std::memory_order_acquire);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -77,15 +76,33 @@ unsigned int S315_5313::GetImageDrawingBufferPlaneNo() const
 }
 
 //----------------------------------------------------------------------------------------------------------------------
-void S315_5313::LockImageBufferData(unsigned int planeNo)
+unsigned int S315_5313::LockCompletedImageBufferPlane() const
 {
-	_imageBufferLock[planeNo].ObtainReadLock();
+	// Register as a reader of the most recently completed image plane. The render thread
+	// never selects a plane with active readers as its next drawing plane, but it may have
+	// published a newer frame and already claimed the plane we loaded before our reader
+	// count was incremented. We confirm the plane is still the most recently completed
+	// plane after registering, and retry with the newer plane if it isn't. Note that
+	// sequentially consistent ordering is required here, to pair with the publish and
+	// select sequence performed by the render thread.
+	unsigned int planeNo = _completedImageBufferPlane.load();
+	while (true)
+	{
+		_imageBufferPlaneReaderCount[planeNo].fetch_add(1);
+		unsigned int completedPlaneNo = _completedImageBufferPlane.load();
+		if (completedPlaneNo == planeNo)
+		{
+			return planeNo;
+		}
+		_imageBufferPlaneReaderCount[planeNo].fetch_sub(1);
+		planeNo = completedPlaneNo;
+	}
 }
 
 //----------------------------------------------------------------------------------------------------------------------
-void S315_5313::UnlockImageBufferData(unsigned int planeNo)
+void S315_5313::UnlockImageBufferPlane(unsigned int planeNo) const
 {
-	_imageBufferLock[planeNo].ReleaseReadLock();
+	_imageBufferPlaneReaderCount[planeNo].fetch_sub(1, std::memory_order_release);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -143,6 +160,115 @@ void S315_5313::GetImageBufferActiveScanPosY(unsigned int planeNo, unsigned int&
 	endPosY = _imageBufferActiveScanPosYEnd[planeNo];
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+// Frame sink functions
+//----------------------------------------------------------------------------------------------------------------------
+void S315_5313::AddFrameSink(IS315_5313FrameSink& frameSink, unsigned int frameInterval)
+{
+	std::unique_lock<std::mutex> lock(_frameSinkMutex);
+	FrameSinkEntry entry;
+	entry.frameSink = &frameSink;
+	entry.frameInterval = (frameInterval > 0)? frameInterval: 1;
+	entry.frameNo = 0;
+	_frameSinks.push_back(entry);
+	_frameSinksPresent = true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void S315_5313::RemoveFrameSink(IS315_5313FrameSink& frameSink)
+{
+	// Note that since the render thread holds the frame sink lock while delivering a
+	// frame, once this function returns, the target sink is guaranteed not to be in use.
+	std::unique_lock<std::mutex> lock(_frameSinkMutex);
+	for (std::vector<FrameSinkEntry>::iterator i = _frameSinks.begin(); i != _frameSinks.end(); ++i)
+	{
+		if (i->frameSink == &frameSink)
+		{
+			_frameSinks.erase(i);
+			break;
+		}
+	}
+	_frameSinksPresent = !_frameSinks.empty();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void S315_5313::NotifyFrameSinksFrameCompleted(unsigned int planeNo)
+{
+	std::unique_lock<std::mutex> lock(_frameSinkMutex);
+
+	// Determine the active image region of the completed frame. We take the horizontal
+	// active scan region from the first active line, since the active width may vary
+	// between lines due to mid-frame changes to the screen settings.
+	unsigned int activeScanPosYStart = _imageBufferActiveScanPosYStart[planeNo];
+	unsigned int activeScanPosYEnd = (_imageBufferActiveScanPosYEnd[planeNo] < ImageBufferHeight)? _imageBufferActiveScanPosYEnd[planeNo]: ImageBufferHeight;
+	if (activeScanPosYStart >= activeScanPosYEnd)
+	{
+		return;
+	}
+	unsigned int activeScanPosXStart = _imageBufferActiveScanPosXStart[planeNo][activeScanPosYStart];
+	unsigned int activeScanPosXEnd = (_imageBufferActiveScanPosXEnd[planeNo][activeScanPosYStart] < ImageBufferWidth)? _imageBufferActiveScanPosXEnd[planeNo][activeScanPosYStart]: ImageBufferWidth;
+	if (activeScanPosXStart >= activeScanPosXEnd)
+	{
+		return;
+	}
+
+	// Pass the active image region of the completed frame to each frame sink which is due
+	// to receive this frame
+	IS315_5313FrameSink::FrameInfo frameInfo;
+	frameInfo.imageData = &_imageBuffer[planeNo][((activeScanPosYStart * ImageBufferWidth) + activeScanPosXStart) * 4];
+	frameInfo.imageDataStride = ImageBufferWidth * 4;
+	frameInfo.activeImageWidth = activeScanPosXEnd - activeScanPosXStart;
+	frameInfo.activeImageHeight = activeScanPosYEnd - activeScanPosYStart;
+	frameInfo.oddInterlaceFrame = _imageBufferOddInterlaceFrame[planeNo];
+	for (std::vector<FrameSinkEntry>::iterator i = _frameSinks.begin(); i != _frameSinks.end(); ++i)
+	{
+		if ((i->frameNo % i->frameInterval) == 0)
+		{
+			frameInfo.frameNo = i->frameNo;
+			i->frameSink->FrameCompleted(frameInfo);
+		}
+		++i->frameNo;
+	}
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Video capture functions
+//----------------------------------------------------------------------------------------------------------------------
+void S315_5313::SetVideoCaptureEnabled(bool state)
+{
+	if (state == _videoCaptureEnabled)
+	{
+		return;
+	}
+
+	if (state)
+	{
+		// Calculate the rate at which frames will be captured, based on the current clock
+		// rate and video mode. Each raster line is always 3420 mclk cycles long, regardless
+		// of the horizontal screen mode. Note that each field of an interlaced frame is
+		// output as a separate frame.
+		const unsigned int mclkCyclesPerLine = 3420;
+		const VScanSettings& vscanSettings = GetVScanSettings(_screenModeV30, _palMode, false);
+		unsigned int frameRateNumerator = (unsigned int)(_clockMclkCurrent + 0.5);
+		unsigned int frameRateDenominator = mclkCyclesPerLine * vscanSettings.linesPerFrame * _videoCaptureFrameInterval;
+
+		// Open the capture file, and register our writer to receive completed frames
+		if (!_videoCaptureWriter.Open(_videoCapturePath, frameRateNumerator, frameRateDenominator))
+		{
+			return;
+		}
+		AddFrameSink(_videoCaptureWriter, _videoCaptureFrameInterval);
+	}
+	else
+	{
+		// Stop delivering frames to our writer, and close the capture file once all
+		// pending frames have been written.
+		RemoveFrameSink(_videoCaptureWriter);
+		_videoCaptureWriter.Close();
+	}
+	_videoCaptureEnabled = state;
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 // Rendering functions
 //----------------------------------------------------------------------------------------------------------------------
@@ -222,6 +348,11 @@ void S315_5313::RenderThread()
 		_vsram->BeginAdvanceSession(_vsramSession, _vsramTimesliceCopy, false);
 		_spriteCache->BeginAdvanceSession(_spriteCacheSession, _spriteCacheTimesliceCopy, false);
 
+		// Discard our decoded copy of the sprite cache at the start of each timeslice. The
+		// committed contents of the sprite cache can be modified outside the render thread
+		// by operations such as rollbacks, savestate loads, or debugger edits.
+		DigitalRenderInvalidateSpriteCacheDecode();
+
 		// Calculate the number of cycles to advance in this update step, and reset the
 		// current advance progress through this timeslice.
 		unsigned int mclkCyclesToAdvance = timesliceRenderInfo.timesliceEndPosition - timesliceRenderInfo.timesliceStartPosition;
@@ -1016,7 +1147,13 @@ void S315_5313::PerformVRAMRenderOperation(const AccessTarget& accessTarget, con
 		// changes which occur at this access slot can take effect.
 		_vram->AdvanceBySession(_renderDigitalMclkCycleProgress, _vramSession, _vramTimesliceCopy);
 		_vsram->AdvanceBySession(_renderDigitalMclkCycleProgress, _vsramSession, _vsramTimesliceCopy);
-		_spriteCache->AdvanceBySession(_renderDigitalMclkCycleProgress, _spriteCacheSession, _spriteCacheTimesliceCopy);
+		if (_renderDigitalMclkCycleProgress >= _spriteCacheSession.nextWriteTime)
+		{
+			// If a write to the sprite cache is being committed at this access slot, our
+			// decoded copy of the sprite cache needs to be rebuilt.
+			_spriteCache->AdvanceBySession(_renderDigitalMclkCycleProgress, _spriteCacheSession, _spriteCacheTimesliceCopy);
+			DigitalRenderInvalidateSpriteCacheDecode();
+		}
 		break;
 	case VRAMRenderOp::REFRESH:
 		// Nothing to do on a memory refresh cycle
@@ -1132,11 +1269,36 @@ void S315_5313::UpdateAnalogRenderProcess(const AccessTarget& accessTarget, cons
 	}
 	else if ((_renderDigitalHCounterPos == hscanSettings.vcounterIncrementPoint) && (_renderDigitalVCounterPos == vscanSettings.vsyncClearedPoint))
 	{
-		// Calculate the image buffer plane to use for the next frame
-		unsigned int newDrawingImageBufferPlane = _videoSingleBuffering? _drawingImageBufferPlane: (_drawingImageBufferPlane + 1) % ImageBufferPlanes;
+		// Pass the completed frame to any registered frame sinks
+		if (_frameSinksPresent)
+		{
+			NotifyFrameSinksFrameCompleted(_drawingImageBufferPlane);
+		}
 
-		// Obtain a write lock on the new drawing image buffer plane
-		_imageBufferLock[newDrawingImageBufferPlane].ObtainWriteLock();
+		// Publish the completed frame as the latest frame available for display
+		_completedImageBufferPlane.store(_drawingImageBufferPlane);
+
+		// Select the image buffer plane to use for the next frame. With three planes, one
+		// holds the frame we just completed, and at most one other can be held by a reader
+		// of an older frame, so there's always a free plane to draw into, and we never
+		// need to wait for a reader. Readers can only lock the latest completed plane, so
+		// once the new frame has been published above, no new reader can lock any other
+		// plane. If multiple concurrent readers hold every other plane, we keep drawing
+		// into the current plane rather than stalling, at the cost of tearing for those
+		// readers. In single buffering mode, we always draw into the same plane.
+		unsigned int newDrawingImageBufferPlane = _drawingImageBufferPlane;
+		if (!_videoSingleBuffering)
+		{
+			for (unsigned int i = 1; i < ImageBufferPlanes; ++i)
+			{
+				unsigned int planeNo = (_drawingImageBufferPlane + i) % ImageBufferPlanes;
+				if (_imageBufferPlaneReaderCount[planeNo].load() == 0)
+				{
+					newDrawingImageBufferPlane = planeNo;
+					break;
+				}
+			}
+		}
 
 		// Advance the drawing image buffer to the next plane
 		_drawingImageBufferPlane = newDrawingImageBufferPlane;
@@ -1144,8 +1306,13 @@ void S315_5313::UpdateAnalogRenderProcess(const AccessTarget& accessTarget, cons
 		// Now that we've completed another frame, advance the last rendered frame token.
 		++_lastRenderedFrameToken;
 
+		// Publish a snapshot of the committed state of VRAM as it stands at the end of this
+		// frame, so that the VRAM and plane debug views can read a consistent copy of it
+		// without contending with this thread or the main execution thread for locks.
+		_vram->PublishCommittedSnapshot();
+
 		// Record the odd interlace frame flag
-		_imageBufferLineCount[_drawingImageBufferPlane] = _renderDigitalOddFlagSet;
+		_imageBufferOddInterlaceFrame[_drawingImageBufferPlane] = _renderDigitalOddFlagSet;
 
 		// Record the number of raster lines we're going to render in the new frame
 		_imageBufferLineCount[_drawingImageBufferPlane] = vscanSettings.topBorderLineCount + vscanSettings.activeDisplayLineCount + vscanSettings.bottomBorderLineCount;
@@ -1157,9 +1324,6 @@ void S315_5313::UpdateAnalogRenderProcess(const AccessTarget& accessTarget, cons
 		// Clear the cache of sprite boundary lines in this frame
 		std::unique_lock<std::mutex> spriteLock(_spriteBoundaryMutex[_drawingImageBufferPlane]);
 		_imageBufferSpriteBoundaryLines[_drawingImageBufferPlane].clear();
-
-		// Release the write lock on the image buffer plane
-		_imageBufferLock[newDrawingImageBufferPlane].ReleaseWriteLock();
 	}
 
 	// Read the display enable register. If this register is cleared, the output for this
@@ -1877,11 +2041,10 @@ unsigned int S315_5313::DigitalRenderCalculateMappingVRAMAddess(unsigned int scr
 }
 
 //----------------------------------------------------------------------------------------------------------------------
-void S315_5313::DigitalRenderBuildSpriteList(unsigned int screenRowNumber, bool interlaceMode2Active, bool screenModeRS1Active, unsigned int& nextTableEntryToRead, bool& spriteSearchComplete, bool& spriteOverflow, unsigned int& spriteDisplayCacheEntryCount, std::vector<SpriteDisplayCacheEntry>& spriteDisplayCache) const
+void S315_5313::DigitalRenderBuildSpriteList(unsigned int screenRowNumber, bool interlaceMode2Active, bool screenModeRS1Active, unsigned int& nextTableEntryToRead, bool& spriteSearchComplete, bool& spriteOverflow, unsigned int& spriteDisplayCacheEntryCount, std::vector<SpriteDisplayCacheEntry>& spriteDisplayCache)
 {
 	if (!spriteSearchComplete && !spriteOverflow)
 	{
-		static const unsigned int spriteCacheEntrySize = 4;
 		const unsigned int spriteAttributeTableSize = (screenModeRS1Active)? 80: 64;
 		//static const unsigned int spritePosScreenStartH = 0x80;
 		const unsigned int spritePosScreenStartV = (interlaceMode2Active)? 0x100: 0x80;
@@ -1890,17 +2053,9 @@ void S315_5313::DigitalRenderBuildSpriteList(unsigned int screenRowNumber, bool
 		const unsigned int renderSpriteDisplayCacheSize = (screenModeRS1Active)? 20: 16;
 		//const unsigned int renderSpriteCellDisplayCacheSize = (screenModeRS1Active)? 40: 32;
 
-		// Calculate the address in the sprite cache of the next sprite to read data for
-		unsigned int spriteCacheAddress = (nextTableEntryToRead * spriteCacheEntrySize);
-
-		// Read all available data on the next sprite from the sprite cache
-		Data spriteVPosData(16);
-		Data spriteSizeAndLinkData(16);
-		spriteVPosData = ((unsigned int)_spriteCache->ReadCommitted(spriteCacheAddress+0) << 8) | (unsigned int)_spriteCache->ReadCommitted(spriteCacheAddress+1);
-		spriteSizeAndLinkData = ((unsigned int)_spriteCache->ReadCommitted(spriteCacheAddress+2) << 8) | (unsigned int)_spriteCache->ReadCommitted(spriteCacheAddress+3);
-
-		// Calculate the width and height of this sprite in cells
-		unsigned int spriteHeightInCells = spriteSizeAndLinkData.GetDataSegment(8, 2) + 1;
+		// Obtain all available data on the next sprite from the sprite cache
+		const SpriteCacheDecodeEntry& spriteCacheEntry = DigitalRenderGetDecodedSpriteCacheEntry(nextTableEntryToRead);
+		unsigned int spriteHeightInCells = spriteCacheEntry.heightInCells;
 
 		// Calculate the relative position of the current active display line in sprite
 		// space.
@@ -1919,14 +2074,15 @@ void S315_5313::DigitalRenderBuildSpriteList(unsigned int screenRowNumber, bool
 			}
 		}
 
-		// Calculate the vertical position of the sprite, discarding any unused bits.
-		Data spriteVPos(spritePosBitCountV);
-		spriteVPos = spriteVPosData;
+		// Calculate the vertical position of the sprite, discarding any unused bits. Note
+		// that the end position of the sprite wraps within the same number of bits.
+		unsigned int spritePosMaskV = ((1u << spritePosBitCountV) - 1);
+		unsigned int spriteVPos = spriteCacheEntry.vpos & spritePosMaskV;
 
 		// If this next sprite is within the current display row, add it to the list of
 		// sprites to display on this line.
 		unsigned int spriteHeightInPixels = spriteHeightInCells * rowsPerTile;
-		if ((spriteVPos <= currentScreenRowInSpriteSpace) && ((spriteVPos + spriteHeightInPixels) > currentScreenRowInSpriteSpace))
+		if ((spriteVPos <= currentScreenRowInSpriteSpace) && (((spriteVPos + spriteHeightInPixels) & spritePosMaskV) > currentScreenRowInSpriteSpace))
 		{
 			// We perform a check for a sprite overflow here. If we exceed the maximum
 			// number of sprites for this line, we set the sprite overflow flag, otherwise
@@ -1934,9 +2090,9 @@ void S315_5313::DigitalRenderBuildSpriteList(unsigned int screenRowNumber, bool
 			if (spriteDisplayCacheEntryCount < renderSpriteDisplayCacheSize)
 			{
 				spriteDisplayCache[spriteDisplayCacheEntryCount].spriteTableIndex = nextTableEntryToRead;
-				spriteDisplayCache[spriteDisplayCacheEntryCount].spriteRowIndex = (currentScreenRowInSpriteSpace - spriteVPos.GetData());
-				spriteDisplayCache[spriteDisplayCacheEntryCount].vpos = spriteVPosData;
-				spriteDisplayCache[spriteDisplayCacheEntryCount].sizeAndLinkData = spriteSizeAndLinkData;
+				spriteDisplayCache[spriteDisplayCacheEntryCount].spriteRowIndex = (currentScreenRowInSpriteSpace - spriteVPos);
+				spriteDisplayCache[spriteDisplayCacheEntryCount].vpos = spriteCacheEntry.vpos;
+				spriteDisplayCache[spriteDisplayCacheEntryCount].sizeAndLinkData = spriteCacheEntry.sizeAndLinkData;
 				++spriteDisplayCacheEntryCount;
 			}
 			else
@@ -1949,7 +2105,7 @@ void S315_5313::DigitalRenderBuildSpriteList(unsigned int screenRowNumber, bool
 		// The sprite search is terminated if we encounter a sprite with a link data value
 		// of 0, or if a link data value is specified which is outside the bounds of the
 		// sprite table, based on the current screen mode settings.
-		nextTableEntryToRead = spriteSizeAndLinkData.GetDataSegment(0, 7);
+		nextTableEntryToRead = spriteCacheEntry.link;
 		if ((nextTableEntryToRead == 0) || (nextTableEntryToRead >= spriteAttributeTableSize))
 		{
 			spriteSearchComplete = true;
@@ -1957,6 +2113,54 @@ void S315_5313::DigitalRenderBuildSpriteList(unsigned int screenRowNumber, bool
 	}
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+// The sprite list for each line is built by walking the linked list of sprites held in
+// the sprite cache, which is repeated from the start of the list on every line. Since the
+// sprite cache is typically only modified a handful of times per frame, we keep a decoded
+// copy of each sprite cache entry, so that each step of the walk doesn't need to read the
+// raw entry back out of the timed sprite cache buffer and decode it again. Each decoded
+// entry records the generation it was decoded in, and is decoded again on its next use
+// whenever the sprite cache has been modified since that point.
+//----------------------------------------------------------------------------------------------------------------------
+const S315_5313::SpriteCacheDecodeEntry& S315_5313::DigitalRenderGetDecodedSpriteCacheEntry(unsigned int spriteTableIndex)
+{
+	static const unsigned int spriteCacheEntrySize = 4;
+
+	// If the decoded entry is still current, return it as-is.
+	SpriteCacheDecodeEntry& entry = _renderSpriteCacheDecode[spriteTableIndex];
+	if (entry.generation == _renderSpriteCacheDecodeGeneration)
+	{
+		return entry;
+	}
+
+	// Read the raw data for this sprite from the sprite cache, and decode it.
+	unsigned int spriteCacheAddress = (spriteTableIndex * spriteCacheEntrySize);
+	entry.vpos = ((unsigned int)_spriteCache->ReadCommitted(spriteCacheAddress+0) << 8) | (unsigned int)_spriteCache->ReadCommitted(spriteCacheAddress+1);
+	entry.sizeAndLinkData = ((unsigned int)_spriteCache->ReadCommitted(spriteCacheAddress+2) << 8) | (unsigned int)_spriteCache->ReadCommitted(spriteCacheAddress+3);
+	entry.heightInCells = ((entry.sizeAndLinkData >> 8) & 0x3) + 1;
+	entry.link = entry.sizeAndLinkData & 0x7F;
+	entry.generation = _renderSpriteCacheDecodeGeneration;
+	return entry;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void S315_5313::DigitalRenderInvalidateSpriteCacheDecode()
+{
+	// Advance the decode generation, which causes each decoded entry to be refreshed on
+	// its next use. If the generation counter wraps around, we explicitly invalidate all
+	// entries, so that no stale entry can match the new generation by chance. Note that
+	// we never use a generation number of 0, as this is the initial value of each entry.
+	++_renderSpriteCacheDecodeGeneration;
+	if (_renderSpriteCacheDecodeGeneration == 0)
+	{
+		for (unsigned int i = 0; i < spriteCacheDecodeEntryCount; ++i)
+		{
+			_renderSpriteCacheDecode[i].generation = 0;
+		}
+		_renderSpriteCacheDecodeGeneration = 1;
+	}
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 void S315_5313::DigitalRenderBuildSpriteCellList(const HScanSettings& hscanSettings, const VScanSettings& vscanSettings, unsigned int spriteDisplayCacheIndex, unsigned int spriteTableBaseAddress, bool interlaceMode2Active, bool screenModeRS1Active, bool& spriteDotOverflow, SpriteDisplayCacheEntry& spriteDisplayCacheEntry, unsigned int& spriteCellDisplayCacheEntryCount, std::vector<SpriteCellDisplayCacheEntry>& spriteCellDisplayCache) const
 {
@@ -56,11 +56,13 @@ References:
 #include "WindowsSupport/WindowsSupport.pkg"
 #include "DeviceInterface/DeviceInterface.pkg"
 #include "TimedBuffers/TimedBuffers.pkg"
+#include "FrameCaptureWriter.h"
 #include <vector>
 #include <list>
 #include <map>
 #include <mutex>
 #include <condition_variable>
+#include <atomic>
 
 class S315_5313 :public Device, public GenericAccessBase<IS315_5313>
 {
@@ -145,9 +147,8 @@ public:
 
 	// Data read/write functions
 	using IGenericAccess::ReadGenericData;
-	using IGenericAccess::WriteGenericData;
 	virtual bool ReadGenericData(unsigned int dataID, const DataContext* dataContext, IGenericAccessDataValue& dataValue) const;
-	virtual bool WriteGenericData(unsigned int dataID, const DataContext* dataContext, IGenericAccessDataValue& dataValue);
+	virtual bool WriteGenericDataInternal(unsigned int dataID, const DataContext* dataContext, IGenericAccessDataValue& dataValue);
 
 	// Data locking functions
 	virtual bool GetGenericDataLocked(unsigned int dataID, const DataContext* dataContext) const;
@@ -166,6 +167,7 @@ private:
 	struct VScanSettings;
 	struct TimesliceRenderInfo;
 	struct SpriteDisplayCacheEntry;
+	struct SpriteCacheDecodeEntry;
 	struct SpriteCellDisplayCacheEntry;
 	struct SpritePixelBufferEntry;
 	struct VRAMRenderOp;
@@ -173,6 +175,7 @@ private:
 	struct FIFOBufferEntry;
 	struct HVCounterAdvanceSession;
 	struct ImageBufferColorEntry;
+	struct FrameSinkEntry;
 
 	// Typedefs
 	typedef RandomTimeAccessBuffer<Data, unsigned int> RegBuffer;
@@ -231,8 +234,8 @@ private:
 	virtual unsigned int GetImageLastRenderedFrameToken() const;
 	virtual unsigned int GetImageCompletedBufferPlaneNo() const;
 	virtual unsigned int GetImageDrawingBufferPlaneNo() const;
-	virtual void LockImageBufferData(unsigned int planeNo);
-	virtual void UnlockImageBufferData(unsigned int planeNo);
+	virtual unsigned int LockCompletedImageBufferPlane() const;
+	virtual void UnlockImageBufferPlane(unsigned int planeNo) const;
 	virtual const unsigned char* GetImageBufferData(unsigned int planeNo) const;
 	virtual const ImageBufferInfo* GetImageBufferInfo(unsigned int planeNo) const;
 	virtual const ImageBufferInfo* GetImageBufferInfo(unsigned int planeNo, unsigned int lineNo, unsigned int pixelNo) const;
@@ -242,6 +245,14 @@ private:
 	virtual void GetImageBufferActiveScanPosX(unsigned int planeNo, unsigned int lineNo, unsigned int& startPosX, unsigned int& endPosX) const;
 	virtual void GetImageBufferActiveScanPosY(unsigned int planeNo, unsigned int& startPosY, unsigned int& endPosY) const;
 
+	// Frame sink functions
+	virtual void AddFrameSink(IS315_5313FrameSink& frameSink, unsigned int frameInterval);
+	virtual void RemoveFrameSink(IS315_5313FrameSink& frameSink);
+	void NotifyFrameSinksFrameCompleted(unsigned int planeNo);
+
+	// Video capture functions
+	void SetVideoCaptureEnabled(bool state);
+
 	// DMA functions
 	void DMAWorkerThread();
 
@@ -255,7 +266,9 @@ private:
 	virtual void DigitalRenderReadHscrollData(unsigned int screenRowNumber, unsigned int hscrollDataBase, bool hscrState, bool lscrState, unsigned int& layerAHscrollPatternDisplacement, unsigned int& layerBHscrollPatternDisplacement, unsigned int& layerAHscrollMappingDisplacement, unsigned int& layerBHscrollMappingDisplacement) const;
 	virtual void DigitalRenderReadVscrollData(unsigned int screenColumnNumber, unsigned int layerNumber, bool vscrState, bool interlaceMode2Active, unsigned int& layerVscrollPatternDisplacement, unsigned int& layerVscrollMappingDisplacement, Data& vsramReadCache) const;
 	static unsigned int DigitalRenderCalculateMappingVRAMAddess(unsigned int screenRowNumber, unsigned int screenColumnNumber, bool interlaceMode2Active, unsigned int nameTableBaseAddress, unsigned int layerHscrollMappingDisplacement, unsigned int layerVscrollMappingDisplacement, unsigned int layerVscrollPatternDisplacement, unsigned int hszState, unsigned int vszState);
-	void DigitalRenderBuildSpriteList(unsigned int screenRowNumber, bool interlaceMode2Active, bool screenModeRS1Active, unsigned int& nextTableEntryToRead, bool& spriteSearchComplete, bool& spriteOverflow, unsigned int& spriteDisplayCacheEntryCount, std::vector<SpriteDisplayCacheEntry>& spriteDisplayCache) const;
+	void DigitalRenderBuildSpriteList(unsigned int screenRowNumber, bool interlaceMode2Active, bool screenModeRS1Active, unsigned int& nextTableEntryToRead, bool& spriteSearchComplete, bool& spriteOverflow, unsigned int& spriteDisplayCacheEntryCount, std::vector<SpriteDisplayCacheEntry>& spriteDisplayCache);
+	const SpriteCacheDecodeEntry& DigitalRenderGetDecodedSpriteCacheEntry(unsigned int spriteTableIndex);
+	void DigitalRenderInvalidateSpriteCacheDecode();
 	void DigitalRenderBuildSpriteCellList(const HScanSettings& hscanSettings, const VScanSettings& vscanSettings, unsigned int spriteDisplayCacheIndex, unsigned int spriteTableBaseAddress, bool interlaceMode2Active, bool screenModeRS1Active, bool& spriteDotOverflow, SpriteDisplayCacheEntry& spriteDisplayCacheEntry, unsigned int& spriteCellDisplayCacheEntryCount, std::vector<SpriteCellDisplayCacheEntry>& spriteCellDisplayCache) const;
 	unsigned int DigitalRenderReadPixelIndex(const Data& patternRow, bool horizontalFlip, unsigned int pixelIndex) const;
 	void CalculateLayerPriorityIndex(unsigned int& layerIndex, bool& shadow, bool& highlight, bool shadowHighlightEnabled, bool spriteIsShadowOperator, bool spriteIsHighlightOperator, bool foundSpritePixel, bool foundLayerAPixel, bool foundLayerBPixel, bool prioritySprite, bool priorityLayerA, bool priorityLayerB) const;
@@ -335,11 +348,13 @@ private:
 	// Processor state advancement functions
 	void UpdateInternalState(unsigned int mclkCyclesTarget, bool checkFifoStateBeforeUpdate, bool stopWhenFifoEmpty, bool stopWhenFifoFull, bool stopWhenFifoNotFull, bool stopWhenReadDataAvailable, bool stopWhenNoDMAOperationInProgress, bool allowAdvancePastCycleTarget);
 	bool AdvanceProcessorState(unsigned int mclkCyclesTarget, bool stopAtNextAccessSlot, bool allowAdvancePastTargetForAccessSlot);
+	bool AdvanceDMAOperationBlock(unsigned int mclkCyclesTarget, bool allowAdvancePastCycleTarget);
 	void PerformReadCacheOperation();
-	void PerformFIFOWriteOperation();
-	void PerformDMACopyOperation();
-	void PerformDMAFillOperation();
+	void PerformFIFOWriteOperation(unsigned int mclkTime);
+	void PerformDMACopyOperation(unsigned int mclkTime);
+	void PerformDMAFillOperation(unsigned int mclkTime);
 	void CacheDMATransferReadData(unsigned int mclkTime);
+	void PerformDMATransferReadOperations(unsigned int mclkTime);
 	void PerformDMATransferOperation();
 	void AdvanceDMAState();
 	bool TargetProcessorStateReached(bool stopWhenFifoEmpty, bool stopWhenFifoFull, bool stopWhenFifoNotFull, bool stopWhenReadDataAvailable, bool stopWhenNoDMAOperationInProgress);
@@ -608,6 +623,12 @@ private:
 	bool _enableSpriteHigh;
 	bool _enableSpriteLow;
 
+	// Video capture settings
+	bool _videoCaptureEnabled;
+	std::wstring _videoCapturePath;
+	unsigned int _videoCaptureFrameInterval;
+	FrameCaptureWriter _videoCaptureWriter;
+
 	// Port monitor settings
 	mutable std::mutex _portMonitorMutex;
 	bool _logStatusRegisterRead;
@@ -839,6 +860,7 @@ private:
 	static const unsigned int maxCellsPerRow = 42;
 	static const unsigned int maxSpriteDisplayCacheSize = 20;
 	static const unsigned int maxSpriteDisplayCellCacheSize = 40;
+	static const unsigned int spriteCacheDecodeEntryCount = SpriteCacheSize / 4;
 	static const unsigned int spritePixelBufferSize = maxCellsPerRow*8;
 	static const unsigned int renderSpritePixelBufferPlaneCount = 2;
 	unsigned int _renderDigitalHCounterPos;
@@ -876,6 +898,8 @@ private:
 	bool _renderSpriteSearchComplete;
 	bool _renderSpriteOverflow;
 	unsigned int _renderSpriteNextAttributeTableEntryToRead;
+	std::vector<SpriteCacheDecodeEntry> _renderSpriteCacheDecode;
+	unsigned int _renderSpriteCacheDecodeGeneration;
 	std::vector<SpriteCellDisplayCacheEntry> _renderSpriteDisplayCellCache;
 	unsigned int _renderSpriteDisplayCellCacheEntryCount;
 	unsigned int _renderSpriteDisplayCellCacheCurrentIndex;
@@ -891,8 +915,9 @@ private:
 
 	// Analog render data buffers
 	unsigned int _drawingImageBufferPlane;
+	std::atomic<unsigned int> _completedImageBufferPlane;
+	mutable std::atomic<unsigned int> _imageBufferPlaneReaderCount[ImageBufferPlanes];
 	volatile unsigned int _lastRenderedFrameToken;
-	mutable ReadWriteLock _imageBufferLock[ImageBufferPlanes];
 	unsigned char _imageBuffer[ImageBufferPlanes][ImageBufferHeight * ImageBufferWidth * 4];
 	ImageBufferInfo _imageBufferInfo[ImageBufferPlanes][ImageBufferHeight * ImageBufferWidth];
 	bool _imageBufferOddInterlaceFrame[ImageBufferPlanes];
@@ -905,6 +930,11 @@ private:
 	mutable std::mutex _spriteBoundaryMutex[ImageBufferPlanes];
 	mutable std::list<SpriteBoundaryLineEntry> _imageBufferSpriteBoundaryLines[ImageBufferPlanes];
 
+	// Frame sink data
+	mutable std::mutex _frameSinkMutex;
+	std::vector<FrameSinkEntry> _frameSinks;
+	volatile bool _frameSinksPresent;
+
 	// DMA worker thread properties
 	mutable std::mutex _workerThreadMutex; // Top-level, required in order to interact with state affecting DMA worker thread.
 	std::condition_variable _workerThreadUpdate;
@@ -258,6 +258,20 @@ struct S315_5313::SpriteDisplayCacheEntry
 	Data hpos;
 };
 
+//----------------------------------------------------------------------------------------------------------------------
+struct S315_5313::SpriteCacheDecodeEntry
+{
+	SpriteCacheDecodeEntry()
+	:generation(0), vpos(0), sizeAndLinkData(0), heightInCells(0), link(0)
+	{ }
+
+	unsigned int generation;
+	unsigned int vpos;
+	unsigned int sizeAndLinkData;
+	unsigned int heightInCells;
+	unsigned int link;
+};
+
 //----------------------------------------------------------------------------------------------------------------------
 struct S315_5313::SpriteCellDisplayCacheEntry
 {
@@ -413,6 +427,14 @@ struct S315_5313::ImageBufferColorEntry
 	unsigned char a;
 };
 
+//----------------------------------------------------------------------------------------------------------------------
+struct S315_5313::FrameSinkEntry
+{
+	IS315_5313FrameSink* frameSink;
+	unsigned int frameInterval;
+	unsigned int frameNo;
+};
+
 //----------------------------------------------------------------------------------------------------------------------
 // Status register functions
 //----------------------------------------------------------------------------------------------------------------------
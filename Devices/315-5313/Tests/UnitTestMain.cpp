@@ -0,0 +1,235 @@
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+#include "315-5313/FrameCaptureWriter.h"
+#include "Stream/Stream.pkg"
+#include <string>
+#include <vector>
+
+class TestFrameSource
+{
+public:
+	static const unsigned int ImageBufferWidth = 512;
+	static const unsigned int ImageBufferHeight = 512;
+
+	TestFrameSource()
+	:imageData(ImageBufferWidth * ImageBufferHeight * 4, 0)
+	{ }
+
+	// Fills the active image with a pattern derived from the frame number and pixel
+	// position, and returns the frame info describing it.
+	IS315_5313FrameSink::FrameInfo BuildFrame(unsigned int frameNo, unsigned int imageWidth, unsigned int imageHeight)
+	{
+		for (unsigned int ypos = 0; ypos < imageHeight; ++ypos)
+		{
+			for (unsigned int xpos = 0; xpos < imageWidth; ++xpos)
+			{
+				unsigned char* pixelData = &imageData[((ypos * ImageBufferWidth) + xpos) * 4];
+				pixelData[0] = GetPatternValue(frameNo, xpos, ypos, 0);
+				pixelData[1] = GetPatternValue(frameNo, xpos, ypos, 1);
+				pixelData[2] = GetPatternValue(frameNo, xpos, ypos, 2);
+				pixelData[3] = 0xFF;
+			}
+		}
+		IS315_5313FrameSink::FrameInfo frameInfo;
+		frameInfo.frameNo = frameNo;
+		frameInfo.imageData = &imageData[0];
+		frameInfo.imageDataStride = ImageBufferWidth * 4;
+		frameInfo.activeImageWidth = imageWidth;
+		frameInfo.activeImageHeight = imageHeight;
+		frameInfo.oddInterlaceFrame = false;
+		return frameInfo;
+	}
+
+	static unsigned char GetPatternValue(unsigned int frameNo, unsigned int xpos, unsigned int ypos, unsigned int channelNo)
+	{
+		return (unsigned char)((frameNo * 31) + (xpos * 7) + (ypos * 13) + (channelNo * 85) + 1);
+	}
+
+	std::vector<unsigned char> imageData;
+};
+
+TEST_CASE("FrameCaptureWriter writes each RGB frame into a fixed size stream frame", "")
+{
+	const unsigned int streamWidth = 320;
+	const unsigned int streamHeight = 240;
+	const unsigned int frameByteSize = streamWidth * streamHeight * 3;
+	struct TestFrameSize
+	{
+		unsigned int width;
+		unsigned int height;
+	};
+	const TestFrameSize frameSizes[] = {{256, 224}, {320, 224}, {320, 240}, {256, 240}};
+	const unsigned int frameCount = sizeof(frameSizes) / sizeof(frameSizes[0]);
+
+	// Deliver a sequence of frames which changes size on every frame, as it would when a
+	// game switches screen modes.
+	Stream::Buffer outputBuffer;
+	FrameCaptureWriter writer;
+	REQUIRE(writer.Open(outputBuffer, FrameCaptureWriter::OutputFormat::RGB, 60, 1));
+	TestFrameSource frameSource;
+	for (unsigned int frameNo = 0; frameNo < frameCount; ++frameNo)
+	{
+		writer.FrameCompleted(frameSource.BuildFrame(frameNo, frameSizes[frameNo].width, frameSizes[frameNo].height));
+	}
+	writer.Close();
+
+	// Since the ring holds more entries than we delivered, every frame must have been
+	// written, with each frame at the top-left of the stream frame, and the remaining
+	// area filled with black.
+	REQUIRE(writer.GetWrittenFrameCount() == frameCount);
+	REQUIRE(writer.GetDroppedFrameCount() == 0);
+	REQUIRE(outputBuffer.Size() == (frameByteSize * frameCount));
+	const unsigned char* outputData = outputBuffer.GetRawBuffer();
+	unsigned int mismatchCount = 0;
+	for (unsigned int frameNo = 0; frameNo < frameCount; ++frameNo)
+	{
+		for (unsigned int ypos = 0; ypos < streamHeight; ++ypos)
+		{
+			for (unsigned int xpos = 0; xpos < streamWidth; ++xpos)
+			{
+				bool pixelInImage = (xpos < frameSizes[frameNo].width) && (ypos < frameSizes[frameNo].height);
+				for (unsigned int channelNo = 0; channelNo < 3; ++channelNo)
+				{
+					unsigned char expectedValue = pixelInImage? TestFrameSource::GetPatternValue(frameNo, xpos, ypos, channelNo): 0;
+					if (outputData[(frameNo * frameByteSize) + (((ypos * streamWidth) + xpos) * 3) + channelNo] != expectedValue)
+					{
+						++mismatchCount;
+					}
+				}
+			}
+		}
+	}
+	REQUIRE(mismatchCount == 0);
+}
+
+TEST_CASE("FrameCaptureWriter writes a Y4M stream with padded frames", "")
+{
+	const unsigned int streamWidth = 320;
+	const unsigned int streamHeight = 240;
+
+	// Deliver a white frame in H32 mode, followed by a white frame in H40 mode
+	Stream::Buffer outputBuffer;
+	FrameCaptureWriter writer;
+	REQUIRE(writer.Open(outputBuffer, FrameCaptureWriter::OutputFormat::Y4M, 60, 1));
+	TestFrameSource frameSource;
+	for (unsigned int frameNo = 0; frameNo < 2; ++frameNo)
+	{
+		IS315_5313FrameSink::FrameInfo frameInfo = frameSource.BuildFrame(frameNo, (frameNo == 0)? 256: 320, 224);
+		for (unsigned int ypos = 0; ypos < frameInfo.activeImageHeight; ++ypos)
+		{
+			for (unsigned int xpos = 0; xpos < frameInfo.activeImageWidth; ++xpos)
+			{
+				unsigned char* pixelData = &frameSource.imageData[((ypos * TestFrameSource::ImageBufferWidth) + xpos) * 4];
+				pixelData[0] = 0xFF;
+				pixelData[1] = 0xFF;
+				pixelData[2] = 0xFF;
+			}
+		}
+		writer.FrameCompleted(frameInfo);
+	}
+	writer.Close();
+	REQUIRE(writer.GetWrittenFrameCount() == 2);
+	REQUIRE(writer.GetDroppedFrameCount() == 0);
+
+	// Verify the stream header, which is sized to the largest active image the VDP can
+	// output rather than the first frame.
+	const std::string expectedHeader = "YUV4MPEG2 W320 H240 F60:1 Ip A1:1 C444 XCOLORRANGE=FULL\n";
+	const std::string frameHeader = "FRAME\n";
+	const unsigned int planeByteSize = streamWidth * streamHeight;
+	const unsigned int frameByteSize = (unsigned int)frameHeader.size() + (planeByteSize * 3);
+	REQUIRE(outputBuffer.Size() == (expectedHeader.size() + (frameByteSize * 2)));
+	const unsigned char* outputData = outputBuffer.GetRawBuffer();
+	REQUIRE(std::string((const char*)outputData, expectedHeader.size()) == expectedHeader);
+
+	// Verify each frame. White converts to full range YCbCr as Y=255 Cb=Cr=128, and black
+	// converts as Y=0 Cb=Cr=128.
+	unsigned int mismatchCount = 0;
+	for (unsigned int frameNo = 0; frameNo < 2; ++frameNo)
+	{
+		const unsigned char* frameData = outputData + expectedHeader.size() + (frameNo * frameByteSize);
+		REQUIRE(std::string((const char*)frameData, frameHeader.size()) == frameHeader);
+		const unsigned char* planeData = frameData + frameHeader.size();
+		unsigned int imageWidth = (frameNo == 0)? 256: 320;
+		for (unsigned int ypos = 0; ypos < streamHeight; ++ypos)
+		{
+			for (unsigned int xpos = 0; xpos < streamWidth; ++xpos)
+			{
+				bool pixelInImage = (xpos < imageWidth) && (ypos < 224);
+				unsigned int pixelOffset = (ypos * streamWidth) + xpos;
+				mismatchCount += (planeData[pixelOffset] != (pixelInImage? 0xFF: 0x00))? 1: 0;
+				mismatchCount += (planeData[planeByteSize + pixelOffset] != 0x80)? 1: 0;
+				mismatchCount += (planeData[(planeByteSize * 2) + pixelOffset] != 0x80)? 1: 0;
+			}
+		}
+	}
+	REQUIRE(mismatchCount == 0);
+}
+
+TEST_CASE("FrameCaptureWriter counts frames dropped when the ring is full", "")
+{
+	const unsigned int frameWidth = 320;
+	const unsigned int frameHeight = 240;
+	const unsigned int frameByteSize = frameWidth * frameHeight * 3;
+	const unsigned int frameCount = 1000;
+	const unsigned int frameBufferEntryCount = 8;
+
+	// Deliver frames faster than the worker thread can write them out
+	Stream::Buffer outputBuffer;
+	FrameCaptureWriter writer;
+	REQUIRE(writer.Open(outputBuffer, FrameCaptureWriter::OutputFormat::RGB, 60, 1));
+	TestFrameSource frameSource;
+	for (unsigned int frameNo = 0; frameNo < frameCount; ++frameNo)
+	{
+		writer.FrameCompleted(frameSource.BuildFrame(frameNo, frameWidth, frameHeight));
+	}
+	writer.Close();
+
+	// Every frame must either have been written or counted as dropped. Since the ring
+	// starts empty, at least one full ring of frames must have been written.
+	unsigned int writtenFrameCount = writer.GetWrittenFrameCount();
+	unsigned int droppedFrameCount = writer.GetDroppedFrameCount();
+	REQUIRE((writtenFrameCount + droppedFrameCount) == frameCount);
+	REQUIRE(writtenFrameCount >= frameBufferEntryCount);
+	REQUIRE(outputBuffer.Size() == (writtenFrameCount * frameByteSize));
+
+	// Each frame which was written must be complete, and must appear in the order it was
+	// received.
+	const unsigned char* outputData = outputBuffer.GetRawBuffer();
+	unsigned int mismatchCount = 0;
+	int lastFrameNo = -1;
+	for (unsigned int writtenFrameNo = 0; writtenFrameNo < writtenFrameCount; ++writtenFrameNo)
+	{
+		const unsigned char* frameData = outputData + (writtenFrameNo * frameByteSize);
+		int frameNo = -1;
+		for (unsigned int i = (unsigned int)(lastFrameNo + 1); i < frameCount; ++i)
+		{
+			if (frameData[0] == TestFrameSource::GetPatternValue(i, 0, 0, 0))
+			{
+				frameNo = (int)i;
+				break;
+			}
+		}
+		REQUIRE(frameNo > lastFrameNo);
+		for (unsigned int ypos = 0; ypos < frameHeight; ++ypos)
+		{
+			for (unsigned int xpos = 0; xpos < frameWidth; ++xpos)
+			{
+				const unsigned char* pixelData = frameData + (((ypos * frameWidth) + xpos) * 3);
+				for (unsigned int channelNo = 0; channelNo < 3; ++channelNo)
+				{
+					mismatchCount += (pixelData[channelNo] != TestFrameSource::GetPatternValue((unsigned int)frameNo, xpos, ypos, channelNo))? 1: 0;
+				}
+			}
+		}
+		lastFrameNo = frameNo;
+	}
+	REQUIRE(mismatchCount == 0);
+}
+
+TEST_CASE("FrameCaptureWriter rejects an image sequence written to a stream", "")
+{
+	Stream::Buffer outputBuffer;
+	FrameCaptureWriter writer;
+	REQUIRE(!writer.Open(outputBuffer, FrameCaptureWriter::OutputFormat::PNG, 60, 1));
+	REQUIRE(!writer.IsOpen());
+}
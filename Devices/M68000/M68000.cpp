@@ -307,10 +307,9 @@ void M68000::Initialize()
 	// Abandon currently pending interrupts, and restore normal processor state
 	_interruptPendingLevel = 0;
 	_lastLineCheckTime = 0;
-	_lineAccessPending = false;
 	_lastTimesliceLength = 0;
 	_blastTimesliceLength = 0;
-	_lineAccessBuffer.clear();
+	_lineAccessBuffer.Clear();
 	_suspendUntilLineStateChangeReceived = false;
 	_manualDeviceAdvanceInProgress = false;
 	_resetLineState = false;
@@ -326,6 +325,9 @@ void M68000::Initialize()
 
 	// Synchronize the changed register state with the current register state
 	PopulateChangedRegStateFromCurrentState();
+
+	// Flag that our state has been reset for any debugger views
+	AllGenericDataModified();
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -642,29 +644,29 @@ double M68000::ExecuteStep()
 	double additionalTime = 0;
 
 	// If we have any pending line state changes waiting, apply any which we have now
-	// reached.
-	if (_lineAccessPending)
+	// reached. Note that this test is a single relaxed load of the time of the next
+	// pending line state change, so we only need to obtain a lock on lineMutex when a
+	// change is actually due to be applied.
+	double currentTimesliceProgress = GetCurrentTimesliceProgress();
+	if (_lineAccessBuffer.IsEntryDue(currentTimesliceProgress))
 	{
 		//##DEBUG##
 		// std::wcout << "M68000 line access pending\n";
 
 		std::unique_lock<std::mutex> lock(_lineMutex);
-		double currentTimesliceProgress = GetCurrentTimesliceProgress();
 		bool done = false;
 		while (!done)
 		{
 			// Remove the next line access that we've reached from the front of the line
 			// access buffer. Note that our lineMutex lock may be released while applying
 			// some line state changes, so we can't keep active reference to an iterator.
-			std::list<LineAccess>::iterator i = _lineAccessBuffer.begin();
-			if ((i == _lineAccessBuffer.end()) || (i->accessTime > currentTimesliceProgress))
+			if (_lineAccessBuffer.Empty() || (_lineAccessBuffer.Front().accessTime > currentTimesliceProgress))
 			{
 				done = true;
 				continue;
 			}
-			LineAccess lineAccess = *i;
-			_lineAccessBuffer.pop_front();
-			_lineAccessPending = !_lineAccessBuffer.empty();
+			LineAccess lineAccess = _lineAccessBuffer.Front();
+			_lineAccessBuffer.PopFront();
 
 			// Apply the line state change
 			if (lineAccess.clockRateChange)
@@ -702,19 +704,19 @@ double M68000::ExecuteStep()
 	// If no line access is pending, and we've decided to suspend until another line state
 	// change is received, suspend execution waiting for another line state change to be
 	// received, unless execution suspension has now been disabled.
-	if (!_lineAccessPending && _suspendUntilLineStateChangeReceived && !_manualDeviceAdvanceInProgress && !GetDeviceContext()->TimesliceSuspensionDisabled())
+	if (!_lineAccessBuffer.IsPending() && _suspendUntilLineStateChangeReceived && !_manualDeviceAdvanceInProgress && !GetDeviceContext()->TimesliceSuspensionDisabled())
 	{
-		// Check lineAccessPending again after taking a lock on lineMutex. This will ensure
-		// we never enter a suspend state when there are actually line access events
-		// sitting in the buffer.
+		// Check for pending line access events again after taking a lock on lineMutex.
+		// This will ensure we never enter a suspend state when there are actually line
+		// access events sitting in the buffer.
 		std::unique_lock<std::mutex> lock(_lineMutex);
-		if (!_lineAccessPending)
+		if (_lineAccessBuffer.Empty())
 		{
 			// Suspend timeslice execution, release the lock on lineMutex, then wait until
 			// execution is resumed. It is essential to perform these steps, in this order.
 			// By waiting to release the lock until after we have suspended timeslice
 			// execution, we ensure that no line state changes have sneaked into the buffer
-			// since we tested the value of the lineAccessPending variable. We need to
+			// since we tested the state of the line access buffer. We need to
 			// release this lock before we enter our wait state however, so that other
 			// devices can resume execution of this device by triggering a line state
 			// change. After releasing the lock, we can now safely enter our wait state,
@@ -1029,8 +1031,7 @@ void M68000::ExecuteRollback()
 	}
 
 	_lastTimesliceLength = _blastTimesliceLength;
-	_lineAccessBuffer = _blineAccessBuffer;
-	_lineAccessPending = !_lineAccessBuffer.empty();
+	_lineAccessBuffer.Rollback();
 
 	_suspendUntilLineStateChangeReceived = _bsuspendUntilLineStateChangeReceived;
 	_resetLineState = _bresetLineState;
@@ -1085,14 +1086,7 @@ void M68000::ExecuteCommit()
 	}
 
 	_blastTimesliceLength = _lastTimesliceLength;
-	if (_lineAccessPending)
-	{
-		_blineAccessBuffer = _lineAccessBuffer;
-	}
-	else
-	{
-		_blineAccessBuffer.clear();
-	}
+	_lineAccessBuffer.Commit();
 
 	_bsuspendUntilLineStateChangeReceived = _suspendUntilLineStateChangeReceived;
 	_bresetLineState = _resetLineState;
@@ -1127,14 +1121,11 @@ void M68000::NotifyUpcomingTimeslice(double nanoseconds)
 	// Reset lastLineCheckTime for the beginning of the new timeslice, and force any
 	// remaining line state changes to be evaluated at the start of the new timeslice.
 	_lastLineCheckTime = 0;
-	for (std::list<LineAccess>::iterator i = _lineAccessBuffer.begin(); i != _lineAccessBuffer.end(); ++i)
-	{
-		// We rebase accessTime here to the start of the new time block, in order to allow
-		// line state changes to be flagged ahead of the time they actually take effect.
-		// This rebasing allows changes flagged ahead of time to safely cross timeslice
-		// boundaries.
-		i->accessTime -= _lastTimesliceLength;
-	}
+
+	// We rebase accessTime here to the start of the new time block, in order to allow line
+	// state changes to be flagged ahead of the time they actually take effect. This
+	// rebasing allows changes flagged ahead of time to safely cross timeslice boundaries.
+	_lineAccessBuffer.RebaseAccessTimes(-_lastTimesliceLength);
 	_lastTimesliceLength = nanoseconds;
 
 	// Since a new timeslice is about to be sent, flag that we haven't yet reached the end
@@ -1389,15 +1380,6 @@ void M68000::SetLineState(unsigned int targetLine, const Data& lineData, IDevice
 		return;
 	}
 
-	// Flag that an entry exists in the buffer. This flag is used to skip the expensive
-	// locking operation in the active thread for this device when no line changes are
-	// pending. Note that we set this flag before we've actually written the entry into
-	// the buffer so that the execution thread is aware of the line state change as soon as
-	// possible, however the lock we've obtained on our line mutex will prevent the
-	// execution thread from attempting to access the line access buffer until the data has
-	// been written.
-	_lineAccessPending = true;
-
 	// Read the time at which this access is being made, and trigger a rollback if we've
 	// already passed that time.
 	if (_lastLineCheckTime > accessTime)
@@ -1406,13 +1388,9 @@ void M68000::SetLineState(unsigned int targetLine, const Data& lineData, IDevice
 	}
 
 	// Insert the line access into the buffer. Note that entries in the buffer are sorted
-	// by access time from lowest to highest.
-	std::list<LineAccess>::reverse_iterator i = _lineAccessBuffer.rbegin();
-	while ((i != _lineAccessBuffer.rend()) && (i->accessTime > accessTime))
-	{
-		++i;
-	}
-	_lineAccessBuffer.insert(i.base(), LineAccess((LineID)targetLine, lineData, accessTime));
+	// by access time from lowest to highest, and inserting the entry publishes the time of
+	// the next pending change to the execution thread for this device.
+	_lineAccessBuffer.Insert(LineAccess((LineID)targetLine, lineData, accessTime));
 
 	// Resume the main execution thread if it is currently suspended waiting for a line
 	// state change to be received.
@@ -1438,31 +1416,24 @@ void M68000::RevokeSetLineState(unsigned int targetLine, const Data& lineData, d
 	}
 
 	// Find the matching line state change entry in the line access buffer
-	std::list<LineAccess>::reverse_iterator i = _lineAccessBuffer.rbegin();
+	TimedLineAccessQueue<LineAccess>::iterator i = _lineAccessBuffer.End();
 	bool foundTargetEntry = false;
-	while (!foundTargetEntry && (i != _lineAccessBuffer.rend()))
+	while (!foundTargetEntry && (i != _lineAccessBuffer.Begin()))
 	{
-		if ((i->lineID == (LineID)targetLine) && (i->state == lineData) && (i->accessTime == reportedTime))
-		{
-			foundTargetEntry = true;
-			continue;
-		}
-		++i;
+		--i;
+		foundTargetEntry = ((i->lineID == (LineID)targetLine) && (i->state == lineData) && (i->accessTime == reportedTime));
 	}
 
 	// Erase the target line state change entry from the line access buffer
 	if (foundTargetEntry)
 	{
-		_lineAccessBuffer.erase((++i).base());
+		_lineAccessBuffer.Erase(i);
 	}
 	else
 	{
 		//##DEBUG##
 		std::wcout << "Failed to find matching line state change in RevokeSetLineState! " << GetLineName(targetLine) << '\t' << lineData.GetData() << '\t' << reportedTime << '\t' << accessTime << '\n';
 	}
-
-	// Update the lineAccessPending flag
-	_lineAccessPending = !_lineAccessBuffer.empty();
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -1492,8 +1463,8 @@ bool M68000::AdvanceToLineState(unsigned int targetLine, const Data& lineData, I
 		// requested, terminate the loop.
 		bool foundTargetStateChange = false;
 		LineAccess* matchingLineAccess = 0;
-		std::list<LineAccess>::iterator i = _lineAccessBuffer.begin();
-		while ((i != _lineAccessBuffer.end()) && (!foundTargetStateChange || (i->accessTime <= accessTime)))
+		TimedLineAccessQueue<LineAccess>::iterator i = _lineAccessBuffer.Begin();
+		while ((i != _lineAccessBuffer.End()) && (!foundTargetStateChange || (i->accessTime <= accessTime)))
 		{
 			// If this line state change modifies the target line, latch the change if it
 			// matches the requested state, otherwise clear any currently latched change.
@@ -1593,7 +1564,7 @@ bool M68000::AdvanceToLineState(unsigned int targetLine, const Data& lineData, I
 
 			_manualDeviceAdvanceInProgress = true;
 			double adjustedTimesliceExecutionProgress = GetCurrentTimesliceProgress();
-			while (!targetLineStateChangeApplied && !_lineAccessBuffer.empty())
+			while (!targetLineStateChangeApplied && _lineAccessBuffer.IsPending())
 			{
 				adjustedTimesliceExecutionProgress += ExecuteStep();
 				SetCurrentTimesliceProgress(adjustedTimesliceExecutionProgress);
@@ -1723,15 +1694,6 @@ void M68000::SetClockSourceRate(unsigned int clockInput, double clockRate, IDevi
 	// here, since line state changes and clock changes are basically the same problem.
 	std::unique_lock<std::mutex> lock(_lineMutex);
 
-	// Flag that an entry exists in the buffer. This flag is used to skip the expensive
-	// locking operation in the active thread for this device when no line changes are
-	// pending. Note that we set this flag before we've actually written the entry into
-	// the buffer so that the execution thread is aware of the line state change as soon as
-	// possible, however the lock we've obtained on our line mutex will prevent the
-	// execution thread from attempting to access the line access buffer until the data has
-	// been written.
-	_lineAccessPending = true;
-
 	// Read the time at which this access is being made, and trigger a rollback if we've
 	// already passed that time.
 	if (_lastLineCheckTime > accessTime)
@@ -1740,13 +1702,9 @@ void M68000::SetClockSourceRate(unsigned int clockInput, double clockRate, IDevi
 	}
 
 	// Insert the line access into the buffer. Note that entries in the buffer are sorted
-	// by access time from lowest to highest.
-	std::list<LineAccess>::reverse_iterator i = _lineAccessBuffer.rbegin();
-	while ((i != _lineAccessBuffer.rend()) && (i->accessTime > accessTime))
-	{
-		++i;
-	}
-	_lineAccessBuffer.insert(i.base(), LineAccess((ClockID)clockInput, clockRate, accessTime));
+	// by access time from lowest to highest, and inserting the entry publishes the time of
+	// the next pending change to the execution thread for this device.
+	_lineAccessBuffer.Insert(LineAccess((ClockID)clockInput, clockRate, accessTime));
 
 	// Resume the main execution thread if it is currently suspended waiting for a line
 	// state change to be received.
@@ -2889,7 +2847,7 @@ void M68000::LoadState(IHierarchicalStorageNode& node)
 		// Restore the lineAccessBuffer state
 		else if ((*i)->GetName() == L"LineAccessBuffer")
 		{
-			_lineAccessBuffer.clear();
+			_lineAccessBuffer.Clear();
 			IHierarchicalStorageNode& lineAccessBufferNode = *(*i);
 			std::list<IHierarchicalStorageNode*> lineAccessBufferChildList = lineAccessBufferNode.GetChildList();
 			for (std::list<IHierarchicalStorageNode*>::iterator lineAccessBufferEntry = lineAccessBufferChildList.begin(); lineAccessBufferEntry != lineAccessBufferChildList.end(); ++lineAccessBufferEntry)
@@ -2939,21 +2897,15 @@ void M68000::LoadState(IHierarchicalStorageNode& node)
 							}
 						}
 
-						// Find the correct location in the list to insert the entry. The
-						// list must be sorted from earliest to latest.
+						// Insert the entry into the buffer. The buffer keeps entries sorted
+						// from earliest to latest.
 						if (lineAccessDefined)
 						{
-							std::list<LineAccess>::reverse_iterator j = _lineAccessBuffer.rbegin();
-							while ((j != _lineAccessBuffer.rend()) && (j->accessTime > lineAccess.accessTime))
-							{
-								++j;
-							}
-							_lineAccessBuffer.insert(j.base(), lineAccess);
+							_lineAccessBuffer.Insert(lineAccess);
 						}
 					}
 				}
 			}
-			_lineAccessPending = !_lineAccessBuffer.empty();
 		}
 	}
 
@@ -3011,10 +2963,10 @@ void M68000::SaveState(IHierarchicalStorageNode& node) const
 	node.CreateChild(L"Register", _interruptPendingLevel).CreateAttribute(L"name", L"PendingInterruptLevel");
 
 	// Save the lineAccessBuffer state
-	if (_lineAccessPending)
+	if (!_lineAccessBuffer.Empty())
 	{
 		IHierarchicalStorageNode& lineAccessState = node.CreateChild(L"LineAccessBuffer");
-		for (std::list<LineAccess>::const_iterator i = _lineAccessBuffer.begin(); i != _lineAccessBuffer.end(); ++i)
+		for (TimedLineAccessQueue<LineAccess>::const_iterator i = _lineAccessBuffer.Begin(); i != _lineAccessBuffer.End(); ++i)
 		{
 			IHierarchicalStorageNode& lineAccessEntry = lineAccessState.CreateChild(L"LineAccess");
 			lineAccessEntry.CreateAttribute(L"ClockRateChange", i->clockRateChange);
@@ -3151,7 +3103,7 @@ bool M68000::ReadGenericData(unsigned int dataID, const DataContext* dataContext
 }
 
 //----------------------------------------------------------------------------------------------------------------------
-bool M68000::WriteGenericData(unsigned int dataID, const DataContext* dataContext, IGenericAccessDataValue& dataValue)
+bool M68000::WriteGenericDataInternal(unsigned int dataID, const DataContext* dataContext, IGenericAccessDataValue& dataValue)
 {
 	ApplyGenericDataValueLimitSettings(dataID, dataValue);
 	IGenericAccessDataValue::DataType dataType = dataValue.GetType();
@@ -3247,7 +3199,7 @@ bool M68000::WriteGenericData(unsigned int dataID, const DataContext* dataContex
 		_d[registerDataContext.registerNo] = dataValueAsUInt.GetValue();
 		return true;}
 	}
-	return Processor::WriteGenericData(dataID, dataContext, dataValue);
+	return Processor::WriteGenericDataInternal(dataID, dataContext, dataValue);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
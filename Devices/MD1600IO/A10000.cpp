@@ -1,4 +1,5 @@
 #include "A10000.h"
+#include <cstring>
 //##DEBUG##
 #include <iostream>
 
@@ -6,25 +7,15 @@
 // Constructors
 //----------------------------------------------------------------------------------------------------------------------
 A10000::A10000(const std::wstring& implementationName, const std::wstring& instanceName, unsigned int moduleID)
-:Device(implementationName, instanceName, moduleID), _versionRegister(8), _bversionRegister(8)
+:Device(implementationName, instanceName, moduleID)
 {
 	_memoryBus = 0;
 	_controlPortBus = 0;
 
-	// Initialize the control port registers
-	_dataRegisters.resize(ControlPortCount, Data(8));
-	_bdataRegisters.resize(ControlPortCount, Data(8));
-	_controlRegisters.resize(ControlPortCount, Data(8));
-	_bcontrolRegisters.resize(ControlPortCount, Data(8));
-	_serialControlRegisters.resize(ControlPortCount, Data(8));
-	_bserialControlRegisters.resize(ControlPortCount, Data(8));
-	_txDataRegisters.resize(ControlPortCount, Data(8));
-	_btxDataRegisters.resize(ControlPortCount, Data(8));
-	_rxDataRegisters.resize(ControlPortCount, Data(8));
-	_brxDataRegisters.resize(ControlPortCount, Data(8));
-
-	_inputLineState.resize(ControlPortCount);
-	_binputLineState.resize(ControlPortCount);
+	// Initialize the register state
+	std::memset(&_registers, 0, sizeof(_registers));
+	std::memset(&_bregisters, 0, sizeof(_bregisters));
+	_lastLineCheckTime = 0;
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -39,38 +30,37 @@ bool A10000::ValidateDevice()
 void A10000::Initialize()
 {
 	// Initialize the version register
-	_inputHardwareVersion = 0;
-	_versionRegister = 0;
+	_registers.inputHardwareVersion = 0;
+	_registers.versionRegister = 0;
 	SetOverseasFlag(false);
 	SetPALFlag(true);
 	SetNoDiskFlag(true);
-	SetHardwareVersion(_inputHardwareVersion);
+	SetHardwareVersion(_registers.inputHardwareVersion);
 
 	// Initialize the control port registers to their correct default values. These
 	// defaults were obtained from Charles MacDonald.
 	//##TODO## Verify these defaults on the hardware. We have seen other documents which
 	// state that the default value for TxData port 3 is initialized to 0xFF, not 0xFB.
-	_dataRegisters[0] = 0x7F;
-	_dataRegisters[1] = 0x7F;
-	_dataRegisters[2] = 0x7F;
-	_controlRegisters[0] = 0x00;
-	_controlRegisters[1] = 0x00;
-	_controlRegisters[2] = 0x00;
-	_txDataRegisters[0] = 0xFF;
-	_rxDataRegisters[0] = 0x00;
-	_serialControlRegisters[0] = 0x00;
-	_txDataRegisters[1] = 0xFF;
-	_rxDataRegisters[1] = 0x00;
-	_serialControlRegisters[1] = 0x00;
-	_txDataRegisters[2] = 0xFF; // 0xFB
-	_rxDataRegisters[2] = 0x00;
-	_serialControlRegisters[2] = 0x00;
+	_registers.ports[0].dataRegister = 0x7F;
+	_registers.ports[1].dataRegister = 0x7F;
+	_registers.ports[2].dataRegister = 0x7F;
+	_registers.ports[0].controlRegister = 0x00;
+	_registers.ports[1].controlRegister = 0x00;
+	_registers.ports[2].controlRegister = 0x00;
+	_registers.ports[0].txDataRegister = 0xFF;
+	_registers.ports[0].rxDataRegister = 0x00;
+	_registers.ports[0].serialControlRegister = 0x00;
+	_registers.ports[1].txDataRegister = 0xFF;
+	_registers.ports[1].rxDataRegister = 0x00;
+	_registers.ports[1].serialControlRegister = 0x00;
+	_registers.ports[2].txDataRegister = 0xFF; // 0xFB
+	_registers.ports[2].rxDataRegister = 0x00;
+	_registers.ports[2].serialControlRegister = 0x00;
 
 	_lastLineCheckTime = 0;
-	_lineAccessPending = false;
 	_lastTimesliceLength = 0;
-	_lineAccessBuffer.clear();
-	_currentHLLineState = false;
+	_lineAccessBuffer.Clear();
+	_registers.currentHLLineState = false;
 
 	// Note that we initialize these lines to false, but on the real system, these lines
 	// read as true when no controller is connected. This occurs because there are pull-up
@@ -79,13 +69,13 @@ void A10000::Initialize()
 	// assuming that these pull-up resistors exist, since they could be removed.
 	for (unsigned int i = 0; i < ControlPortCount; ++i)
 	{
-		_inputLineState[i].lineAssertedD0 = false;
-		_inputLineState[i].lineAssertedD1 = false;
-		_inputLineState[i].lineAssertedD2 = false;
-		_inputLineState[i].lineAssertedD3 = false;
-		_inputLineState[i].lineAssertedTL = false;
-		_inputLineState[i].lineAssertedTR = false;
-		_inputLineState[i].lineAssertedTH = false;
+		_registers.ports[i].inputLineState.lineAssertedD0 = false;
+		_registers.ports[i].inputLineState.lineAssertedD1 = false;
+		_registers.ports[i].inputLineState.lineAssertedD2 = false;
+		_registers.ports[i].inputLineState.lineAssertedD3 = false;
+		_registers.ports[i].inputLineState.lineAssertedTL = false;
+		_registers.ports[i].inputLineState.lineAssertedTR = false;
+		_registers.ports[i].inputLineState.lineAssertedTH = false;
 	}
 }
 
@@ -139,14 +129,11 @@ void A10000::NotifyUpcomingTimeslice(double nanoseconds)
 	// Reset lastLineCheckTime for the beginning of the new timeslice, and force any
 	// remaining line state changes to be evaluated at the start of the new timeslice.
 	_lastLineCheckTime = 0;
-	for (std::list<LineAccess>::iterator i = _lineAccessBuffer.begin(); i != _lineAccessBuffer.end(); ++i)
-	{
-		// We rebase accessTime here to the start of the new time block, in order to allow
-		// line state changes to be flagged ahead of the time they actually take effect.
-		// This rebasing allows changes flagged ahead of time to safely cross timeslice
-		// boundaries.
-		i->accessTime -= _lastTimesliceLength;
-	}
+
+	// We rebase accessTime here to the start of the new time block, in order to allow line
+	// state changes to be flagged ahead of the time they actually take effect. This
+	// rebasing allows changes flagged ahead of time to safely cross timeslice boundaries.
+	_lineAccessBuffer.RebaseAccessTimes(-_lastTimesliceLength);
 	_lastTimesliceLength = nanoseconds;
 }
 
@@ -167,43 +154,19 @@ void A10000::NotifyAfterExecuteCalled()
 //----------------------------------------------------------------------------------------------------------------------
 void A10000::ExecuteRollback()
 {
-	_versionRegister = _bversionRegister;
-	_inputHardwareVersion = _binputHardwareVersion;
-	_dataRegisters = _bdataRegisters;
-	_controlRegisters = _bcontrolRegisters;
-	_serialControlRegisters = _bserialControlRegisters;
-	_txDataRegisters = _btxDataRegisters;
-	_rxDataRegisters = _brxDataRegisters;
-	_inputLineState = _binputLineState;
-	_currentHLLineState = _bcurrentHLLineState;
+	std::memcpy(&_registers, &_bregisters, sizeof(_registers));
 
 	_lastTimesliceLength = _blastTimesliceLength;
-	_lineAccessBuffer = _blineAccessBuffer;
-	_lineAccessPending = !_lineAccessBuffer.empty();
+	_lineAccessBuffer.Rollback();
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 void A10000::ExecuteCommit()
 {
-	_bversionRegister = _versionRegister;
-	_binputHardwareVersion = _inputHardwareVersion;
-	_bdataRegisters = _dataRegisters;
-	_bcontrolRegisters = _controlRegisters;
-	_bserialControlRegisters = _serialControlRegisters;
-	_btxDataRegisters = _txDataRegisters;
-	_brxDataRegisters = _rxDataRegisters;
-	_binputLineState = _inputLineState;
-	_bcurrentHLLineState = _currentHLLineState;
+	std::memcpy(&_bregisters, &_registers, sizeof(_registers));
 
 	_blastTimesliceLength = _lastTimesliceLength;
-	if (_lineAccessPending)
-	{
-		_blineAccessBuffer = _lineAccessBuffer;
-	}
-	else
-	{
-		_blineAccessBuffer.clear();
-	}
+	_lineAccessBuffer.Commit();
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -437,40 +400,37 @@ void A10000::SetLineState(unsigned int targetLine, const Data& lineData, IDevice
 {
 	std::unique_lock<std::mutex> lock(_lineMutex);
 
-	// Read the time at which this access is being made, and trigger a rollback if we've
-	// already passed that time.
-	if (_lastLineCheckTime > accessTime)
-	{
-		GetSystemInterface().SetSystemRollback(GetDeviceContext(), caller, accessTime, _lastLineCheckTime, accessContext);
-	}
-
 	// If this is a line state change which needs to be processed immediately, apply it now
 	// and return.
 	switch ((LineID)targetLine)
 	{
-	case LineID::LINE_HWVERSION:
-		_inputHardwareVersion = lineData.GetData();
-		SetHardwareVersion(_inputHardwareVersion);
-		return;
+	case LineID::LINE_HWVERSION:{
+		double lastLineCheckTime = _lastLineCheckTime.load();
+		if (lastLineCheckTime > accessTime)
+		{
+			GetSystemInterface().SetSystemRollback(GetDeviceContext(), caller, accessTime, lastLineCheckTime, accessContext);
+		}
+		_registers.inputHardwareVersion = lineData.GetData();
+		SetHardwareVersion(_registers.inputHardwareVersion);
+		return;}
 	}
 
-	// Flag that an entry exists in the buffer. This flag is used to skip the expensive
-	// locking operation in the active thread for this device when no line changes are
-	// pending. Note that we set this flag before we've actually written the entry into
-	// the buffer so that the execution thread is aware of the line state change as soon as
-	// possible, however the lock we've obtained on our line mutex will prevent the
-	// execution thread from attempting to access the line access buffer until the data has
-	// been written.
-	_lineAccessPending = true;
-
 	// Insert the line access into the buffer. Note that entries in the buffer are sorted
-	// by access time from lowest to highest.
-	std::list<LineAccess>::reverse_iterator i = _lineAccessBuffer.rbegin();
-	while ((i != _lineAccessBuffer.rend()) && (i->accessTime > accessTime))
+	// by access time from lowest to highest, and inserting the entry publishes the time of
+	// the next pending change to any thread accessing our registers.
+	_lineAccessBuffer.Insert(LineAccess((LineID)targetLine, lineData, accessTime));
+
+	// Trigger a rollback if we've already passed the time of this access. Register
+	// accesses record their access time before testing for pending line state changes
+	// without holding our line mutex, so we perform this check after publishing the new
+	// entry, with a full fence between the two. This ensures that either the register
+	// access sees our new entry, or we see the time of the register access here.
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	double lastLineCheckTime = _lastLineCheckTime.load(std::memory_order_relaxed);
+	if (lastLineCheckTime > accessTime)
 	{
-		++i;
+		GetSystemInterface().SetSystemRollback(GetDeviceContext(), caller, accessTime, lastLineCheckTime, accessContext);
 	}
-	_lineAccessBuffer.insert(i.base(), LineAccess((LineID)targetLine, lineData, accessTime));
 
 	// We explicitly release our lock on lineMutex here so that we're not blocking access
 	// to SetLineState() on this class before we modify the line state for other devices in
@@ -502,41 +462,35 @@ void A10000::RevokeSetLineState(unsigned int targetLine, const Data& lineData, d
 
 	// Read the time at which this access is being made, and trigger a rollback if we've
 	// already passed that time.
-	if (_lastLineCheckTime > accessTime)
+	double lastLineCheckTime = _lastLineCheckTime.load();
+	if (lastLineCheckTime > accessTime)
 	{
-		GetSystemInterface().SetSystemRollback(GetDeviceContext(), caller, accessTime, _lastLineCheckTime, accessContext);
+		GetSystemInterface().SetSystemRollback(GetDeviceContext(), caller, accessTime, lastLineCheckTime, accessContext);
 	}
 
 	// Find the matching line state change entry in the line access buffer
-	std::list<LineAccess>::reverse_iterator lineAccessIterator = _lineAccessBuffer.rbegin();
+	TimedLineAccessQueue<LineAccess>::iterator i = _lineAccessBuffer.End();
 	bool foundTargetEntry = false;
-	while (!foundTargetEntry && (lineAccessIterator != _lineAccessBuffer.rend()))
+	while (!foundTargetEntry && (i != _lineAccessBuffer.Begin()))
 	{
-		if ((lineAccessIterator->lineID == (LineID)targetLine) && (lineAccessIterator->state == lineData) && (lineAccessIterator->accessTime == reportedTime))
-		{
-			foundTargetEntry = true;
-			continue;
-		}
-		++lineAccessIterator;
+		--i;
+		foundTargetEntry = ((i->lineID == (LineID)targetLine) && (i->state == lineData) && (i->accessTime == reportedTime));
 	}
 
 	// Erase the target line state change entry from the line access buffer
 	if (foundTargetEntry)
 	{
-		_lineAccessBuffer.erase((++lineAccessIterator).base());
+		_lineAccessBuffer.Erase(i);
 	}
 	else
 	{
 		//##DEBUG##
 		std::wcout << "Failed to find matching line state change in RevokeSetLineState! " << GetLineName(targetLine) << '\t' << lineData.GetData() << '\t' << reportedTime << '\t' << accessTime << '\n';
-		for (std::list<LineAccess>::iterator i = _lineAccessBuffer.begin(); i != _lineAccessBuffer.end(); ++i)
+		for (TimedLineAccessQueue<LineAccess>::const_iterator j = _lineAccessBuffer.Begin(); j != _lineAccessBuffer.End(); ++j)
 		{
-			std::wcout << "-" << GetLineName((unsigned int)i->lineID) << '\t' << i->state.GetData() << '\t' << i->accessTime << '\n';
+			std::wcout << "-" << GetLineName((unsigned int)j->lineID) << '\t' << j->state.GetData() << '\t' << j->accessTime << '\n';
 		}
 	}
-
-	// Update the lineAccessPending flag
-	_lineAccessPending = !_lineAccessBuffer.empty();
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -547,7 +501,7 @@ void A10000::AssertCurrentOutputLineState() const
 		AssertCurrentOutputLineStateForPort(Ports::Port1);
 		AssertCurrentOutputLineStateForPort(Ports::Port2);
 		AssertCurrentOutputLineStateForPort(Ports::Port3);
-		if (_currentHLLineState) _memoryBus->SetLineState((unsigned int)LineID::LINE_HL, Data(1, 1), GetDeviceContext(), GetDeviceContext(), GetCurrentTimesliceProgress(), 0);
+		if (_registers.currentHLLineState) _memoryBus->SetLineState((unsigned int)LineID::LINE_HL, Data(1, 1), GetDeviceContext(), GetDeviceContext(), GetCurrentTimesliceProgress(), 0);
 	}
 }
 
@@ -559,7 +513,7 @@ void A10000::NegateCurrentOutputLineState() const
 		NegateCurrentOutputLineStateForPort(Ports::Port1);
 		NegateCurrentOutputLineStateForPort(Ports::Port2);
 		NegateCurrentOutputLineStateForPort(Ports::Port3);
-		if (_currentHLLineState) _memoryBus->SetLineState((unsigned int)LineID::LINE_HL, Data(1, 0), GetDeviceContext(), GetDeviceContext(), GetCurrentTimesliceProgress(), 0);
+		if (_registers.currentHLLineState) _memoryBus->SetLineState((unsigned int)LineID::LINE_HL, Data(1, 0), GetDeviceContext(), GetDeviceContext(), GetCurrentTimesliceProgress(), 0);
 	}
 }
 
@@ -636,49 +590,49 @@ void A10000::ApplyLineStateChange(LineID targetLine, const Data& lineData)
 	{
 	// Control port 1 interface
 	case LineID::LINE_PORT1_TH:
-		_inputLineState[GetPortIndexForPort(Ports::Port1)].lineAssertedTH = lineData.GetBit(0);
+		_registers.ports[GetPortIndexForPort(Ports::Port1)].inputLineState.lineAssertedTH = lineData.GetBit(0);
 		if (!GetControlRegisterTH(Ports::Port1))
 		{
 			SetDataRegisterTH(Ports::Port1, lineData.GetBit(0));
 		}
 		break;
 	case LineID::LINE_PORT1_TR:
-		_inputLineState[GetPortIndexForPort(Ports::Port1)].lineAssertedTR = lineData.GetBit(0);
+		_registers.ports[GetPortIndexForPort(Ports::Port1)].inputLineState.lineAssertedTR = lineData.GetBit(0);
 		if (!GetControlRegisterTR(Ports::Port1))
 		{
 			SetDataRegisterTR(Ports::Port1, lineData.GetBit(0));
 		}
 		break;
 	case LineID::LINE_PORT1_TL:
-		_inputLineState[GetPortIndexForPort(Ports::Port1)].lineAssertedTL = lineData.GetBit(0);
+		_registers.ports[GetPortIndexForPort(Ports::Port1)].inputLineState.lineAssertedTL = lineData.GetBit(0);
 		if (!GetControlRegisterTL(Ports::Port1))
 		{
 			SetDataRegisterTL(Ports::Port1, lineData.GetBit(0));
 		}
 		break;
 	case LineID::LINE_PORT1_D3:
-		_inputLineState[GetPortIndexForPort(Ports::Port1)].lineAssertedD3 = lineData.GetBit(0);
+		_registers.ports[GetPortIndexForPort(Ports::Port1)].inputLineState.lineAssertedD3 = lineData.GetBit(0);
 		if (!GetControlRegisterD3(Ports::Port1))
 		{
 			SetDataRegisterD3(Ports::Port1, lineData.GetBit(0));
 		}
 		break;
 	case LineID::LINE_PORT1_D2:
-		_inputLineState[GetPortIndexForPort(Ports::Port1)].lineAssertedD2 = lineData.GetBit(0);
+		_registers.ports[GetPortIndexForPort(Ports::Port1)].inputLineState.lineAssertedD2 = lineData.GetBit(0);
 		if (!GetControlRegisterD2(Ports::Port1))
 		{
 			SetDataRegisterD2(Ports::Port1, lineData.GetBit(0));
 		}
 		break;
 	case LineID::LINE_PORT1_D1:
-		_inputLineState[GetPortIndexForPort(Ports::Port1)].lineAssertedD1 = lineData.GetBit(0);
+		_registers.ports[GetPortIndexForPort(Ports::Port1)].inputLineState.lineAssertedD1 = lineData.GetBit(0);
 		if (!GetControlRegisterD1(Ports::Port1))
 		{
 			SetDataRegisterD1(Ports::Port1, lineData.GetBit(0));
 		}
 		break;
 	case LineID::LINE_PORT1_D0:
-		_inputLineState[GetPortIndexForPort(Ports::Port1)].lineAssertedD0 = lineData.GetBit(0);
+		_registers.ports[GetPortIndexForPort(Ports::Port1)].inputLineState.lineAssertedD0 = lineData.GetBit(0);
 		if (!GetControlRegisterD0(Ports::Port1))
 		{
 			SetDataRegisterD0(Ports::Port1, lineData.GetBit(0));
@@ -687,49 +641,49 @@ void A10000::ApplyLineStateChange(LineID targetLine, const Data& lineData)
 
 	// Control port 2 interface
 	case LineID::LINE_PORT2_TH:
-		_inputLineState[GetPortIndexForPort(Ports::Port2)].lineAssertedTH = lineData.GetBit(0);
+		_registers.ports[GetPortIndexForPort(Ports::Port2)].inputLineState.lineAssertedTH = lineData.GetBit(0);
 		if (!GetControlRegisterTH(Ports::Port2))
 		{
 			SetDataRegisterTH(Ports::Port2, lineData.GetBit(0));
 		}
 		break;
 	case LineID::LINE_PORT2_TR:
-		_inputLineState[GetPortIndexForPort(Ports::Port2)].lineAssertedTR = lineData.GetBit(0);
+		_registers.ports[GetPortIndexForPort(Ports::Port2)].inputLineState.lineAssertedTR = lineData.GetBit(0);
 		if (!GetControlRegisterTR(Ports::Port2))
 		{
 			SetDataRegisterTR(Ports::Port2, lineData.GetBit(0));
 		}
 		break;
 	case LineID::LINE_PORT2_TL:
-		_inputLineState[GetPortIndexForPort(Ports::Port2)].lineAssertedTL = lineData.GetBit(0);
+		_registers.ports[GetPortIndexForPort(Ports::Port2)].inputLineState.lineAssertedTL = lineData.GetBit(0);
 		if (!GetControlRegisterTL(Ports::Port2))
 		{
 			SetDataRegisterTL(Ports::Port2, lineData.GetBit(0));
 		}
 		break;
 	case LineID::LINE_PORT2_D3:
-		_inputLineState[GetPortIndexForPort(Ports::Port2)].lineAssertedD3 = lineData.GetBit(0);
+		_registers.ports[GetPortIndexForPort(Ports::Port2)].inputLineState.lineAssertedD3 = lineData.GetBit(0);
 		if (!GetControlRegisterD3(Ports::Port2))
 		{
 			SetDataRegisterD3(Ports::Port2, lineData.GetBit(0));
 		}
 		break;
 	case LineID::LINE_PORT2_D2:
-		_inputLineState[GetPortIndexForPort(Ports::Port2)].lineAssertedD2 = lineData.GetBit(0);
+		_registers.ports[GetPortIndexForPort(Ports::Port2)].inputLineState.lineAssertedD2 = lineData.GetBit(0);
 		if (!GetControlRegisterD2(Ports::Port2))
 		{
 			SetDataRegisterD2(Ports::Port2, lineData.GetBit(0));
 		}
 		break;
 	case LineID::LINE_PORT2_D1:
-		_inputLineState[GetPortIndexForPort(Ports::Port2)].lineAssertedD1 = lineData.GetBit(0);
+		_registers.ports[GetPortIndexForPort(Ports::Port2)].inputLineState.lineAssertedD1 = lineData.GetBit(0);
 		if (!GetControlRegisterD1(Ports::Port2))
 		{
 			SetDataRegisterD1(Ports::Port2, lineData.GetBit(0));
 		}
 		break;
 	case LineID::LINE_PORT2_D0:
-		_inputLineState[GetPortIndexForPort(Ports::Port2)].lineAssertedD0 = lineData.GetBit(0);
+		_registers.ports[GetPortIndexForPort(Ports::Port2)].inputLineState.lineAssertedD0 = lineData.GetBit(0);
 		if (!GetControlRegisterD0(Ports::Port2))
 		{
 			SetDataRegisterD0(Ports::Port2, lineData.GetBit(0));
@@ -738,49 +692,49 @@ void A10000::ApplyLineStateChange(LineID targetLine, const Data& lineData)
 
 	// Control port 3 interface
 	case LineID::LINE_PORT3_TH:
-		_inputLineState[GetPortIndexForPort(Ports::Port3)].lineAssertedTH = lineData.GetBit(0);
+		_registers.ports[GetPortIndexForPort(Ports::Port3)].inputLineState.lineAssertedTH = lineData.GetBit(0);
 		if (!GetControlRegisterTH(Ports::Port3))
 		{
 			SetDataRegisterTH(Ports::Port3, lineData.GetBit(0));
 		}
 		break;
 	case LineID::LINE_PORT3_TR:
-		_inputLineState[GetPortIndexForPort(Ports::Port3)].lineAssertedTR = lineData.GetBit(0);
+		_registers.ports[GetPortIndexForPort(Ports::Port3)].inputLineState.lineAssertedTR = lineData.GetBit(0);
 		if (!GetControlRegisterTR(Ports::Port3))
 		{
 			SetDataRegisterTR(Ports::Port3, lineData.GetBit(0));
 		}
 		break;
 	case LineID::LINE_PORT3_TL:
-		_inputLineState[GetPortIndexForPort(Ports::Port3)].lineAssertedTL = lineData.GetBit(0);
+		_registers.ports[GetPortIndexForPort(Ports::Port3)].inputLineState.lineAssertedTL = lineData.GetBit(0);
 		if (!GetControlRegisterTL(Ports::Port3))
 		{
 			SetDataRegisterTL(Ports::Port3, lineData.GetBit(0));
 		}
 		break;
 	case LineID::LINE_PORT3_D3:
-		_inputLineState[GetPortIndexForPort(Ports::Port3)].lineAssertedD3 = lineData.GetBit(0);
+		_registers.ports[GetPortIndexForPort(Ports::Port3)].inputLineState.lineAssertedD3 = lineData.GetBit(0);
 		if (!GetControlRegisterD3(Ports::Port3))
 		{
 			SetDataRegisterD3(Ports::Port3, lineData.GetBit(0));
 		}
 		break;
 	case LineID::LINE_PORT3_D2:
-		_inputLineState[GetPortIndexForPort(Ports::Port3)].lineAssertedD2 = lineData.GetBit(0);
+		_registers.ports[GetPortIndexForPort(Ports::Port3)].inputLineState.lineAssertedD2 = lineData.GetBit(0);
 		if (!GetControlRegisterD2(Ports::Port3))
 		{
 			SetDataRegisterD2(Ports::Port3, lineData.GetBit(0));
 		}
 		break;
 	case LineID::LINE_PORT3_D1:
-		_inputLineState[GetPortIndexForPort(Ports::Port3)].lineAssertedD1 = lineData.GetBit(0);
+		_registers.ports[GetPortIndexForPort(Ports::Port3)].inputLineState.lineAssertedD1 = lineData.GetBit(0);
 		if (!GetControlRegisterD1(Ports::Port3))
 		{
 			SetDataRegisterD1(Ports::Port3, lineData.GetBit(0));
 		}
 		break;
 	case LineID::LINE_PORT3_D0:
-		_inputLineState[GetPortIndexForPort(Ports::Port3)].lineAssertedD0 = lineData.GetBit(0);
+		_registers.ports[GetPortIndexForPort(Ports::Port3)].inputLineState.lineAssertedD0 = lineData.GetBit(0);
 		if (!GetControlRegisterD0(Ports::Port3))
 		{
 			SetDataRegisterD0(Ports::Port3, lineData.GetBit(0));
@@ -803,27 +757,29 @@ void A10000::ApplyLineStateChange(LineID targetLine, const Data& lineData)
 void A10000::ApplyPendingLineStateChanges(double currentTimesliceProgress)
 {
 	// If we have any pending line state changes waiting, apply any which we have now
-	// reached.
-	if (_lineAccessPending)
+	// reached. Note that this test is a single relaxed load of the time of the next
+	// pending line state change, so we only need to obtain a lock on lineMutex when a
+	// change is actually due to be applied.
+	if (_lineAccessBuffer.IsEntryDue(currentTimesliceProgress))
 	{
+		std::unique_lock<std::mutex> lock(_lineMutex);
 		bool done = false;
-		while (!done)
+		TimedLineAccessQueue<LineAccess>::iterator i = _lineAccessBuffer.Begin();
+		while (!done && (i != _lineAccessBuffer.End()))
 		{
-			// Remove the next line access that we've reached from the front of the line
-			// access buffer
-			std::list<LineAccess>::iterator i = _lineAccessBuffer.begin();
-			if ((i == _lineAccessBuffer.end()) || (i->accessTime > currentTimesliceProgress))
+			if (i->accessTime <= currentTimesliceProgress)
+			{
+				ApplyLineStateChange(i->lineID, i->state);
+				++i;
+			}
+			else
 			{
 				done = true;
-				continue;
 			}
-			LineAccess lineAccess = *i;
-			_lineAccessBuffer.pop_front();
-			_lineAccessPending = !_lineAccessBuffer.empty();
-
-			// Apply the line state change
-			ApplyLineStateChange(lineAccess.lineID, lineAccess.state);
 		}
+
+		// Clear any completed entries from the list
+		_lineAccessBuffer.EraseUpTo(i);
 	}
 }
 
@@ -856,10 +812,10 @@ void A10000::UpdateHLInterruptState(IDeviceContext* caller, double accessTime, u
 	bool newHLLineState = (GetControlRegisterHL(Ports::Port1) && !GetControlRegisterTH(Ports::Port1) && GetDataRegisterTH(Ports::Port1))
 	                   || (GetControlRegisterHL(Ports::Port2) && !GetControlRegisterTH(Ports::Port2) && GetDataRegisterTH(Ports::Port2))
 	                   || (GetControlRegisterHL(Ports::Port3) && !GetControlRegisterTH(Ports::Port3) && GetDataRegisterTH(Ports::Port3));
-	if (newHLLineState != _currentHLLineState)
+	if (newHLLineState != _registers.currentHLLineState)
 	{
-		_currentHLLineState = newHLLineState;
-		_memoryBus->SetLineState((unsigned int)LineID::LINE_HL, Data(1, _currentHLLineState), GetDeviceContext(), caller, accessTime, accessContext);
+		_registers.currentHLLineState = newHLLineState;
+		_memoryBus->SetLineState((unsigned int)LineID::LINE_HL, Data(1, _registers.currentHLLineState), GetDeviceContext(), caller, accessTime, accessContext);
 	}
 }
 
@@ -871,19 +827,20 @@ IBusInterface::AccessResult A10000::ReadInterface(unsigned int interfaceNumber,
 	std::unique_lock<std::mutex> lock(_accessMutex);
 
 	// Trigger a system rollback if the device has been accessed out of order
-	std::unique_lock<std::mutex> lineLock(_lineMutex);
-	if (_lastLineCheckTime > accessTime)
+	double lastLineCheckTime = _lastLineCheckTime.load(std::memory_order_relaxed);
+	if (lastLineCheckTime > accessTime)
 	{
-		GetSystemInterface().SetSystemRollback(GetDeviceContext(), caller, accessTime, _lastLineCheckTime, accessContext);
+		GetSystemInterface().SetSystemRollback(GetDeviceContext(), caller, accessTime, lastLineCheckTime, accessContext);
 	}
-	_lastLineCheckTime = accessTime;
 
-	// Apply any pending line state changes
+	// Record the time of this access, and apply any pending line state changes which
+	// we've now reached. The fence here pairs with the fence in SetLineState, to ensure
+	// that a line state change which is inserted concurrently for an earlier time either
+	// gets applied here, or triggers a rollback.
+	_lastLineCheckTime.store(accessTime, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_seq_cst);
 	ApplyPendingLineStateChanges(accessTime);
 
-	// Release the lock on lineMutex
-	lineLock.unlock();
-
 	// Process the read
 	switch (location)
 	{
@@ -964,19 +921,20 @@ IBusInterface::AccessResult A10000::WriteInterface(unsigned int interfaceNumber,
 	//}
 
 	// Trigger a system rollback if the device has been accessed out of order
-	std::unique_lock<std::mutex> lineLock(_lineMutex);
-	if (_lastLineCheckTime > accessTime)
+	double lastLineCheckTime = _lastLineCheckTime.load(std::memory_order_relaxed);
+	if (lastLineCheckTime > accessTime)
 	{
-		GetSystemInterface().SetSystemRollback(GetDeviceContext(), caller, accessTime, _lastLineCheckTime, accessContext);
+		GetSystemInterface().SetSystemRollback(GetDeviceContext(), caller, accessTime, lastLineCheckTime, accessContext);
 	}
-	_lastLineCheckTime = accessTime;
 
-	// Apply any pending line state changes
+	// Record the time of this access, and apply any pending line state changes which
+	// we've now reached. The fence here pairs with the fence in SetLineState, to ensure
+	// that a line state change which is inserted concurrently for an earlier time either
+	// gets applied here, or triggers a rollback.
+	_lastLineCheckTime.store(accessTime, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_seq_cst);
 	ApplyPendingLineStateChanges(accessTime);
 
-	// Release the lock on lineMutex
-	lineLock.unlock();
-
 	// Process the write
 	switch (location)
 	{
@@ -1138,7 +1096,7 @@ void A10000::WriteControlRegister(IDeviceContext* caller, double accessTime, uns
 
 			// Set the contents of the data register for this line to the current input
 			// line state
-			SetDataRegisterD0(portNo, _inputLineState[GetPortIndexForPort(portNo)].lineAssertedD0);
+			SetDataRegisterD0(portNo, _registers.ports[GetPortIndexForPort(portNo)].inputLineState.lineAssertedD0);
 		}
 		else
 		{
@@ -1162,7 +1120,7 @@ void A10000::WriteControlRegister(IDeviceContext* caller, double accessTime, uns
 
 			// Set the contents of the data register for this line to the current input
 			// line state
-			SetDataRegisterD1(portNo, _inputLineState[GetPortIndexForPort(portNo)].lineAssertedD1);
+			SetDataRegisterD1(portNo, _registers.ports[GetPortIndexForPort(portNo)].inputLineState.lineAssertedD1);
 		}
 		else
 		{
@@ -1186,7 +1144,7 @@ void A10000::WriteControlRegister(IDeviceContext* caller, double accessTime, uns
 
 			// Set the contents of the data register for this line to the current input
 			// line state
-			SetDataRegisterD2(portNo, _inputLineState[GetPortIndexForPort(portNo)].lineAssertedD2);
+			SetDataRegisterD2(portNo, _registers.ports[GetPortIndexForPort(portNo)].inputLineState.lineAssertedD2);
 		}
 		else
 		{
@@ -1210,7 +1168,7 @@ void A10000::WriteControlRegister(IDeviceContext* caller, double accessTime, uns
 
 			// Set the contents of the data register for this line to the current input
 			// line state
-			SetDataRegisterD3(portNo, _inputLineState[GetPortIndexForPort(portNo)].lineAssertedD3);
+			SetDataRegisterD3(portNo, _registers.ports[GetPortIndexForPort(portNo)].inputLineState.lineAssertedD3);
 		}
 		else
 		{
@@ -1234,7 +1192,7 @@ void A10000::WriteControlRegister(IDeviceContext* caller, double accessTime, uns
 
 			// Set the contents of the data register for this line to the current input
 			// line state
-			SetDataRegisterTL(portNo, _inputLineState[GetPortIndexForPort(portNo)].lineAssertedTL);
+			SetDataRegisterTL(portNo, _registers.ports[GetPortIndexForPort(portNo)].inputLineState.lineAssertedTL);
 		}
 		else
 		{
@@ -1258,7 +1216,7 @@ void A10000::WriteControlRegister(IDeviceContext* caller, double accessTime, uns
 
 			// Set the contents of the data register for this line to the current input
 			// line state
-			SetDataRegisterTR(portNo, _inputLineState[GetPortIndexForPort(portNo)].lineAssertedTR);
+			SetDataRegisterTR(portNo, _registers.ports[GetPortIndexForPort(portNo)].inputLineState.lineAssertedTR);
 		}
 		else
 		{
@@ -1282,7 +1240,7 @@ void A10000::WriteControlRegister(IDeviceContext* caller, double accessTime, uns
 
 			// Set the contents of the data register for this line to the current input
 			// line state
-			SetDataRegisterTH(portNo, _inputLineState[GetPortIndexForPort(portNo)].lineAssertedTH);
+			SetDataRegisterTH(portNo, _registers.ports[GetPortIndexForPort(portNo)].inputLineState.lineAssertedTH);
 		}
 		else
 		{
@@ -1348,7 +1306,7 @@ void A10000::WriteTxDataRegister(IDeviceContext* caller, double accessTime, unsi
 //----------------------------------------------------------------------------------------------------------------------
 Data A10000::ReadRxDataRegister(IDeviceContext* caller, double accessTime, unsigned int accessContext, Ports portNo) const
 {
-	return _rxDataRegisters[GetPortIndexForPort(portNo)];
+	return GetRxDataRegister(portNo);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -1390,7 +1348,7 @@ void A10000::LoadState(IHierarchicalStorageNode& node)
 				{
 					SetTxDataRegister(portNo, Data(8, (*i)->ExtractHexData<unsigned int>()));
 				}
-				else if ((*i)->GetName() == L"TxDataRegister")
+				else if ((*i)->GetName() == L"RxDataRegister")
 				{
 					SetRxDataRegister(portNo, Data(8, (*i)->ExtractHexData<unsigned int>()));
 				}
@@ -1402,31 +1360,31 @@ void A10000::LoadState(IHierarchicalStorageNode& node)
 						std::wstring lineName = lineNameAttribute->GetValue();
 						if (lineName == L"D0")
 						{
-							(*i)->ExtractData(_inputLineState[GetPortIndexForPort(portNo)].lineAssertedD0);
+							(*i)->ExtractData(_registers.ports[GetPortIndexForPort(portNo)].inputLineState.lineAssertedD0);
 						}
 						else if (lineName == L"D1")
 						{
-							(*i)->ExtractData(_inputLineState[GetPortIndexForPort(portNo)].lineAssertedD1);
+							(*i)->ExtractData(_registers.ports[GetPortIndexForPort(portNo)].inputLineState.lineAssertedD1);
 						}
 						else if (lineName == L"D2")
 						{
-							(*i)->ExtractData(_inputLineState[GetPortIndexForPort(portNo)].lineAssertedD2);
+							(*i)->ExtractData(_registers.ports[GetPortIndexForPort(portNo)].inputLineState.lineAssertedD2);
 						}
 						else if (lineName == L"D3")
 						{
-							(*i)->ExtractData(_inputLineState[GetPortIndexForPort(portNo)].lineAssertedD3);
+							(*i)->ExtractData(_registers.ports[GetPortIndexForPort(portNo)].inputLineState.lineAssertedD3);
 						}
 						else if (lineName == L"TL")
 						{
-							(*i)->ExtractData(_inputLineState[GetPortIndexForPort(portNo)].lineAssertedTL);
+							(*i)->ExtractData(_registers.ports[GetPortIndexForPort(portNo)].inputLineState.lineAssertedTL);
 						}
 						else if (lineName == L"TR")
 						{
-							(*i)->ExtractData(_inputLineState[GetPortIndexForPort(portNo)].lineAssertedTR);
+							(*i)->ExtractData(_registers.ports[GetPortIndexForPort(portNo)].inputLineState.lineAssertedTR);
 						}
 						else if (lineName == L"TH")
 						{
-							(*i)->ExtractData(_inputLineState[GetPortIndexForPort(portNo)].lineAssertedTH);
+							(*i)->ExtractData(_registers.ports[GetPortIndexForPort(portNo)].inputLineState.lineAssertedTH);
 						}
 					}
 				}
@@ -1434,15 +1392,15 @@ void A10000::LoadState(IHierarchicalStorageNode& node)
 		}
 		else if ((*i)->GetName() == L"VersionRegister")
 		{
-			_versionRegister = (*i)->ExtractHexData<unsigned int>();
+			SetVersionRegister(Data(8, (*i)->ExtractHexData<unsigned int>()));
 		}
 		else if ((*i)->GetName() == L"InputHardwareVersion")
 		{
-			_inputHardwareVersion = (*i)->ExtractHexData<unsigned int>();
+			_registers.inputHardwareVersion = (*i)->ExtractHexData<unsigned int>();
 		}
 		else if ((*i)->GetName() == L"HLLineState")
 		{
-			_currentHLLineState = (*i)->ExtractData<bool>();
+			_registers.currentHLLineState = (*i)->ExtractData<bool>();
 		}
 		else if ((*i)->GetName() == L"LastTimesliceLength")
 		{
@@ -1451,7 +1409,7 @@ void A10000::LoadState(IHierarchicalStorageNode& node)
 		// Restore the lineAccessBuffer state
 		else if ((*i)->GetName() == L"LineAccessBuffer")
 		{
-			_lineAccessBuffer.clear();
+			_lineAccessBuffer.Clear();
 			IHierarchicalStorageNode& lineAccessBufferNode = *(*i);
 			std::list<IHierarchicalStorageNode*> lineAccessBufferChildList = lineAccessBufferNode.GetChildList();
 			for (std::list<IHierarchicalStorageNode*>::iterator lineAccessBufferEntry = lineAccessBufferChildList.begin(); lineAccessBufferEntry != lineAccessBufferChildList.end(); ++lineAccessBufferEntry)
@@ -1474,19 +1432,13 @@ void A10000::LoadState(IHierarchicalStorageNode& node)
 							lineStateAttribute->ExtractValue(lineState);
 							LineAccess lineAccess(lineID, lineState, accessTime);
 
-							// Find the correct location in the list to insert the entry. The
-							// list must be sorted from earliest to latest.
-							std::list<LineAccess>::reverse_iterator j = _lineAccessBuffer.rbegin();
-							while ((j != _lineAccessBuffer.rend()) && (j->accessTime > lineAccess.accessTime))
-							{
-								++j;
-							}
-							_lineAccessBuffer.insert(j.base(), lineAccess);
+							// Insert the entry into the buffer. The buffer keeps entries
+							// sorted from earliest to latest.
+							_lineAccessBuffer.Insert(lineAccess);
 						}
 					}
 				}
 			}
-			_lineAccessPending = !_lineAccessBuffer.empty();
 		}
 	}
 }
@@ -1503,24 +1455,24 @@ void A10000::SaveState(IHierarchicalStorageNode& node) const
 		node.CreateChildHex(L"TxDataRegister", GetTxDataRegister(portNo).GetData(), GetTxDataRegister(portNo).GetHexCharCount()).CreateAttribute(L"PortNumber", i);
 		node.CreateChildHex(L"RxDataRegister", GetRxDataRegister(portNo).GetData(), GetRxDataRegister(portNo).GetHexCharCount()).CreateAttribute(L"PortNumber", i);
 
-		node.CreateChild(L"LineAsserted", _inputLineState[i].lineAssertedD0).CreateAttribute(L"PortNumber", i).CreateAttribute(L"LineName", "D0");
-		node.CreateChild(L"LineAsserted", _inputLineState[i].lineAssertedD1).CreateAttribute(L"PortNumber", i).CreateAttribute(L"LineName", "D1");
-		node.CreateChild(L"LineAsserted", _inputLineState[i].lineAssertedD2).CreateAttribute(L"PortNumber", i).CreateAttribute(L"LineName", "D2");
-		node.CreateChild(L"LineAsserted", _inputLineState[i].lineAssertedD3).CreateAttribute(L"PortNumber", i).CreateAttribute(L"LineName", "D3");
-		node.CreateChild(L"LineAsserted", _inputLineState[i].lineAssertedTL).CreateAttribute(L"PortNumber", i).CreateAttribute(L"LineName", "TL");
-		node.CreateChild(L"LineAsserted", _inputLineState[i].lineAssertedTR).CreateAttribute(L"PortNumber", i).CreateAttribute(L"LineName", "TR");
-		node.CreateChild(L"LineAsserted", _inputLineState[i].lineAssertedTH).CreateAttribute(L"PortNumber", i).CreateAttribute(L"LineName", "TH");
-	}
-	node.CreateChildHex(L"VersionRegister", _versionRegister.GetData(), _versionRegister.GetHexCharCount());
-	node.CreateChildHex(L"InputHardwareVersion", _inputHardwareVersion, 1);
-	node.CreateChild(L"HLLineState", _currentHLLineState);
+		node.CreateChild(L"LineAsserted", _registers.ports[i].inputLineState.lineAssertedD0).CreateAttribute(L"PortNumber", i).CreateAttribute(L"LineName", "D0");
+		node.CreateChild(L"LineAsserted", _registers.ports[i].inputLineState.lineAssertedD1).CreateAttribute(L"PortNumber", i).CreateAttribute(L"LineName", "D1");
+		node.CreateChild(L"LineAsserted", _registers.ports[i].inputLineState.lineAssertedD2).CreateAttribute(L"PortNumber", i).CreateAttribute(L"LineName", "D2");
+		node.CreateChild(L"LineAsserted", _registers.ports[i].inputLineState.lineAssertedD3).CreateAttribute(L"PortNumber", i).CreateAttribute(L"LineName", "D3");
+		node.CreateChild(L"LineAsserted", _registers.ports[i].inputLineState.lineAssertedTL).CreateAttribute(L"PortNumber", i).CreateAttribute(L"LineName", "TL");
+		node.CreateChild(L"LineAsserted", _registers.ports[i].inputLineState.lineAssertedTR).CreateAttribute(L"PortNumber", i).CreateAttribute(L"LineName", "TR");
+		node.CreateChild(L"LineAsserted", _registers.ports[i].inputLineState.lineAssertedTH).CreateAttribute(L"PortNumber", i).CreateAttribute(L"LineName", "TH");
+	}
+	node.CreateChildHex(L"VersionRegister", GetVersionRegister().GetData(), GetVersionRegister().GetHexCharCount());
+	node.CreateChildHex(L"InputHardwareVersion", _registers.inputHardwareVersion, 1);
+	node.CreateChild(L"HLLineState", _registers.currentHLLineState);
 	node.CreateChild(L"LastTimesliceLength", _lastTimesliceLength);
 
 	// Save the lineAccessBuffer state
-	if (_lineAccessPending)
+	if (!_lineAccessBuffer.Empty())
 	{
 		IHierarchicalStorageNode& lineAccessState = node.CreateChild(L"LineAccessBuffer");
-		for (std::list<LineAccess>::const_iterator i = _lineAccessBuffer.begin(); i != _lineAccessBuffer.end(); ++i)
+		for (TimedLineAccessQueue<LineAccess>::const_iterator i = _lineAccessBuffer.Begin(); i != _lineAccessBuffer.End(); ++i)
 		{
 			IHierarchicalStorageNode& lineAccessEntry = lineAccessState.CreateChild(L"LineAccess");
 			lineAccessEntry.CreateAttribute(L"LineName", GetLineName((unsigned int)i->lineID));
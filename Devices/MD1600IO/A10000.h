@@ -35,8 +35,9 @@ References:
 #define __A10000_H__
 #include "DeviceInterface/DeviceInterface.pkg"
 #include "Device/Device.pkg"
+#include "TimedBuffers/TimedBuffers.pkg"
 #include <mutex>
-#include <vector>
+#include <atomic>
 
 // Physical port interface:
 // Pin 1 - D0
@@ -95,13 +96,38 @@ private:
 	enum class PortLine;
 	enum class LineID;
 
-	// Structures
-	struct InputLineState;
-	struct LineAccess;
-
 	// Constants
 	static const unsigned int ControlPortCount = 3;
 
+	// Structures
+	struct LineAccess;
+	struct InputLineState
+	{
+		bool lineAssertedD0;
+		bool lineAssertedD1;
+		bool lineAssertedD2;
+		bool lineAssertedD3;
+		bool lineAssertedTL;
+		bool lineAssertedTR;
+		bool lineAssertedTH;
+	};
+	struct PortRegisterState
+	{
+		unsigned char dataRegister;
+		unsigned char controlRegister;
+		unsigned char serialControlRegister;
+		unsigned char txDataRegister;
+		unsigned char rxDataRegister;
+		InputLineState inputLineState;
+	};
+	struct RegisterState
+	{
+		unsigned char versionRegister;
+		unsigned int inputHardwareVersion;
+		bool currentHLLineState;
+		PortRegisterState ports[ControlPortCount];
+	};
+
 private:
 	// Line functions
 	void AssertCurrentOutputLineStateForPort(Ports portNo) const;
@@ -111,6 +137,12 @@ private:
 	static LineID GetLineIDForPort(Ports portNo, PortLine portLine);
 	static inline unsigned int GetPortIndexForPort(Ports portNo);
 
+	// Register bit functions
+	static inline bool GetRegisterBit(unsigned char registerValue, unsigned int bitNo);
+	static inline void SetRegisterBit(unsigned char& registerValue, unsigned int bitNo, bool state);
+	static inline unsigned int GetRegisterBits(unsigned char registerValue, unsigned int bitNo, unsigned int bitCount);
+	static inline void SetRegisterBits(unsigned char& registerValue, unsigned int bitNo, unsigned int bitCount, unsigned int data);
+
 	// Data register access
 	inline Data ReadDataRegister(IDeviceContext* caller, double accessTime, unsigned int accessContext, Ports portNo) const;
 	inline void WriteDataRegister(IDeviceContext* caller, double accessTime, unsigned int accessContext, Ports portNo, const Data& data);
@@ -215,39 +247,19 @@ private:
 	IBusInterface* _memoryBus;
 	IBusInterface* _controlPortBus;
 
-	// Version register settings
-	Data _versionRegister;
-	Data _bversionRegister;
-	unsigned int _inputHardwareVersion;
-	unsigned int _binputHardwareVersion;
-
-	// Control port registers
+	// Register state. All registers and input line state for the device are held in a
+	// single packed block, so that the backup copy used for rollback can be saved and
+	// restored with a single memory copy.
 	mutable std::mutex _accessMutex;
-	std::vector<Data> _dataRegisters;
-	std::vector<Data> _bdataRegisters;
-	std::vector<Data> _controlRegisters;
-	std::vector<Data> _bcontrolRegisters;
-	std::vector<Data> _serialControlRegisters;
-	std::vector<Data> _bserialControlRegisters;
-	std::vector<Data> _txDataRegisters;
-	std::vector<Data> _btxDataRegisters;
-	std::vector<Data> _rxDataRegisters;
-	std::vector<Data> _brxDataRegisters;
-	bool _currentHLLineState;
-	bool _bcurrentHLLineState;
-
-	// Input line state
-	std::vector<InputLineState> _inputLineState;
-	std::vector<InputLineState> _binputLineState;
+	RegisterState _registers;
+	RegisterState _bregisters;
 
 	// Line access
 	std::mutex _lineMutex;
-	double _lastLineCheckTime;
-	volatile bool _lineAccessPending;
+	std::atomic<double> _lastLineCheckTime;
 	double _lastTimesliceLength;
 	double _blastTimesliceLength;
-	std::list<LineAccess> _lineAccessBuffer;
-	std::list<LineAccess> _blineAccessBuffer;
+	TimedLineAccessQueue<LineAccess> _lineAccessBuffer;
 };
 
 #include "A10000.inl"
@@ -54,18 +54,6 @@ enum class A10000::LineID
 
 //----------------------------------------------------------------------------------------------------------------------
 // Structures
-//----------------------------------------------------------------------------------------------------------------------
-struct A10000::InputLineState
-{
-	bool lineAssertedD0;
-	bool lineAssertedD1;
-	bool lineAssertedD2;
-	bool lineAssertedD3;
-	bool lineAssertedTL;
-	bool lineAssertedTR;
-	bool lineAssertedTH;
-};
-
 //----------------------------------------------------------------------------------------------------------------------
 struct A10000::LineAccess
 {
@@ -86,6 +74,33 @@ unsigned int A10000::GetPortIndexForPort(Ports portNo)
 	return ((unsigned int)portNo - (unsigned int)Ports::Port1);
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+// Register bit functions
+//----------------------------------------------------------------------------------------------------------------------
+bool A10000::GetRegisterBit(unsigned char registerValue, unsigned int bitNo)
+{
+	return (((unsigned int)registerValue >> bitNo) & 0x01) != 0;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void A10000::SetRegisterBit(unsigned char& registerValue, unsigned int bitNo, bool state)
+{
+	registerValue = (unsigned char)(((unsigned int)registerValue & ~(1u << bitNo)) | ((unsigned int)state << bitNo));
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+unsigned int A10000::GetRegisterBits(unsigned char registerValue, unsigned int bitNo, unsigned int bitCount)
+{
+	return ((unsigned int)registerValue >> bitNo) & ((1u << bitCount) - 1);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void A10000::SetRegisterBits(unsigned char& registerValue, unsigned int bitNo, unsigned int bitCount, unsigned int data)
+{
+	unsigned int bitMask = ((1u << bitCount) - 1) << bitNo;
+	registerValue = (unsigned char)(((unsigned int)registerValue & ~bitMask) | ((data << bitNo) & bitMask));
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 // Version register functions
 // -------------------------------------
@@ -101,49 +116,49 @@ unsigned int A10000::GetPortIndexForPort(Ports portNo)
 //----------------------------------------------------------------------------------------------------------------------
 bool A10000::GetOverseasFlag() const
 {
-	return _versionRegister.GetBit(7);
+	return GetRegisterBit(_registers.versionRegister, 7);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 void A10000::SetOverseasFlag(bool data)
 {
-	_versionRegister.SetBit(7, data);
+	SetRegisterBit(_registers.versionRegister, 7, data);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 bool A10000::GetPALFlag() const
 {
-	return _versionRegister.GetBit(6);
+	return GetRegisterBit(_registers.versionRegister, 6);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 void A10000::SetPALFlag(bool data)
 {
-	_versionRegister.SetBit(6, data);
+	SetRegisterBit(_registers.versionRegister, 6, data);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 bool A10000::GetNoDiskFlag() const
 {
-	return _versionRegister.GetBit(5);
+	return GetRegisterBit(_registers.versionRegister, 5);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 void A10000::SetNoDiskFlag(bool data)
 {
-	_versionRegister.SetBit(5, data);
+	SetRegisterBit(_registers.versionRegister, 5, data);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 unsigned int A10000::GetHardwareVersion() const
 {
-	return _versionRegister.GetDataSegment(0, 4);
+	return GetRegisterBits(_registers.versionRegister, 0, 4);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 void A10000::SetHardwareVersion(unsigned int data)
 {
-	_versionRegister.SetDataSegment(0, 4, data);
+	SetRegisterBits(_registers.versionRegister, 0, 4, data);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -151,73 +166,73 @@ void A10000::SetHardwareVersion(unsigned int data)
 //----------------------------------------------------------------------------------------------------------------------
 Data A10000::GetVersionRegister() const
 {
-	return _versionRegister;
+	return Data(8, _registers.versionRegister);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 void A10000::SetVersionRegister(const Data& data)
 {
-	_versionRegister = data;
+	_registers.versionRegister = (unsigned char)data.GetData();
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 Data A10000::GetDataRegister(Ports portNo) const
 {
-	return _dataRegisters[GetPortIndexForPort(portNo)];
+	return Data(8, _registers.ports[GetPortIndexForPort(portNo)].dataRegister);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 void A10000::SetDataRegister(Ports portNo, const Data& data)
 {
-	_dataRegisters[GetPortIndexForPort(portNo)] = data;
+	_registers.ports[GetPortIndexForPort(portNo)].dataRegister = (unsigned char)data.GetData();
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 Data A10000::GetControlRegister(Ports portNo) const
 {
-	return _controlRegisters[GetPortIndexForPort(portNo)];
+	return Data(8, _registers.ports[GetPortIndexForPort(portNo)].controlRegister);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 void A10000::SetControlRegister(Ports portNo, const Data& data)
 {
-	_controlRegisters[GetPortIndexForPort(portNo)] = data;
+	_registers.ports[GetPortIndexForPort(portNo)].controlRegister = (unsigned char)data.GetData();
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 Data A10000::GetSerialControlRegister(Ports portNo) const
 {
-	return _serialControlRegisters[GetPortIndexForPort(portNo)];
+	return Data(8, _registers.ports[GetPortIndexForPort(portNo)].serialControlRegister);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 void A10000::SetSerialControlRegister(Ports portNo, const Data& data)
 {
-	_serialControlRegisters[GetPortIndexForPort(portNo)] = data;
+	_registers.ports[GetPortIndexForPort(portNo)].serialControlRegister = (unsigned char)data.GetData();
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 Data A10000::GetTxDataRegister(Ports portNo) const
 {
-	return _txDataRegisters[GetPortIndexForPort(portNo)];
+	return Data(8, _registers.ports[GetPortIndexForPort(portNo)].txDataRegister);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 void A10000::SetTxDataRegister(Ports portNo, const Data& data)
 {
-	_txDataRegisters[GetPortIndexForPort(portNo)] = data;
+	_registers.ports[GetPortIndexForPort(portNo)].txDataRegister = (unsigned char)data.GetData();
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 Data A10000::GetRxDataRegister(Ports portNo) const
 {
-	return _rxDataRegisters[GetPortIndexForPort(portNo)];
+	return Data(8, _registers.ports[GetPortIndexForPort(portNo)].rxDataRegister);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 void A10000::SetRxDataRegister(Ports portNo, const Data& data)
 {
-	_rxDataRegisters[GetPortIndexForPort(portNo)] = data;
+	_registers.ports[GetPortIndexForPort(portNo)].rxDataRegister = (unsigned char)data.GetData();
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -235,97 +250,97 @@ void A10000::SetRxDataRegister(Ports portNo, const Data& data)
 //----------------------------------------------------------------------------------------------------------------------
 bool A10000::GetDataRegisterHL(Ports portNo) const
 {
-	return _dataRegisters[GetPortIndexForPort(portNo)].GetBit(7);
+	return GetRegisterBit(_registers.ports[GetPortIndexForPort(portNo)].dataRegister, 7);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 void A10000::SetDataRegisterHL(Ports portNo, bool state)
 {
-	_dataRegisters[GetPortIndexForPort(portNo)].SetBit(7, state);
+	SetRegisterBit(_registers.ports[GetPortIndexForPort(portNo)].dataRegister, 7, state);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 bool A10000::GetDataRegisterTH(Ports portNo) const
 {
-	return _dataRegisters[GetPortIndexForPort(portNo)].GetBit(6);
+	return GetRegisterBit(_registers.ports[GetPortIndexForPort(portNo)].dataRegister, 6);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 void A10000::SetDataRegisterTH(Ports portNo, bool state)
 {
-	_dataRegisters[GetPortIndexForPort(portNo)].SetBit(6, state);
+	SetRegisterBit(_registers.ports[GetPortIndexForPort(portNo)].dataRegister, 6, state);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 bool A10000::GetDataRegisterTR(Ports portNo) const
 {
-	return _dataRegisters[GetPortIndexForPort(portNo)].GetBit(5);
+	return GetRegisterBit(_registers.ports[GetPortIndexForPort(portNo)].dataRegister, 5);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 void A10000::SetDataRegisterTR(Ports portNo, bool state)
 {
-	_dataRegisters[GetPortIndexForPort(portNo)].SetBit(5, state);
+	SetRegisterBit(_registers.ports[GetPortIndexForPort(portNo)].dataRegister, 5, state);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 bool A10000::GetDataRegisterTL(Ports portNo) const
 {
-	return _dataRegisters[GetPortIndexForPort(portNo)].GetBit(4);
+	return GetRegisterBit(_registers.ports[GetPortIndexForPort(portNo)].dataRegister, 4);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 void A10000::SetDataRegisterTL(Ports portNo, bool state)
 {
-	_dataRegisters[GetPortIndexForPort(portNo)].SetBit(4, state);
+	SetRegisterBit(_registers.ports[GetPortIndexForPort(portNo)].dataRegister, 4, state);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 bool A10000::GetDataRegisterD3(Ports portNo) const
 {
-	return _dataRegisters[GetPortIndexForPort(portNo)].GetBit(3);
+	return GetRegisterBit(_registers.ports[GetPortIndexForPort(portNo)].dataRegister, 3);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 void A10000::SetDataRegisterD3(Ports portNo, bool state)
 {
-	_dataRegisters[GetPortIndexForPort(portNo)].SetBit(3, state);
+	SetRegisterBit(_registers.ports[GetPortIndexForPort(portNo)].dataRegister, 3, state);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 bool A10000::GetDataRegisterD2(Ports portNo) const
 {
-	return _dataRegisters[GetPortIndexForPort(portNo)].GetBit(2);
+	return GetRegisterBit(_registers.ports[GetPortIndexForPort(portNo)].dataRegister, 2);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 void A10000::SetDataRegisterD2(Ports portNo, bool state)
 {
-	_dataRegisters[GetPortIndexForPort(portNo)].SetBit(2, state);
+	SetRegisterBit(_registers.ports[GetPortIndexForPort(portNo)].dataRegister, 2, state);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 bool A10000::GetDataRegisterD1(Ports portNo) const
 {
-	return _dataRegisters[GetPortIndexForPort(portNo)].GetBit(1);
+	return GetRegisterBit(_registers.ports[GetPortIndexForPort(portNo)].dataRegister, 1);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 void A10000::SetDataRegisterD1(Ports portNo, bool state)
 {
-	_dataRegisters[GetPortIndexForPort(portNo)].SetBit(1, state);
+	SetRegisterBit(_registers.ports[GetPortIndexForPort(portNo)].dataRegister, 1, state);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 bool A10000::GetDataRegisterD0(Ports portNo) const
 {
-	return _dataRegisters[GetPortIndexForPort(portNo)].GetBit(0);
+	return GetRegisterBit(_registers.ports[GetPortIndexForPort(portNo)].dataRegister, 0);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 void A10000::SetDataRegisterD0(Ports portNo, bool state)
 {
-	_dataRegisters[GetPortIndexForPort(portNo)].SetBit(0, state);
+	SetRegisterBit(_registers.ports[GetPortIndexForPort(portNo)].dataRegister, 0, state);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -344,97 +359,97 @@ void A10000::SetDataRegisterD0(Ports portNo, bool state)
 //----------------------------------------------------------------------------------------------------------------------
 bool A10000::GetControlRegisterHL(Ports portNo) const
 {
-	return _controlRegisters[GetPortIndexForPort(portNo)].GetBit(7);
+	return GetRegisterBit(_registers.ports[GetPortIndexForPort(portNo)].controlRegister, 7);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 void A10000::SetControlRegisterHL(Ports portNo, bool state)
 {
-	_controlRegisters[GetPortIndexForPort(portNo)].SetBit(7, state);
+	SetRegisterBit(_registers.ports[GetPortIndexForPort(portNo)].controlRegister, 7, state);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 bool A10000::GetControlRegisterTH(Ports portNo) const
 {
-	return _controlRegisters[GetPortIndexForPort(portNo)].GetBit(6);
+	return GetRegisterBit(_registers.ports[GetPortIndexForPort(portNo)].controlRegister, 6);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 void A10000::SetControlRegisterTH(Ports portNo, bool state)
 {
-	_controlRegisters[GetPortIndexForPort(portNo)].SetBit(6, state);
+	SetRegisterBit(_registers.ports[GetPortIndexForPort(portNo)].controlRegister, 6, state);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 bool A10000::GetControlRegisterTR(Ports portNo) const
 {
-	return _controlRegisters[GetPortIndexForPort(portNo)].GetBit(5);
+	return GetRegisterBit(_registers.ports[GetPortIndexForPort(portNo)].controlRegister, 5);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 void A10000::SetControlRegisterTR(Ports portNo, bool state)
 {
-	_controlRegisters[GetPortIndexForPort(portNo)].SetBit(5, state);
+	SetRegisterBit(_registers.ports[GetPortIndexForPort(portNo)].controlRegister, 5, state);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 bool A10000::GetControlRegisterTL(Ports portNo) const
 {
-	return _controlRegisters[GetPortIndexForPort(portNo)].GetBit(4);
+	return GetRegisterBit(_registers.ports[GetPortIndexForPort(portNo)].controlRegister, 4);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 void A10000::SetControlRegisterTL(Ports portNo, bool state)
 {
-	_controlRegisters[GetPortIndexForPort(portNo)].SetBit(4, state);
+	SetRegisterBit(_registers.ports[GetPortIndexForPort(portNo)].controlRegister, 4, state);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 bool A10000::GetControlRegisterD3(Ports portNo) const
 {
-	return _controlRegisters[GetPortIndexForPort(portNo)].GetBit(3);
+	return GetRegisterBit(_registers.ports[GetPortIndexForPort(portNo)].controlRegister, 3);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 void A10000::SetControlRegisterD3(Ports portNo, bool state)
 {
-	_controlRegisters[GetPortIndexForPort(portNo)].SetBit(3, state);
+	SetRegisterBit(_registers.ports[GetPortIndexForPort(portNo)].controlRegister, 3, state);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 bool A10000::GetControlRegisterD2(Ports portNo) const
 {
-	return _controlRegisters[GetPortIndexForPort(portNo)].GetBit(2);
+	return GetRegisterBit(_registers.ports[GetPortIndexForPort(portNo)].controlRegister, 2);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 void A10000::SetControlRegisterD2(Ports portNo, bool state)
 {
-	_controlRegisters[GetPortIndexForPort(portNo)].SetBit(2, state);
+	SetRegisterBit(_registers.ports[GetPortIndexForPort(portNo)].controlRegister, 2, state);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 bool A10000::GetControlRegisterD1(Ports portNo) const
 {
-	return _controlRegisters[GetPortIndexForPort(portNo)].GetBit(1);
+	return GetRegisterBit(_registers.ports[GetPortIndexForPort(portNo)].controlRegister, 1);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 void A10000::SetControlRegisterD1(Ports portNo, bool state)
 {
-	_controlRegisters[GetPortIndexForPort(portNo)].SetBit(1, state);
+	SetRegisterBit(_registers.ports[GetPortIndexForPort(portNo)].controlRegister, 1, state);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 bool A10000::GetControlRegisterD0(Ports portNo) const
 {
-	return _controlRegisters[GetPortIndexForPort(portNo)].GetBit(0);
+	return GetRegisterBit(_registers.ports[GetPortIndexForPort(portNo)].controlRegister, 0);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 void A10000::SetControlRegisterD0(Ports portNo, bool state)
 {
-	_controlRegisters[GetPortIndexForPort(portNo)].SetBit(0, state);
+	SetRegisterBit(_registers.ports[GetPortIndexForPort(portNo)].controlRegister, 0, state);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -462,83 +477,83 @@ void A10000::SetControlRegisterD0(Ports portNo, bool state)
 //----------------------------------------------------------------------------------------------------------------------
 unsigned int A10000::GetSerialBaudRate(Ports portNo) const
 {
-	return _serialControlRegisters[GetPortIndexForPort(portNo)].GetDataSegment(6, 2);
+	return GetRegisterBits(_registers.ports[GetPortIndexForPort(portNo)].serialControlRegister, 6, 2);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 void A10000::SetSerialBaudRate(Ports portNo, unsigned int state)
 {
-	_serialControlRegisters[GetPortIndexForPort(portNo)].SetDataSegment(6, 2, state);
+	SetRegisterBits(_registers.ports[GetPortIndexForPort(portNo)].serialControlRegister, 6, 2, state);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 bool A10000::GetSerialInputEnabled(Ports portNo) const
 {
-	return _serialControlRegisters[GetPortIndexForPort(portNo)].GetBit(5);
+	return GetRegisterBit(_registers.ports[GetPortIndexForPort(portNo)].serialControlRegister, 5);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 void A10000::SetSerialInputEnabled(Ports portNo, bool state)
 {
-	_serialControlRegisters[GetPortIndexForPort(portNo)].SetBit(5, state);
+	SetRegisterBit(_registers.ports[GetPortIndexForPort(portNo)].serialControlRegister, 5, state);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 bool A10000::GetSerialOutputEnabled(Ports portNo) const
 {
-	return _serialControlRegisters[GetPortIndexForPort(portNo)].GetBit(4);
+	return GetRegisterBit(_registers.ports[GetPortIndexForPort(portNo)].serialControlRegister, 4);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 void A10000::SetSerialOutputEnabled(Ports portNo, bool state)
 {
-	_serialControlRegisters[GetPortIndexForPort(portNo)].SetBit(4, state);
+	SetRegisterBit(_registers.ports[GetPortIndexForPort(portNo)].serialControlRegister, 4, state);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 bool A10000::GetSerialInterruptEnabled(Ports portNo) const
 {
-	return _serialControlRegisters[GetPortIndexForPort(portNo)].GetBit(3);
+	return GetRegisterBit(_registers.ports[GetPortIndexForPort(portNo)].serialControlRegister, 3);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 void A10000::SetSerialInterruptEnabled(Ports portNo, bool state)
 {
-	_serialControlRegisters[GetPortIndexForPort(portNo)].SetBit(3, state);
+	SetRegisterBit(_registers.ports[GetPortIndexForPort(portNo)].serialControlRegister, 3, state);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 bool A10000::GetSerialErrorFlag(Ports portNo) const
 {
-	return _serialControlRegisters[GetPortIndexForPort(portNo)].GetBit(2);
+	return GetRegisterBit(_registers.ports[GetPortIndexForPort(portNo)].serialControlRegister, 2);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 void A10000::SetSerialErrorFlag(Ports portNo, bool state)
 {
-	_serialControlRegisters[GetPortIndexForPort(portNo)].SetBit(2, state);
+	SetRegisterBit(_registers.ports[GetPortIndexForPort(portNo)].serialControlRegister, 2, state);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 bool A10000::GetRxDataBufferFull(Ports portNo) const
 {
-	return _serialControlRegisters[GetPortIndexForPort(portNo)].GetBit(1);
+	return GetRegisterBit(_registers.ports[GetPortIndexForPort(portNo)].serialControlRegister, 1);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 void A10000::SetRxDataBufferFull(Ports portNo, bool state)
 {
-	_serialControlRegisters[GetPortIndexForPort(portNo)].SetBit(1, state);
+	SetRegisterBit(_registers.ports[GetPortIndexForPort(portNo)].serialControlRegister, 1, state);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 bool A10000::GetTxDataBufferFull(Ports portNo) const
 {
-	return _serialControlRegisters[GetPortIndexForPort(portNo)].GetBit(0);
+	return GetRegisterBit(_registers.ports[GetPortIndexForPort(portNo)].serialControlRegister, 0);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 void A10000::SetTxDataBufferFull(Ports portNo, bool state)
 {
-	_serialControlRegisters[GetPortIndexForPort(portNo)].SetBit(0, state);
+	SetRegisterBit(_registers.ports[GetPortIndexForPort(portNo)].serialControlRegister, 0, state);
 }
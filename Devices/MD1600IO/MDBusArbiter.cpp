@@ -47,9 +47,8 @@ bool MDBusArbiter::ValidateDevice()
 void MDBusArbiter::Initialize()
 {
 	_lastLineCheckTime = 0;
-	_lineAccessPending = false;
 	_lastTimesliceLength = 0;
-	_lineAccessBuffer.clear();
+	_lineAccessBuffer.Clear();
 
 	// Initialize the device settings
 	_activateTMSS = false;
@@ -147,8 +146,7 @@ void MDBusArbiter::RemoveReference(IBusInterface* target)
 void MDBusArbiter::ExecuteRollback()
 {
 	_lastTimesliceLength = _blastTimesliceLength;
-	_lineAccessBuffer = _blineAccessBuffer;
-	_lineAccessPending = !_lineAccessBuffer.empty();
+	_lineAccessBuffer.Rollback();
 
 	_activateTMSS = _bactivateTMSS;
 	_activateBootROM = _bactivateBootROM;
@@ -177,14 +175,7 @@ void MDBusArbiter::ExecuteRollback()
 void MDBusArbiter::ExecuteCommit()
 {
 	_blastTimesliceLength = _lastTimesliceLength;
-	if (_lineAccessPending)
-	{
-		_blineAccessBuffer = _lineAccessBuffer;
-	}
-	else
-	{
-		_blineAccessBuffer.clear();
-	}
+	_lineAccessBuffer.Commit();
 
 	_bactivateTMSS = _activateTMSS;
 	_bactivateBootROM = _activateBootROM;
@@ -221,14 +212,11 @@ void MDBusArbiter::NotifyUpcomingTimeslice(double nanoseconds)
 	// Reset lastLineCheckTime for the beginning of the new timeslice, and force any
 	// remaining line state changes to be evaluated at the start of the new timeslice.
 	_lastLineCheckTime = 0;
-	for (std::list<LineAccess>::iterator i = _lineAccessBuffer.begin(); i != _lineAccessBuffer.end(); ++i)
-	{
-		// We rebase accessTime here to the start of the new time block, in order to allow
-		// line state changes to be flagged ahead of the time they actually take effect.
-		// This rebasing allows changes flagged ahead of time to safely cross timeslice
-		// boundaries.
-		i->accessTime -= _lastTimesliceLength;
-	}
+
+	// We rebase accessTime here to the start of the new time block, in order to allow line
+	// state changes to be flagged ahead of the time they actually take effect. This
+	// rebasing allows changes flagged ahead of time to safely cross timeslice boundaries.
+	_lineAccessBuffer.RebaseAccessTimes(-_lastTimesliceLength);
 	_lastTimesliceLength = nanoseconds;
 }
 
@@ -1197,14 +1185,6 @@ void MDBusArbiter::SetLineState(unsigned int targetLine, const Data& lineData, I
 {
 	std::unique_lock<std::mutex> lock(_lineMutex);
 
-	// Flag that an entry exists in the buffer. This flag is used to skip the expensive
-	// locking operation in the active thread for this device when no line changes are
-	// pending. Note that we set this flag before we've actually written the entry into
-	// the buffer, as we want to force the active thread to lock on the beginning of the
-	// next cycle while this function is executing, so that the current timeslice progress
-	// of the device doesn't change after we've read it.
-	_lineAccessPending = true;
-
 	// Read the time at which this access is being made, and trigger a rollback if we've
 	// already passed that time.
 	if (_lastLineCheckTime > accessTime)
@@ -1257,13 +1237,9 @@ void MDBusArbiter::SetLineState(unsigned int targetLine, const Data& lineData, I
 	}
 
 	// Insert the line access into the buffer. Note that entries in the buffer are sorted
-	// by access time from lowest to highest.
-	std::list<LineAccess>::reverse_iterator i = _lineAccessBuffer.rbegin();
-	while ((i != _lineAccessBuffer.rend()) && (i->accessTime > accessTime))
-	{
-		++i;
-	}
-	_lineAccessBuffer.insert(i.base(), LineAccess((LineID)targetLine, lineData, accessTime));
+	// by access time from lowest to highest, and inserting the entry publishes the time of
+	// the next pending change to any thread applying pending changes.
+	_lineAccessBuffer.Insert(LineAccess((LineID)targetLine, lineData, accessTime));
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -1285,31 +1261,24 @@ void MDBusArbiter::RevokeSetLineState(unsigned int targetLine, const Data& lineD
 	}
 
 	// Find the matching line state change entry in the line access buffer
-	std::list<LineAccess>::reverse_iterator i = _lineAccessBuffer.rbegin();
+	TimedLineAccessQueue<LineAccess>::iterator i = _lineAccessBuffer.End();
 	bool foundTargetEntry = false;
-	while (!foundTargetEntry && (i != _lineAccessBuffer.rend()))
+	while (!foundTargetEntry && (i != _lineAccessBuffer.Begin()))
 	{
-		if ((i->lineID == (LineID)targetLine) && (i->state == lineData) && (i->accessTime == reportedTime))
-		{
-			foundTargetEntry = true;
-			continue;
-		}
-		++i;
+		--i;
+		foundTargetEntry = ((i->lineID == (LineID)targetLine) && (i->state == lineData) && (i->accessTime == reportedTime));
 	}
 
 	// Erase the target line state change entry from the line access buffer
 	if (foundTargetEntry)
 	{
-		_lineAccessBuffer.erase((++i).base());
+		_lineAccessBuffer.Erase(i);
 	}
 	else
 	{
 		//##DEBUG##
 		std::wcout << "Failed to find matching line state change in RevokeSetLineState! " << GetLineName(targetLine) << '\t' << lineData.GetData() << '\t' << reportedTime << '\t' << accessTime << '\n';
 	}
-
-	// Update the lineAccessPending flag
-	_lineAccessPending = !_lineAccessBuffer.empty();
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -1391,14 +1360,16 @@ void MDBusArbiter::ApplyLineStateChange(LineID targetLine, const Data& lineData,
 void MDBusArbiter::ApplyPendingLineStateChanges(double accessTime)
 {
 	// If we have any pending line state changes waiting, apply any which we have now
-	// reached.
-	if (_lineAccessPending)
+	// reached. Note that this test is a single relaxed load of the time of the next
+	// pending line state change, so we only need to obtain a lock on lineMutex when a
+	// change is actually due to be applied.
+	if (_lineAccessBuffer.IsEntryDue(accessTime))
 	{
 		std::unique_lock<std::mutex> lock(_lineMutex);
 		double currentTimesliceProgress = accessTime;
 		bool done = false;
-		std::list<LineAccess>::iterator i = _lineAccessBuffer.begin();
-		while (!done && (i != _lineAccessBuffer.end()))
+		TimedLineAccessQueue<LineAccess>::iterator i = _lineAccessBuffer.Begin();
+		while (!done && (i != _lineAccessBuffer.End()))
 		{
 			if (i->accessTime <= currentTimesliceProgress)
 			{
@@ -1412,8 +1383,7 @@ void MDBusArbiter::ApplyPendingLineStateChanges(double accessTime)
 		}
 
 		// Clear any completed entries from the list
-		_lineAccessBuffer.erase(_lineAccessBuffer.begin(), i);
-		_lineAccessPending = !_lineAccessBuffer.empty();
+		_lineAccessBuffer.EraseUpTo(i);
 	}
 	_lastLineCheckTime = accessTime;
 }
@@ -1458,8 +1428,8 @@ bool MDBusArbiter::AdvanceUntilPendingLineStateChangeApplied(IDeviceContext* cal
 	// If we don't have a pending line state change in the buffer which matches the target
 	// line and state, return false.
 	bool foundTargetStateChange = false;
-	std::list<LineAccess>::iterator i = _lineAccessBuffer.begin();
-	while (!foundTargetStateChange && (i != _lineAccessBuffer.end()))
+	TimedLineAccessQueue<LineAccess>::iterator i = _lineAccessBuffer.Begin();
+	while (!foundTargetStateChange && (i != _lineAccessBuffer.End()))
 	{
 		foundTargetStateChange = ((i->lineID == targetLine) && (i->state == targetLineState));
 		++i;
@@ -1471,8 +1441,8 @@ bool MDBusArbiter::AdvanceUntilPendingLineStateChangeApplied(IDeviceContext* cal
 
 	// Advance the line state buffer until the target line state change is applied
 	bool targetLineStateReached = false;
-	i = _lineAccessBuffer.begin();
-	while (!targetLineStateReached && (i != _lineAccessBuffer.end()))
+	i = _lineAccessBuffer.Begin();
+	while (!targetLineStateReached && (i != _lineAccessBuffer.End()))
 	{
 		ApplyLineStateChange(i->lineID, i->state, i->accessTime);
 		targetLineStateReached = ((i->lineID == targetLine) && (i->state == targetLineState));
@@ -1481,8 +1451,7 @@ bool MDBusArbiter::AdvanceUntilPendingLineStateChangeApplied(IDeviceContext* cal
 	}
 
 	// Clear any completed entries from the list
-	_lineAccessBuffer.erase(_lineAccessBuffer.begin(), i);
-	_lineAccessPending = !_lineAccessBuffer.empty();
+	_lineAccessBuffer.EraseUpTo(i);
 
 	// Return the result of the advance operation. If the logic of our above implementation
 	// is correct, we should always return true at this point, since failure cases were
@@ -1577,7 +1546,7 @@ void MDBusArbiter::LoadState(IHierarchicalStorageNode& node)
 		// Restore the lineAccessBuffer state
 		else if ((*i)->GetName() == L"LineAccessBuffer")
 		{
-			_lineAccessBuffer.clear();
+			_lineAccessBuffer.Clear();
 			IHierarchicalStorageNode& lineAccessBufferNode = *(*i);
 			std::list<IHierarchicalStorageNode*> lineAccessBufferChildList = lineAccessBufferNode.GetChildList();
 			for (std::list<IHierarchicalStorageNode*>::iterator lineAccessBufferEntry = lineAccessBufferChildList.begin(); lineAccessBufferEntry != lineAccessBufferChildList.end(); ++lineAccessBufferEntry)
@@ -1599,19 +1568,13 @@ void MDBusArbiter::LoadState(IHierarchicalStorageNode& node)
 							lineStateAttribute->ExtractValue(lineState);
 							LineAccess lineAccess((LineID)lineID, lineState, accessTime);
 
-							// Find the correct location in the list to insert the entry. The
-							// list must be sorted from earliest to latest.
-							std::list<LineAccess>::reverse_iterator j = _lineAccessBuffer.rbegin();
-							while ((j != _lineAccessBuffer.rend()) && (j->accessTime > lineAccess.accessTime))
-							{
-								++j;
-							}
-							_lineAccessBuffer.insert(j.base(), lineAccess);
+							// Insert the entry into the buffer. The buffer keeps entries
+							// sorted from earliest to latest.
+							_lineAccessBuffer.Insert(lineAccess);
 						}
 					}
 				}
 			}
-			_lineAccessPending = !_lineAccessBuffer.empty();
 		}
 	}
 }
@@ -1640,10 +1603,10 @@ void MDBusArbiter::SaveState(IHierarchicalStorageNode& node) const
 	node.CreateChild(L"LastTimesliceLength", _lastTimesliceLength);
 
 	// Save the lineAccessBuffer state
-	if (_lineAccessPending)
+	if (!_lineAccessBuffer.Empty())
 	{
 		IHierarchicalStorageNode& lineAccessState = node.CreateChild(L"LineAccessBuffer");
-		for (std::list<LineAccess>::const_iterator i = _lineAccessBuffer.begin(); i != _lineAccessBuffer.end(); ++i)
+		for (TimedLineAccessQueue<LineAccess>::const_iterator i = _lineAccessBuffer.Begin(); i != _lineAccessBuffer.End(); ++i)
 		{
 			IHierarchicalStorageNode& lineAccessEntry = lineAccessState.CreateChild(L"LineAccess");
 			lineAccessEntry.CreateAttribute(L"LineName", GetLineName((unsigned int)i->lineID));
@@ -2,6 +2,7 @@
 #define __MDBUSARBITER_H__
 #include "DeviceInterface/DeviceInterface.pkg"
 #include "Device/Device.pkg"
+#include "TimedBuffers/TimedBuffers.pkg"
 #include <mutex>
 
 class MDBusArbiter :public Device
@@ -127,11 +128,9 @@ private:
 	// Line access
 	std::mutex _lineMutex;
 	mutable double _lastLineCheckTime;
-	volatile bool _lineAccessPending;
 	double _lastTimesliceLength;
 	double _blastTimesliceLength;
-	std::list<LineAccess> _lineAccessBuffer;
-	std::list<LineAccess> _blineAccessBuffer;
+	TimedLineAccessQueue<LineAccess> _lineAccessBuffer;
 
 	// Line state
 	volatile bool _cartInLineState;
@@ -8,7 +8,7 @@ public:
 	inline virtual ~IMemory() = 0;
 
 	// Interface version functions
-	static inline unsigned int ThisIMemoryVersion() { return 1; }
+	static inline unsigned int ThisIMemoryVersion() { return 2; }
 	virtual unsigned int GetIMemoryVersion() const = 0;
 
 	// Memory size functions
@@ -23,6 +23,11 @@ public:
 	virtual bool IsMemoryLockingSupported() const = 0;
 	virtual void LockMemoryBlock(unsigned int location, unsigned int size, bool state) = 0;
 	virtual bool IsAddressLocked(unsigned int location) const = 0;
+
+	// Debug memory block access functions
+	virtual unsigned int GetMemoryBlockGeneration() const = 0;
+	virtual void ReadMemoryBlock(unsigned int byteOffset, unsigned int byteCount, unsigned char* data, unsigned char* lockedData) const = 0;
+	virtual void WriteMemoryBlock(unsigned int byteOffset, unsigned int byteCount, const unsigned char* data) = 0;
 };
 IMemory::~IMemory() { }
 
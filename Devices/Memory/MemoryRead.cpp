@@ -43,6 +43,65 @@ void MemoryRead::SetMemoryEntryCount(unsigned int memoryEntryCount)
 	_memoryEntryCount = memoryEntryCount;
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+// Debug memory block access functions
+//----------------------------------------------------------------------------------------------------------------------
+unsigned int MemoryRead::GetMemoryBlockGeneration() const
+{
+	return 0;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void MemoryRead::ReadMemoryBlock(unsigned int byteOffset, unsigned int byteCount, unsigned char* data, unsigned char* lockedData) const
+{
+	unsigned int memoryEntrySizeInBytes = GetMemoryEntrySizeInBytes();
+	Data entryData(memoryEntrySizeInBytes * Data::BitsPerByte);
+	unsigned int byteNoInBlock = 0;
+	while (byteNoInBlock < byteCount)
+	{
+		unsigned int memoryEntryPos = ((byteOffset + byteNoInBlock) / memoryEntrySizeInBytes);
+		unsigned int byteNoInEntry = ((byteOffset + byteNoInBlock) % memoryEntrySizeInBytes);
+		entryData = ReadMemoryEntry(memoryEntryPos);
+		unsigned char entryLocked = ((lockedData != 0) && IsAddressLocked(memoryEntryPos))? 1: 0;
+		while ((byteNoInBlock < byteCount) && (byteNoInEntry < memoryEntrySizeInBytes))
+		{
+			data[byteNoInBlock] = entryData.GetByteFromTopDown(byteNoInEntry);
+			if (lockedData != 0)
+			{
+				lockedData[byteNoInBlock] = entryLocked;
+			}
+			++byteNoInBlock;
+			++byteNoInEntry;
+		}
+	}
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void MemoryRead::WriteMemoryBlock(unsigned int byteOffset, unsigned int byteCount, const unsigned char* data)
+{
+	unsigned int memoryEntrySizeInBytes = GetMemoryEntrySizeInBytes();
+	Data entryData(memoryEntrySizeInBytes * Data::BitsPerByte);
+	unsigned int byteNoInBlock = 0;
+	while (byteNoInBlock < byteCount)
+	{
+		// If only part of this memory entry is being modified, read its current value so
+		// that the remaining bytes are preserved.
+		unsigned int memoryEntryPos = ((byteOffset + byteNoInBlock) / memoryEntrySizeInBytes);
+		unsigned int byteNoInEntry = ((byteOffset + byteNoInBlock) % memoryEntrySizeInBytes);
+		if ((byteNoInEntry > 0) || ((byteCount - byteNoInBlock) < memoryEntrySizeInBytes))
+		{
+			entryData = ReadMemoryEntry(memoryEntryPos);
+		}
+		while ((byteNoInBlock < byteCount) && (byteNoInEntry < memoryEntrySizeInBytes))
+		{
+			entryData.SetByteFromTopDown(byteNoInEntry, data[byteNoInBlock]);
+			++byteNoInBlock;
+			++byteNoInEntry;
+		}
+		WriteMemoryEntry(memoryEntryPos, entryData.GetData());
+	}
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 // Memory locking functions
 //----------------------------------------------------------------------------------------------------------------------
@@ -4,14 +4,18 @@
 #include "DeviceInterface/DeviceInterface.pkg"
 #include "Device/Device.pkg"
 
-//##TODO## Introduce a new interface for classes derived from this class, which
-// provides a high-performance alternative to the Read/Write Transparent functions
-// which specifically provide memory access for the debugger. The functions should
-// work with arrays of data rather than individual values. In our TimedRAM class, we
-// will implement the functions to work on the committed state rather than building
-// information on the latest state. Actually, I'm not sure this will work, because
-// isn't the "committed" state for a TimedRAM buffer defined as the baseline which
-// has been advanced to, which is governed by our render thread?
+// The debug memory block access functions provide the debugger with access to contiguous
+// ranges of memory in a single call, as an alternative to reading or writing individual
+// memory entries. Ranges are specified as byte offsets into the memory, with the bytes of
+// each memory entry ordered from the most significant byte down, and must lie within the
+// memory. If lockedData is non-null, it receives the lock state of the memory entry for
+// each byte in the range. The memory block generation is a value which changes whenever
+// the contents or lock state of the memory may have changed, which allows callers to
+// skip refreshing data which is unchanged. A generation of 0 indicates that changes aren't
+// tracked, in which case the memory must be assumed to have changed on every read. The
+// default implementations provided here are built on the individual memory entry access
+// functions, and should be overridden by derived classes which can copy their memory
+// directly.
 class MemoryRead :public Device, public IMemory
 {
 public:
@@ -28,6 +32,11 @@ public:
 	virtual unsigned int GetMemoryEntryCount() const;
 	void SetMemoryEntryCount(unsigned int memoryEntryCount);
 
+	// Debug memory block access functions
+	virtual unsigned int GetMemoryBlockGeneration() const;
+	virtual void ReadMemoryBlock(unsigned int byteOffset, unsigned int byteCount, unsigned char* data, unsigned char* lockedData) const;
+	virtual void WriteMemoryBlock(unsigned int byteOffset, unsigned int byteCount, const unsigned char* data);
+
 protected:
 	// Memory locking functions
 	virtual bool IsMemoryLockingSupported() const;
@@ -35,6 +35,28 @@ void RAM16::TransparentWriteInterface(unsigned int interfaceNumber, unsigned int
 	WriteArrayValue(location, (unsigned short)data.GetData());
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+// Fixed width memory interface functions
+//----------------------------------------------------------------------------------------------------------------------
+unsigned int RAM16::GetFixedWidthInterfaceBitCount(unsigned int interfaceNumber) const
+{
+	return 16;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+IBusInterface::AccessResult RAM16::ReadInterfaceFixedWidth(unsigned int interfaceNumber, unsigned int location, unsigned short& data, IDeviceContext* caller, double accessTime, unsigned int accessContext)
+{
+	data = ReadArrayValue(location);
+	return true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+IBusInterface::AccessResult RAM16::WriteInterfaceFixedWidth(unsigned int interfaceNumber, unsigned int location, unsigned short data, IDeviceContext* caller, double accessTime, unsigned int accessContext)
+{
+	WriteArrayValueWithLockCheckAndRollback(LimitLocationToMemorySize(location), data);
+	return true;
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 // Debug memory access functions
 //----------------------------------------------------------------------------------------------------------------------
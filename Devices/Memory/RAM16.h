@@ -14,6 +14,11 @@ public:
 	virtual void TransparentReadInterface(unsigned int interfaceNumber, unsigned int location, Data& data, IDeviceContext* caller, unsigned int accessContext);
 	virtual void TransparentWriteInterface(unsigned int interfaceNumber, unsigned int location, const Data& data, IDeviceContext* caller, unsigned int accessContext);
 
+	// Fixed width memory interface functions
+	virtual unsigned int GetFixedWidthInterfaceBitCount(unsigned int interfaceNumber) const;
+	virtual IBusInterface::AccessResult ReadInterfaceFixedWidth(unsigned int interfaceNumber, unsigned int location, unsigned short& data, IDeviceContext* caller, double accessTime, unsigned int accessContext);
+	virtual IBusInterface::AccessResult WriteInterfaceFixedWidth(unsigned int interfaceNumber, unsigned int location, unsigned short data, IDeviceContext* caller, double accessTime, unsigned int accessContext);
+
 	// Debug memory access functions
 	virtual unsigned int ReadMemoryEntry(unsigned int location) const;
 	virtual void WriteMemoryEntry(unsigned int location, unsigned int data);
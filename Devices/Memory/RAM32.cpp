@@ -35,6 +35,28 @@ void RAM32::TransparentWriteInterface(unsigned int interfaceNumber, unsigned int
 	WriteArrayValue(location, (unsigned int)data.GetData());
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+// Fixed width memory interface functions
+//----------------------------------------------------------------------------------------------------------------------
+unsigned int RAM32::GetFixedWidthInterfaceBitCount(unsigned int interfaceNumber) const
+{
+	return 32;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+IBusInterface::AccessResult RAM32::ReadInterfaceFixedWidth(unsigned int interfaceNumber, unsigned int location, unsigned int& data, IDeviceContext* caller, double accessTime, unsigned int accessContext)
+{
+	data = ReadArrayValue(location);
+	return true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+IBusInterface::AccessResult RAM32::WriteInterfaceFixedWidth(unsigned int interfaceNumber, unsigned int location, unsigned int data, IDeviceContext* caller, double accessTime, unsigned int accessContext)
+{
+	WriteArrayValueWithLockCheckAndRollback(LimitLocationToMemorySize(location), data);
+	return true;
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 // Debug memory access functions
 //----------------------------------------------------------------------------------------------------------------------
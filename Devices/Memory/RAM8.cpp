@@ -35,6 +35,28 @@ void RAM8::TransparentWriteInterface(unsigned int interfaceNumber, unsigned int
 	WriteArrayValue(location, (unsigned char)data.GetData());
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+// Fixed width memory interface functions
+//----------------------------------------------------------------------------------------------------------------------
+unsigned int RAM8::GetFixedWidthInterfaceBitCount(unsigned int interfaceNumber) const
+{
+	return 8;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+IBusInterface::AccessResult RAM8::ReadInterfaceFixedWidth(unsigned int interfaceNumber, unsigned int location, unsigned char& data, IDeviceContext* caller, double accessTime, unsigned int accessContext)
+{
+	data = ReadArrayValue(location);
+	return true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+IBusInterface::AccessResult RAM8::WriteInterfaceFixedWidth(unsigned int interfaceNumber, unsigned int location, unsigned char data, IDeviceContext* caller, double accessTime, unsigned int accessContext)
+{
+	WriteArrayValueWithLockCheckAndRollback(location, data);
+	return true;
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 // Debug memory access functions
 //----------------------------------------------------------------------------------------------------------------------
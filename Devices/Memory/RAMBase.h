@@ -3,6 +3,7 @@
 #include "MemoryWrite.h"
 #include <map>
 #include <mutex>
+#include <atomic>
 
 template<class T>
 class RAMBase :public MemoryWrite
@@ -28,6 +29,11 @@ public:
 	virtual void LockMemoryBlock(unsigned int location, unsigned int size, bool state);
 	virtual bool IsAddressLocked(unsigned int location) const;
 
+	// Debug memory block access functions
+	virtual unsigned int GetMemoryBlockGeneration() const;
+	virtual void ReadMemoryBlock(unsigned int byteOffset, unsigned int byteCount, unsigned char* data, unsigned char* lockedData) const;
+	virtual void WriteMemoryBlock(unsigned int byteOffset, unsigned int byteCount, const unsigned char* data);
+
 	// Savestate functions
 	virtual void LoadState(IHierarchicalStorageNode& node);
 	virtual void SaveState(IHierarchicalStorageNode& node) const;
@@ -36,6 +42,14 @@ public:
 	virtual void LoadDebuggerState(IHierarchicalStorageNode& node);
 	virtual void SaveDebuggerState(IHierarchicalStorageNode& node) const;
 
+	// Incremental savestate functions
+	virtual bool IsIncrementalStateSupported() const;
+	virtual unsigned int GetIncrementalStateSize() const;
+	virtual unsigned int AdvanceStateGeneration();
+	virtual bool GetStateChangedRegions(unsigned int sinceGeneration, const Marshal::Out<std::vector<StateRegion>>& regions) const;
+	virtual void ReadStateRegion(unsigned int offset, unsigned int size, unsigned char* data) const;
+	virtual void WriteStateRegion(unsigned int offset, unsigned int size, const unsigned char* data);
+
 protected:
 	// Access helper functions
 	inline T ReadArrayValue(unsigned int arrayEntryPos) const;
@@ -46,6 +60,17 @@ protected:
 	inline unsigned int LimitLocationToMemorySize(unsigned int location) const;
 
 private:
+	// Constants
+	static const unsigned int StatePageSizeInBytes = 0x100;
+
+private:
+	// Debug memory block access functions
+	inline void NotifyMemoryBlockChanged();
+
+	// Incremental savestate functions
+	inline void MarkStatePageChanged(unsigned int arrayEntryPos);
+	void MarkAllStatePagesChanged();
+
 	// Memory location functions
 	unsigned int LimitMemoryLocationToMemorySizePowerOfTwo(unsigned int location) const;
 	unsigned int LimitMemoryLocationToMemorySizeNonPowerOfTwo(unsigned int location) const;
@@ -64,6 +89,10 @@ private:
 	bool* _memoryLockedArray;
 	std::unordered_map<unsigned int, T> _buffer;
 	mutable std::mutex _bufferMutex;
+
+	unsigned int _stateGeneration;
+	std::vector<unsigned int> _statePageGeneration;
+	std::atomic<unsigned int> _memoryBlockGeneration;
 };
 
 #include "RAMBase.inl"
@@ -3,7 +3,7 @@
 //----------------------------------------------------------------------------------------------------------------------
 template<class T>
 RAMBase<T>::RAMBase(const std::wstring& implementationName, const std::wstring& instanceName, unsigned int moduleID)
-:MemoryWrite(implementationName, instanceName, moduleID), _memoryArraySize(0), _memoryArray(0), _memoryLockedArray(0), _initialMemoryDataSpecified(false), _repeatInitialMemoryData(false), _dataIsPersistent(false)
+:MemoryWrite(implementationName, instanceName, moduleID), _memoryArraySize(0), _memoryArray(0), _memoryLockedArray(0), _initialMemoryDataSpecified(false), _repeatInitialMemoryData(false), _dataIsPersistent(false), _stateGeneration(1), _memoryBlockGeneration(1)
 { }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -47,6 +47,12 @@ bool RAMBase<T>::Construct(IHierarchicalStorageNode& node)
 	_memoryLockedArray = new bool[_memoryArraySize];
 	memset(&_memoryLockedArray[0], 0, (_memoryArraySize * sizeof(bool)));
 
+	// Allocate the page generation table used to track which areas of the memory array have changed between state
+	// captures. All pages start out tagged with the current generation, so that they're all reported as changed
+	// relative to generation 0.
+	unsigned int statePageCount = (((_memoryArraySize * memoryArrayEntryByteSize) + (StatePageSizeInBytes - 1)) / StatePageSizeInBytes);
+	_statePageGeneration.assign(statePageCount, _stateGeneration);
+
 	// Read the PersistentData attribute if specified
 	IHierarchicalStorageAttribute* persistentDataAttribute = node.GetAttribute(L"PersistentData");
 	if (persistentDataAttribute != 0)
@@ -128,6 +134,8 @@ void RAMBase<T>::Initialize()
 			_memoryArray[i] = initialValue;
 		}
 	}
+	MarkAllStatePagesChanged();
+	NotifyMemoryBlockChanged();
 
 	// Initialize rollback state
 	std::lock_guard<std::mutex> lock(_bufferMutex);
@@ -176,6 +184,11 @@ void RAMBase<T>::ExecuteRollback()
 	for (const auto& i : _buffer)
 	{
 		_memoryArray[i.first] = i.second;
+		MarkStatePageChanged(i.first);
+	}
+	if (!_buffer.empty())
+	{
+		NotifyMemoryBlockChanged();
 	}
 	_buffer.clear();
 }
@@ -205,6 +218,7 @@ void RAMBase<T>::LockMemoryBlock(unsigned int location, unsigned int size, bool
 	{
 		_memoryLockedArray[location + i] = state;
 	}
+	NotifyMemoryBlockChanged();
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -214,6 +228,75 @@ bool RAMBase<T>::IsAddressLocked(unsigned int location) const
 	return _memoryLockedArray[location];
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+// Debug memory block access functions
+//----------------------------------------------------------------------------------------------------------------------
+template<class T>
+unsigned int RAMBase<T>::GetMemoryBlockGeneration() const
+{
+	return _memoryBlockGeneration.load(std::memory_order_relaxed);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+template<class T>
+void RAMBase<T>::ReadMemoryBlock(unsigned int byteOffset, unsigned int byteCount, unsigned char* data, unsigned char* lockedData) const
+{
+	// Copy the requested range while holding the buffer lock, so that we can't observe a
+	// rollback operation which has only been partially applied. Where each memory entry is
+	// a single byte, the memory array already matches the requested layout, and the range
+	// can be copied directly.
+	std::lock_guard<std::mutex> lock(_bufferMutex);
+	if (sizeof(T) == 1)
+	{
+		memcpy(data, &_memoryArray[byteOffset], byteCount);
+	}
+	else
+	{
+		for (unsigned int byteNoInBlock = 0; byteNoInBlock < byteCount; ++byteNoInBlock)
+		{
+			unsigned int arrayEntryPos = ((byteOffset + byteNoInBlock) / (unsigned int)sizeof(T));
+			unsigned int byteNoInEntry = ((byteOffset + byteNoInBlock) % (unsigned int)sizeof(T));
+			unsigned int byteShift = ((((unsigned int)sizeof(T) - 1) - byteNoInEntry) * Data::BitsPerByte);
+			data[byteNoInBlock] = (unsigned char)(_memoryArray[arrayEntryPos] >> byteShift);
+		}
+	}
+	if (lockedData != 0)
+	{
+		for (unsigned int byteNoInBlock = 0; byteNoInBlock < byteCount; ++byteNoInBlock)
+		{
+			lockedData[byteNoInBlock] = _memoryLockedArray[(byteOffset + byteNoInBlock) / (unsigned int)sizeof(T)]? 1: 0;
+		}
+	}
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+template<class T>
+void RAMBase<T>::WriteMemoryBlock(unsigned int byteOffset, unsigned int byteCount, const unsigned char* data)
+{
+	std::lock_guard<std::mutex> lock(_bufferMutex);
+	for (unsigned int byteNoInBlock = 0; byteNoInBlock < byteCount; ++byteNoInBlock)
+	{
+		unsigned int arrayEntryPos = ((byteOffset + byteNoInBlock) / (unsigned int)sizeof(T));
+		unsigned int byteNoInEntry = ((byteOffset + byteNoInBlock) % (unsigned int)sizeof(T));
+		unsigned int byteShift = ((((unsigned int)sizeof(T) - 1) - byteNoInEntry) * Data::BitsPerByte);
+		T byteMask = (T)((T)0xFF << byteShift);
+		_memoryArray[arrayEntryPos] = (T)((_memoryArray[arrayEntryPos] & ~byteMask) | ((T)data[byteNoInBlock] << byteShift));
+		MarkStatePageChanged(arrayEntryPos);
+	}
+	NotifyMemoryBlockChanged();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+template<class T>
+void RAMBase<T>::NotifyMemoryBlockChanged()
+{
+	// This is called on every write to memory, so we avoid an atomic read-modify-write
+	// operation here. The generation only serves as a hint to the debugger that the memory
+	// contents may have changed, and if two writers race, the generation still changes
+	// even if one of the increments is lost.
+	_memoryBlockGeneration.store(_memoryBlockGeneration.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 // Access helper functions
 //----------------------------------------------------------------------------------------------------------------------
@@ -227,7 +310,10 @@ T RAMBase<T>::ReadArrayValue(unsigned int arrayEntryPos) const
 template<class T>
 void RAMBase<T>::WriteArrayValue(unsigned int arrayEntryPos, T newValue)
 {
-	_memoryArray[LimitLocationToMemorySize(arrayEntryPos)] = newValue;
+	arrayEntryPos = LimitLocationToMemorySize(arrayEntryPos);
+	_memoryArray[arrayEntryPos] = newValue;
+	MarkStatePageChanged(arrayEntryPos);
+	NotifyMemoryBlockChanged();
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -244,6 +330,8 @@ void RAMBase<T>::WriteArrayValueWithLockCheckAndRollback(unsigned int arrayEntry
 		std::lock_guard<std::mutex> lock(_bufferMutex);
 		_buffer.insert(std::make_pair(arrayEntryPos, _memoryArray[arrayEntryPos]));
 		_memoryArray[arrayEntryPos] = newValue;
+		MarkStatePageChanged(arrayEntryPos);
+		NotifyMemoryBlockChanged();
 	}
 }
 
@@ -266,6 +354,8 @@ void RAMBase<T>::LoadState(IHierarchicalStorageNode& node)
 	{
 		memset(&_memoryArray[entriesToLoad], 0, (entriesToFill * sizeof(T)));
 	}
+	MarkAllStatePagesChanged();
+	NotifyMemoryBlockChanged();
 
 	MemoryWrite::LoadState(node);
 }
@@ -298,6 +388,8 @@ void RAMBase<T>::LoadPersistentState(IHierarchicalStorageNode& node)
 		{
 			memset(&_memoryArray[entriesToLoad], 0, (entriesToFill * sizeof(T)));
 		}
+		MarkAllStatePagesChanged();
+		NotifyMemoryBlockChanged();
 	}
 
 	MemoryWrite::LoadPersistentState(node);
@@ -352,3 +444,108 @@ void RAMBase<T>::SaveDebuggerState(IHierarchicalStorageNode& node) const
 
 	MemoryWrite::SaveDebuggerState(node);
 }
+
+//----------------------------------------------------------------------------------------------------------------------
+// Incremental savestate functions
+//----------------------------------------------------------------------------------------------------------------------
+template<class T>
+bool RAMBase<T>::IsIncrementalStateSupported() const
+{
+	return true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+template<class T>
+unsigned int RAMBase<T>::GetIncrementalStateSize() const
+{
+	return (_memoryArraySize * (unsigned int)sizeof(T));
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+template<class T>
+unsigned int RAMBase<T>::AdvanceStateGeneration()
+{
+	// Close off the current generation and return its number to the caller. Any page written from this point on will
+	// be tagged with a later generation number, so it will be reported as changed when compared against the returned
+	// generation.
+	return _stateGeneration++;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+template<class T>
+bool RAMBase<T>::GetStateChangedRegions(unsigned int sinceGeneration, const Marshal::Out<std::vector<StateRegion>>& regions) const
+{
+	// Build a list of changed regions, merging runs of adjacent changed pages into a single region
+	std::vector<StateRegion> changedRegions;
+	unsigned int memoryArraySizeInBytes = (_memoryArraySize * (unsigned int)sizeof(T));
+	unsigned int statePageCount = (unsigned int)_statePageGeneration.size();
+	unsigned int pageNo = 0;
+	while (pageNo < statePageCount)
+	{
+		if (_statePageGeneration[pageNo] <= sinceGeneration)
+		{
+			++pageNo;
+			continue;
+		}
+		unsigned int firstPageNo = pageNo;
+		while ((pageNo < statePageCount) && (_statePageGeneration[pageNo] > sinceGeneration))
+		{
+			++pageNo;
+		}
+		unsigned int regionOffset = (firstPageNo * StatePageSizeInBytes);
+		unsigned int regionEnd = (pageNo * StatePageSizeInBytes);
+		regionEnd = (regionEnd > memoryArraySizeInBytes)? memoryArraySizeInBytes: regionEnd;
+		changedRegions.push_back(StateRegion(regionOffset, regionEnd - regionOffset));
+	}
+	regions = changedRegions;
+	return true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+template<class T>
+void RAMBase<T>::ReadStateRegion(unsigned int offset, unsigned int size, unsigned char* data) const
+{
+	// The incremental state image is the memory array in native byte order. It's only ever restored into the same
+	// device instance it was read from, so no byte swapping is required here.
+	unsigned int memoryArraySizeInBytes = (_memoryArraySize * (unsigned int)sizeof(T));
+	if ((offset >= memoryArraySizeInBytes) || (size > (memoryArraySizeInBytes - offset)))
+	{
+		return;
+	}
+	std::lock_guard<std::mutex> lock(_bufferMutex);
+	memcpy(data, (const unsigned char*)_memoryArray + offset, size);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+template<class T>
+void RAMBase<T>::WriteStateRegion(unsigned int offset, unsigned int size, const unsigned char* data)
+{
+	unsigned int memoryArraySizeInBytes = (_memoryArraySize * (unsigned int)sizeof(T));
+	if ((offset >= memoryArraySizeInBytes) || (size > (memoryArraySizeInBytes - offset)) || (size == 0))
+	{
+		return;
+	}
+	std::lock_guard<std::mutex> lock(_bufferMutex);
+	memcpy((unsigned char*)_memoryArray + offset, data, size);
+	unsigned int firstPageNo = (offset / StatePageSizeInBytes);
+	unsigned int lastPageNo = ((offset + size - 1) / StatePageSizeInBytes);
+	for (unsigned int pageNo = firstPageNo; pageNo <= lastPageNo; ++pageNo)
+	{
+		_statePageGeneration[pageNo] = _stateGeneration;
+	}
+	NotifyMemoryBlockChanged();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+template<class T>
+void RAMBase<T>::MarkStatePageChanged(unsigned int arrayEntryPos)
+{
+	_statePageGeneration[(arrayEntryPos * (unsigned int)sizeof(T)) / StatePageSizeInBytes] = _stateGeneration;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+template<class T>
+void RAMBase<T>::MarkAllStatePagesChanged()
+{
+	_statePageGeneration.assign(_statePageGeneration.size(), _stateGeneration);
+}
@@ -12,7 +12,7 @@ ROM16::ROM16(const std::wstring& implementationName, const std::wstring& instanc
 //----------------------------------------------------------------------------------------------------------------------
 IBusInterface::AccessResult ROM16::ReadInterface(unsigned int interfaceNumber, unsigned int location, Data& data, IDeviceContext* caller, double accessTime, unsigned int accessContext)
 {
-	data = _memoryArray[LimitLocationToMemorySize(location)];
+	data = ReadArrayValue(location);
 	return true;
 }
 
@@ -25,13 +25,34 @@ IBusInterface::AccessResult ROM16::WriteInterface(unsigned int interfaceNumber,
 //----------------------------------------------------------------------------------------------------------------------
 void ROM16::TransparentReadInterface(unsigned int interfaceNumber, unsigned int location, Data& data, IDeviceContext* caller, unsigned int accessContext)
 {
-	data = _memoryArray[LimitLocationToMemorySize(location)];
+	data = ReadArrayValue(location);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 void ROM16::TransparentWriteInterface(unsigned int interfaceNumber, unsigned int location, const Data& data, IDeviceContext* caller, unsigned int accessContext)
 {
-	_memoryArray[LimitLocationToMemorySize(location)] = (unsigned short)data.GetData();
+	WriteArrayValue(location, (unsigned short)data.GetData());
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Fixed width memory interface functions
+//----------------------------------------------------------------------------------------------------------------------
+unsigned int ROM16::GetFixedWidthInterfaceBitCount(unsigned int interfaceNumber) const
+{
+	return 16;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+IBusInterface::AccessResult ROM16::ReadInterfaceFixedWidth(unsigned int interfaceNumber, unsigned int location, unsigned short& data, IDeviceContext* caller, double accessTime, unsigned int accessContext)
+{
+	data = ReadArrayValue(location);
+	return true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+IBusInterface::AccessResult ROM16::WriteInterfaceFixedWidth(unsigned int interfaceNumber, unsigned int location, unsigned short data, IDeviceContext* caller, double accessTime, unsigned int accessContext)
+{
+	return true;
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -39,11 +60,11 @@ void ROM16::TransparentWriteInterface(unsigned int interfaceNumber, unsigned int
 //----------------------------------------------------------------------------------------------------------------------
 unsigned int ROM16::ReadMemoryEntry(unsigned int location) const
 {
-	return _memoryArray[LimitLocationToMemorySize(location)];
+	return ReadArrayValue(location);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 void ROM16::WriteMemoryEntry(unsigned int location, unsigned int data)
 {
-	_memoryArray[LimitLocationToMemorySize(location)] = (unsigned short)data;
+	WriteArrayValue(location, (unsigned short)data);
 }
@@ -12,7 +12,7 @@ ROM32::ROM32(const std::wstring& implementationName, const std::wstring& instanc
 //----------------------------------------------------------------------------------------------------------------------
 IBusInterface::AccessResult ROM32::ReadInterface(unsigned int interfaceNumber, unsigned int location, Data& data, IDeviceContext* caller, double accessTime, unsigned int accessContext)
 {
-	data = _memoryArray[LimitLocationToMemorySize(location)];
+	data = ReadArrayValue(location);
 	return true;
 }
 
@@ -25,13 +25,34 @@ IBusInterface::AccessResult ROM32::WriteInterface(unsigned int interfaceNumber,
 //----------------------------------------------------------------------------------------------------------------------
 void ROM32::TransparentReadInterface(unsigned int interfaceNumber, unsigned int location, Data& data, IDeviceContext* caller, unsigned int accessContext)
 {
-	data = _memoryArray[LimitLocationToMemorySize(location)];
+	data = ReadArrayValue(location);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 void ROM32::TransparentWriteInterface(unsigned int interfaceNumber, unsigned int location, const Data& data, IDeviceContext* caller, unsigned int accessContext)
 {
-	_memoryArray[LimitLocationToMemorySize(location)] = (unsigned int)data.GetData();
+	WriteArrayValue(location, (unsigned int)data.GetData());
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Fixed width memory interface functions
+//----------------------------------------------------------------------------------------------------------------------
+unsigned int ROM32::GetFixedWidthInterfaceBitCount(unsigned int interfaceNumber) const
+{
+	return 32;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+IBusInterface::AccessResult ROM32::ReadInterfaceFixedWidth(unsigned int interfaceNumber, unsigned int location, unsigned int& data, IDeviceContext* caller, double accessTime, unsigned int accessContext)
+{
+	data = ReadArrayValue(location);
+	return true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+IBusInterface::AccessResult ROM32::WriteInterfaceFixedWidth(unsigned int interfaceNumber, unsigned int location, unsigned int data, IDeviceContext* caller, double accessTime, unsigned int accessContext)
+{
+	return true;
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -39,11 +60,11 @@ void ROM32::TransparentWriteInterface(unsigned int interfaceNumber, unsigned int
 //----------------------------------------------------------------------------------------------------------------------
 unsigned int ROM32::ReadMemoryEntry(unsigned int location) const
 {
-	return _memoryArray[LimitLocationToMemorySize(location)];
+	return ReadArrayValue(location);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 void ROM32::WriteMemoryEntry(unsigned int location, unsigned int data)
 {
-	_memoryArray[LimitLocationToMemorySize(location)] = data;
+	WriteArrayValue(location, data);
 }
@@ -12,7 +12,7 @@ ROM8::ROM8(const std::wstring& implementationName, const std::wstring& instanceN
 //----------------------------------------------------------------------------------------------------------------------
 IBusInterface::AccessResult ROM8::ReadInterface(unsigned int interfaceNumber, unsigned int location, Data& data, IDeviceContext* caller, double accessTime, unsigned int accessContext)
 {
-	data = _memoryArray[LimitLocationToMemorySize(location)];
+	data = ReadArrayValue(location);
 	return true;
 }
 
@@ -25,13 +25,34 @@ IBusInterface::AccessResult ROM8::WriteInterface(unsigned int interfaceNumber, u
 //----------------------------------------------------------------------------------------------------------------------
 void ROM8::TransparentReadInterface(unsigned int interfaceNumber, unsigned int location, Data& data, IDeviceContext* caller, unsigned int accessContext)
 {
-	data = _memoryArray[LimitLocationToMemorySize(location)];
+	data = ReadArrayValue(location);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 void ROM8::TransparentWriteInterface(unsigned int interfaceNumber, unsigned int location, const Data& data, IDeviceContext* caller, unsigned int accessContext)
 {
-	_memoryArray[LimitLocationToMemorySize(location)] = (unsigned char)data.GetData();
+	WriteArrayValue(location, (unsigned char)data.GetData());
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Fixed width memory interface functions
+//----------------------------------------------------------------------------------------------------------------------
+unsigned int ROM8::GetFixedWidthInterfaceBitCount(unsigned int interfaceNumber) const
+{
+	return 8;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+IBusInterface::AccessResult ROM8::ReadInterfaceFixedWidth(unsigned int interfaceNumber, unsigned int location, unsigned char& data, IDeviceContext* caller, double accessTime, unsigned int accessContext)
+{
+	data = ReadArrayValue(location);
+	return true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+IBusInterface::AccessResult ROM8::WriteInterfaceFixedWidth(unsigned int interfaceNumber, unsigned int location, unsigned char data, IDeviceContext* caller, double accessTime, unsigned int accessContext)
+{
+	return true;
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -39,11 +60,11 @@ void ROM8::TransparentWriteInterface(unsigned int interfaceNumber, unsigned int
 //----------------------------------------------------------------------------------------------------------------------
 unsigned int ROM8::ReadMemoryEntry(unsigned int location) const
 {
-	return _memoryArray[LimitLocationToMemorySize(location)];
+	return ReadArrayValue(location);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 void ROM8::WriteMemoryEntry(unsigned int location, unsigned int data)
 {
-	_memoryArray[LimitLocationToMemorySize(location)] = (unsigned char)data;
+	WriteArrayValue(location, (unsigned char)data);
 }
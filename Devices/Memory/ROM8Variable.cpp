@@ -20,19 +20,19 @@ IBusInterface::AccessResult ROM8Variable::ReadInterface(unsigned int interfaceNu
 		unsigned int dataByteSize = data.GetByteSize();
 		for (unsigned int i = 0; i < dataByteSize; ++i)
 		{
-			data.SetByteFromTopDown(i, _memoryArray[LimitLocationToMemorySize(location + i)]);
+			data.SetByteFromTopDown(i, ReadArrayValue(location + i));
 		}
 		break;}
 	case 1:
-		data = _memoryArray[LimitLocationToMemorySize(location)];
+		data = ReadArrayValue(location);
 		break;
 	case 2:{
 		unsigned int baseLocation = location * (interfaceNumber / arrayEntryByteSize);
-		data = ((unsigned int)_memoryArray[LimitLocationToMemorySize(baseLocation)] << (arrayEntryByteSize * Data::BitsPerByte)) | (unsigned int)_memoryArray[LimitLocationToMemorySize(baseLocation + 1)];
+		data = ((unsigned int)ReadArrayValue(baseLocation) << (arrayEntryByteSize * Data::BitsPerByte)) | (unsigned int)ReadArrayValue(baseLocation + 1);
 		break;}
 	case 4:{
 		unsigned int baseLocation = location * (interfaceNumber / arrayEntryByteSize);
-		data = ((unsigned int)_memoryArray[LimitLocationToMemorySize(baseLocation)] << (arrayEntryByteSize * 3 * Data::BitsPerByte)) | ((unsigned int)_memoryArray[LimitLocationToMemorySize(baseLocation + 1)] << (arrayEntryByteSize * 2 * Data::BitsPerByte)) | ((unsigned int)_memoryArray[LimitLocationToMemorySize(baseLocation + 2)] << (arrayEntryByteSize * 1 * Data::BitsPerByte)) | (unsigned int)_memoryArray[LimitLocationToMemorySize(baseLocation + 3)];
+		data = ((unsigned int)ReadArrayValue(baseLocation) << (arrayEntryByteSize * 3 * Data::BitsPerByte)) | ((unsigned int)ReadArrayValue(baseLocation + 1) << (arrayEntryByteSize * 2 * Data::BitsPerByte)) | ((unsigned int)ReadArrayValue(baseLocation + 2) << (arrayEntryByteSize * 1 * Data::BitsPerByte)) | (unsigned int)ReadArrayValue(baseLocation + 3);
 		break;}
 	}
 	return true;
@@ -61,23 +61,23 @@ void ROM8Variable::TransparentWriteInterface(unsigned int interfaceNumber, unsig
 		unsigned int dataByteSize = data.GetByteSize();
 		for (unsigned int i = 0; i < dataByteSize; ++i)
 		{
-			_memoryArray[LimitLocationToMemorySize(location + i)] = data.GetByteFromTopDown(i);
+			WriteArrayValue(location + i, data.GetByteFromTopDown(i));
 		}
 		break;}
 	case 1:
-		_memoryArray[LimitLocationToMemorySize(location)] = (unsigned char)data.GetData();
+		WriteArrayValue(location, (unsigned char)data.GetData());
 		break;
 	case 2:{
 		unsigned int baseLocation = location * (interfaceNumber / arrayEntryByteSize);
-		_memoryArray[LimitLocationToMemorySize(baseLocation)] = data.GetByteFromTopDown(0);
-		_memoryArray[LimitLocationToMemorySize(baseLocation + 1)] = data.GetByteFromTopDown(1);
+		WriteArrayValue(baseLocation, data.GetByteFromTopDown(0));
+		WriteArrayValue(baseLocation + 1, data.GetByteFromTopDown(1));
 		break;}
 	case 4:{
 		unsigned int baseLocation = location * (interfaceNumber / arrayEntryByteSize);
-		_memoryArray[LimitLocationToMemorySize(baseLocation)] = data.GetByteFromTopDown(0);
-		_memoryArray[LimitLocationToMemorySize(baseLocation + 1)] = data.GetByteFromTopDown(1);
-		_memoryArray[LimitLocationToMemorySize(baseLocation + 2)] = data.GetByteFromTopDown(2);
-		_memoryArray[LimitLocationToMemorySize(baseLocation + 3)] = data.GetByteFromTopDown(3);
+		WriteArrayValue(baseLocation, data.GetByteFromTopDown(0));
+		WriteArrayValue(baseLocation + 1, data.GetByteFromTopDown(1));
+		WriteArrayValue(baseLocation + 2, data.GetByteFromTopDown(2));
+		WriteArrayValue(baseLocation + 3, data.GetByteFromTopDown(3));
 		break;}
 	}
 }
@@ -87,11 +87,11 @@ void ROM8Variable::TransparentWriteInterface(unsigned int interfaceNumber, unsig
 //----------------------------------------------------------------------------------------------------------------------
 unsigned int ROM8Variable::ReadMemoryEntry(unsigned int location) const
 {
-	return _memoryArray[LimitLocationToMemorySize(location)];
+	return ReadArrayValue(location);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 void ROM8Variable::WriteMemoryEntry(unsigned int location, unsigned int data)
 {
-	_memoryArray[LimitLocationToMemorySize(location)] = (unsigned char)data;
+	WriteArrayValue(location, (unsigned char)data);
 }
@@ -1,6 +1,8 @@
 #ifndef __ROMBASE_H__
 #define __ROMBASE_H__
 #include "MemoryRead.h"
+#include "Stream/Stream.pkg"
+#include <atomic>
 
 template<class T>
 class ROMBase :public MemoryRead
@@ -16,22 +18,42 @@ public:
 	// Memory size functions
 	virtual unsigned int GetMemoryEntrySizeInBytes() const;
 
+	// Debug memory block access functions
+	virtual unsigned int GetMemoryBlockGeneration() const;
+	virtual void ReadMemoryBlock(unsigned int byteOffset, unsigned int byteCount, unsigned char* data, unsigned char* lockedData) const;
+
 protected:
+	// Access helper functions
+	inline T ReadArrayValue(unsigned int location) const;
+	inline void WriteArrayValue(unsigned int location, T newValue);
+
 	// Memory location functions
 	inline unsigned int LimitLocationToMemorySize(unsigned int location) const;
 
 private:
+	// Initialization functions
+	bool ConstructFromMappedFile(IHierarchicalStorageNode& node, const std::wstring& filePath);
+	void SetMemoryArraySize(unsigned int memoryArraySize);
+
+	// Access helper functions
+	static inline T ReadBigEndianEntry(const unsigned char* entryData);
+	static inline void WriteBigEndianEntry(unsigned char* entryData, T newValue);
+
+	// Debug memory block access functions
+	inline void NotifyMemoryBlockChanged();
+
 	// Memory location functions
 	unsigned int LimitMemoryLocationToMemorySizePowerOfTwo(unsigned int location) const;
 	unsigned int LimitMemoryLocationToMemorySizeNonPowerOfTwo(unsigned int location) const;
 
-protected:
-	T* _memoryArray;
-
 private:
+	unsigned char* _memoryArray;
+	Stream::FileMapping _fileMapping;
+	unsigned char* _memoryArrayData;
 	unsigned int _memoryArraySize;
 	unsigned int _memoryArraySizeMask;
 	unsigned int (ROMBase::*_memoryLimitFunction)(unsigned int) const;
+	std::atomic<unsigned int> _memoryBlockGeneration;
 };
 
 #include "ROMBase.inl"
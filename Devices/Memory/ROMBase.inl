@@ -3,14 +3,14 @@
 //----------------------------------------------------------------------------------------------------------------------
 template<class T>
 ROMBase<T>::ROMBase(const std::wstring& implementationName, const std::wstring& instanceName, unsigned int moduleID)
-:MemoryRead(implementationName, instanceName, moduleID), _memoryArraySize(0), _memoryArray(0)
+:MemoryRead(implementationName, instanceName, moduleID), _memoryArraySize(0), _memoryArray(0), _memoryArrayData(0), _memoryBlockGeneration(1)
 { }
 
 //----------------------------------------------------------------------------------------------------------------------
 template<class T>
 ROMBase<T>::~ROMBase()
 {
-	delete _memoryArray;
+	delete[] _memoryArray;
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -24,6 +24,35 @@ bool ROMBase<T>::Construct(IHierarchicalStorageNode& node)
 	// Obtain the size in bytes of a single entry in the memory array
 	unsigned int memoryArrayEntryByteSize = (unsigned int)sizeof(T);
 
+	// If the ROM data has been supplied as a file to map directly rather than as loaded
+	// binary data, attempt to map the file now. If the file can't be mapped, or the
+	// requested memory layout can't be represented by the file mapping, we fall back to
+	// loading the file contents into our binary data stream, and construct the memory
+	// array from it in the same way as any other embedded ROM data.
+	_fileMapping.Close();
+	_memoryArrayData = 0;
+	IHierarchicalStorageAttribute* mappedBinaryDataPathAttribute = node.GetAttribute(L"MappedBinaryDataPath");
+	if (mappedBinaryDataPathAttribute != 0)
+	{
+		std::wstring mappedBinaryDataPath = mappedBinaryDataPathAttribute->GetValue();
+		if (ConstructFromMappedFile(node, mappedBinaryDataPath))
+		{
+			return result;
+		}
+		if (!_fileMapping.IsOpen() && !_fileMapping.Open(mappedBinaryDataPath))
+		{
+			return false;
+		}
+		Stream::IStream& dataStream = node.GetBinaryDataBufferStream();
+		dataStream.SetStreamPos(0);
+		if (!dataStream.WriteData(_fileMapping.GetData(), (Stream::IStream::SizeType)_fileMapping.Size()))
+		{
+			return false;
+		}
+		_fileMapping.Close();
+		node.SetBinaryDataPresent(true);
+	}
+
 	// If embedded ROM data has been specified, attempt to load it now.
 	if (node.GetBinaryDataPresent())
 	{
@@ -65,19 +94,17 @@ bool ROMBase<T>::Construct(IHierarchicalStorageNode& node)
 		// Set the memory array size based on the recorded memory entry count. Note that at
 		// this point, the memory entry count has already been adjusted to a clean multiple
 		// of the array entry byte size.
-		_memoryArraySize = memoryEntryCount;
-
-		// Determine which memory limit function to use based on the memory size. Since this will be hit very often, we
-		// use a member function pointer here as an optimization.
-		_memoryArraySizeMask = (_memoryArraySize - 1);
-		bool memorySizeIsPowerOfTwo = ((_memoryArraySize & _memoryArraySizeMask) == 0);
-		_memoryLimitFunction = (memorySizeIsPowerOfTwo ? &ROMBase::LimitMemoryLocationToMemorySizePowerOfTwo : &ROMBase::LimitMemoryLocationToMemorySizeNonPowerOfTwo);
+		SetMemoryArraySize(memoryEntryCount);
 
 		// Resize the internal memory array based on the calculated array size, and
-		// initialize all elements to 0.
-		delete _memoryArray;
-		_memoryArray = new T[_memoryArraySize];
-		memset(&_memoryArray[0], 0, (_memoryArraySize * memoryArrayEntryByteSize));
+		// initialize all elements to 0. Note that the memory array holds each entry in big
+		// endian form, as it appears in the ROM data, so that it has the same layout as a
+		// mapped ROM file.
+		unsigned int memoryArrayByteSize = (_memoryArraySize * memoryArrayEntryByteSize);
+		delete[] _memoryArray;
+		_memoryArray = new unsigned char[memoryArrayByteSize];
+		memset(&_memoryArray[0], 0, memoryArrayByteSize);
+		_memoryArrayData = _memoryArray;
 
 		// Read the RepeatData attribute if specified
 		bool repeatData = false;
@@ -87,76 +114,113 @@ bool ROMBase<T>::Construct(IHierarchicalStorageNode& node)
 			repeatData = repeatDataAttribute->ExtractValue<bool>();
 		}
 
-		// Read in the ROM data
+		// Read in the ROM data. If the ROM data doesn't align with a whole entry in the
+		// array, the missing lower data in the last entry is left padded out with zeros.
 		unsigned int dataStreamByteSize = (unsigned int)dataStream.Size();
-		unsigned int entriesInDataStream = (dataStreamByteSize / memoryArrayEntryByteSize);
-		unsigned int entriesToRead = (_memoryArraySize < entriesInDataStream)? _memoryArraySize: entriesInDataStream;
-		if (!dataStream.ReadDataBigEndian(&_memoryArray[0], entriesToRead))
+		unsigned int bytesToRead = (memoryArrayByteSize < dataStreamByteSize)? memoryArrayByteSize: dataStreamByteSize;
+		if (!dataStream.ReadData(&_memoryArray[0], bytesToRead))
 		{
 			return false;
 		}
 
-		// If there is more space available in the memory array after reading in the ROM
-		// data entries above, and there is remaining data in the ROM data stream that
-		// doesn't align with a whole entry in the array, read in the remaining data into
-		// the next array entry, and pad out the missing lower data with zeros.
-		unsigned int bytesRemainingInDataStream = (dataStreamByteSize % memoryArrayEntryByteSize);
-		if ((_memoryArraySize > entriesInDataStream) && (bytesRemainingInDataStream > 0))
-		{
-			// Read in each remaining byte in the data stream into the next available array
-			// entry
-			for (unsigned int i = 0; i < bytesRemainingInDataStream; ++i)
-			{
-				unsigned char remainingData;
-				if (!dataStream.ReadDataBigEndian(remainingData))
-				{
-					return false;
-				}
-				_memoryArray[entriesToRead] = (T)((_memoryArray[entriesToRead] << 8) | remainingData);
-			}
-
-			// Shift the data in the entry up by the required number of bits to align the
-			// partial data read with the top of the entry, and pad out the lower bits with
-			// zeros.
-			_memoryArray[entriesToRead] <<= (8 * (memoryArrayEntryByteSize - bytesRemainingInDataStream));
-		}
-
 		// If the data string has been set to repeat until the end of the memory block is
-		// reached, fill out the remainder of the memory block now.
-		if (repeatData)
+		// reached, fill out the remainder of the memory block now. Note that only whole
+		// entries from the ROM data are repeated.
+		unsigned int entryBytesInDataStream = ((dataStreamByteSize / memoryArrayEntryByteSize) * memoryArrayEntryByteSize);
+		if (repeatData && (entryBytesInDataStream > 0))
 		{
-			for (unsigned int i = entriesToRead; i < _memoryArraySize; ++i)
+			for (unsigned int i = entryBytesInDataStream; i < memoryArrayByteSize; ++i)
 			{
-				unsigned int originalDataIndex = i % entriesInDataStream;
-				_memoryArray[i] = _memoryArray[originalDataIndex];
+				_memoryArray[i] = _memoryArray[i % entryBytesInDataStream];
 			}
 		}
 	}
 	else
 	{
 		// If no embedded ROM data has been provided, validate the specified memory entry count.
-		_memoryArraySize = GetMemoryEntryCount();
-		if (_memoryArraySize <= 0)
+		if (GetMemoryEntryCount() <= 0)
 		{
 			return false;
 		}
-
-		// Determine which memory limit function to use based on the memory size. Since this will be hit very often, we
-		// use a member function pointer here as an optimization.
-		_memoryArraySizeMask = (_memoryArraySize - 1);
-		bool memorySizeIsPowerOfTwo = ((_memoryArraySize & _memoryArraySizeMask) == 0);
-		_memoryLimitFunction = (memorySizeIsPowerOfTwo ? &ROMBase::LimitMemoryLocationToMemorySizePowerOfTwo : &ROMBase::LimitMemoryLocationToMemorySizeNonPowerOfTwo);
+		SetMemoryArraySize(GetMemoryEntryCount());
 
 		// Resize the internal memory array based on the calculated array size, and
 		// initialize all elements to 0.
-		delete _memoryArray;
-		_memoryArray = new T[_memoryArraySize];
-		memset(&_memoryArray[0], 0, (_memoryArraySize * memoryArrayEntryByteSize));
+		unsigned int memoryArrayByteSize = (_memoryArraySize * memoryArrayEntryByteSize);
+		delete[] _memoryArray;
+		_memoryArray = new unsigned char[memoryArrayByteSize];
+		memset(&_memoryArray[0], 0, memoryArrayByteSize);
+		_memoryArrayData = _memoryArray;
 	}
 
 	return result;
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+template<class T>
+bool ROMBase<T>::ConstructFromMappedFile(IHierarchicalStorageNode& node, const std::wstring& filePath)
+{
+	// Map the target file. Note that we request a copy on write mapping here, so that the
+	// debugger is still able to modify ROM contents. Any pages which are modified become
+	// private to this device, while unmodified pages remain shared with any other mapping
+	// of the same file.
+	if (!_fileMapping.Open(filePath, true))
+	{
+		return false;
+	}
+
+	// Calculate the number of array entries covered by the file. If the file size isn't a
+	// clean multiple of the array entry size, the last entry is padded out with zeros.
+	// Since the file mapping is always padded out to a whole page with zeros, this padding
+	// is provided for us by the mapped view.
+	unsigned int memoryArrayEntryByteSize = (unsigned int)sizeof(T);
+	unsigned int mappedEntryCount = (unsigned int)((_fileMapping.Size() + (memoryArrayEntryByteSize - 1)) / memoryArrayEntryByteSize);
+
+	// Read the RepeatData attribute if specified
+	bool repeatData = false;
+	IHierarchicalStorageAttribute* repeatDataAttribute = node.GetAttribute(L"RepeatData");
+	if (repeatDataAttribute != 0)
+	{
+		repeatData = repeatDataAttribute->ExtractValue<bool>();
+	}
+
+	// Ensure the requested memory layout can be represented using the mapped file data.
+	// If no entry count has been specified, the memory size is defined by the file size.
+	// If an entry count has been specified, the memory can only be mapped directly if it
+	// matches the file size, or if the data is set to repeat and the memory size is an
+	// exact multiple of the file size, in which case the mirroring is performed by our
+	// memory limit function rather than by duplicating the data.
+	unsigned int memoryEntryCount = GetMemoryEntryCount();
+	if (memoryEntryCount <= 0)
+	{
+		SetMemoryEntryCount(mappedEntryCount);
+	}
+	else if ((memoryEntryCount != mappedEntryCount) && (!repeatData || ((memoryEntryCount % mappedEntryCount) != 0)))
+	{
+		return false;
+	}
+
+	// Bind to the mapped data
+	delete[] _memoryArray;
+	_memoryArray = 0;
+	_memoryArrayData = _fileMapping.GetWritableData();
+	SetMemoryArraySize(mappedEntryCount);
+	return true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+template<class T>
+void ROMBase<T>::SetMemoryArraySize(unsigned int memoryArraySize)
+{
+	_memoryArraySize = memoryArraySize;
+
+	// Determine which memory limit function to use based on the memory size. Since this will be hit very often, we
+	// use a member function pointer here as an optimization.
+	_memoryArraySizeMask = (_memoryArraySize - 1);
+	bool memorySizeIsPowerOfTwo = ((_memoryArraySize & _memoryArraySizeMask) == 0);
+	_memoryLimitFunction = (memorySizeIsPowerOfTwo ? &ROMBase::LimitMemoryLocationToMemorySizePowerOfTwo : &ROMBase::LimitMemoryLocationToMemorySizeNonPowerOfTwo);
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 // Memory size functions
 //----------------------------------------------------------------------------------------------------------------------
@@ -166,6 +230,122 @@ unsigned int ROMBase<T>::GetMemoryEntrySizeInBytes() const
 	return sizeof(T);
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+// Debug memory block access functions
+//----------------------------------------------------------------------------------------------------------------------
+template<class T>
+unsigned int ROMBase<T>::GetMemoryBlockGeneration() const
+{
+	return _memoryBlockGeneration.load(std::memory_order_relaxed);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+template<class T>
+void ROMBase<T>::ReadMemoryBlock(unsigned int byteOffset, unsigned int byteCount, unsigned char* data, unsigned char* lockedData) const
+{
+	// Copy the requested range of memory. Our memory data is always stored in the same big
+	// endian form as the requested layout, so we can copy each run of data up to the end of
+	// the array in a single operation. Note that the memory may be mirrored beyond the end
+	// of the array, so the location of each run is limited to the memory size.
+	unsigned int memoryArrayByteSize = (_memoryArraySize * (unsigned int)sizeof(T));
+	unsigned int byteNoInBlock = 0;
+	while (byteNoInBlock < byteCount)
+	{
+		unsigned int arrayEntryPos = LimitLocationToMemorySize((byteOffset + byteNoInBlock) / (unsigned int)sizeof(T));
+		unsigned int byteNoInEntry = ((byteOffset + byteNoInBlock) % (unsigned int)sizeof(T));
+		unsigned int arrayBytePos = ((arrayEntryPos * (unsigned int)sizeof(T)) + byteNoInEntry);
+		unsigned int copySize = (byteCount - byteNoInBlock);
+		copySize = (copySize < (memoryArrayByteSize - arrayBytePos))? copySize: (memoryArrayByteSize - arrayBytePos);
+		memcpy(&data[byteNoInBlock], &_memoryArrayData[arrayBytePos], copySize);
+		byteNoInBlock += copySize;
+	}
+
+	// Memory locking isn't supported for ROM devices, so no data is ever locked.
+	if (lockedData != 0)
+	{
+		memset(lockedData, 0, byteCount);
+	}
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+template<class T>
+void ROMBase<T>::NotifyMemoryBlockChanged()
+{
+	// Transparent writes and debugger writes call this once per array entry, so a plain
+	// load and store is used rather than an atomic increment. The generation is only a
+	// change hint for the memory editor, so a lost increment from a racing write is
+	// harmless as long as the value still moves.
+	_memoryBlockGeneration.store(_memoryBlockGeneration.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Access helper functions
+//----------------------------------------------------------------------------------------------------------------------
+template<class T>
+T ROMBase<T>::ReadArrayValue(unsigned int location) const
+{
+	return ReadBigEndianEntry(&_memoryArrayData[(size_t)LimitLocationToMemorySize(location) * sizeof(T)]);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+template<class T>
+void ROMBase<T>::WriteArrayValue(unsigned int location, T newValue)
+{
+	WriteBigEndianEntry(&_memoryArrayData[(size_t)LimitLocationToMemorySize(location) * sizeof(T)], newValue);
+	NotifyMemoryBlockChanged();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Memory data is held in big endian form, as it appears in the ROM file, whether it's
+// mapped directly from the file or loaded into our own memory array. Since the array
+// entry type is fixed for each device, we provide a specialised conversion for each entry
+// width here rather than assembling entries byte by byte in a loop on every access.
+//----------------------------------------------------------------------------------------------------------------------
+template<>
+inline unsigned char ROMBase<unsigned char>::ReadBigEndianEntry(const unsigned char* entryData)
+{
+	return *entryData;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+template<>
+inline unsigned short ROMBase<unsigned short>::ReadBigEndianEntry(const unsigned char* entryData)
+{
+	return (unsigned short)(((unsigned int)entryData[0] << 8) | (unsigned int)entryData[1]);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+template<>
+inline unsigned int ROMBase<unsigned int>::ReadBigEndianEntry(const unsigned char* entryData)
+{
+	return ((unsigned int)entryData[0] << 24) | ((unsigned int)entryData[1] << 16) | ((unsigned int)entryData[2] << 8) | (unsigned int)entryData[3];
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+template<>
+inline void ROMBase<unsigned char>::WriteBigEndianEntry(unsigned char* entryData, unsigned char newValue)
+{
+	*entryData = newValue;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+template<>
+inline void ROMBase<unsigned short>::WriteBigEndianEntry(unsigned char* entryData, unsigned short newValue)
+{
+	entryData[0] = (unsigned char)(newValue >> 8);
+	entryData[1] = (unsigned char)newValue;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+template<>
+inline void ROMBase<unsigned int>::WriteBigEndianEntry(unsigned char* entryData, unsigned int newValue)
+{
+	entryData[0] = (unsigned char)(newValue >> 24);
+	entryData[1] = (unsigned char)(newValue >> 16);
+	entryData[2] = (unsigned char)(newValue >> 8);
+	entryData[3] = (unsigned char)newValue;
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 // Memory location functions
 //----------------------------------------------------------------------------------------------------------------------
@@ -4,7 +4,7 @@
 // Constructors
 //----------------------------------------------------------------------------------------------------------------------
 SharedRAM::SharedRAM(const std::wstring& implementationName, const std::wstring& instanceName, unsigned int moduleID)
-:MemoryWrite(implementationName, instanceName, moduleID)
+:MemoryWrite(implementationName, instanceName, moduleID), _bufferGeneration(1), _memoryBlockGeneration(1)
 { }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -17,6 +17,7 @@ bool SharedRAM::Construct(IHierarchicalStorageNode& node)
 	}
 	_memory.resize(GetMemoryEntryCount());
 	_memoryLocked.resize(GetMemoryEntryCount());
+	_bufferIndex.resize(GetMemoryEntryCount());
 	return result;
 }
 
@@ -35,9 +36,10 @@ void SharedRAM::Initialize()
 {
 	// Initialize the memory buffer
 	_memory.assign(GetMemoryEntryCount(), 0);
+	NotifyMemoryBlockChanged();
 
 	// Initialize rollback state
-	_buffer.clear();
+	ClearAccessBuffer();
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -48,16 +50,37 @@ void SharedRAM::ExecuteRollback()
 	std::unique_lock<std::mutex> lock(_accessLock);
 	for (MemoryAccessBuffer::const_iterator i = _buffer.begin(); i != _buffer.end(); ++i)
 	{
-		_memory[i->first] = i->second.data;
+		_memory[i->location] = i->data;
 	}
-	_buffer.clear();
+	if (!_buffer.empty())
+	{
+		NotifyMemoryBlockChanged();
+	}
+	ClearAccessBuffer();
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 void SharedRAM::ExecuteCommit()
 {
 	std::unique_lock<std::mutex> lock(_accessLock);
+	ClearAccessBuffer();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Rollback functions
+//----------------------------------------------------------------------------------------------------------------------
+void SharedRAM::ClearAccessBuffer()
+{
+	// Advance the buffer generation, which invalidates every entry in the index array
+	// without needing to visit it. If the generation counter wraps around, we reset the
+	// index array so that no stale entries can match the new generation.
 	_buffer.clear();
+	++_bufferGeneration;
+	if (_bufferGeneration == 0)
+	{
+		_bufferIndex.assign(_bufferIndex.size(), MemoryAccessIndexEntry());
+		_bufferGeneration = 1;
+	}
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -67,18 +90,22 @@ IBusInterface::AccessResult SharedRAM::ReadInterface(unsigned int interfaceNumbe
 {
 	std::unique_lock<std::mutex> lock(_accessLock);
 
+	unsigned int memorySize = (unsigned int)_memory.size();
 	unsigned int dataByteSize = data.GetByteSize();
 	for (unsigned int i = 0; i < dataByteSize; ++i)
 	{
-		MemoryAccessBuffer::iterator bufferEntryIterator = _buffer.find(location + i);
-		if (bufferEntryIterator == _buffer.end())
+		unsigned int bytePos = (location + i) % memorySize;
+		MemoryAccessIndexEntry& indexEntry = _bufferIndex[bytePos];
+		if (indexEntry.generation != _bufferGeneration)
 		{
 			// If the location hasn't been tagged, mark it
-			_buffer.insert(MemoryAccessBufferEntry(location + i, MemoryWriteStatus(false, _memory[(location + i) % _memory.size()], caller, accessTime, accessContext)));
+			indexEntry.generation = _bufferGeneration;
+			indexEntry.bufferIndex = (unsigned int)_buffer.size();
+			_buffer.push_back(MemoryWriteStatus(bytePos, false, _memory[bytePos], caller, accessTime, accessContext));
 		}
 		else
 		{
-			MemoryWriteStatus* bufferEntry = &bufferEntryIterator->second;
+			MemoryWriteStatus* bufferEntry = &_buffer[indexEntry.bufferIndex];
 			// If the location was tagged by a different author, mark it as shared
 			bufferEntry->shared |= (bufferEntry->author != caller);
 			double originalAccessTime = bufferEntry->timeslice;
@@ -95,7 +122,7 @@ IBusInterface::AccessResult SharedRAM::ReadInterface(unsigned int interfaceNumbe
 				GetSystemInterface().SetSystemRollback(GetDeviceContext(), bufferEntry->author, bufferEntry->timeslice, conflictTime, bufferEntry->accessContext);
 			}
 		}
-		data.SetByteFromTopDown(i, _memory[(location + i) % _memory.size()]);
+		data.SetByteFromTopDown(i, _memory[bytePos]);
 	}
 
 	return true;
@@ -106,21 +133,24 @@ IBusInterface::AccessResult SharedRAM::WriteInterface(unsigned int interfaceNumb
 {
 	std::unique_lock<std::mutex> lock(_accessLock);
 
+	unsigned int memorySize = (unsigned int)_memory.size();
 	unsigned int dataByteSize = data.GetByteSize();
 	for (unsigned int i = 0; i < dataByteSize; ++i)
 	{
-		unsigned int bytePos = (location + i) % (unsigned int)_memory.size();
-		if (!IsAddressLocked(bytePos))
+		unsigned int bytePos = (location + i) % memorySize;
+		if (_memoryLocked[bytePos] == 0)
 		{
-			MemoryAccessBuffer::iterator bufferEntryIterator = _buffer.find(location + i);
-			if (bufferEntryIterator == _buffer.end())
+			MemoryAccessIndexEntry& indexEntry = _bufferIndex[bytePos];
+			if (indexEntry.generation != _bufferGeneration)
 			{
 				// If the location hasn't been tagged, mark it
-				_buffer.insert(MemoryAccessBufferEntry(bytePos, MemoryWriteStatus(true, _memory[bytePos], caller, accessTime, accessContext)));
+				indexEntry.generation = _bufferGeneration;
+				indexEntry.bufferIndex = (unsigned int)_buffer.size();
+				_buffer.push_back(MemoryWriteStatus(bytePos, true, _memory[bytePos], caller, accessTime, accessContext));
 			}
 			else
 			{
-				MemoryWriteStatus* bufferEntry = &bufferEntryIterator->second;
+				MemoryWriteStatus* bufferEntry = &_buffer[indexEntry.bufferIndex];
 				bool previousWriteOccurred = bufferEntry->written;
 				bufferEntry->written = true;
 				// If the location was tagged by a different author, mark it as shared
@@ -142,6 +172,7 @@ IBusInterface::AccessResult SharedRAM::WriteInterface(unsigned int interfaceNumb
 			_memory[bytePos] = data.GetByteFromTopDown(i);
 		}
 	}
+	NotifyMemoryBlockChanged();
 
 	return true;
 }
@@ -164,6 +195,7 @@ void SharedRAM::TransparentWriteInterface(unsigned int interfaceNumber, unsigned
 	{
 		_memory[(location + i) % _memory.size()] = data.GetByteFromTopDown(i);
 	}
+	NotifyMemoryBlockChanged();
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -178,6 +210,45 @@ unsigned int SharedRAM::ReadMemoryEntry(unsigned int location) const
 void SharedRAM::WriteMemoryEntry(unsigned int location, unsigned int data)
 {
 	_memory[location % _memory.size()] = (unsigned char)data;
+	NotifyMemoryBlockChanged();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Debug memory block access functions
+//----------------------------------------------------------------------------------------------------------------------
+unsigned int SharedRAM::GetMemoryBlockGeneration() const
+{
+	return _memoryBlockGeneration.load(std::memory_order_relaxed);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void SharedRAM::ReadMemoryBlock(unsigned int byteOffset, unsigned int byteCount, unsigned char* data, unsigned char* lockedData) const
+{
+	// Copy the requested range while holding the access lock, so that the copy is consistent
+	// with respect to bus accesses and rollback operations.
+	std::unique_lock<std::mutex> lock(_accessLock);
+	memcpy(data, &_memory[byteOffset], byteCount);
+	if (lockedData != 0)
+	{
+		memcpy(lockedData, &_memoryLocked[byteOffset], byteCount);
+	}
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void SharedRAM::WriteMemoryBlock(unsigned int byteOffset, unsigned int byteCount, const unsigned char* data)
+{
+	std::unique_lock<std::mutex> lock(_accessLock);
+	memcpy(&_memory[byteOffset], data, byteCount);
+	NotifyMemoryBlockChanged();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void SharedRAM::NotifyMemoryBlockChanged()
+{
+	// Bus writes call this while holding the access lock, so a plain load and store is
+	// sufficient, and avoids a locked increment on every write. Transparent and debugger
+	// writes may race with it, but the generation still changes if an increment is lost.
+	_memoryBlockGeneration.store(_memoryBlockGeneration.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -193,14 +264,15 @@ void SharedRAM::LockMemoryBlock(unsigned int location, unsigned int size, bool s
 {
 	for (unsigned int i = 0; i < size; ++i)
 	{
-		_memoryLocked[location + i] = state;
+		_memoryLocked[location + i] = (state)? 1: 0;
 	}
+	NotifyMemoryBlockChanged();
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 bool SharedRAM::IsAddressLocked(unsigned int location) const
 {
-	return _memoryLocked[location];
+	return (_memoryLocked[location] != 0);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -215,6 +287,7 @@ void SharedRAM::LoadState(IHierarchicalStorageNode& node)
 	{
 		_memory[i] = 0;
 	}
+	NotifyMemoryBlockChanged();
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -2,8 +2,8 @@
 #define __SHAREDRAM_H__
 #include "MemoryWrite.h"
 #include <mutex>
-#include <map>
 #include <vector>
+#include <atomic>
 
 class SharedRAM :public MemoryWrite
 {
@@ -32,6 +32,11 @@ public:
 	virtual unsigned int ReadMemoryEntry(unsigned int location) const;
 	virtual void WriteMemoryEntry(unsigned int location, unsigned int data);
 
+	// Debug memory block access functions
+	virtual unsigned int GetMemoryBlockGeneration() const;
+	virtual void ReadMemoryBlock(unsigned int byteOffset, unsigned int byteCount, unsigned char* data, unsigned char* lockedData) const;
+	virtual void WriteMemoryBlock(unsigned int byteOffset, unsigned int byteCount, const unsigned char* data);
+
 	// Memory locking functions
 	virtual bool IsMemoryLockingSupported() const;
 	virtual void LockMemoryBlock(unsigned int location, unsigned int size, bool state);
@@ -41,16 +46,24 @@ public:
 	virtual void LoadState(IHierarchicalStorageNode& node);
 	virtual void SaveState(IHierarchicalStorageNode& node) const;
 
+private:
+	// Rollback functions
+	void ClearAccessBuffer();
+
+	// Debug memory block access functions
+	void NotifyMemoryBlockChanged();
+
 private:
 	// Rollback data
 	struct MemoryWriteStatus
 	{
 		MemoryWriteStatus()
 		{ }
-		MemoryWriteStatus(bool awritten, unsigned char adata, IDeviceContext* aauthor, double atimeslice, unsigned int aaccessContext)
-		:written(awritten), shared(false), data(adata), author(aauthor), timeslice(atimeslice), accessContext(aaccessContext)
+		MemoryWriteStatus(unsigned int alocation, bool awritten, unsigned char adata, IDeviceContext* aauthor, double atimeslice, unsigned int aaccessContext)
+		:location(alocation), written(awritten), shared(false), data(adata), author(aauthor), timeslice(atimeslice), accessContext(aaccessContext)
 		{ }
 
+		unsigned int location;
 		bool written;
 		bool shared;
 		unsigned char data;
@@ -58,13 +71,29 @@ private:
 		double timeslice;
 		unsigned int accessContext;
 	};
-	typedef std::map<unsigned int, MemoryWriteStatus> MemoryAccessBuffer;
-	typedef std::pair<unsigned int, MemoryWriteStatus> MemoryAccessBufferEntry;
+	struct MemoryAccessIndexEntry
+	{
+		MemoryAccessIndexEntry()
+		:generation(0), bufferIndex(0)
+		{ }
+
+		unsigned int generation;
+		unsigned int bufferIndex;
+	};
+	typedef std::vector<MemoryWriteStatus> MemoryAccessBuffer;
 
-	std::mutex _accessLock;
+	// Accesses within the current timeslice are recorded in an append-only buffer, with an
+	// entry holding the original value for each address on its first access. The index
+	// array maps each address to its entry in the buffer, where the index entry is only
+	// valid if its generation matches the current buffer generation. This allows the
+	// buffer to be cleared on commit or rollback without visiting the index array.
+	mutable std::mutex _accessLock;
+	unsigned int _bufferGeneration;
+	std::vector<MemoryAccessIndexEntry> _bufferIndex;
 	MemoryAccessBuffer _buffer;
 	std::vector<unsigned char> _memory;
-	std::vector<bool> _memoryLocked;
+	std::vector<unsigned char> _memoryLocked;
+	std::atomic<unsigned int> _memoryBlockGeneration;
 };
 
 #endif
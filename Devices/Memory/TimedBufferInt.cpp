@@ -1,5 +1,26 @@
 #include "TimedBufferInt.h"
 #include "TimedBufferTimeslice.h"
+#include <thread>
+
+//----------------------------------------------------------------------------------------------------------------------
+// Constructors
+//----------------------------------------------------------------------------------------------------------------------
+TimedBufferInt::TimedBufferInt()
+:_snapshotGeneration(0)
+{
+	for (unsigned int i = 0; i < SnapshotBufferCount; ++i)
+	{
+		_snapshotSequenceNo[i].store(0, std::memory_order_relaxed);
+	}
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Interface version functions
+//----------------------------------------------------------------------------------------------------------------------
+unsigned int TimedBufferInt::GetITimedBufferIntVersion() const
+{
+	return ThisITimedBufferIntVersion();
+}
 
 //----------------------------------------------------------------------------------------------------------------------
 // Size functions
@@ -14,6 +35,11 @@ void TimedBufferInt::Resize(unsigned int bufferSize, bool keepLatestBufferCopy)
 {
 	_memory.Resize(bufferSize, keepLatestBufferCopy);
 	_memoryLocked.resize(bufferSize);
+	for (unsigned int i = 0; i < SnapshotBufferCount; ++i)
+	{
+		_snapshotBuffer[i].resize(bufferSize);
+	}
+	InvalidateCommittedSnapshot();
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -31,6 +57,14 @@ void TimedBufferInt::Write(unsigned int address, const DataType& data, const Acc
 	{
 		_memory.Write(address, data, accessTarget);
 	}
+
+	// Writes which directly target the latest or committed state of the buffer are only
+	// made by the debugger, and bypass the commit process, so the published snapshot of
+	// the committed state no longer matches the buffer.
+	if ((accessTarget.target == AccessTarget::TARGET_LATEST) || (accessTarget.target == AccessTarget::TARGET_COMMITTED))
+	{
+		InvalidateCommittedSnapshot();
+	}
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -51,6 +85,7 @@ void TimedBufferInt::Write(unsigned int address, TimesliceType writeTime, const
 //----------------------------------------------------------------------------------------------------------------------
 TimedBufferInt::DataType& TimedBufferInt::ReferenceCommitted(unsigned int address)
 {
+	InvalidateCommittedSnapshot();
 	return _memory.ReferenceCommitted(address);
 }
 
@@ -76,6 +111,7 @@ TimedBufferInt::DataType TimedBufferInt::ReadLatest(unsigned int address) const
 void TimedBufferInt::WriteLatest(unsigned int address, const DataType& data)
 {
 	_memory.WriteLatest(address, data);
+	InvalidateCommittedSnapshot();
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -84,12 +120,19 @@ void TimedBufferInt::GetLatestBufferCopy(DataType* buffer, unsigned int bufferSi
 	_memory.GetLatestBufferCopy(buffer, bufferSize);
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+void TimedBufferInt::GetLatestBufferRange(unsigned int address, DataType* buffer, unsigned int count) const
+{
+	_memory.GetLatestBufferRange(address, buffer, count);
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 // Time management functions
 //----------------------------------------------------------------------------------------------------------------------
 void TimedBufferInt::Initialize()
 {
 	_memory.Initialize();
+	InvalidateCommittedSnapshot();
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -195,12 +238,98 @@ bool TimedBufferInt::IsByteLocked(unsigned int location) const
 	return _memoryLocked[location];
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+// Snapshot functions
+//----------------------------------------------------------------------------------------------------------------------
+void TimedBufferInt::PublishCommittedSnapshot()
+{
+	// Write the committed state into the snapshot buffer which isn't currently published.
+	// The sequence number for the buffer is odd while it is being written, which allows a
+	// reader which was still copying from this buffer since its last publication to detect
+	// that its copy is invalid.
+	unsigned int generation = _snapshotGeneration.load(std::memory_order_acquire);
+	unsigned int nextGeneration = ((generation & ~SnapshotValidFlag) + SnapshotGenerationIncrement) | SnapshotValidFlag;
+	unsigned int targetBufferIndex = GetSnapshotBufferIndex(nextGeneration);
+	std::atomic<unsigned int>& sequenceNo = _snapshotSequenceNo[targetBufferIndex];
+	sequenceNo.fetch_add(1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+	std::vector<DataType>& snapshotBuffer = _snapshotBuffer[targetBufferIndex];
+	if (!snapshotBuffer.empty())
+	{
+		_memory.GetCommittedBufferCopy(&snapshotBuffer[0], (unsigned int)snapshotBuffer.size());
+	}
+	sequenceNo.fetch_add(1, std::memory_order_release);
+
+	// Publish the new snapshot, unless the snapshot was invalidated while we were building
+	// it. Since every invalidation advances the generation, the exchange will fail in that
+	// case, and the snapshot remains withdrawn until the next call.
+	_snapshotGeneration.compare_exchange_strong(generation, nextGeneration, std::memory_order_release, std::memory_order_relaxed);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool TimedBufferInt::GetCommittedSnapshot(DataType* buffer, unsigned int bufferSize) const
+{
+	// Copy the most recently published snapshot, and confirm it wasn't overwritten while we
+	// were copying it. This can only occur if two more snapshots were published during the
+	// copy, so we only need to retry a small number of times. If no snapshot has been
+	// published yet, we fail the request, and the caller needs to fall back to a locked read
+	// of the buffer.
+	for (unsigned int attempt = 0; attempt < MaxSnapshotReadAttempts; ++attempt)
+	{
+		unsigned int generation = _snapshotGeneration.load(std::memory_order_acquire);
+		if ((generation & SnapshotValidFlag) == 0)
+		{
+			return false;
+		}
+		unsigned int sourceBufferIndex = GetSnapshotBufferIndex(generation);
+		const std::atomic<unsigned int>& sequenceNo = _snapshotSequenceNo[sourceBufferIndex];
+		unsigned int initialSequenceNo = sequenceNo.load(std::memory_order_acquire);
+		if ((initialSequenceNo & 1) != 0)
+		{
+			std::this_thread::yield();
+			continue;
+		}
+		const std::vector<DataType>& snapshotBuffer = _snapshotBuffer[sourceBufferIndex];
+		size_t copySize = (bufferSize < snapshotBuffer.size())? (size_t)bufferSize: snapshotBuffer.size();
+		if (copySize > 0)
+		{
+			memcpy((void*)buffer, (const void*)&snapshotBuffer[0], copySize * sizeof(DataType));
+		}
+		std::atomic_thread_fence(std::memory_order_acquire);
+		if (sequenceNo.load(std::memory_order_relaxed) == initialSequenceNo)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void TimedBufferInt::InvalidateCommittedSnapshot()
+{
+	// Withdraw the published snapshot whenever the buffer is changed outside the normal
+	// commit process. Readers fall back to a locked read of the buffer until the next
+	// snapshot is published. Note that we always advance the generation here, even if no
+	// snapshot is currently published, so that a snapshot which was being built from the
+	// old buffer contents when this change was made can't be published afterwards.
+	unsigned int generation = _snapshotGeneration.load(std::memory_order_relaxed);
+	while (!_snapshotGeneration.compare_exchange_weak(generation, (generation & ~SnapshotValidFlag) + SnapshotGenerationIncrement, std::memory_order_release, std::memory_order_relaxed))
+	{ }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+unsigned int TimedBufferInt::GetSnapshotBufferIndex(unsigned int generation)
+{
+	return ((generation / SnapshotGenerationIncrement) % SnapshotBufferCount);
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 // Savestate functions
 //----------------------------------------------------------------------------------------------------------------------
 void TimedBufferInt::LoadState(IHierarchicalStorageNode& node)
 {
 	_memory.LoadState(node);
+	InvalidateCommittedSnapshot();
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -219,6 +348,7 @@ void TimedBufferInt::LoadDebuggerState(IHierarchicalStorageNode& node)
 	{
 		_memoryLocked[i] = 0;
 	}
+	InvalidateCommittedSnapshot();
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -2,10 +2,26 @@
 #define __TIMEDBUFFERINTSHELL_H__
 #include "TimedBuffers/TimedBuffers.pkg"
 #include <vector>
+#include <atomic>
 
+// In addition to the timed buffer itself, this class maintains a published snapshot of the
+// committed buffer state, which is refreshed by the owner of the buffer through calls to
+// PublishCommittedSnapshot(), typically at frame boundaries. The snapshot is held in two
+// buffers which are published alternately, each protected by a sequence number, so that
+// debug views can obtain a consistent copy of the committed state without taking any lock,
+// and without ever stalling the thread which publishes the snapshot. Changes which are made
+// to the buffer outside the commit process withdraw the snapshot by advancing the same
+// generation word which publishes it, so a snapshot which was being built when the change
+// was made is never published.
 class TimedBufferInt :public ITimedBufferInt
 {
 public:
+	// Constructors
+	TimedBufferInt();
+
+	// Interface version functions
+	virtual unsigned int GetITimedBufferIntVersion() const;
+
 	// Size functions
 	virtual unsigned int Size() const;
 	void Resize(unsigned int bufferSize, bool keepLatestBufferCopy = false);
@@ -20,6 +36,7 @@ public:
 	virtual DataType ReadCommitted(unsigned int address, TimesliceType readTime) const;
 	virtual DataType ReadLatest(unsigned int address) const;
 	virtual void WriteLatest(unsigned int address, const DataType& data);
+	void GetLatestBufferRange(unsigned int address, DataType* buffer, unsigned int count) const;
 
 	// Time management functions
 	virtual void Initialize();
@@ -44,6 +61,9 @@ public:
 	virtual void LockMemoryBlock(unsigned int location, unsigned int size, bool state);
 	virtual bool IsByteLocked(unsigned int location) const;
 
+	// Snapshot functions
+	virtual void PublishCommittedSnapshot();
+
 	// Savestate functions
 	void LoadState(IHierarchicalStorageNode& node);
 	void SaveState(IHierarchicalStorageNode& node, const std::wstring& bufferName) const;
@@ -54,9 +74,27 @@ protected:
 	// Access functions
 	virtual void GetLatestBufferCopy(DataType* buffer, unsigned int bufferSize) const;
 
+	// Snapshot functions
+	virtual bool GetCommittedSnapshot(DataType* buffer, unsigned int bufferSize) const;
+
+private:
+	// Constants
+	static const unsigned int SnapshotBufferCount = 2;
+	static const unsigned int MaxSnapshotReadAttempts = 4;
+	static const unsigned int SnapshotValidFlag = 0x1;
+	static const unsigned int SnapshotGenerationIncrement = 0x2;
+
+private:
+	// Snapshot functions
+	void InvalidateCommittedSnapshot();
+	static unsigned int GetSnapshotBufferIndex(unsigned int generation);
+
 private:
 	RandomTimeAccessBuffer<DataType, TimesliceType> _memory;
 	std::vector<bool> _memoryLocked;
+	std::vector<DataType> _snapshotBuffer[SnapshotBufferCount];
+	std::atomic<unsigned int> _snapshotSequenceNo[SnapshotBufferCount];
+	std::atomic<unsigned int> _snapshotGeneration; // Bit 0 is set while a snapshot is published
 };
 
 #endif
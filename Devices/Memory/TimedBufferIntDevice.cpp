@@ -134,6 +134,45 @@ void TimedBufferIntDevice::WriteMemoryEntry(unsigned int location, unsigned int
 	_bufferShell.WriteLatest(location % memorySize, (unsigned char)data);
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+// Debug memory block access functions
+//----------------------------------------------------------------------------------------------------------------------
+void TimedBufferIntDevice::ReadMemoryBlock(unsigned int byteOffset, unsigned int byteCount, unsigned char* data, unsigned char* lockedData) const
+{
+	// Copy the latest state of the requested range of the buffer, with each run of data up
+	// to the end of the buffer copied in a single operation. Note that the memory may be
+	// mirrored beyond the end of the buffer, so the location of each run is limited to the
+	// memory size. Note also that we don't track changes to the buffer here, so the memory
+	// block generation is left as unsupported.
+	unsigned int memorySize = GetMemoryEntryCount();
+	unsigned int byteNoInBlock = 0;
+	while (byteNoInBlock < byteCount)
+	{
+		unsigned int bufferPos = ((byteOffset + byteNoInBlock) % memorySize);
+		unsigned int copySize = (byteCount - byteNoInBlock);
+		copySize = (copySize < (memorySize - bufferPos))? copySize: (memorySize - bufferPos);
+		_bufferShell.GetLatestBufferRange(bufferPos, &data[byteNoInBlock], copySize);
+		byteNoInBlock += copySize;
+	}
+	if (lockedData != 0)
+	{
+		for (unsigned int byteNoInBlock = 0; byteNoInBlock < byteCount; ++byteNoInBlock)
+		{
+			lockedData[byteNoInBlock] = _bufferShell.IsByteLocked((byteOffset + byteNoInBlock) % memorySize)? 1: 0;
+		}
+	}
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void TimedBufferIntDevice::WriteMemoryBlock(unsigned int byteOffset, unsigned int byteCount, const unsigned char* data)
+{
+	unsigned int memorySize = GetMemoryEntryCount();
+	for (unsigned int byteNoInBlock = 0; byteNoInBlock < byteCount; ++byteNoInBlock)
+	{
+		_bufferShell.WriteLatest((byteOffset + byteNoInBlock) % memorySize, data[byteNoInBlock]);
+	}
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 // Savestate functions
 //----------------------------------------------------------------------------------------------------------------------
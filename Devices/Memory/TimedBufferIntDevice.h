@@ -25,6 +25,10 @@ public:
 	virtual unsigned int ReadMemoryEntry(unsigned int location) const;
 	virtual void WriteMemoryEntry(unsigned int location, unsigned int data);
 
+	// Debug memory block access functions
+	virtual void ReadMemoryBlock(unsigned int byteOffset, unsigned int byteCount, unsigned char* data, unsigned char* lockedData) const;
+	virtual void WriteMemoryBlock(unsigned int byteOffset, unsigned int byteCount, const unsigned char* data);
+
 	// Savestate functions
 	virtual void LoadState(IHierarchicalStorageNode& node);
 	virtual void SaveState(IHierarchicalStorageNode& node) const;
@@ -226,6 +226,9 @@ void SN76489::Initialize()
 	//##TODO## Make these power-on defaults configurable through the system XML file
 	_latchedChannel = 1;
 	_latchedVolume = true;
+
+	// Flag that our state has been reset for any debugger views
+	AllGenericDataModified();
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -357,6 +360,9 @@ void SN76489::ExecuteRollback()
 
 	// Clear any uncommitted timeslices from our render timeslice buffers
 	_regTimesliceListUncommitted.clear();
+
+	// Flag that our state has been rolled back for any debugger views
+	AllGenericDataModified();
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -387,6 +393,9 @@ void SN76489::ExecuteCommit()
 		// Notify the render thread that it's got more work to do
 		_renderThreadUpdate.notify_all();
 	}
+
+	// Flag that our committed state may have changed for any debugger views
+	AllGenericDataModified();
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -865,6 +874,9 @@ void SN76489::LoadState(IHierarchicalStorageNode& node)
 			(*i)->ExtractData(_noiseOutputMasked);
 		}
 	}
+
+	// Flag that our state has been replaced for any debugger views
+	AllGenericDataModified();
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -1017,7 +1029,7 @@ bool SN76489::ReadGenericData(unsigned int dataID, const DataContext* dataContex
 }
 
 //----------------------------------------------------------------------------------------------------------------------
-bool SN76489::WriteGenericData(unsigned int dataID, const DataContext* dataContext, IGenericAccessDataValue& dataValue)
+bool SN76489::WriteGenericDataInternal(unsigned int dataID, const DataContext* dataContext, IGenericAccessDataValue& dataValue)
 {
 	//##TODO## Restructure this to be a flat switch statement as per other devices
 	ApplyGenericDataValueLimitSettings(dataID, dataValue);
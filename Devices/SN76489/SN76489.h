@@ -93,9 +93,8 @@ public:
 
 	// Data read/write functions
 	using IGenericAccess::ReadGenericData;
-	using IGenericAccess::WriteGenericData;
 	virtual bool ReadGenericData(unsigned int dataID, const DataContext* dataContext, IGenericAccessDataValue& dataValue) const;
-	virtual bool WriteGenericData(unsigned int dataID, const DataContext* dataContext, IGenericAccessDataValue& dataValue);
+	virtual bool WriteGenericDataInternal(unsigned int dataID, const DataContext* dataContext, IGenericAccessDataValue& dataValue);
 
 	// Data locking functions
 	virtual bool GetGenericDataLocked(unsigned int dataID, const DataContext* dataContext) const;
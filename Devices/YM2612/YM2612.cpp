@@ -476,6 +476,9 @@ void YM2612::Initialize()
 			WriteGenericData(i->dataID, i->GetDataContext(), i->lockedValue);
 		}
 	}
+
+	// Flag that our state has been reset for any debugger views
+	AllGenericDataModified();
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -803,6 +806,9 @@ void YM2612::ExecuteRollback()
 	// Clear any uncommitted timeslices from our render timeslice buffers
 	_regTimesliceListUncommitted.clear();
 	_timerATimesliceListUncommitted.clear();
+
+	// Flag that our state has been rolled back for any debugger views
+	AllGenericDataModified();
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -869,6 +875,9 @@ void YM2612::ExecuteCommit()
 		// Notify the render thread that it's got more work to do
 		_renderThreadUpdate.notify_all();
 	}
+
+	// Flag that our committed state may have changed for any debugger views
+	AllGenericDataModified();
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -2899,6 +2908,9 @@ void YM2612::LoadState(IHierarchicalStorageNode& node)
 			WriteGenericData(i->dataID, i->GetDataContext(), i->lockedValue);
 		}
 	}
+
+	// Flag that our state has been replaced for any debugger views
+	AllGenericDataModified();
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -3398,7 +3410,7 @@ bool YM2612::ReadGenericData(unsigned int dataID, const DataContext* dataContext
 }
 
 //----------------------------------------------------------------------------------------------------------------------
-bool YM2612::WriteGenericData(unsigned int dataID, const DataContext* dataContext, IGenericAccessDataValue& dataValue)
+bool YM2612::WriteGenericDataInternal(unsigned int dataID, const DataContext* dataContext, IGenericAccessDataValue& dataValue)
 {
 	ApplyGenericDataValueLimitSettings(dataID, dataValue);
 	IGenericAccessDataValue::DataType dataType = dataValue.GetType();
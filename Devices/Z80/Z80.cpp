@@ -402,14 +402,13 @@ void Z80::Initialize()
 	_bprocessorStopped = false;
 
 	_lastLineCheckTime = 0;
-	_lineAccessPending = false;
 	_resetLineState = false;
 	_busreqLineState = false;
 	_busackLineState = false;
 	_intLineState = false;
 	_nmiLineState = false;
 	_lastTimesliceLength = 0;
-	_lineAccessBuffer.clear();
+	_lineAccessBuffer.Clear();
 	_suspendUntilLineStateChangeReceived = false;
 
 	Reset();
@@ -431,6 +430,9 @@ void Z80::Initialize()
 
 	// Synchronize the changed register state with the current register state
 	PopulateChangedRegStateFromCurrentState();
+
+	// Flag that our state has been reset for any debugger views
+	AllGenericDataModified();
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -462,6 +464,9 @@ void Z80::Reset()
 	// from a 68K-triggered reset without being 'stuck' in the HALT state."
 
 	ClearCallStack();
+
+	// Flag that our state has been reset for any debugger views
+	AllGenericDataModified();
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -515,29 +520,29 @@ double Z80::ExecuteStep()
 	double additionalTime = 0;
 
 	// If we have any pending line state changes waiting, apply any which we have now
-	// reached.
-	if (_lineAccessPending)
+	// reached. Note that this test is a single relaxed load of the time of the next
+	// pending line state change, so we only need to obtain a lock on lineMutex when a
+	// change is actually due to be applied.
+	double currentTimesliceProgress = GetCurrentTimesliceProgress();
+	if (_lineAccessBuffer.IsEntryDue(currentTimesliceProgress))
 	{
 		//##DEBUG##
 //		std::wcout << "Z80 line access pending\n";
 
 		std::unique_lock<std::mutex> lock(_lineMutex);
-		double currentTimesliceProgress = GetCurrentTimesliceProgress();
 		bool done = false;
 		while (!done)
 		{
 			// Remove the next line access that we've reached from the front of the line
 			// access buffer. Note that our lineMutex lock may be released while applying
 			// some line state changes, so we can't keep active reference to an iterator.
-			std::list<LineAccess>::iterator i = _lineAccessBuffer.begin();
-			if ((i == _lineAccessBuffer.end()) || (i->accessTime > currentTimesliceProgress))
+			if (_lineAccessBuffer.Empty() || (_lineAccessBuffer.Front().accessTime > currentTimesliceProgress))
 			{
 				done = true;
 				continue;
 			}
-			LineAccess lineAccess = *i;
-			_lineAccessBuffer.pop_front();
-			_lineAccessPending = !_lineAccessBuffer.empty();
+			LineAccess lineAccess = _lineAccessBuffer.Front();
+			_lineAccessBuffer.PopFront();
 
 			//##DEBUG##
 			// std::wstringstream logMessage;
@@ -562,19 +567,19 @@ double Z80::ExecuteStep()
 	// If no line access is pending, and we've decided to suspend until another line state
 	// change is received, suspend execution waiting for another line state change to be
 	// received, unless execution suspension has now been disabled.
-	if (!_lineAccessPending && _suspendUntilLineStateChangeReceived && !GetDeviceContext()->TimesliceSuspensionDisabled())
+	if (!_lineAccessBuffer.IsPending() && _suspendUntilLineStateChangeReceived && !GetDeviceContext()->TimesliceSuspensionDisabled())
 	{
-		// Check lineAccessPending again after taking a lock on lineMutex. This will ensure
-		// we never enter a suspend state when there are actually line access events
-		// sitting in the buffer.
+		// Check for pending line access events again after taking a lock on lineMutex.
+		// This will ensure we never enter a suspend state when there are actually line
+		// access events sitting in the buffer.
 		std::unique_lock<std::mutex> lock(_lineMutex);
-		if (!_lineAccessPending)
+		if (_lineAccessBuffer.Empty())
 		{
 			// Suspend timeslice execution, release the lock on lineMutex, then wait until
 			// execution is resumed. It is essential to perform these steps, in this order.
 			// By waiting to release the lock until after we have suspended timeslice
 			// execution, we ensure that no line state changes have sneaked into the buffer
-			// since we tested the value of the lineAccessPending variable. We need to
+			// since we tested the state of the line access buffer. We need to
 			// release this lock before we enter our wait state however, so that other
 			// devices can resume execution of this device by triggering a line state
 			// change. After releasing the lock, we can now safely enter our wait state,
@@ -854,8 +859,7 @@ void Z80::ExecuteRollback()
 	_processorStopped = _bprocessorStopped;
 
 	_lastTimesliceLength = _blastTimesliceLength;
-	_lineAccessBuffer = _blineAccessBuffer;
-	_lineAccessPending = !_lineAccessBuffer.empty();
+	_lineAccessBuffer.Rollback();
 
 	_suspendUntilLineStateChangeReceived = _bsuspendUntilLineStateChangeReceived;
 	_resetLineState = _bresetLineState;
@@ -887,14 +891,7 @@ void Z80::ExecuteCommit()
 	_bprocessorStopped = _processorStopped;
 
 	_blastTimesliceLength = _lastTimesliceLength;
-	if (_lineAccessPending)
-	{
-		_blineAccessBuffer = _lineAccessBuffer;
-	}
-	else
-	{
-		_blineAccessBuffer.clear();
-	}
+	_lineAccessBuffer.Commit();
 
 	_bsuspendUntilLineStateChangeReceived = _suspendUntilLineStateChangeReceived;
 	_bresetLineState = _resetLineState;
@@ -918,14 +915,11 @@ void Z80::NotifyUpcomingTimeslice(double nanoseconds)
 	// Reset lastLineCheckTime for the beginning of the new timeslice, and force any
 	// remaining line state changes to be evaluated at the start of the new timeslice.
 	_lastLineCheckTime = 0;
-	for (std::list<LineAccess>::iterator i = _lineAccessBuffer.begin(); i != _lineAccessBuffer.end(); ++i)
-	{
-		// We rebase accessTime here to the start of the new time block, in order to allow
-		// line state changes to be flagged ahead of the time they actually take effect.
-		// This rebasing allows changes flagged ahead of time to safely cross timeslice
-		// boundaries.
-		i->accessTime -= _lastTimesliceLength;
-	}
+
+	// We rebase accessTime here to the start of the new time block, in order to allow line
+	// state changes to be flagged ahead of the time they actually take effect. This
+	// rebasing allows changes flagged ahead of time to safely cross timeslice boundaries.
+	_lineAccessBuffer.RebaseAccessTimes(-_lastTimesliceLength);
 	_lastTimesliceLength = nanoseconds;
 }
 
@@ -1000,14 +994,6 @@ void Z80::SetLineState(unsigned int targetLine, const Data& lineData, IDeviceCon
 {
 	std::unique_lock<std::mutex> lock(_lineMutex);
 
-	// Flag that an entry exists in the buffer. This flag is used to skip the expensive
-	// locking operation in the active thread for this device when no line changes are
-	// pending. Note that we set this flag before we've actually written the entry into
-	// the buffer, as we want to force the active thread to lock on the beginning of the
-	// next cycle while this function is executing, so that the current timeslice progress
-	// of the device doesn't change after we've read it.
-	_lineAccessPending = true;
-
 	// Read the time at which this access is being made, and trigger a rollback if we've
 	// already passed that time.
 	if (_lastLineCheckTime > accessTime)
@@ -1016,13 +1002,9 @@ void Z80::SetLineState(unsigned int targetLine, const Data& lineData, IDeviceCon
 	}
 
 	// Insert the line access into the buffer. Note that entries in the buffer are sorted
-	// by access time from lowest to highest.
-	std::list<LineAccess>::reverse_iterator i = _lineAccessBuffer.rbegin();
-	while ((i != _lineAccessBuffer.rend()) && (i->accessTime > accessTime))
-	{
-		++i;
-	}
-	_lineAccessBuffer.insert(i.base(), LineAccess(targetLine, lineData, accessTime));
+	// by access time from lowest to highest, and inserting the entry publishes the time of
+	// the next pending change to the execution thread for this device.
+	_lineAccessBuffer.Insert(LineAccess(targetLine, lineData, accessTime));
 
 	// Resume the main execution thread if it is currently suspended waiting for a line
 	// state change to be received.
@@ -1051,31 +1033,24 @@ void Z80::RevokeSetLineState(unsigned int targetLine, const Data& lineData, doub
 	}
 
 	// Find the matching line state change entry in the line access buffer
-	std::list<LineAccess>::reverse_iterator i = _lineAccessBuffer.rbegin();
+	TimedLineAccessQueue<LineAccess>::iterator i = _lineAccessBuffer.End();
 	bool foundTargetEntry = false;
-	while (!foundTargetEntry && (i != _lineAccessBuffer.rend()))
+	while (!foundTargetEntry && (i != _lineAccessBuffer.Begin()))
 	{
-		if ((i->lineID == targetLine) && (i->state == lineData) && (i->accessTime == reportedTime))
-		{
-			foundTargetEntry = true;
-			continue;
-		}
-		++i;
+		--i;
+		foundTargetEntry = ((i->lineID == targetLine) && (i->state == lineData) && (i->accessTime == reportedTime));
 	}
 
 	// Erase the target line state change entry from the line access buffer
 	if (foundTargetEntry)
 	{
-		_lineAccessBuffer.erase((++i).base());
+		_lineAccessBuffer.Erase(i);
 	}
 	else
 	{
 		//##DEBUG##
 		std::wcout << "Failed to find matching line state change in RevokeSetLineState! " << GetLineName(targetLine) << '\t' << lineData.GetData() << '\t' << std::setprecision(24) << reportedTime << '\t' << std::setprecision(24) << accessTime << '\n';
 	}
-
-	// Update the lineAccessPending flag
-	_lineAccessPending = !_lineAccessBuffer.empty();
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -1179,14 +1154,6 @@ void Z80::SetClockSourceRate(unsigned int clockInput, double clockRate, IDeviceC
 	// here, since line state changes and clock changes are basically the same problem.
 	std::unique_lock<std::mutex> lock(_lineMutex);
 
-	// Flag that an entry exists in the buffer. This flag is used to skip the expensive
-	// locking operation in the active thread for this device when no line changes are
-	// pending. Note that we set this flag before we've actually written the entry into
-	// the buffer, as we want to force the active thread to lock on the beginning of the
-	// next cycle while this function is executing, so that the current timeslice progress
-	// of the device doesn't change after we've read it.
-	_lineAccessPending = true;
-
 	// Read the time at which this access is being made, and trigger a rollback if we've
 	// already passed that time.
 	if (_lastLineCheckTime > accessTime)
@@ -1195,13 +1162,9 @@ void Z80::SetClockSourceRate(unsigned int clockInput, double clockRate, IDeviceC
 	}
 
 	// Insert the line access into the buffer. Note that entries in the buffer are sorted
-	// by access time from lowest to highest.
-	std::list<LineAccess>::reverse_iterator i = _lineAccessBuffer.rbegin();
-	while ((i != _lineAccessBuffer.rend()) && (i->accessTime > accessTime))
-	{
-		++i;
-	}
-	_lineAccessBuffer.insert(i.base(), LineAccess(clockInput, clockRate, accessTime));
+	// by access time from lowest to highest, and inserting the entry publishes the time of
+	// the next pending change to the execution thread for this device.
+	_lineAccessBuffer.Insert(LineAccess(clockInput, clockRate, accessTime));
 
 	// Resume the main execution thread if it is currently suspended waiting for a line
 	// state change to be received.
@@ -1638,7 +1601,7 @@ void Z80::LoadState(IHierarchicalStorageNode& node)
 		// Restore the lineAccessBuffer state
 		else if ((*i)->GetName() == L"LineAccessBuffer")
 		{
-			_lineAccessBuffer.clear();
+			_lineAccessBuffer.Clear();
 			IHierarchicalStorageNode& lineAccessBufferNode = *(*i);
 			std::list<IHierarchicalStorageNode*> lineAccessBufferChildList = lineAccessBufferNode.GetChildList();
 			for (std::list<IHierarchicalStorageNode*>::iterator lineAccessBufferEntry = lineAccessBufferChildList.begin(); lineAccessBufferEntry != lineAccessBufferChildList.end(); ++lineAccessBufferEntry)
@@ -1688,21 +1651,15 @@ void Z80::LoadState(IHierarchicalStorageNode& node)
 							}
 						}
 
-						// Find the correct location in the list to insert the entry. The
-						// list must be sorted from earliest to latest.
+						// Insert the entry into the buffer. The buffer keeps entries sorted
+						// from earliest to latest.
 						if (lineAccessDefined)
 						{
-							std::list<LineAccess>::reverse_iterator j = _lineAccessBuffer.rbegin();
-							while ((j != _lineAccessBuffer.rend()) && (j->accessTime > lineAccess.accessTime))
-							{
-								++j;
-							}
-							_lineAccessBuffer.insert(j.base(), lineAccess);
+							_lineAccessBuffer.Insert(lineAccess);
 						}
 					}
 				}
 			}
-			_lineAccessPending = !_lineAccessBuffer.empty();
 		}
 	}
 
@@ -1750,10 +1707,10 @@ void Z80::SaveState(IHierarchicalStorageNode& node) const
 	node.CreateChild(L"Register", _nmiLineState).CreateAttribute(L"name", L"NMILineState");
 
 	// Save the lineAccessBuffer state
-	if (_lineAccessPending)
+	if (!_lineAccessBuffer.Empty())
 	{
 		IHierarchicalStorageNode& lineAccessState = node.CreateChild(L"LineAccessBuffer");
-		for (std::list<LineAccess>::const_iterator i = _lineAccessBuffer.begin(); i != _lineAccessBuffer.end(); ++i)
+		for (TimedLineAccessQueue<LineAccess>::const_iterator i = _lineAccessBuffer.Begin(); i != _lineAccessBuffer.End(); ++i)
 		{
 			IHierarchicalStorageNode& lineAccessEntry = lineAccessState.CreateChild(L"LineAccess");
 			lineAccessEntry.CreateAttribute(L"ClockRateChange", i->clockRateChange);
@@ -1877,7 +1834,7 @@ bool Z80::ReadGenericData(unsigned int dataID, const DataContext* dataContext, I
 }
 
 //----------------------------------------------------------------------------------------------------------------------
-bool Z80::WriteGenericData(unsigned int dataID, const DataContext* dataContext, IGenericAccessDataValue& dataValue)
+bool Z80::WriteGenericDataInternal(unsigned int dataID, const DataContext* dataContext, IGenericAccessDataValue& dataValue)
 {
 	ApplyGenericDataValueLimitSettings(dataID, dataValue);
 	IGenericAccessDataValue::DataType dataType = dataValue.GetType();
@@ -2109,7 +2066,7 @@ bool Z80::WriteGenericData(unsigned int dataID, const DataContext* dataContext,
 		SetFlagC(dataValueAsBool.GetValue());
 		return true;}
 	}
-	return Processor::WriteGenericData(dataID, dataContext, dataValue);
+	return Processor::WriteGenericDataInternal(dataID, dataContext, dataValue);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
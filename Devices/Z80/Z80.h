@@ -34,6 +34,7 @@ References:
 #include "DeviceInterface/DeviceInterface.pkg"
 #include "Processor/Processor.pkg"
 #include "ThreadLib/ThreadLib.pkg"
+#include "TimedBuffers/TimedBuffers.pkg"
 #include "Data.h"
 #include "ExecuteTime.h"
 #include <mutex>
@@ -269,9 +270,8 @@ public:
 
 	// Data read/write functions
 	using IGenericAccess::ReadGenericData;
-	using IGenericAccess::WriteGenericData;
 	virtual bool ReadGenericData(unsigned int dataID, const DataContext* dataContext, IGenericAccessDataValue& dataValue) const;
-	virtual bool WriteGenericData(unsigned int dataID, const DataContext* dataContext, IGenericAccessDataValue& dataValue);
+	virtual bool WriteGenericDataInternal(unsigned int dataID, const DataContext* dataContext, IGenericAccessDataValue& dataValue);
 
 	// Highlight functions
 	virtual bool GetGenericDataHighlightState(unsigned int dataID, const DataContext* dataContext) const;
@@ -395,11 +395,9 @@ private:
 	// Line access
 	std::mutex _lineMutex;
 	mutable double _lastLineCheckTime;
-	volatile bool _lineAccessPending;
 	double _lastTimesliceLength;
 	double _blastTimesliceLength;
-	std::list<LineAccess> _lineAccessBuffer;
-	std::list<LineAccess> _blineAccessBuffer;
+	TimedLineAccessQueue<LineAccess> _lineAccessBuffer;
 	bool _suspendWhenBusReleased;
 	volatile bool _suspendUntilLineStateChangeReceived;
 	bool _bsuspendUntilLineStateChangeReceived;
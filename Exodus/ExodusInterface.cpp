@@ -118,6 +118,7 @@ bool ExodusInterface::InitializePrefs()
 	SetGlobalPreferenceEnablePersistentState(true);
 	SetGlobalPreferenceLoadWorkspaceWithDebugState(true);
 	SetGlobalPreferenceShowDebugConsole(false);
+	SetGlobalPreferenceBinarySavestates(false);
 
 	// Load preferences from the settings.xml file if present
 	LoadPrefs(_preferenceFilePath);
@@ -1299,6 +1300,10 @@ bool ExodusInterface::LoadPrefs(const std::wstring& filePath)
 		{
 			SetGlobalPreferenceShowDebugConsole((*i)->ExtractData<bool>());
 		}
+		else if ((*i)->GetName() == L"BinarySavestates")
+		{
+			SetGlobalPreferenceBinarySavestates((*i)->ExtractData<bool>());
+		}
 	}
 
 	return true;
@@ -1330,6 +1335,7 @@ void ExodusInterface::SavePrefs(const std::wstring& filePath)
 	rootNode.CreateChild(L"EnablePersistentState").SetData(_prefs.enablePersistentState);
 	rootNode.CreateChild(L"LoadWorkspaceWithDebugState").SetData(_prefs.loadWorkspaceWithDebugState);
 	rootNode.CreateChild(L"ShowDebugConsole").SetData(_prefs.showDebugConsole);
+	rootNode.CreateChild(L"BinarySavestates").SetData(_prefs.binarySavestates);
 	for (auto preferenceEntry : _globalPreferences)
 	{
 		rootNode.CreateChild(preferenceEntry.first).SetData(preferenceEntry.second);
@@ -1467,6 +1473,12 @@ bool ExodusInterface::GetGlobalPreferenceShowDebugConsole() const
 	return _prefs.showDebugConsole;
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+bool ExodusInterface::GetGlobalPreferenceBinarySavestates() const
+{
+	return _prefs.binarySavestates;
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 void ExodusInterface::SetGlobalPreferencePathModules(const std::wstring& state)
 {
@@ -1653,6 +1665,14 @@ void ExodusInterface::SetGlobalPreferenceShowDebugConsole(bool state)
 	}
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+void ExodusInterface::SetGlobalPreferenceBinarySavestates(bool state)
+{
+	// Apply the new preference setting
+	_prefs.binarySavestates = state;
+	_system->SetBinarySavestateFormatState(_prefs.binarySavestates);
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 // Assembly functions
 //----------------------------------------------------------------------------------------------------------------------
@@ -2936,6 +2956,12 @@ LRESULT CALLBACK ExodusInterface::WndProc(HWND hwnd, UINT msg, WPARAM wParam, LP
 		case ID_FILE_QUICKLOADSTATE:
 			state->QuickLoadState(false);
 			break;
+		case ID_FILE_CAPTURESTATECHECKPOINT:
+			state->_system->CaptureStateCheckpoint();
+			break;
+		case ID_FILE_RESTORESTATECHECKPOINT:
+			state->_system->RestoreStateCheckpoint();
+			break;
 		case ID_FILE_SAVEDEBUGSTATE:
 			state->SaveState(state->_prefs.pathSavestates, true);
 			break;
@@ -140,6 +140,7 @@ public:
 	virtual bool GetGlobalPreferenceEnablePersistentState() const;
 	virtual bool GetGlobalPreferenceLoadWorkspaceWithDebugState() const;
 	virtual bool GetGlobalPreferenceShowDebugConsole() const;
+	bool GetGlobalPreferenceBinarySavestates() const;
 	void SetGlobalPreferencePathModules(const std::wstring& state);
 	void SetGlobalPreferencePathSavestates(const std::wstring& state);
 	void SetGlobalPreferencePathPersistentState(const std::wstring& state);
@@ -153,6 +154,7 @@ public:
 	void SetGlobalPreferenceEnablePersistentState(bool state);
 	void SetGlobalPreferenceLoadWorkspaceWithDebugState(bool state);
 	void SetGlobalPreferenceShowDebugConsole(bool state);
+	void SetGlobalPreferenceBinarySavestates(bool state);
 
 	// Assembly functions
 	bool LoadAssembliesFromFolder(const std::wstring& folderPath);
@@ -190,6 +192,7 @@ private:
 		bool enablePersistentState;
 		bool loadWorkspaceWithDebugState;
 		bool showDebugConsole;
+		bool binarySavestates;
 	};
 	struct NewMenuItem;
 	struct SavestateCellWindowState;
@@ -61,6 +61,7 @@ INT_PTR SettingsView::msgWM_INITDIALOG(HWND hwnd, WPARAM wparam, LPARAM lparam)
 	CheckDlgButton(hwnd, IDC_SETTINGS_ENABLEPERSISTENTSTATE, _model.GetGlobalPreferenceEnablePersistentState()? BST_CHECKED: BST_UNCHECKED);
 	CheckDlgButton(hwnd, IDC_SETTINGS_LOADWORKSPACEWITHDEBUGSTATE, _model.GetGlobalPreferenceLoadWorkspaceWithDebugState()? BST_CHECKED: BST_UNCHECKED);
 	CheckDlgButton(hwnd, IDC_SETTINGS_SHOWDEBUGCONSOLE, _model.GetGlobalPreferenceShowDebugConsole()? BST_CHECKED: BST_UNCHECKED);
+	CheckDlgButton(hwnd, IDC_SETTINGS_BINARYSAVESTATES, _model.GetGlobalPreferenceBinarySavestates()? BST_CHECKED: BST_UNCHECKED);
 
 	EnableWindow(GetDlgItem(hwnd, IDC_SETTINGS_APPLY), FALSE);
 
@@ -91,6 +92,7 @@ INT_PTR SettingsView::msgWM_COMMAND(HWND hwnd, WPARAM wparam, LPARAM lparam)
 		case IDC_SETTINGS_ENABLEPERSISTENTSTATE:
 		case IDC_SETTINGS_LOADWORKSPACEWITHDEBUGSTATE:
 		case IDC_SETTINGS_SHOWDEBUGCONSOLE:
+		case IDC_SETTINGS_BINARYSAVESTATES:
 			EnableWindow(GetDlgItem(hwnd, IDC_SETTINGS_APPLY), TRUE);
 			break;
 		case IDC_SETTINGS_OK:
@@ -114,6 +116,7 @@ INT_PTR SettingsView::msgWM_COMMAND(HWND hwnd, WPARAM wparam, LPARAM lparam)
 			_model.SetGlobalPreferenceEnablePersistentState(IsDlgButtonChecked(hwnd, IDC_SETTINGS_ENABLEPERSISTENTSTATE) == BST_CHECKED);
 			_model.SetGlobalPreferenceLoadWorkspaceWithDebugState(IsDlgButtonChecked(hwnd, IDC_SETTINGS_LOADWORKSPACEWITHDEBUGSTATE) == BST_CHECKED);
 			_model.SetGlobalPreferenceShowDebugConsole(IsDlgButtonChecked(hwnd, IDC_SETTINGS_SHOWDEBUGCONSOLE) == BST_CHECKED);
+			_model.SetGlobalPreferenceBinarySavestates(IsDlgButtonChecked(hwnd, IDC_SETTINGS_BINARYSAVESTATES) == BST_CHECKED);
 			_model.SavePrefs();
 			EnableWindow(GetDlgItem(hwnd, IDC_SETTINGS_APPLY), FALSE);
 			break;
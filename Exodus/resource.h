@@ -108,6 +108,7 @@
 #define IDC_SETTINGS_SHOWDEBUGCONSOLE   1450
 #define IDC_SETTINGS_ENABLEPERSISTENTSTATE2 1451
 #define IDC_SETTINGS_LOADWORKSPACEWITHDEBUGSTATE 1451
+#define IDC_SETTINGS_BINARYSAVESTATES   1482
 #define IDC_LOADMODULE_MODULETEXT       1461
 #define IDC_UNLOADMODULE_MODULETEXT     1462
 #define IDC_SETTINGS_PATHPERSISTENTSTATECHANGE 1463
@@ -205,6 +206,8 @@
 #define ID_SETTINGS_PLATFORMSETTINGS    40114
 #define ID_SETTINGS_DEBUGCONSOLE        40116
 #define ID_WINDOW_CREATEDASHBOARD       40118
+#define ID_FILE_CAPTURESTATECHECKPOINT  40121
+#define ID_FILE_RESTORESTATECHECKPOINT  40122
 
 // Next default values for new objects
 // 
@@ -212,8 +215,8 @@
 #ifndef APSTUDIO_READONLY_SYMBOLS
 #define _APS_NO_MFC                     1
 #define _APS_NEXT_RESOURCE_VALUE        176
-#define _APS_NEXT_COMMAND_VALUE         40121
-#define _APS_NEXT_CONTROL_VALUE         1482
+#define _APS_NEXT_COMMAND_VALUE         40123
+#define _APS_NEXT_CONTROL_VALUE         1483
 #define _APS_NEXT_SYMED_VALUE           101
 #endif
 #endif
@@ -310,6 +310,42 @@ void Device::LoadDebuggerState(IHierarchicalStorageNode& node)
 void Device::SaveDebuggerState(IHierarchicalStorageNode& node) const
 { }
 
+//----------------------------------------------------------------------------------------------------------------------
+// Incremental savestate functions
+//----------------------------------------------------------------------------------------------------------------------
+bool Device::IsIncrementalStateSupported() const
+{
+	return false;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+unsigned int Device::GetIncrementalStateSize() const
+{
+	return 0;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+unsigned int Device::AdvanceStateGeneration()
+{
+	return 0;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool Device::GetStateChangedRegions(unsigned int sinceGeneration, const Marshal::Out<std::vector<StateRegion>>& regions) const
+{
+	// Devices which don't track changes to their state can't report changed regions. Callers must fall back to the
+	// SaveState and LoadState functions for this device.
+	return false;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void Device::ReadStateRegion(unsigned int offset, unsigned int size, unsigned char* data) const
+{ }
+
+//----------------------------------------------------------------------------------------------------------------------
+void Device::WriteStateRegion(unsigned int offset, unsigned int size, const unsigned char* data)
+{ }
+
 //----------------------------------------------------------------------------------------------------------------------
 // CE line state functions
 //----------------------------------------------------------------------------------------------------------------------
@@ -372,6 +408,62 @@ void Device::TransparentReadInterface(unsigned int interfaceNumber, unsigned int
 void Device::TransparentWriteInterface(unsigned int interfaceNumber, unsigned int location, const Data& data, IDeviceContext* caller, unsigned int accessContext)
 { }
 
+//----------------------------------------------------------------------------------------------------------------------
+// Fixed width memory functions
+//----------------------------------------------------------------------------------------------------------------------
+unsigned int Device::GetFixedWidthInterfaceBitCount(unsigned int interfaceNumber) const
+{
+	// Devices only receive fixed width accesses for interfaces they explicitly opt in to.
+	// A return value of 0 indicates that all accesses should go through the generic Data
+	// based memory functions.
+	return 0;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+IBusInterface::AccessResult Device::ReadInterfaceFixedWidth(unsigned int interfaceNumber, unsigned int location, unsigned char& data, IDeviceContext* caller, double accessTime, unsigned int accessContext)
+{
+	Data genericData(8);
+	IBusInterface::AccessResult accessResult = ReadInterface(interfaceNumber, location, genericData, caller, accessTime, accessContext);
+	data = (unsigned char)genericData.GetData();
+	return accessResult;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+IBusInterface::AccessResult Device::ReadInterfaceFixedWidth(unsigned int interfaceNumber, unsigned int location, unsigned short& data, IDeviceContext* caller, double accessTime, unsigned int accessContext)
+{
+	Data genericData(16);
+	IBusInterface::AccessResult accessResult = ReadInterface(interfaceNumber, location, genericData, caller, accessTime, accessContext);
+	data = (unsigned short)genericData.GetData();
+	return accessResult;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+IBusInterface::AccessResult Device::ReadInterfaceFixedWidth(unsigned int interfaceNumber, unsigned int location, unsigned int& data, IDeviceContext* caller, double accessTime, unsigned int accessContext)
+{
+	Data genericData(32);
+	IBusInterface::AccessResult accessResult = ReadInterface(interfaceNumber, location, genericData, caller, accessTime, accessContext);
+	data = (unsigned int)genericData.GetData();
+	return accessResult;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+IBusInterface::AccessResult Device::WriteInterfaceFixedWidth(unsigned int interfaceNumber, unsigned int location, unsigned char data, IDeviceContext* caller, double accessTime, unsigned int accessContext)
+{
+	return WriteInterface(interfaceNumber, location, Data(8, data), caller, accessTime, accessContext);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+IBusInterface::AccessResult Device::WriteInterfaceFixedWidth(unsigned int interfaceNumber, unsigned int location, unsigned short data, IDeviceContext* caller, double accessTime, unsigned int accessContext)
+{
+	return WriteInterface(interfaceNumber, location, Data(16, data), caller, accessTime, accessContext);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+IBusInterface::AccessResult Device::WriteInterfaceFixedWidth(unsigned int interfaceNumber, unsigned int location, unsigned int data, IDeviceContext* caller, double accessTime, unsigned int accessContext)
+{
+	return WriteInterface(interfaceNumber, location, Data(32, data), caller, accessTime, accessContext);
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 // Port functions
 //----------------------------------------------------------------------------------------------------------------------
@@ -79,6 +79,14 @@ public:
 	virtual void LoadDebuggerState(IHierarchicalStorageNode& node);
 	virtual void SaveDebuggerState(IHierarchicalStorageNode& node) const;
 
+	// Incremental savestate functions
+	virtual bool IsIncrementalStateSupported() const;
+	virtual unsigned int GetIncrementalStateSize() const;
+	virtual unsigned int AdvanceStateGeneration();
+	virtual bool GetStateChangedRegions(unsigned int sinceGeneration, const Marshal::Out<std::vector<StateRegion>>& regions) const;
+	virtual void ReadStateRegion(unsigned int offset, unsigned int size, unsigned char* data) const;
+	virtual void WriteStateRegion(unsigned int offset, unsigned int size, const unsigned char* data);
+
 	// CE line state functions
 	virtual unsigned int GetCELineID(const Marshal::In<std::wstring>& lineName, bool inputLine) const;
 	virtual void SetCELineInput(unsigned int lineID, bool lineMapped, unsigned int lineStartBitNumber);
@@ -94,6 +102,15 @@ public:
 	virtual void TransparentReadInterface(unsigned int interfaceNumber, unsigned int location, Data& data, IDeviceContext* caller, unsigned int accessContext);
 	virtual void TransparentWriteInterface(unsigned int interfaceNumber, unsigned int location, const Data& data, IDeviceContext* caller, unsigned int accessContext);
 
+	// Fixed width memory functions
+	virtual unsigned int GetFixedWidthInterfaceBitCount(unsigned int interfaceNumber) const;
+	virtual IBusInterface::AccessResult ReadInterfaceFixedWidth(unsigned int interfaceNumber, unsigned int location, unsigned char& data, IDeviceContext* caller, double accessTime, unsigned int accessContext);
+	virtual IBusInterface::AccessResult ReadInterfaceFixedWidth(unsigned int interfaceNumber, unsigned int location, unsigned short& data, IDeviceContext* caller, double accessTime, unsigned int accessContext);
+	virtual IBusInterface::AccessResult ReadInterfaceFixedWidth(unsigned int interfaceNumber, unsigned int location, unsigned int& data, IDeviceContext* caller, double accessTime, unsigned int accessContext);
+	virtual IBusInterface::AccessResult WriteInterfaceFixedWidth(unsigned int interfaceNumber, unsigned int location, unsigned char data, IDeviceContext* caller, double accessTime, unsigned int accessContext);
+	virtual IBusInterface::AccessResult WriteInterfaceFixedWidth(unsigned int interfaceNumber, unsigned int location, unsigned short data, IDeviceContext* caller, double accessTime, unsigned int accessContext);
+	virtual IBusInterface::AccessResult WriteInterfaceFixedWidth(unsigned int interfaceNumber, unsigned int location, unsigned int data, IDeviceContext* caller, double accessTime, unsigned int accessContext);
+
 	// Port functions
 	virtual IBusInterface::AccessResult ReadPort(unsigned int interfaceNumber, unsigned int location, Data& data, IDeviceContext* caller, double accessTime, unsigned int accessContext);
 	virtual IBusInterface::AccessResult WritePort(unsigned int interfaceNumber, unsigned int location, const Data& data, IDeviceContext* caller, double accessTime, unsigned int accessContext);
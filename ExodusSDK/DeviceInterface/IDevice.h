@@ -7,6 +7,7 @@
 #include "HierarchicalStorageInterface/HierarchicalStorageInterface.pkg"
 #include <string>
 #include <list>
+#include <vector>
 class Data;
 class ISystemDeviceInterface;
 class IDeviceContext;
@@ -20,12 +21,15 @@ public:
 	// Enumerations
 	enum class UpdateMethod;
 
+	// Structures
+	struct StateRegion;
+
 public:
 	// Constructors
 	inline virtual ~IDevice() = 0;
 
 	// Interface version functions
-	static inline unsigned int ThisIDeviceVersion() { return 1; }
+	static inline unsigned int ThisIDeviceVersion() { return 3; }
 	virtual unsigned int GetIDeviceVersion() const = 0;
 
 	// Initialization functions
@@ -151,6 +155,23 @@ public:
 	virtual Marshal::Ret<std::wstring> GetKeyCodeName(unsigned int keyCodeID) const = 0;
 	virtual void HandleInputKeyDown(unsigned int keyCodeID) = 0;
 	virtual void HandleInputKeyUp(unsigned int keyCodeID) = 0;
+
+	// Fixed width memory functions
+	virtual unsigned int GetFixedWidthInterfaceBitCount(unsigned int interfaceNumber) const = 0;
+	virtual IBusInterface::AccessResult ReadInterfaceFixedWidth(unsigned int interfaceNumber, unsigned int location, unsigned char& data, IDeviceContext* caller, double accessTime, unsigned int accessContext) = 0;
+	virtual IBusInterface::AccessResult ReadInterfaceFixedWidth(unsigned int interfaceNumber, unsigned int location, unsigned short& data, IDeviceContext* caller, double accessTime, unsigned int accessContext) = 0;
+	virtual IBusInterface::AccessResult ReadInterfaceFixedWidth(unsigned int interfaceNumber, unsigned int location, unsigned int& data, IDeviceContext* caller, double accessTime, unsigned int accessContext) = 0;
+	virtual IBusInterface::AccessResult WriteInterfaceFixedWidth(unsigned int interfaceNumber, unsigned int location, unsigned char data, IDeviceContext* caller, double accessTime, unsigned int accessContext) = 0;
+	virtual IBusInterface::AccessResult WriteInterfaceFixedWidth(unsigned int interfaceNumber, unsigned int location, unsigned short data, IDeviceContext* caller, double accessTime, unsigned int accessContext) = 0;
+	virtual IBusInterface::AccessResult WriteInterfaceFixedWidth(unsigned int interfaceNumber, unsigned int location, unsigned int data, IDeviceContext* caller, double accessTime, unsigned int accessContext) = 0;
+
+	// Incremental savestate functions
+	virtual bool IsIncrementalStateSupported() const = 0;
+	virtual unsigned int GetIncrementalStateSize() const = 0;
+	virtual unsigned int AdvanceStateGeneration() = 0;
+	virtual bool GetStateChangedRegions(unsigned int sinceGeneration, const Marshal::Out<std::vector<StateRegion>>& regions) const = 0;
+	virtual void ReadStateRegion(unsigned int offset, unsigned int size, unsigned char* data) const = 0;
+	virtual void WriteStateRegion(unsigned int offset, unsigned int size, const unsigned char* data) = 0;
 };
 IDevice::~IDevice() { }
 
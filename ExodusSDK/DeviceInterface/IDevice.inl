@@ -7,3 +7,25 @@ enum class IDevice::UpdateMethod
 	Step,
 	Timeslice
 };
+
+//----------------------------------------------------------------------------------------------------------------------
+// Structures
+//----------------------------------------------------------------------------------------------------------------------
+// Describes a block of device state which has been modified since a given state generation. The offset and size are
+// measured in bytes within the incremental state image exposed by the device, which for memory devices is the memory
+// array in native byte order.
+struct IDevice::StateRegion
+{
+public:
+	// Constructors
+	StateRegion()
+	:offset(0), size(0)
+	{ }
+	StateRegion(unsigned int aoffset, unsigned int asize)
+	:offset(aoffset), size(asize)
+	{ }
+
+public:
+	unsigned int offset;
+	unsigned int size;
+};
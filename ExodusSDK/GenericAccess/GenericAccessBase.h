@@ -3,12 +3,14 @@
 #include "IGenericAccess.h"
 #include <map>
 #include <vector>
+#include <atomic>
 
 template<class B>
 class GenericAccessBase :public B
 {
 public:
 	// Constructors
+	GenericAccessBase();
 	virtual ~GenericAccessBase();
 
 	// Interface version functions
@@ -34,6 +36,7 @@ public:
 	using B::WriteGenericData;
 	bool ReadGenericData(unsigned int dataID, const typename B::DataContext* dataContext, const Marshal::Out<std::wstring>& dataValue) const;
 	bool WriteGenericData(unsigned int dataID, const typename B::DataContext* dataContext, const Marshal::In<std::wstring>& dataValue);
+	virtual bool WriteGenericData(unsigned int dataID, const typename B::DataContext* dataContext, IGenericAccessDataValue& dataValue);
 	virtual bool ApplyGenericDataValueLimitSettings(unsigned int dataID, IGenericAccessDataValue& dataValue) const;
 	virtual bool ApplyGenericDataValueDisplaySettings(unsigned int dataID, IGenericAccessDataValue& dataValue) const;
 
@@ -47,10 +50,39 @@ public:
 	// Command execution functions
 	virtual bool ExecuteGenericCommand(unsigned int commandID, const typename B::DataContext* dataContext);
 
+	// Change notification functions
+	virtual unsigned int GetGenericDataLastModifiedToken() const;
+	virtual unsigned int GetGenericDataLastModifiedToken(unsigned int dataID) const;
+	virtual void GenericDataChangeNotifyRegister(IObserverSubscription& observer);
+	virtual void GenericDataChangeNotifyDeregister(IObserverSubscription& observer);
+	virtual void GenericDataChangeNotifyAcknowledge();
+
+	// Batched data read functions
+	virtual unsigned int ReadGenericDataBatch(typename B::DataBatchReadEntry* entries, unsigned int entryCount) const;
+
+protected:
+	// Data read/write functions
+	virtual bool WriteGenericDataInternal(unsigned int dataID, const typename B::DataContext* dataContext, IGenericAccessDataValue& dataValue) = 0;
+
+	// Change notification functions
+	void GenericDataModified(unsigned int dataID);
+	void AllGenericDataModified();
+
+private:
+	// Change notification functions
+	void NotifyGenericDataChangeObservers();
+
 private:
 	std::map<unsigned int, const IGenericAccessDataInfo*> _genericDataList;
 	std::map<unsigned int, const IGenericAccessCommandInfo*> _genericCommandList;
 	std::vector<const IGenericAccessPage*> _genericPageList;
+
+	// Change notification data
+	std::map<unsigned int, std::atomic<unsigned int>> _genericDataLastModifiedTokens;
+	std::atomic<unsigned int> _allGenericDataLastModifiedToken;
+	std::atomic<unsigned int> _genericDataLastModifiedToken;
+	std::atomic<bool> _genericDataChangeNotificationPending;
+	ObserverCollection _genericDataChangeObservers;
 };
 
 #include "GenericAccessBase.inl"
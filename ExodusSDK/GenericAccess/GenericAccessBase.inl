@@ -1,5 +1,11 @@
 //----------------------------------------------------------------------------------------------------------------------
 // Constructors
+//----------------------------------------------------------------------------------------------------------------------
+template<class B>
+GenericAccessBase<B>::GenericAccessBase()
+:_allGenericDataLastModifiedToken(0), _genericDataLastModifiedToken(0), _genericDataChangeNotificationPending(false)
+{ }
+
 //----------------------------------------------------------------------------------------------------------------------
 template<class B>
 GenericAccessBase<B>::~GenericAccessBase()
@@ -78,8 +84,9 @@ bool GenericAccessBase<B>::AddGenericDataInfo(const IGenericAccessDataInfo* data
 		return false;
 	}
 
-	// Add this data entry to the generic data list
+	// Add this data entry to the generic data list, and create a modification token for it.
 	_genericDataList[dataID] = dataInfo;
+	_genericDataLastModifiedTokens[dataID] = 0;
 	return true;
 }
 
@@ -251,6 +258,29 @@ bool GenericAccessBase<B>::ReadGenericData(unsigned int dataID, const typename B
 	return true;
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+template<class B>
+unsigned int GenericAccessBase<B>::ReadGenericDataBatch(typename B::DataBatchReadEntry* entries, unsigned int entryCount) const
+{
+	// Read each requested data value directly into the typed value object supplied by the
+	// caller. Unlike the string-based read path, this performs no string conversion or
+	// marshalling of the result, and allows the caller to retrieve all the values it needs
+	// with a single call across the interface boundary. Derived classes which guard their
+	// generic data with a single lock can override this function to obtain that lock once
+	// for the entire batch.
+	unsigned int successCount = 0;
+	for (unsigned int i = 0; i < entryCount; ++i)
+	{
+		typename B::DataBatchReadEntry& entry = entries[i];
+		entry.result = (entry.dataValue != 0) && ReadGenericData(entry.dataID, entry.dataContext, *entry.dataValue);
+		if (entry.result)
+		{
+			++successCount;
+		}
+	}
+	return successCount;
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 template<class B>
 bool GenericAccessBase<B>::WriteGenericData(unsigned int dataID, const typename B::DataContext* dataContext, const Marshal::In<std::wstring>& dataValue)
@@ -365,7 +395,23 @@ bool GenericAccessBase<B>::WriteGenericData(unsigned int dataID, const typename
 	default:
 		return false;
 	}
+	return true;
+}
 
+//----------------------------------------------------------------------------------------------------------------------
+template<class B>
+bool GenericAccessBase<B>::WriteGenericData(unsigned int dataID, const typename B::DataContext* dataContext, IGenericAccessDataValue& dataValue)
+{
+	// Attempt to write the target value. Since every write from outside the device passes
+	// through here, including the typed register setters on device interfaces, we flag the
+	// modification here rather than relying on each device to do it.
+	if (!WriteGenericDataInternal(dataID, dataContext, dataValue))
+	{
+		return false;
+	}
+
+	// Flag that the target data value has been modified
+	GenericDataModified(dataID);
 	return true;
 }
 
@@ -529,3 +575,85 @@ bool GenericAccessBase<B>::ExecuteGenericCommand(unsigned int commandID, const t
 {
 	return false;
 }
+
+//----------------------------------------------------------------------------------------------------------------------
+// Change notification functions
+//----------------------------------------------------------------------------------------------------------------------
+template<class B>
+unsigned int GenericAccessBase<B>::GetGenericDataLastModifiedToken() const
+{
+	return _genericDataLastModifiedToken;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+template<class B>
+unsigned int GenericAccessBase<B>::GetGenericDataLastModifiedToken(unsigned int dataID) const
+{
+	// Combine the token for the target data value with the token for modifications which
+	// affect all data values. Since both tokens only ever advance, the combined value
+	// changes whenever either one does.
+	unsigned int allDataToken = _allGenericDataLastModifiedToken;
+	std::map<unsigned int, std::atomic<unsigned int>>::const_iterator tokenIterator = _genericDataLastModifiedTokens.find(dataID);
+	return (tokenIterator != _genericDataLastModifiedTokens.end())? allDataToken + tokenIterator->second.load(): allDataToken;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+template<class B>
+void GenericAccessBase<B>::GenericDataChangeNotifyRegister(IObserverSubscription& observer)
+{
+	_genericDataChangeObservers.AddObserver(observer);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+template<class B>
+void GenericAccessBase<B>::GenericDataChangeNotifyDeregister(IObserverSubscription& observer)
+{
+	_genericDataChangeObservers.RemoveObserver(observer);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+template<class B>
+void GenericAccessBase<B>::GenericDataChangeNotifyAcknowledge()
+{
+	// Since the caller is about to observe the current state, re-arm change notifications
+	// for our observers. Callers need to do this before they read any data values, so that
+	// any modification which isn't reflected in the values they read is guaranteed to
+	// trigger another notification.
+	_genericDataChangeNotificationPending = false;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+template<class B>
+void GenericAccessBase<B>::GenericDataModified(unsigned int dataID)
+{
+	std::map<unsigned int, std::atomic<unsigned int>>::iterator tokenIterator = _genericDataLastModifiedTokens.find(dataID);
+	if (tokenIterator != _genericDataLastModifiedTokens.end())
+	{
+		++tokenIterator->second;
+	}
+	++_genericDataLastModifiedToken;
+	NotifyGenericDataChangeObservers();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+template<class B>
+void GenericAccessBase<B>::AllGenericDataModified()
+{
+	++_allGenericDataLastModifiedToken;
+	++_genericDataLastModifiedToken;
+	NotifyGenericDataChangeObservers();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+template<class B>
+void GenericAccessBase<B>::NotifyGenericDataChangeObservers()
+{
+	// Only notify our observers on the first modification since change notifications were
+	// last acknowledged. This coalesces notifications down to the rate at which observers actually
+	// consume them, so that devices can flag modifications from their execution thread
+	// without flooding the UI with notifications.
+	if (!_genericDataChangeNotificationPending.exchange(true))
+	{
+		_genericDataChangeObservers.NotifyObservers();
+	}
+}
@@ -1,6 +1,7 @@
 #ifndef __IGENERICACCESS_H__
 #define __IGENERICACCESS_H__
 #include "MarshalSupport/MarshalSupport.pkg"
+#include "CallbackSupport/CallbackSupport.pkg"
 #include "IGenericAccessDataInfo.h"
 #include "IGenericAccessCommandInfo.h"
 #include <set>
@@ -19,13 +20,20 @@ public:
 		DataContext(const DataContext& source) = default;
 		inline virtual ~DataContext() = 0;
 	};
+	struct DataBatchReadEntry
+	{
+		unsigned int dataID;
+		const DataContext* dataContext;
+		IGenericAccessDataValue* dataValue;
+		bool result;
+	};
 
 public:
 	// Constructors
 	inline virtual ~IGenericAccess() = 0;
 
 	// Interface version functions
-	static inline unsigned int ThisIGenericAccessVersion() { return 1; }
+	static inline unsigned int ThisIGenericAccessVersion() { return 2; }
 	virtual unsigned int GetIGenericAccessVersion() const = 0;
 
 	// Data info functions
@@ -57,6 +65,16 @@ public:
 
 	// Command execution functions
 	virtual bool ExecuteGenericCommand(unsigned int commandID, const DataContext* dataContext) = 0;
+
+	// Change notification functions
+	virtual unsigned int GetGenericDataLastModifiedToken() const = 0;
+	virtual unsigned int GetGenericDataLastModifiedToken(unsigned int dataID) const = 0;
+	virtual void GenericDataChangeNotifyRegister(IObserverSubscription& observer) = 0;
+	virtual void GenericDataChangeNotifyDeregister(IObserverSubscription& observer) = 0;
+	virtual void GenericDataChangeNotifyAcknowledge() = 0;
+
+	// Batched data read functions
+	virtual unsigned int ReadGenericDataBatch(DataBatchReadEntry* entries, unsigned int entryCount) const = 0;
 };
 IGenericAccess::DataContext::~DataContext() { }
 IGenericAccess::~IGenericAccess() { }
@@ -0,0 +1,175 @@
+#include "DebugAddressFilter.h"
+
+//----------------------------------------------------------------------------------------------------------------------
+// Constructors
+//----------------------------------------------------------------------------------------------------------------------
+DebugAddressFilter::DebugAddressFilter()
+:_addressBusMask(0), _pageShift(0), _pageCount(1), _pageBitmap(1)
+{
+	// Until the filter has been initialized, report every address as a possible match, so
+	// that all addresses are checked against the full breakpoint or watchpoint list.
+	_pageBitmap[0].store(1, std::memory_order_relaxed);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void DebugAddressFilter::Initialize(unsigned int addressBusWidth)
+{
+	// Limit the bitmap to a maximum of 2^PageIndexBits pages. For address buses which are
+	// wider than this, each bit in the bitmap represents a block of addresses.
+	addressBusWidth = (addressBusWidth < 1) ? 1 : ((addressBusWidth > 32) ? 32 : addressBusWidth);
+	_addressBusMask = (addressBusWidth >= 32) ? 0xFFFFFFFF : ((1u << addressBusWidth) - 1);
+	_pageShift = (addressBusWidth > PageIndexBits) ? (addressBusWidth - PageIndexBits) : 0;
+	_pageCount = (1u << (addressBusWidth - _pageShift));
+	_pageBitmap = std::vector<std::atomic<unsigned int>>((_pageCount + 31) / 32);
+	_pendingPageBitmap.assign(_pageBitmap.size(), 0);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Rebuild functions
+//----------------------------------------------------------------------------------------------------------------------
+void DebugAddressFilter::BeginRebuild()
+{
+	_pendingPageBitmap.assign(_pageBitmap.size(), 0);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void DebugAddressFilter::AddLocation(unsigned int location)
+{
+	unsigned int pageNo = GetPageNo(location);
+	_pendingPageBitmap[pageNo >> 5] |= (1u << (pageNo & 0x1F));
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void DebugAddressFilter::EndRebuild()
+{
+	// Publish the new bitmap one word at a time. Only words which have actually changed
+	// are written, so the execution thread never observes a cleared bit for a page which
+	// is a candidate both before and after the rebuild.
+	for (size_t i = 0; i < _pageBitmap.size(); ++i)
+	{
+		if (_pageBitmap[i].load(std::memory_order_relaxed) != _pendingPageBitmap[i])
+		{
+			_pageBitmap[i].store(_pendingPageBitmap[i], std::memory_order_release);
+		}
+	}
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void DebugAddressFilter::AddLocationCondition(bool conditionNot, ConditionType conditionType, unsigned int data1, unsigned int data2, unsigned int mask)
+{
+	// If any of the address bits which select a page are excluded by the location mask,
+	// the candidate pages don't form a simple range, so we need to test each page
+	// individually.
+	unsigned int pageOffsetMask = (1u << _pageShift) - 1;
+	unsigned int pageSelectMask = _addressBusMask & ~pageOffsetMask;
+	if ((mask & pageSelectMask) != pageSelectMask)
+	{
+		for (unsigned int pageNo = 0; pageNo < _pageCount; ++pageNo)
+		{
+			if (PageMayPassLocationCondition(pageNo, conditionNot, conditionType, data1, data2, mask))
+			{
+				_pendingPageBitmap[pageNo >> 5] |= (1u << (pageNo & 0x1F));
+			}
+		}
+		return;
+	}
+
+	// Since all the page select bits are included in the comparison, the masked location
+	// values increase with the page number, and the candidate pages for each condition
+	// can be calculated directly as a range. Note that the page containing each boundary
+	// value is always included, which may produce a false positive, but never a false
+	// negative.
+	unsigned int lastPageNo = _pageCount - 1;
+	unsigned int data1PageNo = (data1 > _addressBusMask) ? lastPageNo : (data1 >> _pageShift);
+	unsigned int data2PageNo = (data2 > _addressBusMask) ? lastPageNo : (data2 >> _pageShift);
+	switch (conditionType)
+	{
+	case ConditionType::Equal:
+		if (conditionNot)
+		{
+			SetPageRange(0, lastPageNo);
+		}
+		else if (((data1 & ~mask) == 0) && (data1 <= _addressBusMask))
+		{
+			SetPageRange(data1PageNo, data1PageNo);
+		}
+		break;
+	case ConditionType::Greater:
+		if (conditionNot)
+		{
+			SetPageRange(0, data1PageNo);
+		}
+		else
+		{
+			SetPageRange(data1PageNo, lastPageNo);
+		}
+		break;
+	case ConditionType::Less:
+		if (conditionNot)
+		{
+			SetPageRange(data1PageNo, lastPageNo);
+		}
+		else
+		{
+			SetPageRange(0, data1PageNo);
+		}
+		break;
+	case ConditionType::GreaterAndLess:
+		if (conditionNot)
+		{
+			SetPageRange(0, data1PageNo);
+			SetPageRange(data2PageNo, lastPageNo);
+		}
+		else if (data1 < data2)
+		{
+			SetPageRange(data1PageNo, data2PageNo);
+		}
+		break;
+	default:
+		SetPageRange(0, lastPageNo);
+		break;
+	}
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool DebugAddressFilter::PageMayPassLocationCondition(unsigned int pageNo, bool conditionNot, ConditionType conditionType, unsigned int data1, unsigned int data2, unsigned int mask) const
+{
+	// Within a page, the page select bits are fixed and the page offset bits take every
+	// possible value, so the masked location values within the page are the page base
+	// value combined with every subset of the masked page offset bits. This gives us the
+	// minimum and maximum masked values that can occur within the page.
+	unsigned int pageOffsetMask = ((1u << _pageShift) - 1) & mask;
+	unsigned int minValue = (pageNo << _pageShift) & mask;
+	unsigned int maxValue = minValue | pageOffsetMask;
+	switch (conditionType)
+	{
+	case ConditionType::Equal:
+		return (conditionNot) ? ((pageOffsetMask != 0) || (minValue != data1)) : ((data1 & ~pageOffsetMask) == minValue);
+	case ConditionType::Greater:
+		return (conditionNot) ? (minValue <= data1) : (maxValue > data1);
+	case ConditionType::Less:
+		return (conditionNot) ? (maxValue >= data1) : (minValue < data1);
+	case ConditionType::GreaterAndLess:
+		return (conditionNot) ? ((minValue <= data1) || (maxValue >= data2)) : ((maxValue > data1) && (minValue < data2));
+	}
+	return true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void DebugAddressFilter::SetPageRange(unsigned int firstPageNo, unsigned int lastPageNo)
+{
+	unsigned int pageNo = firstPageNo;
+	while (pageNo <= lastPageNo)
+	{
+		if (((pageNo & 0x1F) == 0) && ((lastPageNo - pageNo) >= 0x1F))
+		{
+			_pendingPageBitmap[pageNo >> 5] = 0xFFFFFFFF;
+			pageNo += 0x20;
+		}
+		else
+		{
+			_pendingPageBitmap[pageNo >> 5] |= (1u << (pageNo & 0x1F));
+			++pageNo;
+		}
+	}
+}
@@ -0,0 +1,54 @@
+#ifndef __DEBUGADDRESSFILTER_H__
+#define __DEBUGADDRESSFILTER_H__
+#include <vector>
+#include <atomic>
+
+// This class maintains a page-level bitmap of the addresses which may satisfy the location
+// condition of at least one breakpoint or watchpoint. It allows the processor core to
+// reject the common case, where an address can't trigger any breakpoint or watchpoint,
+// with a single bit test and no lock. Any address which passes this filter still needs to
+// be checked against the full breakpoint or watchpoint list. The bitmap is rebuilt into a
+// separate buffer when the set of breakpoints or watchpoints changes, and each word is
+// then published atomically, so bits for unaffected pages are never cleared, even
+// transiently, while the filter is being read by the execution thread.
+class DebugAddressFilter
+{
+public:
+	// Constructors
+	DebugAddressFilter();
+	void Initialize(unsigned int addressBusWidth);
+
+	// Filter functions
+	inline bool MayMatch(unsigned int location) const;
+
+	// Rebuild functions
+	void BeginRebuild();
+	template<class T>
+	void AddLocationCondition(const T& entry);
+	void AddLocation(unsigned int location);
+	void EndRebuild();
+
+private:
+	// Enumerations
+	enum class ConditionType;
+
+	// Constants
+	static const unsigned int PageIndexBits = 16;
+
+private:
+	// Rebuild functions
+	void AddLocationCondition(bool conditionNot, ConditionType conditionType, unsigned int data1, unsigned int data2, unsigned int mask);
+	bool PageMayPassLocationCondition(unsigned int pageNo, bool conditionNot, ConditionType conditionType, unsigned int data1, unsigned int data2, unsigned int mask) const;
+	void SetPageRange(unsigned int firstPageNo, unsigned int lastPageNo);
+	inline unsigned int GetPageNo(unsigned int location) const;
+
+private:
+	unsigned int _addressBusMask;
+	unsigned int _pageShift;
+	unsigned int _pageCount;
+	std::vector<std::atomic<unsigned int>> _pageBitmap;
+	std::vector<unsigned int> _pendingPageBitmap;
+};
+
+#include "DebugAddressFilter.inl"
+#endif
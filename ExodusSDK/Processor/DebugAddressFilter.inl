@@ -0,0 +1,51 @@
+//----------------------------------------------------------------------------------------------------------------------
+// Enumerations
+//----------------------------------------------------------------------------------------------------------------------
+enum class DebugAddressFilter::ConditionType
+{
+	Equal,
+	Greater,
+	Less,
+	GreaterAndLess,
+	Unknown
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+// Filter functions
+//----------------------------------------------------------------------------------------------------------------------
+bool DebugAddressFilter::MayMatch(unsigned int location) const
+{
+	unsigned int pageNo = GetPageNo(location);
+	return (_pageBitmap[pageNo >> 5].load(std::memory_order_relaxed) & (1u << (pageNo & 0x1F))) != 0;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Rebuild functions
+//----------------------------------------------------------------------------------------------------------------------
+template<class T>
+void DebugAddressFilter::AddLocationCondition(const T& entry)
+{
+	ConditionType conditionType = ConditionType::Unknown;
+	switch (entry.GetLocationCondition())
+	{
+	case T::Condition::Equal:
+		conditionType = ConditionType::Equal;
+		break;
+	case T::Condition::Greater:
+		conditionType = ConditionType::Greater;
+		break;
+	case T::Condition::Less:
+		conditionType = ConditionType::Less;
+		break;
+	case T::Condition::GreaterAndLess:
+		conditionType = ConditionType::GreaterAndLess;
+		break;
+	}
+	AddLocationCondition(entry.GetLocationConditionNot(), conditionType, entry.GetLocationConditionData1(), entry.GetLocationConditionData2(), entry.GetLocationMask());
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+unsigned int DebugAddressFilter::GetPageNo(unsigned int location) const
+{
+	return (location & _addressBusMask) >> _pageShift;
+}
@@ -27,7 +27,7 @@ public:
 	inline virtual ~IProcessor() = 0;
 
 	// Interface version functions
-	static inline unsigned int ThisIProcessorVersion() { return 1; }
+	static inline unsigned int ThisIProcessorVersion() { return 2; }
 	virtual unsigned int GetIProcessorVersion() const = 0;
 
 	// Device access functions
@@ -173,6 +173,9 @@ public:
 	virtual bool ActiveDisassemblyExportAnalysisToASMFile(const Marshal::In<std::wstring>& filePath) const = 0;
 	virtual bool ActiveDisassemblyExportAnalysisToTextFile(const Marshal::In<std::wstring>& filePath) const = 0;
 	virtual bool ActiveDisassemblyExportAnalysisToIDCFile(const Marshal::In<std::wstring>& filePath) const = 0;
+
+	// Trace export functions
+	virtual bool ExportTraceFileToTextFile(const Marshal::In<std::wstring>& traceFilePath, const Marshal::In<std::wstring>& textFilePath) const = 0;
 };
 IProcessor::~IProcessor() { }
 
@@ -7,6 +7,9 @@
 #include <sstream>
 #include <iostream>
 #include <iomanip>
+#include <functional>
+#include <cstring>
+#include <chrono>
 
 //----------------------------------------------------------------------------------------------------------------------
 // Constructors
@@ -15,9 +18,14 @@ Processor::Processor(const std::wstring& implementationName, const std::wstring&
 :Device(implementationName, instanceName, moduleID),
 _clockSpeed(0), _reportedClockSpeed(0), _clockSpeedOverridden(false),
 _traceLogEnabled(false), _traceLogToFile(false), _traceLogDisassemble(false), _traceLogLength(2000), _traceLogLastModifiedToken(0),
+_traceRecordNextSlot(0), _traceRecordTotal(0), _btraceRecordTotal(0), _traceRecordClearedTotal(0), _traceLogLengthChangePending(false),
+_traceFileWriterActive(false), _traceFileWriterStopRequested(false), _traceFileRecordWritePos(0), _traceFileRecordReadPos(0),
 _stackDisassemble(false), _callStackLastModifiedToken(0), _stepOver(false), _stepOut(false),
-_breakOnNextOpcode(false), _breakpointExists(false), _watchpointExists(false)
+_breakOnNextOpcode(false), _breakpointExists(false), _watchpointExists(false), _transientBreakpointExists(false)
 {
+	// Allocate the trace record buffer
+	ResizeTraceRecordBuffer(_traceLogLength);
+
 	// Initialize active disassembly info
 	_activeDisassemblyAnalysis = new ActiveDisassemblyAnalysisData();
 	_activeDisassemblyEnabled = false;
@@ -50,6 +58,9 @@ _breakOnNextOpcode(false), _breakpointExists(false), _watchpointExists(false)
 //----------------------------------------------------------------------------------------------------------------------
 Processor::~Processor()
 {
+	// Stop the trace file writer if it's currently running
+	CloseTraceFile();
+
 	// Delete any remaining breakpoint objects
 	for (size_t i = 0; i < _breakpoints.size(); ++i)
 	{
@@ -65,12 +76,9 @@ Processor::~Processor()
 	_watchpoints.clear();
 
 	// Delete all disassembly info
-	for (std::set<DisassemblyAddressInfo*>::const_iterator i = _activeDisassemblyAddressInfoSet.begin(); i != _activeDisassemblyAddressInfoSet.end(); ++i)
-	{
-		delete *i;
-	}
-	_activeDisassemblyAddressInfoSet.clear();
 	_activeDisassemblyAddressInfo.clear();
+	_activeDisassemblyAddressSlotHead.clear();
+	_activeDisassemblyAddressSlots.clear();
 	_activeDisassemblyJumpTableInfo.clear();
 	_activeDisassemblyArrayInfo.clear();
 	delete _activeDisassemblyAnalysis;
@@ -111,7 +119,7 @@ bool Processor::BuildDevice()
 {
 	// Initialize the trace logging state
 	std::wstring captureFolder = GetSystemInterface().GetCapturePath();
-	std::wstring traceLogFileName = GetDeviceInstanceName() + L"_TraceLog.txt";
+	std::wstring traceLogFileName = GetDeviceInstanceName() + L"_TraceLog.extrace";
 	_traceFilePath = PathCombinePaths(captureFolder, traceLogFileName);
 
 	// Initialize active disassembly info. Note that we can't initialize these data members
@@ -122,6 +130,17 @@ bool Processor::BuildDevice()
 	_activeDisassemblyUncommittedEndLocation = _activeDisassemblyEndLocation;
 	_activeDisassemblyAnalysisEndLocation = _activeDisassemblyEndLocation;
 
+	// Initialize the breakpoint and watchpoint address filters. As above, these require
+	// the address bus width, so they can't be initialized in the constructor.
+	{
+		std::unique_lock<std::mutex> lock(_debugMutex);
+		_breakpointFilter.Initialize(GetAddressBusWidth());
+		_watchpointReadFilter.Initialize(GetAddressBusWidth());
+		_watchpointWriteFilter.Initialize(GetAddressBusWidth());
+		RebuildBreakpointFilter();
+		RebuildWatchpointFilters();
+	}
+
 	//##TODO## Register a generic access page for modifying breakpoints and watchpoints
 	bool result = true;
 	result &= AddGenericDataInfo((new GenericAccessDataInfo(IProcessorDataSource::BreakpointName, IGenericAccessDataValue::DataType::String)));
@@ -170,9 +189,27 @@ void Processor::ExecuteRollback()
 		_reportedClockSpeed = _clockSpeed;
 	}
 
-	// Call stack and trace log
+	// Call stack
 	_callStack = _bcallStack;
-	_traceLog = _btraceLog;
+
+	// Trace log. Since the trace records are stored in a ring buffer, rolling back simply
+	// moves the write position back to where it was at the last commit. Any committed
+	// records which have been overwritten since the last commit no longer carry the
+	// sequence number of the record the reader expects, and are dropped from the log. Note
+	// that the modified token is advanced by one more than the number of discarded
+	// records, since the record total contributes to the token returned to the caller.
+	{
+		std::unique_lock<std::mutex> traceLock(_traceMutex);
+		unsigned long long discardedRecordCount = _traceRecordTotal.load(std::memory_order_relaxed) - _btraceRecordTotal;
+		_traceRecordTotal.store(_btraceRecordTotal, std::memory_order_release);
+		if (_traceRecordClearedTotal.load(std::memory_order_relaxed) > _btraceRecordTotal)
+		{
+			_traceRecordClearedTotal.store(_btraceRecordTotal, std::memory_order_relaxed);
+		}
+		_traceLogLastModifiedToken.fetch_add((unsigned int)discardedRecordCount + 1, std::memory_order_relaxed);
+		_traceRecordNextSlot = (!_traceRecords.empty())? (unsigned int)(_btraceRecordTotal % (unsigned long long)_traceRecords.size()): 0;
+		ApplyPendingTraceLengthChange();
+	}
 
 	// Breakpoint and Watchpoint hit counters
 	if (_breakpointExists)
@@ -195,6 +232,9 @@ void Processor::ExecuteRollback()
 	_stepOver = _bstepOver;
 	_stepOut = _bstepOut;
 	_stackLevel = _bstackLevel;
+
+	// Flag that our state has been rolled back for any debugger views
+	AllGenericDataModified();
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -205,9 +245,15 @@ void Processor::ExecuteCommit()
 	// Clock speed
 	_bclockSpeed = _clockSpeed;
 
-	// Call stack and trace log
+	// Call stack
 	_bcallStack = _callStack;
-	_btraceLog = _traceLog;
+
+	// Trace log
+	{
+		std::unique_lock<std::mutex> traceLock(_traceMutex);
+		_btraceRecordTotal = _traceRecordTotal.load(std::memory_order_relaxed);
+		ApplyPendingTraceLengthChange();
+	}
 
 	// Breakpoint and Watchpoint hit counters
 	if (_breakpointExists)
@@ -230,6 +276,9 @@ void Processor::ExecuteCommit()
 	_bstepOver = _stepOver;
 	_bstepOut = _stepOut;
 	_bstackLevel = _stackLevel;
+
+	// Flag that our committed state may have changed for any debugger views
+	AllGenericDataModified();
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -260,6 +309,7 @@ void Processor::BreakOnStepOverCurrentOpcode()
 		// like, that loop on a counter.
 		_transientBreakpoints.insert(opcodeInfo.GetOpcodeCountedLoopEndLocation());
 		_transientBreakpointExists = true;
+		RebuildBreakpointFilter();
 	}
 	else
 	{
@@ -287,6 +337,7 @@ void Processor::BreakOnTargetOpcodeTransient(unsigned int location)
 	std::unique_lock<std::mutex> lock(_debugMutex);
 	_transientBreakpoints.insert(location);
 	_transientBreakpointExists = true;
+	RebuildBreakpointFilter();
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -359,6 +410,7 @@ IBreakpoint* Processor::CreateBreakpoint()
 	Breakpoint* breakpoint = new Breakpoint(GetAddressBusWidth(), GetDataBusWidth(), GetAddressBusCharWidth());
 	_breakpoints.push_back(breakpoint);
 	_breakpointExists = true;
+	RebuildBreakpointFilter();
 
 	//##TODO## Add this new breakpoint to our list of breakpoints
 	GenericAccessGroup* breakpointEntry = (new GenericAccessGroup(L"Breakpoint"))->SetOpenByDefault(false)->SetDataContext(new BreakpointDataContext(breakpoint));
@@ -424,9 +476,11 @@ bool Processor::LockBreakpoint(IBreakpoint* breakpoint) const
 //----------------------------------------------------------------------------------------------------------------------
 void Processor::UnlockBreakpoint(IBreakpoint* breakpoint) const
 {
-	// Unlock this breakpoint
+	// Unlock this breakpoint, and rebuild the breakpoint filter to take into account any
+	// changes which were made to the breakpoint while it was locked.
 	std::unique_lock<std::mutex> lock(_debugMutex);
 	_lockedBreakpoints.erase(breakpoint);
+	RebuildBreakpointFilter();
 	_breakpointLockReleased.notify_all();
 }
 
@@ -476,6 +530,7 @@ void Processor::DeleteBreakpoint(IBreakpoint* breakpoint)
 	// Delete the target breakpoint, and remove it from the list of breakpoints.
 	_breakpoints.erase(_breakpoints.begin() + breakpointNo);
 	_breakpointExists = !_breakpoints.empty();
+	RebuildBreakpointFilter();
 	delete breakpoint;
 }
 
@@ -510,8 +565,11 @@ void Processor::CheckExecutionInternal(unsigned int location)
 				{
 					breakOnInstruction = true;
 					triggerBreakpoint = breakpoint;
-					_transientBreakpoints.erase(location);
-					_transientBreakpointExists = !_transientBreakpoints.empty();
+					if (_transientBreakpoints.erase(location) > 0)
+					{
+						_transientBreakpointExists = !_transientBreakpoints.empty();
+						RebuildBreakpointFilter();
+					}
 				}
 			}
 		}
@@ -523,6 +581,7 @@ void Processor::CheckExecutionInternal(unsigned int location)
 		breakOnInstruction = true;
 		_transientBreakpoints.erase(location);
 		_transientBreakpointExists = !_transientBreakpoints.empty();
+		RebuildBreakpointFilter();
 	}
 
 	if (breakOnInstruction)
@@ -540,6 +599,27 @@ void Processor::CheckExecutionInternal(unsigned int location)
 	}
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+void Processor::RebuildBreakpointFilter() const
+{
+	// Note that this method must be called with the debug mutex held. Disabled breakpoints
+	// can never trigger, so they're excluded from the filter, but locked breakpoints are
+	// still included, since they may be unlocked at any time.
+	_breakpointFilter.BeginRebuild();
+	for (size_t i = 0; i < _breakpoints.size(); ++i)
+	{
+		if (_breakpoints[i]->GetEnabled())
+		{
+			_breakpointFilter.AddLocationCondition(*_breakpoints[i]);
+		}
+	}
+	for (std::set<unsigned int>::const_iterator i = _transientBreakpoints.begin(); i != _transientBreakpoints.end(); ++i)
+	{
+		_breakpointFilter.AddLocation(*i);
+	}
+	_breakpointFilter.EndRebuild();
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 void Processor::TriggerBreakpoint(Breakpoint* breakpoint) const
 {
@@ -605,6 +685,7 @@ IWatchpoint* Processor::CreateWatchpoint()
 	Watchpoint* watchpoint = new Watchpoint(GetAddressBusWidth(), GetDataBusWidth(), GetAddressBusCharWidth());
 	_watchpoints.push_back(watchpoint);
 	_watchpointExists = true;
+	RebuildWatchpointFilters();
 	return watchpoint;
 }
 
@@ -643,9 +724,11 @@ bool Processor::LockWatchpoint(IWatchpoint* watchpoint) const
 //----------------------------------------------------------------------------------------------------------------------
 void Processor::UnlockWatchpoint(IWatchpoint* watchpoint) const
 {
-	// Unlock this watchpoint
+	// Unlock this watchpoint, and rebuild the watchpoint filters to take into account any
+	// changes which were made to the watchpoint while it was locked.
 	std::unique_lock<std::mutex> lock(_debugMutex);
 	_lockedWatchpoints.erase(watchpoint);
+	RebuildWatchpointFilters();
 	_watchpointLockReleased.notify_all();
 }
 
@@ -679,6 +762,7 @@ void Processor::DeleteWatchpoint(IWatchpoint* watchpoint)
 	// Delete the target watchpoint, and remove it from the list of watchpoints.
 	_watchpoints.erase(_watchpoints.begin() + watchpointNo);
 	_watchpointExists = !_watchpoints.empty();
+	RebuildWatchpointFilters();
 	delete watchpoint;
 }
 
@@ -753,6 +837,28 @@ void Processor::CheckMemoryWriteInternal(unsigned int location, unsigned int dat
 	}
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+void Processor::RebuildWatchpointFilters() const
+{
+	// Note that this method must be called with the debug mutex held
+	_watchpointReadFilter.BeginRebuild();
+	_watchpointWriteFilter.BeginRebuild();
+	for (size_t i = 0; i < _watchpoints.size(); ++i)
+	{
+		const Watchpoint& watchpoint = *_watchpoints[i];
+		if (watchpoint.GetEnabled() && watchpoint.GetOnRead())
+		{
+			_watchpointReadFilter.AddLocationCondition(watchpoint);
+		}
+		if (watchpoint.GetEnabled() && watchpoint.GetOnWrite())
+		{
+			_watchpointWriteFilter.AddLocationCondition(watchpoint);
+		}
+	}
+	_watchpointReadFilter.EndRebuild();
+	_watchpointWriteFilter.EndRebuild();
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 void Processor::TriggerWatchpoint(Watchpoint* watchpoint) const
 {
@@ -922,7 +1028,14 @@ unsigned int Processor::GetTraceLength() const
 //----------------------------------------------------------------------------------------------------------------------
 void Processor::SetTraceLength(unsigned int length)
 {
+	// Since the trace record buffer is written to by the processor without locking, we
+	// can't reallocate it here. The new length is applied to the buffer on the next commit
+	// or rollback, when the processor isn't executing. Until then, the trace log returned
+	// to the caller is limited to the new length.
+	std::unique_lock<std::mutex> lock(_traceMutex);
 	_traceLogLength = length;
+	_traceLogLengthChangePending.store(true, std::memory_order_relaxed);
+	_traceLogLastModifiedToken.fetch_add(1, std::memory_order_relaxed);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -987,89 +1100,354 @@ void Processor::SetTraceFileLoggingEnabled(bool state)
 //----------------------------------------------------------------------------------------------------------------------
 Marshal::Ret<std::list<Processor::TraceLogEntry>> Processor::GetTraceLog() const
 {
-	std::unique_lock<std::mutex> lock(_debugMutex);
-	return _traceLog;
+	// Take a copy of the addresses of the current trace records, from newest to oldest.
+	// Since the processor writes to the trace record buffer without locking, each slot is
+	// read in the same manner as a sequence lock. If the sequence number of a slot doesn't
+	// match the record we expect, or changes while we're reading it, the record has been
+	// overwritten, and since all older records must also have been overwritten, we stop.
+	std::vector<unsigned int> addresses;
+	{
+		std::unique_lock<std::mutex> lock(_traceMutex);
+		unsigned long long recordTotal = _traceRecordTotal.load(std::memory_order_acquire);
+		unsigned long long clearedTotal = _traceRecordClearedTotal.load(std::memory_order_relaxed);
+		unsigned long long bufferSize = (unsigned long long)_traceRecords.size();
+		unsigned long long recordCount = (recordTotal > clearedTotal)? (recordTotal - clearedTotal): 0;
+		recordCount = (recordCount < bufferSize)? recordCount: bufferSize;
+		recordCount = (recordCount < (unsigned long long)_traceLogLength)? recordCount: (unsigned long long)_traceLogLength;
+		addresses.reserve((size_t)recordCount);
+		for (unsigned long long i = 0; i < recordCount; ++i)
+		{
+			unsigned long long recordNo = recordTotal - 1 - i;
+			const TraceRecordSlot& slot = _traceRecords[(size_t)(recordNo % bufferSize)];
+			unsigned long long sequenceNo = slot.sequenceNo.load(std::memory_order_acquire);
+			if (sequenceNo != ((recordNo * 2) + 2))
+			{
+				break;
+			}
+			unsigned int address = slot.address.load(std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_acquire);
+			if (slot.sequenceNo.load(std::memory_order_relaxed) != sequenceNo)
+			{
+				break;
+			}
+			addresses.push_back(address);
+		}
+	}
+
+	// Build the trace log entries. Disassembly is performed here rather than when each
+	// trace record is captured, so that the cost is only incurred for trace entries which
+	// are actually retrieved.
+	std::list<TraceLogEntry> traceLog;
+	TraceDisassemblyCache disassemblyCache;
+	bool disassemble = _traceLogDisassemble;
+	for (size_t i = 0; i < addresses.size(); ++i)
+	{
+		traceLog.push_back(GetTraceLogEntry(addresses[i], disassemble, disassemblyCache));
+	}
+	return traceLog;
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 unsigned int Processor::GetTraceLogLastModifiedToken() const
 {
-	return _traceLogLastModifiedToken;
+	// Note that the record total isn't stored in the modified token itself, so that the
+	// processor doesn't need to update a second shared value for each recorded opcode.
+	return _traceLogLastModifiedToken.load(std::memory_order_relaxed) + (unsigned int)_traceRecordTotal.load(std::memory_order_relaxed);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 void Processor::ClearTraceLog()
 {
-	std::unique_lock<std::mutex> lock(_debugMutex);
-	_traceLog.clear();
-	++_traceLogLastModifiedToken;
+	// Rather than modifying the trace record buffer, which is owned by the processor, we
+	// simply hide all records up to the current record total from the trace log.
+	std::unique_lock<std::mutex> lock(_traceMutex);
+	_traceRecordClearedTotal.store(_traceRecordTotal.load(std::memory_order_acquire), std::memory_order_relaxed);
+	_traceLogLastModifiedToken.fetch_add(1, std::memory_order_relaxed);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool Processor::ExportTraceFileToTextFile(const Marshal::In<std::wstring>& traceFilePath, const Marshal::In<std::wstring>& textFilePath) const
+{
+	// Open the trace file, and validate the header
+	std::wstring traceFilePathResolved = traceFilePath;
+	Stream::File traceFile;
+	if (!traceFile.Open(traceFilePathResolved, Stream::File::OpenMode::ReadOnly, Stream::File::CreateMode::Open))
+	{
+		GetDeviceContext()->WriteLogEvent(LogEntry(LogEntry::EventLevel::Error, L"Failed to open trace file \"" + traceFilePathResolved + L"\"!"));
+		return false;
+	}
+	unsigned char signature[4];
+	unsigned int formatVersion;
+	unsigned int addressBusWidth;
+	bool readHeader = traceFile.ReadData(&signature[0], (Stream::IStream::SizeType)sizeof(signature));
+	readHeader &= traceFile.ReadData(Stream::IStream::ByteOrder::LittleEndian, formatVersion);
+	readHeader &= traceFile.ReadData(Stream::IStream::ByteOrder::LittleEndian, addressBusWidth);
+	if (!readHeader || (signature[0] != 'E') || (signature[1] != 'X') || (signature[2] != 'T') || (signature[3] != 'R') || (formatVersion != TraceFileFormatVersion))
+	{
+		GetDeviceContext()->WriteLogEvent(LogEntry(LogEntry::EventLevel::Error, L"Failed to export trace file \"" + traceFilePathResolved + L"\" because it isn't a supported trace file!"));
+		return false;
+	}
+	if (addressBusWidth != GetAddressBusWidth())
+	{
+		GetDeviceContext()->WriteLogEvent(LogEntry(LogEntry::EventLevel::Warning, L"Trace file \"" + traceFilePathResolved + L"\" was recorded with a different address bus width than this processor. The disassembly may not be correct."));
+	}
+
+	// Create the output file
+	std::wstring textFilePathResolved = textFilePath;
+	Stream::File textFile;
+	if (!textFile.Open(textFilePathResolved, Stream::File::OpenMode::WriteOnly, Stream::File::CreateMode::Create))
+	{
+		GetDeviceContext()->WriteLogEvent(LogEntry(LogEntry::EventLevel::Error, L"Failed to create output file \"" + textFilePathResolved + L"\"!"));
+		return false;
+	}
+
+	// Decode each trace record, and write the opcode address and disassembly to the
+	// output file. Note that the opcode is disassembled from the current contents of
+	// memory, not the contents at the time the trace was recorded.
+	TraceDisassemblyCache disassemblyCache;
+	unsigned int pcLength = GetPCCharWidth();
+	unsigned int address;
+	double timesliceProgress;
+	while (traceFile.ReadData(Stream::IStream::ByteOrder::LittleEndian, address) && traceFile.ReadData(Stream::IStream::ByteOrder::LittleEndian, timesliceProgress))
+	{
+		const TraceLogEntry& traceEntry = GetTraceLogEntry(address, true, disassemblyCache);
+		std::wstring opcodeAddressAsString;
+		IntToStringBase16(address, opcodeAddressAsString, pcLength);
+		textFile.WriteText(opcodeAddressAsString);
+		textFile.WriteText("\t");
+		textFile.WriteText(traceEntry.disassemblyOpcode);
+		textFile.WriteText("\t");
+		textFile.WriteText(traceEntry.disassemblyArgs);
+		if (!traceEntry.disassemblyComment.empty())
+		{
+			textFile.WriteText("\t;");
+			textFile.WriteText(traceEntry.disassemblyComment);
+		}
+		textFile.WriteText("\n");
+	}
+	return true;
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 bool Processor::OpenTraceFile(const std::wstring& filePath)
 {
+	// Create the trace file
 	if (!_traceFile.Open(filePath, Stream::File::OpenMode::WriteOnly, Stream::File::CreateMode::Create))
 	{
 		GetDeviceContext()->WriteLogEvent(LogEntry(LogEntry::EventLevel::Error, L"Failed to create trace log file with path \"" + filePath + L"\"!"));
 		return false;
 	}
+
+	// Write the trace file header. The header consists of a 4-byte signature, followed
+	// by the format version number and the address bus width of the processor, both
+	// stored as 32-bit little-endian values. Each trace record which follows the header
+	// is 12 bytes in size, consisting of the 32-bit opcode address, followed by the
+	// 64-bit floating point time of the opcode in nanoseconds relative to the start of
+	// the current timeslice. All values are stored in little-endian byte order.
+	const unsigned char signature[] = {'E', 'X', 'T', 'R'};
+	_traceFile.WriteData(&signature[0], (Stream::IStream::SizeType)sizeof(signature));
+	_traceFile.WriteData(Stream::IStream::ByteOrder::LittleEndian, TraceFileFormatVersion);
+	_traceFile.WriteData(Stream::IStream::ByteOrder::LittleEndian, GetAddressBusWidth());
+
+	// Start the background writer thread for the trace file. Note that the trace file
+	// record buffer is allocated the first time a trace file is opened, and is never
+	// reallocated after that point, since the processor may still be adding a record to
+	// it when a trace file is closed.
+	if (_traceFileRecords.empty())
+	{
+		_traceFileRecords.resize(TraceFileRecordBufferSize);
+	}
+	_traceFileRecordReadPos.store(_traceFileRecordWritePos.load(std::memory_order_acquire), std::memory_order_relaxed);
+	_traceFileWriterStopRequested = false;
+	_traceFileWriterThread = std::thread(std::bind(std::mem_fn(&Processor::TraceFileWriterThread), this));
+	_traceFileWriterActive.store(true, std::memory_order_release);
 	return true;
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 void Processor::CloseTraceFile()
 {
+	// Stop accepting new records for the trace file
+	if (!_traceFileWriterActive.exchange(false, std::memory_order_acq_rel))
+	{
+		return;
+	}
+
+	// Wait for the writer thread to write out all buffered records and terminate
+	{
+		std::unique_lock<std::mutex> writerLock(_traceFileWriterMutex);
+		_traceFileWriterStopRequested = true;
+		_traceFileWriterAdvance.notify_all();
+	}
+	_traceFileWriterThread.join();
 	_traceFile.Close();
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 void Processor::RecordTraceInternal(unsigned int pc)
 {
-	std::unique_lock<std::mutex> lock(_debugMutex);
+	// Note that this method is called for every opcode executed while trace logging is
+	// enabled, so we only record the raw trace information here, and we never take a
+	// lock. The trace record buffer is only ever written to by the processor, and is only
+	// reallocated on commit or rollback, when the processor isn't executing. Each slot is
+	// published in the same manner as a sequence lock, so that readers can detect a record
+	// being overwritten while they read it.
+	TraceRecord record;
+	record.address = pc;
+	record.timesliceProgress = GetCurrentTimesliceProgress();
+	unsigned long long recordNo = _traceRecordTotal.load(std::memory_order_relaxed);
 
-	TraceLogEntry traceEntry(pc);
-	if (_traceLogDisassemble)
+	// Add the entry to the running trace log
+	if (!_traceRecords.empty())
 	{
-		OpcodeInfo opcodeInfo;
-		if (GetOpcodeInfo(pc, opcodeInfo))
-		{
-			traceEntry.disassemblyOpcode = opcodeInfo.GetOpcodeNameDisassembly();
-			traceEntry.disassemblyArgs = opcodeInfo.GetOpcodeArgumentsDisassembly();
-			traceEntry.disassemblyComment = opcodeInfo.GetDisassemblyComment();
-		}
+		TraceRecordSlot& slot = _traceRecords[_traceRecordNextSlot];
+		slot.sequenceNo.store((recordNo * 2) + 1, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);
+		slot.address.store(record.address, std::memory_order_relaxed);
+		slot.timesliceProgress.store(record.timesliceProgress, std::memory_order_relaxed);
+		slot.sequenceNo.store((recordNo * 2) + 2, std::memory_order_release);
+		_traceRecordNextSlot = ((_traceRecordNextSlot + 1) < (unsigned int)_traceRecords.size())? (_traceRecordNextSlot + 1): 0;
 	}
+	_traceRecordTotal.store(recordNo + 1, std::memory_order_release);
 
-	// Add the entry to the running trace log
-	if (_traceLogLength > 0)
+	// Record the entry in the trace log file if requested
+	if (_traceFileWriterActive.load(std::memory_order_acquire))
 	{
-		_traceLog.push_front(traceEntry);
+		WriteTraceFileRecord(record);
 	}
-	while (_traceLog.size() > _traceLogLength)
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void Processor::ApplyPendingTraceLengthChange()
+{
+	// Note that this method must be called with the trace mutex held, while the processor
+	// isn't executing.
+	if (_traceLogLengthChangePending.exchange(false, std::memory_order_relaxed))
 	{
-		_traceLog.pop_back();
+		ResizeTraceRecordBuffer(_traceLogLength);
 	}
-	++_traceLogLastModifiedToken;
+}
 
-	// Record the entry in the trace log file if requested
-	if (_traceLogToFile)
+//----------------------------------------------------------------------------------------------------------------------
+void Processor::ResizeTraceRecordBuffer(unsigned int length)
+{
+	// Note that this method must only be called while the processor isn't executing, with
+	// the trace mutex held. We preserve the most recent records which fit in the new
+	// buffer, and maintain the invariant that each record is stored at the slot given by
+	// its record number modulo the buffer size, which allows a rollback to simply restore
+	// the write position.
+	std::vector<TraceRecordSlot> newTraceRecords(length);
+	for (unsigned int i = 0; i < length; ++i)
 	{
-		std::wstring opcodeAddressAsString;
-		IntToStringBase16(pc, opcodeAddressAsString, GetPCCharWidth());
-		_traceFile.WriteText(opcodeAddressAsString);
-		if (_traceLogDisassemble)
-		{
-			_traceFile.WriteText("\t");
-			_traceFile.WriteText(traceEntry.disassemblyOpcode);
-			_traceFile.WriteText("\t");
-			_traceFile.WriteText(traceEntry.disassemblyArgs);
-			if (!traceEntry.disassemblyComment.empty())
+		newTraceRecords[i].sequenceNo.store(0, std::memory_order_relaxed);
+		newTraceRecords[i].address.store(0, std::memory_order_relaxed);
+		newTraceRecords[i].timesliceProgress.store(0, std::memory_order_relaxed);
+	}
+	unsigned long long recordTotal = _traceRecordTotal.load(std::memory_order_relaxed);
+	unsigned long long oldBufferSize = (unsigned long long)_traceRecords.size();
+	unsigned long long copyCount = (oldBufferSize < (unsigned long long)length)? oldBufferSize: (unsigned long long)length;
+	copyCount = (copyCount < recordTotal)? copyCount: recordTotal;
+	for (unsigned long long i = 0; i < copyCount; ++i)
+	{
+		unsigned long long recordNo = recordTotal - 1 - i;
+		const TraceRecordSlot& oldSlot = _traceRecords[(size_t)(recordNo % oldBufferSize)];
+		TraceRecordSlot& newSlot = newTraceRecords[(size_t)(recordNo % length)];
+		newSlot.sequenceNo.store(oldSlot.sequenceNo.load(std::memory_order_relaxed), std::memory_order_relaxed);
+		newSlot.address.store(oldSlot.address.load(std::memory_order_relaxed), std::memory_order_relaxed);
+		newSlot.timesliceProgress.store(oldSlot.timesliceProgress.load(std::memory_order_relaxed), std::memory_order_relaxed);
+	}
+	_traceRecords.swap(newTraceRecords);
+	_traceRecordNextSlot = (length > 0)? (unsigned int)(recordTotal % length): 0;
+	_traceLogLength = length;
+	_traceLogLastModifiedToken.fetch_add(1, std::memory_order_relaxed);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void Processor::WriteTraceFileRecord(const TraceRecord& record)
+{
+	// The trace file record buffer is a single producer, single consumer ring. If the
+	// writer thread has fallen behind and the ring is full, we wait for it to make room
+	// rather than dropping records, unless the trace file is closed while we're waiting.
+	unsigned int writePos = _traceFileRecordWritePos.load(std::memory_order_relaxed);
+	while ((writePos - _traceFileRecordReadPos.load(std::memory_order_acquire)) >= TraceFileRecordBufferSize)
+	{
+		if (!_traceFileWriterActive.load(std::memory_order_acquire))
+		{
+			return;
+		}
+		std::this_thread::yield();
+	}
+	_traceFileRecords[writePos % TraceFileRecordBufferSize] = record;
+	_traceFileRecordWritePos.store(writePos + 1, std::memory_order_release);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void Processor::TraceFileWriterThread()
+{
+	std::vector<unsigned char> buffer;
+	std::unique_lock<std::mutex> writerLock(_traceFileWriterMutex);
+	while (true)
+	{
+		// Since the processor doesn't signal the writer thread when it adds a record, we
+		// poll for new records while the ring is empty, until the writer is stopped.
+		unsigned int readPos = _traceFileRecordReadPos.load(std::memory_order_relaxed);
+		unsigned int writePos = _traceFileRecordWritePos.load(std::memory_order_acquire);
+		if (readPos == writePos)
+		{
+			if (_traceFileWriterStopRequested)
+			{
+				break;
+			}
+			_traceFileWriterAdvance.wait_for(writerLock, std::chrono::milliseconds(TraceFileWriterPollIntervalInMilliseconds));
+			continue;
+		}
+		writerLock.unlock();
+
+		// Convert the available trace records into their file representation, and write
+		// them to the trace file in a single operation.
+		unsigned int recordCount = writePos - readPos;
+		buffer.resize((size_t)recordCount * TraceFileRecordSize);
+		size_t bufferPos = 0;
+		for (unsigned int i = 0; i < recordCount; ++i)
+		{
+			const TraceRecord& record = _traceFileRecords[(readPos + i) % TraceFileRecordBufferSize];
+			unsigned long long timesliceProgressBits;
+			memcpy(&timesliceProgressBits, &record.timesliceProgress, sizeof(timesliceProgressBits));
+			for (unsigned int byteNo = 0; byteNo < 4; ++byteNo)
+			{
+				buffer[bufferPos++] = (unsigned char)((record.address >> (byteNo * 8)) & 0xFF);
+			}
+			for (unsigned int byteNo = 0; byteNo < 8; ++byteNo)
 			{
-				_traceFile.WriteText("\t;");
-				_traceFile.WriteText(traceEntry.disassemblyComment);
+				buffer[bufferPos++] = (unsigned char)((timesliceProgressBits >> (byteNo * 8)) & 0xFF);
 			}
 		}
-		_traceFile.WriteText("\n");
+		_traceFileRecordReadPos.store(writePos, std::memory_order_release);
+		_traceFile.WriteData(&buffer[0], (Stream::IStream::SizeType)buffer.size());
+
+		writerLock.lock();
+	}
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+const Processor::TraceLogEntry& Processor::GetTraceLogEntry(unsigned int address, bool disassemble, TraceDisassemblyCache& disassemblyCache) const
+{
+	// Since the same addresses tend to recur heavily in a trace, we cache the trace log
+	// entry for each address we decode.
+	TraceDisassemblyCache::const_iterator disassemblyCacheIterator = disassemblyCache.find(address);
+	if (disassemblyCacheIterator == disassemblyCache.end())
+	{
+		TraceLogEntry traceEntry(address);
+		OpcodeInfo opcodeInfo;
+		if (disassemble && GetOpcodeInfo(address, opcodeInfo))
+		{
+			traceEntry.disassemblyOpcode = opcodeInfo.GetOpcodeNameDisassembly();
+			traceEntry.disassemblyArgs = opcodeInfo.GetOpcodeArgumentsDisassembly();
+			traceEntry.disassemblyComment = opcodeInfo.GetDisassemblyComment();
+		}
+		disassemblyCacheIterator = disassemblyCache.insert(TraceDisassemblyCache::value_type(address, traceEntry)).first;
 	}
+	return disassemblyCacheIterator->second;
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -1354,7 +1732,7 @@ void Processor::SetActiveDisassemblyJumpTableDistanceTolerance(unsigned int stat
 unsigned int Processor::GetActiveDisassemblyRecordedItemCount() const
 {
 	std::unique_lock<std::mutex> lock(_debugMutex);
-	return (unsigned int)_activeDisassemblyAddressInfoSet.size();
+	return (unsigned int)_activeDisassemblyAddressInfo.size();
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -1441,34 +1819,25 @@ void Processor::EnableActiveDisassembly(unsigned int startLocation, unsigned int
 	_activeDisassemblyStartLocation = startLocation;
 	_activeDisassemblyEndLocation = endLocation;
 
-	// Resize the array holding the disassembly address info
+	// Resize the slot table holding the disassembly address info
 	unsigned int requiredDisassemblyAddressInfoArraySize = _activeDisassemblyEndLocation - _activeDisassemblyStartLocation;
-	if ((_activeDisassemblyStartLocation != oldActiveDisassemblyStartLocation) || (_activeDisassemblyEndLocation != oldActiveDisassemblyEndLocation) || ((unsigned int)_activeDisassemblyAddressInfo.size() != requiredDisassemblyAddressInfoArraySize))
+	if ((_activeDisassemblyStartLocation != oldActiveDisassemblyStartLocation) || (_activeDisassemblyEndLocation != oldActiveDisassemblyEndLocation) || ((unsigned int)_activeDisassemblyAddressSlotHead.size() != requiredDisassemblyAddressInfoArraySize))
 	{
-		// Clear disassemblyAddressInfo and resize it correctly for the new region
-		_activeDisassemblyAddressInfo.clear();
-		_activeDisassemblyAddressInfo.resize(requiredDisassemblyAddressInfoArraySize);
-
-		// Insert current entries into the resized array, and remove any existing entries
-		// which now fall outsize the active disassembly region.
-		std::set<DisassemblyAddressInfo*> entriesToRemove;
-		for (std::set<DisassemblyAddressInfo*>::const_iterator i = _activeDisassemblyAddressInfoSet.begin(); i != _activeDisassemblyAddressInfoSet.end(); ++i)
+		// Compact the entry arena, removing any existing entries which now fall outside
+		// the active disassembly region. Entries are moved rather than copied, and the
+		// slot table is rebuilt from scratch below, so no stale entry indexes remain.
+		std::deque<DisassemblyAddressInfo> retainedEntries;
+		for (std::deque<DisassemblyAddressInfo>::iterator i = _activeDisassemblyAddressInfo.begin(); i != _activeDisassemblyAddressInfo.end(); ++i)
 		{
-			DisassemblyAddressInfo* entry = *i;
-			if ((entry->baseMemoryAddress < _activeDisassemblyStartLocation) || ((entry->baseMemoryAddress + entry->memoryBlockSize) >= _activeDisassemblyEndLocation))
+			if ((i->baseMemoryAddress >= _activeDisassemblyStartLocation) && ((i->baseMemoryAddress + i->memoryBlockSize) < _activeDisassemblyEndLocation))
 			{
-				entriesToRemove.insert(entry);
+				retainedEntries.push_back(std::move(*i));
 			}
-			else
-			{
-				AddDisassemblyAddressInfoEntryToArray(*i);
-			}
-		}
-		for (std::set<DisassemblyAddressInfo*>::const_iterator i = entriesToRemove.begin(); i != entriesToRemove.end(); ++i)
-		{
-			_activeDisassemblyAddressInfoSet.erase(*i);
-			delete *i;
 		}
+		_activeDisassemblyAddressInfo.swap(retainedEntries);
+
+		// Insert the remaining entries into a slot table sized for the new region
+		RebuildDisassemblyAddressSlotTable();
 
 		// Remove any jump table definitions which now begin outside the active disassembly
 		// region, and remove any entries which now extend outside the active disassembly
@@ -1551,21 +1920,17 @@ void Processor::ClearActiveDisassembly()
 void Processor::ClearActiveDisassemblyInternal()
 {
 	// Delete all disassembly info
-	for (std::set<DisassemblyAddressInfo*>::const_iterator i = _activeDisassemblyAddressInfoSet.begin(); i != _activeDisassemblyAddressInfoSet.end(); ++i)
-	{
-		delete *i;
-	}
-	_activeDisassemblyAddressInfoSet.clear();
 	_activeDisassemblyAddressInfo.clear();
+	_activeDisassemblyAddressSlotHead.clear();
+	_activeDisassemblyAddressSlots.clear();
 	_activeDisassemblyJumpTableInfo.clear();
 	_activeDisassemblyArrayInfo.clear();
 
-	// If active disassembly is currently enabled, re-allocate the disassembly array using
-	// the current array size.
+	// If active disassembly is currently enabled, re-allocate the slot table using the
+	// current region size.
 	if (_activeDisassemblyEnabled)
 	{
-		unsigned int disassemblyAddressInfoArraySize = _activeDisassemblyEndLocation - _activeDisassemblyStartLocation;
-		_activeDisassemblyAddressInfo.resize(disassemblyAddressInfoArraySize);
+		RebuildDisassemblyAddressSlotTable();
 	}
 }
 
@@ -1589,13 +1954,12 @@ unsigned int Processor::MakeDataArrayAtLocation(unsigned int location, unsigned
 
 	// Try and find existing data references at the same address which define the start of
 	// an array. If one is found, return the existing array ID for that data reference.
-	std::list<DisassemblyAddressInfo*>& addressList = _activeDisassemblyAddressInfo[location - _activeDisassemblyStartLocation];
-	for (std::list<DisassemblyAddressInfo*>::const_iterator i = addressList.begin(); i != addressList.end(); ++i)
+	for (unsigned int slotIndex = _activeDisassemblyAddressSlotHead[location - _activeDisassemblyStartLocation]; slotIndex != NoDisassemblyAddressSlot; slotIndex = _activeDisassemblyAddressSlots[slotIndex].nextSlot)
 	{
-		DisassemblyAddressInfo* entry = *i;
-		if ((entry->entryType == DisassemblyEntryType::Data) && (entry->baseMemoryAddress == location) && (entry->memoryBlockSize == dataSize) && (entry->dataType == dataType) && entry->arrayStartingHereDefined)
+		const DisassemblyAddressInfo& entry = _activeDisassemblyAddressInfo[_activeDisassemblyAddressSlots[slotIndex].entryIndex];
+		if ((entry.entryType == DisassemblyEntryType::Data) && (entry.baseMemoryAddress == location) && (entry.memoryBlockSize == dataSize) && (entry.dataType == dataType) && entry.arrayStartingHereDefined)
 		{
-			return entry->arrayIDStartingHere;
+			return entry.arrayIDStartingHere;
 		}
 	}
 
@@ -1628,26 +1992,27 @@ void Processor::AddDisassemblyAddressInfoCode(unsigned int location, unsigned in
 		return;
 	}
 
-	// Try and find identical existing references at the same address
+	// Try and find identical existing references at the same address. This is the path
+	// taken for every executed opcode after the first time it's seen, so it only walks
+	// the slot chain for this address, and performs no allocation.
 	bool foundExistingCodeReference = false;
-	std::list<DisassemblyAddressInfo*>& addressList = _activeDisassemblyAddressInfo[location - _activeDisassemblyStartLocation];
-	for (std::list<DisassemblyAddressInfo*>::const_iterator i = addressList.begin(); i != addressList.end(); ++i)
+	for (unsigned int slotIndex = _activeDisassemblyAddressSlotHead[location - _activeDisassemblyStartLocation]; slotIndex != NoDisassemblyAddressSlot; slotIndex = _activeDisassemblyAddressSlots[slotIndex].nextSlot)
 	{
-		DisassemblyAddressInfo* entry = *i;
-		if ((entry->baseMemoryAddress == location) && (entry->memoryBlockSize == dataSize))
+		DisassemblyAddressInfo& entry = _activeDisassemblyAddressInfo[_activeDisassemblyAddressSlots[slotIndex].entryIndex];
+		if ((entry.baseMemoryAddress == location) && (entry.memoryBlockSize == dataSize))
 		{
 			// Check if this entry refers to an opcode
-			if (entry->entryType == DisassemblyEntryType::Code)
+			if (entry.entryType == DisassemblyEntryType::Code)
 			{
 				// Flag if we've found an existing reference to an opcode at this location
 				foundExistingCodeReference = true;
 			}
-			else if (entry->entryType == DisassemblyEntryType::CodeAutoDetect)
+			else if (entry.entryType == DisassemblyEntryType::CodeAutoDetect)
 			{
 				// If we've found a reference to an auto-detected opcode at this location,
 				// change it to a confirmed opcode, and flag that we've found an existing
 				// opcode reference here.
-				entry->entryType = DisassemblyEntryType::Code;
+				entry.entryType = DisassemblyEntryType::Code;
 				foundExistingCodeReference = true;
 			}
 		}
@@ -1660,19 +2025,18 @@ void Processor::AddDisassemblyAddressInfoCode(unsigned int location, unsigned in
 		return;
 	}
 
-	// Create a new DisassemblyAddressInfo object to describe the entry, and insert it into
-	// the set of DisassemblyAddressInfo objects.
-	DisassemblyAddressInfo* newEntry = new DisassemblyAddressInfo();
-	newEntry->entryType = DisassemblyEntryType::Code;
-	newEntry->baseMemoryAddress = location;
-	newEntry->memoryBlockSize = dataSize;
-	newEntry->comment = comment;
-	newEntry->entryDefinedOutsideArray = true;
-	_activeDisassemblyAddressInfoSet.insert(newEntry);
+	// Create a new DisassemblyAddressInfo object in the entry arena to describe the entry
+	unsigned int newEntryIndex = CreateDisassemblyAddressInfoEntry();
+	DisassemblyAddressInfo& newEntry = _activeDisassemblyAddressInfo[newEntryIndex];
+	newEntry.entryType = DisassemblyEntryType::Code;
+	newEntry.baseMemoryAddress = location;
+	newEntry.memoryBlockSize = dataSize;
+	newEntry.comment = comment;
+	newEntry.entryDefinedOutsideArray = true;
 
-	// Add the new reference to the reference list at each address location it occupies,
-	// and set conflict flags where appropriate.
-	AddDisassemblyAddressInfoEntryToArray(newEntry);
+	// Add the new reference to the slot chain at each address location it occupies, and
+	// set conflict flags where appropriate.
+	AddDisassemblyAddressInfoEntryToArray(newEntryIndex);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -1693,40 +2057,41 @@ void Processor::AddDisassemblyAddressInfoData(unsigned int location, unsigned in
 
 	// Try and find identical existing references at the same address
 	bool foundExistingDataReference = false;
-	DisassemblyAddressInfo* targetEntry = 0;
-	std::list<DisassemblyAddressInfo*>& addressList = _activeDisassemblyAddressInfo[location - _activeDisassemblyStartLocation];
-	std::list<DisassemblyAddressInfo*>::const_iterator addressListIterator = addressList.begin();
-	while (!foundExistingDataReference && (addressListIterator != addressList.end()))
+	unsigned int targetEntryIndex = 0;
+	unsigned int slotIndex = _activeDisassemblyAddressSlotHead[location - _activeDisassemblyStartLocation];
+	while (!foundExistingDataReference && (slotIndex != NoDisassemblyAddressSlot))
 	{
-		DisassemblyAddressInfo* entry = *addressListIterator;
-		if ((entry->entryType == DisassemblyEntryType::Data) && (entry->baseMemoryAddress == location) && (entry->memoryBlockSize == dataSize) && (entry->dataType == dataType))
+		const DisassemblyAddressSlot& slot = _activeDisassemblyAddressSlots[slotIndex];
+		const DisassemblyAddressInfo& entry = _activeDisassemblyAddressInfo[slot.entryIndex];
+		if ((entry.entryType == DisassemblyEntryType::Data) && (entry.baseMemoryAddress == location) && (entry.memoryBlockSize == dataSize) && (entry.dataType == dataType))
 		{
 			foundExistingDataReference = true;
-			targetEntry = entry;
+			targetEntryIndex = slot.entryIndex;
 			continue;
 		}
-		++addressListIterator;
+		slotIndex = slot.nextSlot;
 	}
 
 	// If we didn't manage to find an identical existing reference, create a new entry for
 	// this data reference.
 	if (!foundExistingDataReference)
 	{
-		// Create a new DisassemblyAddressInfo object to describe the entry, and insert it
-		// into the set of DisassemblyAddressInfo objects.
-		targetEntry = new DisassemblyAddressInfo();
-		targetEntry->entryType = DisassemblyEntryType::Data;
-		targetEntry->baseMemoryAddress = location;
-		targetEntry->memoryBlockSize = dataSize;
-		targetEntry->dataType = dataType;
-		targetEntry->comment = comment;
-		targetEntry->entryDefinedOutsideArray = (arrayID == 0);
-		_activeDisassemblyAddressInfoSet.insert(targetEntry);
+		// Create a new DisassemblyAddressInfo object in the entry arena to describe the
+		// entry
+		targetEntryIndex = CreateDisassemblyAddressInfoEntry();
+		DisassemblyAddressInfo& newEntry = _activeDisassemblyAddressInfo[targetEntryIndex];
+		newEntry.entryType = DisassemblyEntryType::Data;
+		newEntry.baseMemoryAddress = location;
+		newEntry.memoryBlockSize = dataSize;
+		newEntry.dataType = dataType;
+		newEntry.comment = comment;
+		newEntry.entryDefinedOutsideArray = (arrayID == 0);
 
-		// Add the new reference to the reference list at each address location it
-		// occupies, and set conflict flags where appropriate.
-		AddDisassemblyAddressInfoEntryToArray(targetEntry);
+		// Add the new reference to the slot chain at each address location it occupies,
+		// and set conflict flags where appropriate.
+		AddDisassemblyAddressInfoEntryToArray(targetEntryIndex);
 	}
+	DisassemblyAddressInfo* targetEntry = &_activeDisassemblyAddressInfo[targetEntryIndex];
 
 	// Add this data entry to the target array if an array ID has been specified
 	if (arrayID != 0)
@@ -1777,11 +2142,10 @@ void Processor::AddDisassemblyAddressInfoOffset(unsigned int location, unsigned
 
 	// Try and find identical existing references at the same address
 	bool foundExistingDataReference = false;
-	std::list<DisassemblyAddressInfo*>& addressList = _activeDisassemblyAddressInfo[location - _activeDisassemblyStartLocation];
-	for (std::list<DisassemblyAddressInfo*>::const_iterator i = addressList.begin(); i != addressList.end(); ++i)
+	for (unsigned int slotIndex = _activeDisassemblyAddressSlotHead[location - _activeDisassemblyStartLocation]; !foundExistingDataReference && (slotIndex != NoDisassemblyAddressSlot); slotIndex = _activeDisassemblyAddressSlots[slotIndex].nextSlot)
 	{
-		DisassemblyAddressInfo* entry = *i;
-		if ((entry->entryType == entryType) && (entry->baseMemoryAddress == location) && (entry->memoryBlockSize == dataSize))
+		const DisassemblyAddressInfo& entry = _activeDisassemblyAddressInfo[_activeDisassemblyAddressSlots[slotIndex].entryIndex];
+		if ((entry.entryType == entryType) && (entry.baseMemoryAddress == location) && (entry.memoryBlockSize == dataSize))
 		{
 			foundExistingDataReference = true;
 		}
@@ -1794,20 +2158,19 @@ void Processor::AddDisassemblyAddressInfoOffset(unsigned int location, unsigned
 		return;
 	}
 
-	// Create a new DisassemblyAddressInfo object to describe the entry, and insert it into
-	// the set of DisassemblyAddressInfo objects.
-	DisassemblyAddressInfo* newEntry = new DisassemblyAddressInfo();
-	newEntry->entryType = entryType;
-	newEntry->baseMemoryAddress = location;
-	newEntry->memoryBlockSize = dataSize;
-	newEntry->relativeOffset = relativeOffset;
-	newEntry->relativeOffsetBaseAddress = relativeOffsetBaseAddress;
-	newEntry->entryDefinedOutsideArray = true;
-	_activeDisassemblyAddressInfoSet.insert(newEntry);
+	// Create a new DisassemblyAddressInfo object in the entry arena to describe the entry
+	unsigned int newEntryIndex = CreateDisassemblyAddressInfoEntry();
+	DisassemblyAddressInfo& newEntry = _activeDisassemblyAddressInfo[newEntryIndex];
+	newEntry.entryType = entryType;
+	newEntry.baseMemoryAddress = location;
+	newEntry.memoryBlockSize = dataSize;
+	newEntry.relativeOffset = relativeOffset;
+	newEntry.relativeOffsetBaseAddress = relativeOffsetBaseAddress;
+	newEntry.entryDefinedOutsideArray = true;
 
-	// Add the new reference to the reference list at each address location it occupies,
-	// and set conflict flags where appropriate.
-	AddDisassemblyAddressInfoEntryToArray(newEntry);
+	// Add the new reference to the slot chain at each address location it occupies, and
+	// set conflict flags where appropriate.
+	AddDisassemblyAddressInfoEntryToArray(newEntryIndex);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -1851,24 +2214,35 @@ void Processor::AddDisassemblyPossibleBranchTable(unsigned int baseAddress, unsi
 }
 
 //----------------------------------------------------------------------------------------------------------------------
-void Processor::AddDisassemblyAddressInfoEntryToArray(DisassemblyAddressInfo* newEntry)
+unsigned int Processor::CreateDisassemblyAddressInfoEntry()
+{
+	// Append a new default constructed entry to the arena. Entries are never individually
+	// removed from the arena, so the index of an entry remains valid until the arena is
+	// cleared or compacted, at which point the slot table is rebuilt.
+	_activeDisassemblyAddressInfo.emplace_back();
+	return (unsigned int)(_activeDisassemblyAddressInfo.size() - 1);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void Processor::AddDisassemblyAddressInfoEntryToArray(unsigned int entryIndex)
 {
 	// Verify that the start address of this entry lies within the array bounds
+	DisassemblyAddressInfo* newEntry = &_activeDisassemblyAddressInfo[entryIndex];
 	if (newEntry->baseMemoryAddress < _activeDisassemblyStartLocation)
 	{
 		return;
 	}
 
-	// Add the new reference to the reference list at each address location it occupies,
-	// and set conflict flags where appropriate.
+	// Add the new reference to the slot chain at each address location it occupies, and
+	// set conflict flags where appropriate.
 	for (unsigned int locationOffset = 0; (locationOffset < newEntry->memoryBlockSize) && ((newEntry->baseMemoryAddress + locationOffset) < _activeDisassemblyEndLocation); ++locationOffset)
 	{
 		// Iterate over each address which falls within the range of this new entry, and
 		// set the conflict flags appropriately if there are any known code clashes.
-		std::list<DisassemblyAddressInfo*>& addressList = _activeDisassemblyAddressInfo[(newEntry->baseMemoryAddress - _activeDisassemblyStartLocation) + locationOffset];
-		for (std::list<DisassemblyAddressInfo*>::const_iterator i = addressList.begin(); i != addressList.end(); ++i)
+		unsigned int& slotHead = _activeDisassemblyAddressSlotHead[(newEntry->baseMemoryAddress - _activeDisassemblyStartLocation) + locationOffset];
+		for (unsigned int slotIndex = slotHead; slotIndex != NoDisassemblyAddressSlot; slotIndex = _activeDisassemblyAddressSlots[slotIndex].nextSlot)
 		{
-			DisassemblyAddressInfo* entry = *i;
+			DisassemblyAddressInfo* entry = &_activeDisassemblyAddressInfo[_activeDisassemblyAddressSlots[slotIndex].entryIndex];
 
 			if (newEntry->entryType == DisassemblyEntryType::Code)
 			{
@@ -1908,8 +2282,28 @@ void Processor::AddDisassemblyAddressInfoEntryToArray(DisassemblyAddressInfo* ne
 			}
 		}
 
-		// Add the new reference to the list
-		addressList.push_front(newEntry);
+		// Add the new reference to the head of the slot chain
+		DisassemblyAddressSlot slot;
+		slot.entryIndex = entryIndex;
+		slot.nextSlot = slotHead;
+		slotHead = (unsigned int)_activeDisassemblyAddressSlots.size();
+		_activeDisassemblyAddressSlots.push_back(slot);
+	}
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void Processor::RebuildDisassemblyAddressSlotTable()
+{
+	// Reset the slot table to cover the current active disassembly region
+	_activeDisassemblyAddressSlotHead.assign(_activeDisassemblyEndLocation - _activeDisassemblyStartLocation, NoDisassemblyAddressSlot);
+	_activeDisassemblyAddressSlots.clear();
+
+	// Add each entry in the arena back into the slot table, in the order the entries
+	// were originally recorded.
+	unsigned int entryCount = (unsigned int)_activeDisassemblyAddressInfo.size();
+	for (unsigned int entryIndex = 0; entryIndex < entryCount; ++entryIndex)
+	{
+		AddDisassemblyAddressInfoEntryToArray(entryIndex);
 	}
 }
 
@@ -1948,9 +2342,9 @@ bool Processor::PerformActiveDisassemblyAnalysis(unsigned int minAddress, unsign
 	// Load the active disassembly data into our analysis arrays
 	std::map<unsigned int, const DisassemblyAddressInfo*> disassemblyDataSortedRaw;
 	std::map<unsigned int, const DisassemblyAddressInfo*> disassemblyOffsetSortedRaw;
-	for (std::set<DisassemblyAddressInfo*>::const_iterator i = _activeDisassemblyAddressInfoSet.begin(); i != _activeDisassemblyAddressInfoSet.end(); ++i)
+	for (std::deque<DisassemblyAddressInfo>::const_iterator i = _activeDisassemblyAddressInfo.begin(); i != _activeDisassemblyAddressInfo.end(); ++i)
 	{
-		DisassemblyAddressInfo* entry = *i;
+		const DisassemblyAddressInfo* entry = &(*i);
 
 		// Exclude entries which lie outside the analysis region
 		if ((entry->baseMemoryAddress < analysis.minAddress) || ((entry->baseMemoryAddress + entry->memoryBlockSize) > analysis.maxAddress))
@@ -1998,19 +2392,19 @@ bool Processor::PerformActiveDisassemblyAnalysis(unsigned int minAddress, unsign
 		case DisassemblyEntryType::Data:
 			if (_activeDisassemblyAnalyzeData && entry->entryDefinedOutsideArray)
 			{
-				disassemblyDataSortedRaw.insert(std::pair<unsigned int, DisassemblyAddressInfo*>(entry->baseMemoryAddress, entry));
+				disassemblyDataSortedRaw.insert(std::pair<unsigned int, const DisassemblyAddressInfo*>(entry->baseMemoryAddress, entry));
 			}
 			break;
 		case DisassemblyEntryType::OffsetCode:
 			if (_activeDisassemblyAnalyzeCodeOffsets)
 			{
-				disassemblyOffsetSortedRaw.insert(std::pair<unsigned int, DisassemblyAddressInfo*>(entry->baseMemoryAddress, entry));
+				disassemblyOffsetSortedRaw.insert(std::pair<unsigned int, const DisassemblyAddressInfo*>(entry->baseMemoryAddress, entry));
 			}
 			break;
 		case DisassemblyEntryType::OffsetData:
 			if (_activeDisassemblyAnalyzeDataOffsets)
 			{
-				disassemblyOffsetSortedRaw.insert(std::pair<unsigned int, DisassemblyAddressInfo*>(entry->baseMemoryAddress, entry));
+				disassemblyOffsetSortedRaw.insert(std::pair<unsigned int, const DisassemblyAddressInfo*>(entry->baseMemoryAddress, entry));
 			}
 			break;
 		default:
@@ -2491,7 +2885,7 @@ bool Processor::ActiveDisassemblyEntrySeemsToBePartOfArray(ActiveDisassemblyAnal
 	while (!foundOverlappingOpcode && (memoryBaseOffset < (currentEntry->baseMemoryAddress - lastKnownEntryLocation)))
 	{
 		unsigned int entryByteLocation = lastKnownEntryLocation + memoryBaseOffset;
-		for (std::list<DisassemblyAddressInfo*>::const_iterator i = analysis.disassemblyAddressInfo[entryByteLocation - analysis.minAddress].begin(); i != analysis.disassemblyAddressInfo[entryByteLocation - analysis.minAddress].end(); ++i)
+		for (std::list<const DisassemblyAddressInfo*>::const_iterator i = analysis.disassemblyAddressInfo[entryByteLocation - analysis.minAddress].begin(); i != analysis.disassemblyAddressInfo[entryByteLocation - analysis.minAddress].end(); ++i)
 		{
 			if ((*i)->entryType == DisassemblyEntryType::Code)
 			{
@@ -3290,8 +3684,8 @@ void Processor::ActiveDisassemblyAddLabelForTarget(ActiveDisassemblyAnalysisData
 	// free location where a label can be placed.
 	int locationOffset = 0;
 	unsigned int adjustedAddress = targetAddress;
-	const std::list<DisassemblyAddressInfo*>& entriesForAddress = analysis.disassemblyAddressInfo[targetAddress - analysis.minAddress];
-	for (std::list<DisassemblyAddressInfo*>::const_iterator i = entriesForAddress.begin(); i != entriesForAddress.end(); ++i)
+	const std::list<const DisassemblyAddressInfo*>& entriesForAddress = analysis.disassemblyAddressInfo[targetAddress - analysis.minAddress];
+	for (std::list<const DisassemblyAddressInfo*>::const_iterator i = entriesForAddress.begin(); i != entriesForAddress.end(); ++i)
 	{
 		const DisassemblyAddressInfo* entry = *i;
 		if (entry->baseMemoryAddress != targetAddress)
@@ -4289,6 +4683,9 @@ void Processor::LoadState(IHierarchicalStorageNode& node)
 	}
 
 	Device::LoadState(node);
+
+	// Flag that our state has been replaced for any debugger views
+	AllGenericDataModified();
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -4333,7 +4730,11 @@ void Processor::LoadDebuggerState(IHierarchicalStorageNode& node)
 				// Trace
 				else if (registerName == L"TraceEnabled")			_traceLogEnabled = i->ExtractData<bool>();
 				else if (registerName == L"TraceDisassemble")		_traceLogDisassemble = i->ExtractData<bool>();
-				else if (registerName == L"TraceLength")			_traceLogLength = i->ExtractData<unsigned int>();
+				else if (registerName == L"TraceLength")
+				{
+					std::unique_lock<std::mutex> traceLock(_traceMutex);
+					ResizeTraceRecordBuffer(i->ExtractData<unsigned int>());
+				}
 				else if (registerName == L"TraceLogToFile")			_traceLogToFile = i->ExtractData<bool>();
 				else if (registerName == L"TraceFilePath")			_traceFilePath = i->GetData();
 				// Active Disassembly
@@ -4398,6 +4799,7 @@ void Processor::LoadDebuggerState(IHierarchicalStorageNode& node)
 				}
 			}
 			_breakpointExists = !_breakpoints.empty();
+			RebuildBreakpointFilter();
 		}
 		else if (keyName == L"WatchpointList")
 		{
@@ -4419,6 +4821,7 @@ void Processor::LoadDebuggerState(IHierarchicalStorageNode& node)
 				}
 			}
 			_watchpointExists = !_watchpoints.empty();
+			RebuildWatchpointFilters();
 		}
 		else if (keyName == L"ActiveDisassemblyData")
 		{
@@ -4439,7 +4842,7 @@ void Processor::LoadDebuggerState(IHierarchicalStorageNode& node)
 			stream.ReadData(disassemblyEntryCount);
 			for (unsigned int entryNo = 0; entryNo < disassemblyEntryCount; ++entryNo)
 			{
-				DisassemblyAddressInfo* entry = new DisassemblyAddressInfo();
+				DisassemblyAddressInfo* entry = &_activeDisassemblyAddressInfo[CreateDisassemblyAddressInfoEntry()];
 				unsigned int entryType;
 				unsigned int dataType;
 				stream.ReadData(entryType);
@@ -4471,8 +4874,6 @@ void Processor::LoadDebuggerState(IHierarchicalStorageNode& node)
 				{
 					stream.ReadData(entry->comment[charNo]);
 				}
-
-				_activeDisassemblyAddressInfoSet.insert(entry);
 			}
 
 			// Read all jump table entries from the saved data
@@ -4526,14 +4927,10 @@ void Processor::LoadDebuggerState(IHierarchicalStorageNode& node)
 		_activeDisassemblyStartLocation = newActiveDisassemblyStartLocation;
 		_activeDisassemblyEndLocation = newActiveDisassemblyEndLocation;
 
-		// Clear disassemblyAddressInfo and resize it correctly for the new region if
-		// active disassembly is currently enabled.
-		_activeDisassemblyAddressInfo.clear();
-		if (_activeDisassemblyEnabled)
-		{
-			unsigned int disassemblyAddressInfoArraySize = _activeDisassemblyEndLocation - _activeDisassemblyStartLocation;
-			_activeDisassemblyAddressInfo.resize(disassemblyAddressInfoArraySize);
-		}
+		// Clear the slot table. It will be rebuilt for the new region below if active
+		// disassembly is currently enabled.
+		_activeDisassemblyAddressSlotHead.clear();
+		_activeDisassemblyAddressSlots.clear();
 	}
 
 	// If new active disassembly data was loaded, Clear the active disassembly analysis
@@ -4543,16 +4940,12 @@ void Processor::LoadDebuggerState(IHierarchicalStorageNode& node)
 		_activeDisassemblyAnalysis->Initialize();
 	}
 
-	// If new active disassembly data was loaded, and active disassembly is currently
-	// running, ensure that the physical address entry array is updated to contain the new
-	// entries.
-	if (activeDisassemblyDataLoaded && _activeDisassemblyEnabled)
+	// If new active disassembly data was loaded or the active region has changed, and
+	// active disassembly is currently running, ensure that the slot table is rebuilt to
+	// reference all entries in the arena.
+	if ((activeDisassemblyDataLoaded || activeDisassemblyStateChanged) && _activeDisassemblyEnabled)
 	{
-		// Add all address entries to the memory array
-		for (std::set<DisassemblyAddressInfo*>::const_iterator addressInfoIterator = _activeDisassemblyAddressInfoSet.begin(); addressInfoIterator != _activeDisassemblyAddressInfoSet.end(); ++addressInfoIterator)
-		{
-			AddDisassemblyAddressInfoEntryToArray(*addressInfoIterator);
-		}
+		RebuildDisassemblyAddressSlotTable();
 	}
 
 	Device::LoadDebuggerState(node);
@@ -4620,7 +5013,7 @@ void Processor::SaveDebuggerState(IHierarchicalStorageNode& node) const
 	node.CreateChild(L"Register", _activeDisassemblyMinimumArrayEntryCount).CreateAttribute(L"name", L"ActiveDisassemblyMinimumArrayEntryCount");
 	node.CreateChildHex(L"Register", _activeDisassemblyOffsetArrayDistanceTolerance, GetAddressBusCharWidth()).CreateAttribute(L"name", L"ActiveDisassemblyOffsetArrayDistanceTolerance");
 	node.CreateChildHex(L"Register", _activeDisassemblyJumpTableDistanceTolerance, GetAddressBusCharWidth()).CreateAttribute(L"name", L"ActiveDisassemblyJumpTableDistanceTolerance");
-	if (!_activeDisassemblyAddressInfoSet.empty())
+	if (!_activeDisassemblyAddressInfo.empty())
 	{
 		// Create and configure the child node to store our active disassembly data as a
 		// binary data stream.
@@ -4637,10 +5030,10 @@ void Processor::SaveDebuggerState(IHierarchicalStorageNode& node) const
 		stream.WriteData((unsigned int)1);
 
 		// Write all address entries to the saved data
-		stream.WriteData((unsigned int)_activeDisassemblyAddressInfoSet.size());
-		for (std::set<DisassemblyAddressInfo*>::const_iterator i = _activeDisassemblyAddressInfoSet.begin(); i != _activeDisassemblyAddressInfoSet.end(); ++i)
+		stream.WriteData((unsigned int)_activeDisassemblyAddressInfo.size());
+		for (std::deque<DisassemblyAddressInfo>::const_iterator i = _activeDisassemblyAddressInfo.begin(); i != _activeDisassemblyAddressInfo.end(); ++i)
 		{
-			const DisassemblyAddressInfo* entry = *i;
+			const DisassemblyAddressInfo* entry = &(*i);
 			stream.WriteData((unsigned int)entry->entryType);
 			stream.WriteData(entry->baseMemoryAddress);
 			stream.WriteData(entry->memoryBlockSize);
@@ -4848,7 +5241,7 @@ bool Processor::ReadGenericData(unsigned int dataID, const DataContext* dataCont
 }
 
 //----------------------------------------------------------------------------------------------------------------------
-bool Processor::WriteGenericData(unsigned int dataID, const DataContext* dataContext, IGenericAccessDataValue& dataValue)
+bool Processor::WriteGenericDataInternal(unsigned int dataID, const DataContext* dataContext, IGenericAccessDataValue& dataValue)
 {
 	ApplyGenericDataValueLimitSettings(dataID, dataValue);
 	IGenericAccessDataValue::DataType dataType = dataValue.GetType();
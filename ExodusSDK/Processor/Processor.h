@@ -106,14 +106,18 @@ actually executed are disassembled correctly.
 #include <string>
 #include <vector>
 #include <list>
+#include <deque>
 #include <set>
 #include <map>
 #include "Breakpoint.h"
 #include "Watchpoint.h"
+#include "DebugAddressFilter.h"
 #include "ThinContainers/ThinContainers.pkg"
 #include "Stream/Stream.pkg"
 #include <mutex>
 #include <condition_variable>
+#include <thread>
+#include <atomic>
 
 class Processor :public Device, public GenericAccessBase<IProcessor>
 {
@@ -210,6 +214,7 @@ public:
 	virtual Marshal::Ret<std::list<TraceLogEntry>> GetTraceLog() const;
 	virtual unsigned int GetTraceLogLastModifiedToken() const;
 	virtual void ClearTraceLog();
+	virtual bool ExportTraceFileToTextFile(const Marshal::In<std::wstring>& traceFilePath, const Marshal::In<std::wstring>& textFilePath) const;
 	inline void RecordTrace(unsigned int pc);
 
 	// Active disassembly info functions
@@ -308,9 +313,8 @@ public:
 
 	// Data read/write functions
 	using IGenericAccess::ReadGenericData;
-	using IGenericAccess::WriteGenericData;
 	virtual bool ReadGenericData(unsigned int dataID, const DataContext* dataContext, IGenericAccessDataValue& dataValue) const;
-	virtual bool WriteGenericData(unsigned int dataID, const DataContext* dataContext, IGenericAccessDataValue& dataValue);
+	virtual bool WriteGenericDataInternal(unsigned int dataID, const DataContext* dataContext, IGenericAccessDataValue& dataValue);
 
 	// Command execution functions
 	virtual bool ExecuteGenericCommand(unsigned int commandID, const DataContext* dataContext);
@@ -322,7 +326,10 @@ private:
 	// Structures
 	struct BreakpointCallbackParams;
 	struct WatchpointCallbackParams;
+	struct TraceRecord;
+	struct TraceRecordSlot;
 	struct DisassemblyAddressInfo;
+	struct DisassemblyAddressSlot;
 	struct DisassemblyArrayInfo;
 	struct DisassemblyJumpTableInfo;
 	struct ActiveDisassemblyAnalysisData;
@@ -332,10 +339,19 @@ private:
 	typedef std::pair<unsigned int, DisassemblyArrayInfo> DisassemblyArrayInfoMapEntry;
 	typedef std::map<unsigned int, DisassemblyJumpTableInfo> DisassemblyJumpTableInfoMap;
 	typedef std::pair<unsigned int, DisassemblyJumpTableInfo> DisassemblyJumpTableInfoMapEntry;
+	typedef std::map<unsigned int, TraceLogEntry> TraceDisassemblyCache;
+
+	// Constants
+	static const unsigned int TraceFileFormatVersion = 1;
+	static const unsigned int TraceFileRecordSize = 12;
+	static const unsigned int TraceFileRecordBufferSize = 0x10000;
+	static const unsigned int TraceFileWriterPollIntervalInMilliseconds = 5;
+	static const unsigned int NoDisassemblyAddressSlot = 0xFFFFFFFF;
 
 private:
 	// Breakpoint functions
 	void CheckExecutionInternal(unsigned int location);
+	void RebuildBreakpointFilter() const;
 	void TriggerBreakpoint(Breakpoint* breakpoint) const;
 	static void BreakpointCallbackRaw(void* params);
 	void BreakpointCallback(Breakpoint* breakpoint) const;
@@ -343,6 +359,7 @@ private:
 	// Watchpoint functions
 	void CheckMemoryReadInternal(unsigned int location, unsigned int data);
 	void CheckMemoryWriteInternal(unsigned int location, unsigned int data);
+	void RebuildWatchpointFilters() const;
 	void TriggerWatchpoint(Watchpoint* watchpoint) const;
 	static void WatchpointCallbackRaw(void* params);
 	void WatchpointCallback(Watchpoint* watchpoint) const;
@@ -351,6 +368,11 @@ private:
 	bool OpenTraceFile(const std::wstring& filePath);
 	void CloseTraceFile();
 	void RecordTraceInternal(unsigned int pc);
+	void ApplyPendingTraceLengthChange();
+	void ResizeTraceRecordBuffer(unsigned int length);
+	void WriteTraceFileRecord(const TraceRecord& record);
+	void TraceFileWriterThread();
+	const TraceLogEntry& GetTraceLogEntry(unsigned int address, bool disassemble, TraceDisassemblyCache& disassemblyCache) const;
 
 	// Active disassembly operation functions
 	void EnableActiveDisassembly(unsigned int startLocation, unsigned int endLocation);
@@ -358,7 +380,9 @@ private:
 	void ClearActiveDisassemblyInternal();
 
 	// Active disassembly logging functions
-	void AddDisassemblyAddressInfoEntryToArray(DisassemblyAddressInfo* newEntry);
+	unsigned int CreateDisassemblyAddressInfoEntry();
+	void AddDisassemblyAddressInfoEntryToArray(unsigned int entryIndex);
+	void RebuildDisassemblyAddressSlotTable();
 
 	// Active disassembly analysis functions
 	bool PerformActiveDisassemblyAnalysis(unsigned int minAddress, unsigned int maxAddress, ActiveDisassemblyAnalysisData& analysis) const;
@@ -396,6 +420,9 @@ private:
 	volatile bool _breakpointExists;
 	volatile bool _watchpointExists;
 	volatile bool _transientBreakpointExists;
+	mutable DebugAddressFilter _breakpointFilter;
+	mutable DebugAddressFilter _watchpointReadFilter;
+	mutable DebugAddressFilter _watchpointWriteFilter;
 
 	// Call stack
 	volatile bool _breakOnNextOpcode;
@@ -412,15 +439,28 @@ private:
 	unsigned int _callStackLastModifiedToken;
 
 	// Trace
-	std::list<TraceLogEntry> _traceLog;
-	std::list<TraceLogEntry> _btraceLog;
+	mutable std::mutex _traceMutex;
+	std::vector<TraceRecordSlot> _traceRecords;
+	unsigned int _traceRecordNextSlot;
+	std::atomic<unsigned long long> _traceRecordTotal;
+	unsigned long long _btraceRecordTotal;
+	std::atomic<unsigned long long> _traceRecordClearedTotal;
+	std::atomic<bool> _traceLogLengthChangePending;
 	std::wstring _traceFilePath;
 	Stream::File _traceFile;
 	bool _traceLogToFile;
+	std::atomic<bool> _traceFileWriterActive;
+	bool _traceFileWriterStopRequested;
+	std::vector<TraceRecord> _traceFileRecords;
+	std::atomic<unsigned int> _traceFileRecordWritePos;
+	std::atomic<unsigned int> _traceFileRecordReadPos;
+	std::mutex _traceFileWriterMutex;
+	std::condition_variable _traceFileWriterAdvance;
+	std::thread _traceFileWriterThread;
 	volatile bool _traceLogEnabled;
 	bool _traceLogDisassemble;
 	unsigned int _traceLogLength;
-	unsigned int _traceLogLastModifiedToken;
+	std::atomic<unsigned int> _traceLogLastModifiedToken;
 
 	// Active disassembly
 	bool _activeDisassemblyEnabled;
@@ -429,8 +469,9 @@ private:
 	unsigned int _activeDisassemblyEndLocation;
 	unsigned int _activeDisassemblyUncommittedStartLocation;
 	unsigned int _activeDisassemblyUncommittedEndLocation;
-	std::vector<std::list<DisassemblyAddressInfo*>> _activeDisassemblyAddressInfo;
-	std::set<DisassemblyAddressInfo*> _activeDisassemblyAddressInfoSet;
+	std::deque<DisassemblyAddressInfo> _activeDisassemblyAddressInfo;
+	std::vector<unsigned int> _activeDisassemblyAddressSlotHead;
+	std::vector<DisassemblyAddressSlot> _activeDisassemblyAddressSlots;
 	DisassemblyArrayInfoMap _activeDisassemblyArrayInfo;
 	DisassemblyJumpTableInfoMap _activeDisassemblyJumpTableInfo;
 	unsigned int _activeDisassemblyAnalysisStartLocation;
@@ -69,6 +69,24 @@ struct Processor::WatchpointCallbackParams
 	Watchpoint* watchpoint;
 };
 
+//----------------------------------------------------------------------------------------------------------------------
+struct Processor::TraceRecord
+{
+	unsigned int address;
+	double timesliceProgress;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+struct Processor::TraceRecordSlot
+{
+	// The sequence number of a slot is twice the number of the record it holds plus two
+	// once the record has been fully written, or plus one while the record is being
+	// written. A value of 0 indicates the slot has never held a record.
+	std::atomic<unsigned long long> sequenceNo;
+	std::atomic<unsigned int> address;
+	std::atomic<double> timesliceProgress;
+};
+
 //----------------------------------------------------------------------------------------------------------------------
 struct Processor::DisassemblyAddressInfo
 {
@@ -101,6 +119,13 @@ struct Processor::DisassemblyAddressInfo
 	std::set<unsigned int> arraysMemberOf;
 };
 
+//----------------------------------------------------------------------------------------------------------------------
+struct Processor::DisassemblyAddressSlot
+{
+	unsigned int entryIndex;
+	unsigned int nextSlot;
+};
+
 //----------------------------------------------------------------------------------------------------------------------
 struct Processor::DisassemblyArrayInfo
 {
@@ -176,7 +201,7 @@ struct Processor::ActiveDisassemblyAnalysisData
 	std::map<unsigned int, DisassemblyAddressInfo*> predictedCodeEntries;
 	std::map<unsigned int, DisassemblyAddressInfo*> predictedDataEntries;
 	std::map<unsigned int, DisassemblyAddressInfo*> predictedOffsetEntries;
-	std::vector<std::list<DisassemblyAddressInfo*>> disassemblyAddressInfo;
+	std::vector<std::list<const DisassemblyAddressInfo*>> disassemblyAddressInfo;
 };
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -242,7 +267,9 @@ void Processor::CheckExecution(unsigned int location)
 	// which we expect it will almost all the time, due to a lack of inlining and needing
 	// to prepare the stack and registers for inner variables that never get used. This has
 	// been verified through profiling as a performance bottleneck.
-	if (_breakpointExists || _breakOnNextOpcode || _stepOver || _transientBreakpointExists)
+	// Note that the breakpoint filter is only a quick rejection test. Any location it
+	// accepts still needs to be checked against each breakpoint.
+	if (_breakOnNextOpcode || _stepOver || ((_breakpointExists || _transientBreakpointExists) && _breakpointFilter.MayMatch(location)))
 	{
 		CheckExecutionInternal(location);
 	}
@@ -259,7 +286,7 @@ void Processor::CheckMemoryRead(unsigned int location, unsigned int data)
 	// which we expect it will almost all the time, due to a lack of inlining and needing
 	// to prepare the stack and registers for inner variables that never get used. This has
 	// been verified through profiling as a performance bottleneck.
-	if (_watchpointExists)
+	if (_watchpointExists && _watchpointReadFilter.MayMatch(location))
 	{
 		CheckMemoryReadInternal(location, data);
 	}
@@ -274,7 +301,7 @@ void Processor::CheckMemoryWrite(unsigned int location, unsigned int data)
 	// which we expect it will almost all the time, due to a lack of inlining and needing
 	// to prepare the stack and registers for inner variables that never get used. This has
 	// been verified through profiling as a performance bottleneck.
-	if (_watchpointExists)
+	if (_watchpointExists && _watchpointWriteFilter.MayMatch(location))
 	{
 		CheckMemoryWriteInternal(location, data);
 	}
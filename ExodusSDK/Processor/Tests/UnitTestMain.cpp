@@ -0,0 +1,366 @@
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+#include "Processor/DebugAddressFilter.h"
+#include <vector>
+#include <algorithm>
+#include <random>
+#include <chrono>
+
+struct TestLocationCondition
+{
+	enum class Condition
+	{
+		Equal,
+		Greater,
+		Less,
+		GreaterAndLess
+	};
+
+	TestLocationCondition(bool conditionNot, Condition condition, unsigned int data1, unsigned int data2, unsigned int mask)
+	:conditionNot(conditionNot), condition(condition), data1(data1), data2(data2), mask(mask)
+	{ }
+
+	bool GetLocationConditionNot() const
+	{
+		return conditionNot;
+	}
+	Condition GetLocationCondition() const
+	{
+		return condition;
+	}
+	unsigned int GetLocationConditionData1() const
+	{
+		return data1;
+	}
+	unsigned int GetLocationConditionData2() const
+	{
+		return data2;
+	}
+	unsigned int GetLocationMask() const
+	{
+		return mask;
+	}
+
+	// This is the same comparison performed by the Breakpoint and Watchpoint classes, which
+	// the filter must never reject a matching location for.
+	bool PassesLocationCondition(unsigned int location) const
+	{
+		bool result = true;
+		unsigned int locationMasked = (location & mask);
+		switch (condition)
+		{
+		case Condition::Equal:
+			result = (locationMasked == data1);
+			break;
+		case Condition::Greater:
+			result = (locationMasked > data1);
+			break;
+		case Condition::Less:
+			result = (locationMasked < data1);
+			break;
+		case Condition::GreaterAndLess:
+			result = (locationMasked > data1) && (locationMasked < data2);
+			break;
+		}
+		result ^= conditionNot;
+		return result;
+	}
+
+	bool conditionNot;
+	Condition condition;
+	unsigned int data1;
+	unsigned int data2;
+	unsigned int mask;
+};
+
+static std::vector<TestLocationCondition> BuildRandomConditions(std::mt19937& generator, unsigned int addressBusWidth, unsigned int conditionsPerType)
+{
+	// Build a set of conditions covering every condition type, with and without negation,
+	// using a full location mask, a mask which clears only page offset bits, and a mask
+	// which clears some of the page select bits. Data values are mostly drawn from the
+	// address range, with some values outside the address range and some values which
+	// don't fit within the location mask.
+	unsigned int addressBusMask = (addressBusWidth >= 32) ? 0xFFFFFFFF : ((1u << addressBusWidth) - 1);
+	std::uniform_int_distribution<unsigned int> addressDistribution(0, addressBusMask);
+	std::uniform_int_distribution<unsigned int> valueDistribution(0, 0xFFFFFFFF);
+	std::uniform_int_distribution<unsigned int> selectorDistribution(0, 7);
+	const TestLocationCondition::Condition conditionTypes[] = {TestLocationCondition::Condition::Equal, TestLocationCondition::Condition::Greater, TestLocationCondition::Condition::Less, TestLocationCondition::Condition::GreaterAndLess};
+	std::vector<TestLocationCondition> conditions;
+	for (TestLocationCondition::Condition conditionType : conditionTypes)
+	{
+		for (unsigned int conditionNot = 0; conditionNot < 2; ++conditionNot)
+		{
+			for (unsigned int maskType = 0; maskType < 3; ++maskType)
+			{
+				for (unsigned int i = 0; i < conditionsPerType; ++i)
+				{
+					unsigned int mask = addressBusMask;
+					if (maskType == 1)
+					{
+						mask &= ~(valueDistribution(generator) & 0x7);
+					}
+					else if (maskType == 2)
+					{
+						mask &= valueDistribution(generator) | 0x7;
+					}
+					unsigned int data1 = addressDistribution(generator);
+					unsigned int data2 = addressDistribution(generator);
+					unsigned int selector = selectorDistribution(generator);
+					if (selector == 0)
+					{
+						data1 = valueDistribution(generator);
+					}
+					else if (selector < 4)
+					{
+						data1 &= mask;
+						data2 &= mask;
+					}
+					if ((conditionType == TestLocationCondition::Condition::GreaterAndLess) && (data1 > data2) && (selector != 7))
+					{
+						std::swap(data1, data2);
+					}
+					conditions.push_back(TestLocationCondition(conditionNot != 0, conditionType, data1, data2, mask));
+				}
+			}
+		}
+	}
+	return conditions;
+}
+
+static std::vector<unsigned int> BuildSampleLocations(std::mt19937& generator, unsigned int addressBusWidth, const TestLocationCondition& condition)
+{
+	// For address buses which are too wide to test exhaustively, build a list of locations
+	// around each boundary of the condition, plus a set of locations which satisfy an equal
+	// comparison against each data value, and a set of random locations.
+	unsigned int addressBusMask = (addressBusWidth >= 32) ? 0xFFFFFFFF : ((1u << addressBusWidth) - 1);
+	std::uniform_int_distribution<unsigned int> addressDistribution(0, addressBusMask);
+	std::vector<unsigned int> locations;
+	const unsigned int boundaries[] = {0, addressBusMask, condition.data1, condition.data2};
+	for (unsigned int boundary : boundaries)
+	{
+		for (int offset = -2; offset <= 2; ++offset)
+		{
+			locations.push_back((boundary + (unsigned int)offset) & addressBusMask);
+		}
+	}
+	for (unsigned int i = 0; i < 64; ++i)
+	{
+		locations.push_back((condition.data1 & condition.mask) | (addressDistribution(generator) & ~condition.mask & addressBusMask));
+		locations.push_back((condition.data2 & condition.mask) | (addressDistribution(generator) & ~condition.mask & addressBusMask));
+		locations.push_back(addressDistribution(generator));
+	}
+	return locations;
+}
+
+TEST_CASE("DebugAddressFilter reports every location before initialization", "")
+{
+	DebugAddressFilter filter;
+	REQUIRE(filter.MayMatch(0));
+	REQUIRE(filter.MayMatch(0x1234));
+	REQUIRE(filter.MayMatch(0xFFFFFFFF));
+}
+
+TEST_CASE("DebugAddressFilter has no false negatives", "")
+{
+	std::mt19937 generator(0x5EED);
+
+	SECTION("Every location is checked for address buses narrow enough to map each page to a single location", "")
+	{
+		const unsigned int addressBusWidth = 16;
+		DebugAddressFilter filter;
+		filter.Initialize(addressBusWidth);
+		std::vector<TestLocationCondition> conditions = BuildRandomConditions(generator, addressBusWidth, 8);
+		for (const TestLocationCondition& condition : conditions)
+		{
+			filter.BeginRebuild();
+			filter.AddLocationCondition(condition);
+			filter.EndRebuild();
+			for (unsigned int location = 0; location < (1u << addressBusWidth); ++location)
+			{
+				if (condition.PassesLocationCondition(location) && !filter.MayMatch(location))
+				{
+					CAPTURE((int)condition.condition);
+					CAPTURE(condition.conditionNot);
+					CAPTURE(condition.data1);
+					CAPTURE(condition.data2);
+					CAPTURE(condition.mask);
+					CAPTURE(location);
+					REQUIRE(filter.MayMatch(location));
+				}
+			}
+		}
+	}
+
+	SECTION("Every location is checked for an address bus with multiple locations per page", "")
+	{
+		const unsigned int addressBusWidth = 18;
+		DebugAddressFilter filter;
+		filter.Initialize(addressBusWidth);
+		std::vector<TestLocationCondition> conditions = BuildRandomConditions(generator, addressBusWidth, 10);
+		for (const TestLocationCondition& condition : conditions)
+		{
+			filter.BeginRebuild();
+			filter.AddLocationCondition(condition);
+			filter.EndRebuild();
+			for (unsigned int location = 0; location < (1u << addressBusWidth); ++location)
+			{
+				if (condition.PassesLocationCondition(location) && !filter.MayMatch(location))
+				{
+					CAPTURE((int)condition.condition);
+					CAPTURE(condition.conditionNot);
+					CAPTURE(condition.data1);
+					CAPTURE(condition.data2);
+					CAPTURE(condition.mask);
+					CAPTURE(location);
+					REQUIRE(filter.MayMatch(location));
+				}
+			}
+		}
+	}
+
+	SECTION("Boundary and random locations are checked for wide address buses", "")
+	{
+		const unsigned int addressBusWidths[] = {24, 32};
+		for (unsigned int addressBusWidth : addressBusWidths)
+		{
+			DebugAddressFilter filter;
+			filter.Initialize(addressBusWidth);
+			std::vector<TestLocationCondition> conditions = BuildRandomConditions(generator, addressBusWidth, 20);
+			for (const TestLocationCondition& condition : conditions)
+			{
+				filter.BeginRebuild();
+				filter.AddLocationCondition(condition);
+				filter.EndRebuild();
+				std::vector<unsigned int> locations = BuildSampleLocations(generator, addressBusWidth, condition);
+				for (unsigned int location : locations)
+				{
+					if (condition.PassesLocationCondition(location) && !filter.MayMatch(location))
+					{
+						CAPTURE(addressBusWidth);
+						CAPTURE((int)condition.condition);
+						CAPTURE(condition.conditionNot);
+						CAPTURE(condition.data1);
+						CAPTURE(condition.data2);
+						CAPTURE(condition.mask);
+						CAPTURE(location);
+						REQUIRE(filter.MayMatch(location));
+					}
+				}
+			}
+		}
+	}
+
+	SECTION("Combined conditions and individual locations are all retained after a rebuild", "")
+	{
+		const unsigned int addressBusWidth = 18;
+		DebugAddressFilter filter;
+		filter.Initialize(addressBusWidth);
+		std::vector<TestLocationCondition> conditions = BuildRandomConditions(generator, addressBusWidth, 2);
+		std::vector<unsigned int> individualLocations = {0x00000, 0x12345, 0x3FFFF};
+		filter.BeginRebuild();
+		for (const TestLocationCondition& condition : conditions)
+		{
+			filter.AddLocationCondition(condition);
+		}
+		for (unsigned int location : individualLocations)
+		{
+			filter.AddLocation(location);
+		}
+		filter.EndRebuild();
+		for (unsigned int location = 0; location < (1u << addressBusWidth); ++location)
+		{
+			bool passes = std::find(individualLocations.begin(), individualLocations.end(), location) != individualLocations.end();
+			for (size_t i = 0; !passes && (i < conditions.size()); ++i)
+			{
+				passes = conditions[i].PassesLocationCondition(location);
+			}
+			if (passes && !filter.MayMatch(location))
+			{
+				CAPTURE(location);
+				REQUIRE(filter.MayMatch(location));
+			}
+		}
+	}
+}
+
+TEST_CASE("DebugAddressFilter rejects unrelated locations with many breakpoints", "")
+{
+	// Place several hundred breakpoints in the upper half of a 24-bit address space, then
+	// confirm that every location in the lower half is still rejected by the filter. The
+	// rejection is a single bitmap test, so the time taken to reject a location should not
+	// depend on the number of breakpoints.
+	const unsigned int addressBusWidth = 24;
+	const unsigned int breakpointCount = 500;
+	const unsigned int missLocationCount = (1u << (addressBusWidth - 1));
+	std::mt19937 generator(0xB0B);
+	std::uniform_int_distribution<unsigned int> upperHalfDistribution(missLocationCount, (1u << addressBusWidth) - 1);
+	std::vector<TestLocationCondition> breakpoints;
+	for (unsigned int i = 0; i < breakpointCount; ++i)
+	{
+		breakpoints.push_back(TestLocationCondition(false, TestLocationCondition::Condition::Equal, upperHalfDistribution(generator), 0, (1u << addressBusWidth) - 1));
+	}
+
+	DebugAddressFilter singleFilter;
+	singleFilter.Initialize(addressBusWidth);
+	singleFilter.BeginRebuild();
+	singleFilter.AddLocationCondition(breakpoints.front());
+	singleFilter.EndRebuild();
+
+	DebugAddressFilter manyFilter;
+	manyFilter.Initialize(addressBusWidth);
+	manyFilter.BeginRebuild();
+	for (const TestLocationCondition& breakpoint : breakpoints)
+	{
+		manyFilter.AddLocationCondition(breakpoint);
+	}
+	manyFilter.EndRebuild();
+
+	SECTION("All breakpoint locations pass the filter", "")
+	{
+		for (const TestLocationCondition& breakpoint : breakpoints)
+		{
+			REQUIRE(manyFilter.MayMatch(breakpoint.data1));
+		}
+	}
+
+	SECTION("Locations outside any breakpoint page are rejected", "")
+	{
+		unsigned int singleMatchCount = 0;
+		unsigned int manyMatchCount = 0;
+		for (unsigned int location = 0; location < missLocationCount; ++location)
+		{
+			singleMatchCount += singleFilter.MayMatch(location)? 1: 0;
+			manyMatchCount += manyFilter.MayMatch(location)? 1: 0;
+		}
+		REQUIRE(singleMatchCount == 0);
+		REQUIRE(manyMatchCount == 0);
+	}
+
+	SECTION("The time taken to reject a location does not grow with the number of breakpoints", "")
+	{
+		// We allow a generous margin here so that scheduling noise can't fail the test. A
+		// filter which scanned the breakpoint list would take hundreds of times longer.
+		auto timeMissPath = [&](const DebugAddressFilter& filter)
+		{
+			std::chrono::steady_clock::duration bestTime = std::chrono::steady_clock::duration::max();
+			unsigned int matchCount = 0;
+			for (unsigned int pass = 0; pass < 5; ++pass)
+			{
+				std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+				for (unsigned int location = 0; location < missLocationCount; ++location)
+				{
+					matchCount += filter.MayMatch(location)? 1: 0;
+				}
+				std::chrono::steady_clock::duration passTime = std::chrono::steady_clock::now() - startTime;
+				bestTime = (passTime < bestTime)? passTime: bestTime;
+			}
+			REQUIRE(matchCount == 0);
+			return std::chrono::duration_cast<std::chrono::microseconds>(bestTime).count();
+		};
+		long long singleTime = timeMissPath(singleFilter);
+		long long manyTime = timeMissPath(manyFilter);
+		CAPTURE(singleTime);
+		CAPTURE(manyTime);
+		REQUIRE(manyTime <= ((singleTime * 4) + 1000));
+	}
+}
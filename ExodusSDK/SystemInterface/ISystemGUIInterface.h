@@ -41,7 +41,7 @@ public:
 
 public:
 	// Interface version functions
-	static inline unsigned int ThisISystemGUIInterfaceVersion() { return 1; }
+	static inline unsigned int ThisISystemGUIInterfaceVersion() { return 3; }
 	virtual unsigned int GetISystemGUIInterfaceVersion() const = 0;
 
 	// Path functions
@@ -144,6 +144,15 @@ public:
 	virtual bool RestoreViewStateForDevice(const Marshal::In<std::wstring>& viewGroupName, const Marshal::In<std::wstring>& viewName, IHierarchicalStorageNode& viewState, IViewPresenter** restoredViewPresenter, unsigned int moduleID, const Marshal::In<std::wstring>& deviceInstanceName) const = 0;
 	virtual bool RestoreViewStateForExtension(const Marshal::In<std::wstring>& viewGroupName, const Marshal::In<std::wstring>& viewName, IHierarchicalStorageNode& viewState, IViewPresenter** restoredViewPresenter, const Marshal::In<std::wstring>& extensionInstanceName) const = 0;
 	virtual bool RestoreViewStateForExtension(const Marshal::In<std::wstring>& viewGroupName, const Marshal::In<std::wstring>& viewName, IHierarchicalStorageNode& viewState, IViewPresenter** restoredViewPresenter, unsigned int moduleID, const Marshal::In<std::wstring>& extensionInstanceName) const = 0;
+
+	// Savestate format functions
+	virtual bool GetBinarySavestateFormatState() const = 0;
+	virtual void SetBinarySavestateFormatState(bool state) = 0;
+
+	// State checkpoint functions
+	virtual bool CaptureStateCheckpoint() = 0;
+	virtual bool RestoreStateCheckpoint() = 0;
+	virtual bool GetStateCheckpointPresent() const = 0;
 };
 
 #include "ISystemGUIInterface.inl"
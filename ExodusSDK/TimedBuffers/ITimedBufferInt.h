@@ -20,6 +20,10 @@ public:
 	// Make sure the object can't be deleted from this base
 	protected: inline virtual ~ITimedBufferInt() = 0; public:
 
+	// Interface version functions
+	static inline unsigned int ThisITimedBufferIntVersion() { return 1; }
+	virtual unsigned int GetITimedBufferIntVersion() const = 0;
+
 	// Size functions
 	virtual unsigned int Size() const = 0;
 
@@ -63,6 +67,15 @@ public:
 protected:
 	// Access functions
 	virtual void GetLatestBufferCopy(DataType* buffer, unsigned int bufferSize) const = 0;
+
+public:
+	// Snapshot functions
+	virtual void PublishCommittedSnapshot() = 0;
+	inline bool GetCommittedSnapshot(std::vector<DataType>& buffer) const;
+
+protected:
+	// Snapshot functions
+	virtual bool GetCommittedSnapshot(DataType* buffer, unsigned int bufferSize) const = 0;
 };
 ITimedBufferInt::~ITimedBufferInt() { }
 
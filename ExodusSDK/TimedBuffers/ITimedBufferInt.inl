@@ -10,3 +10,13 @@ void ITimedBufferInt::GetLatestBufferCopy(std::vector<DataType>& buffer) const
 		GetLatestBufferCopy(&buffer[0], bufferSize);
 	}
 }
+
+//----------------------------------------------------------------------------------------------------------------------
+// Snapshot functions
+//----------------------------------------------------------------------------------------------------------------------
+bool ITimedBufferInt::GetCommittedSnapshot(std::vector<DataType>& buffer) const
+{
+	unsigned int bufferSize = Size();
+	buffer.resize(bufferSize);
+	return (bufferSize > 0) && GetCommittedSnapshot(&buffer[0], bufferSize);
+}
@@ -92,6 +92,8 @@ public:
 	void WriteLatest(unsigned int address, const DataType& data);
 	void GetLatestBufferCopy(std::vector<DataType>& buffer) const;
 	void GetLatestBufferCopy(DataType* buffer, unsigned int bufferSize) const;
+	void GetLatestBufferRange(unsigned int address, DataType* buffer, unsigned int count) const;
+	void GetCommittedBufferCopy(DataType* buffer, unsigned int bufferSize) const;
 
 	// Time management functions
 	void Initialize();
@@ -454,6 +454,54 @@ void RandomTimeAccessBuffer<DataType, TimesliceType>::GetLatestBufferCopy(DataTy
 	}
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+template<class DataType, class TimesliceType>
+void RandomTimeAccessBuffer<DataType, TimesliceType>::GetLatestBufferRange(unsigned int address, DataType* buffer, unsigned int count) const
+{
+	if (!_latestMemoryBufferExists)
+	{
+		std::unique_lock<std::mutex> lock(_accessLock);
+
+		// Populate the target buffer with the committed memory state for the target range
+		memcpy((void*)buffer, (const void*)&_memory[address], (size_t)count * sizeof(DataType));
+
+		// Commit each buffered write entry which falls within the target range to the
+		// target buffer
+		for (typename std::list<WriteEntry>::const_iterator i = _writeList.begin(); i != _writeList.end(); ++i)
+		{
+			if ((i->writeAddress >= address) && ((i->writeAddress - address) < count))
+			{
+				buffer[i->writeAddress - address] = i->newValue;
+			}
+		}
+	}
+	else
+	{
+		// Populate the target buffer with the latest memory state for the target range
+		memcpy((void*)buffer, (const void*)&_latestMemory[address], (size_t)count * sizeof(DataType));
+	}
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+template<class DataType, class TimesliceType>
+void RandomTimeAccessBuffer<DataType, TimesliceType>::GetCommittedBufferCopy(DataType* buffer, unsigned int bufferSize) const
+{
+	// Determine the number of elements to copy
+	size_t copySize = (size_t)bufferSize;
+	if (copySize > _memory.size())
+	{
+		copySize = _memory.size();
+	}
+
+	// Populate the target buffer with the committed memory state. As with the other
+	// committed access functions, no lock is taken here, so this must only be called from
+	// the thread which advances the committed state.
+	if (copySize > 0)
+	{
+		memcpy((void*)buffer, (const void*)&_memory[0], copySize * sizeof(DataType));
+	}
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 // Time management functions
 //----------------------------------------------------------------------------------------------------------------------
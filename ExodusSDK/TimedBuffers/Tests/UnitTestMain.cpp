@@ -0,0 +1,259 @@
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+#include "TimedBuffers/TimedLineAccessQueue.h"
+#include <limits>
+#include <mutex>
+#include <thread>
+#include <functional>
+
+struct TestLineAccess
+{
+	TestLineAccess(double accessTime, unsigned int value)
+	:accessTime(accessTime), value(value), check(~value)
+	{ }
+
+	double accessTime;
+	unsigned int value;
+	unsigned int check;
+};
+
+TEST_CASE("TimedLineAccessQueue entry ordering", "")
+{
+	TimedLineAccessQueue<TestLineAccess> queue(4);
+	REQUIRE(queue.Empty());
+	REQUIRE(!queue.IsPending());
+	REQUIRE(queue.GetNextPendingTime() == std::numeric_limits<double>::infinity());
+
+	SECTION("Entries are sorted by access time, with entries at the same time kept in insertion order", "")
+	{
+		queue.Insert(TestLineAccess(30.0, 1));
+		queue.Insert(TestLineAccess(10.0, 2));
+		queue.Insert(TestLineAccess(20.0, 3));
+		queue.Insert(TestLineAccess(10.0, 4));
+		queue.Insert(TestLineAccess(40.0, 5));
+		REQUIRE(queue.Size() == 5);
+		const unsigned int expectedValues[] = {2, 4, 3, 1, 5};
+		unsigned int entryNo = 0;
+		for (TimedLineAccessQueue<TestLineAccess>::const_iterator i = queue.Begin(); i != queue.End(); ++i)
+		{
+			REQUIRE(i->value == expectedValues[entryNo++]);
+		}
+		REQUIRE(entryNo == 5);
+	}
+	SECTION("The pending time tracks the front entry", "")
+	{
+		queue.Insert(TestLineAccess(30.0, 1));
+		REQUIRE(queue.IsPending());
+		REQUIRE(queue.GetNextPendingTime() == 30.0);
+		REQUIRE(!queue.IsEntryDue(29.0));
+		REQUIRE(queue.IsEntryDue(30.0));
+		queue.Insert(TestLineAccess(10.0, 2));
+		REQUIRE(queue.GetNextPendingTime() == 10.0);
+		queue.PopFront();
+		REQUIRE(queue.GetNextPendingTime() == 30.0);
+		queue.PopFront();
+		REQUIRE(queue.Empty());
+		REQUIRE(!queue.IsPending());
+	}
+	SECTION("Entries can be removed from the front and middle of the queue", "")
+	{
+		for (unsigned int i = 0; i < 6; ++i)
+		{
+			queue.Insert(TestLineAccess((double)(i * 10), i));
+		}
+		queue.EraseUpTo(queue.Begin() + 2);
+		REQUIRE(queue.Size() == 4);
+		REQUIRE(queue.Front().value == 2);
+		REQUIRE(queue.GetNextPendingTime() == 20.0);
+		queue.Erase(queue.Begin() + 1);
+		REQUIRE(queue.Size() == 3);
+		REQUIRE((queue.Begin() + 1)->value == 4);
+		queue.Erase(queue.Begin());
+		REQUIRE(queue.GetNextPendingTime() == 40.0);
+		queue.Clear();
+		REQUIRE(queue.Empty());
+		REQUIRE(!queue.IsPending());
+	}
+	SECTION("Consumed entries are reclaimed when the array is full", "")
+	{
+		// Entries are inserted at twice the rate they're consumed, so the live entries
+		// drift along the array, and are shifted back to the start each time it fills.
+		for (unsigned int i = 0; i < 100; ++i)
+		{
+			queue.Insert(TestLineAccess((double)i, i));
+			queue.Insert(TestLineAccess((double)i + 0.5, i + 1000));
+			REQUIRE(queue.Front().value == (((i % 2) == 0)? (i / 2): ((i / 2) + 1000)));
+			queue.PopFront();
+		}
+		REQUIRE(queue.Size() == 100);
+		REQUIRE(queue.Front().value == 50);
+		REQUIRE(queue.GetNextPendingTime() == 50.0);
+	}
+}
+
+TEST_CASE("TimedLineAccessQueue commit and rollback", "")
+{
+	TimedLineAccessQueue<TestLineAccess> queue;
+	queue.Insert(TestLineAccess(10.0, 1));
+	queue.Insert(TestLineAccess(20.0, 2));
+	queue.Commit();
+
+	SECTION("Rollback restores the entries present at the last commit", "")
+	{
+		queue.PopFront();
+		queue.Insert(TestLineAccess(5.0, 3));
+		queue.Insert(TestLineAccess(30.0, 4));
+		REQUIRE(queue.Size() == 3);
+		queue.Rollback();
+		REQUIRE(queue.Size() == 2);
+		REQUIRE(queue.Front().value == 1);
+		REQUIRE((queue.Begin() + 1)->value == 2);
+		REQUIRE(queue.GetNextPendingTime() == 10.0);
+	}
+	SECTION("Rollback restores a queue which was emptied after the last commit", "")
+	{
+		queue.Clear();
+		REQUIRE(!queue.IsPending());
+		queue.Rollback();
+		REQUIRE(queue.Size() == 2);
+		REQUIRE(queue.IsEntryDue(10.0));
+	}
+	SECTION("Rollback without any changes since the last commit leaves the queue unchanged", "")
+	{
+		queue.Rollback();
+		REQUIRE(queue.Size() == 2);
+		REQUIRE(queue.Front().value == 1);
+		REQUIRE(queue.GetNextPendingTime() == 10.0);
+	}
+	SECTION("Commit latches the current entries as the rollback state", "")
+	{
+		queue.PopFront();
+		queue.Insert(TestLineAccess(40.0, 3));
+		queue.Commit();
+		queue.Clear();
+		queue.Rollback();
+		REQUIRE(queue.Size() == 2);
+		REQUIRE(queue.Front().value == 2);
+		REQUIRE((queue.Begin() + 1)->value == 3);
+		queue.Rollback();
+		REQUIRE(queue.Size() == 2);
+	}
+	SECTION("Repeated rollbacks restore the same state", "")
+	{
+		for (unsigned int i = 0; i < 3; ++i)
+		{
+			queue.PopFront();
+			queue.Insert(TestLineAccess(15.0, 10 + i));
+			queue.Rollback();
+			REQUIRE(queue.Size() == 2);
+			REQUIRE(queue.Front().value == 1);
+			REQUIRE((queue.Begin() + 1)->value == 2);
+		}
+	}
+}
+
+TEST_CASE("TimedLineAccessQueue access time rebasing", "")
+{
+	TimedLineAccessQueue<TestLineAccess> queue;
+	queue.Insert(TestLineAccess(100.0, 1));
+	queue.Insert(TestLineAccess(150.0, 2));
+	queue.Insert(TestLineAccess(250.0, 3));
+	queue.PopFront();
+	queue.Commit();
+
+	SECTION("Rebasing shifts all pending entries and the pending time", "")
+	{
+		queue.RebaseAccessTimes(-200.0);
+		REQUIRE(queue.Size() == 2);
+		REQUIRE(queue.Front().accessTime == -50.0);
+		REQUIRE((queue.Begin() + 1)->accessTime == 50.0);
+		REQUIRE(queue.GetNextPendingTime() == -50.0);
+		REQUIRE(queue.IsEntryDue(0.0));
+		queue.Insert(TestLineAccess(0.0, 4));
+		REQUIRE((queue.Begin() + 1)->value == 4);
+	}
+	SECTION("Rebasing is undone by a rollback to the last commit", "")
+	{
+		queue.RebaseAccessTimes(-200.0);
+		queue.Rollback();
+		REQUIRE(queue.Front().accessTime == 150.0);
+		REQUIRE((queue.Begin() + 1)->accessTime == 250.0);
+		REQUIRE(queue.GetNextPendingTime() == 150.0);
+	}
+	SECTION("Rebased access times are retained by a commit", "")
+	{
+		queue.RebaseAccessTimes(-200.0);
+		queue.Commit();
+		queue.Clear();
+		queue.Rollback();
+		REQUIRE(queue.Front().accessTime == -50.0);
+		REQUIRE(queue.GetNextPendingTime() == -50.0);
+	}
+	SECTION("Rebasing an empty queue leaves it empty", "")
+	{
+		queue.Clear();
+		queue.RebaseAccessTimes(-200.0);
+		REQUIRE(queue.Empty());
+		REQUIRE(!queue.IsPending());
+	}
+}
+
+struct WriterThreadParams
+{
+	WriterThreadParams(TimedLineAccessQueue<TestLineAccess>& queue, std::mutex& lineMutex, unsigned int entryCount)
+	:queue(queue), lineMutex(lineMutex), entryCount(entryCount)
+	{ }
+
+	TimedLineAccessQueue<TestLineAccess>& queue;
+	std::mutex& lineMutex;
+	unsigned int entryCount;
+};
+
+void WriterThread(WriterThreadParams& params)
+{
+	for (unsigned int i = 0; i < params.entryCount; ++i)
+	{
+		std::unique_lock<std::mutex> lock(params.lineMutex);
+		params.queue.Insert(TestLineAccess((double)i, i));
+	}
+}
+
+TEST_CASE("TimedLineAccessQueue concurrent insertion against a reader", "")
+{
+	// The writer inserts entries under the line mutex, as a device raising line state
+	// changes does, while the reader polls for due entries without taking the lock, and
+	// only takes the lock to remove entries once they're found to be due.
+	const unsigned int entryCount = 200000;
+	TimedLineAccessQueue<TestLineAccess> queue(8);
+	std::mutex lineMutex;
+
+	WriterThreadParams writerParams(queue, lineMutex, entryCount);
+	std::thread writerThread(WriterThread, std::ref(writerParams));
+
+	unsigned int nextExpectedValue = 0;
+	bool entriesValid = true;
+	double currentTime = 0.0;
+	while ((nextExpectedValue < entryCount) && entriesValid)
+	{
+		if (!queue.IsEntryDue(currentTime))
+		{
+			currentTime += 1.0;
+			std::this_thread::yield();
+			continue;
+		}
+		std::unique_lock<std::mutex> lock(lineMutex);
+		while (!queue.Empty() && (queue.Front().accessTime <= currentTime))
+		{
+			const TestLineAccess& entry = queue.Front();
+			entriesValid &= (entry.value == nextExpectedValue) && (entry.check == ~entry.value) && (entry.accessTime == (double)entry.value);
+			++nextExpectedValue;
+			queue.PopFront();
+		}
+	}
+	writerThread.join();
+
+	REQUIRE(entriesValid);
+	REQUIRE(nextExpectedValue == entryCount);
+	REQUIRE(queue.Empty());
+	REQUIRE(!queue.IsPending());
+}
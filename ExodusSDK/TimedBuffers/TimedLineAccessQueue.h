@@ -0,0 +1,83 @@
+#ifndef __TIMEDLINEACCESSQUEUE_H__
+#define __TIMEDLINEACCESSQUEUE_H__
+#include <vector>
+#include <atomic>
+#include <limits>
+
+// This container holds pending line state changes for a device, sorted by access time
+// from lowest to highest. Entries are stored in a single preallocated array, so the queue
+// performs no allocation during normal operation once it has reached its working size.
+//
+// Structural changes to the queue (insertion, removal, and rollback operations) must be
+// serialized by the owning device, generally by holding its line mutex. The execution
+// thread of the owning device however can test for pending entries without taking any
+// lock, by calling IsPending() or IsEntryDue(). These functions perform a single relaxed
+// load of an atomic watermark holding the access time of the earliest pending entry,
+// which is updated by every structural change. If an entry is found to be due, the caller
+// then obtains its lock before removing the entry, which ensures the entry data written
+// by the producer is visible.
+//
+// Any object can be stored in this container, provided it meets the following
+// requirements:
+// -It is copy constructible
+// -It is assignable
+// -It has a member of type double named accessTime
+
+template<class EntryType>
+class TimedLineAccessQueue
+{
+public:
+	// Typedefs
+	typedef typename std::vector<EntryType>::iterator iterator;
+	typedef typename std::vector<EntryType>::const_iterator const_iterator;
+
+public:
+	// Constructors
+	TimedLineAccessQueue(unsigned int initialCapacity = DefaultInitialCapacity);
+
+	// Pending entry functions
+	inline bool IsPending() const;
+	inline bool IsEntryDue(double currentTime) const;
+	inline double GetNextPendingTime() const;
+
+	// Entry access functions
+	inline bool Empty() const;
+	inline unsigned int Size() const;
+	inline iterator Begin();
+	inline const_iterator Begin() const;
+	inline iterator End();
+	inline const_iterator End() const;
+	inline EntryType& Front();
+	inline const EntryType& Front() const;
+
+	// Entry modification functions
+	void Insert(const EntryType& entry);
+	void PopFront();
+	void Erase(const iterator& position);
+	void EraseUpTo(const iterator& position);
+	void Clear();
+	void RebaseAccessTimes(double timeOffset);
+
+	// Rollback functions
+	void Commit();
+	void Rollback();
+
+private:
+	// Constants
+	static const unsigned int DefaultInitialCapacity = 0x40;
+
+private:
+	// Watermark functions
+	void EntriesModified();
+
+private:
+	std::vector<EntryType> _entries;
+	unsigned int _firstEntryIndex;
+	std::vector<EntryType> _committedEntries;
+	unsigned int _sequenceNo;
+	unsigned int _committedSequenceNo;
+	std::atomic<double> _nextPendingTime;
+};
+
+#include "TimedLineAccessQueue.inl"
+#endif
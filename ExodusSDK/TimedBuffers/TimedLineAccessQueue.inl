@@ -0,0 +1,236 @@
+//----------------------------------------------------------------------------------------------------------------------
+// Constructors
+//----------------------------------------------------------------------------------------------------------------------
+template<class EntryType>
+TimedLineAccessQueue<EntryType>::TimedLineAccessQueue(unsigned int initialCapacity)
+:_firstEntryIndex(0), _sequenceNo(0), _committedSequenceNo(0), _nextPendingTime(std::numeric_limits<double>::infinity())
+{
+	_entries.reserve(initialCapacity);
+	_committedEntries.reserve(initialCapacity);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Pending entry functions
+//----------------------------------------------------------------------------------------------------------------------
+template<class EntryType>
+bool TimedLineAccessQueue<EntryType>::IsPending() const
+{
+	return (_nextPendingTime.load(std::memory_order_relaxed) != std::numeric_limits<double>::infinity());
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+template<class EntryType>
+bool TimedLineAccessQueue<EntryType>::IsEntryDue(double currentTime) const
+{
+	return (_nextPendingTime.load(std::memory_order_relaxed) <= currentTime);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+template<class EntryType>
+double TimedLineAccessQueue<EntryType>::GetNextPendingTime() const
+{
+	return _nextPendingTime.load(std::memory_order_relaxed);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Entry access functions
+//----------------------------------------------------------------------------------------------------------------------
+template<class EntryType>
+bool TimedLineAccessQueue<EntryType>::Empty() const
+{
+	return (_firstEntryIndex == (unsigned int)_entries.size());
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+template<class EntryType>
+unsigned int TimedLineAccessQueue<EntryType>::Size() const
+{
+	return (unsigned int)_entries.size() - _firstEntryIndex;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+template<class EntryType>
+typename TimedLineAccessQueue<EntryType>::iterator TimedLineAccessQueue<EntryType>::Begin()
+{
+	return _entries.begin() + _firstEntryIndex;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+template<class EntryType>
+typename TimedLineAccessQueue<EntryType>::const_iterator TimedLineAccessQueue<EntryType>::Begin() const
+{
+	return _entries.begin() + _firstEntryIndex;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+template<class EntryType>
+typename TimedLineAccessQueue<EntryType>::iterator TimedLineAccessQueue<EntryType>::End()
+{
+	return _entries.end();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+template<class EntryType>
+typename TimedLineAccessQueue<EntryType>::const_iterator TimedLineAccessQueue<EntryType>::End() const
+{
+	return _entries.end();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+template<class EntryType>
+EntryType& TimedLineAccessQueue<EntryType>::Front()
+{
+	return _entries[_firstEntryIndex];
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+template<class EntryType>
+const EntryType& TimedLineAccessQueue<EntryType>::Front() const
+{
+	return _entries[_firstEntryIndex];
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Entry modification functions
+//----------------------------------------------------------------------------------------------------------------------
+template<class EntryType>
+void TimedLineAccessQueue<EntryType>::Insert(const EntryType& entry)
+{
+	// If the array is full but entries have been consumed from the front, shift the live
+	// entries back to the start of the array rather than growing it.
+	if ((_firstEntryIndex > 0) && (_entries.size() == _entries.capacity()))
+	{
+		_entries.erase(_entries.begin(), _entries.begin() + _firstEntryIndex);
+		_firstEntryIndex = 0;
+	}
+
+	// Find the insertion point for the new entry. Entries are sorted by access time from
+	// lowest to highest, with entries at the same time kept in the order they were
+	// inserted. Since new entries are almost always later than all existing entries, we
+	// search backwards from the end of the array.
+	unsigned int insertIndex = (unsigned int)_entries.size();
+	while ((insertIndex > _firstEntryIndex) && (_entries[insertIndex - 1].accessTime > entry.accessTime))
+	{
+		--insertIndex;
+	}
+	_entries.insert(_entries.begin() + insertIndex, entry);
+	EntriesModified();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+template<class EntryType>
+void TimedLineAccessQueue<EntryType>::PopFront()
+{
+	// Advance past the front entry, and reset the array once the last live entry has been
+	// consumed. Note that this never releases the allocated storage.
+	++_firstEntryIndex;
+	if (_firstEntryIndex == (unsigned int)_entries.size())
+	{
+		_entries.clear();
+		_firstEntryIndex = 0;
+	}
+	EntriesModified();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+template<class EntryType>
+void TimedLineAccessQueue<EntryType>::Erase(const iterator& position)
+{
+	_entries.erase(position);
+	if (_firstEntryIndex == (unsigned int)_entries.size())
+	{
+		_entries.clear();
+		_firstEntryIndex = 0;
+	}
+	EntriesModified();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+template<class EntryType>
+void TimedLineAccessQueue<EntryType>::EraseUpTo(const iterator& position)
+{
+	// Remove all entries before the target position from the front of the queue
+	_firstEntryIndex = (unsigned int)(position - _entries.begin());
+	if (_firstEntryIndex == (unsigned int)_entries.size())
+	{
+		_entries.clear();
+		_firstEntryIndex = 0;
+	}
+	EntriesModified();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+template<class EntryType>
+void TimedLineAccessQueue<EntryType>::Clear()
+{
+	_entries.clear();
+	_firstEntryIndex = 0;
+	EntriesModified();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+template<class EntryType>
+void TimedLineAccessQueue<EntryType>::RebaseAccessTimes(double timeOffset)
+{
+	// Shift the access time of all pending entries by the target offset. Since every entry
+	// moves by the same amount, the sort order of the queue is unaffected.
+	for (unsigned int i = _firstEntryIndex; i < (unsigned int)_entries.size(); ++i)
+	{
+		_entries[i].accessTime += timeOffset;
+	}
+	if (_firstEntryIndex < (unsigned int)_entries.size())
+	{
+		EntriesModified();
+	}
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Rollback functions
+//----------------------------------------------------------------------------------------------------------------------
+template<class EntryType>
+void TimedLineAccessQueue<EntryType>::Commit()
+{
+	// If the queue hasn't been modified since the last commit, the committed entries are
+	// already up to date. This is the common case, since most timeslices see no line
+	// state changes at all.
+	if (_sequenceNo == _committedSequenceNo)
+	{
+		return;
+	}
+
+	// Latch the current set of pending entries as the committed state
+	_committedEntries.assign(_entries.begin() + _firstEntryIndex, _entries.end());
+	_committedSequenceNo = _sequenceNo;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+template<class EntryType>
+void TimedLineAccessQueue<EntryType>::Rollback()
+{
+	// If the queue hasn't been modified since the last commit, there's nothing to restore
+	if (_sequenceNo == _committedSequenceNo)
+	{
+		return;
+	}
+
+	// Restore the committed set of pending entries
+	_entries.assign(_committedEntries.begin(), _committedEntries.end());
+	_firstEntryIndex = 0;
+	EntriesModified();
+	_sequenceNo = _committedSequenceNo;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Watermark functions
+//----------------------------------------------------------------------------------------------------------------------
+template<class EntryType>
+void TimedLineAccessQueue<EntryType>::EntriesModified()
+{
+	// Advance the sequence number for the queue, and publish the access time of the new
+	// front entry as the next pending time. Note that we use release semantics here so
+	// that an execution thread which observes the new watermark and subsequently obtains
+	// the owning lock will see the entry data.
+	++_sequenceNo;
+	double nextPendingTime = (_firstEntryIndex < (unsigned int)_entries.size())? _entries[_firstEntryIndex].accessTime: std::numeric_limits<double>::infinity();
+	_nextPendingTime.store(nextPendingTime, std::memory_order_release);
+}
@@ -523,13 +523,16 @@ void ImageView::UpdateImage()
 		--_windowPendingClearCount;
 	}
 
-	// Determine the index of the current image plane that is being used for display
-	unsigned int displayingImageBufferPlane = _model.GetImageCompletedBufferPlaneNo();
+	// Lock the most recently completed image plane for display. This prevents the render
+	// thread from drawing into this plane until we're done with it, without ever causing
+	// the render thread to wait on us.
+	unsigned int displayingImageBufferPlane = _model.LockCompletedImageBufferPlane();
 
 	// Obtain the number of rows in this frame
 	unsigned int rowCount = _model.GetImageBufferLineCount(displayingImageBufferPlane);
 	if (rowCount <= 0)
 	{
+		_model.UnlockImageBufferPlane(displayingImageBufferPlane);
 		return;
 	}
 
@@ -545,9 +548,7 @@ void ImageView::UpdateImage()
 	if (_model.GetVideoSingleBuffering() || (_lastRenderedFrameTokenCached != latestLastRenderedFrameToken))
 	{
 		// Copy the contents of the image buffer into our image texture for rendering
-		_model.LockImageBufferData(displayingImageBufferPlane);
 		glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, _model.ImageBufferWidth, rowCount, GL_RGBA, GL_UNSIGNED_BYTE, _model.GetImageBufferData(displayingImageBufferPlane));
-		_model.UnlockImageBufferData(displayingImageBufferPlane);
 
 		// Update our cached last rendered frame token
 		unsigned int framesCompletedDrawing = latestLastRenderedFrameToken - _lastRenderedFrameTokenCached;
@@ -758,6 +759,9 @@ void ImageView::UpdateImage()
 		}
 	}
 
+	// Release our lock on the displayed image plane
+	_model.UnlockImageBufferPlane(displayingImageBufferPlane);
+
 	// Signal the OpenGL drawing operations to start as quickly as possible
 	glFlush();
 }
@@ -0,0 +1,61 @@
+#include "PatternTileCache.h"
+#include <cstring>
+
+//----------------------------------------------------------------------------------------------------------------------
+// Constructors
+//----------------------------------------------------------------------------------------------------------------------
+PatternTileCache::PatternTileCache()
+:_vramData(VRAMSize, 0), _decodedRows(PatternRowCount * DecodedRowByteSize, 0), _cacheValid(false)
+{ }
+
+//----------------------------------------------------------------------------------------------------------------------
+// Cache update functions
+//----------------------------------------------------------------------------------------------------------------------
+void PatternTileCache::Update(const std::vector<unsigned char>& vramData)
+{
+	// Compare each tile in the supplied VRAM data against the data we last decoded, and
+	// decode any tiles which have changed. Most frames only modify a small number of
+	// tiles, so this is far cheaper than decoding the entire buffer each time.
+	unsigned int vramDataSize = ((unsigned int)vramData.size() < VRAMSize)? (unsigned int)vramData.size(): VRAMSize;
+	for (unsigned int tileAddress = 0; (tileAddress + TileByteSize) <= vramDataSize; tileAddress += TileByteSize)
+	{
+		const unsigned char* tileData = &vramData[tileAddress];
+		if (!_cacheValid || (memcmp(tileData, &_vramData[tileAddress], TileByteSize) != 0))
+		{
+			memcpy(&_vramData[tileAddress], tileData, TileByteSize);
+			DecodeTile(tileData, tileAddress);
+		}
+	}
+	_cacheValid = true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void PatternTileCache::Invalidate()
+{
+	_cacheValid = false;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Decode functions
+//----------------------------------------------------------------------------------------------------------------------
+void PatternTileCache::DecodeTile(const unsigned char* tileData, unsigned int tileAddress)
+{
+	// Expand each row of the target tile to one byte per pixel. Each byte of pattern data
+	// holds two pixels, with the leftmost pixel in the upper nibble.
+	unsigned int firstRowNo = tileAddress / PatternRowByteSize;
+	for (unsigned int tileRowNo = 0; tileRowNo < (TileByteSize / PatternRowByteSize); ++tileRowNo)
+	{
+		const unsigned char* rowData = tileData + (tileRowNo * PatternRowByteSize);
+		unsigned char* decodedRow = &_decodedRows[(firstRowNo + tileRowNo) * DecodedRowByteSize];
+		unsigned char* decodedRowFlipped = decodedRow + PatternRowPixelCount;
+		for (unsigned int byteNo = 0; byteNo < PatternRowByteSize; ++byteNo)
+		{
+			unsigned char upperPixel = (rowData[byteNo] >> 4) & 0x0F;
+			unsigned char lowerPixel = rowData[byteNo] & 0x0F;
+			decodedRow[(byteNo * 2)] = upperPixel;
+			decodedRow[(byteNo * 2) + 1] = lowerPixel;
+			decodedRowFlipped[(PatternRowPixelCount - 1) - (byteNo * 2)] = upperPixel;
+			decodedRowFlipped[(PatternRowPixelCount - 2) - (byteNo * 2)] = lowerPixel;
+		}
+	}
+}
@@ -0,0 +1,54 @@
+#ifndef __PATTERNTILECACHE_H__
+#define __PATTERNTILECACHE_H__
+#include <vector>
+
+// This class holds a decoded copy of the pattern data in a VRAM buffer, with each 4bpp
+// pattern row expanded to one byte per pixel in both normal and horizontally flipped
+// order, so that a full 8-pixel row can be read with a single lookup. Vertical flipping
+// only changes which row is addressed, so no vertically flipped copies are stored, and
+// since rows are addressed directly, 8x16 interlace mode 2 tiles are handled as two
+// consecutive 8x8 tiles. Each call to Update() compares the supplied VRAM data against
+// the data the cache was last built from, and only decodes again the tiles which have
+// been written to.
+//
+// This cache is only used by the debugger views, which work from a whole snapshot of
+// VRAM. The core renderer deliberately doesn't use it. The renderer fetches each pattern
+// row from committed VRAM at the access slot where the hardware fetches it, and already
+// holds the fetched row for the rest of the line, so mid-frame VRAM writes take effect
+// at the correct point. A cache keyed on VRAM contents would need to be invalidated on
+// every committed VRAM write, which would add cost to the write path without saving any
+// VRAM reads in the renderer.
+class PatternTileCache
+{
+public:
+	// Constructors
+	PatternTileCache();
+
+	// Cache update functions
+	void Update(const std::vector<unsigned char>& vramData);
+	void Invalidate();
+
+	// Pattern data functions
+	inline const unsigned char* GetPatternRowPixels(unsigned int patternRowAddress, bool hflip) const;
+
+private:
+	// Constants
+	static const unsigned int VRAMSize = 0x10000;
+	static const unsigned int TileByteSize = 0x20;
+	static const unsigned int PatternRowByteSize = 4;
+	static const unsigned int PatternRowPixelCount = 8;
+	static const unsigned int PatternRowCount = VRAMSize / PatternRowByteSize;
+	static const unsigned int DecodedRowByteSize = PatternRowPixelCount * 2;
+
+private:
+	// Decode functions
+	void DecodeTile(const unsigned char* tileData, unsigned int tileAddress);
+
+private:
+	std::vector<unsigned char> _vramData;
+	std::vector<unsigned char> _decodedRows;
+	bool _cacheValid;
+};
+
+#include "PatternTileCache.inl"
+#endif
@@ -0,0 +1,10 @@
+//----------------------------------------------------------------------------------------------------------------------
+// Pattern data functions
+//----------------------------------------------------------------------------------------------------------------------
+const unsigned char* PatternTileCache::GetPatternRowPixels(unsigned int patternRowAddress, bool hflip) const
+{
+	// Return the eight decoded pixel values for the target pattern row. The normal and
+	// horizontally flipped versions of each row are stored side by side.
+	unsigned int rowNo = (patternRowAddress % VRAMSize) / PatternRowByteSize;
+	return &_decodedRows[(rowNo * DecodedRowByteSize) + (hflip? PatternRowPixelCount: 0)];
+}
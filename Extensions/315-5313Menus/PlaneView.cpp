@@ -871,12 +871,15 @@ LRESULT PlaneView::msgRenderWM_TIMER(HWND hwnd, WPARAM wparam, LPARAM lparam)
 	_model.LockExternalBuffers();
 	ITimedBufferInt* vramBuffer = _model.GetVRAMBuffer();
 	std::vector<unsigned char> vramDataCopy(IS315_5313::VramSize, 0);
-	if (vramBuffer != 0)
+	if ((vramBuffer != 0) && !vramBuffer->GetCommittedSnapshot(vramDataCopy))
 	{
 		vramBuffer->GetLatestBufferCopy(vramDataCopy);
 	}
 	_model.UnlockExternalBuffers();
 
+	// Bring the decoded pattern cache up to date with the current VRAM contents
+	_patternTileCache.Update(vramDataCopy);
+
 	// Fill the plane render buffer
 	for (unsigned int ypos = 0; ypos < _bufferHeight; ++ypos)
 	{
@@ -991,15 +994,9 @@ LRESULT PlaneView::msgRenderWM_TIMER(HWND hwnd, WPARAM wparam, LPARAM lparam)
 					unsigned int patternRowDataAddress = (((spriteMapping.blockNumber + blockOffset) * blockPatternByteSize) + (patternRowNo * patternDataRowByteSize)) % (unsigned int)vramDataCopy.size();
 					patternRowDataAddress = (_spritePatternBase + patternRowDataAddress) % (unsigned int)vramDataCopy.size();
 
-					// Read the pattern data byte for the target pixel in the target block
-					const unsigned int pixelsPerPatternByte = 2;
-					unsigned int patternByteNo = patternColumnNo / pixelsPerPatternByte;
-					bool patternDataUpperHalf = (patternColumnNo % pixelsPerPatternByte) == 0;
-					Data patternData(8, vramDataCopy[patternRowDataAddress + patternByteNo]);
-
-					// Return the target palette row and index numbers
+					// Read the decoded pattern data for the target pixel in the target block
 					unsigned int paletteRow = spriteMapping.paletteLine;
-					unsigned int paletteIndex = patternData.GetDataSegment((patternDataUpperHalf)? 4: 0, 4);
+					unsigned int paletteIndex = ReadPatternPixel(vramDataCopy, patternRowDataAddress, patternColumnNo, false);
 
 					// If this pixel is transparent, skip it.
 					if (paletteIndex == 0)
@@ -1338,7 +1335,6 @@ void PlaneView::GetScrollPlanePaletteInfo(const std::vector<unsigned char>& vram
 {
 	// Constants
 	const unsigned int mappingByteSize = 2;
-	const unsigned int pixelsPerPatternByte = 2;
 	unsigned int blockPixelSizeX = 8;
 	unsigned int blockPixelSizeY = (interlaceMode2Active)? 16: 8;
 
@@ -1357,16 +1353,37 @@ void PlaneView::GetScrollPlanePaletteInfo(const std::vector<unsigned char>& vram
 	unsigned int patternRowDataAddress = _model.CalculatePatternDataRowAddress(patternRowNumber, 0, interlaceMode2Active, mappingData);
 	patternRowDataAddress = (patternBaseAddress + patternRowDataAddress) % (unsigned int)vramData.size();
 
-	// Read the pattern data byte for the target pixel in the target block
+	// Read the decoded pattern data for the target pixel in the target block
 	bool patternHFlip = mappingData.GetBit(11);
-	unsigned int patternColumnNo = (patternHFlip)? (blockPixelSizeX - 1) - (xpos % blockPixelSizeX): (xpos % blockPixelSizeX);
-	unsigned int patternByteNo = patternColumnNo / pixelsPerPatternByte;
-	bool patternDataUpperHalf = (patternColumnNo % pixelsPerPatternByte) == 0;
-	Data patternData(8, vramData[patternRowDataAddress + patternByteNo]);
+	unsigned int patternColumnNo = xpos % blockPixelSizeX;
 
 	// Return the target palette row and index numbers
 	paletteRow = mappingData.GetDataSegment(13, 2);
-	paletteIndex = patternData.GetDataSegment((patternDataUpperHalf)? 4: 0, 4);
+	paletteIndex = ReadPatternPixel(vramData, patternRowDataAddress, patternColumnNo, patternHFlip);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+unsigned int PlaneView::ReadPatternPixel(const std::vector<unsigned char>& vramData, unsigned int patternRowDataAddress, unsigned int patternColumnNo, bool patternHFlip) const
+{
+	// Constants
+	const unsigned int patternDataRowByteSize = 4;
+	const unsigned int pixelsPerPatternRow = 8;
+	const unsigned int pixelsPerPatternByte = 2;
+
+	// If the target pattern row is aligned to a row boundary, which is always the case
+	// unless a pattern base address has been manually entered which isn't, read the pixel
+	// from the decoded pattern cache.
+	if ((patternRowDataAddress % patternDataRowByteSize) == 0)
+	{
+		return _patternTileCache.GetPatternRowPixels(patternRowDataAddress, patternHFlip)[patternColumnNo];
+	}
+
+	// Decode the target pixel directly from the pattern data byte
+	unsigned int flippedColumnNo = (patternHFlip)? (pixelsPerPatternRow - 1) - patternColumnNo: patternColumnNo;
+	unsigned int patternByteNo = flippedColumnNo / pixelsPerPatternByte;
+	bool patternDataUpperHalf = (flippedColumnNo % pixelsPerPatternByte) == 0;
+	Data patternData(8, vramData[(patternRowDataAddress + patternByteNo) % (unsigned int)vramData.size()]);
+	return patternData.GetDataSegment((patternDataUpperHalf)? 4: 0, 4);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -3,6 +3,7 @@
 #include "WindowsSupport/WindowsSupport.pkg"
 #include "DeviceInterface/DeviceInterface.pkg"
 #include "PlaneViewPresenter.h"
+#include "PatternTileCache.h"
 #include "315-5313/IS315_5313.h"
 
 class PlaneView :public ViewBase
@@ -42,6 +43,7 @@ private:
 
 	// Render helper methods
 	void GetScrollPlanePaletteInfo(const std::vector<unsigned char>& vramData, unsigned int mappingBaseAddress, unsigned int patternBaseAddress, unsigned int planeWidth, unsigned int planeHeight, unsigned int xpos, unsigned int ypos, bool interlaceMode2Active, unsigned int& paletteRow, unsigned int& paletteIndex) const;
+	unsigned int ReadPatternPixel(const std::vector<unsigned char>& vramData, unsigned int patternRowDataAddress, unsigned int patternColumnNo, bool patternHFlip) const;
 	void GetScrollPlaneHScrollData(const std::vector<unsigned char>& vramData, unsigned int screenRowNumber, unsigned int hscrollDataBase, bool hscrState, bool lscrState, bool layerA, unsigned int& layerHscrollPatternDisplacement, unsigned int& layerHscrollMappingDisplacement) const;
 
 private:
@@ -75,6 +77,7 @@ private:
 	HGLRC _glrc;
 	HWND _hwndRender;
 	unsigned char* _buffer;
+	PatternTileCache _patternTileCache;
 	bool _initializedDialog;
 	std::wstring _previousText;
 	unsigned int _currentControlFocus;
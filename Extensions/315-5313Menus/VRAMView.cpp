@@ -406,7 +406,12 @@ LRESULT VRAMView::msgRenderWM_TIMER(HWND hwnd, WPARAM wparam, LPARAM lparam)
 	std::vector<unsigned char> vramDataCopy;
 	if (vramBuffer != 0)
 	{
-		vramBuffer->GetLatestBufferCopy(vramDataCopy);
+		// Read the snapshot of VRAM published by the device at the end of the last frame if
+		// one is available, otherwise fall back to a locked read of the latest buffer state.
+		if (!vramBuffer->GetCommittedSnapshot(vramDataCopy))
+		{
+			vramBuffer->GetLatestBufferCopy(vramDataCopy);
+		}
 		obtainedVRAMData = true;
 	}
 	_model.UnlockExternalBuffers();
@@ -418,6 +423,8 @@ LRESULT VRAMView::msgRenderWM_TIMER(HWND hwnd, WPARAM wparam, LPARAM lparam)
 	// Constants
 	static const unsigned int vramSize = 0x10000;
 	static const unsigned int pixelsPerByte = 2;
+	static const unsigned int bytesPerPatternRow = 4;
+	static const unsigned int paletteIndexCount = 16;
 	static const unsigned int pixelsInVRAM = vramSize * pixelsPerByte;
 	static const unsigned int blockPixelSizeX = 8;
 	unsigned int blockPixelSizeY = ((_blockSize == BLOCKSIZE_8X16) || ((_blockSize == BLOCKSIZE_AUTO) && (_model.RegGetLSM0()) && (_model.RegGetLSM1())))? 16: 8;
@@ -427,99 +434,110 @@ LRESULT VRAMView::msgRenderWM_TIMER(HWND hwnd, WPARAM wparam, LPARAM lparam)
 
 	_vramImage.SetImageFormat(pixelsPerBufferRow, bufferVisiblePixelRowCount, IImage::PIXELFORMAT_RGB, IImage::DATAFORMAT_8BIT);
 
-	// Fill the VRAM render buffer
-	for (unsigned int byteNo = 0; byteNo < vramSize; ++byteNo)
+	// Bring the decoded pattern cache up to date with the current VRAM contents
+	_patternTileCache.Update(vramDataCopy);
+
+	// Decode the colour for each possible palette index
+	unsigned char paletteR[paletteIndexCount];
+	unsigned char paletteG[paletteIndexCount];
+	unsigned char paletteB[paletteIndexCount];
+	for (unsigned int index = 0; index < paletteIndexCount; ++index)
 	{
-		unsigned char nextByte = vramDataCopy[byteNo];
-		for (unsigned int pixelNo = 0; pixelNo < pixelsPerByte; ++pixelNo)
+		unsigned char r = 0;
+		unsigned char g = 0;
+		unsigned char b = 0;
+		if (_selectedPalette == PALETTE_LOWHIGH)
 		{
-			// Decode the colour for the selected pixel
-			unsigned int index = (nextByte >> (((pixelsPerByte - 1) - pixelNo) * 4)) & 0x0F;
-			unsigned char r = 0;
-			unsigned char g = 0;
-			unsigned char b = 0;
-			if (_selectedPalette == PALETTE_LOWHIGH)
+			r = (unsigned char)index * 17;
+			g = (unsigned char)index * 17;
+			b = (unsigned char)index * 17;
+			if (_shadow && !_highlight)
 			{
-				r = (unsigned char)index * 17;
-				g = (unsigned char)index * 17;
-				b = (unsigned char)index * 17;
-				if (_shadow && !_highlight)
-				{
-					r /= 2;
-					g /= 2;
-					b /= 2;
-				}
-				else if (_highlight && !_shadow)
-				{
-					r = (r / 2) + 0x80;
-					g = (g / 2) + 0x80;
-					b = (b / 2) + 0x80;
-				}
+				r /= 2;
+				g /= 2;
+				b /= 2;
 			}
-			else if (_selectedPalette == PALETTE_HIGHLOW)
+			else if (_highlight && !_shadow)
 			{
-				r = 0xFF - ((unsigned char)index * 17);
-				g = 0xFF - ((unsigned char)index * 17);
-				b = 0xFF - ((unsigned char)index * 17);
-				if (_shadow && !_highlight)
-				{
-					r /= 2;
-					g /= 2;
-					b /= 2;
-				}
-				else if (_highlight && !_shadow)
-				{
-					r = (r / 2) + 0x80;
-					g = (g / 2) + 0x80;
-					b = (b / 2) + 0x80;
-				}
+				r = (r / 2) + 0x80;
+				g = (g / 2) + 0x80;
+				b = (b / 2) + 0x80;
 			}
-			else
+		}
+		else if (_selectedPalette == PALETTE_HIGHLOW)
+		{
+			r = 0xFF - ((unsigned char)index * 17);
+			g = 0xFF - ((unsigned char)index * 17);
+			b = 0xFF - ((unsigned char)index * 17);
+			if (_shadow && !_highlight)
 			{
-				// Decode the colour for the target palette entry
-				IS315_5313::DecodedPaletteColorEntry color = _model.ReadDecodedPaletteColor(_selectedPalette, index);
-				r = _model.ColorValueTo8BitValue(color.r, _shadow, _highlight);
-				g = _model.ColorValueTo8BitValue(color.g, _shadow, _highlight);
-				b = _model.ColorValueTo8BitValue(color.b, _shadow, _highlight);
+				r /= 2;
+				g /= 2;
+				b /= 2;
 			}
+			else if (_highlight && !_shadow)
+			{
+				r = (r / 2) + 0x80;
+				g = (g / 2) + 0x80;
+				b = (b / 2) + 0x80;
+			}
+		}
+		else
+		{
+			// Decode the colour for the target palette entry
+			IS315_5313::DecodedPaletteColorEntry color = _model.ReadDecodedPaletteColor(_selectedPalette, index);
+			r = _model.ColorValueTo8BitValue(color.r, _shadow, _highlight);
+			g = _model.ColorValueTo8BitValue(color.g, _shadow, _highlight);
+			b = _model.ColorValueTo8BitValue(color.b, _shadow, _highlight);
+		}
+		paletteR[index] = r;
+		paletteG[index] = g;
+		paletteB[index] = b;
+	}
 
-			// Calculate the position in the data buffer to store the decoded colour. Note
-			// that a lot of math is required here. We've got to convert a raw byte index
-			// for a tile-based image buffer into a raw byte index for a scanline-based
-			// image buffer, so this is a non-trivial conversion.
-			unsigned int blockNo = (byteNo * pixelsPerByte) / (blockPixelSizeX * blockPixelSizeY);
-			unsigned int pixelNoWithinBlock = ((byteNo * pixelsPerByte) + pixelNo) % (blockPixelSizeX * blockPixelSizeY);
-			unsigned int blockRowNo = pixelNoWithinBlock / blockPixelSizeX;
-			unsigned int blockColumnNo = pixelNoWithinBlock % blockPixelSizeX;
-			unsigned int blockBufferRowNo = ((blockNo / _blocksPerRenderRow) * blockPixelSizeY) + blockRowNo;
-			unsigned int blockBufferColumnNo = ((blockNo % _blocksPerRenderRow) * blockPixelSizeX) + blockColumnNo;
-
+	// Fill the VRAM render buffer, one pattern row at a time
+	for (unsigned int rowAddress = 0; rowAddress < vramSize; rowAddress += bytesPerPatternRow)
+	{
+		const unsigned char* rowPixels = _patternTileCache.GetPatternRowPixels(rowAddress, false);
+
+		// Calculate the position in the data buffer to store the decoded row. Note that a
+		// lot of math is required here. We've got to convert a raw byte index for a
+		// tile-based image buffer into a raw byte index for a scanline-based image buffer,
+		// so this is a non-trivial conversion.
+		unsigned int blockNo = (rowAddress * pixelsPerByte) / (blockPixelSizeX * blockPixelSizeY);
+		unsigned int blockRowNo = ((rowAddress * pixelsPerByte) % (blockPixelSizeX * blockPixelSizeY)) / blockPixelSizeX;
+		unsigned int blockBufferRowNo = ((blockNo / _blocksPerRenderRow) * blockPixelSizeY) + blockRowNo;
+		unsigned int blockBufferFirstColumnNo = ((blockNo % _blocksPerRenderRow) * blockPixelSizeX);
+		for (unsigned int blockColumnNo = 0; blockColumnNo < blockPixelSizeX; ++blockColumnNo)
+		{
 			// Copy the decoded colour data into the buffer
-			_vramImage.WritePixelData(blockBufferColumnNo, blockBufferRowNo, 0, r);
-			_vramImage.WritePixelData(blockBufferColumnNo, blockBufferRowNo, 1, g);
-			_vramImage.WritePixelData(blockBufferColumnNo, blockBufferRowNo, 2, b);
+			unsigned int index = rowPixels[blockColumnNo];
+			unsigned int blockBufferColumnNo = blockBufferFirstColumnNo + blockColumnNo;
+			_vramImage.WritePixelData(blockBufferColumnNo, blockBufferRowNo, 0, paletteR[index]);
+			_vramImage.WritePixelData(blockBufferColumnNo, blockBufferRowNo, 1, paletteG[index]);
+			_vramImage.WritePixelData(blockBufferColumnNo, blockBufferRowNo, 2, paletteB[index]);
 
 			// Copy the data into the details popup
 			if (blockNo == _tileNumber)
 			{
-				_tileDetails[blockRowNo][blockColumnNo].r = r;
-				_tileDetails[blockRowNo][blockColumnNo].g = g;
-				_tileDetails[blockRowNo][blockColumnNo].b = b;
+				_tileDetails[blockRowNo][blockColumnNo].r = paletteR[index];
+				_tileDetails[blockRowNo][blockColumnNo].g = paletteG[index];
+				_tileDetails[blockRowNo][blockColumnNo].b = paletteB[index];
 				_tileDetails[blockRowNo][blockColumnNo].value = index;
 			}
+		}
 
-			// If we've just output the last pixel at the end of a row within the last
-			// block, pad this scanline in the data buffer out to the end of the line.
-			unsigned int lastBlockNo = ((pixelsInVRAM / (blockPixelSizeX * blockPixelSizeY)) - 1);
-			if ((blockNo == lastBlockNo) && (blockColumnNo == (blockPixelSizeX - 1)))
+		// If we've just output a row within the last block, pad this scanline in the data
+		// buffer out to the end of the line.
+		unsigned int lastBlockNo = ((pixelsInVRAM / (blockPixelSizeX * blockPixelSizeY)) - 1);
+		if (blockNo == lastBlockNo)
+		{
+			unsigned int paddingPixelsAfterLastBlock = ((_blocksPerRenderRow - 1) - (lastBlockNo % _blocksPerRenderRow)) * blockPixelSizeX;
+			for (unsigned int i = 0; i < paddingPixelsAfterLastBlock; ++i)
 			{
-				unsigned int paddingPixelsAfterLastBlock = ((_blocksPerRenderRow - 1) - (lastBlockNo % _blocksPerRenderRow)) * blockPixelSizeX;
-				for (unsigned int i = 0; i < paddingPixelsAfterLastBlock; ++i)
-				{
-					_vramImage.WritePixelData(blockBufferColumnNo + 1 + i, blockBufferRowNo, 0, (unsigned char)0);
-					_vramImage.WritePixelData(blockBufferColumnNo + 1 + i, blockBufferRowNo, 1, (unsigned char)0);
-					_vramImage.WritePixelData(blockBufferColumnNo + 1 + i, blockBufferRowNo, 2, (unsigned char)0);
-				}
+				_vramImage.WritePixelData(blockBufferFirstColumnNo + blockPixelSizeX + i, blockBufferRowNo, 0, (unsigned char)0);
+				_vramImage.WritePixelData(blockBufferFirstColumnNo + blockPixelSizeX + i, blockBufferRowNo, 1, (unsigned char)0);
+				_vramImage.WritePixelData(blockBufferFirstColumnNo + blockPixelSizeX + i, blockBufferRowNo, 2, (unsigned char)0);
 			}
 		}
 	}
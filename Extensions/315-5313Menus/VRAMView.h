@@ -4,6 +4,7 @@
 #include "DeviceInterface/DeviceInterface.pkg"
 #include "Image/Image.pkg"
 #include "VRAMViewPresenter.h"
+#include "PatternTileCache.h"
 #include "315-5313/IS315_5313.h"
 
 class VRAMView :public ViewBase
@@ -94,6 +95,7 @@ private:
 	std::wstring _previousText;
 	unsigned int _currentControlFocus;
 	Image _vramImage;
+	PatternTileCache _patternTileCache;
 
 	HWND _hwndLayoutGrid;
 	HWND _hwndScrollViewer;
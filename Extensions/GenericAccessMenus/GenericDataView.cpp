@@ -8,7 +8,7 @@
 // Constructors
 //----------------------------------------------------------------------------------------------------------------------
 GenericDataView::GenericDataView(IUIManager& uiManager, GenericDataViewPresenter& presenter, IGenericAccess& model, const IGenericAccessPage* page)
-:ViewBase(uiManager, presenter), _presenter(presenter), _model(model), _page(page)
+:ViewBase(uiManager, presenter), _presenter(presenter), _model(model), _page(page), _genericDataChangePending(false)
 {
 	SetWindowSettings(_page->GetTitle(), 0, 0, 500, 300);
 	//##TODO## Allow the device to give a hint here to assist in picking an appropriate
@@ -17,6 +17,16 @@ GenericDataView::GenericDataView(IUIManager& uiManager, GenericDataViewPresenter
 	SetDockableViewType(true, DockPos::Right, false, L"Exodus.RegisterGroup");
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+GenericDataView::~GenericDataView()
+{
+	// Delete each typed data value we allocated for batched reads
+	for (unsigned int i = 0; i < (unsigned int)_batchReadValues.size(); ++i)
+	{
+		delete _batchReadValues[i];
+	}
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 // Member window procedure
 //----------------------------------------------------------------------------------------------------------------------
@@ -73,6 +83,13 @@ LRESULT GenericDataView::msgWM_CREATE(HWND hwnd, WPARAM wparam, LPARAM lparam)
 	SendMessage(_hwndDataList, (UINT)WC_DataGrid::WindowMessages::InsertColumn, 0, (LPARAM)&nameColumn);
 	SendMessage(_hwndDataList, (UINT)WC_DataGrid::WindowMessages::InsertColumn, 0, (LPARAM)&valueColumn);
 
+	// Subscribe to change notifications for the generic data of the device. Note that we
+	// acknowledge change notifications before populating the data grid, which arms them,
+	// so that any change made after this point will trigger a refresh.
+	_genericDataChangeSubscription.SetBoundCallback(std::bind(std::mem_fn(&GenericDataView::GenericDataChanged), this));
+	_model.GenericDataChangeNotifyRegister(_genericDataChangeSubscription);
+	_model.GenericDataChangeNotifyAcknowledge();
+
 	// Check if the root node contains any child groups
 	const IGenericAccessGroup* rootNode = _page->GetContentRoot();
 	bool rootNodeContainsChildGroups = false;
@@ -106,6 +123,7 @@ LRESULT GenericDataView::msgWM_CREATE(HWND hwnd, WPARAM wparam, LPARAM lparam)
 LRESULT GenericDataView::msgWM_DESTROY(HWND hwnd, WPARAM wparam, LPARAM lparam)
 {
 	KillTimer(hwnd, 1);
+	_model.GenericDataChangeNotifyDeregister(_genericDataChangeSubscription);
 
 	return DefWindowProc(hwnd, WM_DESTROY, wparam, lparam);
 }
@@ -113,6 +131,24 @@ LRESULT GenericDataView::msgWM_DESTROY(HWND hwnd, WPARAM wparam, LPARAM lparam)
 //----------------------------------------------------------------------------------------------------------------------
 LRESULT GenericDataView::msgWM_TIMER(HWND hwnd, WPARAM wparam, LPARAM lparam)
 {
+	// If the device hasn't reported any changes to its generic data since our last
+	// refresh, abort any further processing. This avoids reading every data value from the
+	// device, and contending with the execution thread for its locks, while the device
+	// state isn't changing. Since this timer limits how often we refresh, any number of
+	// changes between timer events are coalesced into a single update.
+	if (!_genericDataChangePending.exchange(false))
+	{
+		return 0;
+	}
+
+	// Re-arm change notifications from the device. This needs to occur before we read any
+	// data values, so that a change made during our refresh will trigger another one.
+	_model.GenericDataChangeNotifyAcknowledge();
+
+	// Read the current values of all data entries which aren't nested within a collection
+	// in a single batch from the device
+	ReadBatchedDataValues();
+
 	// Update the contents of the data grid
 	unsigned int currentRow = 0;
 	while (currentRow < (unsigned int)_rowInfo.size())
@@ -269,6 +305,7 @@ LRESULT GenericDataView::msgWM_COMMAND(HWND hwnd, WPARAM wparam, LPARAM lparam)
 					// Execute the specified command on the device
 					const IGenericAccessGroupCommandEntry* commandEntry = static_cast<const IGenericAccessGroupCommandEntry*>(targetRowInfo.entry);
 					_model.ExecuteGenericCommand(commandEntry->GetCommandID(), commandEntry->GetDataContext());
+					_genericDataChangePending = true;
 				}
 				else if (targetRowInfo.entryType == IGenericAccessGroupEntry::GroupEntryType::Data)
 				{
@@ -339,6 +376,7 @@ LRESULT GenericDataView::msgWM_COMMAND(HWND hwnd, WPARAM wparam, LPARAM lparam)
 						}
 						bool newLockedState = !_model.GetGenericDataLocked(dataID, dataContext);
 						_model.SetGenericDataLocked(dataID, dataContext, newLockedState);
+						_genericDataChangePending = true;
 					}
 
 					// Unlock the target row entry now that we're finished accessing its
@@ -450,6 +488,16 @@ LRESULT GenericDataView::msgWM_KILLFOCUS(HWND hwnd, WPARAM wparam, LPARAM lparam
 	return 0;
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+// Change notification methods
+//----------------------------------------------------------------------------------------------------------------------
+void GenericDataView::GenericDataChanged()
+{
+	// Note that this is called from whichever thread modified the device data, so we only
+	// flag the change here, and leave the refresh to be performed on our next timer event.
+	_genericDataChangePending = true;
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 // Data update methods
 //----------------------------------------------------------------------------------------------------------------------
@@ -614,6 +662,8 @@ void GenericDataView::PopulateDataGrid(const IGenericAccessGroupEntry* entry, un
 		entryRowInfo.lastCollectionModifiedToken = 0;
 		entryRowInfo.collectionEntryKey = collectionEntryKey;
 		entryRowInfo.parentCollectionInfo = parentCollectionInfo;
+		entryRowInfo.batchReadPending = false;
+		entryRowInfo.batchReadIndex = 0;
 		_rowInfo.insert(_rowInfo.begin() + currentRow, entryRowInfo);
 	}
 
@@ -818,15 +868,36 @@ void GenericDataView::UpdateDataGrid(unsigned int& currentRow, bool parentLockSu
 				const IGenericAccessGroupDataEntry* dataEntry = static_cast<const IGenericAccessGroupDataEntry*>(targetRowInfo.entry);
 				dataID = dataEntry->GetDataID();
 				dataContext = dataEntry->GetDataContext();
-				_model.ReadGenericData(dataID, dataContext, value);
 			}
 			else
 			{
 				const IGenericAccessGroupSingleSelectionList* selectionListEntry = static_cast<const IGenericAccessGroupSingleSelectionList*>(targetRowInfo.entry);
 				dataID = selectionListEntry->GetDataID();
 				dataContext = selectionListEntry->GetDataContext();
+			}
+
+			// If the value for this row was retrieved as part of the batched read for this
+			// update, convert the typed value we received to a string here, otherwise read
+			// the value as a string from the device directly.
+			if (targetRowInfo.batchReadPending)
+			{
+				const IGenericAccess::DataBatchReadEntry& batchReadEntry = _batchReadEntries[targetRowInfo.batchReadIndex];
+				if (batchReadEntry.result)
+				{
+					value = batchReadEntry.dataValue->GetValueString();
+				}
+				targetRowInfo.batchReadPending = false;
+			}
+			else
+			{
 				_model.ReadGenericData(dataID, dataContext, value);
+			}
 
+			// If this is a selection list, translate the raw data value into the matching
+			// selection list entry.
+			if (targetRowInfo.entryType == IGenericAccessGroup::GroupEntryType::SingleSelectionList)
+			{
+				const IGenericAccessGroupSingleSelectionList* selectionListEntry = static_cast<const IGenericAccessGroupSingleSelectionList*>(targetRowInfo.entry);
 				std::list<std::pair<const IGenericAccessDataValue*, const IGenericAccessDataValue*>> selectionList = selectionListEntry->GetSelectionList();
 				std::list<std::pair<const IGenericAccessDataValue*, const IGenericAccessDataValue*>>::const_iterator selectionListIterator = selectionList.begin();
 				bool convertedValue = false;
@@ -938,6 +1009,113 @@ void GenericDataView::UpdateDataGrid(unsigned int& currentRow, bool parentLockSu
 	}
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+void GenericDataView::ReadBatchedDataValues()
+{
+	// Build the list of data values to retrieve in this batch. Note that we exclude entries
+	// nested within a collection, since these can only be safely accessed while holding a
+	// lock on each parent collection, which is handled by the per-row path in
+	// UpdateDataGrid. Typed value objects are retained between updates, and only
+	// reallocated if the data type for a given batch slot changes, so that a refresh of a
+	// page with a stable layout performs no allocation here.
+	unsigned int batchEntryCount = 0;
+	for (unsigned int rowNo = 0; rowNo < (unsigned int)_rowInfo.size(); ++rowNo)
+	{
+		GridRowInfo& rowInfo = _rowInfo[rowNo];
+		rowInfo.batchReadPending = false;
+		if (!rowInfo.parentCollectionInfo.empty())
+		{
+			continue;
+		}
+
+		// Retrieve the data ID and context for this row, if it refers to a data value.
+		unsigned int dataID;
+		const IGenericAccess::DataContext* dataContext;
+		if (rowInfo.entryType == IGenericAccessGroup::GroupEntryType::Data)
+		{
+			const IGenericAccessGroupDataEntry* dataEntry = static_cast<const IGenericAccessGroupDataEntry*>(rowInfo.entry);
+			dataID = dataEntry->GetDataID();
+			dataContext = dataEntry->GetDataContext();
+		}
+		else if (rowInfo.entryType == IGenericAccessGroup::GroupEntryType::SingleSelectionList)
+		{
+			const IGenericAccessGroupSingleSelectionList* selectionListEntry = static_cast<const IGenericAccessGroupSingleSelectionList*>(rowInfo.entry);
+			dataID = selectionListEntry->GetDataID();
+			dataContext = selectionListEntry->GetDataContext();
+		}
+		else
+		{
+			continue;
+		}
+
+		// Retrieve the data type for this data value
+		const IGenericAccessDataInfo* dataInfo = _model.GetGenericDataInfo(dataID);
+		if (dataInfo == 0)
+		{
+			continue;
+		}
+		IGenericAccessDataValue::DataType dataType = dataInfo->GetType();
+
+		// Ensure we have a typed value object of the correct type in this batch slot
+		if (batchEntryCount >= (unsigned int)_batchReadValues.size())
+		{
+			_batchReadValues.push_back(0);
+			_batchReadEntries.resize(_batchReadValues.size());
+		}
+		IGenericAccessDataValue*& dataValue = _batchReadValues[batchEntryCount];
+		if ((dataValue == 0) || (dataValue->GetType() != dataType))
+		{
+			delete dataValue;
+			dataValue = CreateDataValue(dataType);
+			if (dataValue == 0)
+			{
+				continue;
+			}
+		}
+
+		// Add this data value to the batch
+		IGenericAccess::DataBatchReadEntry& batchReadEntry = _batchReadEntries[batchEntryCount];
+		batchReadEntry.dataID = dataID;
+		batchReadEntry.dataContext = dataContext;
+		batchReadEntry.dataValue = dataValue;
+		batchReadEntry.result = false;
+		rowInfo.batchReadPending = true;
+		rowInfo.batchReadIndex = batchEntryCount;
+		++batchEntryCount;
+	}
+
+	// Retrieve all the data values in the batch from the device in a single call
+	if (batchEntryCount > 0)
+	{
+		_model.ReadGenericDataBatch(&_batchReadEntries[0], batchEntryCount);
+	}
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+IGenericAccessDataValue* GenericDataView::CreateDataValue(IGenericAccessDataValue::DataType dataType)
+{
+	switch (dataType)
+	{
+	case IGenericAccessDataValue::DataType::Bool:
+		return new GenericAccessDataValueBool();
+	case IGenericAccessDataValue::DataType::Int:
+		return new GenericAccessDataValueInt();
+	case IGenericAccessDataValue::DataType::UInt:
+		return new GenericAccessDataValueUInt();
+	case IGenericAccessDataValue::DataType::Float:
+		return new GenericAccessDataValueFloat();
+	case IGenericAccessDataValue::DataType::Double:
+		return new GenericAccessDataValueDouble();
+	case IGenericAccessDataValue::DataType::String:
+		return new GenericAccessDataValueString();
+	case IGenericAccessDataValue::DataType::FilePath:
+		return new GenericAccessDataValueFilePath();
+	case IGenericAccessDataValue::DataType::FolderPath:
+		return new GenericAccessDataValueFolderPath();
+	}
+	return 0;
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 std::wstring GenericDataView::BuildGroupSummaryText(const IGenericAccessGroup* group)
 {
@@ -5,12 +5,14 @@
 #include "GenericDataViewPresenter.h"
 #include <vector>
 #include <list>
+#include <atomic>
 
 class GenericDataView :public ViewBase
 {
 public:
 	// Constructors
 	GenericDataView(IUIManager& uiManager, GenericDataViewPresenter& presenter, IGenericAccess& model, const IGenericAccessPage* page);
+	~GenericDataView();
 
 protected:
 	// Member window procedure
@@ -45,6 +47,8 @@ private:
 		std::wstring collectionEntryKey;
 		std::list<ExpandStateInfo> preservedExpandState;
 		std::list<ParentCollectionInfo> parentCollectionInfo;
+		bool batchReadPending;
+		unsigned int batchReadIndex;
 	};
 	struct CachedState
 	{
@@ -70,11 +74,16 @@ private:
 	LRESULT msgWM_SETFOCUS(HWND hwnd, WPARAM wParam, LPARAM lParam);
 	LRESULT msgWM_KILLFOCUS(HWND hwnd, WPARAM wParam, LPARAM lParam);
 
+	// Change notification methods
+	void GenericDataChanged();
+
 	// Data update methods
 	void PopulateDataGrid(const IGenericAccessGroupEntry* entry, unsigned int& currentRow, unsigned int indentLevel, bool addChildrenOnly, bool usePreservedExpandState, bool preservedExpandState, unsigned int preservedExpandStateCollectionEntryCount, std::list<ExpandStateInfo>& preservedExpandStateBuffer, const std::list<ParentCollectionInfo>& parentCollectionInfo, const std::wstring& collectionEntryKey = L"", bool useNameOverride = false, const std::wstring& nameOverride = L"");
 	void DepopulateDataGrid(unsigned int targetRowNo, bool removeChildrenOnly, std::list<ExpandStateInfo>& preservedExpandStateBuffer);
 	void DepopulateDataGrid(unsigned int recursionDepth, unsigned int& targetRowNo, unsigned int& rowsToRemove, bool removeChildrenOnly, std::list<ExpandStateInfo>& preservedExpandStateBuffer);
 	void UpdateDataGrid(unsigned int& currentRow, bool parentLockSucceeded);
+	void ReadBatchedDataValues();
+	static IGenericAccessDataValue* CreateDataValue(IGenericAccessDataValue::DataType dataType);
 	std::wstring BuildGroupSummaryText(const IGenericAccessGroup* currentNode);
 
 	// Collection locking methods
@@ -87,8 +96,12 @@ private:
 	IGenericAccess& _model;
 	std::map<unsigned int, std::map<const IGenericAccess::DataContext*, CachedState>> _cachedStateMap;
 	std::vector<GridRowInfo> _rowInfo;
+	std::vector<IGenericAccess::DataBatchReadEntry> _batchReadEntries;
+	std::vector<IGenericAccessDataValue*> _batchReadValues;
 	HWND _hwndDataList;
 	HFONT _valueFont;
+	ObserverSubscription _genericDataChangeSubscription;
+	std::atomic<bool> _genericDataChangePending;
 };
 
 #endif
@@ -3,6 +3,7 @@
 #include "HierarchicalStorage/HierarchicalStorage.pkg"
 #include "DataConversion/DataConversion.pkg"
 #include "WindowsSupport/WindowsSupport.pkg"
+#include "Stream/Stream.pkg"
 
 //----------------------------------------------------------------------------------------------------------------------
 // Constructors
@@ -50,7 +51,8 @@ void MegaDriveROMLoader::LoadROMFile()
 	// Use the saved general ROM directory preference as the initial folder location when searching for the target ROM
 	// file. If no directory is saved, we let Windows choose the initial search location.
 	std::wstring initialSearchFolderPath;
-	HierarchicalStorageNode generalROMDirectoryNode;
+	HierarchicalStorageTree generalROMDirectoryTree;
+	IHierarchicalStorageNode& generalROMDirectoryNode = generalROMDirectoryTree.GetRootNode();
 	if (GetGUIInterface().GetGlobalPreference(L"Paths.GeneralROMDirectory", generalROMDirectoryNode))
 	{
 		initialSearchFolderPath = generalROMDirectoryNode.ExtractData<std::wstring>();
@@ -258,7 +260,7 @@ bool MegaDriveROMLoader::BuildROMFileModuleFromFile(const std::wstring& filePath
 	node.CreateChild(L"System.ImportConnector").CreateAttribute(L"ConnectorClassName", L"CartridgePort").CreateAttribute(L"ConnectorInstanceName", L"Cartridge Port");
 	node.CreateChild(L"System.ImportBusInterface").CreateAttribute(L"ConnectorInstanceName", L"Cartridge Port").CreateAttribute(L"BusInterfaceName", L"BusInterface").CreateAttribute(L"ImportName", L"BusInterface");
 	node.CreateChild(L"System.ImportSystemLine").CreateAttribute(L"ConnectorInstanceName", L"Cartridge Port").CreateAttribute(L"SystemLineName", L"CART").CreateAttribute(L"ImportName", L"CART");
-	node.CreateChild(L"Device").CreateAttribute(L"DeviceName", L"ROM16").CreateAttribute(L"InstanceName", L"ROM").CreateAttribute(L"BinaryDataPresent", true).CreateAttribute(L"SeparateBinaryData", true).SetData(filePath);
+	node.CreateChild(L"Device").CreateAttribute(L"DeviceName", L"ROM16").CreateAttribute(L"InstanceName", L"ROM").CreateAttribute(L"BinaryDataPresent", true).CreateAttribute(L"SeparateBinaryData", true).CreateAttribute(L"MapBinaryData", true).SetData(filePath);
 	if (sramPresent)
 	{
 		IHierarchicalStorageNode& ramDeviceNode = node.CreateChild(L"Device").CreateAttribute(L"DeviceName", L"RAM8").CreateAttribute(L"InstanceName", L"SRAM").CreateAttributeHex(L"MemoryEntryCount", sramByteSize, 0).CreateAttribute(L"RepeatData", true).CreateAttribute(L"PersistentData", true);
@@ -351,7 +353,30 @@ bool MegaDriveROMLoader::SaveOutputROMModule(IHierarchicalStorageTree& tree, con
 //----------------------------------------------------------------------------------------------------------------------
 bool MegaDriveROMLoader::LoadROMHeaderFromFile(const std::wstring& filePath, MegaDriveROMHeader& romHeader) const
 {
+	// If the target is a plain file on disk rather than an entry within an archive, map the
+	// file and read the header directly from the mapped view. The ROM device maps the same
+	// file when the generated module is loaded, so the file data only needs to be brought
+	// into memory once.
 	IGUIExtensionInterface& guiInterface = GetGUIInterface();
+	if (guiInterface.PathSplitElements(filePath).Get().size() == 1)
+	{
+		Stream::FileMapping fileMapping;
+		if (fileMapping.Open(filePath))
+		{
+			// Validate the size of the selected file
+			if (fileMapping.Size() < 0x200)
+			{
+				return false;
+			}
+
+			// Read in the contents of the Mega Drive ROM header from the mapped file
+			Stream::Buffer headerBuffer(0x200);
+			headerBuffer.WriteData(fileMapping.GetData(), 0x200);
+			return LoadROMHeaderFromStream(headerBuffer, (unsigned int)fileMapping.Size(), romHeader);
+		}
+	}
+
+	// Open the target file as a stream
 	Stream::IStream* dataStream = guiInterface.OpenExistingFileForRead(filePath);
 	if (dataStream == 0)
 	{
@@ -366,34 +391,44 @@ bool MegaDriveROMLoader::LoadROMHeaderFromFile(const std::wstring& filePath, Meg
 	}
 
 	// Read in the contents of the Mega Drive ROM header from the file
-	dataStream->SetStreamPos(0x100);
+	bool result = LoadROMHeaderFromStream(*dataStream, (unsigned int)dataStream->Size(), romHeader);
+
+	// Return the result of the operation
+	guiInterface.DeleteFileStream(dataStream);
+	return result;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool MegaDriveROMLoader::LoadROMHeaderFromStream(Stream::IStream& dataStream, unsigned int fileSize, MegaDriveROMHeader& romHeader)
+{
+	// Read in the contents of the Mega Drive ROM header from the stream
+	dataStream.SetStreamPos(0x100);
 	bool result = true;
-	result &= dataStream->ReadTextFixedLengthBufferAsASCII(0x10, romHeader.segaString);
-	result &= dataStream->ReadTextFixedLengthBufferAsASCII(0x10, romHeader.copyrightString);
-	result &= dataStream->ReadTextFixedLengthBufferAsASCII(0x30, romHeader.gameTitleJapan);
-	result &= dataStream->ReadTextFixedLengthBufferAsASCII(0x30, romHeader.gameTitleOverseas);
-	result &= dataStream->ReadTextFixedLengthBufferAsASCII(0x0E, romHeader.versionString);
-	result &= dataStream->ReadDataBigEndian(romHeader.checksum);
-	result &= dataStream->ReadTextFixedLengthBufferAsASCII(0x10, romHeader.controllerString);
-	result &= dataStream->ReadDataBigEndian(romHeader.romLocationStart);
-	result &= dataStream->ReadDataBigEndian(romHeader.romLocationEnd);
-	result &= dataStream->ReadDataBigEndian(romHeader.ramLocationStart);
-	result &= dataStream->ReadDataBigEndian(romHeader.ramLocationEnd);
-	result &= dataStream->ReadDataBigEndian(romHeader.bramSetting[0]);
-	result &= dataStream->ReadDataBigEndian(romHeader.bramSetting[1]);
-	result &= dataStream->ReadDataBigEndian(romHeader.bramSetting[2]);
-	result &= dataStream->ReadDataBigEndian(romHeader.bramSetting[3]);
-	result &= dataStream->ReadDataBigEndian(romHeader.bramLocationStart);
-	result &= dataStream->ReadDataBigEndian(romHeader.bramLocationEnd);
-	result &= dataStream->ReadTextFixedLengthBufferAsASCII(0x4, romHeader.bramUnusedData);
-	result &= dataStream->ReadTextFixedLengthBufferAsASCII(0x30, romHeader.unknownString);
-	result &= dataStream->ReadTextFixedLengthBufferAsASCII(0x10, romHeader.regionString);
+	result &= dataStream.ReadTextFixedLengthBufferAsASCII(0x10, romHeader.segaString);
+	result &= dataStream.ReadTextFixedLengthBufferAsASCII(0x10, romHeader.copyrightString);
+	result &= dataStream.ReadTextFixedLengthBufferAsASCII(0x30, romHeader.gameTitleJapan);
+	result &= dataStream.ReadTextFixedLengthBufferAsASCII(0x30, romHeader.gameTitleOverseas);
+	result &= dataStream.ReadTextFixedLengthBufferAsASCII(0x0E, romHeader.versionString);
+	result &= dataStream.ReadDataBigEndian(romHeader.checksum);
+	result &= dataStream.ReadTextFixedLengthBufferAsASCII(0x10, romHeader.controllerString);
+	result &= dataStream.ReadDataBigEndian(romHeader.romLocationStart);
+	result &= dataStream.ReadDataBigEndian(romHeader.romLocationEnd);
+	result &= dataStream.ReadDataBigEndian(romHeader.ramLocationStart);
+	result &= dataStream.ReadDataBigEndian(romHeader.ramLocationEnd);
+	result &= dataStream.ReadDataBigEndian(romHeader.bramSetting[0]);
+	result &= dataStream.ReadDataBigEndian(romHeader.bramSetting[1]);
+	result &= dataStream.ReadDataBigEndian(romHeader.bramSetting[2]);
+	result &= dataStream.ReadDataBigEndian(romHeader.bramSetting[3]);
+	result &= dataStream.ReadDataBigEndian(romHeader.bramLocationStart);
+	result &= dataStream.ReadDataBigEndian(romHeader.bramLocationEnd);
+	result &= dataStream.ReadTextFixedLengthBufferAsASCII(0x4, romHeader.bramUnusedData);
+	result &= dataStream.ReadTextFixedLengthBufferAsASCII(0x30, romHeader.unknownString);
+	result &= dataStream.ReadTextFixedLengthBufferAsASCII(0x10, romHeader.regionString);
 
 	// Record additional information about the ROM file
-	romHeader.fileSize = (unsigned int)dataStream->Size();
+	romHeader.fileSize = fileSize;
 
 	// Return the result of the operation
-	guiInterface.DeleteFileStream(dataStream);
 	return result;
 }
 
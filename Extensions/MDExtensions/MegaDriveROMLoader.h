@@ -35,6 +35,7 @@ private:
 
 	// ROM analysis functions
 	bool LoadROMHeaderFromFile(const std::wstring& filePath, MegaDriveROMHeader& romHeader) const;
+	static bool LoadROMHeaderFromStream(Stream::IStream& dataStream, unsigned int fileSize, MegaDriveROMHeader& romHeader);
 	static bool AutoDetectRegionCode(const MegaDriveROMHeader& romHeader, std::wstring& regionCode);
 	static bool AutoDetectBackupRAMSupport(const MegaDriveROMHeader& romHeader, unsigned int& sramStartLocation, unsigned int& sramByteSize, bool& linkedToEvenAddress, bool& linkedToOddAddress, bool& sram16Bit, std::vector<unsigned char>& initialRAMData);
 	static bool StringStartsWith(const std::string& targetString, const std::string& compareString);
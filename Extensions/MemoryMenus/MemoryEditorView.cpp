@@ -10,6 +10,9 @@ MemoryEditorView::MemoryEditorView(IUIManager& uiManager, MemoryEditorViewPresen
 :ViewBase(uiManager, presenter), _presenter(presenter), _model(model)
 {
 	_hwndMem = NULL;
+	_lastMemoryBlockGeneration = 0;
+	_lastWindowPos = 0;
+	_lastWindowSize = 0;
 	SetWindowSettings(presenter.GetUnqualifiedViewTitle(), 0, 0, 440, 500);
 	SetDockableViewType(true, DockPos::Right, false, L"Exodus.VerticalWatchers");
 }
@@ -99,36 +102,9 @@ LRESULT MemoryEditorView::msgWM_DESTROY(HWND hwnd, WPARAM wparam, LPARAM lparam)
 //----------------------------------------------------------------------------------------------------------------------
 LRESULT MemoryEditorView::msgWM_TIMER(HWND hwnd, WPARAM wparam, LPARAM lparam)
 {
-	unsigned int totalMemorySize = (_model.GetMemoryEntryCount() * _model.GetMemoryEntrySizeInBytes());
 	unsigned int windowSize = (unsigned int)SendMessage(_hwndMem, (UINT)WC_HexEdit::WindowMessages::GetWindowSize, 0, 0);
 	unsigned int windowPos = (unsigned int)SendMessage(_hwndMem, (UINT)WC_HexEdit::WindowMessages::GetWindowPos, 0, 0);
-	if (windowSize > 0)
-	{
-		unsigned int memoryEntrySizeInBytes = _model.GetMemoryEntrySizeInBytes();
-		std::vector<unsigned char> bufferSegment(windowSize);
-		std::vector<unsigned char> markBufferSegment(windowSize);
-		Data data(memoryEntrySizeInBytes * Data::BitsPerByte);
-		unsigned int byteNoInWindow = 0;
-		while ((byteNoInWindow < windowSize) && ((windowPos + byteNoInWindow) < totalMemorySize))
-		{
-			unsigned int memoryEntryPos = ((windowPos + byteNoInWindow) / memoryEntrySizeInBytes);
-			unsigned int memoryEntrySkippedBytes = ((windowPos + byteNoInWindow) % memoryEntrySizeInBytes);
-			data = _model.ReadMemoryEntry(memoryEntryPos);
-			unsigned int byteNoInEntry = memoryEntrySkippedBytes;
-			while ((byteNoInWindow < windowSize) && ((windowPos + byteNoInWindow) < totalMemorySize) && (byteNoInEntry < memoryEntrySizeInBytes))
-			{
-				bufferSegment[byteNoInWindow] = data.GetByteFromTopDown(byteNoInEntry);
-				markBufferSegment[byteNoInWindow] = _model.IsAddressLocked(memoryEntryPos)? 1: 0;
-				++byteNoInWindow;
-				++byteNoInEntry;
-			}
-		}
-		WC_HexEdit::Hex_UpdateWindowData info;
-		info.newBufferSize = windowSize;
-		info.newBufferData = &bufferSegment[0];
-		info.newMarkBufferData = &markBufferSegment[0];
-		SendMessage(_hwndMem, (UINT)WC_HexEdit::WindowMessages::UpdateWindowData, 0, (LPARAM)&info);
-	}
+	UpdateWindowData(windowPos, windowSize, false);
 
 	return 0;
 }
@@ -142,120 +118,56 @@ LRESULT MemoryEditorView::msgWM_COMMAND(HWND hwnd, WPARAM wparam, LPARAM lparam)
 		if (notification == WC_HexEdit::WindowNotifications::ReadData)
 		{
 			WC_HexEdit::Hex_ReadDataInfo* readDataInfo = (WC_HexEdit::Hex_ReadDataInfo*)lparam;
-			unsigned int memoryEntrySizeInBytes = _model.GetMemoryEntrySizeInBytes();
-			Data data(memoryEntrySizeInBytes * Data::BitsPerByte);
-			unsigned int memoryEntryPos = (readDataInfo->offset / memoryEntrySizeInBytes);
-			unsigned int memoryEntrySkippedBytes = (readDataInfo->offset % memoryEntrySizeInBytes);
-			data = _model.ReadMemoryEntry(memoryEntryPos);
-			readDataInfo->data = data.GetByteFromTopDown(memoryEntrySkippedBytes);
-			readDataInfo->processed = true;
+			unsigned int totalMemorySize = (_model.GetMemoryEntryCount() * _model.GetMemoryEntrySizeInBytes());
+			if (readDataInfo->offset < totalMemorySize)
+			{
+				_model.ReadMemoryBlock(readDataInfo->offset, 1, &readDataInfo->data, 0);
+				readDataInfo->processed = true;
+			}
 		}
 		else if (notification == WC_HexEdit::WindowNotifications::WriteData)
 		{
 			WC_HexEdit::Hex_WriteDataInfo* writeDataInfo = (WC_HexEdit::Hex_WriteDataInfo*)lparam;
-			unsigned int memoryEntrySizeInBytes = _model.GetMemoryEntrySizeInBytes();
-			if (memoryEntrySizeInBytes == 1)
-			{
-				_model.WriteMemoryEntry(writeDataInfo->offset, writeDataInfo->data);
-			}
-			else
+			unsigned int totalMemorySize = (_model.GetMemoryEntryCount() * _model.GetMemoryEntrySizeInBytes());
+			if (writeDataInfo->offset < totalMemorySize)
 			{
-				Data data(memoryEntrySizeInBytes * Data::BitsPerByte);
-				unsigned int memoryEntryPos = (writeDataInfo->offset / memoryEntrySizeInBytes);
-				unsigned int memoryEntrySkippedBytes = (writeDataInfo->offset % memoryEntrySizeInBytes);
-				data = _model.ReadMemoryEntry(memoryEntryPos);
-				data.SetByteFromTopDown(memoryEntrySkippedBytes, writeDataInfo->data);
-				_model.WriteMemoryEntry(memoryEntryPos, data.GetData());
+				_model.WriteMemoryBlock(writeDataInfo->offset, 1, &writeDataInfo->data);
 			}
 		}
 		else if (notification == WC_HexEdit::WindowNotifications::ReadDataBlock)
 		{
 			WC_HexEdit::Hex_ReadDataBlockInfo* readDataBlockInfo = (WC_HexEdit::Hex_ReadDataBlockInfo*)lparam;
-			unsigned int memoryEntrySizeInBytes = _model.GetMemoryEntrySizeInBytes();
-			Data data(memoryEntrySizeInBytes * Data::BitsPerByte);
-			unsigned int byteNoInBlock = 0;
-			while (byteNoInBlock < readDataBlockInfo->size)
+			unsigned int totalMemorySize = (_model.GetMemoryEntryCount() * _model.GetMemoryEntrySizeInBytes());
+			if (readDataBlockInfo->offset < totalMemorySize)
 			{
-				unsigned int memoryEntryPos = ((readDataBlockInfo->offset + byteNoInBlock) / memoryEntrySizeInBytes);
-				unsigned int memoryEntrySkippedBytes = ((readDataBlockInfo->offset + byteNoInBlock) % memoryEntrySizeInBytes);
-				data = _model.ReadMemoryEntry(memoryEntryPos);
-				unsigned int byteNoInEntry = memoryEntrySkippedBytes;
-				while ((byteNoInBlock < readDataBlockInfo->size) && (byteNoInEntry < memoryEntrySizeInBytes))
-				{
-					readDataBlockInfo->buffer[byteNoInBlock] = data.GetByteFromTopDown(byteNoInEntry);
-					++byteNoInBlock;
-					++byteNoInEntry;
-				}
+				unsigned int readSize = ((totalMemorySize - readDataBlockInfo->offset) < readDataBlockInfo->size)? (totalMemorySize - readDataBlockInfo->offset): readDataBlockInfo->size;
+				_model.ReadMemoryBlock(readDataBlockInfo->offset, readSize, readDataBlockInfo->buffer, 0);
+				memset(readDataBlockInfo->buffer + readSize, 0, (readDataBlockInfo->size - readSize));
+				readDataBlockInfo->processed = true;
 			}
-			readDataBlockInfo->processed = true;
 		}
 		else if (notification == WC_HexEdit::WindowNotifications::WriteDataBlock)
 		{
 			WC_HexEdit::Hex_WriteDataBlockInfo* writeDataBlockInfo = (WC_HexEdit::Hex_WriteDataBlockInfo*)lparam;
-			unsigned int memoryEntrySizeInBytes = _model.GetMemoryEntrySizeInBytes();
-			Data data(memoryEntrySizeInBytes * Data::BitsPerByte);
-			unsigned int byteNoInBlock = 0;
-			while (byteNoInBlock < writeDataBlockInfo->size)
+			unsigned int totalMemorySize = (_model.GetMemoryEntryCount() * _model.GetMemoryEntrySizeInBytes());
+			if (writeDataBlockInfo->offset < totalMemorySize)
 			{
-				unsigned int memoryEntryPos = ((writeDataBlockInfo->offset + byteNoInBlock) / memoryEntrySizeInBytes);
-				unsigned int memoryEntrySkippedBytes = ((writeDataBlockInfo->offset + byteNoInBlock) % memoryEntrySizeInBytes);
-				unsigned int writeDataBlockRemainingBytes = ((writeDataBlockInfo->size - 1) - byteNoInBlock);
-				if ((memoryEntrySkippedBytes > 0) || (writeDataBlockRemainingBytes < memoryEntrySizeInBytes))
-				{
-					data = _model.ReadMemoryEntry(memoryEntryPos);
-				}
-				unsigned int byteNoInEntry = memoryEntrySkippedBytes;
-				while ((byteNoInBlock < writeDataBlockInfo->size) && (byteNoInEntry < memoryEntrySizeInBytes))
-				{
-					data.SetByteFromTopDown(byteNoInEntry, writeDataBlockInfo->buffer[byteNoInBlock]);
-					++byteNoInBlock;
-					++byteNoInEntry;
-				}
-				_model.WriteMemoryEntry(memoryEntryPos, data.GetData());
+				unsigned int writeSize = ((totalMemorySize - writeDataBlockInfo->offset) < writeDataBlockInfo->size)? (totalMemorySize - writeDataBlockInfo->offset): writeDataBlockInfo->size;
+				_model.WriteMemoryBlock(writeDataBlockInfo->offset, writeSize, writeDataBlockInfo->buffer);
 			}
 			writeDataBlockInfo->processed = true;
 		}
 		else if (notification == WC_HexEdit::WindowNotifications::NewWindowPos)
 		{
 			WC_HexEdit::Hex_NewWindowPosInfo* windowPosInfo = (WC_HexEdit::Hex_NewWindowPosInfo*)lparam;
-			unsigned int totalMemorySize = (_model.GetMemoryEntryCount() * _model.GetMemoryEntrySizeInBytes());
-			unsigned int windowSize = windowPosInfo->windowSize;
-			unsigned int windowPos = windowPosInfo->windowPos;
-			if (windowSize > 0)
-			{
-				std::vector<unsigned char> bufferSegment(windowSize);
-				std::vector<unsigned char> markBufferSegment(windowSize);
-
-				unsigned int memoryEntrySizeInBytes = _model.GetMemoryEntrySizeInBytes();
-				Data data(memoryEntrySizeInBytes * Data::BitsPerByte);
-				unsigned int byteNoInBlock = 0;
-				while ((byteNoInBlock < windowSize) && ((windowPos + byteNoInBlock) < totalMemorySize))
-				{
-					unsigned int memoryEntryPos = ((windowPos + byteNoInBlock) / memoryEntrySizeInBytes);
-					unsigned int memoryEntrySkippedBytes = ((windowPos + byteNoInBlock) % memoryEntrySizeInBytes);
-					data = _model.ReadMemoryEntry(memoryEntryPos);
-					unsigned int byteNoInEntry = memoryEntrySkippedBytes;
-					while ((byteNoInBlock < windowSize) && ((windowPos + byteNoInBlock) < totalMemorySize) && (byteNoInEntry < memoryEntrySizeInBytes))
-					{
-						bufferSegment[byteNoInBlock] = data.GetByteFromTopDown(byteNoInEntry);
-						markBufferSegment[byteNoInBlock] = _model.IsAddressLocked(memoryEntryPos)? 1: 0;
-						++byteNoInBlock;
-						++byteNoInEntry;
-					}
-				}
-
-				WC_HexEdit::Hex_UpdateWindowData info;
-				info.newBufferSize = windowSize;
-				info.newBufferData = &bufferSegment[0];
-				info.newMarkBufferData = &markBufferSegment[0];
-				SendMessage(_hwndMem, (UINT)WC_HexEdit::WindowMessages::UpdateWindowData, 0, (LPARAM)&info);
-			}
+			UpdateWindowData(windowPosInfo->windowPos, windowPosInfo->windowSize, true);
 		}
 		else if (notification == WC_HexEdit::WindowNotifications::UpdateDataMarking)
 		{
 			WC_HexEdit::Hex_UpdateDataMarkingState* dataMarkingState = (WC_HexEdit::Hex_UpdateDataMarkingState*)lparam;
 			unsigned int memoryEntrySizeInBytes = _model.GetMemoryEntrySizeInBytes();
 			_model.LockMemoryBlock(dataMarkingState->offset / memoryEntrySizeInBytes, ((dataMarkingState->size + (memoryEntrySizeInBytes - 1)) / memoryEntrySizeInBytes), dataMarkingState->state);
+			_lastMemoryBlockGeneration = 0;
 		}
 	}
 
@@ -315,3 +227,42 @@ LRESULT MemoryEditorView::msgWM_KILLFOCUS(HWND hwnd, WPARAM wparam, LPARAM lpara
 	SendMessage(_hwndMem, WM_KILLFOCUS, NULL, 0);
 	return 0;
 }
+
+//----------------------------------------------------------------------------------------------------------------------
+// Window data functions
+//----------------------------------------------------------------------------------------------------------------------
+void MemoryEditorView::UpdateWindowData(unsigned int windowPos, unsigned int windowSize, bool forceUpdate)
+{
+	// If the memory reports that its contents haven't changed since our last update, and
+	// the window hasn't moved, there's nothing to do.
+	unsigned int memoryBlockGeneration = _model.GetMemoryBlockGeneration();
+	if (!forceUpdate && (memoryBlockGeneration != 0) && (memoryBlockGeneration == _lastMemoryBlockGeneration) && (windowPos == _lastWindowPos) && (windowSize == _lastWindowSize))
+	{
+		return;
+	}
+	_lastMemoryBlockGeneration = memoryBlockGeneration;
+	_lastWindowPos = windowPos;
+	_lastWindowSize = windowSize;
+	if (windowSize <= 0)
+	{
+		return;
+	}
+
+	// Read the memory contents and lock state for the window in a single operation. Any
+	// part of the window which extends past the end of the memory is left as zero.
+	unsigned int totalMemorySize = (_model.GetMemoryEntryCount() * _model.GetMemoryEntrySizeInBytes());
+	_windowData.assign(windowSize, 0);
+	_windowMarkData.assign(windowSize, 0);
+	if (windowPos < totalMemorySize)
+	{
+		unsigned int readSize = ((totalMemorySize - windowPos) < windowSize)? (totalMemorySize - windowPos): windowSize;
+		_model.ReadMemoryBlock(windowPos, readSize, &_windowData[0], &_windowMarkData[0]);
+	}
+
+	// Pass the new window data to the HexEdit control
+	WC_HexEdit::Hex_UpdateWindowData info;
+	info.newBufferSize = windowSize;
+	info.newBufferData = &_windowData[0];
+	info.newMarkBufferData = &_windowMarkData[0];
+	SendMessage(_hwndMem, (UINT)WC_HexEdit::WindowMessages::UpdateWindowData, 0, (LPARAM)&info);
+}
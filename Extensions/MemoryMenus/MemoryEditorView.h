@@ -30,10 +30,18 @@ private:
 	LRESULT msgWM_SETFOCUS(HWND hwnd, WPARAM wParam, LPARAM lParam);
 	LRESULT msgWM_KILLFOCUS(HWND hwnd, WPARAM wParam, LPARAM lParam);
 
+	// Window data functions
+	void UpdateWindowData(unsigned int windowPos, unsigned int windowSize, bool forceUpdate);
+
 private:
 	MemoryEditorViewPresenter& _presenter;
 	IMemory& _model;
 	HWND _hwndMem;
+	unsigned int _lastMemoryBlockGeneration;
+	unsigned int _lastWindowPos;
+	unsigned int _lastWindowSize;
+	std::vector<unsigned char> _windowData;
+	std::vector<unsigned char> _windowMarkData;
 };
 
 #endif
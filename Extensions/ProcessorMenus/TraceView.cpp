@@ -338,12 +338,34 @@ INT_PTR TraceView::msgPanelWM_COMMAND(HWND hwnd, WPARAM wparam, LPARAM lparam)
 		case IDC_PROCESSOR_TRACE_TRACEFILEPATHCHANGE:{
 			std::wstring filePathCurrent = GetDlgItemString(hwnd, IDC_PROCESSOR_TRACE_TRACEFILEPATH);
 			std::wstring selectedFilePath;
-			if (SelectNewFile(hwnd, L"Text files|txt", L"txt", filePathCurrent, _presenter.GetGUIInterface().GetGlobalPreferencePathCaptures(), selectedFilePath))
+			if (SelectNewFile(hwnd, L"Trace files|extrace", L"extrace", filePathCurrent, _presenter.GetGUIInterface().GetGlobalPreferencePathCaptures(), selectedFilePath))
 			{
 				_model.SetTraceLoggingFilePath(selectedFilePath);
 				UpdateDlgItemString(hwnd, IDC_PROCESSOR_TRACE_TRACEFILEPATH, selectedFilePath);
 			}
 			break;}
+		case IDC_PROCESSOR_TRACE_EXPORTTRACEFILE:{
+			std::wstring currentTraceFilePath = _model.GetTraceLoggingFilePath();
+			std::wstring traceFilePath;
+			if (!SelectExistingFile(hwnd, L"Trace files|extrace", L"extrace", currentTraceFilePath, _presenter.GetGUIInterface().GetGlobalPreferencePathCaptures(), traceFilePath))
+			{
+				break;
+			}
+			std::wstring textFilePath;
+			if (!SelectNewFile(hwnd, L"Text files|txt", L"txt", L"", _presenter.GetGUIInterface().GetGlobalPreferencePathCaptures(), textFilePath))
+			{
+				break;
+			}
+
+			// If the selected trace file is currently being written to, stop logging to it
+			// first, so that all buffered trace records are written out before it's exported.
+			if (_model.IsTraceFileLoggingEnabled() && (traceFilePath == currentTraceFilePath))
+			{
+				_model.SetTraceFileLoggingEnabled(false);
+				CheckDlgButton(hwnd, IDC_PROCESSOR_TRACE_ENABLETRACEFILE, BST_UNCHECKED);
+			}
+			_model.ExportTraceFileToTextFile(traceFilePath, textFilePath);
+			break;}
 		}
 	}
 
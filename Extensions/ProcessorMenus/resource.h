@@ -139,6 +139,7 @@
 #define IDC_PROCESSOR_DISASSEMBLY_PANEL_RUNTOSELECTION 1447
 #define IDC_PROCESSOR_DISASSEMBLY_PANEL_RUN 1448
 #define IDC_PROCESSOR_DISASSEMBLY_PANEL_STOP 1449
+#define IDC_PROCESSOR_TRACE_EXPORTTRACEFILE 1450
 
 // Next default values for new objects
 // 
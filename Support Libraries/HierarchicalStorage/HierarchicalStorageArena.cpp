@@ -0,0 +1,130 @@
+#include "HierarchicalStorageArena.h"
+#include <new>
+
+//----------------------------------------------------------------------------------------------------------------------
+// Structures
+//----------------------------------------------------------------------------------------------------------------------
+struct HierarchicalStorageArena::FreeEntry
+{
+	// Free entries are stored in place within the released allocation itself, so every
+	// allocation must be at least large enough to hold this structure.
+	FreeEntry* nextEntry;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+// Constructors
+//----------------------------------------------------------------------------------------------------------------------
+HierarchicalStorageArena::HierarchicalStorageArena()
+:_currentBlockPos(0), _currentBlockRemainingBytes(0)
+{ }
+
+//----------------------------------------------------------------------------------------------------------------------
+// Allocation functions
+//----------------------------------------------------------------------------------------------------------------------
+void* HierarchicalStorageArena::Allocate(size_t size)
+{
+	size = RoundAllocationSize(size);
+	std::unique_lock<std::mutex> lock(_accessMutex);
+
+	// If a previous allocation of the same size has been released, reuse it.
+	FreeListMap::iterator freeListIterator = _freeLists.find(size);
+	if ((freeListIterator != _freeLists.end()) && (freeListIterator->second != 0))
+	{
+		FreeEntry* freeEntry = freeListIterator->second;
+		freeListIterator->second = freeEntry->nextEntry;
+		return freeEntry;
+	}
+
+	// If this allocation is large relative to our block size, give it a block of its own
+	// so we don't waste the remaining space in the current block.
+	if (size > (BlockSizeInBytes / 4))
+	{
+		_blocks.push_back(Block(new unsigned char[size]));
+		return _blocks.back().get();
+	}
+
+	// Start a new block if there isn't enough space left in the current block for this
+	// allocation
+	if (size > _currentBlockRemainingBytes)
+	{
+		_blocks.push_back(Block(new unsigned char[BlockSizeInBytes]));
+		_currentBlockPos = _blocks.back().get();
+		_currentBlockRemainingBytes = BlockSizeInBytes;
+	}
+
+	// Allocate the requested memory from the current block
+	void* allocation = _currentBlockPos;
+	_currentBlockPos += size;
+	_currentBlockRemainingBytes -= size;
+	return allocation;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void HierarchicalStorageArena::Free(void* allocation, size_t size)
+{
+	// Add this allocation to the free list for its size. Note that the size must match the
+	// size which was originally passed to Allocate.
+	size = RoundAllocationSize(size);
+	std::unique_lock<std::mutex> lock(_accessMutex);
+	FreeEntry*& freeListHead = _freeLists[size];
+	FreeEntry* freeEntry = new(allocation) FreeEntry;
+	freeEntry->nextEntry = freeListHead;
+	freeListHead = freeEntry;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+size_t HierarchicalStorageArena::RoundAllocationSize(size_t size)
+{
+	// Round the allocation size up so that the next allocation from the same block will be
+	// correctly aligned for any type, and so that a released allocation can always hold its
+	// free list entry.
+	size = (size < sizeof(FreeEntry))? sizeof(FreeEntry): size;
+	return (size + (AllocationAlignment - 1)) & ~(AllocationAlignment - 1);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Name functions
+//----------------------------------------------------------------------------------------------------------------------
+const std::wstring& HierarchicalStorageArena::InternName(const std::wstring& name)
+{
+	return InternName(name.c_str(), name.size());
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+const std::wstring& HierarchicalStorageArena::InternName(const wchar_t* name, size_t length)
+{
+	// Attempt to locate an existing copy of this name
+	size_t nameHash = CalculateNameHash(name, length);
+	std::unique_lock<std::mutex> lock(_accessMutex);
+	std::pair<NameLookupMap::const_iterator, NameLookupMap::const_iterator> nameRange = _nameLookup.equal_range(nameHash);
+	for (NameLookupMap::const_iterator i = nameRange.first; i != nameRange.second; ++i)
+	{
+		const std::wstring& existingName = *i->second;
+		if ((existingName.size() == length) && (existingName.compare(0, length, name, length) == 0))
+		{
+			return existingName;
+		}
+	}
+
+	// Add this name to our set of interned names. Note that we use a deque to store the
+	// names, as it guarantees references to existing elements remain valid when new
+	// elements are appended.
+	_names.push_back(std::wstring(name, length));
+	const std::wstring& newName = _names.back();
+	_nameLookup.insert(NameLookupMap::value_type(nameHash, &newName));
+	return newName;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+size_t HierarchicalStorageArena::CalculateNameHash(const wchar_t* name, size_t length)
+{
+	// Calculate a 32-bit FNV-1a hash of the name. Names are short, so this is both faster
+	// and simpler than building a temporary string to use the standard hash function.
+	unsigned int hash = 2166136261u;
+	for (size_t i = 0; i < length; ++i)
+	{
+		hash ^= (unsigned int)name[i];
+		hash *= 16777619u;
+	}
+	return (size_t)hash;
+}
@@ -0,0 +1,65 @@
+#ifndef __HIERARCHICALSTORAGEARENA_H__
+#define __HIERARCHICALSTORAGEARENA_H__
+#include <string>
+#include <vector>
+#include <deque>
+#include <unordered_map>
+#include <memory>
+#include <mutex>
+#include <cstddef>
+
+// This class provides the backing storage for all the nodes and attributes in a single
+// hierarchical storage tree. Nodes and attributes are allocated sequentially out of large
+// blocks rather than individually from the heap, and node and attribute names are interned
+// so that each distinct name is only stored once per tree, regardless of how many elements
+// use it. Allocations returned to the arena with Free are kept on a free list for their
+// rounded size and reused by later allocations of the same size, so a long lived tree which
+// repeatedly creates and deletes elements only grows to its peak element count. Blocks
+// themselves, and interned names, are only released when the arena itself is destroyed.
+class HierarchicalStorageArena
+{
+public:
+	// Constructors
+	HierarchicalStorageArena();
+
+	// Allocation functions
+	void* Allocate(size_t size);
+	void Free(void* allocation, size_t size);
+
+	// Name functions
+	const std::wstring& InternName(const std::wstring& name);
+	const std::wstring& InternName(const wchar_t* name, size_t length);
+
+private:
+	// Constants
+	static const size_t BlockSizeInBytes = 0x10000;
+	static const size_t AllocationAlignment = alignof(std::max_align_t);
+
+private:
+	// Structures
+	struct FreeEntry;
+
+private:
+	// Typedefs
+	typedef std::unique_ptr<unsigned char[]> Block;
+	typedef std::unordered_multimap<size_t, const std::wstring*> NameLookupMap;
+	typedef std::unordered_map<size_t, FreeEntry*> FreeListMap;
+
+private:
+	// Allocation functions
+	static inline size_t RoundAllocationSize(size_t size);
+
+	// Name functions
+	static size_t CalculateNameHash(const wchar_t* name, size_t length);
+
+private:
+	std::mutex _accessMutex;
+	std::vector<Block> _blocks;
+	unsigned char* _currentBlockPos;
+	size_t _currentBlockRemainingBytes;
+	FreeListMap _freeLists;
+	std::deque<std::wstring> _names;
+	NameLookupMap _nameLookup;
+};
+
+#endif
@@ -3,12 +3,13 @@
 //----------------------------------------------------------------------------------------------------------------------
 // Constructors
 //----------------------------------------------------------------------------------------------------------------------
-HierarchicalStorageAttribute::HierarchicalStorageAttribute()
+HierarchicalStorageAttribute::HierarchicalStorageAttribute(HierarchicalStorageArena& arena)
+:_arena(arena), _name(&arena.InternName(L"")), _buffer(0, ValueBufferSizeIncrement), _integerValuePresent(false), _integerValueStreamPosAtStart(false), _integerValueNegative(false), _integerValueMagnitude(0)
 { }
 
 //----------------------------------------------------------------------------------------------------------------------
-HierarchicalStorageAttribute::HierarchicalStorageAttribute(const std::wstring& name)
-:_name(name)
+HierarchicalStorageAttribute::HierarchicalStorageAttribute(HierarchicalStorageArena& arena, const std::wstring& name)
+:_arena(arena), _name(&arena.InternName(name)), _buffer(0, ValueBufferSizeIncrement), _integerValuePresent(false), _integerValueStreamPosAtStart(false), _integerValueNegative(false), _integerValueMagnitude(0)
 { }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -16,13 +17,40 @@ HierarchicalStorageAttribute::HierarchicalStorageAttribute(const std::wstring& n
 //----------------------------------------------------------------------------------------------------------------------
 Marshal::Ret<std::wstring> HierarchicalStorageAttribute::GetName() const
 {
-	return _name;
+	return *_name;
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 void HierarchicalStorageAttribute::SetName(const Marshal::In<std::wstring>& name)
 {
-	_name = name;
+	_name = &_arena.InternName(name.Get());
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Typed value functions
+//----------------------------------------------------------------------------------------------------------------------
+bool HierarchicalStorageAttribute::GetIntegerValue(bool& negative, unsigned long long& magnitude) const
+{
+	if (!_integerValuePresent)
+	{
+		return false;
+	}
+	negative = _integerValueNegative;
+	magnitude = _integerValueMagnitude;
+	return true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void HierarchicalStorageAttribute::SetIntegerValue(bool negative, unsigned long long magnitude)
+{
+	// Integer values are held in binary form until the value is accessed as a stream. We
+	// track the stream position the value would have if it had been written as text, which
+	// is at the end of the value until the position is reset.
+	_buffer.Resize(0);
+	_integerValuePresent = true;
+	_integerValueStreamPosAtStart = false;
+	_integerValueNegative = negative;
+	_integerValueMagnitude = magnitude;
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -30,17 +58,37 @@ void HierarchicalStorageAttribute::SetName(const Marshal::In<std::wstring>& name
 //----------------------------------------------------------------------------------------------------------------------
 void HierarchicalStorageAttribute::ResetInternalStreamPosition() const
 {
+	_integerValueStreamPosAtStart = true;
 	_buffer.SetStreamPos(0);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 void HierarchicalStorageAttribute::EmptyInternalStream()
 {
+	_integerValuePresent = false;
 	_buffer.Resize(0);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 Stream::IStream& HierarchicalStorageAttribute::GetInternalStream() const
 {
+	// If the value is currently held in binary form, convert it to text now. Since the
+	// caller may modify the stream, the binary form is discarded at this point.
+	if (_integerValuePresent)
+	{
+		_integerValuePresent = false;
+		_buffer.Resize(0);
+		_buffer.SetStreamPos(0);
+		Stream::ViewText bufferView(_buffer);
+		if (_integerValueNegative)
+		{
+			bufferView << L'-';
+		}
+		bufferView << _integerValueMagnitude;
+		if (_integerValueStreamPosAtStart)
+		{
+			_buffer.SetStreamPos(0);
+		}
+	}
 	return _buffer;
 }
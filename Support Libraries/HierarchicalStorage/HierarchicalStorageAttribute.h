@@ -1,18 +1,24 @@
 #ifndef __HIERARCHICALSTORAGEATTRIBUTE_H__
 #define __HIERARCHICALSTORAGEATTRIBUTE_H__
 #include "HierarchicalStorageInterface/HierarchicalStorageInterface.pkg"
+#include "HierarchicalStorageArena.h"
 #include "Stream/Stream.pkg"
 
 class HierarchicalStorageAttribute :public IHierarchicalStorageAttribute
 {
 public:
 	// Constructors
-	HierarchicalStorageAttribute();
-	explicit HierarchicalStorageAttribute(const std::wstring& name);
+	explicit HierarchicalStorageAttribute(HierarchicalStorageArena& arena);
+	HierarchicalStorageAttribute(HierarchicalStorageArena& arena, const std::wstring& name);
 
 	// Name functions
 	virtual Marshal::Ret<std::wstring> GetName() const;
 	virtual void SetName(const Marshal::In<std::wstring>& name);
+	inline const std::wstring& GetInternedName() const;
+
+	// Typed value functions
+	virtual bool GetIntegerValue(bool& negative, unsigned long long& magnitude) const;
+	virtual void SetIntegerValue(bool negative, unsigned long long magnitude);
 
 protected:
 	// Stream functions
@@ -21,8 +27,18 @@ protected:
 	virtual Stream::IStream& GetInternalStream() const;
 
 private:
-	std::wstring _name;
+	// Constants
+	static const unsigned int ValueBufferSizeIncrement = 0x40;
+
+private:
+	HierarchicalStorageArena& _arena;
+	const std::wstring* _name;
 	mutable Stream::Buffer _buffer;
+	mutable bool _integerValuePresent;
+	mutable bool _integerValueStreamPosAtStart;
+	bool _integerValueNegative;
+	unsigned long long _integerValueMagnitude;
 };
 
+#include "HierarchicalStorageAttribute.inl"
 #endif
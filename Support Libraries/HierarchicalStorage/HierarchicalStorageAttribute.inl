@@ -0,0 +1,7 @@
+//----------------------------------------------------------------------------------------------------------------------
+// Name functions
+//----------------------------------------------------------------------------------------------------------------------
+const std::wstring& HierarchicalStorageAttribute::GetInternedName() const
+{
+	return *_name;
+}
@@ -0,0 +1,456 @@
+#include "HierarchicalStorageBinaryFormat.h"
+
+//----------------------------------------------------------------------------------------------------------------------
+// Constructors
+//----------------------------------------------------------------------------------------------------------------------
+HierarchicalStorageBinaryFormat::HierarchicalStorageBinaryFormat()
+:_data(0), _pos(0), _end(0)
+{}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Format detection functions
+//----------------------------------------------------------------------------------------------------------------------
+bool HierarchicalStorageBinaryFormat::IsBinaryFormat(const unsigned char* data, size_t dataSize)
+{
+	return (dataSize >= HeaderSize) && (data[0] == 'E') && (data[1] == 'X') && (data[2] == 'H') && (data[3] == 'S');
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Save/Load functions
+//----------------------------------------------------------------------------------------------------------------------
+void HierarchicalStorageBinaryFormat::Save(HierarchicalStorageNode& rootNode, std::vector<unsigned char>& buffer)
+{
+	// Reserve space for the header, and write out the node data for the entire tree.
+	// Strings are collected into the string table as they're encountered.
+	_strings.clear();
+	_stringLookup.clear();
+	_internedStringLookup.clear();
+	buffer.clear();
+	buffer.reserve(0x10000);
+	buffer.resize(HeaderSize, 0);
+	WriteVarInt(buffer, GetInternedStringIndex(rootNode.GetInternedName()));
+	SaveNode(rootNode, buffer);
+
+	// Write the string table. Each string is stored as a length followed by a sequence
+	// of little-endian UTF-16 code units.
+	unsigned long long stringTableOffset = (unsigned long long)buffer.size();
+	WriteVarInt(buffer, _strings.size());
+	for (size_t stringIndex = 0; stringIndex < _strings.size(); ++stringIndex)
+	{
+		const std::wstring& text = _strings[stringIndex];
+		WriteVarInt(buffer, text.size());
+		size_t bufferPos = buffer.size();
+		buffer.resize(bufferPos + (text.size() * 2));
+		for (size_t i = 0; i < text.size(); ++i)
+		{
+			buffer[bufferPos++] = (unsigned char)((unsigned int)text[i] & 0xFF);
+			buffer[bufferPos++] = (unsigned char)(((unsigned int)text[i] >> 8) & 0xFF);
+		}
+	}
+
+	// Fill in the header
+	buffer[0] = 'E';
+	buffer[1] = 'X';
+	buffer[2] = 'H';
+	buffer[3] = 'S';
+	for (unsigned int i = 0; i < 4; ++i)
+	{
+		buffer[4 + i] = (unsigned char)((FormatVersion >> (i * 8)) & 0xFF);
+	}
+	for (unsigned int i = 0; i < 8; ++i)
+	{
+		buffer[8 + i] = (unsigned char)((stringTableOffset >> (i * 8)) & 0xFF);
+	}
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void HierarchicalStorageBinaryFormat::SaveNode(HierarchicalStorageNode& node, std::vector<unsigned char>& buffer)
+{
+	// Determine the content present in this node
+	bool binaryDataPresent = node.GetBinaryDataPresent();
+	std::wstring data;
+	if (!binaryDataPresent)
+	{
+		data = node.GetData();
+	}
+	unsigned int flags = 0;
+	flags |= (!data.empty()) ? NodeFlagTextData : 0;
+	flags |= (binaryDataPresent) ? NodeFlagBinaryData : 0;
+	flags |= (binaryDataPresent && node.GetInlineBinaryDataEnabled()) ? NodeFlagInlineBinaryData : 0;
+	WriteVarInt(buffer, flags);
+
+	// Write attributes. Attribute values which are held as integers are written directly
+	// in binary form. Text values which are canonical decimal integers are also stored in
+	// binary form, with all other values stored as a reference to the string table.
+	size_t attributeCount = node.GetAttributeCount();
+	WriteVarInt(buffer, attributeCount);
+	for (size_t i = 0; i < attributeCount; ++i)
+	{
+		HierarchicalStorageAttribute& attribute = node.GetAttributeByIndex(i);
+		WriteVarInt(buffer, GetInternedStringIndex(attribute.GetInternedName()));
+		bool negative;
+		unsigned long long magnitude;
+		if (attribute.GetIntegerValue(negative, magnitude))
+		{
+			buffer.push_back((unsigned char)(negative ? ValueType::NegativeInteger : ValueType::UnsignedInteger));
+			WriteVarInt(buffer, magnitude);
+			continue;
+		}
+		std::wstring value = attribute.GetValue();
+		if (ParseCanonicalInteger(value, negative, magnitude))
+		{
+			buffer.push_back((unsigned char)(negative ? ValueType::NegativeInteger : ValueType::UnsignedInteger));
+			WriteVarInt(buffer, magnitude);
+		}
+		else
+		{
+			buffer.push_back((unsigned char)ValueType::String);
+			WriteVarInt(buffer, GetStringIndex(value));
+		}
+	}
+
+	// Write data
+	if ((flags & NodeFlagTextData) != 0)
+	{
+		WriteVarInt(buffer, GetStringIndex(data));
+	}
+	if (binaryDataPresent)
+	{
+		// Write the binary data buffer name and size, then pad the output buffer so that
+		// the payload begins on an aligned boundary, and copy the binary data directly
+		// from the node into the output buffer.
+		WriteVarInt(buffer, GetStringIndex(node.GetBinaryDataBufferName()));
+		Stream::IStream& binaryDataStream = node.GetBinaryDataBufferStream();
+		size_t binaryDataSize = (size_t)binaryDataStream.Size();
+		WriteVarInt(buffer, binaryDataSize);
+		size_t payloadPos = (buffer.size() + (BinaryDataAlignment - 1)) & ~(BinaryDataAlignment - 1);
+		buffer.resize(payloadPos + binaryDataSize, 0);
+		if (binaryDataSize > 0)
+		{
+			binaryDataStream.SetStreamPos(0);
+			binaryDataStream.ReadData(&buffer[payloadPos], (Stream::IStream::SizeType)binaryDataSize);
+			binaryDataStream.SetStreamPos(0);
+		}
+	}
+
+	// Write child nodes
+	size_t childCount = node.GetChildCount();
+	WriteVarInt(buffer, childCount);
+	for (size_t i = 0; i < childCount; ++i)
+	{
+		HierarchicalStorageNode& childNode = node.GetChildByIndex(i);
+		WriteVarInt(buffer, GetInternedStringIndex(childNode.GetInternedName()));
+		SaveNode(childNode, buffer);
+	}
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+unsigned int HierarchicalStorageBinaryFormat::GetStringIndex(const std::wstring& text)
+{
+	std::map<std::wstring, unsigned int>::const_iterator stringLookupIterator = _stringLookup.find(text);
+	if (stringLookupIterator != _stringLookup.end())
+	{
+		return stringLookupIterator->second;
+	}
+	unsigned int stringIndex = (unsigned int)_strings.size();
+	_strings.push_back(text);
+	_stringLookup.insert(std::pair<std::wstring, unsigned int>(text, stringIndex));
+	return stringIndex;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+unsigned int HierarchicalStorageBinaryFormat::GetInternedStringIndex(const std::wstring& internedText)
+{
+	// Node and attribute names are interned by the tree, so we can avoid a string
+	// comparison for all but the first occurrence of each name by looking up the address
+	// of the interned string.
+	std::map<const std::wstring*, unsigned int>::const_iterator internedStringLookupIterator = _internedStringLookup.find(&internedText);
+	if (internedStringLookupIterator != _internedStringLookup.end())
+	{
+		return internedStringLookupIterator->second;
+	}
+	unsigned int stringIndex = GetStringIndex(internedText);
+	_internedStringLookup.insert(std::pair<const std::wstring*, unsigned int>(&internedText, stringIndex));
+	return stringIndex;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void HierarchicalStorageBinaryFormat::WriteVarInt(std::vector<unsigned char>& buffer, unsigned long long data)
+{
+	while (data >= 0x80)
+	{
+		buffer.push_back((unsigned char)((data & 0x7F) | 0x80));
+		data >>= 7;
+	}
+	buffer.push_back((unsigned char)data);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool HierarchicalStorageBinaryFormat::ParseCanonicalInteger(const std::wstring& text, bool& negative, unsigned long long& magnitude)
+{
+	// Only accept values which will be reproduced exactly when converted back to text.
+	// This excludes leading zeros, a negative zero, and values which may exceed the range
+	// of a 64-bit integer.
+	size_t pos = 0;
+	negative = (!text.empty() && (text[0] == L'-'));
+	pos += (negative) ? 1 : 0;
+	size_t digitCount = text.size() - pos;
+	if ((digitCount == 0) || (digitCount > 19) || ((text[pos] == L'0') && (negative || (digitCount > 1))))
+	{
+		return false;
+	}
+	magnitude = 0;
+	while (pos < text.size())
+	{
+		wchar_t character = text[pos++];
+		if ((character < L'0') || (character > L'9'))
+		{
+			return false;
+		}
+		magnitude = (magnitude * 10) + (unsigned long long)(character - L'0');
+	}
+	return true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool HierarchicalStorageBinaryFormat::Load(HierarchicalStorageNode& rootNode, const unsigned char* data, size_t dataSize)
+{
+	// Validate the header
+	if (!IsBinaryFormat(data, dataSize))
+	{
+		return SetError(L"Invalid binary storage header");
+	}
+	unsigned int formatVersion = 0;
+	for (unsigned int i = 0; i < 4; ++i)
+	{
+		formatVersion |= (unsigned int)data[4 + i] << (i * 8);
+	}
+	if (formatVersion != FormatVersion)
+	{
+		return SetError(L"Unsupported binary storage format version");
+	}
+	unsigned long long stringTableOffset = 0;
+	for (unsigned int i = 0; i < 8; ++i)
+	{
+		stringTableOffset |= (unsigned long long)data[8 + i] << (i * 8);
+	}
+	if ((stringTableOffset < HeaderSize) || (stringTableOffset > (unsigned long long)dataSize))
+	{
+		return SetError(L"Invalid string table offset");
+	}
+
+	// Load the string table
+	_data = data;
+	_pos = (size_t)stringTableOffset;
+	_end = dataSize;
+	if (!LoadStringTable())
+	{
+		return false;
+	}
+
+	// Load the node data
+	_pos = HeaderSize;
+	_end = (size_t)stringTableOffset;
+	const std::wstring* rootNodeName;
+	if (!ReadString(rootNodeName))
+	{
+		return false;
+	}
+	rootNode.SetName(*rootNodeName);
+	return LoadNodeContent(rootNode, 0);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool HierarchicalStorageBinaryFormat::LoadStringTable()
+{
+	_strings.clear();
+	size_t stringCount;
+	if (!ReadCount(stringCount))
+	{
+		return SetError(L"Invalid string table");
+	}
+	_strings.resize(stringCount);
+	for (size_t stringIndex = 0; stringIndex < stringCount; ++stringIndex)
+	{
+		unsigned long long length;
+		if (!ReadVarInt(length) || (length > ((_end - _pos) / 2)))
+		{
+			return SetError(L"Invalid string table");
+		}
+		std::wstring& text = _strings[stringIndex];
+		text.resize((size_t)length);
+		for (size_t i = 0; i < text.size(); ++i)
+		{
+			text[i] = (wchar_t)((unsigned int)_data[_pos] | ((unsigned int)_data[_pos + 1] << 8));
+			_pos += 2;
+		}
+	}
+	return true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool HierarchicalStorageBinaryFormat::LoadNodeContent(HierarchicalStorageNode& node, unsigned int depth)
+{
+	if (depth > MaxNodeDepth)
+	{
+		return SetError(L"Maximum node depth exceeded");
+	}
+
+	// Load attributes
+	unsigned long long flags;
+	size_t attributeCount;
+	if (!ReadVarInt(flags) || !ReadCount(attributeCount))
+	{
+		return SetError(L"Unexpected end of node data");
+	}
+	for (size_t i = 0; i < attributeCount; ++i)
+	{
+		const std::wstring* attributeName;
+		if (!ReadString(attributeName) || (_pos >= _end))
+		{
+			return SetError(L"Invalid attribute data");
+		}
+		ValueType valueType = (ValueType)_data[_pos++];
+		HierarchicalStorageAttribute& attribute = node.CreateAttributeFromBuffer(attributeName->c_str(), attributeName->size());
+		if (valueType == ValueType::String)
+		{
+			const std::wstring* value;
+			if (!ReadString(value))
+			{
+				return SetError(L"Invalid attribute data");
+			}
+			attribute.SetValue(*value);
+		}
+		else if ((valueType == ValueType::UnsignedInteger) || (valueType == ValueType::NegativeInteger))
+		{
+			unsigned long long magnitude;
+			if (!ReadVarInt(magnitude))
+			{
+				return SetError(L"Invalid attribute data");
+			}
+			attribute.SetIntegerValue((valueType == ValueType::NegativeInteger), magnitude);
+		}
+		else
+		{
+			return SetError(L"Invalid attribute value type");
+		}
+	}
+
+	// Load data
+	if ((flags & NodeFlagTextData) != 0)
+	{
+		const std::wstring* data;
+		if (!ReadString(data))
+		{
+			return SetError(L"Invalid node data");
+		}
+		node.SetData(*data);
+	}
+	if ((flags & NodeFlagBinaryData) != 0)
+	{
+		const std::wstring* bufferName;
+		size_t binaryDataSize;
+		if (!ReadString(bufferName) || !ReadCount(binaryDataSize))
+		{
+			return SetError(L"Invalid binary data");
+		}
+		size_t payloadPos = (_pos + (BinaryDataAlignment - 1)) & ~(BinaryDataAlignment - 1);
+		if ((payloadPos > _end) || (binaryDataSize > (_end - payloadPos)))
+		{
+			return SetError(L"Invalid binary data");
+		}
+		node.SetBinaryDataPresent(true);
+		node.SetInlineBinaryDataEnabled((flags & NodeFlagInlineBinaryData) != 0);
+		node.SetBinaryDataBufferName(*bufferName);
+		if (binaryDataSize > 0)
+		{
+			node.GetBinaryDataBufferStream().WriteData(&_data[payloadPos], (Stream::IStream::SizeType)binaryDataSize);
+		}
+		_pos = payloadPos + binaryDataSize;
+	}
+
+	// Load child nodes
+	size_t childCount;
+	if (!ReadCount(childCount))
+	{
+		return SetError(L"Unexpected end of node data");
+	}
+	for (size_t i = 0; i < childCount; ++i)
+	{
+		const std::wstring* childName;
+		if (!ReadString(childName))
+		{
+			return SetError(L"Invalid child node data");
+		}
+		HierarchicalStorageNode& childNode = node.CreateChildFromBuffer(childName->c_str(), childName->size());
+		if (!LoadNodeContent(childNode, depth + 1))
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool HierarchicalStorageBinaryFormat::ReadVarInt(unsigned long long& data)
+{
+	data = 0;
+	unsigned int shift = 0;
+	while (_pos < _end)
+	{
+		unsigned char byte = _data[_pos++];
+		data |= (unsigned long long)(byte & 0x7F) << shift;
+		if ((byte & 0x80) == 0)
+		{
+			return true;
+		}
+		shift += 7;
+		if (shift >= 64)
+		{
+			return false;
+		}
+	}
+	return false;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool HierarchicalStorageBinaryFormat::ReadCount(size_t& count)
+{
+	// Every counted item occupies at least one byte, so any count larger than the
+	// remaining data is invalid. Rejecting it here prevents a corrupt file from triggering
+	// a huge allocation.
+	unsigned long long data;
+	if (!ReadVarInt(data) || (data > (unsigned long long)(_end - _pos)))
+	{
+		return false;
+	}
+	count = (size_t)data;
+	return true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool HierarchicalStorageBinaryFormat::ReadString(const std::wstring*& text)
+{
+	unsigned long long stringIndex;
+	if (!ReadVarInt(stringIndex) || (stringIndex >= (unsigned long long)_strings.size()))
+	{
+		return false;
+	}
+	text = &_strings[(size_t)stringIndex];
+	return true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Error handling functions
+//----------------------------------------------------------------------------------------------------------------------
+std::wstring HierarchicalStorageBinaryFormat::GetErrorString() const
+{
+	return _errorString;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool HierarchicalStorageBinaryFormat::SetError(const std::wstring& errorMessage)
+{
+	_errorString = errorMessage;
+	return false;
+}
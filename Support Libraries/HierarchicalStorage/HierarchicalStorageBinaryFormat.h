@@ -0,0 +1,74 @@
+#ifndef __HIERARCHICALSTORAGEBINARYFORMAT_H__
+#define __HIERARCHICALSTORAGEBINARYFORMAT_H__
+#include "HierarchicalStorageNode.h"
+#include <string>
+#include <vector>
+#include <map>
+
+// This class implements the compact binary serialization format for hierarchical storage
+// trees. The format consists of a fixed size header, followed by the node data, followed
+// by a table of all the strings referenced by the node data. All integer values are
+// stored as variable length unsigned integers, attribute values which hold integers are
+// stored in binary form rather than as text, and binary data payloads are stored inline,
+// aligned to a 16-byte boundary from the start of the data. Integer attribute values are
+// loaded back into the attribute in binary form, so they're never formatted as text unless
+// the value is later read as text.
+class HierarchicalStorageBinaryFormat
+{
+public:
+	// Constructors
+	HierarchicalStorageBinaryFormat();
+
+	// Format detection functions
+	static bool IsBinaryFormat(const unsigned char* data, size_t dataSize);
+
+	// Save/Load functions
+	void Save(HierarchicalStorageNode& rootNode, std::vector<unsigned char>& buffer);
+	bool Load(HierarchicalStorageNode& rootNode, const unsigned char* data, size_t dataSize);
+
+	// Error handling functions
+	std::wstring GetErrorString() const;
+
+private:
+	// Enumerations
+	enum class ValueType;
+
+	// Constants
+	static const unsigned int FormatVersion = 1;
+	static const size_t HeaderSize = 16;
+	static const size_t BinaryDataAlignment = 16;
+	static const unsigned int MaxNodeDepth = 0x400;
+	static const unsigned int NodeFlagTextData = 0x01;
+	static const unsigned int NodeFlagBinaryData = 0x02;
+	static const unsigned int NodeFlagInlineBinaryData = 0x04;
+
+private:
+	// Save functions
+	void SaveNode(HierarchicalStorageNode& node, std::vector<unsigned char>& buffer);
+	unsigned int GetStringIndex(const std::wstring& text);
+	unsigned int GetInternedStringIndex(const std::wstring& internedText);
+	static void WriteVarInt(std::vector<unsigned char>& buffer, unsigned long long data);
+	static bool ParseCanonicalInteger(const std::wstring& text, bool& negative, unsigned long long& magnitude);
+
+	// Load functions
+	bool LoadStringTable();
+	bool LoadNodeContent(HierarchicalStorageNode& node, unsigned int depth);
+	bool ReadVarInt(unsigned long long& data);
+	bool ReadCount(size_t& count);
+	bool ReadString(const std::wstring*& text);
+
+	// Error handling functions
+	bool SetError(const std::wstring& errorMessage);
+
+private:
+	std::wstring _errorString;
+	std::vector<std::wstring> _strings;
+	std::map<std::wstring, unsigned int> _stringLookup;
+	std::map<const std::wstring*, unsigned int> _internedStringLookup;
+	const unsigned char* _data;
+	size_t _pos;
+	size_t _end;
+};
+
+#include "HierarchicalStorageBinaryFormat.inl"
+#endif
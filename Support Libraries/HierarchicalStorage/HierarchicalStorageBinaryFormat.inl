@@ -0,0 +1,9 @@
+//----------------------------------------------------------------------------------------------------------------------
+// Enumerations
+//----------------------------------------------------------------------------------------------------------------------
+enum class HierarchicalStorageBinaryFormat::ValueType
+{
+	String = 0,
+	UnsignedInteger = 1,
+	NegativeInteger = 2
+};
@@ -1,15 +1,16 @@
 #include "HierarchicalStorageNode.h"
+#include <new>
 
 //----------------------------------------------------------------------------------------------------------------------
 // Constructors
 //----------------------------------------------------------------------------------------------------------------------
-HierarchicalStorageNode::HierarchicalStorageNode()
-:_parent(0), _binaryDataPresent(false), _inlineBinaryData(false), _dataStream(Stream::IStream::TextEncoding::UTF16, Stream::IStream::NewLineEncoding::Unix, Stream::IStream::ByteOrder::BigEndian, 0)
+HierarchicalStorageNode::HierarchicalStorageNode(HierarchicalStorageArena& arena)
+:_arena(arena), _name(&arena.InternName(L"")), _parent(0), _binaryDataPresent(false), _inlineBinaryData(false), _dataStream(Stream::IStream::TextEncoding::UTF16, Stream::IStream::NewLineEncoding::Unix, Stream::IStream::ByteOrder::BigEndian, 0)
 { }
 
 //----------------------------------------------------------------------------------------------------------------------
-HierarchicalStorageNode::HierarchicalStorageNode(const std::wstring& name)
-:_name(name), _parent(0), _binaryDataPresent(false), _inlineBinaryData(false), _dataStream(Stream::IStream::TextEncoding::UTF16, Stream::IStream::NewLineEncoding::Unix, Stream::IStream::ByteOrder::BigEndian, 0)
+HierarchicalStorageNode::HierarchicalStorageNode(HierarchicalStorageArena& arena, const std::wstring& name)
+:_arena(arena), _name(&arena.InternName(name)), _parent(0), _binaryDataPresent(false), _inlineBinaryData(false), _dataStream(Stream::IStream::TextEncoding::UTF16, Stream::IStream::NewLineEncoding::Unix, Stream::IStream::ByteOrder::BigEndian, 0)
 { }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -23,11 +24,11 @@ void HierarchicalStorageNode::Initialize()
 {
 	for (ChildList::iterator i = _children.begin(); i != _children.end(); ++i)
 	{
-		delete *i;
+		DestroyChild(*i);
 	}
 	for (AttributeList::iterator i = _attributes.begin(); i != _attributes.end(); ++i)
 	{
-		delete i->second;
+		DestroyAttribute(*i);
 	}
 	_children.clear();
 	_attributes.clear();
@@ -40,13 +41,13 @@ void HierarchicalStorageNode::Initialize()
 //----------------------------------------------------------------------------------------------------------------------
 Marshal::Ret<std::wstring> HierarchicalStorageNode::GetName() const
 {
-	return _name;
+	return *_name;
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 void HierarchicalStorageNode::SetName(const Marshal::In<std::wstring>& name)
 {
-	_name = name;
+	_name = &_arena.InternName(name.Get());
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -90,21 +91,39 @@ Stream::IStream& HierarchicalStorageNode::GetInternalStream() const
 //----------------------------------------------------------------------------------------------------------------------
 IHierarchicalStorageNode& HierarchicalStorageNode::CreateChild()
 {
-	HierarchicalStorageNode* child = new HierarchicalStorageNode();
-	child->SetParent(this);
-	_children.push_back(child);
-	return *child;
+	return AllocateChild(_arena.InternName(L""));
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 IHierarchicalStorageNode& HierarchicalStorageNode::CreateChild(const Marshal::In<std::wstring>& name)
 {
-	HierarchicalStorageNode* child = new HierarchicalStorageNode(name);
+	return AllocateChild(_arena.InternName(name.Get()));
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+HierarchicalStorageNode& HierarchicalStorageNode::CreateChildFromBuffer(const wchar_t* name, size_t nameLength)
+{
+	return AllocateChild(_arena.InternName(name, nameLength));
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+HierarchicalStorageNode& HierarchicalStorageNode::AllocateChild(const std::wstring& internedName)
+{
+	HierarchicalStorageNode* child = new(_arena.Allocate(sizeof(HierarchicalStorageNode))) HierarchicalStorageNode(_arena, internedName);
 	child->SetParent(this);
 	_children.push_back(child);
 	return *child;
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+void HierarchicalStorageNode::DestroyChild(HierarchicalStorageNode* node)
+{
+	// Child nodes are allocated from the arena, so after running the destructor we return
+	// the memory to the arena to be reused by later allocations.
+	node->~HierarchicalStorageNode();
+	_arena.Free(node, sizeof(HierarchicalStorageNode));
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 void HierarchicalStorageNode::DeleteChild(IHierarchicalStorageNode& node)
 {
@@ -113,7 +132,9 @@ void HierarchicalStorageNode::DeleteChild(IHierarchicalStorageNode& node)
 	{
 		if (*childListIterator == &node)
 		{
+			HierarchicalStorageNode* child = *childListIterator;
 			_children.erase(childListIterator);
+			DestroyChild(child);
 			return;
 		}
 		++childListIterator;
@@ -138,7 +159,7 @@ bool HierarchicalStorageNode::IsChildPresent(const Marshal::In<std::wstring>& na
 	for (ChildList::const_iterator i = _children.begin(); i != _children.end(); ++i)
 	{
 		HierarchicalStorageNode* childNode = *i;
-		if (childNode->GetName() == nameResolved)
+		if (*childNode->_name == nameResolved)
 		{
 			return true;
 		}
@@ -154,7 +175,7 @@ IHierarchicalStorageNode* HierarchicalStorageNode::GetChild(const Marshal::In<st
 	for (ChildList::const_iterator i = _children.begin(); i != _children.end(); ++i)
 	{
 		HierarchicalStorageNode* childNode = *i;
-		if (foundSearchStartNode && (childNode->GetName() == nameResolved))
+		if (foundSearchStartNode && (*childNode->_name == nameResolved))
 		{
 			return childNode;
 		}
@@ -171,7 +192,7 @@ bool HierarchicalStorageNode::IsAttributePresent(const Marshal::In<std::wstring>
 	std::wstring nameResolved = name.Get();
 	for (AttributeList::const_iterator i = _attributes.begin(); i != _attributes.end(); ++i)
 	{
-		if (i->first == nameResolved)
+		if ((*i)->GetInternedName() == nameResolved)
 		{
 			return true;
 		}
@@ -185,9 +206,9 @@ IHierarchicalStorageAttribute* HierarchicalStorageNode::GetAttribute(const Marsh
 	std::wstring nameResolved = name.Get();
 	for (AttributeList::const_iterator i = _attributes.begin(); i != _attributes.end(); ++i)
 	{
-		if (i->first == nameResolved)
+		if ((*i)->GetInternedName() == nameResolved)
 		{
-			return i->second;
+			return *i;
 		}
 	}
 	return 0;
@@ -199,24 +220,56 @@ IHierarchicalStorageAttribute& HierarchicalStorageNode::CreateAttribute(const Ma
 	IHierarchicalStorageAttribute* attribute = GetAttribute(name);
 	if (attribute == 0)
 	{
-		HierarchicalStorageAttribute* newAttribute = new HierarchicalStorageAttribute(name);
-		attribute = newAttribute;
-		_attributes.push_back(AttributeListEntry(name, newAttribute));
+		attribute = &AllocateAttribute(_arena.InternName(name.Get()));
 	}
 	return *attribute;
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+HierarchicalStorageAttribute& HierarchicalStorageNode::CreateAttributeFromBuffer(const wchar_t* name, size_t nameLength)
+{
+	// Since attribute names are interned, we can identify any existing attribute with the
+	// same name by comparing the name pointers alone.
+	const std::wstring& internedName = _arena.InternName(name, nameLength);
+	for (AttributeList::const_iterator i = _attributes.begin(); i != _attributes.end(); ++i)
+	{
+		if (&(*i)->GetInternedName() == &internedName)
+		{
+			return *(*i);
+		}
+	}
+	return AllocateAttribute(internedName);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+HierarchicalStorageAttribute& HierarchicalStorageNode::AllocateAttribute(const std::wstring& internedName)
+{
+	HierarchicalStorageAttribute* attribute = new(_arena.Allocate(sizeof(HierarchicalStorageAttribute))) HierarchicalStorageAttribute(_arena, internedName);
+	_attributes.push_back(attribute);
+	return *attribute;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void HierarchicalStorageNode::DestroyAttribute(HierarchicalStorageAttribute* attribute)
+{
+	attribute->~HierarchicalStorageAttribute();
+	_arena.Free(attribute, sizeof(HierarchicalStorageAttribute));
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 void HierarchicalStorageNode::DeleteAttribute(IHierarchicalStorageAttribute& attribute)
 {
 	AttributeList::iterator attributeIterator = _attributes.begin();
 	while (attributeIterator != _attributes.end())
 	{
-		if (attributeIterator->second == &attribute)
+		if (*attributeIterator == &attribute)
 		{
+			HierarchicalStorageAttribute* targetAttribute = *attributeIterator;
 			_attributes.erase(attributeIterator);
+			DestroyAttribute(targetAttribute);
 			return;
 		}
+		++attributeIterator;
 	}
 }
 
@@ -226,7 +279,7 @@ Marshal::Ret<std::list<IHierarchicalStorageAttribute*>> HierarchicalStorageNode:
 	std::list<IHierarchicalStorageAttribute*> attributeList;
 	for (size_t i = 0; i < _attributes.size(); ++i)
 	{
-		attributeList.push_back(_attributes[i].second);
+		attributeList.push_back(_attributes[i]);
 	}
 	return attributeList;
 }
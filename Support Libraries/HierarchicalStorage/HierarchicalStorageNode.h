@@ -2,6 +2,7 @@
 #define __HIERARCHICALSTORAGENODE_H__
 #include "HierarchicalStorageInterface/HierarchicalStorageInterface.pkg"
 #include "HierarchicalStorageAttribute.h"
+#include "HierarchicalStorageArena.h"
 #include "Stream/Stream.pkg"
 #include <vector>
 #include <map>
@@ -11,14 +12,15 @@ class HierarchicalStorageNode :public IHierarchicalStorageNode
 {
 public:
 	// Constructors
-	HierarchicalStorageNode();
-	explicit HierarchicalStorageNode(const std::wstring& name);
+	explicit HierarchicalStorageNode(HierarchicalStorageArena& arena);
+	HierarchicalStorageNode(HierarchicalStorageArena& arena, const std::wstring& name);
 	~HierarchicalStorageNode();
 	void Initialize();
 
 	// Name functions
 	virtual Marshal::Ret<std::wstring> GetName() const;
 	virtual void SetName(const Marshal::In<std::wstring>& name);
+	inline const std::wstring& GetInternedName() const;
 
 	// Parent functions
 	virtual IHierarchicalStorageNode& GetParent() const;
@@ -33,6 +35,9 @@ public:
 	virtual Marshal::Ret<std::list<IHierarchicalStorageNode*>> GetChildList() const;
 	virtual bool IsChildPresent(const Marshal::In<std::wstring>& name) const;
 	virtual IHierarchicalStorageNode* GetChild(const Marshal::In<std::wstring>& name, const IHierarchicalStorageNode* searchAfterChildNode = 0) const;
+	HierarchicalStorageNode& CreateChildFromBuffer(const wchar_t* name, size_t nameLength);
+	inline size_t GetChildCount() const;
+	inline HierarchicalStorageNode& GetChildByIndex(size_t index) const;
 
 	// Attribute functions
 	using IHierarchicalStorageNode::CreateAttribute;
@@ -41,6 +46,9 @@ public:
 	virtual IHierarchicalStorageAttribute& CreateAttribute(const Marshal::In<std::wstring>& name);
 	virtual void DeleteAttribute(IHierarchicalStorageAttribute& attribute);
 	virtual Marshal::Ret<std::list<IHierarchicalStorageAttribute*>> GetAttributeList() const;
+	HierarchicalStorageAttribute& CreateAttributeFromBuffer(const wchar_t* name, size_t nameLength);
+	inline size_t GetAttributeCount() const;
+	inline HierarchicalStorageAttribute& GetAttributeByIndex(size_t index) const;
 
 	// Binary data functions
 	virtual bool GetBinaryDataPresent() const;
@@ -64,16 +72,24 @@ private:
 	// Parent functions
 	void SetParent(HierarchicalStorageNode* parent);
 
+	// Child functions
+	HierarchicalStorageNode& AllocateChild(const std::wstring& internedName);
+	void DestroyChild(HierarchicalStorageNode* node);
+
+	// Attribute functions
+	HierarchicalStorageAttribute& AllocateAttribute(const std::wstring& internedName);
+	void DestroyAttribute(HierarchicalStorageAttribute* attribute);
+
 private:
 	// Typedefs
 	typedef std::vector<HierarchicalStorageNode*> ChildList;
-	typedef std::pair<std::wstring, HierarchicalStorageAttribute*> AttributeListEntry;
 	// Note that this is a vector rather than a map, so that we can preserve the explicit
 	// ordering of attributes.
-	typedef std::vector<AttributeListEntry> AttributeList;
+	typedef std::vector<HierarchicalStorageAttribute*> AttributeList;
 
 private:
-	std::wstring _name;
+	HierarchicalStorageArena& _arena;
+	const std::wstring* _name;
 	HierarchicalStorageNode* _parent;
 	ChildList _children;
 	AttributeList _attributes;
@@ -83,4 +99,5 @@ private:
 	mutable Stream::Buffer _dataStream;
 };
 
+#include "HierarchicalStorageNode.inl"
 #endif
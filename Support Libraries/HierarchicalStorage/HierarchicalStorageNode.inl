@@ -0,0 +1,35 @@
+//----------------------------------------------------------------------------------------------------------------------
+// Name functions
+//----------------------------------------------------------------------------------------------------------------------
+const std::wstring& HierarchicalStorageNode::GetInternedName() const
+{
+	return *_name;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Child functions
+//----------------------------------------------------------------------------------------------------------------------
+size_t HierarchicalStorageNode::GetChildCount() const
+{
+	return _children.size();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+HierarchicalStorageNode& HierarchicalStorageNode::GetChildByIndex(size_t index) const
+{
+	return *_children[index];
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Attribute functions
+//----------------------------------------------------------------------------------------------------------------------
+size_t HierarchicalStorageNode::GetAttributeCount() const
+{
+	return _attributes.size();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+HierarchicalStorageAttribute& HierarchicalStorageNode::GetAttributeByIndex(size_t index) const
+{
+	return *_attributes[index];
+}
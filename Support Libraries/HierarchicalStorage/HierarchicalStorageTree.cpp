@@ -1,13 +1,14 @@
 #include "HierarchicalStorageTree.h"
-#include <sstream>
+#include "HierarchicalStorageXMLParser.h"
+#include "HierarchicalStorageBinaryFormat.h"
 
 //----------------------------------------------------------------------------------------------------------------------
 // Constructors
 //----------------------------------------------------------------------------------------------------------------------
 HierarchicalStorageTree::HierarchicalStorageTree()
-:_allowSeparateBinaryData(true), _storageMode(StorageMode::XML)
+:_allowSeparateBinaryData(true), _storageMode(StorageMode::XML), _binaryDataInline(false)
 {
-	_root = new HierarchicalStorageNode();
+	_root = new HierarchicalStorageNode(_arena);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -27,121 +28,200 @@ void HierarchicalStorageTree::Initialize()
 //----------------------------------------------------------------------------------------------------------------------
 bool HierarchicalStorageTree::SaveTree(Stream::IStream& target)
 {
-	return SaveNode(*_root, target, L"");
+	// If the tree is being saved in binary form, serialize the tree into a single
+	// buffer, and write it to the target stream in one operation.
+	_binaryDataInline = (_storageMode == StorageMode::Binary);
+	if (_storageMode == StorageMode::Binary)
+	{
+		std::vector<unsigned char> buffer;
+		HierarchicalStorageBinaryFormat binaryFormat;
+		binaryFormat.Save(*_root, buffer);
+		return target.WriteData(&buffer[0], (Stream::IStream::SizeType)buffer.size());
+	}
+
+	// Generate the text for the entire tree into a single buffer, and write it to the
+	// target stream in one operation.
+	std::wstring buffer;
+	buffer.reserve(0x10000);
+	std::vector<unsigned char> binaryDataBuffer;
+	SaveNode(*_root, buffer, 0, binaryDataBuffer);
+
+	// Note that we include the null terminator in the buffer size here. The text write
+	// functions report a failure if they reach the end of the buffer without finding the
+	// terminator, even if all the text was written successfully.
+	return target.WriteText(buffer.c_str(), (Stream::IStream::SizeType)buffer.size() + 1);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 bool HierarchicalStorageTree::LoadTree(Stream::IStream& source)
 {
-	// Load the contents of the source stream into a buffer of unicode characters
-	std::wstring buffer;
-	Stream::ViewText view(source);
-	if (!view.ReadTextString(buffer, false))
+	// Calculate the amount of data remaining in the source stream
+	Stream::IStream::SizeType streamPos = source.GetStreamPos();
+	Stream::IStream::SizeType streamSize = source.Size();
+	if (streamPos >= streamSize)
 	{
 		return false;
 	}
-	if (buffer.empty())
+	size_t dataSize = (size_t)(streamSize - streamPos);
+
+	// If the source stream is an in-memory buffer, parse the data directly from the
+	// buffer, otherwise read the remaining data from the stream into memory in a single
+	// operation.
+	Stream::Buffer* sourceBuffer = dynamic_cast<Stream::Buffer*>(&source);
+	if (sourceBuffer != 0)
+	{
+		sourceBuffer->SetStreamPos(streamSize);
+		return LoadTree(sourceBuffer->GetRawBuffer() + streamPos, dataSize, source.GetTextEncoding(), source.GetByteOrder());
+	}
+	std::vector<unsigned char> data(dataSize);
+	if (!source.ReadData(&data[0], (Stream::IStream::SizeType)dataSize))
 	{
 		return false;
 	}
+	return LoadTree(&data[0], dataSize, source.GetTextEncoding(), source.GetByteOrder());
+}
 
-	// Create a new expat XML parser
-	XML_Parser parser = XML_ParserCreate(NULL);
-	if (parser == 0)
+//----------------------------------------------------------------------------------------------------------------------
+bool HierarchicalStorageTree::LoadTree(const unsigned char* data, size_t dataSize, Stream::IStream::TextEncoding textEncoding, Stream::IStream::ByteOrder byteOrder)
+{
+	// If the source data is in our binary storage format, load it directly. The binary
+	// format is independent of the text encoding and byte order of the source stream. Note
+	// that the format of the source data doesn't change the storage mode of the tree, so a
+	// caller which selected a storage mode keeps it when the tree is saved again.
+	_binaryDataInline = HierarchicalStorageBinaryFormat::IsBinaryFormat(data, dataSize);
+	if (_binaryDataInline)
 	{
-		return false;
+		HierarchicalStorageBinaryFormat binaryFormat;
+		if (!binaryFormat.Load(*_root, data, dataSize))
+		{
+			_errorString = binaryFormat.GetErrorString();
+			return false;
+		}
+		return true;
 	}
 
-	// Set our callback handlers for the parser
-	XML_SetUserData(parser, this);
-	XML_SetElementHandler(parser, LoadStartElement, LoadEndElement);
-	XML_SetCharacterDataHandler(parser, LoadData);
+	// Determine whether multi-byte text in the source data is in our native byte order
+	const unsigned short byteOrderTest = 1;
+	bool platformIsLittleEndian = (*((const unsigned char*)&byteOrderTest) == 1);
+	bool nativeByteOrder = (byteOrder == Stream::IStream::ByteOrder::Platform) || ((byteOrder == Stream::IStream::ByteOrder::LittleEndian) == platformIsLittleEndian);
 
-	// Parse the XML data
-	_currentNodeDuringLoad = 0;
-	if (XML_Parse(parser, (char*)&buffer[0], (int)(buffer.size() * sizeof(wchar_t)), 1) != XML_STATUS_OK)
+	// Parse UTF-8 and native UTF-16 data directly from the source buffer. Any other text
+	// encoding is converted to a UTF-16 string first.
+	std::wstring convertedText;
+	switch (textEncoding)
 	{
-		// If XML parsing failed, set the error string, and return false.
-		std::wstringstream errorStream;
-		errorStream << XML_ErrorString(XML_GetErrorCode(parser)) << L" at line " << XML_GetCurrentLineNumber(parser);
-		_errorString = errorStream.str();
-		XML_ParserFree(parser);
+	case Stream::IStream::TextEncoding::UTF8:
+		return LoadTreeFromText((const char*)data, dataSize);
+	case Stream::IStream::TextEncoding::ASCII:
+		convertedText.assign(data, data + dataSize);
+		break;
+	case Stream::IStream::TextEncoding::UTF16:
+		if (nativeByteOrder && (sizeof(wchar_t) == 2) && ((((size_t)data) % sizeof(wchar_t)) == 0))
+		{
+			return LoadTreeFromText((const wchar_t*)data, dataSize / sizeof(wchar_t));
+		}
+		convertedText.resize(dataSize / 2);
+		for (size_t i = 0; i < convertedText.size(); ++i)
+		{
+			unsigned int firstByte = data[(i * 2) + 0];
+			unsigned int secondByte = data[(i * 2) + 1];
+			convertedText[i] = (wchar_t)((nativeByteOrder == platformIsLittleEndian) ? ((secondByte << 8) | firstByte) : ((firstByte << 8) | secondByte));
+		}
+		break;
+	case Stream::IStream::TextEncoding::UTF32:
+		convertedText.reserve(dataSize / 4);
+		for (size_t i = 0; (i + 4) <= dataSize; i += 4)
+		{
+			bool littleEndianData = (nativeByteOrder == platformIsLittleEndian);
+			unsigned int codePoint = (littleEndianData) ? ((unsigned int)data[i + 0] | ((unsigned int)data[i + 1] << 8) | ((unsigned int)data[i + 2] << 16) | ((unsigned int)data[i + 3] << 24)) : ((unsigned int)data[i + 3] | ((unsigned int)data[i + 2] << 8) | ((unsigned int)data[i + 1] << 16) | ((unsigned int)data[i + 0] << 24));
+			if (codePoint >= 0x10000)
+			{
+				codePoint -= 0x10000;
+				convertedText.push_back((wchar_t)(0xD800 | ((codePoint >> 10) & 0x3FF)));
+				convertedText.push_back((wchar_t)(0xDC00 | (codePoint & 0x3FF)));
+			}
+			else
+			{
+				convertedText.push_back((wchar_t)codePoint);
+			}
+		}
+		break;
+	default:
 		return false;
 	}
+	if (convertedText.empty())
+	{
+		return false;
+	}
+	return LoadTreeFromText(convertedText.c_str(), convertedText.size());
+}
 
-	// Free the XML parser
-	XML_ParserFree(parser);
-
+//----------------------------------------------------------------------------------------------------------------------
+template<class CharType>
+bool HierarchicalStorageTree::LoadTreeFromText(const CharType* data, size_t length)
+{
+	if (length == 0)
+	{
+		return false;
+	}
+	HierarchicalStorageXMLParser<CharType> parser(data, length);
+	if (!parser.Parse(*_root))
+	{
+		_errorString = parser.GetErrorString();
+		return false;
+	}
 	return true;
 }
 
 //----------------------------------------------------------------------------------------------------------------------
-bool HierarchicalStorageTree::SaveNode(IHierarchicalStorageNode& node, Stream::IStream& stream, const std::wstring& indentPrefix) const
+void HierarchicalStorageTree::SaveNode(HierarchicalStorageNode& node, std::wstring& buffer, unsigned int indentLevel, std::vector<unsigned char>& binaryDataBuffer) const
 {
-	Stream::ViewText streamView(stream);
-
 	// Open key
-	streamView << indentPrefix << L'<' << node.GetName();
+	buffer.append(indentLevel, L'\t');
+	buffer.push_back(L'<');
+	buffer.append(node.GetInternedName());
 
 	// Write attributes
-	std::list<IHierarchicalStorageAttribute*> attributeList = node.GetAttributeList();
-	for (std::list<IHierarchicalStorageAttribute*>::const_iterator i = attributeList.begin(); i != attributeList.end(); ++i)
+	for (size_t i = 0; i < node.GetAttributeCount(); ++i)
 	{
-		std::wstring name = (*i)->GetName();
-		std::wstring value = (*i)->GetValue();
-		std::wstring finalValue;
-		for (unsigned int valuePos = 0; valuePos < value.length(); ++valuePos)
-		{
-			if (IsCharacterReserved(value[valuePos]))
-			{
-				finalValue += GetNumericCharacterReference(value[valuePos]);
-			}
-			else
-			{
-				finalValue.push_back(value[valuePos]);
-			}
-		}
-		streamView << L' ' << name << L"=\"" << finalValue << L"\"";
+		HierarchicalStorageAttribute& attribute = node.GetAttributeByIndex(i);
+		buffer.push_back(L' ');
+		buffer.append(attribute.GetInternedName());
+		buffer.append(L"=\"");
+		AppendEscapedText(buffer, attribute.GetValue());
+		buffer.push_back(L'\"');
 	}
 	if (node.GetBinaryDataPresent())
 	{
-		streamView << L" BinaryDataPresent=\"1\"";
+		buffer.append(L" BinaryDataPresent=\"1\"");
 		if (GetSeparateBinaryDataEnabled() && !node.GetInlineBinaryDataEnabled())
 		{
-			streamView << L" SeparateBinaryData=\"1\"";
+			buffer.append(L" SeparateBinaryData=\"1\"");
 		}
 	}
 
-	std::list<IHierarchicalStorageNode*> childList = node.GetChildList();
-	if (childList.empty() && !node.GetBinaryDataPresent() && node.GetData().empty())
+	size_t childCount = node.GetChildCount();
+	std::wstring data;
+	if (!node.GetBinaryDataPresent())
+	{
+		data = node.GetData();
+	}
+	if ((childCount == 0) && !node.GetBinaryDataPresent() && data.empty())
 	{
 		// If this entity contains no children and no data, shortcut the rest of the save
 		// process and use an empty element tag.
-		streamView << L" />";
+		buffer.append(L" />");
 	}
 	else
 	{
 		// If we need to output a full open/close key pair, close the opening value, and
 		// continue with the save process.
-		streamView << L'>';
+		buffer.push_back(L'>');
 
 		// Write data
 		if (!node.GetBinaryDataPresent())
 		{
-			std::wstring data = node.GetData();
-			std::wstring finalData;
-			for (unsigned int i = 0; i < data.length(); ++i)
-			{
-				if (IsCharacterReserved(data[i]))
-				{
-					finalData += GetNumericCharacterReference(data[i]);
-				}
-				else
-				{
-					finalData.push_back(data[i]);
-				}
-			}
-			streamView << finalData;
+			AppendEscapedText(buffer, data);
 		}
 		else
 		{
@@ -150,134 +230,44 @@ bool HierarchicalStorageTree::SaveNode(IHierarchicalStorageNode& node, Stream::I
 			if (GetSeparateBinaryDataEnabled() && !node.GetInlineBinaryDataEnabled())
 			{
 				// Output the name of the separate binary storage buffer
-				streamView << node.GetBinaryDataBufferName();
+				buffer.append(node.GetBinaryDataBufferName());
 			}
 			else
 			{
 				// Save binary data in the XML structure
+				static const wchar_t hexDigits[] = L"0123456789ABCDEF";
 				Stream::IStream::SizeType readCount = (node.GetBinaryDataBufferStream().Size() / (Stream::IStream::SizeType)sizeof(unsigned char));
-				std::vector<unsigned char> buffer((size_t)readCount);
-				node.ExtractBinaryData(buffer);
-				for (unsigned int i = 0; i < buffer.size(); ++i)
+				binaryDataBuffer.resize((size_t)readCount);
+				node.ExtractBinaryData(binaryDataBuffer);
+				size_t bufferPos = buffer.size();
+				buffer.resize(bufferPos + (binaryDataBuffer.size() * 2));
+				for (size_t i = 0; i < binaryDataBuffer.size(); ++i)
 				{
-					streamView << Stream::Hex(2) << buffer[i];
+					buffer[bufferPos++] = hexDigits[binaryDataBuffer[i] >> 4];
+					buffer[bufferPos++] = hexDigits[binaryDataBuffer[i] & 0x0F];
 				}
 			}
 		}
 
 		// Write child elements
-		if (!childList.empty())
+		if (childCount > 0)
 		{
-			streamView << L"\n";
-			for (std::list<IHierarchicalStorageNode*>::const_iterator i = childList.begin(); i != childList.end(); ++i)
+			buffer.push_back(L'\n');
+			for (size_t i = 0; i < childCount; ++i)
 			{
-				//##TODO## Add error handling
-				SaveNode(*(*i), stream, indentPrefix + L'\t');
+				SaveNode(node.GetChildByIndex(i), buffer, indentLevel + 1, binaryDataBuffer);
 			}
-			streamView << indentPrefix;
+			buffer.append(indentLevel, L'\t');
 		}
 
 		// Close key
-		streamView << L"</" << node.GetName() << L'>';
+		buffer.append(L"</");
+		buffer.append(node.GetInternedName());
+		buffer.push_back(L'>');
 	}
 
 	// Move to a new line in preparation for the next entity
-	streamView << L"\n";
-	return true;
-}
-
-//----------------------------------------------------------------------------------------------------------------------
-void XMLCALL HierarchicalStorageTree::LoadStartElement(void *userData, const XML_Char *aname, const XML_Char **aatts)
-{
-	HierarchicalStorageTree* tree = (HierarchicalStorageTree*)userData;
-	HierarchicalStorageNode* node = 0;
-	if (tree->_currentNodeDuringLoad == 0)
-	{
-		node = tree->_root;
-		tree->_currentNodeDuringLoad = node;
-	}
-	else
-	{
-		node = (HierarchicalStorageNode*)(&tree->_currentNodeDuringLoad->CreateChild());
-		tree->_currentNodeDuringLoad = node;
-	}
-
-	node->SetName(std::wstring(aname));
-	while (*aatts != 0)
-	{
-		std::wstring name;
-		std::wstring value;
-		name = (*(aatts++));
-		if (*aatts != 0)
-		{
-			value = (*(aatts++));
-			node->CreateAttribute(name, value);
-		}
-	}
-}
-
-//----------------------------------------------------------------------------------------------------------------------
-void XMLCALL HierarchicalStorageTree::LoadEndElement(void *userData, const XML_Char *aname)
-{
-	HierarchicalStorageTree* tree = (HierarchicalStorageTree*)userData;
-	if (tree->_currentNodeDuringLoad != 0)
-	{
-		tree->_currentNodeDuringLoad = &tree->_currentNodeDuringLoad->GetParent();
-	}
-}
-
-//----------------------------------------------------------------------------------------------------------------------
-void XMLCALL HierarchicalStorageTree::LoadData(void *userData, const XML_Char *s, int len)
-{
-	HierarchicalStorageTree* tree = (HierarchicalStorageTree*)userData;
-
-	// Append all printable characters to the data stream
-	std::wstring data;
-	if (!tree->_currentNodeDuringLoad->GetBinaryDataPresent())
-	{
-		data = tree->_currentNodeDuringLoad->GetData();
-	}
-	for (int i = 0; i < len; ++i)
-	{
-		// Exclude all characters that are not printable, and exclude all whitespace
-		// characters with the exception of space.
-		if ((iswprint(*(s + i)) != 0) && ((iswspace(*(s + i)) == 0) || (*(s + i) == L' ')))
-		{
-			data.push_back(*(s + i));
-		}
-	}
-	if (tree->_currentNodeDuringLoad->IsAttributePresent(L"BinaryDataPresent"))
-	{
-		tree->_currentNodeDuringLoad->SetBinaryDataPresent(true);
-		if (tree->_currentNodeDuringLoad->IsAttributePresent(L"SeparateBinaryData"))
-		{
-			tree->_currentNodeDuringLoad->SetInlineBinaryDataEnabled(false);
-			// Load the name of the separate binary storage buffer
-			tree->_currentNodeDuringLoad->SetBinaryDataBufferName(tree->_currentNodeDuringLoad->GetBinaryDataBufferName() + data);
-		}
-		else
-		{
-			tree->_currentNodeDuringLoad->SetInlineBinaryDataEnabled(true);
-			// Load inline binary data from the XML structure
-			size_t charPos = 0;
-			while ((data.length() - charPos) >= 2)
-			{
-				std::wstringstream dataStream;
-				dataStream << data[charPos + 0] << data[charPos + 1];
-				unsigned int byte;
-				dataStream >> std::hex >> byte;
-
-				Stream::IStream& bufferStream = tree->_currentNodeDuringLoad->GetBinaryDataBufferStream();
-				bufferStream.WriteData((unsigned char)byte);
-
-				charPos += 2;
-			}
-		}
-	}
-	else
-	{
-		tree->_currentNodeDuringLoad->SetData(data);
-	}
+	buffer.push_back(L'\n');
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -292,6 +282,7 @@ HierarchicalStorageTree::StorageMode HierarchicalStorageTree::GetStorageMode() c
 void HierarchicalStorageTree::SetStorageMode(StorageMode astorageMode)
 {
 	_storageMode = astorageMode;
+	_binaryDataInline = (_storageMode == StorageMode::Binary);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -327,8 +318,14 @@ Marshal::Ret<std::wstring> HierarchicalStorageTree::GetErrorString() const
 //----------------------------------------------------------------------------------------------------------------------
 Marshal::Ret<std::list<IHierarchicalStorageNode*>> HierarchicalStorageTree::GetBinaryDataNodeList()
 {
+	// Binary data is always stored inline in the binary storage format, so there are no
+	// separate binary data buffers for the caller to load or save when the tree was last
+	// loaded from, or saved to, that format.
 	std::list<IHierarchicalStorageNode*> binaryEntityList;
-	_root->AddBinaryDataEntitiesToList(binaryEntityList);
+	if (!_binaryDataInline)
+	{
+		_root->AddBinaryDataEntitiesToList(binaryEntityList);
+	}
 	return binaryEntityList;
 }
 
@@ -353,9 +350,33 @@ bool HierarchicalStorageTree::IsCharacterReserved(wchar_t character) const
 }
 
 //----------------------------------------------------------------------------------------------------------------------
-std::wstring HierarchicalStorageTree::GetNumericCharacterReference(wchar_t character) const
+void HierarchicalStorageTree::AppendEscapedText(std::wstring& buffer, const std::wstring& text) const
 {
-	std::wstringstream substitution;
-	substitution << L"&#" << (unsigned int)character << L';';
-	return substitution.str();
+	// Append the text to the buffer, substituting all reserved characters with a numeric
+	// character reference.
+	for (size_t i = 0; i < text.size(); ++i)
+	{
+		wchar_t character = text[i];
+		if (!IsCharacterReserved(character))
+		{
+			buffer.push_back(character);
+			continue;
+		}
+
+		wchar_t digits[10];
+		unsigned int digitCount = 0;
+		unsigned int characterCode = (unsigned int)character;
+		do
+		{
+			digits[digitCount++] = (wchar_t)(L'0' + (characterCode % 10));
+			characterCode /= 10;
+		}
+		while (characterCode > 0);
+		buffer.append(L"&#");
+		while (digitCount > 0)
+		{
+			buffer.push_back(digits[--digitCount]);
+		}
+		buffer.push_back(L';');
+	}
 }
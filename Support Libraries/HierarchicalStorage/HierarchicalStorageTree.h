@@ -1,10 +1,8 @@
 #ifndef __HIERARCHICALSTORAGETREE_H__
 #define __HIERARCHICALSTORAGETREE_H__
-#define XML_STATIC
-#define XML_UNICODE_WCHAR_T
-#include <expat.h>
 #include "HierarchicalStorageInterface/HierarchicalStorageInterface.pkg"
 #include "HierarchicalStorageNode.h"
+#include "HierarchicalStorageArena.h"
 #include <vector>
 
 class HierarchicalStorageTree :public IHierarchicalStorageTree
@@ -16,9 +14,9 @@ public:
 	void Initialize();
 
 	// Save/Load functions
-	//##TODO## Take the storage mode into account when saving and loading
 	virtual bool SaveTree(Stream::IStream& target);
 	virtual bool LoadTree(Stream::IStream& source);
+	bool LoadTree(const unsigned char* data, size_t dataSize, Stream::IStream::TextEncoding textEncoding, Stream::IStream::ByteOrder byteOrder);
 
 	// Storage mode functions
 	virtual StorageMode GetStorageMode() const;
@@ -35,21 +33,21 @@ public:
 
 private:
 	// Save/Load functions
-	bool SaveNode(IHierarchicalStorageNode& node, Stream::IStream& stream, const std::wstring& indentPrefix) const;
-	static void XMLCALL LoadStartElement(void *userData, const XML_Char *aname, const XML_Char **aatts);
-	static void XMLCALL LoadEndElement(void *userData, const XML_Char *aname);
-	static void XMLCALL LoadData(void *userData, const XML_Char *s, int len);
+	void SaveNode(HierarchicalStorageNode& node, std::wstring& buffer, unsigned int indentLevel, std::vector<unsigned char>& binaryDataBuffer) const;
+	template<class CharType>
+	bool LoadTreeFromText(const CharType* data, size_t length);
 
 	// Reserved character substitution functions
 	bool IsCharacterReserved(wchar_t character) const;
-	std::wstring GetNumericCharacterReference(wchar_t character) const;
+	void AppendEscapedText(std::wstring& buffer, const std::wstring& text) const;
 
 private:
 	StorageMode _storageMode;
+	HierarchicalStorageArena _arena;
 	HierarchicalStorageNode* _root;
-	IHierarchicalStorageNode* _currentNodeDuringLoad;
 	mutable std::wstring _errorString;
 	bool _allowSeparateBinaryData;
+	bool _binaryDataInline;
 };
 
 #endif
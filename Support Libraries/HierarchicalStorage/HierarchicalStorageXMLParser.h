@@ -0,0 +1,67 @@
+#ifndef __HIERARCHICALSTORAGEXMLPARSER_H__
+#define __HIERARCHICALSTORAGEXMLPARSER_H__
+#include "HierarchicalStorageNode.h"
+#include <string>
+#include <vector>
+
+// This class parses an XML document directly from an in-memory buffer into a hierarchical
+// storage tree. The CharType template parameter specifies the code unit type of the source
+// buffer, with char being used for UTF-8 data, and wchar_t for UTF-16 data in the native
+// byte order. When parsing UTF-16 data, element and attribute names are passed to the tree
+// directly from the source buffer, otherwise text is decoded into a small set of reusable
+// buffers owned by the parser, so no per-token string allocations are required.
+template<class CharType>
+class HierarchicalStorageXMLParser
+{
+public:
+	// Constructors
+	HierarchicalStorageXMLParser(const CharType* data, size_t length);
+
+	// Parse functions
+	bool Parse(HierarchicalStorageNode& rootNode);
+
+	// Error handling functions
+	std::wstring GetErrorString() const;
+
+private:
+	// Parse functions
+	bool ParseStartTag(HierarchicalStorageNode& node, bool& emptyElement);
+	bool ParseEndTag(const HierarchicalStorageNode& node);
+	bool ParseName(const wchar_t*& name, size_t& nameLength);
+	bool ResolveName(const CharType* nameStart, const wchar_t*& name, size_t& nameLength);
+	bool ParseAttributeValue();
+	bool ParseReference(std::wstring& target);
+	bool ParseCDATASection(std::wstring& target);
+	bool SkipMisc();
+	bool SkipComment();
+	bool SkipProcessingInstruction();
+	bool SkipDocumentTypeDeclaration();
+	bool SkipWhitespace();
+	bool CompleteNode(HierarchicalStorageNode& node, std::wstring& content);
+
+	// Character functions
+	inline unsigned int CodeUnitAt(const CharType* pos) const;
+	inline bool IsLiteralAt(const CharType* pos, const char* literal) const;
+	static inline bool IsWhitespace(unsigned int codeUnit);
+	static inline bool IsNameDelimiter(unsigned int codeUnit);
+	static inline unsigned int GetHexDigitValue(unsigned int codeUnit);
+	static void AppendCodePoint(std::wstring& target, unsigned int codePoint);
+	bool AppendText(std::wstring& target, const CharType* begin, const CharType* end);
+
+	// Error handling functions
+	bool SetError(const std::wstring& errorMessage);
+
+private:
+	const CharType* _begin;
+	const CharType* _end;
+	const CharType* _pos;
+	std::wstring _errorString;
+	std::wstring _nameBuffer;
+	std::wstring _valueBuffer;
+	std::vector<unsigned char> _binaryDataBuffer;
+	std::vector<HierarchicalStorageNode*> _nodeStack;
+	std::vector<std::wstring> _contentStack;
+};
+
+#include "HierarchicalStorageXMLParser.inl"
+#endif
@@ -0,0 +1,812 @@
+#include <algorithm>
+#include <sstream>
+#include <cwctype>
+
+//----------------------------------------------------------------------------------------------------------------------
+// Character functions
+//----------------------------------------------------------------------------------------------------------------------
+template<>
+inline unsigned int HierarchicalStorageXMLParser<char>::CodeUnitAt(const char* pos) const
+{
+	return (unsigned int)(unsigned char)*pos;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+template<>
+inline unsigned int HierarchicalStorageXMLParser<wchar_t>::CodeUnitAt(const wchar_t* pos) const
+{
+	return (unsigned int)*pos;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+template<>
+inline bool HierarchicalStorageXMLParser<char>::AppendText(std::wstring& target, const char* begin, const char* end)
+{
+	// Decode the UTF-8 source text, and append the resulting code points to the target
+	// string as UTF-16.
+	const unsigned char* pos = (const unsigned char*)begin;
+	const unsigned char* endPos = (const unsigned char*)end;
+	while (pos < endPos)
+	{
+		unsigned int leadByte = *(pos++);
+		if (leadByte < 0x80)
+		{
+			target.push_back((wchar_t)leadByte);
+			continue;
+		}
+
+		unsigned int trailingByteCount;
+		unsigned int codePoint;
+		if ((leadByte & 0xE0) == 0xC0)
+		{
+			trailingByteCount = 1;
+			codePoint = (leadByte & 0x1F);
+		}
+		else if ((leadByte & 0xF0) == 0xE0)
+		{
+			trailingByteCount = 2;
+			codePoint = (leadByte & 0x0F);
+		}
+		else if ((leadByte & 0xF8) == 0xF0)
+		{
+			trailingByteCount = 3;
+			codePoint = (leadByte & 0x07);
+		}
+		else
+		{
+			return SetError(L"not well-formed (invalid token)");
+		}
+		if ((size_t)(endPos - pos) < trailingByteCount)
+		{
+			return SetError(L"not well-formed (invalid token)");
+		}
+		for (unsigned int i = 0; i < trailingByteCount; ++i)
+		{
+			unsigned int trailingByte = *(pos++);
+			if ((trailingByte & 0xC0) != 0x80)
+			{
+				return SetError(L"not well-formed (invalid token)");
+			}
+			codePoint = (codePoint << 6) | (trailingByte & 0x3F);
+		}
+		AppendCodePoint(target, codePoint);
+	}
+	return true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+template<>
+inline bool HierarchicalStorageXMLParser<wchar_t>::AppendText(std::wstring& target, const wchar_t* begin, const wchar_t* end)
+{
+	target.append(begin, end);
+	return true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+template<class CharType>
+bool HierarchicalStorageXMLParser<CharType>::IsLiteralAt(const CharType* pos, const char* literal) const
+{
+	while (*literal != '\0')
+	{
+		if ((pos >= _end) || (CodeUnitAt(pos) != (unsigned int)(unsigned char)*literal))
+		{
+			return false;
+		}
+		++pos;
+		++literal;
+	}
+	return true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+template<class CharType>
+bool HierarchicalStorageXMLParser<CharType>::IsWhitespace(unsigned int codeUnit)
+{
+	return (codeUnit == ' ') || (codeUnit == '\t') || (codeUnit == '\r') || (codeUnit == '\n');
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+template<class CharType>
+bool HierarchicalStorageXMLParser<CharType>::IsNameDelimiter(unsigned int codeUnit)
+{
+	switch (codeUnit)
+	{
+	case ' ':
+	case '\t':
+	case '\r':
+	case '\n':
+	case '/':
+	case '>':
+	case '<':
+	case '=':
+	case '&':
+	case '\"':
+	case '\'':
+		return true;
+	}
+	return false;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+template<class CharType>
+unsigned int HierarchicalStorageXMLParser<CharType>::GetHexDigitValue(unsigned int codeUnit)
+{
+	if ((codeUnit >= '0') && (codeUnit <= '9'))
+	{
+		return (codeUnit - '0');
+	}
+	else if ((codeUnit >= 'A') && (codeUnit <= 'F'))
+	{
+		return (codeUnit - 'A') + 10;
+	}
+	else if ((codeUnit >= 'a') && (codeUnit <= 'f'))
+	{
+		return (codeUnit - 'a') + 10;
+	}
+	return 0xFF;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+template<class CharType>
+void HierarchicalStorageXMLParser<CharType>::AppendCodePoint(std::wstring& target, unsigned int codePoint)
+{
+	if (codePoint >= 0x10000)
+	{
+		codePoint -= 0x10000;
+		target.push_back((wchar_t)(0xD800 | ((codePoint >> 10) & 0x3FF)));
+		target.push_back((wchar_t)(0xDC00 | (codePoint & 0x3FF)));
+	}
+	else
+	{
+		target.push_back((wchar_t)codePoint);
+	}
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Constructors
+//----------------------------------------------------------------------------------------------------------------------
+template<class CharType>
+HierarchicalStorageXMLParser<CharType>::HierarchicalStorageXMLParser(const CharType* data, size_t length)
+:_begin(data), _end(data + length), _pos(data)
+{ }
+
+//----------------------------------------------------------------------------------------------------------------------
+// Parse functions
+//----------------------------------------------------------------------------------------------------------------------
+template<class CharType>
+bool HierarchicalStorageXMLParser<CharType>::Parse(HierarchicalStorageNode& rootNode)
+{
+	// Skip any byte order mark at the start of the buffer
+	_pos = _begin;
+	_nodeStack.clear();
+	if ((_pos < _end) && (CodeUnitAt(_pos) == 0xFEFF))
+	{
+		++_pos;
+	}
+	else if (IsLiteralAt(_pos, "\xEF\xBB\xBF"))
+	{
+		_pos += 3;
+	}
+
+	// Skip over the XML declaration, and any comments or other markup before the root
+	// element
+	if (!SkipMisc())
+	{
+		return false;
+	}
+	if ((_pos >= _end) || (CodeUnitAt(_pos) != '<'))
+	{
+		return SetError(L"no element found");
+	}
+
+	// Load the root element
+	++_pos;
+	const wchar_t* name;
+	size_t nameLength;
+	if (!ParseName(name, nameLength))
+	{
+		return false;
+	}
+	rootNode.SetName(std::wstring(name, nameLength));
+	bool emptyElement;
+	if (!ParseStartTag(rootNode, emptyElement))
+	{
+		return false;
+	}
+	if (emptyElement)
+	{
+		_valueBuffer.clear();
+		if (!CompleteNode(rootNode, _valueBuffer))
+		{
+			return false;
+		}
+	}
+	else
+	{
+		_nodeStack.push_back(&rootNode);
+		_contentStack.resize(std::max(_contentStack.size(), _nodeStack.size()));
+		_contentStack[0].clear();
+	}
+
+	// Load the contents of the root element. Note that we use an explicit stack here
+	// rather than recursion, so that deeply nested documents can't exhaust the call stack.
+	while (!_nodeStack.empty())
+	{
+		if (_pos >= _end)
+		{
+			return SetError(L"no element found");
+		}
+
+		HierarchicalStorageNode& node = *_nodeStack.back();
+		std::wstring& content = _contentStack[_nodeStack.size() - 1];
+		unsigned int codeUnit = CodeUnitAt(_pos);
+		if (codeUnit == '&')
+		{
+			if (!ParseReference(content))
+			{
+				return false;
+			}
+		}
+		else if (codeUnit != '<')
+		{
+			const CharType* textStart = _pos;
+			while ((_pos < _end) && (CodeUnitAt(_pos) != '<') && (CodeUnitAt(_pos) != '&'))
+			{
+				++_pos;
+			}
+			if (!AppendText(content, textStart, _pos))
+			{
+				return false;
+			}
+		}
+		else if (IsLiteralAt(_pos, "</"))
+		{
+			_pos += 2;
+			if (!ParseEndTag(node) || !CompleteNode(node, content))
+			{
+				return false;
+			}
+			_nodeStack.pop_back();
+		}
+		else if (IsLiteralAt(_pos, "<!--"))
+		{
+			if (!SkipComment())
+			{
+				return false;
+			}
+		}
+		else if (IsLiteralAt(_pos, "<![CDATA["))
+		{
+			if (!ParseCDATASection(content))
+			{
+				return false;
+			}
+		}
+		else if (IsLiteralAt(_pos, "<?"))
+		{
+			if (!SkipProcessingInstruction())
+			{
+				return false;
+			}
+		}
+		else
+		{
+			// Load a child element
+			++_pos;
+			if (!ParseName(name, nameLength))
+			{
+				return false;
+			}
+			HierarchicalStorageNode& childNode = node.CreateChildFromBuffer(name, nameLength);
+			if (!ParseStartTag(childNode, emptyElement))
+			{
+				return false;
+			}
+			if (emptyElement)
+			{
+				_valueBuffer.clear();
+				if (!CompleteNode(childNode, _valueBuffer))
+				{
+					return false;
+				}
+			}
+			else
+			{
+				_nodeStack.push_back(&childNode);
+				_contentStack.resize(std::max(_contentStack.size(), _nodeStack.size()));
+				_contentStack[_nodeStack.size() - 1].clear();
+			}
+		}
+	}
+
+	// Ensure there's no content following the root element other than comments and
+	// processing instructions. We allow the buffer to be null terminated here, since the
+	// text may have been generated into a fixed size buffer.
+	if (!SkipMisc())
+	{
+		return false;
+	}
+	if ((_pos < _end) && (CodeUnitAt(_pos) != 0))
+	{
+		return SetError(L"junk after document element");
+	}
+	return true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+template<class CharType>
+bool HierarchicalStorageXMLParser<CharType>::ParseStartTag(HierarchicalStorageNode& node, bool& emptyElement)
+{
+	while (true)
+	{
+		// Check if we've reached the end of the tag
+		bool whitespacePresent = SkipWhitespace();
+		if (_pos >= _end)
+		{
+			return SetError(L"unclosed token");
+		}
+		unsigned int codeUnit = CodeUnitAt(_pos);
+		if (codeUnit == '>')
+		{
+			++_pos;
+			emptyElement = false;
+			return true;
+		}
+		else if (codeUnit == '/')
+		{
+			if (!IsLiteralAt(_pos, "/>"))
+			{
+				return SetError(L"not well-formed (invalid token)");
+			}
+			_pos += 2;
+			emptyElement = true;
+			return true;
+		}
+		else if (!whitespacePresent)
+		{
+			return SetError(L"not well-formed (invalid token)");
+		}
+
+		// Load the next attribute
+		const wchar_t* attributeName;
+		size_t attributeNameLength;
+		if (!ParseName(attributeName, attributeNameLength))
+		{
+			return false;
+		}
+		SkipWhitespace();
+		if ((_pos >= _end) || (CodeUnitAt(_pos) != '='))
+		{
+			return SetError(L"not well-formed (invalid token)");
+		}
+		++_pos;
+		SkipWhitespace();
+		if (!ParseAttributeValue())
+		{
+			return false;
+		}
+		HierarchicalStorageAttribute& attribute = node.CreateAttributeFromBuffer(attributeName, attributeNameLength);
+		attribute.SetValue(_valueBuffer);
+	}
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+template<class CharType>
+bool HierarchicalStorageXMLParser<CharType>::ParseEndTag(const HierarchicalStorageNode& node)
+{
+	// Ensure the name of the end tag matches the element we're closing
+	const wchar_t* name;
+	size_t nameLength;
+	if (!ParseName(name, nameLength))
+	{
+		return false;
+	}
+	const std::wstring& nodeName = node.GetInternedName();
+	if ((nodeName.size() != nameLength) || (nodeName.compare(0, nameLength, name, nameLength) != 0))
+	{
+		return SetError(L"mismatched tag");
+	}
+
+	// Consume the end of the tag
+	SkipWhitespace();
+	if ((_pos >= _end) || (CodeUnitAt(_pos) != '>'))
+	{
+		return SetError(L"not well-formed (invalid token)");
+	}
+	++_pos;
+	return true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+template<class CharType>
+bool HierarchicalStorageXMLParser<CharType>::ParseName(const wchar_t*& name, size_t& nameLength)
+{
+	const CharType* nameStart = _pos;
+	while ((_pos < _end) && !IsNameDelimiter(CodeUnitAt(_pos)))
+	{
+		++_pos;
+	}
+	if (_pos == nameStart)
+	{
+		return SetError(L"not well-formed (invalid token)");
+	}
+	return ResolveName(nameStart, name, nameLength);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+template<>
+inline bool HierarchicalStorageXMLParser<char>::ResolveName(const char* nameStart, const wchar_t*& name, size_t& nameLength)
+{
+	_nameBuffer.clear();
+	if (!AppendText(_nameBuffer, nameStart, _pos))
+	{
+		return false;
+	}
+	name = _nameBuffer.c_str();
+	nameLength = _nameBuffer.size();
+	return true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+template<>
+inline bool HierarchicalStorageXMLParser<wchar_t>::ResolveName(const wchar_t* nameStart, const wchar_t*& name, size_t& nameLength)
+{
+	// Since the source buffer is already in our native string format, we can refer to the
+	// name directly within the source buffer.
+	name = nameStart;
+	nameLength = (size_t)(_pos - nameStart);
+	return true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+template<class CharType>
+bool HierarchicalStorageXMLParser<CharType>::ParseAttributeValue()
+{
+	// Read the opening quote character
+	if (_pos >= _end)
+	{
+		return SetError(L"unclosed token");
+	}
+	unsigned int quoteCodeUnit = CodeUnitAt(_pos);
+	if ((quoteCodeUnit != '\"') && (quoteCodeUnit != '\''))
+	{
+		return SetError(L"not well-formed (invalid token)");
+	}
+	++_pos;
+
+	// Read the attribute value
+	_valueBuffer.clear();
+	while (true)
+	{
+		const CharType* textStart = _pos;
+		unsigned int codeUnit = 0;
+		while ((_pos < _end) && ((codeUnit = CodeUnitAt(_pos)) != quoteCodeUnit) && (codeUnit != '&') && (codeUnit != '<') && (codeUnit != '\t') && (codeUnit != '\r') && (codeUnit != '\n'))
+		{
+			++_pos;
+		}
+		if (!AppendText(_valueBuffer, textStart, _pos))
+		{
+			return false;
+		}
+		if (_pos >= _end)
+		{
+			return SetError(L"unclosed token");
+		}
+
+		if (codeUnit == quoteCodeUnit)
+		{
+			++_pos;
+			return true;
+		}
+		else if (codeUnit == '&')
+		{
+			if (!ParseReference(_valueBuffer))
+			{
+				return false;
+			}
+		}
+		else if (codeUnit == '<')
+		{
+			return SetError(L"not well-formed (invalid token)");
+		}
+		else
+		{
+			// As required by the XML standard, literal whitespace characters within an
+			// attribute value are normalized to a space, with a CR LF pair being treated
+			// as a single character.
+			if ((codeUnit == '\r') && IsLiteralAt(_pos + 1, "\n"))
+			{
+				++_pos;
+			}
+			++_pos;
+			_valueBuffer.push_back(L' ');
+		}
+	}
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+template<class CharType>
+bool HierarchicalStorageXMLParser<CharType>::ParseReference(std::wstring& target)
+{
+	// Locate the end of the reference
+	static const size_t MaxReferenceLength = 16;
+	const CharType* referenceStart = ++_pos;
+	while ((_pos < _end) && (CodeUnitAt(_pos) != ';') && ((size_t)(_pos - referenceStart) < MaxReferenceLength))
+	{
+		++_pos;
+	}
+	if ((_pos >= _end) || (CodeUnitAt(_pos) != ';'))
+	{
+		return SetError(L"not well-formed (invalid token)");
+	}
+	size_t referenceLength = (size_t)(_pos - referenceStart);
+	++_pos;
+
+	// Decode a numeric character reference
+	if ((referenceLength >= 2) && (CodeUnitAt(referenceStart) == '#'))
+	{
+		bool hexReference = (CodeUnitAt(referenceStart + 1) == 'x');
+		size_t digitPos = (hexReference) ? 2 : 1;
+		if (digitPos >= referenceLength)
+		{
+			return SetError(L"not well-formed (invalid token)");
+		}
+		unsigned int codePoint = 0;
+		while (digitPos < referenceLength)
+		{
+			unsigned int digitValue = GetHexDigitValue(CodeUnitAt(referenceStart + digitPos++));
+			if (digitValue >= ((hexReference) ? 16u : 10u))
+			{
+				return SetError(L"not well-formed (invalid token)");
+			}
+			codePoint = (codePoint * ((hexReference) ? 16 : 10)) + digitValue;
+			if (codePoint > 0x10FFFF)
+			{
+				return SetError(L"reference to invalid character number");
+			}
+		}
+		if (codePoint == 0)
+		{
+			return SetError(L"reference to invalid character number");
+		}
+		AppendCodePoint(target, codePoint);
+		return true;
+	}
+
+	// Decode a predefined entity reference
+	static const struct
+	{
+		const char* name;
+		size_t nameLength;
+		wchar_t value;
+	} predefinedEntities[] = {{"lt", 2, L'<'}, {"gt", 2, L'>'}, {"amp", 3, L'&'}, {"quot", 4, L'\"'}, {"apos", 4, L'\''}};
+	for (unsigned int i = 0; i < (sizeof(predefinedEntities) / sizeof(predefinedEntities[0])); ++i)
+	{
+		if ((predefinedEntities[i].nameLength == referenceLength) && IsLiteralAt(referenceStart, predefinedEntities[i].name))
+		{
+			target.push_back(predefinedEntities[i].value);
+			return true;
+		}
+	}
+	return SetError(L"undefined entity");
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+template<class CharType>
+bool HierarchicalStorageXMLParser<CharType>::ParseCDATASection(std::wstring& target)
+{
+	_pos += 9;
+	const CharType* textStart = _pos;
+	while ((_pos < _end) && !IsLiteralAt(_pos, "]]>"))
+	{
+		++_pos;
+	}
+	if (_pos >= _end)
+	{
+		return SetError(L"unclosed CDATA section");
+	}
+	if (!AppendText(target, textStart, _pos))
+	{
+		return false;
+	}
+	_pos += 3;
+	return true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+template<class CharType>
+bool HierarchicalStorageXMLParser<CharType>::SkipMisc()
+{
+	while (true)
+	{
+		SkipWhitespace();
+		if (IsLiteralAt(_pos, "<?"))
+		{
+			if (!SkipProcessingInstruction())
+			{
+				return false;
+			}
+		}
+		else if (IsLiteralAt(_pos, "<!--"))
+		{
+			if (!SkipComment())
+			{
+				return false;
+			}
+		}
+		else if (IsLiteralAt(_pos, "<!DOCTYPE"))
+		{
+			if (!SkipDocumentTypeDeclaration())
+			{
+				return false;
+			}
+		}
+		else
+		{
+			return true;
+		}
+	}
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+template<class CharType>
+bool HierarchicalStorageXMLParser<CharType>::SkipComment()
+{
+	_pos += 4;
+	while ((_pos < _end) && !IsLiteralAt(_pos, "-->"))
+	{
+		++_pos;
+	}
+	if (_pos >= _end)
+	{
+		return SetError(L"unclosed token");
+	}
+	_pos += 3;
+	return true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+template<class CharType>
+bool HierarchicalStorageXMLParser<CharType>::SkipProcessingInstruction()
+{
+	_pos += 2;
+	while ((_pos < _end) && !IsLiteralAt(_pos, "?>"))
+	{
+		++_pos;
+	}
+	if (_pos >= _end)
+	{
+		return SetError(L"unclosed token");
+	}
+	_pos += 2;
+	return true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+template<class CharType>
+bool HierarchicalStorageXMLParser<CharType>::SkipDocumentTypeDeclaration()
+{
+	// We don't process document type declarations, but we need to skip over them, taking
+	// into account any internal subset enclosed in square brackets.
+	_pos += 9;
+	unsigned int bracketDepth = 0;
+	while (_pos < _end)
+	{
+		unsigned int codeUnit = CodeUnitAt(_pos++);
+		if (codeUnit == '[')
+		{
+			++bracketDepth;
+		}
+		else if ((codeUnit == ']') && (bracketDepth > 0))
+		{
+			--bracketDepth;
+		}
+		else if ((codeUnit == '>') && (bracketDepth == 0))
+		{
+			return true;
+		}
+	}
+	return SetError(L"unclosed token");
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+template<class CharType>
+bool HierarchicalStorageXMLParser<CharType>::SkipWhitespace()
+{
+	const CharType* startPos = _pos;
+	while ((_pos < _end) && IsWhitespace(CodeUnitAt(_pos)))
+	{
+		++_pos;
+	}
+	return (_pos != startPos);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+template<class CharType>
+bool HierarchicalStorageXMLParser<CharType>::CompleteNode(HierarchicalStorageNode& node, std::wstring& content)
+{
+	// Exclude all characters that are not printable, and exclude all whitespace characters
+	// with the exception of space.
+	content.erase(std::remove_if(content.begin(), content.end(), [](wchar_t character) { return (iswprint(character) == 0) || ((iswspace(character) != 0) && (character != L' ')); }), content.end());
+
+	// Determine if this node contains binary data
+	bool binaryDataPresent = false;
+	bool separateBinaryData = false;
+	for (size_t i = 0; i < node.GetAttributeCount(); ++i)
+	{
+		const std::wstring& attributeName = node.GetAttributeByIndex(i).GetInternedName();
+		binaryDataPresent |= (attributeName == L"BinaryDataPresent");
+		separateBinaryData |= (attributeName == L"SeparateBinaryData");
+	}
+
+	// Load the content of this node
+	if (!binaryDataPresent)
+	{
+		if (!content.empty())
+		{
+			node.SetData(content);
+		}
+	}
+	else
+	{
+		node.SetBinaryDataPresent(true);
+		if (separateBinaryData)
+		{
+			// Load the name of the separate binary storage buffer
+			node.SetInlineBinaryDataEnabled(false);
+			node.SetBinaryDataBufferName(content);
+		}
+		else
+		{
+			// Load inline binary data from the XML structure
+			node.SetInlineBinaryDataEnabled(true);
+			_binaryDataBuffer.resize(content.size() / 2);
+			for (size_t i = 0; i < _binaryDataBuffer.size(); ++i)
+			{
+				unsigned int highNybble = GetHexDigitValue((unsigned int)content[(i * 2) + 0]);
+				unsigned int lowNybble = GetHexDigitValue((unsigned int)content[(i * 2) + 1]);
+				if ((highNybble > 0xF) || (lowNybble > 0xF))
+				{
+					return SetError(L"invalid binary data");
+				}
+				_binaryDataBuffer[i] = (unsigned char)((highNybble << 4) | lowNybble);
+			}
+			if (!_binaryDataBuffer.empty())
+			{
+				node.GetBinaryDataBufferStream().WriteData(&_binaryDataBuffer[0], (Stream::IStream::SizeType)_binaryDataBuffer.size());
+			}
+		}
+	}
+	return true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Error handling functions
+//----------------------------------------------------------------------------------------------------------------------
+template<class CharType>
+std::wstring HierarchicalStorageXMLParser<CharType>::GetErrorString() const
+{
+	return _errorString;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+template<class CharType>
+bool HierarchicalStorageXMLParser<CharType>::SetError(const std::wstring& errorMessage)
+{
+	// Calculate the line number where the error occurred. We only do this when an error is
+	// encountered, so we don't need to track line numbers during parsing.
+	unsigned int lineNumber = 1;
+	const CharType* endPos = std::min(_pos, _end);
+	for (const CharType* i = _begin; i < endPos; ++i)
+	{
+		if (CodeUnitAt(i) == '\n')
+		{
+			++lineNumber;
+		}
+	}
+
+	std::wstringstream errorStream;
+	errorStream << errorMessage << L" at line " << lineNumber;
+	_errorString = errorStream.str();
+	return false;
+}
@@ -0,0 +1,415 @@
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+#include "HierarchicalStorage/HierarchicalStorageNode.h"
+#include "HierarchicalStorage/HierarchicalStorageArena.h"
+#include "HierarchicalStorage/HierarchicalStorageTree.h"
+#include <sstream>
+#include <limits>
+#include <algorithm>
+#include <string>
+#include <vector>
+
+TEST_CASE("HierarchicalStorageArena::Free", "")
+{
+	HierarchicalStorageArena arena;
+	SECTION("Released allocations are reused for allocations of the same size", "")
+	{
+		void* firstAllocation = arena.Allocate(40);
+		void* secondAllocation = arena.Allocate(40);
+		arena.Free(firstAllocation, 40);
+		REQUIRE(arena.Allocate(40) == firstAllocation);
+		arena.Free(secondAllocation, 40);
+		arena.Free(firstAllocation, 40);
+		REQUIRE(arena.Allocate(40) == firstAllocation);
+		REQUIRE(arena.Allocate(40) == secondAllocation);
+	}
+	SECTION("Released allocations are not reused for allocations of a different size", "")
+	{
+		void* firstAllocation = arena.Allocate(40);
+		arena.Free(firstAllocation, 40);
+		REQUIRE(arena.Allocate(400) != firstAllocation);
+		REQUIRE(arena.Allocate(40) == firstAllocation);
+	}
+}
+
+TEST_CASE("HierarchicalStorageNode::DeleteAttribute", "")
+{
+	HierarchicalStorageArena arena;
+	HierarchicalStorageNode node(arena);
+	IHierarchicalStorageAttribute& firstAttribute = node.CreateAttribute(L"first");
+	IHierarchicalStorageAttribute& secondAttribute = node.CreateAttribute(L"second");
+	IHierarchicalStorageAttribute& thirdAttribute = node.CreateAttribute(L"third");
+	firstAttribute.SetValue(1);
+	secondAttribute.SetValue(2);
+	thirdAttribute.SetValue(3);
+	SECTION("Deleting the first attribute", "")
+	{
+		node.DeleteAttribute(firstAttribute);
+		REQUIRE(!node.IsAttributePresent(L"first"));
+		REQUIRE(node.GetAttribute(L"second")->ExtractValue<int>() == 2);
+		REQUIRE(node.GetAttribute(L"third")->ExtractValue<int>() == 3);
+		REQUIRE(node.GetAttributeList().Get().size() == 2);
+	}
+	SECTION("Deleting an attribute after the first attribute", "")
+	{
+		// This previously never returned, as the search loop didn't advance past an
+		// attribute which didn't match.
+		node.DeleteAttribute(thirdAttribute);
+		REQUIRE(!node.IsAttributePresent(L"third"));
+		REQUIRE(node.GetAttribute(L"first")->ExtractValue<int>() == 1);
+		REQUIRE(node.GetAttribute(L"second")->ExtractValue<int>() == 2);
+		REQUIRE(node.GetAttributeList().Get().size() == 2);
+	}
+	SECTION("Deleting an attribute which belongs to another node", "")
+	{
+		HierarchicalStorageNode otherNode(arena);
+		IHierarchicalStorageAttribute& otherAttribute = otherNode.CreateAttribute(L"first");
+		node.DeleteAttribute(otherAttribute);
+		REQUIRE(node.GetAttributeList().Get().size() == 3);
+		REQUIRE(otherNode.IsAttributePresent(L"first"));
+	}
+	SECTION("Deleted attributes are reused by new attributes", "")
+	{
+		node.DeleteAttribute(secondAttribute);
+		IHierarchicalStorageAttribute& newAttribute = node.CreateAttribute(L"fourth");
+		REQUIRE(&newAttribute == &secondAttribute);
+		newAttribute.SetValue(4);
+		REQUIRE(node.GetAttribute(L"fourth")->ExtractValue<int>() == 4);
+		REQUIRE(node.GetAttribute(L"first")->ExtractValue<int>() == 1);
+		REQUIRE(node.GetAttribute(L"third")->ExtractValue<int>() == 3);
+	}
+}
+
+TEST_CASE("HierarchicalStorageNode::DeleteChild", "")
+{
+	HierarchicalStorageArena arena;
+	HierarchicalStorageNode node(arena);
+	IHierarchicalStorageNode& firstChild = node.CreateChild(L"first");
+	IHierarchicalStorageNode& secondChild = node.CreateChild(L"second");
+	secondChild.CreateChild(L"grandchild").CreateAttribute(L"value").SetValue(5);
+	SECTION("Deleting a child removes it and its descendants", "")
+	{
+		node.DeleteChild(secondChild);
+		REQUIRE(!node.IsChildPresent(L"second"));
+		REQUIRE(node.GetChild(L"first") == &firstChild);
+		REQUIRE(node.GetChildList().Get().size() == 1);
+	}
+	SECTION("Repeatedly creating and deleting children reuses the same memory", "")
+	{
+		node.DeleteChild(firstChild);
+		for (unsigned int i = 0; i < 1000; ++i)
+		{
+			IHierarchicalStorageNode& child = node.CreateChild(L"temp");
+			REQUIRE(&child == &firstChild);
+			node.DeleteChild(child);
+		}
+		REQUIRE(node.GetChildList().Get().size() == 1);
+	}
+}
+
+TEST_CASE("HierarchicalStorageAttribute integer values", "")
+{
+	HierarchicalStorageArena arena;
+	HierarchicalStorageNode node(arena);
+	IHierarchicalStorageAttribute& attribute = node.CreateAttribute(L"value");
+	SECTION("Integer values are read back as integers and as text", "")
+	{
+		attribute.SetValue(-1234);
+		REQUIRE(attribute.ExtractValue<int>() == -1234);
+		REQUIRE(attribute.ExtractValue<long long>() == -1234);
+		REQUIRE(attribute.GetValue() == L"-1234");
+		REQUIRE(attribute.ExtractValue<int>() == -1234);
+	}
+	SECTION("The most negative value is stored correctly", "")
+	{
+		attribute.SetValue(std::numeric_limits<long long>::min());
+		REQUIRE(attribute.ExtractValue<long long>() == std::numeric_limits<long long>::min());
+		REQUIRE(attribute.GetValue() == L"-9223372036854775808");
+	}
+	SECTION("Text can be appended to an integer value", "")
+	{
+		attribute.SetValue(12);
+		attribute.InsertValue(L"34");
+		REQUIRE(attribute.GetValue() == L"1234");
+		REQUIRE(attribute.ExtractValue<unsigned int>() == 1234);
+	}
+	SECTION("Values which don't fit the target type are converted as text", "")
+	{
+		attribute.SetValue(0x12345);
+		std::wstringstream stream(L"74565");
+		unsigned short expectedValue = 0;
+		stream >> expectedValue;
+		REQUIRE(attribute.ExtractValue<unsigned short>() == expectedValue);
+	}
+}
+
+TEST_CASE("HierarchicalStorageTree binary storage mode", "")
+{
+	HierarchicalStorageTree tree;
+	tree.SetStorageMode(IHierarchicalStorageTree::StorageMode::Binary);
+	IHierarchicalStorageNode& rootNode = tree.GetRootNode();
+	rootNode.SetName(L"State");
+	IHierarchicalStorageNode& childNode = rootNode.CreateChild(L"Device");
+	childNode.CreateAttribute(L"Name", std::wstring(L"Z80"));
+	childNode.CreateAttribute(L"ModuleID", 7u);
+	childNode.CreateAttribute(L"Offset", -3);
+	Stream::Buffer buffer(0);
+	REQUIRE(tree.SaveTree(buffer));
+
+	SECTION("The storage mode is retained when loading XML data", "")
+	{
+		const char xmlText[] = "<State><Device Name=\"Z80\" ModuleID=\"7\"/></State>";
+		Stream::Buffer xmlBuffer(Stream::IStream::TextEncoding::UTF8, 0);
+		REQUIRE(xmlBuffer.WriteData((const unsigned char*)&xmlText[0], sizeof(xmlText) - 1));
+		xmlBuffer.SetStreamPos(0);
+		HierarchicalStorageTree loadedTree;
+		loadedTree.SetStorageMode(IHierarchicalStorageTree::StorageMode::Binary);
+		REQUIRE(loadedTree.LoadTree(xmlBuffer));
+		REQUIRE(loadedTree.GetStorageMode() == IHierarchicalStorageTree::StorageMode::Binary);
+		REQUIRE(loadedTree.GetRootNode().GetChild(L"Device")->GetAttribute(L"ModuleID")->ExtractValue<unsigned int>() == 7);
+	}
+	SECTION("Binary data round trips with typed attribute values", "")
+	{
+		buffer.SetStreamPos(0);
+		HierarchicalStorageTree loadedTree;
+		REQUIRE(loadedTree.LoadTree(buffer));
+		REQUIRE(loadedTree.GetStorageMode() == IHierarchicalStorageTree::StorageMode::XML);
+		IHierarchicalStorageNode* loadedChildNode = loadedTree.GetRootNode().GetChild(L"Device");
+		REQUIRE(loadedChildNode != 0);
+		REQUIRE(loadedChildNode->GetAttribute(L"Name")->GetValue() == L"Z80");
+		REQUIRE(loadedChildNode->GetAttribute(L"ModuleID")->ExtractValue<unsigned int>() == 7);
+		REQUIRE(loadedChildNode->GetAttribute(L"Offset")->ExtractValue<int>() == -3);
+		REQUIRE(loadedChildNode->GetAttribute(L"Offset")->GetValue() == L"-3");
+	}
+}
+
+static bool LoadTreeFromUTF8Text(HierarchicalStorageTree& tree, const std::string& text)
+{
+	Stream::Buffer buffer(Stream::IStream::TextEncoding::UTF8, 0);
+	if (!text.empty() && !buffer.WriteData((const unsigned char*)text.c_str(), (Stream::IStream::SizeType)text.size()))
+	{
+		return false;
+	}
+	buffer.SetStreamPos(0);
+	buffer.ProcessByteOrderMark();
+	return tree.LoadTree(buffer);
+}
+
+static std::wstring BuildWideString(const unsigned int* codeUnits, size_t codeUnitCount)
+{
+	// We build expected strings from explicit UTF-16 code units here, since the parser
+	// produces UTF-16 text regardless of the size of wchar_t on the target platform.
+	std::wstring result;
+	for (size_t i = 0; i < codeUnitCount; ++i)
+	{
+		result.push_back((wchar_t)codeUnits[i]);
+	}
+	return result;
+}
+
+TEST_CASE("HierarchicalStorageTree XML round trip", "")
+{
+	HierarchicalStorageTree tree;
+	IHierarchicalStorageNode& rootNode = tree.GetRootNode();
+	rootNode.SetName(L"State");
+	IHierarchicalStorageNode& textNode = rootNode.CreateChild(L"Text");
+	textNode.CreateAttribute(L"Reserved", std::wstring(L"<tag attr=\"1\" other='2'> & 100%\tend"));
+	textNode.SetData(std::wstring(L"a<b>&c"));
+	const unsigned char inlineData[] = {0x00, 0x12, 0xAB, 0xFF};
+	rootNode.CreateChild(L"Inline").InsertBinaryData(&inlineData[0], sizeof(inlineData), L"Inline", true);
+	const unsigned char separateData[] = {0x55, 0xAA};
+	rootNode.CreateChild(L"Separate").InsertBinaryData(&separateData[0], sizeof(separateData), L"Separate.Data", false);
+	Stream::Buffer buffer(Stream::IStream::TextEncoding::UTF8, 0);
+	REQUIRE(tree.SaveTree(buffer));
+	std::string savedText((const char*)buffer.GetRawBuffer(), (size_t)buffer.Size());
+
+	SECTION("Reserved characters are saved as numeric character references", "")
+	{
+		REQUIRE(savedText.find("&#60;tag attr=&#34;1&#34; other=&#39;2&#39;&#62; &#38; 100&#37;&#9;end") != std::string::npos);
+		REQUIRE(savedText.find(">a&#60;b&#62;&#38;c</Text>") != std::string::npos);
+	}
+	SECTION("Binary data is saved inline as hex, or as a reference to a separate buffer", "")
+	{
+		REQUIRE(savedText.find("<Inline BinaryDataPresent=\"1\">0012ABFF</Inline>") != std::string::npos);
+		REQUIRE(savedText.find("<Separate BinaryDataPresent=\"1\" SeparateBinaryData=\"1\">Separate.Data</Separate>") != std::string::npos);
+	}
+	SECTION("The loaded tree matches the saved tree", "")
+	{
+		buffer.SetStreamPos(0);
+		HierarchicalStorageTree loadedTree;
+		REQUIRE(loadedTree.LoadTree(buffer));
+		IHierarchicalStorageNode& loadedRootNode = loadedTree.GetRootNode();
+		REQUIRE(loadedRootNode.GetName() == L"State");
+		IHierarchicalStorageNode* loadedTextNode = loadedRootNode.GetChild(L"Text");
+		REQUIRE(loadedTextNode != 0);
+		REQUIRE(loadedTextNode->GetAttribute(L"Reserved")->GetValue() == L"<tag attr=\"1\" other='2'> & 100%\tend");
+		REQUIRE(loadedTextNode->GetData() == L"a<b>&c");
+
+		IHierarchicalStorageNode* loadedInlineNode = loadedRootNode.GetChild(L"Inline");
+		REQUIRE(loadedInlineNode != 0);
+		REQUIRE(loadedInlineNode->GetBinaryDataPresent());
+		REQUIRE(loadedInlineNode->GetInlineBinaryDataEnabled());
+		REQUIRE(loadedInlineNode->GetBinaryDataBufferStream().Size() == sizeof(inlineData));
+		std::vector<unsigned char> loadedInlineData(sizeof(inlineData));
+		loadedInlineNode->ExtractBinaryData(loadedInlineData);
+		REQUIRE(loadedInlineData == std::vector<unsigned char>(&inlineData[0], &inlineData[0] + sizeof(inlineData)));
+
+		IHierarchicalStorageNode* loadedSeparateNode = loadedRootNode.GetChild(L"Separate");
+		REQUIRE(loadedSeparateNode != 0);
+		REQUIRE(loadedSeparateNode->GetBinaryDataPresent());
+		REQUIRE(!loadedSeparateNode->GetInlineBinaryDataEnabled());
+		REQUIRE(loadedSeparateNode->GetBinaryDataBufferName() == L"Separate.Data");
+		std::list<IHierarchicalStorageNode*> binaryDataNodes = loadedTree.GetBinaryDataNodeList();
+		REQUIRE(std::find(binaryDataNodes.begin(), binaryDataNodes.end(), loadedSeparateNode) != binaryDataNodes.end());
+	}
+}
+
+TEST_CASE("HierarchicalStorageTree XML references", "")
+{
+	HierarchicalStorageTree tree;
+	SECTION("Numeric and predefined entity references are decoded in attributes and content", "")
+	{
+		REQUIRE(LoadTreeFromUTF8Text(tree, "<Root Value=\"&#60;&#x41;&#x4a;&lt;&gt;&amp;&quot;&apos;\">x&#38;y&#x7E;</Root>"));
+		REQUIRE(tree.GetRootNode().GetAttribute(L"Value")->GetValue() == L"<AJ<>&\"'");
+		REQUIRE(tree.GetRootNode().GetData() == L"x&y~");
+	}
+	SECTION("Numeric references to characters outside the ASCII range are decoded", "")
+	{
+		REQUIRE(LoadTreeFromUTF8Text(tree, "<Root Value=\"&#xE9;&#8364;\" />"));
+		const unsigned int expectedCodeUnits[] = {0x00E9, 0x20AC};
+		REQUIRE(tree.GetRootNode().GetAttribute(L"Value")->GetValue() == BuildWideString(&expectedCodeUnits[0], 2));
+	}
+	SECTION("Literal whitespace in attribute values is normalized to spaces", "")
+	{
+		REQUIRE(LoadTreeFromUTF8Text(tree, "<Root Value=\"a\tb\r\nc\nd\" />"));
+		REQUIRE(tree.GetRootNode().GetAttribute(L"Value")->GetValue() == L"a b c d");
+	}
+}
+
+TEST_CASE("HierarchicalStorageTree XML text encodings", "")
+{
+	HierarchicalStorageTree tree;
+	SECTION("UTF-8 multibyte sequences are decoded in names, attributes and content", "")
+	{
+		REQUIRE(LoadTreeFromUTF8Text(tree, "\xEF\xBB\xBF<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<R\xC3\xA9sum\xC3\xA9 Price=\"\xE2\x82\xAC" "5\"><Face\xF0\x9F\x98\x80 /></R\xC3\xA9sum\xC3\xA9>"));
+		const unsigned int expectedNameCodeUnits[] = {'R', 0x00E9, 's', 'u', 'm', 0x00E9};
+		const unsigned int expectedPriceCodeUnits[] = {0x20AC, '5'};
+		const unsigned int expectedChildNameCodeUnits[] = {'F', 'a', 'c', 'e', 0xD83D, 0xDE00};
+		REQUIRE(tree.GetRootNode().GetName() == BuildWideString(&expectedNameCodeUnits[0], 6));
+		REQUIRE(tree.GetRootNode().GetAttribute(L"Price")->GetValue() == BuildWideString(&expectedPriceCodeUnits[0], 2));
+		REQUIRE(tree.GetRootNode().GetChild(BuildWideString(&expectedChildNameCodeUnits[0], 6)) != 0);
+	}
+	SECTION("UTF-16 text with a byte order mark is decoded", "")
+	{
+		const std::string text = "<?xml version=\"1.0\" encoding=\"UTF-16\"?>\r\n<Root Name=\"Z80\"><Child>text</Child></Root>";
+		std::vector<unsigned char> data;
+		data.push_back(0xFF);
+		data.push_back(0xFE);
+		for (size_t i = 0; i < text.size(); ++i)
+		{
+			data.push_back((unsigned char)text[i]);
+			data.push_back(0);
+		}
+		Stream::Buffer buffer(0);
+		REQUIRE(buffer.WriteData(&data[0], (Stream::IStream::SizeType)data.size()));
+		buffer.SetStreamPos(0);
+		REQUIRE(buffer.ProcessByteOrderMark());
+		REQUIRE(buffer.GetTextEncoding() == Stream::IStream::TextEncoding::UTF16);
+		REQUIRE(tree.LoadTree(buffer));
+		REQUIRE(tree.GetRootNode().GetName() == L"Root");
+		REQUIRE(tree.GetRootNode().GetAttribute(L"Name")->GetValue() == L"Z80");
+		REQUIRE(tree.GetRootNode().GetChild(L"Child")->GetData() == L"text");
+	}
+}
+
+TEST_CASE("HierarchicalStorageTree XML markup", "")
+{
+	HierarchicalStorageTree tree;
+	SECTION("Comments, processing instructions and a document type declaration before the root element are skipped", "")
+	{
+		REQUIRE(LoadTreeFromUTF8Text(tree, "<?xml version=\"1.0\"?>\n<!-- <Fake/> -->\n<!DOCTYPE Root [<!ELEMENT Root ANY>]>\n<?target data?>\n<Root />\n<!-- trailing -->"));
+		REQUIRE(tree.GetRootNode().GetName() == L"Root");
+		REQUIRE(tree.GetRootNode().GetChildList().Get().empty());
+	}
+	SECTION("Comments and processing instructions within content are skipped, and CDATA is kept verbatim", "")
+	{
+		REQUIRE(LoadTreeFromUTF8Text(tree, "<Root>a<!-- <Fake/> --><?pi <Fake/>?><![CDATA[<b>&amp;]]>c</Root>"));
+		REQUIRE(tree.GetRootNode().GetChildList().Get().empty());
+		REQUIRE(tree.GetRootNode().GetData() == L"a<b>&amp;c");
+	}
+	SECTION("Nested elements are loaded in document order", "")
+	{
+		REQUIRE(LoadTreeFromUTF8Text(tree, "<Root><A><B Value='1'/></A><A/></Root>"));
+		std::list<IHierarchicalStorageNode*> childList = tree.GetRootNode().GetChildList();
+		REQUIRE(childList.size() == 2);
+		REQUIRE(childList.front()->GetChild(L"B")->GetAttribute(L"Value")->ExtractValue<int>() == 1);
+		REQUIRE(childList.back()->GetChildList().Get().empty());
+	}
+}
+
+TEST_CASE("HierarchicalStorageTree XML errors", "")
+{
+	HierarchicalStorageTree tree;
+	SECTION("Mismatched tags", "")
+	{
+		REQUIRE(!LoadTreeFromUTF8Text(tree, "<Root>\n\t<A>\n\t</B>\n</Root>"));
+		REQUIRE(tree.GetErrorString() == L"mismatched tag at line 3");
+	}
+	SECTION("Unclosed elements", "")
+	{
+		REQUIRE(!LoadTreeFromUTF8Text(tree, "<Root>\n<A>\n"));
+		REQUIRE(tree.GetErrorString() == L"no element found at line 3");
+	}
+	SECTION("Documents without a root element", "")
+	{
+		REQUIRE(!LoadTreeFromUTF8Text(tree, "<?xml version=\"1.0\"?>\n<!-- comment -->\n"));
+		REQUIRE(tree.GetErrorString() == L"no element found at line 3");
+	}
+	SECTION("Undefined entities", "")
+	{
+		REQUIRE(!LoadTreeFromUTF8Text(tree, "<Root>\n&unknown;</Root>"));
+		REQUIRE(tree.GetErrorString() == L"undefined entity at line 2");
+	}
+	SECTION("Unterminated references", "")
+	{
+		REQUIRE(!LoadTreeFromUTF8Text(tree, "<Root Value=\"&amp\" />"));
+		REQUIRE(tree.GetErrorString() == L"not well-formed (invalid token) at line 1");
+	}
+	SECTION("References to invalid characters", "")
+	{
+		REQUIRE(!LoadTreeFromUTF8Text(tree, "<Root>&#0;</Root>"));
+		REQUIRE(tree.GetErrorString() == L"reference to invalid character number at line 1");
+		REQUIRE(!LoadTreeFromUTF8Text(tree, "<Root>&#x110000;</Root>"));
+		REQUIRE(tree.GetErrorString() == L"reference to invalid character number at line 1");
+	}
+	SECTION("Invalid UTF-8 sequences", "")
+	{
+		REQUIRE(!LoadTreeFromUTF8Text(tree, "<Root>\n\xC3\x28</Root>"));
+		REQUIRE(tree.GetErrorString() == L"not well-formed (invalid token) at line 2");
+	}
+	SECTION("Unclosed CDATA sections", "")
+	{
+		REQUIRE(!LoadTreeFromUTF8Text(tree, "<Root><![CDATA[text</Root>"));
+		REQUIRE(tree.GetErrorString() == L"unclosed CDATA section at line 1");
+	}
+	SECTION("Unclosed comments", "")
+	{
+		REQUIRE(!LoadTreeFromUTF8Text(tree, "<Root>\n<!-- text\n</Root>"));
+		REQUIRE(tree.GetErrorString() == L"unclosed token at line 3");
+	}
+	SECTION("Unquoted attribute values", "")
+	{
+		REQUIRE(!LoadTreeFromUTF8Text(tree, "<Root Value=1 />"));
+		REQUIRE(tree.GetErrorString() == L"not well-formed (invalid token) at line 1");
+	}
+	SECTION("Content after the root element", "")
+	{
+		REQUIRE(!LoadTreeFromUTF8Text(tree, "<Root />\n<Other />"));
+		REQUIRE(tree.GetErrorString() == L"junk after document element at line 2");
+	}
+	SECTION("Invalid inline binary data", "")
+	{
+		REQUIRE(!LoadTreeFromUTF8Text(tree, "<Root>\n<Data BinaryDataPresent=\"1\">12G4</Data>\n</Root>"));
+		REQUIRE(tree.GetErrorString() == L"invalid binary data at line 2");
+	}
+}
@@ -3,6 +3,8 @@
 #include "StreamInterface/StreamInterface.pkg"
 #include "MarshalSupport/MarshalSupport.pkg"
 #include <string>
+#include <type_traits>
+#include <limits>
 using namespace MarshalSupport::Operators;
 
 class IHierarchicalStorageAttribute
@@ -41,6 +43,26 @@ protected:
 	virtual void ResetInternalStreamPosition() const = 0;
 	virtual void EmptyInternalStream() = 0;
 	virtual Stream::IStream& GetInternalStream() const = 0;
+
+	// Typed value functions
+	virtual bool GetIntegerValue(bool& negative, unsigned long long& magnitude) const = 0;
+	virtual void SetIntegerValue(bool negative, unsigned long long magnitude) = 0;
+
+private:
+	// Structures
+	template<class T>
+	struct IsIntegerValueType;
+
+private:
+	// Typed value functions
+	template<class T>
+	bool ExtractIntegerValue(T& target, std::true_type) const;
+	template<class T>
+	bool ExtractIntegerValue(T& target, std::false_type) const;
+	template<class T>
+	void SetValueInternal(const T& data, std::true_type);
+	template<class T>
+	void SetValueInternal(const T& data, std::false_type);
 };
 IHierarchicalStorageAttribute::~IHierarchicalStorageAttribute() { }
 
@@ -1,3 +1,14 @@
+//----------------------------------------------------------------------------------------------------------------------
+// Structures
+//----------------------------------------------------------------------------------------------------------------------
+template<class T>
+struct IHierarchicalStorageAttribute::IsIntegerValueType :public std::integral_constant<bool,
+	std::is_same<T, short>::value || std::is_same<T, unsigned short>::value ||
+	std::is_same<T, int>::value || std::is_same<T, unsigned int>::value ||
+	std::is_same<T, long>::value || std::is_same<T, unsigned long>::value ||
+	std::is_same<T, long long>::value || std::is_same<T, unsigned long long>::value>
+{ };
+
 //----------------------------------------------------------------------------------------------------------------------
 // Value read functions
 //----------------------------------------------------------------------------------------------------------------------
@@ -15,11 +26,8 @@ std::wstring IHierarchicalStorageAttribute::GetValue() const
 template<class T>
 T IHierarchicalStorageAttribute::ExtractValue()
 {
-	ResetInternalStreamPosition();
-	Stream::IStream& buffer = GetInternalStream();
-	Stream::ViewText bufferView(buffer);
 	T data;
-	bufferView >> data;
+	ExtractValue(data);
 	return data;
 }
 
@@ -39,6 +47,13 @@ T IHierarchicalStorageAttribute::ExtractHexValue()
 template<class T>
 void IHierarchicalStorageAttribute::ExtractValue(T& target)
 {
+	// If the attribute holds an integer value in binary form, retrieve it directly rather
+	// than formatting it as text and parsing it back again.
+	if (ExtractIntegerValue(target, IsIntegerValueType<T>()))
+	{
+		return;
+	}
+
 	ResetInternalStreamPosition();
 	Stream::IStream& buffer = GetInternalStream();
 	Stream::ViewText bufferView(buffer);
@@ -61,11 +76,7 @@ void IHierarchicalStorageAttribute::ExtractHexValue(T& target)
 template<class T>
 void IHierarchicalStorageAttribute::SetValue(const T& data)
 {
-	ResetInternalStreamPosition();
-	EmptyInternalStream();
-	Stream::IStream& buffer = GetInternalStream();
-	Stream::ViewText bufferView(buffer);
-	bufferView << data;
+	SetValueInternal(data, IsIntegerValueType<T>());
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -85,3 +96,65 @@ void IHierarchicalStorageAttribute::InsertHexValue(const T& data, unsigned int l
 	Stream::ViewText bufferView(buffer);
 	bufferView << Stream::Hex(length) << data;
 }
+
+//----------------------------------------------------------------------------------------------------------------------
+// Typed value functions
+//----------------------------------------------------------------------------------------------------------------------
+template<class T>
+bool IHierarchicalStorageAttribute::ExtractIntegerValue(T& target, std::true_type) const
+{
+	// Only use the binary value if it can be represented exactly by the target type. Any
+	// other value is left to the text conversion, so that out of range values behave the
+	// same way regardless of how they were stored.
+	bool negative;
+	unsigned long long magnitude;
+	if (!GetIntegerValue(negative, magnitude))
+	{
+		return false;
+	}
+	if (negative)
+	{
+		if (!std::numeric_limits<T>::is_signed || (magnitude == 0) || ((magnitude - 1) > (unsigned long long)std::numeric_limits<T>::max()))
+		{
+			return false;
+		}
+		target = (T)(-(long long)(magnitude - 1) - 1);
+		return true;
+	}
+	if (magnitude > (unsigned long long)std::numeric_limits<T>::max())
+	{
+		return false;
+	}
+	target = (T)magnitude;
+	return true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+template<class T>
+bool IHierarchicalStorageAttribute::ExtractIntegerValue(T& target, std::false_type) const
+{
+	return false;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+template<class T>
+void IHierarchicalStorageAttribute::SetValueInternal(const T& data, std::true_type)
+{
+	// Integer values are stored in binary form, and only converted to text if the value is
+	// accessed as a stream. Note that we calculate the magnitude of a negative value
+	// through unsigned arithmetic, so that the most negative value is handled correctly.
+	bool negative = (data < (T)0);
+	unsigned long long magnitude = (negative)? (0ULL - (unsigned long long)(long long)data): (unsigned long long)data;
+	SetIntegerValue(negative, magnitude);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+template<class T>
+void IHierarchicalStorageAttribute::SetValueInternal(const T& data, std::false_type)
+{
+	ResetInternalStreamPosition();
+	EmptyInternalStream();
+	Stream::IStream& buffer = GetInternalStream();
+	Stream::ViewText bufferView(buffer);
+	bufferView << data;
+}
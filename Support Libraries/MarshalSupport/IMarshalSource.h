@@ -649,6 +649,27 @@ public:
 		Internal::MarshalObjectHelper<ElementType>::MarshalObjectToExistingObject(*sourceObject, element);
 	}
 
+	// Raw data access methods
+	inline bool GetRawData(const ElementType*& data, size_t& length) const
+	{
+		// Retrieve a pointer to the raw array contents in the source object, along with the size of each element as seen
+		// by the sender.
+		size_t elementByteSize;
+		RetrieveData(elementByteSize, data, length);
+
+		// We can only expose the source array directly if each element can be read in place. This requires that the
+		// element type has no custom marshaller, and that the element byte size reported by the sender matches our own,
+		// so that the layout of the array is the same on both sides of the boundary. If these conditions aren't met, the
+		// caller needs to fall back to marshalling a copy of the container.
+		if (Internal::has_marshal_constructor<ElementType>::value || (elementByteSize != sizeof(ElementType)))
+		{
+			data = 0;
+			length = 0;
+			return false;
+		}
+		return true;
+	}
+
 protected:
 	// Constructors
 	inline ~IMarshalSource() { }
@@ -1136,6 +1157,27 @@ public:
 		MarshalToInternal<false>(targetObject);
 	}
 
+	// Raw data access methods
+	inline bool GetRawData(const ElementType*& data, size_t& length) const
+	{
+		// Retrieve a pointer to the raw array contents in the source object, along with the size of each element as seen
+		// by the sender.
+		size_t elementByteSize;
+		RetrieveData(elementByteSize, data, length);
+
+		// We can only expose the source array directly if each element can be read in place. This requires that the
+		// element type has no custom marshaller, and that the element byte size reported by the sender matches our own,
+		// so that the layout of the array is the same on both sides of the boundary. If these conditions aren't met, the
+		// caller needs to fall back to marshalling a copy of the container.
+		if (Internal::has_marshal_constructor<ElementType>::value || (elementByteSize != sizeof(ElementType)))
+		{
+			data = 0;
+			length = 0;
+			return false;
+		}
+		return true;
+	}
+
 protected:
 	// Constructors
 	inline ~IMarshalSource() { }
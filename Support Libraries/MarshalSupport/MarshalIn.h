@@ -343,6 +343,16 @@ public:
 		_sourceReference.GetElement(index, element);
 	}
 
+	// Raw data access methods
+	inline bool GetRawData(const ElementType*& data, size_t& length) const
+	{
+		// Note that this provides read-only access to the contents of the bound collection in place, without copying it. The
+		// returned pointer is only valid while the bound object is in scope, which for a function argument is the duration
+		// of the call. If this method returns false, the element layout differs between each side of the boundary, and the
+		// caller must use one of the marshal methods above instead.
+		return _sourceReference.GetRawData(data, length);
+	}
+
 	// Implicit conversions
 	inline operator std::vector<ElementType, Alloc>() const
 	{
@@ -654,6 +664,16 @@ public:
 		_sourceReference.MarshalToWithoutMove(targetObject);
 	}
 
+	// Raw data access methods
+	inline bool GetRawData(const ElementType*& data, size_t& length) const
+	{
+		// Note that this provides read-only access to the contents of the bound string in place, without copying it. The
+		// returned pointer is only valid while the bound object is in scope, which for a function argument is the duration
+		// of the call. If this method returns false, the element layout differs between each side of the boundary, and the
+		// caller must use one of the marshal methods above instead.
+		return _sourceReference.GetRawData(data, length);
+	}
+
 	// Implicit conversions
 	inline operator std::basic_string<ElementType, traits, Alloc>() const
 	{
@@ -57,60 +57,75 @@ inline std::basic_string<ElementType, traits, Alloc> operator+(const ElementType
 	return (result);
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+// Compares the bound string against the supplied character array. Where the string can be accessed in place, this is
+// done directly against the source data without marshalling a copy of the string.
+template<class ElementType, class traits, class Alloc>
+inline bool IsInStringEqual(const In<std::basic_string<ElementType, traits, Alloc>>& left, const ElementType* rightData, size_t rightLength)
+{
+	const ElementType* leftData;
+	size_t leftLength;
+	if (!left.GetRawData(leftData, leftLength))
+	{
+		return (left.GetWithoutMove().compare(0, std::basic_string<ElementType, traits, Alloc>::npos, rightData, rightLength) == 0);
+	}
+	return (leftLength == rightLength) && (traits::compare(leftData, rightData, leftLength) == 0);
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 template<class ElementType, class traits, class Alloc>
 bool operator==(const In<std::basic_string<ElementType, traits, Alloc>>& left, const std::basic_string<ElementType, traits, Alloc>& right)
 {
-	return (left.GetWithoutMove() == right);
+	return IsInStringEqual(left, right.data(), right.size());
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 template<class ElementType, class traits, class Alloc>
 bool operator==(const std::basic_string<ElementType, traits, Alloc>& left, const In<std::basic_string<ElementType, traits, Alloc>>& right)
 {
-	return (right.GetWithoutMove() == left);
+	return IsInStringEqual(right, left.data(), left.size());
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 template<class ElementType, class traits, class Alloc>
 bool operator==(const In<std::basic_string<ElementType, traits, Alloc>>& left, const ElementType *right)
 {
-	return (left.GetWithoutMove() == right);
+	return IsInStringEqual(left, right, traits::length(right));
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 template<class ElementType, class traits, class Alloc>
 bool operator==(const ElementType * left, const In<std::basic_string<ElementType, traits, Alloc>>& right)
 {
-	return (right.GetWithoutMove() == left);
+	return IsInStringEqual(right, left, traits::length(left));
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 template<class ElementType, class traits, class Alloc>
 bool operator!=(const In<std::basic_string<ElementType, traits, Alloc>>& left, const std::basic_string<ElementType, traits, Alloc>& right)
 {
-	return (left.GetWithoutMove() != right);
+	return !IsInStringEqual(left, right.data(), right.size());
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 template<class ElementType, class traits, class Alloc>
 bool operator!=(const std::basic_string<ElementType, traits, Alloc>& left, const In<std::basic_string<ElementType, traits, Alloc>>& right)
 {
-	return (right.GetWithoutMove() != left);
+	return !IsInStringEqual(right, left.data(), left.size());
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 template<class ElementType, class traits, class Alloc>
 bool operator!=(const In<std::basic_string<ElementType, traits, Alloc>>& left, const ElementType *right)
 {
-	return (left.GetWithoutMove() != right);
+	return !IsInStringEqual(left, right, traits::length(right));
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 template<class ElementType, class traits, class Alloc>
 bool operator!=(const ElementType *left, const In<std::basic_string<ElementType, traits, Alloc>>& right)
 {
-	return (right.GetWithoutMove() != left);
+	return !IsInStringEqual(right, left, traits::length(left));
 }
 
 //----------------------------------------------------------------------------------------------------------------------
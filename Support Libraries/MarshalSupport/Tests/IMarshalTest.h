@@ -232,6 +232,9 @@ public:
 	virtual void OutTestVectorExtensions02(const Marshal::Out<std::vector<CustomMarshalObject>>& marshaller) const = 0;
 	virtual void OutTestVectorExtensions11(const Marshal::Out<std::vector<int>>& marshaller) const = 0;
 	virtual void OutTestVectorExtensions12(const Marshal::Out<std::vector<CustomMarshalObject>>& marshaller) const = 0;
+	virtual bool InTestVectorExtensions21(const Marshal::In<std::vector<int>>& marshaller) const = 0;
+	virtual bool InTestVectorExtensions22(const Marshal::In<std::vector<CustomMarshalObject>>& marshaller) const = 0;
+	virtual bool InTestVectorExtensions23(const Marshal::In<std::string>& marshaller) const = 0;
 
 	//std::pair tests
 	virtual bool InTestPair01(const Marshal::In<std::pair<std::wstring, int>>& marshaller) const = 0;
@@ -17,6 +17,9 @@ public:
 	virtual void StringInNoMarshalling(const char* data, std::string& out) const = 0;
 	virtual void StringInNoMarshallingWithSize(const char* data, size_t length, std::string& out) const = 0;
 	virtual void StringInWithMarshalling(const Marshal::In<std::string>& data, std::string& out) const = 0;
+	virtual void StringChecksumNoMarshallingWithSize(const char* data, size_t length, unsigned int& checksum) const = 0;
+	virtual void StringChecksumWithMarshalling(const Marshal::In<std::string>& data, unsigned int& checksum) const = 0;
+	virtual void StringChecksumWithMarshallingRawData(const Marshal::In<std::string>& data, unsigned int& checksum) const = 0;
 
 	virtual void FillVectorNoMarshalling(double* data, size_t entryCount, std::vector<double>& out) const = 0;
 	virtual void FillVectorNoMarshallingPushBack(double* data, size_t entryCount, std::vector<double>& out) const = 0;
@@ -26,6 +29,10 @@ public:
 	virtual void FillVectorWithMarshallingPushBack(double* data, size_t entryCount, const Marshal::Out<std::vector<double>>& out) const = 0;
 	virtual void FillVectorWithMarshallingAssign(double* data, size_t entryCount, const Marshal::Out<std::vector<double>>& out) const = 0;
 	virtual void FillVectorWithMarshallingConstruct(double* data, size_t entryCount, const Marshal::Out<std::vector<double>>& out) const = 0;
+
+	virtual void SumVectorNoMarshalling(const double* data, size_t entryCount, double& sum) const = 0;
+	virtual void SumVectorWithMarshalling(const Marshal::In<std::vector<double>>& data, double& sum) const = 0;
+	virtual void SumVectorWithMarshallingRawData(const Marshal::In<std::vector<double>>& data, double& sum) const = 0;
 };
 
 #endif
@@ -711,6 +711,42 @@ protected:
 		std::vector<CustomMarshalObject> data = testData.testCustomMarshaller01;
 		marshaller.AssignFrom(&data[0], data.size());
 	}
+	virtual bool InTestVectorExtensions21(const Marshal::In<std::vector<int>>& marshaller) const
+	{
+		const int* data;
+		size_t length;
+		if(!marshaller.GetRawData(data, length))
+		{
+			return false;
+		}
+		return CompareTestData(std::vector<int>(data, data + length), testData.testVectorExtensions01);
+	}
+	virtual bool InTestVectorExtensions22(const Marshal::In<std::vector<CustomMarshalObject>>& marshaller) const
+	{
+		// Elements with a custom marshaller can't be accessed in place, so we need to fall back to marshalling a copy here
+		const CustomMarshalObject* data;
+		size_t length;
+		if(marshaller.GetRawData(data, length))
+		{
+			return false;
+		}
+		return CompareTestData(marshaller.Get(), testData.testCustomMarshaller01);
+	}
+	virtual bool InTestVectorExtensions23(const Marshal::In<std::string>& marshaller) const
+	{
+		const char* data;
+		size_t length;
+		if(!marshaller.GetRawData(data, length))
+		{
+			return false;
+		}
+		bool result = CompareTestData(std::string(data, length), testData.testPrimitive33);
+		result &= (marshaller == testData.testPrimitive33);
+		result &= (marshaller == testData.testPrimitive33.c_str());
+		result &= !(marshaller != testData.testPrimitive33);
+		result &= (marshaller != "1234");
+		return result;
+	}
 #ifdef MARSHALSUPPORT_CPP11SUPPORTED
 	virtual void OutTestVectorExtensions14(const Marshal::Out<std::vector<MoveTypeNoCopy>>& marshaller) const
 	{
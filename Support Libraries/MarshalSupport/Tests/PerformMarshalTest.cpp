@@ -92,6 +92,9 @@ extern "C" __declspec(dllexport) bool MarshalTestVectorExtensions(IMarshalTestBa
 	result &= CompareTestData(testData.testCustomMarshaller01, testExtensions02);
 	result &= CompareTestData(testData.testVectorExtensions01, testExtensions11);
 	result &= CompareTestData(testData.testCustomMarshaller01, testExtensions12);
+	result &= marshalTest.InTestVectorExtensions21(testData.testVectorExtensions01);
+	result &= marshalTest.InTestVectorExtensions22(testData.testCustomMarshaller01);
+	result &= marshalTest.InTestVectorExtensions23(testData.testPrimitive33);
 
 #ifdef MARSHALSUPPORT_CPP11SUPPORTED
 	if(marshalTest.Version() > 0)
@@ -15,6 +15,33 @@ void PerformanceTest::StringInWithMarshalling(const Marshal::In<std::string>& da
 	data.Get(out);
 }
 
+void PerformanceTest::StringChecksumNoMarshallingWithSize(const char* data, size_t length, unsigned int& checksum) const
+{
+	checksum = 0;
+	for(size_t i = 0; i < length; ++i)
+	{
+		checksum = (checksum * 31) + (unsigned char)data[i];
+	}
+}
+
+void PerformanceTest::StringChecksumWithMarshalling(const Marshal::In<std::string>& data, unsigned int& checksum) const
+{
+	std::string dataAsString = data.GetWithoutMove();
+	StringChecksumNoMarshallingWithSize(dataAsString.data(), dataAsString.size(), checksum);
+}
+
+void PerformanceTest::StringChecksumWithMarshallingRawData(const Marshal::In<std::string>& data, unsigned int& checksum) const
+{
+	const char* rawData;
+	size_t rawDataLength;
+	if(!data.GetRawData(rawData, rawDataLength))
+	{
+		StringChecksumWithMarshalling(data, checksum);
+		return;
+	}
+	StringChecksumNoMarshallingWithSize(rawData, rawDataLength, checksum);
+}
+
 void PerformanceTest::FillVectorNoMarshalling(double* data, size_t entryCount, std::vector<double>& out) const
 {
 	out.resize(entryCount);
@@ -72,3 +99,30 @@ void PerformanceTest::FillVectorWithMarshallingConstruct(double* data, size_t en
 {
 	out = std::vector<double>(data, (data + entryCount));
 }
+
+void PerformanceTest::SumVectorNoMarshalling(const double* data, size_t entryCount, double& sum) const
+{
+	sum = 0;
+	for(size_t i = 0; i < entryCount; ++i)
+	{
+		sum += data[i];
+	}
+}
+
+void PerformanceTest::SumVectorWithMarshalling(const Marshal::In<std::vector<double>>& data, double& sum) const
+{
+	std::vector<double> dataAsVector = data.GetWithoutMove();
+	SumVectorNoMarshalling(dataAsVector.data(), dataAsVector.size(), sum);
+}
+
+void PerformanceTest::SumVectorWithMarshallingRawData(const Marshal::In<std::vector<double>>& data, double& sum) const
+{
+	const double* rawData;
+	size_t rawDataLength;
+	if(!data.GetRawData(rawData, rawDataLength))
+	{
+		SumVectorWithMarshalling(data, sum);
+		return;
+	}
+	SumVectorNoMarshalling(rawData, rawDataLength, sum);
+}
@@ -7,6 +7,9 @@ class PerformanceTest :public IPerformanceTest
 	virtual void StringInNoMarshalling(const char* data, std::string& out) const;
 	virtual void StringInNoMarshallingWithSize(const char* data, size_t length, std::string& out) const;
 	virtual void StringInWithMarshalling(const Marshal::In<std::string>& data, std::string& out) const;
+	virtual void StringChecksumNoMarshallingWithSize(const char* data, size_t length, unsigned int& checksum) const;
+	virtual void StringChecksumWithMarshalling(const Marshal::In<std::string>& data, unsigned int& checksum) const;
+	virtual void StringChecksumWithMarshallingRawData(const Marshal::In<std::string>& data, unsigned int& checksum) const;
 
 	virtual void FillVectorNoMarshalling(double* data, size_t entryCount, std::vector<double>& out) const;
 	virtual void FillVectorNoMarshallingPushBack(double* data, size_t entryCount, std::vector<double>& out) const;
@@ -16,6 +19,10 @@ class PerformanceTest :public IPerformanceTest
 	virtual void FillVectorWithMarshallingPushBack(double* data, size_t entryCount, const Marshal::Out<std::vector<double>>& out) const;
 	virtual void FillVectorWithMarshallingAssign(double* data, size_t entryCount, const Marshal::Out<std::vector<double>>& out) const;
 	virtual void FillVectorWithMarshallingConstruct(double* data, size_t entryCount, const Marshal::Out<std::vector<double>>& out) const;
+
+	virtual void SumVectorNoMarshalling(const double* data, size_t entryCount, double& sum) const;
+	virtual void SumVectorWithMarshalling(const Marshal::In<std::vector<double>>& data, double& sum) const;
+	virtual void SumVectorWithMarshallingRawData(const Marshal::In<std::vector<double>>& data, double& sum) const;
 };
 
 #endif
@@ -13,13 +13,16 @@ int main()
 	std::chrono::duration<float> secs = t1_cpu - t0_cpu;
 
 	std::cout << "MarshalSupport std::string performance test" << std::endl;
-	std::cout << "\t\tchar*\t\tchar* + size\tMarshal" << std::endl;
+	std::cout << "\t\tchar*\t\tchar* + size\tMarshal\t\tRead char*\tRead Marshal\tRead RawData" << std::endl;
 
 	std::cout << std::showpoint << std::fixed << std::setprecision(8);
 
 	std::string stringResult0;
 	std::string stringResult1;
 	std::string stringResult2;
+	unsigned int checksumResult0;
+	unsigned int checksumResult1;
+	unsigned int checksumResult2;
 	unsigned int stringLoopCount = 10000000;
 	unsigned int stringLength = 98;
 	bool enableOutput = false;
@@ -62,6 +65,35 @@ int main()
 		}
 		t1_cpu = std::chrono::high_resolution_clock::now();
 		secs = t1_cpu - t0_cpu;
+		if(enableOutput) std::cout << secs.count() << '\t';
+
+		// The following tests cover the case where the callee only needs to read the string, and doesn't retain a copy of
+		// it. Reading the bound string in place through GetRawData avoids marshalling a copy of it.
+		t0_cpu = std::chrono::high_resolution_clock::now();
+		for(unsigned int j = 0; j < stringLoopCount; j++)
+		{
+			performanceTestInterface->StringChecksumNoMarshallingWithSize(testString.c_str(), testString.length(), checksumResult0);
+		}
+		t1_cpu = std::chrono::high_resolution_clock::now();
+		secs = t1_cpu - t0_cpu;
+		if(enableOutput) std::cout << secs.count() << '\t';
+
+		t0_cpu = std::chrono::high_resolution_clock::now();
+		for(unsigned int j = 0; j < stringLoopCount; j++)
+		{
+			performanceTestInterface->StringChecksumWithMarshalling(testString, checksumResult1);
+		}
+		t1_cpu = std::chrono::high_resolution_clock::now();
+		secs = t1_cpu - t0_cpu;
+		if(enableOutput) std::cout << secs.count() << '\t';
+
+		t0_cpu = std::chrono::high_resolution_clock::now();
+		for(unsigned int j = 0; j < stringLoopCount; j++)
+		{
+			performanceTestInterface->StringChecksumWithMarshallingRawData(testString, checksumResult2);
+		}
+		t1_cpu = std::chrono::high_resolution_clock::now();
+		secs = t1_cpu - t0_cpu;
 		if(enableOutput) std::cout << secs.count() << '\n';
 
 		stringLength = (stringLength + 1) % 100;
@@ -103,6 +103,8 @@ int main()
 	std::vector<double> result1;
 	std::vector<double> result2;
 	std::vector<double> result3;
+	std::vector<double> readData[4] = {std::vector<double>(M, 1), std::vector<double>(M, 2), std::vector<double>(M, 3), std::vector<double>(M, 4)};
+	double sumResult[4];
 
 	if(columnOutput)
 	{
@@ -299,8 +301,60 @@ int main()
 		secs = t1_cpu - t0_cpu;
 		durations[3][2] = secs;
 		if(!columnOutput) std::cout << "\t" << secs.count() << " " << (int)((secs.count() / durations[3][0].count()) * 100) << "%";
-		if(checkResult) CheckResult(data, result0, result1, result2, result3);
-		if(clearResult) ClearResult(result0, result1, result2, result3);
+		if(checkResult) CheckResult(data, result0, result1, result2, result3);
+		if(clearResult) ClearResult(result0, result1, result2, result3);
+
+		// The following tests cover the case where the callee only needs to read the vector, and doesn't retain a copy of
+		// it. Reading the bound vector in place through GetRawData avoids marshalling a copy of it.
+		if(!columnOutput)
+		{
+			std::cout << std::endl << "Read\tNative\t\tMarshal\t\tRawData" << std::endl;
+			t0_cpu = std::chrono::high_resolution_clock::now();
+			for(int j = 0; j < N; j++)
+			{
+				for(int i = 0; i < 4; ++i)
+				{
+					performanceTestInterface->SumVectorNoMarshalling(readData[i].data(), M, sumResult[i]);
+				}
+			}
+			t1_cpu = std::chrono::high_resolution_clock::now();
+			std::chrono::duration<float> readNativeSecs = t1_cpu - t0_cpu;
+			std::cout << "\t" << readNativeSecs.count();
+
+			t0_cpu = std::chrono::high_resolution_clock::now();
+			for(int j = 0; j < N; j++)
+			{
+				for(int i = 0; i < 4; ++i)
+				{
+					performanceTestInterface->SumVectorWithMarshalling(readData[i], sumResult[i]);
+				}
+			}
+			t1_cpu = std::chrono::high_resolution_clock::now();
+			secs = t1_cpu - t0_cpu;
+			std::cout << "\t" << secs.count() << " " << (int)((secs.count() / readNativeSecs.count()) * 100) << "%";
+
+			t0_cpu = std::chrono::high_resolution_clock::now();
+			for(int j = 0; j < N; j++)
+			{
+				for(int i = 0; i < 4; ++i)
+				{
+					performanceTestInterface->SumVectorWithMarshallingRawData(readData[i], sumResult[i]);
+				}
+			}
+			t1_cpu = std::chrono::high_resolution_clock::now();
+			secs = t1_cpu - t0_cpu;
+			std::cout << "\t" << secs.count() << " " << (int)((secs.count() / readNativeSecs.count()) * 100) << "%";
+			if(checkResult)
+			{
+				for(int i = 0; i < 4; ++i)
+				{
+					if(sumResult[i] != ((double)M * (i + 1)))
+					{
+						std::cout << "ERROR!";
+					}
+				}
+			}
+		}
 
 		if(columnOutput)
 		{
@@ -0,0 +1,80 @@
+#include "FileMapping.h"
+namespace Stream {
+
+//----------------------------------------------------------------------------------------------------------------------
+// Constructors
+//----------------------------------------------------------------------------------------------------------------------
+FileMapping::~FileMapping()
+{
+	Close();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// File binding
+//----------------------------------------------------------------------------------------------------------------------
+bool FileMapping::Open(const std::wstring& filename, bool copyOnWrite)
+{
+	// If a file is currently mapped, close it.
+	if (IsOpen())
+	{
+		Close();
+	}
+
+	// Open the target file. Note that we allow other processes to read, write, and delete the file while it's open, so
+	// that tools which rebuild the file aren't locked out while it's mapped. The file handle is only held until the
+	// mapping object has been created below.
+	HANDLE fileHandle = CreateFile(filename.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (fileHandle == INVALID_HANDLE_VALUE)
+	{
+		return false;
+	}
+
+	// Retrieve the size of the file. Empty files can't be mapped, and we don't support mapping files which can't be
+	// addressed in their entirety within our address space.
+	LARGE_INTEGER fileSize;
+	if ((GetFileSizeEx(fileHandle, &fileSize) == 0) || (fileSize.QuadPart <= 0) || ((unsigned long long)fileSize.QuadPart > (unsigned long long)((size_t)-1)))
+	{
+		CloseHandle(fileHandle);
+		return false;
+	}
+
+	// Create a read only mapping of the file, and map a view of the entire file into our address space. If copy on
+	// write has been requested, we request a copy on write view, which allows the mapped data to be modified without
+	// affecting the underlying file or any other views of it. The mapping object holds its own reference to the file,
+	// so we release our file handle as soon as the mapping has been created.
+	_mappingHandle = CreateFileMapping(fileHandle, NULL, PAGE_READONLY, 0, 0, NULL);
+	CloseHandle(fileHandle);
+	if (_mappingHandle == NULL)
+	{
+		return false;
+	}
+	_mappedData = (unsigned char*)MapViewOfFile(_mappingHandle, (copyOnWrite? FILE_MAP_COPY: FILE_MAP_READ), 0, 0, 0);
+	if (_mappedData == 0)
+	{
+		CloseHandle(_mappingHandle);
+		_mappingHandle = NULL;
+		return false;
+	}
+
+	// Flag that a file is mapped, and return true.
+	_mappedDataSize = (size_t)fileSize.QuadPart;
+	_copyOnWrite = copyOnWrite;
+	_fileOpen = true;
+	return true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void FileMapping::Close()
+{
+	if (_fileOpen)
+	{
+		UnmapViewOfFile(_mappedData);
+		CloseHandle(_mappingHandle);
+		_mappedData = 0;
+		_mappedDataSize = 0;
+		_mappingHandle = NULL;
+		_fileOpen = false;
+	}
+}
+
+} // Close namespace Stream
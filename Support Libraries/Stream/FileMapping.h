@@ -0,0 +1,43 @@
+#ifndef __FILEMAPPING_H__
+#define __FILEMAPPING_H__
+#include <string>
+#include "WindowsSupport/WindowsSupport.pkg"
+namespace Stream {
+
+// This class maps the contents of a file directly into the address space of the process, allowing the file data to be
+// accessed without being copied into a separate buffer. Where multiple mappings are opened for the same file, the
+// operating system will share a single physical copy of the file data between them. When opened in copy on write
+// mode, the mapped data may be modified, in which case only the modified pages become private to this mapping, and the
+// changes are never written back to the file. Note that the file isn't locked against writes while it's mapped. If the
+// file is rewritten in place, any pages which haven't been modified through this mapping will reflect the new contents.
+class FileMapping
+{
+public:
+	// Make sure the FileMapping object is non-copyable
+	protected: FileMapping(const FileMapping& object) { } public:
+
+	// Constructors
+	inline FileMapping();
+	~FileMapping();
+
+	// File binding
+	bool Open(const std::wstring& filename, bool copyOnWrite = false);
+	void Close();
+	inline bool IsOpen() const;
+
+	// Data functions
+	inline size_t Size() const;
+	inline const unsigned char* GetData() const;
+	inline unsigned char* GetWritableData() const;
+
+private:
+	bool _fileOpen;
+	bool _copyOnWrite;
+	HANDLE _mappingHandle;
+	unsigned char* _mappedData;
+	size_t _mappedDataSize;
+};
+
+} // Close namespace Stream
+#include "FileMapping.inl"
+#endif
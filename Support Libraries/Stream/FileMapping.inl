@@ -0,0 +1,40 @@
+namespace Stream {
+
+//----------------------------------------------------------------------------------------------------------------------
+// Constructors
+//----------------------------------------------------------------------------------------------------------------------
+FileMapping::FileMapping()
+:_fileOpen(false), _copyOnWrite(false), _mappingHandle(NULL), _mappedData(0), _mappedDataSize(0)
+{ }
+
+//----------------------------------------------------------------------------------------------------------------------
+// File binding
+//----------------------------------------------------------------------------------------------------------------------
+bool FileMapping::IsOpen() const
+{
+	return _fileOpen;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Data functions
+//----------------------------------------------------------------------------------------------------------------------
+size_t FileMapping::Size() const
+{
+	return _mappedDataSize;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+const unsigned char* FileMapping::GetData() const
+{
+	return _mappedData;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+unsigned char* FileMapping::GetWritableData() const
+{
+	// Writes are only permitted into a copy on write mapping. Since a read only view will trigger an access violation
+	// on the first write, we return null here rather than handing out a pointer which can't be used.
+	return (_copyOnWrite)? _mappedData: 0;
+}
+
+} // Close namespace Stream
@@ -406,6 +406,18 @@ bool BusInterface::BuildMapEntry(MapEntry& mapEntry, IDevice* device, const Devi
 		}
 	}
 
+	// If the target device supports fixed width access for this interface at the same width
+	// as the data bus, and no data line remapping is required, latch the access width so
+	// that memory accesses through this mapping can bypass the generic Data path.
+	if (memoryMapping && !mapEntry.remapDataLines)
+	{
+		unsigned int fixedWidthBitCount = device->GetFixedWidthInterfaceBitCount(mapEntry.interfaceNumber);
+		if ((fixedWidthBitCount == busMappingDataBusWidth) && ((fixedWidthBitCount == 8) || (fixedWidthBitCount == 16) || (fixedWidthBitCount == 32)))
+		{
+			mapEntry.fixedWidthAccessBitCount = fixedWidthBitCount;
+		}
+	}
+
 	return true;
 }
 
@@ -2434,6 +2446,23 @@ BusInterface::MapEntry* BusInterface::ResolveMemoryAddress(unsigned int ce, unsi
 	return 0;
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+template<class DataType>
+BusInterface::AccessResult BusInterface::ReadMemoryFixedWidth(const MapEntry* mapEntry, unsigned int interfaceOffset, Data& data, IDeviceContext* caller, double accessTime, unsigned int accessContext) const
+{
+	DataType fixedWidthData = (DataType)data.GetData();
+	AccessResult accessResult = mapEntry->device->ReadInterfaceFixedWidth(mapEntry->interfaceNumber, interfaceOffset, fixedWidthData, caller, accessTime, accessContext);
+	data.SetData(fixedWidthData);
+	return accessResult;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+template<class DataType>
+BusInterface::AccessResult BusInterface::WriteMemoryFixedWidth(const MapEntry* mapEntry, unsigned int interfaceOffset, const Data& data, IDeviceContext* caller, double accessTime, unsigned int accessContext) const
+{
+	return mapEntry->device->WriteInterfaceFixedWidth(mapEntry->interfaceNumber, interfaceOffset, (DataType)data.GetData(), caller, accessTime, accessContext);
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 BusInterface::AccessResult BusInterface::ReadMemory(unsigned int location, Data& data, IDeviceContext* caller, double accessTime, unsigned int accessContext, void* calculateCELineStateContext)
 {
@@ -2479,6 +2508,22 @@ BusInterface::AccessResult BusInterface::ReadMemory(unsigned int location, Data&
 				accessResult.accessMask = mapEntry->dataLineRemapTable.GetBitMaskOriginalLinesPreserved();
 			}
 		}
+		else if (mapEntry->fixedWidthAccessBitCount == data.GetBitCount())
+		{
+			// Perform the access through the fixed width interface of the device
+			switch (mapEntry->fixedWidthAccessBitCount)
+			{
+			case 8:
+				accessResult = ReadMemoryFixedWidth<unsigned char>(mapEntry, interfaceOffset, data, caller, accessTime, accessContext);
+				break;
+			case 16:
+				accessResult = ReadMemoryFixedWidth<unsigned short>(mapEntry, interfaceOffset, data, caller, accessTime, accessContext);
+				break;
+			case 32:
+				accessResult = ReadMemoryFixedWidth<unsigned int>(mapEntry, interfaceOffset, data, caller, accessTime, accessContext);
+				break;
+			}
+		}
 		else
 		{
 			accessResult = mapEntry->device->ReadInterface(mapEntry->interfaceNumber, interfaceOffset, data, caller, accessTime, accessContext);
@@ -2514,6 +2559,22 @@ BusInterface::AccessResult BusInterface::WriteMemory(unsigned int location, cons
 			tempData = mapEntry->dataLineRemapTable.ConvertTo(data.GetData());
 			accessResult = mapEntry->device->WriteInterface(mapEntry->interfaceNumber, interfaceOffset, tempData, caller, accessTime, accessContext);
 		}
+		else if (mapEntry->fixedWidthAccessBitCount == data.GetBitCount())
+		{
+			// Perform the access through the fixed width interface of the device
+			switch (mapEntry->fixedWidthAccessBitCount)
+			{
+			case 8:
+				accessResult = WriteMemoryFixedWidth<unsigned char>(mapEntry, interfaceOffset, data, caller, accessTime, accessContext);
+				break;
+			case 16:
+				accessResult = WriteMemoryFixedWidth<unsigned short>(mapEntry, interfaceOffset, data, caller, accessTime, accessContext);
+				break;
+			case 32:
+				accessResult = WriteMemoryFixedWidth<unsigned int>(mapEntry, interfaceOffset, data, caller, accessTime, accessContext);
+				break;
+			}
+		}
 		else
 		{
 			accessResult = mapEntry->device->WriteInterface(mapEntry->interfaceNumber, interfaceOffset, data, caller, accessTime, accessContext);
@@ -186,6 +186,10 @@ private:
 
 	// Memory interface functions
 	MapEntry* ResolveMemoryAddress(unsigned int ce, unsigned int location) const;
+	template<class DataType>
+	inline AccessResult ReadMemoryFixedWidth(const MapEntry* mapEntry, unsigned int interfaceOffset, Data& data, IDeviceContext* caller, double accessTime, unsigned int accessContext) const;
+	template<class DataType>
+	inline AccessResult WriteMemoryFixedWidth(const MapEntry* mapEntry, unsigned int interfaceOffset, const Data& data, IDeviceContext* caller, double accessTime, unsigned int accessContext) const;
 
 	// Port interface functions
 	MapEntry* ResolvePortAddress(unsigned int ce, unsigned int location) const;
@@ -120,7 +120,8 @@ struct BusInterface::MapEntry
 	 interfaceOffset(0),
 	 interfaceNumber(0),
 	 remapAddressLines(false),
-	 remapDataLines(false)
+	 remapDataLines(false),
+	 fixedWidthAccessBitCount(0)
 	{ }
 
 	unsigned int address;
@@ -140,6 +141,7 @@ struct BusInterface::MapEntry
 	bool remapDataLines;
 	DataRemapTable addressLineRemapTable;
 	DataRemapTable dataLineRemapTable;
+	unsigned int fixedWidthAccessBitCount;
 };
 
 //----------------------------------------------------------------------------------------------------------------------
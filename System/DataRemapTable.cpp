@@ -1,12 +1,17 @@
 #include "DataRemapTable.h"
 #include "DataConversion/DataConversion.pkg"
 #include <list>
+#if defined(_M_IX86) || defined(_M_X64)
+#include <intrin.h>
+#include <immintrin.h>
+#define DATAREMAPTABLE_PARALLEL_BIT_OPERATIONS
+#endif
 
 //----------------------------------------------------------------------------------------------------------------------
 // Constructors
 //----------------------------------------------------------------------------------------------------------------------
 DataRemapTable::DataRemapTable()
-:_conversionTableStateSetManually(false)
+:_conversionTableStateSetManually(false), _useMethodConversionTableTo(false), _useMethodConversionTableFrom(false)
 {
 	// Set the default maximum bit counts for our conversion tables to 20 bits, which gives
 	// us a maximum table size of 1 MegaByte.
@@ -145,6 +150,8 @@ bool DataRemapTable::SetDataMapping(const std::wstring& mappingString, unsigned
 	_discardBottomBitCount = 0;
 	_discardTopBitCount = 0;
 	_forcedSetBitMaskInConverted = 0;
+	_dataBitMappings.clear();
+	_dataBitMappingsSize = 0;
 
 	// Process our mapping elements, and build our mapping settings.
 	unsigned int highestSourceBitNumberUsed = 0;
@@ -206,6 +213,8 @@ bool DataRemapTable::SetDataMapping(const std::wstring& mappingString, unsigned
 			BitMapping bitMappingEntry;
 			bitMappingEntry.bitMaskOriginal = 1 << i->sourceDataBitNumber;
 			bitMappingEntry.bitMaskConverted = 1 << _bitCountConverted;
+			bitMappingEntry.bitNumberOriginal = i->sourceDataBitNumber;
+			bitMappingEntry.bitNumberConverted = _bitCountConverted;
 			_dataBitMappings.push_back(bitMappingEntry);
 			_dataBitMappingsSize = (unsigned int)_dataBitMappings.size();
 
@@ -233,33 +242,36 @@ bool DataRemapTable::SetDataMapping(const std::wstring& mappingString, unsigned
 	_discardBottomBitCount = lowestSourceBitNumberUsed;
 	_discardTopBitCount = (sourceBitCount - 1) - highestSourceBitNumberUsed;
 
-	// If the relative order of all used source bits is maintained by the mapping, flag
-	// that we can use the shift and mask method to perform the conversion.
-	_useMethodShiftAndMask = allSourceBitsInRelativeOrder;
-
-	// Determine whether to use physical conversion tables
-	if (!_conversionTableStateSetManually)
+	// Select the conversion method to use for this mapping. We try each specialised method
+	// in order of increasing cost. Any mapping can be handled by the byte lookup table
+	// method, which performs at most one table read for each byte of the source data.
+	ConversionMethod conversionMethod;
+	if (allSourceBitsInRelativeOrder)
 	{
-		// Only build conversion tables if we can't use the shift and mask method. The
-		// shift and mask method is so efficient, the table method is almost certainly
-		// going to be slower due to the latency involved in memory access, and the high
-		// likelihood of a cache miss with a conversion table.
-		if (!_useMethodShiftAndMask)
-		{
-			_useMethodConversionTableTo = ((_bitCountOriginal - (_discardBottomBitCount + _discardTopBitCount)) <= _conversionTableToMaxBitCount);
-			_useMethodConversionTableFrom = ((_bitCountConverted - (_insertBottomBitCount + _insertTopBitCount)) <= _conversionTableFromMaxBitCount);
-		}
-		else
-		{
-			_useMethodConversionTableTo = false;
-			_useMethodConversionTableFrom = false;
-		}
+		conversionMethod = ConversionMethod::ShiftAndMask;
 	}
-
-	// Build the physical conversion tables
-	if (_useMethodConversionTableTo)
+	else if (BuildBitSegments())
+	{
+		conversionMethod = ConversionMethod::BitSegments;
+	}
+	else if (IsBitOrderPreserved() && IsParallelBitOperationSupported())
+	{
+		conversionMethod = ConversionMethod::ParallelBitExtract;
+	}
+	else
+	{
+		BuildByteLookupTables();
+		conversionMethod = ConversionMethod::ByteLookupTable;
+	}
+	_conversionMethodTo = conversionMethod;
+	_conversionMethodFrom = conversionMethod;
+
+	// Build the physical conversion tables if they've been requested. We only build these
+	// tables on request, since the methods above are all within a few instructions of a
+	// single table read, without the memory cost or cache pressure of a table which covers
+	// the entire range of values.
+	if (_conversionTableStateSetManually && _useMethodConversionTableTo && ((_bitCountOriginal - (_discardBottomBitCount + _discardTopBitCount)) <= _conversionTableToMaxBitCount))
 	{
-		_useMethodConversionTableTo = false;
 		unsigned int conversionTableToSize = (1 << (_bitCountOriginal - (_discardBottomBitCount + _discardTopBitCount)));
 		_conversionTableTo.resize(conversionTableToSize, 0);
 		unsigned int nextNumber = 0;
@@ -268,11 +280,10 @@ bool DataRemapTable::SetDataMapping(const std::wstring& mappingString, unsigned
 			_conversionTableTo[i] = ConvertTo(nextNumber);
 			nextNumber += (1 << _discardBottomBitCount);
 		}
-		_useMethodConversionTableTo = true;
+		_conversionMethodTo = ConversionMethod::ConversionTable;
 	}
-	if (_useMethodConversionTableFrom)
+	if (_conversionTableStateSetManually && _useMethodConversionTableFrom && ((_bitCountConverted - (_insertBottomBitCount + _insertTopBitCount)) <= _conversionTableFromMaxBitCount))
 	{
-		_useMethodConversionTableFrom = false;
 		unsigned int conversionTableFromSize = (1 << (_bitCountConverted - (_insertBottomBitCount + _insertTopBitCount)));
 		_conversionTableFrom.resize(conversionTableFromSize, 0);
 		unsigned int nextNumber = 0;
@@ -281,12 +292,114 @@ bool DataRemapTable::SetDataMapping(const std::wstring& mappingString, unsigned
 			_conversionTableFrom[i] = ConvertFrom(nextNumber);
 			nextNumber += (1 << _insertBottomBitCount);
 		}
-		_useMethodConversionTableFrom = true;
+		_conversionMethodFrom = ConversionMethod::ConversionTable;
 	}
 
 	return true;
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+// Conversion method selection functions
+//----------------------------------------------------------------------------------------------------------------------
+bool DataRemapTable::BuildBitSegments()
+{
+	// Group our bit mappings into runs of adjacent source bits which remain adjacent after
+	// conversion. Since our bit mappings are ordered from the lowest converted bit upwards,
+	// each run can be built up in a single pass. If the mapping breaks down into more runs
+	// than we allow for, this method isn't suitable for the mapping.
+	_bitSegments.clear();
+	_bitSegmentsSize = 0;
+	for (unsigned int i = 0; i < _dataBitMappingsSize; ++i)
+	{
+		// If this bit continues the previous run, add it to the current segment.
+		const BitMapping& bitMapping = _dataBitMappings[i];
+		if ((i > 0) && (bitMapping.bitNumberOriginal == (_dataBitMappings[i - 1].bitNumberOriginal + 1)) && (bitMapping.bitNumberConverted == (_dataBitMappings[i - 1].bitNumberConverted + 1)))
+		{
+			BitSegment& bitSegment = _bitSegments.back();
+			bitSegment.bitMaskOriginal |= bitMapping.bitMaskOriginal;
+			bitSegment.bitMaskConverted |= bitMapping.bitMaskConverted;
+			continue;
+		}
+
+		// Start a new segment for this bit
+		if ((unsigned int)_bitSegments.size() >= MaxBitSegmentCount)
+		{
+			_bitSegments.clear();
+			return false;
+		}
+		BitSegment bitSegment;
+		bitSegment.bitMaskOriginal = bitMapping.bitMaskOriginal;
+		bitSegment.bitMaskConverted = bitMapping.bitMaskConverted;
+		bitSegment.shiftLeftCount = (bitMapping.bitNumberConverted > bitMapping.bitNumberOriginal)? (bitMapping.bitNumberConverted - bitMapping.bitNumberOriginal): 0;
+		bitSegment.shiftRightCount = (bitMapping.bitNumberOriginal > bitMapping.bitNumberConverted)? (bitMapping.bitNumberOriginal - bitMapping.bitNumberConverted): 0;
+		_bitSegments.push_back(bitSegment);
+	}
+	_bitSegmentsSize = (unsigned int)_bitSegments.size();
+	return true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool DataRemapTable::IsBitOrderPreserved() const
+{
+	// Determine if each mapped source bit is higher than the source bit mapped to the
+	// converted bit below it. If so, the mapping can be performed by extracting the source
+	// bits and depositing them into the converted bits as a group.
+	for (unsigned int i = 1; i < _dataBitMappingsSize; ++i)
+	{
+		if (_dataBitMappings[i].bitNumberOriginal <= _dataBitMappings[i - 1].bitNumberOriginal)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void DataRemapTable::BuildByteLookupTables()
+{
+	// Build a lookup table for each byte of the original data, where each entry holds the
+	// converted bits which are generated by that byte value.
+	_byteLookupTableToByteCount = (_bitCountOriginal + (BitsPerByte - 1)) / BitsPerByte;
+	_byteLookupTableTo.assign(_byteLookupTableToByteCount * ByteLookupTableEntryCount, 0);
+	for (unsigned int byteNo = 0; byteNo < _byteLookupTableToByteCount; ++byteNo)
+	{
+		for (unsigned int i = 0; i < ByteLookupTableEntryCount; ++i)
+		{
+			_byteLookupTableTo[(byteNo * ByteLookupTableEntryCount) + i] = ConvertToUsingBitMappings(i << (byteNo * BitsPerByte));
+		}
+	}
+
+	// Build a lookup table for each byte of the converted data, where each entry holds the
+	// original bits which are generated by that byte value.
+	_byteLookupTableFromByteCount = (_bitCountConverted + (BitsPerByte - 1)) / BitsPerByte;
+	_byteLookupTableFrom.assign(_byteLookupTableFromByteCount * ByteLookupTableEntryCount, 0);
+	for (unsigned int byteNo = 0; byteNo < _byteLookupTableFromByteCount; ++byteNo)
+	{
+		for (unsigned int i = 0; i < ByteLookupTableEntryCount; ++i)
+		{
+			_byteLookupTableFrom[(byteNo * ByteLookupTableEntryCount) + i] = ConvertFromUsingBitMappings(i << (byteNo * BitsPerByte));
+		}
+	}
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool DataRemapTable::IsParallelBitOperationSupported()
+{
+#ifdef DATAREMAPTABLE_PARALLEL_BIT_OPERATIONS
+	// Check for BMI2 support, which is reported in bit 8 of EBX for CPUID leaf 7.
+	int cpuInfo[4];
+	__cpuid(cpuInfo, 0);
+	if (cpuInfo[0] < 7)
+	{
+		return false;
+	}
+	__cpuidex(cpuInfo, 7, 0);
+	return ((cpuInfo[1] & (1 << 8)) != 0);
+#else
+	return false;
+#endif
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 // Data conversion functions
 //----------------------------------------------------------------------------------------------------------------------
@@ -294,22 +407,42 @@ unsigned int DataRemapTable::ConvertTo(unsigned int sourceData) const
 {
 	unsigned int result = 0;
 
-	if (_useMethodConversionTableTo)
+	switch (_conversionMethodTo)
 	{
+	case ConversionMethod::ConversionTable:
 		result = _conversionTableTo[(sourceData & _bitMaskOriginal) >> _discardBottomBitCount];
-	}
-	else if (_useMethodShiftAndMask)
-	{
+		break;
+	case ConversionMethod::ShiftAndMask:
 		result = ((sourceData & _bitMaskOriginal) >> _discardBottomBitCount) << _insertBottomBitCount;
 		result |= _forcedSetBitMaskInConverted;
-	}
-	else
-	{
-		for (unsigned int i = 0; i < _dataBitMappingsSize; ++i)
+		break;
+	case ConversionMethod::BitSegments:
+		for (unsigned int i = 0; i < _bitSegmentsSize; ++i)
 		{
-			result |= ((sourceData & _dataBitMappings[i].bitMaskOriginal) != 0)? _dataBitMappings[i].bitMaskConverted: 0;
+			const BitSegment& bitSegment = _bitSegments[i];
+			result |= ((sourceData & bitSegment.bitMaskOriginal) << bitSegment.shiftLeftCount) >> bitSegment.shiftRightCount;
 		}
 		result |= _forcedSetBitMaskInConverted;
+		break;
+#ifdef DATAREMAPTABLE_PARALLEL_BIT_OPERATIONS
+	case ConversionMethod::ParallelBitExtract:
+		result = _pdep_u32(_pext_u32(sourceData, _bitMaskOriginal), _bitMaskConverted);
+		result |= _forcedSetBitMaskInConverted;
+		break;
+#endif
+	case ConversionMethod::ByteLookupTable:{
+		const unsigned int* byteLookupTable = &_byteLookupTableTo[0];
+		for (unsigned int i = 0; i < _byteLookupTableToByteCount; ++i)
+		{
+			result |= byteLookupTable[sourceData & 0xFF];
+			sourceData >>= BitsPerByte;
+			byteLookupTable += ByteLookupTableEntryCount;
+		}
+		result |= _forcedSetBitMaskInConverted;
+		break;}
+	default:
+		result = ConvertToUsingBitMappings(sourceData) | _forcedSetBitMaskInConverted;
+		break;
 	}
 
 	return result;
@@ -320,21 +453,63 @@ unsigned int DataRemapTable::ConvertFrom(unsigned int sourceData) const
 {
 	unsigned int result = 0;
 
-	if (_useMethodConversionTableFrom)
+	switch (_conversionMethodFrom)
 	{
+	case ConversionMethod::ConversionTable:
 		result = _conversionTableFrom[(sourceData & _bitMaskConverted) >> _insertBottomBitCount];
-	}
-	else if (_useMethodShiftAndMask)
-	{
+		break;
+	case ConversionMethod::ShiftAndMask:
 		result = ((sourceData >> _insertBottomBitCount) << _discardBottomBitCount) & _bitMaskOriginal;
-	}
-	else
-	{
-		for (unsigned int i = 0; i < _dataBitMappingsSize; ++i)
+		break;
+	case ConversionMethod::BitSegments:
+		for (unsigned int i = 0; i < _bitSegmentsSize; ++i)
 		{
-			result |= ((sourceData & _dataBitMappings[i].bitMaskConverted) != 0)? _dataBitMappings[i].bitMaskOriginal: 0;
+			const BitSegment& bitSegment = _bitSegments[i];
+			result |= ((sourceData & bitSegment.bitMaskConverted) << bitSegment.shiftRightCount) >> bitSegment.shiftLeftCount;
 		}
+		break;
+#ifdef DATAREMAPTABLE_PARALLEL_BIT_OPERATIONS
+	case ConversionMethod::ParallelBitExtract:
+		result = _pdep_u32(_pext_u32(sourceData, _bitMaskConverted), _bitMaskOriginal);
+		break;
+#endif
+	case ConversionMethod::ByteLookupTable:{
+		const unsigned int* byteLookupTable = &_byteLookupTableFrom[0];
+		for (unsigned int i = 0; i < _byteLookupTableFromByteCount; ++i)
+		{
+			result |= byteLookupTable[sourceData & 0xFF];
+			sourceData >>= BitsPerByte;
+			byteLookupTable += ByteLookupTableEntryCount;
+		}
+		break;}
+	default:
+		result = ConvertFromUsingBitMappings(sourceData);
+		break;
+	}
+
+	return result;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Generic data conversion functions
+//----------------------------------------------------------------------------------------------------------------------
+unsigned int DataRemapTable::ConvertToUsingBitMappings(unsigned int sourceData) const
+{
+	unsigned int result = 0;
+	for (unsigned int i = 0; i < _dataBitMappingsSize; ++i)
+	{
+		result |= ((sourceData & _dataBitMappings[i].bitMaskOriginal) != 0)? _dataBitMappings[i].bitMaskConverted: 0;
 	}
+	return result;
+}
 
+//----------------------------------------------------------------------------------------------------------------------
+unsigned int DataRemapTable::ConvertFromUsingBitMappings(unsigned int sourceData) const
+{
+	unsigned int result = 0;
+	for (unsigned int i = 0; i < _dataBitMappingsSize; ++i)
+	{
+		result |= ((sourceData & _dataBitMappings[i].bitMaskConverted) != 0)? _dataBitMappings[i].bitMaskOriginal: 0;
+	}
 	return result;
 }
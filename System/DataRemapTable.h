@@ -23,10 +23,30 @@ public:
 	inline unsigned int GetBitMaskOriginalLinesPreserved() const;
 
 private:
+	// Enumerations
+	enum class ConversionMethod;
+
 	// Structures
 	struct BitMapping;
+	struct BitSegment;
 	struct MappingElement;
 
+	// Constants
+	static const unsigned int MaxBitSegmentCount = 4;
+	static const unsigned int BitsPerByte = 8;
+	static const unsigned int ByteLookupTableEntryCount = 0x100;
+
+private:
+	// Conversion method selection functions
+	bool BuildBitSegments();
+	bool IsBitOrderPreserved() const;
+	void BuildByteLookupTables();
+	static bool IsParallelBitOperationSupported();
+
+	// Generic data conversion functions
+	unsigned int ConvertToUsingBitMappings(unsigned int sourceData) const;
+	unsigned int ConvertFromUsingBitMappings(unsigned int sourceData) const;
+
 private:
 	// Mapping settings
 	unsigned int _bitMaskOriginal;   // Mask of the lines to preserve in the original data
@@ -40,16 +60,27 @@ private:
 	unsigned int _forcedSetBitMaskInConverted; // Mask of bits to force as set in the converted value
 
 	// Conversion method settings
-	bool _useMethodConversionTableTo;
-	bool _useMethodConversionTableFrom;
-	bool _useMethodShiftAndMask;
+	ConversionMethod _conversionMethodTo;
+	ConversionMethod _conversionMethodFrom;
 
 	// Manual bit mapping data
 	unsigned int _dataBitMappingsSize; // We cache this purely as a paranoid optimization
 	std::vector<BitMapping> _dataBitMappings;
 
+	// Bit segment data
+	unsigned int _bitSegmentsSize;
+	std::vector<BitSegment> _bitSegments;
+
+	// Byte lookup table data
+	unsigned int _byteLookupTableToByteCount;
+	unsigned int _byteLookupTableFromByteCount;
+	std::vector<unsigned int> _byteLookupTableTo;
+	std::vector<unsigned int> _byteLookupTableFrom;
+
 	// Conversion table data
 	bool _conversionTableStateSetManually;
+	bool _useMethodConversionTableTo;
+	bool _useMethodConversionTableFrom;
 	unsigned int _conversionTableToMaxBitCount;
 	unsigned int _conversionTableFromMaxBitCount;
 	std::vector<unsigned int> _conversionTableTo;
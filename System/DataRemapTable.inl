@@ -1,3 +1,15 @@
+//----------------------------------------------------------------------------------------------------------------------
+// Enumerations
+//----------------------------------------------------------------------------------------------------------------------
+enum class DataRemapTable::ConversionMethod
+{
+	ShiftAndMask,       // All mapped bits form a single contiguous run
+	BitSegments,        // Mapped bits form a small number of contiguous runs, such as a byte swap
+	ParallelBitExtract, // Mapped bits are in relative order, and the host supports BMI2
+	ByteLookupTable,    // Mapped bits are converted using a 256-entry lookup table per byte
+	ConversionTable     // Mapped bits are converted using a single table for the entire value
+};
+
 //----------------------------------------------------------------------------------------------------------------------
 // Structures
 //----------------------------------------------------------------------------------------------------------------------
@@ -5,6 +17,17 @@ struct DataRemapTable::BitMapping
 {
 	unsigned int bitMaskOriginal;
 	unsigned int bitMaskConverted;
+	unsigned int bitNumberOriginal;
+	unsigned int bitNumberConverted;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+struct DataRemapTable::BitSegment
+{
+	unsigned int bitMaskOriginal;
+	unsigned int bitMaskConverted;
+	unsigned int shiftLeftCount;  // Left shift applied to the original bits when converting to the converted form
+	unsigned int shiftRightCount; // Right shift applied to the original bits when converting to the converted form
 };
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,317 @@
+#include "EventLogRing.h"
+#include <thread>
+#include <sstream>
+#include <iomanip>
+#include <cstring>
+
+//----------------------------------------------------------------------------------------------------------------------
+// Constructors
+//----------------------------------------------------------------------------------------------------------------------
+EventLogRing::EventLogRing()
+:_nextEntryNo(0), _firstEntryNo(0), _maxEntryCount(RecordCount), _lastModifiedToken(0), _stringCount(0)
+{
+	_records = new Record[RecordCount];
+	for (unsigned int i = 0; i < EventLevelCount; ++i)
+	{
+		_eventLevelStringIDs[i].store(InvalidStringID, std::memory_order_relaxed);
+	}
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+EventLogRing::~EventLogRing()
+{
+	delete[] _records;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Size functions
+//----------------------------------------------------------------------------------------------------------------------
+unsigned int EventLogRing::GetMaxEntryCount() const
+{
+	return _maxEntryCount.load(std::memory_order_acquire);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void EventLogRing::SetMaxEntryCount(unsigned int maxEntryCount)
+{
+	// Since records are never allocated after construction, the number of entries we can
+	// retain is limited by the number of records in the ring.
+	_maxEntryCount.store((maxEntryCount < RecordCount)? maxEntryCount: RecordCount, std::memory_order_release);
+	_lastModifiedToken.fetch_add(1, std::memory_order_acq_rel);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+unsigned int EventLogRing::GetEntryCapacity()
+{
+	return RecordCount;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Entry functions
+//----------------------------------------------------------------------------------------------------------------------
+void EventLogRing::WriteEntry(const ILogEntry& entry)
+{
+	// Read the source and text strings for the entry in place from the returned string
+	// objects. If raw access to the string data isn't available, we fall back to
+	// retrieving a copy of the string.
+	Marshal::Ret<std::wstring> sourceReturn(entry.GetSource());
+	Marshal::In<std::wstring> sourceMarshaller(sourceReturn);
+	std::wstring sourceString;
+	const wchar_t* sourceData;
+	size_t sourceLength;
+	if (!sourceMarshaller.GetRawData(sourceData, sourceLength))
+	{
+		sourceString = sourceMarshaller.GetWithoutMove();
+		sourceData = sourceString.c_str();
+		sourceLength = sourceString.size();
+	}
+	Marshal::Ret<std::wstring> textReturn(entry.GetText());
+	Marshal::In<std::wstring> textMarshaller(textReturn);
+	std::wstring textString;
+	const wchar_t* textData;
+	size_t textLength;
+	if (!textMarshaller.GetRawData(textData, textLength))
+	{
+		textString = textMarshaller.GetWithoutMove();
+		textData = textString.c_str();
+		textLength = textString.size();
+	}
+
+	// Capture the raw event time and resolve the interned strings for this entry
+	FILETIME fileTime;
+	GetSystemTimeAsFileTime(&fileTime);
+	unsigned long long timestamp = ((unsigned long long)fileTime.dwHighDateTime << 32) | (unsigned long long)fileTime.dwLowDateTime;
+	ILogEntry::EventLevel eventLevel = entry.GetEventLevel();
+	unsigned int eventLevelStringID = GetEventLevelStringID(entry);
+	unsigned int sourceStringID = InternString(sourceData, sourceLength);
+	bool textOverflow = (textLength > MaxInlineTextLength);
+
+	// Claim the next entry number, and with it the record this entry will be written to
+	unsigned int entryNo = _nextEntryNo.fetch_add(1, std::memory_order_acq_rel);
+	Record& record = _records[entryNo & RecordIndexMask];
+
+	// If any strings for this entry couldn't be stored inline, add them to the overflow
+	// map before the record is published, and discard any overflow entries belonging to
+	// records which have since been overwritten.
+	if (textOverflow || (sourceStringID == InvalidStringID))
+	{
+		std::unique_lock<std::mutex> lock(_overflowMutex);
+		OverflowEntry& overflowEntry = _overflowEntries[entryNo];
+		if (sourceStringID == InvalidStringID)
+		{
+			overflowEntry.source.assign(sourceData, sourceLength);
+		}
+		if (textOverflow)
+		{
+			overflowEntry.text.assign(textData, textLength);
+		}
+		std::map<unsigned int, OverflowEntry>::iterator overflowIterator = _overflowEntries.begin();
+		while ((overflowIterator != _overflowEntries.end()) && ((entryNo - overflowIterator->first) >= RecordCount))
+		{
+			overflowIterator = _overflowEntries.erase(overflowIterator);
+		}
+	}
+
+	// Obtain exclusive access to the target record. Another writer can only be holding this
+	// record if the entire ring has been written to while it was being filled, so this will
+	// almost never need to wait.
+	unsigned int sequenceNo = record.sequenceNo.load(std::memory_order_relaxed);
+	while (((sequenceNo & 1) != 0) || !record.sequenceNo.compare_exchange_weak(sequenceNo, sequenceNo + 1, std::memory_order_acquire, std::memory_order_relaxed))
+	{
+		std::this_thread::yield();
+		sequenceNo = record.sequenceNo.load(std::memory_order_relaxed);
+	}
+
+	// Write the entry into the record, unless a later entry has already wrapped around the
+	// ring and taken ownership of it, in which case this entry has already been discarded.
+	if ((sequenceNo == 0) || ((int)(entryNo - record.entryNo) > 0))
+	{
+		unsigned int inlineTextLength = textOverflow? MaxInlineTextLength: (unsigned int)textLength;
+		record.entryNo = entryNo;
+		record.eventLevel = eventLevel;
+		record.eventLevelStringID = eventLevelStringID;
+		record.sourceStringID = sourceStringID;
+		record.timestamp = timestamp;
+		record.textLength = inlineTextLength;
+		record.textOverflow = textOverflow;
+		std::memcpy(&record.text[0], textData, inlineTextLength * sizeof(wchar_t));
+	}
+	record.sequenceNo.store(sequenceNo + 2, std::memory_order_release);
+	_lastModifiedToken.fetch_add(1, std::memory_order_acq_rel);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void EventLogRing::ReadEntries(std::vector<SystemLogEntry>& entries) const
+{
+	// Determine the range of entries to return
+	unsigned int nextEntryNo = _nextEntryNo.load(std::memory_order_acquire);
+	unsigned int firstEntryNo = _firstEntryNo.load(std::memory_order_acquire);
+	unsigned int entryCount = nextEntryNo - firstEntryNo;
+	unsigned int maxEntryCount = _maxEntryCount.load(std::memory_order_acquire);
+	entryCount = (entryCount < maxEntryCount)? entryCount: maxEntryCount;
+
+	// Expand each record into a log entry, with the most recent entry first. Records which
+	// are still being written, or have been overwritten by a later entry since we started,
+	// are skipped.
+	entries.clear();
+	entries.reserve(entryCount);
+	Record record;
+	for (unsigned int i = 0; i < entryCount; ++i)
+	{
+		if (ReadRecord(nextEntryNo - (i + 1), record))
+		{
+			entries.push_back(SystemLogEntry());
+			ExpandRecord(record, entries.back());
+		}
+	}
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void EventLogRing::Clear()
+{
+	// Records are left in place, but all entries written up to this point are excluded from
+	// any future reads.
+	_firstEntryNo.store(_nextEntryNo.load(std::memory_order_acquire), std::memory_order_release);
+	std::unique_lock<std::mutex> lock(_overflowMutex);
+	_overflowEntries.clear();
+	_lastModifiedToken.fetch_add(1, std::memory_order_acq_rel);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// String table functions
+//----------------------------------------------------------------------------------------------------------------------
+unsigned int EventLogRing::InternString(const wchar_t* data, size_t length)
+{
+	// Search for an existing match for the string. Entries in the string table are never
+	// modified once they've been published, so this can be done without a lock.
+	unsigned int stringCount = _stringCount.load(std::memory_order_acquire);
+	for (unsigned int i = 0; i < stringCount; ++i)
+	{
+		if ((_strings[i].size() == length) && (_strings[i].compare(0, length, data, length) == 0))
+		{
+			return i;
+		}
+	}
+
+	// Add the string to the table, checking first that it wasn't added by another thread
+	// since we performed our search.
+	std::unique_lock<std::mutex> lock(_stringMutex);
+	unsigned int newStringCount = _stringCount.load(std::memory_order_relaxed);
+	for (unsigned int i = stringCount; i < newStringCount; ++i)
+	{
+		if ((_strings[i].size() == length) && (_strings[i].compare(0, length, data, length) == 0))
+		{
+			return i;
+		}
+	}
+	if (newStringCount >= MaxStringCount)
+	{
+		return InvalidStringID;
+	}
+	_strings[newStringCount].assign(data, length);
+	_stringCount.store(newStringCount + 1, std::memory_order_release);
+	return newStringCount;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+unsigned int EventLogRing::GetEventLevelStringID(const ILogEntry& entry)
+{
+	// The event level string is fixed for each event level, so we only need to request it
+	// from a log entry the first time each event level is seen.
+	unsigned int eventLevelIndex = (unsigned int)entry.GetEventLevel();
+	unsigned int stringID = (eventLevelIndex < EventLevelCount)? _eventLevelStringIDs[eventLevelIndex].load(std::memory_order_acquire): InvalidStringID;
+	if (stringID == InvalidStringID)
+	{
+		std::wstring eventLevelString = entry.GetEventLevelString();
+		stringID = InternString(eventLevelString.c_str(), eventLevelString.size());
+		if ((eventLevelIndex < EventLevelCount) && (stringID != InvalidStringID))
+		{
+			_eventLevelStringIDs[eventLevelIndex].store(stringID, std::memory_order_release);
+		}
+	}
+	return stringID;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Record functions
+//----------------------------------------------------------------------------------------------------------------------
+bool EventLogRing::ReadRecord(unsigned int entryNo, Record& record) const
+{
+	// Copy the contents of the target record, and confirm the record wasn't modified while
+	// we were reading it by checking its sequence number is unchanged.
+	const Record& sourceRecord = _records[entryNo & RecordIndexMask];
+	for (unsigned int attempt = 0; attempt < MaxRecordReadAttempts; ++attempt)
+	{
+		unsigned int sequenceNo = sourceRecord.sequenceNo.load(std::memory_order_acquire);
+		if ((sequenceNo & 1) != 0)
+		{
+			std::this_thread::yield();
+			continue;
+		}
+		record.entryNo = sourceRecord.entryNo;
+		record.eventLevel = sourceRecord.eventLevel;
+		record.eventLevelStringID = sourceRecord.eventLevelStringID;
+		record.sourceStringID = sourceRecord.sourceStringID;
+		record.timestamp = sourceRecord.timestamp;
+		record.textLength = (sourceRecord.textLength < MaxInlineTextLength)? sourceRecord.textLength: MaxInlineTextLength;
+		record.textOverflow = sourceRecord.textOverflow;
+		std::memcpy(&record.text[0], &sourceRecord.text[0], record.textLength * sizeof(wchar_t));
+		std::atomic_thread_fence(std::memory_order_acquire);
+		if (sourceRecord.sequenceNo.load(std::memory_order_relaxed) == sequenceNo)
+		{
+			return ((sequenceNo != 0) && (record.entryNo == entryNo));
+		}
+	}
+	return false;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void EventLogRing::ExpandRecord(const Record& record, SystemLogEntry& entry) const
+{
+	entry.eventLevel = record.eventLevel;
+	entry.eventTimeString = BuildTimeString(record.timestamp);
+	if (record.eventLevelStringID != InvalidStringID)
+	{
+		entry.eventLevelString = _strings[record.eventLevelStringID];
+	}
+	if (record.sourceStringID != InvalidStringID)
+	{
+		entry.source = _strings[record.sourceStringID];
+	}
+	entry.text.assign(&record.text[0], record.textLength);
+
+	// Retrieve any strings for this entry which were stored in the overflow map
+	if (record.textOverflow || (record.sourceStringID == InvalidStringID))
+	{
+		std::unique_lock<std::mutex> lock(_overflowMutex);
+		std::map<unsigned int, OverflowEntry>::const_iterator overflowIterator = _overflowEntries.find(record.entryNo);
+		if (overflowIterator != _overflowEntries.end())
+		{
+			if (record.sourceStringID == InvalidStringID)
+			{
+				entry.source = overflowIterator->second.source;
+			}
+			if (record.textOverflow)
+			{
+				entry.text = overflowIterator->second.text;
+			}
+		}
+	}
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+std::wstring EventLogRing::BuildTimeString(unsigned long long timestamp)
+{
+	// Convert the raw system timestamp into local time, and format it in the same way as
+	// the time string of a log entry.
+	FILETIME systemFileTime;
+	systemFileTime.dwLowDateTime = (DWORD)timestamp;
+	systemFileTime.dwHighDateTime = (DWORD)(timestamp >> 32);
+	FILETIME localFileTime;
+	FileTimeToLocalFileTime(&systemFileTime, &localFileTime);
+	SYSTEMTIME time;
+	FileTimeToSystemTime(&localFileTime, &time);
+	std::wstringstream stream;
+	stream << std::setw(2) << std::setfill(L'0') << (int)time.wHour << L':' << (int)time.wMinute << L':' << (int)time.wSecond << L'.' << (int)time.wMilliseconds;
+	return stream.str();
+}
@@ -0,0 +1,95 @@
+#ifndef __EVENTLOGRING_H__
+#define __EVENTLOGRING_H__
+#include "WindowsSupport/WindowsSupport.pkg"
+#include "DeviceInterface/DeviceInterface.pkg"
+#include "SystemInterface/SystemInterface.pkg"
+#include <string>
+#include <vector>
+#include <map>
+#include <mutex>
+#include <atomic>
+
+// This container holds the most recent events written to the system event log. Events are
+// written into a fixed array of preallocated records, which is treated as a ring buffer.
+// Any number of threads can write events concurrently without taking a lock: each writer
+// claims the next record index with a single atomic increment, then fills the record under
+// a per-record sequence number, which allows a reader to detect and discard a record which
+// was modified while it was being read. Once the ring is full, the oldest records are
+// overwritten.
+//
+// Records only hold the raw event data. The source and event level strings are interned
+// into a shared string table, the event text is copied into a fixed inline buffer, and the
+// event time is stored as a raw system timestamp. Expansion of records into SystemLogEntry
+// structures, which involves formatting the time and building the strings, is only
+// performed when the log is read. Event text which is too long to fit into a record, and
+// sources which can't be interned because the string table is full, are stored in a
+// separate overflow map, which is the only path on which a writer will take a lock.
+class EventLogRing
+{
+public:
+	// Typedefs
+	typedef ISystemGUIInterface::SystemLogEntry SystemLogEntry;
+
+public:
+	// Constructors
+	EventLogRing();
+	~EventLogRing();
+
+	// Size functions
+	unsigned int GetMaxEntryCount() const;
+	void SetMaxEntryCount(unsigned int maxEntryCount);
+	static unsigned int GetEntryCapacity();
+
+	// Entry functions
+	void WriteEntry(const ILogEntry& entry);
+	void ReadEntries(std::vector<SystemLogEntry>& entries) const;
+	void Clear();
+
+	// Change notification functions
+	inline unsigned int GetLastModifiedToken() const;
+
+private:
+	// Structures
+	struct Record;
+	struct OverflowEntry;
+
+	// Constants
+	static const unsigned int RecordCount = 0x800;
+	static const unsigned int RecordIndexMask = RecordCount - 1;
+	static const unsigned int MaxInlineTextLength = 0xF8;
+	static const unsigned int MaxStringCount = 0x100;
+	static const unsigned int EventLevelCount = 5;
+	static const unsigned int InvalidStringID = 0xFFFFFFFF;
+	static const unsigned int MaxRecordReadAttempts = 4;
+
+private:
+	// String table functions
+	unsigned int InternString(const wchar_t* data, size_t length);
+	unsigned int GetEventLevelStringID(const ILogEntry& entry);
+
+	// Record functions
+	bool ReadRecord(unsigned int entryNo, Record& record) const;
+	void ExpandRecord(const Record& record, SystemLogEntry& entry) const;
+	static std::wstring BuildTimeString(unsigned long long timestamp);
+
+private:
+	// Record settings
+	Record* _records;
+	std::atomic<unsigned int> _nextEntryNo;
+	std::atomic<unsigned int> _firstEntryNo;
+	std::atomic<unsigned int> _maxEntryCount;
+	std::atomic<unsigned int> _lastModifiedToken;
+
+	// String table settings
+	std::wstring _strings[MaxStringCount];
+	std::atomic<unsigned int> _stringCount;
+	std::mutex _stringMutex;
+	std::atomic<unsigned int> _eventLevelStringIDs[EventLevelCount];
+
+	// Overflow settings
+	mutable std::mutex _overflowMutex;
+	std::map<unsigned int, OverflowEntry> _overflowEntries;
+};
+
+#include "EventLogRing.inl"
+#endif
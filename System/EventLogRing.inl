@@ -0,0 +1,36 @@
+//----------------------------------------------------------------------------------------------------------------------
+// Structures
+//----------------------------------------------------------------------------------------------------------------------
+struct EventLogRing::Record
+{
+	Record()
+	:sequenceNo(0), entryNo(0), eventLevelStringID(InvalidStringID), sourceStringID(InvalidStringID), timestamp(0), textLength(0), textOverflow(false)
+	{ }
+
+	// The sequence number is odd while the record is being written, and is advanced
+	// again once the write is complete.
+	std::atomic<unsigned int> sequenceNo;
+	unsigned int entryNo;
+	ILogEntry::EventLevel eventLevel;
+	unsigned int eventLevelStringID;
+	unsigned int sourceStringID;
+	unsigned long long timestamp;
+	unsigned int textLength;
+	bool textOverflow;
+	wchar_t text[MaxInlineTextLength];
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+struct EventLogRing::OverflowEntry
+{
+	std::wstring source;
+	std::wstring text;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+// Change notification functions
+//----------------------------------------------------------------------------------------------------------------------
+unsigned int EventLogRing::GetLastModifiedToken() const
+{
+	return _lastModifiedToken.load(std::memory_order_acquire);
+}
@@ -0,0 +1,61 @@
+#ifndef __INPUTEVENTQUEUE_H__
+#define __INPUTEVENTQUEUE_H__
+#include <atomic>
+
+// This container holds input events which have been received from the host, and which are
+// waiting to be delivered to devices by the system execution thread. Events are stored in
+// a fixed array of preallocated slots, which is treated as a bounded ring buffer, so no
+// allocation is performed when an event is written. Any number of threads can write events
+// concurrently without taking a lock: each writer claims the next slot by advancing the
+// write position with an atomic compare-and-swap, then publishes the slot through a
+// per-slot sequence number once the event data has been written. If the ring is full, the
+// write fails, and the caller is responsible for deciding how to handle the lost event.
+//
+// Only a single thread may read events. Events are read in the order they were written,
+// but they remain in the ring until they are explicitly released by the reader. This
+// allows the system to deliver the same events again if the timeslice they were delivered
+// in is rolled back, and only release them once the timeslice has been committed. Testing
+// whether any events are waiting is a single acquire load, so the reader can poll the
+// queue on every timeslice at negligible cost.
+//
+// Any object can be stored in this container, provided it meets the following
+// requirements:
+// -It is default constructible
+// -It is assignable
+
+template<class EntryType>
+class InputEventQueue
+{
+public:
+	// Constructors
+	InputEventQueue();
+	~InputEventQueue();
+
+	// Size functions
+	static unsigned int GetEntryCapacity();
+
+	// Write functions
+	bool WriteEntry(const EntryType& entry);
+
+	// Read functions
+	inline bool Empty() const;
+	unsigned int GetReadableEntryCount() const;
+	inline const EntryType& GetEntry(unsigned int entryNo) const;
+	void ReleaseEntries(unsigned int entryCount);
+
+private:
+	// Structures
+	struct Slot;
+
+	// Constants
+	static const unsigned int SlotCount = 0x100;
+	static const unsigned int SlotIndexMask = SlotCount - 1;
+
+private:
+	Slot* _slots;
+	std::atomic<unsigned int> _writePos;
+	unsigned int _readPos;
+};
+
+#include "InputEventQueue.inl"
+#endif
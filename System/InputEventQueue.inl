@@ -0,0 +1,125 @@
+//----------------------------------------------------------------------------------------------------------------------
+// Structures
+//----------------------------------------------------------------------------------------------------------------------
+template<class EntryType>
+struct InputEventQueue<EntryType>::Slot
+{
+	// The sequence number of a slot is equal to the write position which will next claim
+	// it while the slot is free, and is advanced by one once the entry for that position
+	// has been written. Releasing the entry advances it to the position which will claim
+	// the slot on the next pass around the ring.
+	std::atomic<unsigned int> sequenceNo;
+	EntryType entry;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+// Constructors
+//----------------------------------------------------------------------------------------------------------------------
+template<class EntryType>
+InputEventQueue<EntryType>::InputEventQueue()
+:_writePos(0), _readPos(0)
+{
+	_slots = new Slot[SlotCount];
+	for (unsigned int i = 0; i < SlotCount; ++i)
+	{
+		_slots[i].sequenceNo.store(i, std::memory_order_relaxed);
+	}
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+template<class EntryType>
+InputEventQueue<EntryType>::~InputEventQueue()
+{
+	delete[] _slots;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Size functions
+//----------------------------------------------------------------------------------------------------------------------
+template<class EntryType>
+unsigned int InputEventQueue<EntryType>::GetEntryCapacity()
+{
+	return SlotCount;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Write functions
+//----------------------------------------------------------------------------------------------------------------------
+template<class EntryType>
+bool InputEventQueue<EntryType>::WriteEntry(const EntryType& entry)
+{
+	unsigned int writePos = _writePos.load(std::memory_order_relaxed);
+	while (true)
+	{
+		// If the slot at the current write position is free, attempt to claim it. If
+		// another writer claims it first, the compare-and-swap loads the new write
+		// position, and we try again with the next slot.
+		Slot& slot = _slots[writePos & SlotIndexMask];
+		unsigned int sequenceNo = slot.sequenceNo.load(std::memory_order_acquire);
+		int sequenceDifference = (int)(sequenceNo - writePos);
+		if (sequenceDifference == 0)
+		{
+			if (_writePos.compare_exchange_weak(writePos, writePos + 1, std::memory_order_relaxed))
+			{
+				// Write the entry into the claimed slot, and publish it to the reader
+				slot.entry = entry;
+				slot.sequenceNo.store(writePos + 1, std::memory_order_release);
+				return true;
+			}
+		}
+		else if (sequenceDifference < 0)
+		{
+			// The slot still holds an entry from the previous pass around the ring which
+			// hasn't been released yet, so the ring is full.
+			return false;
+		}
+		else
+		{
+			// Another writer has claimed this slot since we loaded the write position
+			writePos = _writePos.load(std::memory_order_relaxed);
+		}
+	}
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Read functions
+//----------------------------------------------------------------------------------------------------------------------
+template<class EntryType>
+bool InputEventQueue<EntryType>::Empty() const
+{
+	return (_slots[_readPos & SlotIndexMask].sequenceNo.load(std::memory_order_acquire) != (_readPos + 1));
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+template<class EntryType>
+unsigned int InputEventQueue<EntryType>::GetReadableEntryCount() const
+{
+	// Count the number of consecutive published entries from the current read position.
+	// Note that a writer may have claimed a slot but not yet published it, in which case
+	// that entry, and any entries after it, will be read on a later call.
+	unsigned int entryCount = 0;
+	while ((entryCount < SlotCount) && (_slots[(_readPos + entryCount) & SlotIndexMask].sequenceNo.load(std::memory_order_acquire) == (_readPos + entryCount + 1)))
+	{
+		++entryCount;
+	}
+	return entryCount;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+template<class EntryType>
+const EntryType& InputEventQueue<EntryType>::GetEntry(unsigned int entryNo) const
+{
+	return _slots[(_readPos + entryNo) & SlotIndexMask].entry;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+template<class EntryType>
+void InputEventQueue<EntryType>::ReleaseEntries(unsigned int entryCount)
+{
+	// Return the target number of entries from the front of the ring to the writers
+	for (unsigned int i = 0; i < entryCount; ++i)
+	{
+		_slots[_readPos & SlotIndexMask].sequenceNo.store(_readPos + SlotCount, std::memory_order_release);
+		++_readPos;
+	}
+}
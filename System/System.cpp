@@ -7,6 +7,8 @@
 #include <time.h>
 #include <functional>
 #include <thread>
+#include <atomic>
+#include <chrono>
 #include <sstream>
 #include <algorithm>
 //##DEBUG##
@@ -17,14 +19,26 @@
 // Constructors
 //----------------------------------------------------------------------------------------------------------------------
 System::System(IGUIExtensionInterface& guiExtensionInterface)
-:_guiExtensionInterface(guiExtensionInterface), _stopSystem(false), _systemStopped(true), _initialize(true), _rollback(false), _performingSingleDeviceStep(false), _enableThrottling(true), _runWhenProgramModuleLoaded(true), _enablePersistentState(true)
+:_guiExtensionInterface(guiExtensionInterface), _stopSystem(false), _systemStopped(true), _initialize(true), _rollback(false), _performingSingleDeviceStep(false), _enableThrottling(true), _runWhenProgramModuleLoaded(true), _enablePersistentState(true), _binarySavestateFormat(false), _stateCheckpointPresent(false)
 {
-	_eventLogSize = 500;
-	_eventLogLastModifiedToken = 0;
+	_eventLog.SetMaxEntryCount(500);
 
 	_embeddedROMInfoLastModifiedToken = 0;
 
 	_inputDeviceListLastModifiedToken = 0;
+	for (unsigned int i = 0; i < KeyCodeCount; ++i)
+	{
+		_inputKeyCodeMapped[i] = false;
+		_inputKeyCodePressed[i] = false;
+		_inputKeyCodeReleasePending[i] = false;
+	}
+	_inputReleasePendingCount = 0;
+	_inputReleasesPrepared.reserve(KeyCodeCount);
+	_inputEventsPreparedCount = 0;
+	_inputEventsSent = false;
+	_inputEventTime = 0;
+	_inputEventLastDeliveryTime = -(double)MaxInputEventSpacingInNanoseconds;
+	_inputEventPreparedDeliveryTime = _inputEventLastDeliveryTime;
 
 	_nextFreeModuleID = 0;
 	_nextFreeConnectorID = 1000;
@@ -105,11 +119,18 @@ bool System::LoadState(const Marshal::In<std::wstring>& filePath, FileType fileT
 			return false;
 		}
 
-		// Load XML tree from file
-		ZIPFileEntry* entry = archive.GetFileEntry(L"save.xml");
+		// Load the state tree from file. The tree is stored in save.xml for states saved in
+		// XML form, or save.dat for states saved in the binary storage format.
+		std::wstring stateEntryName = L"save.xml";
+		ZIPFileEntry* entry = archive.GetFileEntry(stateEntryName);
 		if (entry == 0)
 		{
-			WriteLogEvent(LogEntry(LogEntry::EventLevel::Error, L"System", L"Failed to load state from file " + filePath + L" because the save.xml file could not be found within the zip archive!"));
+			stateEntryName = L"save.dat";
+			entry = archive.GetFileEntry(stateEntryName);
+		}
+		if (entry == 0)
+		{
+			WriteLogEvent(LogEntry(LogEntry::EventLevel::Error, L"System", L"Failed to load state from file " + filePath + L" because neither a save.xml or save.dat file could be found within the zip archive!"));
 			if (running)
 			{
 				RunSystem();
@@ -119,7 +140,7 @@ bool System::LoadState(const Marshal::In<std::wstring>& filePath, FileType fileT
 		Stream::Buffer buffer(0);
 		if (!entry->Decompress(buffer))
 		{
-			WriteLogEvent(LogEntry(LogEntry::EventLevel::Error, L"System", L"Failed to load state from file " + filePath + L" because there was an error decompressing the save.xml file from the zip archive!"));
+			WriteLogEvent(LogEntry(LogEntry::EventLevel::Error, L"System", L"Failed to load state from file " + filePath + L" because there was an error decompressing the " + stateEntryName + L" file from the zip archive!"));
 			if (running)
 			{
 				RunSystem();
@@ -401,9 +422,20 @@ bool System::SaveState(const Marshal::In<std::wstring>& filePath, FileType fileT
 
 	if (fileType == FileType::ZIP)
 	{
-		// Save the XML tree to a unicode buffer
+		// Save the tree to a buffer. If the binary savestate format has been enabled, the
+		// tree is saved in the binary storage format with all binary data stored inline,
+		// otherwise it's saved as a unicode XML document.
+		bool binaryFormat = _binarySavestateFormat;
+		std::wstring stateEntryName = (binaryFormat)? L"save.dat": L"save.xml";
 		Stream::Buffer buffer(Stream::IStream::TextEncoding::UTF8, 0);
-		buffer.InsertByteOrderMark();
+		if (binaryFormat)
+		{
+			tree.SetStorageMode(IHierarchicalStorageTree::StorageMode::Binary);
+		}
+		else
+		{
+			buffer.InsertByteOrderMark();
+		}
 		if (!tree.SaveTree(buffer))
 		{
 			WriteLogEvent(LogEntry(LogEntry::EventLevel::Error, L"System", L"Failed to save state to file " + filePath + L" because there was an error saving the xml tree. The xml error string is as follows: " + tree.GetErrorString()));
@@ -416,11 +448,11 @@ bool System::SaveState(const Marshal::In<std::wstring>& filePath, FileType fileT
 
 		ZIPArchive archive;
 		ZIPFileEntry entry;
-		entry.SetFileName(L"save.xml");
+		entry.SetFileName(stateEntryName);
 		buffer.SetStreamPos(0);
 		if (!entry.Compress(buffer))
 		{
-			WriteLogEvent(LogEntry(LogEntry::EventLevel::Error, L"System", L"Failed to save state to file " + filePath + L" because there was an error compressing the save.xml file!"));
+			WriteLogEvent(LogEntry(LogEntry::EventLevel::Error, L"System", L"Failed to save state to file " + filePath + L" because there was an error compressing the " + stateEntryName + L" file!"));
 			if (running)
 			{
 				RunSystem();
@@ -1312,70 +1344,212 @@ bool System::DoesLoadedModuleMatchSavedModule(const SavedRelationshipMap& savedR
 }
 
 //----------------------------------------------------------------------------------------------------------------------
-// Logging functions
+// State checkpoint functions
 //----------------------------------------------------------------------------------------------------------------------
-void System::WriteLogEvent(const ILogEntry& entry) const
+bool System::CaptureStateCheckpoint()
 {
-	std::unique_lock<std::mutex> lock(_eventLogMutex);
-	SystemLogEntry logEntryInternal;
-	logEntryInternal.text = entry.GetText();
-	logEntryInternal.source = entry.GetSource();
-	logEntryInternal.eventLevel = entry.GetEventLevel();
-	logEntryInternal.eventLevelString = entry.GetEventLevelString();
-	logEntryInternal.eventTimeString = entry.GetTimeString();
-	_log.push_front(logEntryInternal);
-	if (_log.size() > _eventLogSize)
+	// Save running state and pause system
+	bool running = SystemRunning();
+	StopSystem();
+	std::unique_lock<std::mutex> lock(_stateCheckpointMutex);
+
+	// If there's no checkpoint for the current set of loaded devices, build a new entry for
+	// each device. Devices which support incremental state keep a cached image of their state
+	// between captures, so only the regions they report as changed need to be copied.
+	if (!_stateCheckpointPresent)
 	{
-		_log.pop_back();
+		_stateCheckpointEntries.clear();
+		for (LoadedDeviceInfoList::const_iterator i = _loadedDeviceInfoList.begin(); i != _loadedDeviceInfoList.end(); ++i)
+		{
+			StateCheckpointEntry entry;
+			entry.device = (*i).device;
+			entry.incrementalState = (*i).device->IsIncrementalStateSupported();
+			_stateCheckpointEntries.push_back(entry);
+		}
 	}
-	++_eventLogLastModifiedToken;
+
+	// Capture the current state of each device
+	_stateCheckpointTree.Initialize();
+	_stateCheckpointTree.GetRootNode().SetName(L"State");
+	unsigned int incrementalBytesCopied = 0;
+	for (StateCheckpointEntryList::iterator i = _stateCheckpointEntries.begin(); i != _stateCheckpointEntries.end(); ++i)
+	{
+		StateCheckpointEntry& entry = *i;
+		if (entry.incrementalState)
+		{
+			std::vector<IDevice::StateRegion> regions;
+			unsigned int stateSize = entry.device->GetIncrementalStateSize();
+			if (!_stateCheckpointPresent || (entry.stateData.size() != stateSize) || !entry.device->GetStateChangedRegions(entry.stateGeneration, regions))
+			{
+				entry.stateData.assign(stateSize, 0);
+				regions.assign(1, IDevice::StateRegion(0, stateSize));
+			}
+			for (std::vector<IDevice::StateRegion>::const_iterator regionIterator = regions.begin(); regionIterator != regions.end(); ++regionIterator)
+			{
+				if (regionIterator->size > 0)
+				{
+					entry.device->ReadStateRegion(regionIterator->offset, regionIterator->size, &entry.stateData[regionIterator->offset]);
+					incrementalBytesCopied += regionIterator->size;
+				}
+			}
+			entry.stateGeneration = entry.device->AdvanceStateGeneration();
+			entry.stateNode = 0;
+		}
+		else
+		{
+			IHierarchicalStorageNode& node = _stateCheckpointTree.GetRootNode().CreateChild(L"Device");
+			entry.device->SaveState(node);
+			entry.stateNode = &node;
+		}
+	}
+	_stateCheckpointPresent = true;
+
+	// Log the event
+	LogEntry logEntry(LogEntry::EventLevel::Info, L"System", L"");
+	logEntry << L"Captured state checkpoint. " << incrementalBytesCopied << L" bytes of device state were copied from devices supporting incremental state.";
+	WriteLogEvent(logEntry);
+
+	// Restore running state
+	lock.unlock();
+	if (running)
+	{
+		RunSystem();
+	}
+	return true;
 }
 
 //----------------------------------------------------------------------------------------------------------------------
-Marshal::Ret<std::vector<System::SystemLogEntry>> System::GetEventLog() const
+bool System::RestoreStateCheckpoint()
 {
-	std::unique_lock<std::mutex> lock(_eventLogMutex);
-	std::vector<SystemLogEntry> eventLogCopy(_log.size());
-	unsigned int eventLogCopyIndex = 0;
-	for (std::list<SystemLogEntry>::const_iterator i = _log.begin(); i != _log.end(); ++i)
+	// Save running state and pause system
+	bool running = SystemRunning();
+	StopSystem();
+	std::unique_lock<std::mutex> lock(_stateCheckpointMutex);
+
+	// Ensure a checkpoint has been captured for the current set of loaded devices
+	if (!_stateCheckpointPresent)
+	{
+		WriteLogEvent(LogEntry(LogEntry::EventLevel::Error, L"System", L"Failed to restore state checkpoint because no checkpoint has been captured since the loaded modules last changed!"));
+		lock.unlock();
+		if (running)
+		{
+			RunSystem();
+		}
+		return false;
+	}
+
+	// Restore the state of each device. For devices which support incremental state, only the
+	// regions which have changed since the checkpoint was captured need to be written back.
+	// Note that we negate the output line state here, and re-assert it after loading the state
+	// data, in the same way as when loading a savestate.
+	unsigned int incrementalBytesCopied = 0;
+	for (StateCheckpointEntryList::const_iterator i = _stateCheckpointEntries.begin(); i != _stateCheckpointEntries.end(); ++i)
+	{
+		const StateCheckpointEntry& entry = *i;
+		entry.device->NegateCurrentOutputLineState();
+		if (entry.incrementalState)
+		{
+			std::vector<IDevice::StateRegion> regions;
+			if (!entry.device->GetStateChangedRegions(entry.stateGeneration, regions))
+			{
+				regions.assign(1, IDevice::StateRegion(0, (unsigned int)entry.stateData.size()));
+			}
+			for (std::vector<IDevice::StateRegion>::const_iterator regionIterator = regions.begin(); regionIterator != regions.end(); ++regionIterator)
+			{
+				if ((regionIterator->size > 0) && (regionIterator->offset < entry.stateData.size()) && (regionIterator->size <= (entry.stateData.size() - regionIterator->offset)))
+				{
+					entry.device->WriteStateRegion(regionIterator->offset, regionIterator->size, &entry.stateData[regionIterator->offset]);
+					incrementalBytesCopied += regionIterator->size;
+				}
+			}
+		}
+		else
+		{
+			entry.device->LoadState(*entry.stateNode);
+		}
+		entry.device->AssertCurrentOutputLineState();
+	}
+
+	// Log the event
+	LogEntry logEntry(LogEntry::EventLevel::Info, L"System", L"");
+	logEntry << L"Restored state checkpoint. " << incrementalBytesCopied << L" bytes of device state were copied to devices supporting incremental state.";
+	WriteLogEvent(logEntry);
+
+	// Restore running state
+	lock.unlock();
+	if (running)
 	{
-		eventLogCopy[eventLogCopyIndex++] = *i;
+		RunSystem();
 	}
+	return true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool System::GetStateCheckpointPresent() const
+{
+	std::unique_lock<std::mutex> lock(_stateCheckpointMutex);
+	return _stateCheckpointPresent;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void System::DiscardStateCheckpoint()
+{
+	// Any change to the set of loaded devices invalidates the current checkpoint, as the
+	// checkpoint entries hold references to the devices they were captured from.
+	std::unique_lock<std::mutex> lock(_stateCheckpointMutex);
+	_stateCheckpointPresent = false;
+	_stateCheckpointEntries.clear();
+	_stateCheckpointTree.Initialize();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Logging functions
+//----------------------------------------------------------------------------------------------------------------------
+void System::WriteLogEvent(const ILogEntry& entry) const
+{
+	_eventLog.WriteEntry(entry);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+Marshal::Ret<std::vector<System::SystemLogEntry>> System::GetEventLog() const
+{
+	std::vector<SystemLogEntry> eventLogCopy;
+	_eventLog.ReadEntries(eventLogCopy);
 	return eventLogCopy;
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 unsigned int System::GetEventLogLastModifiedToken() const
 {
-	std::unique_lock<std::mutex> lock(_eventLogMutex);
-	return _eventLogLastModifiedToken;
+	return _eventLog.GetLastModifiedToken();
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 void System::ClearEventLog()
 {
-	std::unique_lock<std::mutex> lock(_eventLogMutex);
-	_log.clear();
-	++_eventLogLastModifiedToken;
+	_eventLog.Clear();
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 unsigned int System::GetEventLogSize() const
 {
-	std::unique_lock<std::mutex> lock(_eventLogMutex);
-	return _eventLogSize;
+	return _eventLog.GetMaxEntryCount();
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 void System::SetEventLogSize(unsigned int logSize)
 {
-	std::unique_lock<std::mutex> lock(_eventLogMutex);
-	_eventLogSize = logSize;
-	while (_log.size() > _eventLogSize)
+	// The event log ring has a fixed record capacity, so a larger log size is clamped to
+	// that capacity. We report this in the event log itself, so that the effective log
+	// size isn't silently different from the requested size.
+	unsigned int entryCapacity = EventLogRing::GetEntryCapacity();
+	if (logSize > entryCapacity)
 	{
-		_log.pop_back();
+		LogEntry logEntry(LogEntry::EventLevel::Warning, L"System", L"");
+		logEntry << L"The requested event log size of " << logSize << L" entries exceeds the event log capacity. The event log size has been limited to " << entryCapacity << L" entries.";
+		WriteLogEvent(logEntry);
 	}
-	++_eventLogLastModifiedToken;
+	_eventLog.SetMaxEntryCount(logSize);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -2089,6 +2263,18 @@ void System::SetEnablePersistentState(bool state)
 	_enablePersistentState = state;
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+bool System::GetBinarySavestateFormatState() const
+{
+	return _binarySavestateFormat;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void System::SetBinarySavestateFormatState(bool state)
+{
+	_binarySavestateFormat = state;
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 void System::SignalSystemStopped()
 {
@@ -2252,6 +2438,11 @@ void System::ExecuteSystemStep(double targetTime)
 //----------------------------------------------------------------------------------------------------------------------
 double System::ExecuteSystemStepInternal(double maximumTimeslice)
 {
+	// Determine which buffered input events are due to be delivered in this timeslice. If
+	// further events are waiting, the timeslice is limited to end at the time the next one
+	// is due, so that it can be delivered at the correct point in emulated time.
+	maximumTimeslice = PrepareStoredInputEvents(maximumTimeslice);
+
 	// Determine the maximum length of time all devices can run unsynchronized before the
 	// next timing point
 	DeviceContext* nextDeviceStep = 0;
@@ -2312,6 +2503,11 @@ double System::ExecuteSystemStepInternal(double maximumTimeslice)
 			std::wcout << "Rollback\t" << std::setprecision(16) << _rollbackTimeslice << '\n';
 			_executionManager.Rollback();
 
+			// Flag that the input events delivered in this timeslice have been rolled back.
+			// If we're rolling back to the start of the timeslice, we won't execute it again
+			// here, so the events are left in the queue to be delivered in the next one.
+			_inputEventsSent = false;
+
 			//##DEBUG##
 			if (_rollbackTimeslice < 0)
 			{
@@ -2365,7 +2561,7 @@ double System::ExecuteSystemStepInternal(double maximumTimeslice)
 	_executionManager.Commit();
 
 	// Clear all input events which have been successfully processed
-	ClearSentStoredInputEvents();
+	ClearSentStoredInputEvents(timeslice);
 
 	return timeslice;
 }
@@ -2861,8 +3057,8 @@ bool System::LoadPersistentGlobalExtension(const std::wstring& extensionName)
 	}
 
 	// Construct the extension object
-	HierarchicalStorageNode node;
-	if (!extension->Construct(node))
+	HierarchicalStorageTree tree;
+	if (!extension->Construct(tree.GetRootNode()))
 	{
 		WriteLogEvent(LogEntry(LogEntry::EventLevel::Error, L"System", L"Construct failed for " + extensionName + L"!"));
 		DestroyExtension(extensionName, extension);
@@ -3380,6 +3576,18 @@ bool System::LoadModuleInternal(const std::wstring& filePath, const ConnectorMap
 		}
 		Stream::IStream& dataStream = *binaryFileStreamReference;
 
+		// If the element has requested that its binary data be mapped directly from the
+		// source file, and the target is a plain file on disk rather than an entry within an
+		// archive, pass the resolved path through to the device rather than loading the file
+		// contents here. The device is responsible for mapping the file when it's
+		// constructed.
+		IHierarchicalStorageAttribute* mapBinaryDataAttribute = (*i)->GetAttribute(L"MapBinaryData");
+		if ((mapBinaryDataAttribute != 0) && mapBinaryDataAttribute->ExtractValue<bool>() && (_guiExtensionInterface.PathSplitElements(binaryFilePath).Get().size() == 1))
+		{
+			(*i)->CreateAttribute(L"MappedBinaryDataPath", binaryFilePath);
+			continue;
+		}
+
 		// Obtain a reference to the binary data stream within this XML element
 		Stream::IStream& binaryData = (*i)->GetBinaryDataBufferStream();
 		binaryData.SetStreamPos(0);
@@ -3518,23 +3726,32 @@ bool System::LoadModuleInternal(const std::wstring& filePath, const ConnectorMap
 		++displayNameModuleIterator;
 	}
 
-	// Load the elements from the root node one by one
+	// Create and construct all the devices defined in this module up front. Devices can be
+	// constructed independently of each other, so this is done in parallel before any of the
+	// remaining elements, which bind the devices together, are processed.
 	bool loadedWithoutErrors = true;
-	NameToIDMap connectorNameToIDMap;
-	NameToIDMap lineGroupNameToIDMap;
-	unsigned int entriesProcessed = 0;
 	std::list<IHierarchicalStorageNode*> childList = rootNode.GetChildList();
 	unsigned int entryCount = (unsigned int)childList.size();
+	unsigned int entriesProcessed = (unsigned int)std::count_if(childList.begin(), childList.end(), [](IHierarchicalStorageNode* entry) { return (entry->GetName() == L"Device"); });
+	std::chrono::steady_clock::time_point deviceLoadStartTime = std::chrono::steady_clock::now();
+	loadedWithoutErrors &= LoadModule_Devices(childList, moduleInfo.moduleID);
+	std::chrono::steady_clock::time_point deviceLoadEndTime = std::chrono::steady_clock::now();
+	_loadSystemProgress = ((float)entriesProcessed / (float)entryCount);
+
+	// Load the remaining elements from the root node one by one
+	NameToIDMap connectorNameToIDMap;
+	NameToIDMap lineGroupNameToIDMap;
 	for (std::list<IHierarchicalStorageNode*>::const_iterator i = childList.begin(); !_loadSystemAbort && (i != childList.end()); ++i)
 	{
-		_loadSystemProgress = ((float)++entriesProcessed / (float)entryCount);
-
 		std::wstring elementName = (*i)->GetName();
 		if (elementName == L"Device")
 		{
-			loadedWithoutErrors &= LoadModule_Device(*(*i), moduleInfo.moduleID);
+			// Devices have already been loaded above
+			continue;
 		}
-		else if (elementName == L"Device.SetDependentDevice")
+
+		_loadSystemProgress = ((float)++entriesProcessed / (float)entryCount);
+		if (elementName == L"Device.SetDependentDevice")
 		{
 			loadedWithoutErrors &= LoadModule_Device_SetDependentDevice(*(*i), moduleInfo.moduleID);
 		}
@@ -3769,6 +3986,12 @@ bool System::LoadModuleInternal(const std::wstring& filePath, const ConnectorMap
 			WriteLogEvent(LogEntry(LogEntry::EventLevel::Warning, L"System", L"Unrecognized element: " + elementName + L" when loading module file " + filePath + L"."));
 		}
 	}
+	std::chrono::steady_clock::time_point bindingEndTime = std::chrono::steady_clock::now();
+
+	// Log the time taken by each phase of the module load
+	LogEntry loadTimeLogEntry(LogEntry::EventLevel::Info, L"System", L"");
+	loadTimeLogEntry << L"Loaded module " << moduleInfo.displayName << L": device construction took " << std::chrono::duration_cast<std::chrono::milliseconds>(deviceLoadEndTime - deviceLoadStartTime).count() << L"ms, binding took " << std::chrono::duration_cast<std::chrono::milliseconds>(bindingEndTime - deviceLoadEndTime).count() << L"ms.";
+	WriteLogEvent(loadTimeLogEntry);
 
 	// Add the info for this module to the list of loaded modules
 	addedModuleIDs.push_back(moduleInfo.moduleID);
@@ -4542,6 +4765,7 @@ void System::UnloadModuleInternal(unsigned int moduleID)
 			}
 
 			// Delete the device
+			DiscardStateCheckpoint();
 			UnloadDevice(currentElement->device);
 			_loadedDeviceInfoList.erase(currentElement);
 		}
@@ -4763,6 +4987,12 @@ void System::UnloadModuleInternal(unsigned int moduleID)
 
 //----------------------------------------------------------------------------------------------------------------------
 unsigned int System::GetFirstAvailableDeviceIndex() const
+{
+	return GetFirstAvailableDeviceIndex(PendingDeviceInfoList());
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+unsigned int System::GetFirstAvailableDeviceIndex(const PendingDeviceInfoList& pendingDevices) const
 {
 	bool deviceIndexFree;
 	unsigned int deviceIndex;
@@ -4779,6 +5009,13 @@ unsigned int System::GetFirstAvailableDeviceIndex() const
 				break;
 			}
 		}
+
+		// Device indexes which have been handed out to devices that are still being loaded
+		// are also considered to be in use.
+		for (unsigned int i = 0; deviceIndexFree && (i < pendingDevices.size()); ++i)
+		{
+			deviceIndexFree = (pendingDevices[i].deviceContext->GetDeviceIndexNo() != deviceIndex);
+		}
 	}
 	while (!deviceIndexFree);
 	return deviceIndex;
@@ -4870,6 +5107,27 @@ unsigned int System::GenerateFreeEmbeddedROMID() const
 
 //----------------------------------------------------------------------------------------------------------------------
 bool System::LoadModule_Device(IHierarchicalStorageNode& node, unsigned int moduleID)
+{
+	// Create the device, and bind it to a new device context
+	PendingDeviceInfo deviceInfo;
+	if (!LoadModule_Device_Create(node, moduleID, PendingDeviceInfoList(), deviceInfo))
+	{
+		return false;
+	}
+
+	// Construct and build the device
+	if (!LoadModule_Device_Construct(deviceInfo))
+	{
+		return false;
+	}
+
+	// Add the device object to the system
+	LoadModule_Device_Register(deviceInfo);
+	return true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool System::LoadModule_Device_Create(IHierarchicalStorageNode& node, unsigned int moduleID, const PendingDeviceInfoList& pendingDevices, PendingDeviceInfo& deviceInfo)
 {
 	// Load the device class and instance names
 	IHierarchicalStorageAttribute* deviceNameAttribute = node.GetAttribute(L"DeviceName");
@@ -4910,7 +5168,7 @@ bool System::LoadModule_Device(IHierarchicalStorageNode& node, unsigned int modu
 	DeviceContext* deviceContext = new DeviceContext(*device, *this);
 
 	// Associate this device with the first available device index number
-	unsigned int newDeviceIndexNumber = GetFirstAvailableDeviceIndex();
+	unsigned int newDeviceIndexNumber = GetFirstAvailableDeviceIndex(pendingDevices);
 	deviceContext->SetDeviceIndexNo(newDeviceIndexNumber);
 
 	// Bind our device to the device context object
@@ -4918,14 +5176,36 @@ bool System::LoadModule_Device(IHierarchicalStorageNode& node, unsigned int modu
 	{
 		WriteLogEvent(LogEntry(LogEntry::EventLevel::Error, L"System", L"BindToDeviceContext failed for  " + instanceName + L"!"));
 		DestroyDevice(deviceName, device);
+		delete deviceContext;
 		return false;
 	}
 
+	// Return information on the created device to the caller
+	deviceInfo.node = &node;
+	deviceInfo.device = device;
+	deviceInfo.deviceContext = deviceContext;
+	deviceInfo.deviceName = deviceName;
+	deviceInfo.name = instanceName;
+	deviceInfo.displayName = displayName;
+	deviceInfo.moduleID = moduleID;
+	deviceInfo.constructed = false;
+	return true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool System::LoadModule_Device_Construct(PendingDeviceInfo& deviceInfo) const
+{
+	// Note that this function may be called from a worker thread, with other devices being
+	// constructed in parallel. The device has no access to any other device at this point,
+	// so only the device itself and the thread safe logging functions are touched here.
+	IDevice* device = deviceInfo.device;
+
 	// Construct the device object
-	if (!device->Construct(node))
+	if (!device->Construct(*deviceInfo.node))
 	{
-		WriteLogEvent(LogEntry(LogEntry::EventLevel::Error, L"System", L"Construct failed for " + instanceName + L"!"));
-		DestroyDevice(deviceName, device);
+		WriteLogEvent(LogEntry(LogEntry::EventLevel::Error, L"System", L"Construct failed for " + deviceInfo.name + L"!"));
+		DestroyDevice(deviceInfo.deviceName, device);
+		delete deviceInfo.deviceContext;
 		return false;
 	}
 
@@ -4933,25 +5213,104 @@ bool System::LoadModule_Device(IHierarchicalStorageNode& node, unsigned int modu
 	// device
 	if (!device->BuildDevice())
 	{
-		WriteLogEvent(LogEntry(LogEntry::EventLevel::Error, L"System", L"BuildDevice failed for " + instanceName + L"!"));
-		DestroyDevice(deviceName, device);
+		WriteLogEvent(LogEntry(LogEntry::EventLevel::Error, L"System", L"BuildDevice failed for " + deviceInfo.name + L"!"));
+		DestroyDevice(deviceInfo.deviceName, device);
+		delete deviceInfo.deviceContext;
 		return false;
 	}
 
+	deviceInfo.constructed = true;
+	return true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void System::LoadModule_Device_Register(const PendingDeviceInfo& deviceInfo)
+{
 	// Add the device object to the system
 	std::unique_lock<std::mutex> loadedElementLock(_loadedElementMutex);
-	LoadedDeviceInfo deviceInfo;
-	deviceInfo.moduleID = moduleID;
-	deviceInfo.device = device;
-	deviceInfo.deviceContext = deviceContext;
-	deviceInfo.name = instanceName;
-	deviceInfo.displayName = displayName;
-	_loadedDeviceInfoList.push_back(deviceInfo);
-	_devices.push_back(deviceContext);
-	_executionManager.AddDevice(deviceContext);
+	DiscardStateCheckpoint();
+	LoadedDeviceInfo loadedDeviceInfo;
+	loadedDeviceInfo.moduleID = deviceInfo.moduleID;
+	loadedDeviceInfo.device = deviceInfo.device;
+	loadedDeviceInfo.deviceContext = deviceInfo.deviceContext;
+	loadedDeviceInfo.name = deviceInfo.name;
+	loadedDeviceInfo.displayName = deviceInfo.displayName;
+	_loadedDeviceInfoList.push_back(loadedDeviceInfo);
+	_devices.push_back(deviceInfo.deviceContext);
+	_executionManager.AddDevice(deviceInfo.deviceContext);
+}
 
-	return true;
+//----------------------------------------------------------------------------------------------------------------------
+bool System::LoadModule_Devices(const std::list<IHierarchicalStorageNode*>& childList, unsigned int moduleID)
+{
+	// Create each device defined in this module in definition order, and assign each one a
+	// unique device index. This is done serially, as device creation and index assignment
+	// have to be consistent from one load to the next for savestates to match up.
+	bool loadedWithoutErrors = true;
+	PendingDeviceInfoList pendingDevices;
+	for (std::list<IHierarchicalStorageNode*>::const_iterator i = childList.begin(); !_loadSystemAbort && (i != childList.end()); ++i)
+	{
+		if ((*i)->GetName() == L"Device")
+		{
+			PendingDeviceInfo deviceInfo;
+			if (LoadModule_Device_Create(*(*i), moduleID, pendingDevices, deviceInfo))
+			{
+				pendingDevices.push_back(deviceInfo);
+			}
+			else
+			{
+				loadedWithoutErrors = false;
+			}
+		}
+	}
+
+	// Construct and build each device. Devices are independent of each other until they're
+	// bound together by the later elements in the module definition, so the potentially
+	// expensive work of constructing them, such as loading and decoding ROM data, is spread
+	// across a set of worker threads here.
+	unsigned int pendingDeviceCount = (unsigned int)pendingDevices.size();
+	unsigned int workerThreadCount = std::max(std::min(std::thread::hardware_concurrency(), pendingDeviceCount), 1u);
+	std::atomic<unsigned int> nextPendingDeviceIndex(0);
+	std::function<void()> constructWorker = [&]()
+	{
+		unsigned int pendingDeviceIndex;
+		while (!_loadSystemAbort && ((pendingDeviceIndex = nextPendingDeviceIndex++) < pendingDeviceCount))
+		{
+			LoadModule_Device_Construct(pendingDevices[pendingDeviceIndex]);
+		}
+	};
+	std::vector<std::thread> workerThreads;
+	for (unsigned int i = 1; i < workerThreadCount; ++i)
+	{
+		workerThreads.push_back(std::thread(constructWorker));
+	}
+	constructWorker();
+	for (unsigned int i = 0; i < workerThreads.size(); ++i)
+	{
+		workerThreads[i].join();
+	}
 
+	// Add each successfully constructed device to the system in definition order. If a
+	// load abort was requested while devices were still being constructed, any devices we
+	// didn't get to are destroyed here.
+	for (unsigned int i = 0; i < pendingDeviceCount; ++i)
+	{
+		const PendingDeviceInfo& deviceInfo = pendingDevices[i];
+		if (deviceInfo.constructed)
+		{
+			LoadModule_Device_Register(deviceInfo);
+		}
+		else
+		{
+			if (i >= nextPendingDeviceIndex)
+			{
+				DestroyDevice(deviceInfo.deviceName, deviceInfo.device);
+				delete deviceInfo.deviceContext;
+			}
+			loadedWithoutErrors = false;
+		}
+	}
+	return loadedWithoutErrors;
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -9333,36 +9692,67 @@ bool System::TranslateJoystickAxis(unsigned int joystickNo, unsigned int axisNo,
 //----------------------------------------------------------------------------------------------------------------------
 void System::HandleInputKeyDown(KeyCode keyCode)
 {
-	std::unique_lock<std::mutex> lock(_inputMutex);
-	if (!_systemStopped)
+	// Discard this event if the system isn't running, or if the key isn't mapped to any
+	// device. We test the mapping using a flag which is maintained alongside the key map,
+	// so that we don't need to obtain the input lock on the host input thread.
+	unsigned int keyCodeIndex = (unsigned int)keyCode;
+	if (_systemStopped || (keyCodeIndex >= KeyCodeCount) || !_inputKeyCodeMapped[keyCodeIndex])
 	{
-		InputKeyMap::const_iterator i = _inputKeyMap.find(keyCode);
-		if (i != _inputKeyMap.end())
-		{
-			InputEventEntry entry;
-			entry.sent = false;
-			entry.inputEvent = InputEvent::KeyDown;
-			entry.keyCode = keyCode;
-			_inputEvents.push_back(entry);
-		}
+		return;
+	}
+
+	// If this key is already held, this is an auto-repeat event from the host, and it's
+	// discarded, so that holding a key can't fill the queue.
+	if (_inputKeyCodePressed[keyCodeIndex].exchange(true))
+	{
+		return;
+	}
+
+	// If the release of this key was never queued because the queue was full, the target
+	// device still sees this key as held, so we cancel the pending release rather than
+	// queueing another press.
+	if (_inputKeyCodeReleasePending[keyCodeIndex].exchange(false))
+	{
+		--_inputReleasePendingCount;
+		return;
+	}
+
+	// Queue this input event for delivery. If the queue is full the press is lost, in which
+	// case we flag the key as released again, so that the matching release is discarded.
+	InputEventEntry entry;
+	entry.inputEvent = InputEvent::KeyDown;
+	entry.keyCode = keyCode;
+	entry.hostTime = std::chrono::steady_clock::now();
+	if (!_inputEvents.WriteEntry(entry))
+	{
+		_inputKeyCodePressed[keyCodeIndex] = false;
 	}
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 void System::HandleInputKeyUp(KeyCode keyCode)
 {
-	std::unique_lock<std::mutex> lock(_inputMutex);
-	if (!_systemStopped)
+	// Discard this event if we never queued a press for this key. Note that releases are
+	// queued even if the system has been stopped since the key was pressed, so that the key
+	// isn't left held by the target device when the system resumes.
+	unsigned int keyCodeIndex = (unsigned int)keyCode;
+	if ((keyCodeIndex >= KeyCodeCount) || !_inputKeyCodePressed[keyCodeIndex].exchange(false))
 	{
-		InputKeyMap::const_iterator i = _inputKeyMap.find(keyCode);
-		if (i != _inputKeyMap.end())
-		{
-			InputEventEntry entry;
-			entry.sent = false;
-			entry.inputEvent = InputEvent::KeyUp;
-			entry.keyCode = keyCode;
-			_inputEvents.push_back(entry);
-		}
+		return;
+	}
+
+	// Queue this input event for delivery. If the queue is full, we can't drop this event
+	// without leaving the key held, so we flag the release as pending instead. Pending
+	// releases are delivered once every event which was queued before them has been
+	// delivered.
+	InputEventEntry entry;
+	entry.inputEvent = InputEvent::KeyUp;
+	entry.keyCode = keyCode;
+	entry.hostTime = std::chrono::steady_clock::now();
+	if (!_inputEvents.WriteEntry(entry))
+	{
+		++_inputReleasePendingCount;
+		_inputKeyCodeReleasePending[keyCodeIndex] = true;
 	}
 }
 
@@ -9490,6 +9880,7 @@ bool System::SetDeviceKeyCodeMapping(IDevice* targetDevice, unsigned int deviceK
 		const InputMapEntry& inputMapEntry = inputKeyMapIterator->second;
 		if ((inputMapEntry.targetDevice == targetDevice) && (inputMapEntry.targetDeviceKeyCode == deviceKeyCode))
 		{
+			_inputKeyCodeMapped[(unsigned int)inputMapEntry.keyCode] = false;
 			_inputKeyMap.erase(inputKeyMapIterator);
 			break;
 		}
@@ -9505,6 +9896,7 @@ bool System::SetDeviceKeyCodeMapping(IDevice* targetDevice, unsigned int deviceK
 		mapEntry.targetDevice = targetDevice;
 		mapEntry.targetDeviceKeyCode = deviceKeyCode;
 		_inputKeyMap[systemKeyCode] = mapEntry;
+		_inputKeyCodeMapped[(unsigned int)systemKeyCode] = true;
 	}
 	return true;
 }
@@ -9523,21 +9915,92 @@ void System::UnmapAllKeyCodeMappingsForDevice(IDevice* device)
 	}
 	for (std::list<KeyCode>::const_iterator i = keyCodesToRemove.begin(); i != keyCodesToRemove.end(); ++i)
 	{
+		_inputKeyCodeMapped[(unsigned int)*i] = false;
 		_inputKeyMap.erase(*i);
 	}
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+double System::PrepareStoredInputEvents(double maximumTimeslice)
+{
+	// If no input events are waiting to be delivered, abort any further processing. This is
+	// the common case, and requires no locking.
+	_inputEventsPreparedCount = 0;
+	if (_inputEvents.Empty() && (_inputReleasePendingCount == 0) && _inputReleasesPrepared.empty())
+	{
+		return maximumTimeslice;
+	}
+
+	// Determine how many events at the front of the queue are due to be delivered at the
+	// start of this timeslice. Each event is due after the event before it by the same
+	// amount of time which separated them on the host, so that a key which is pressed and
+	// released within a single timeslice is still held long enough for the system to see
+	// it. This spacing is limited, so that an event which arrives after a long idle period
+	// isn't delayed, and an event is never delivered before the current time.
+	double timeslice = maximumTimeslice;
+	double lastDeliveryTime = _inputEventLastDeliveryTime;
+	std::chrono::steady_clock::time_point lastHostTime = _inputEventLastHostTime;
+	unsigned int readableEntryCount = _inputEvents.GetReadableEntryCount();
+	while (_inputEventsPreparedCount < readableEntryCount)
+	{
+		const InputEventEntry& entry = _inputEvents.GetEntry(_inputEventsPreparedCount);
+		long long hostTimeSinceLastEvent = std::chrono::duration_cast<std::chrono::nanoseconds>(entry.hostTime - lastHostTime).count();
+		double deliveryTime = lastDeliveryTime + (double)std::min(std::max(hostTimeSinceLastEvent, 0LL), (long long)MaxInputEventSpacingInNanoseconds);
+		if (deliveryTime > _inputEventTime)
+		{
+			// The next event isn't due yet, so end this timeslice at the time it's due. This
+			// acts as a timing point, and the event is delivered at the start of the
+			// following timeslice.
+			timeslice = std::min(timeslice, deliveryTime - _inputEventTime);
+			break;
+		}
+		lastDeliveryTime = _inputEventTime;
+		lastHostTime = entry.hostTime;
+		++_inputEventsPreparedCount;
+	}
+	_inputEventPreparedDeliveryTime = lastDeliveryTime;
+	_inputEventPreparedHostTime = lastHostTime;
+
+	// If every event in the queue is being delivered in this timeslice, deliver any pending
+	// releases after them. Since these releases were only flagged as pending because the
+	// queue was full at the time, every event which was queued before them for the same key
+	// has now been delivered.
+	if ((_inputEventsPreparedCount == readableEntryCount) && (_inputReleasePendingCount != 0))
+	{
+		for (unsigned int i = 0; i < KeyCodeCount; ++i)
+		{
+			if (_inputKeyCodeReleasePending[i].exchange(false))
+			{
+				--_inputReleasePendingCount;
+				_inputReleasesPrepared.push_back((KeyCode)i);
+			}
+		}
+	}
+	return timeslice;
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 void System::SendStoredInputEvents()
 {
+	// If no input events are due to be delivered in this timeslice, abort any further
+	// processing. This is the common case, and requires no locking.
+	_inputEventsSent = true;
+	if ((_inputEventsPreparedCount == 0) && _inputReleasesPrepared.empty())
+	{
+		return;
+	}
+
+	// Deliver all input events which are due in this timeslice to their target devices.
+	// Note that events remain in the queue until the timeslice they were delivered in has
+	// been committed, so that they're delivered again if this timeslice is rolled back.
 	std::unique_lock<std::mutex> lock(_inputMutex);
-	for (std::list<InputEventEntry>::iterator i = _inputEvents.begin(); i != _inputEvents.end(); ++i)
+	for (unsigned int i = 0; i < _inputEventsPreparedCount; ++i)
 	{
-		i->sent = true;
-		InputKeyMap::const_iterator keyMapEntry = _inputKeyMap.find(i->keyCode);
+		const InputEventEntry& entry = _inputEvents.GetEntry(i);
+		InputKeyMap::const_iterator keyMapEntry = _inputKeyMap.find(entry.keyCode);
 		if (keyMapEntry != _inputKeyMap.end())
 		{
-			switch (i->inputEvent)
+			switch (entry.inputEvent)
 			{
 			case InputEvent::KeyDown:
 				keyMapEntry->second.targetDevice->HandleInputKeyDown(keyMapEntry->second.targetDeviceKeyCode);
@@ -9548,18 +10011,37 @@ void System::SendStoredInputEvents()
 			}
 		}
 	}
+	for (unsigned int i = 0; i < (unsigned int)_inputReleasesPrepared.size(); ++i)
+	{
+		InputKeyMap::const_iterator keyMapEntry = _inputKeyMap.find(_inputReleasesPrepared[i]);
+		if (keyMapEntry != _inputKeyMap.end())
+		{
+			keyMapEntry->second.targetDevice->HandleInputKeyUp(keyMapEntry->second.targetDeviceKeyCode);
+		}
+	}
 }
 
 //----------------------------------------------------------------------------------------------------------------------
-void System::ClearSentStoredInputEvents()
+void System::ClearSentStoredInputEvents(double timeslice)
 {
-	std::unique_lock<std::mutex> lock(_inputMutex);
-	std::list<InputEventEntry>::iterator i = _inputEvents.begin();
-	while ((i != _inputEvents.end()) && i->sent)
+	// Release all input events which were delivered in the committed timeslice. If the
+	// timeslice was rolled back to its start, the events are kept to be delivered in the
+	// next timeslice.
+	if (_inputEventsSent)
 	{
-		++i;
+		if (_inputEventsPreparedCount > 0)
+		{
+			_inputEvents.ReleaseEntries(_inputEventsPreparedCount);
+			_inputEventLastDeliveryTime = _inputEventPreparedDeliveryTime;
+			_inputEventLastHostTime = _inputEventPreparedHostTime;
+		}
+		_inputReleasesPrepared.clear();
+		_inputEventsSent = false;
 	}
-	_inputEvents.erase(_inputEvents.begin(), i);
+	_inputEventsPreparedCount = 0;
+
+	// Advance the current time used to schedule input events
+	_inputEventTime += timeslice;
 }
 
 //----------------------------------------------------------------------------------------------------------------------
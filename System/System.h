@@ -26,11 +26,16 @@ should be able to be sent to all devices simultaneously.
 #include "ClockSource.h"
 #include "DeviceContext.h"
 #include "ExecutionManager.h"
+#include "EventLogRing.h"
+#include "InputEventQueue.h"
+#include "HierarchicalStorage/HierarchicalStorage.pkg"
 #include <string>
 #include <vector>
 #include <map>
 #include <mutex>
 #include <condition_variable>
+#include <atomic>
+#include <chrono>
 
 // Terminology:
 // Assembly  - An assembly (IE, a dll) which contains the definition of one or more devices
@@ -77,6 +82,11 @@ public:
 	virtual bool LoadModuleRelationshipsNode(IHierarchicalStorageNode& node, const Marshal::Out<ModuleRelationshipMap>& relationshipMap) const;
 	virtual void SaveModuleRelationshipsNode(IHierarchicalStorageNode& node, bool saveFilePathInfo = false, const Marshal::In<std::wstring>& relativePathBase = L"") const;
 
+	// State checkpoint functions
+	virtual bool CaptureStateCheckpoint();
+	virtual bool RestoreStateCheckpoint();
+	virtual bool GetStateCheckpointPresent() const;
+
 	// Logging functions
 	virtual void WriteLogEvent(const ILogEntry& entry) const;
 	virtual Marshal::Ret<std::vector<SystemLogEntry>> GetEventLog() const;
@@ -115,6 +125,8 @@ public:
 	virtual void SetRunWhenProgramModuleLoadedState(bool state);
 	virtual bool GetEnablePersistentState() const;
 	virtual void SetEnablePersistentState(bool state);
+	virtual bool GetBinarySavestateFormatState() const;
+	virtual void SetBinarySavestateFormatState(bool state);
 
 	// Device registration
 	virtual bool RegisterDevice(const IDeviceInfo& entry, AssemblyHandle assemblyHandle);
@@ -214,6 +226,7 @@ private:
 	struct DeviceLibraryEntry;
 	struct ExtensionLibraryEntry;
 	struct LoadedDeviceInfo;
+	struct PendingDeviceInfo;
 	struct ExportedDeviceInfo;
 	struct ImportedDeviceInfo;
 	struct LoadedExtensionInfo;
@@ -247,6 +260,7 @@ private:
 	struct ImportedSystemSettingInfo;
 	struct SystemLineMapping;
 	struct EmbeddedROMInfoInternal;
+	struct StateCheckpointEntry;
 
 	// Typedefs
 	typedef std::map<std::wstring, unsigned int> NameToIDMap;
@@ -254,6 +268,7 @@ private:
 	typedef std::map<unsigned int, LoadedModuleInfoInternal> LoadedModuleInfoMap;
 	typedef std::pair<unsigned int, LoadedModuleInfoInternal> LoadedModuleInfoMapEntry;
 	typedef std::list<LoadedDeviceInfo> LoadedDeviceInfoList;
+	typedef std::vector<PendingDeviceInfo> PendingDeviceInfoList;
 	typedef std::list<ImportedDeviceInfo> ImportedDeviceInfoList;
 	typedef std::vector<DeviceContext*> DeviceArray;
 	typedef std::list<LoadedExtensionInfo> LoadedExtensionInfoList;
@@ -286,6 +301,11 @@ private:
 	typedef std::list<ImportedSystemLineInfo> ImportedSystemLineList;
 	typedef std::list<ImportedSystemSettingInfo> ImportedSystemSettingList;
 	typedef std::list<SystemLineMapping> SystemLineMappingList;
+	typedef std::list<StateCheckpointEntry> StateCheckpointEntryList;
+
+	// Constants
+	static const unsigned int KeyCodeCount = (unsigned int)KeyCode::EndOfList;
+	static const unsigned int MaxInputEventSpacingInNanoseconds = 20000000;
 
 private:
 	// Embedded ROM functions
@@ -308,8 +328,12 @@ private:
 	void SaveModuleRelationshipsImportConnectors(IHierarchicalStorageNode& moduleNode, unsigned int moduleID) const;
 	bool DoesLoadedModuleMatchSavedModule(const SavedRelationshipMap& savedRelationshipData, const SavedRelationshipModule& savedModuleInfo, const LoadedModuleInfoInternal& loadedModuleInfo, const ConnectorInfoMapOnImportingModuleID& connectorDetailsOnImportingModuleID) const;
 
+	// State checkpoint functions
+	void DiscardStateCheckpoint();
+
 	// Module loading and unloading
 	unsigned int GetFirstAvailableDeviceIndex() const;
+	unsigned int GetFirstAvailableDeviceIndex(const PendingDeviceInfoList& pendingDevices) const;
 	unsigned int GenerateFreeModuleID() const;
 	unsigned int GenerateFreeConnectorID() const;
 	unsigned int GenerateFreeLineGroupID() const;
@@ -317,6 +341,10 @@ private:
 	unsigned int GenerateFreeSystemSettingID() const;
 	unsigned int GenerateFreeEmbeddedROMID() const;
 	bool LoadModule_Device(IHierarchicalStorageNode& node, unsigned int moduleID);
+	bool LoadModule_Device_Create(IHierarchicalStorageNode& node, unsigned int moduleID, const PendingDeviceInfoList& pendingDevices, PendingDeviceInfo& deviceInfo);
+	bool LoadModule_Device_Construct(PendingDeviceInfo& deviceInfo) const;
+	void LoadModule_Device_Register(const PendingDeviceInfo& deviceInfo);
+	bool LoadModule_Devices(const std::list<IHierarchicalStorageNode*>& childList, unsigned int moduleID);
 	bool LoadModule_Device_SetDependentDevice(IHierarchicalStorageNode& node, unsigned int moduleID);
 	bool LoadModule_Device_ReferenceDevice(IHierarchicalStorageNode& node, unsigned int moduleID);
 	bool LoadModule_Device_ReferenceExtension(IHierarchicalStorageNode& node, unsigned int moduleID);
@@ -436,8 +464,9 @@ private:
 
 	// Input functions
 	void UnmapAllKeyCodeMappingsForDevice(IDevice* device);
+	double PrepareStoredInputEvents(double maximumTimeslice);
 	void SendStoredInputEvents();
-	void ClearSentStoredInputEvents();
+	void ClearSentStoredInputEvents(double timeslice);
 
 	// System setting functions
 	bool ApplySystemStateChange(const SystemStateChange& stateChange);
@@ -530,13 +559,32 @@ private:
 	unsigned int _inputDeviceListLastModifiedToken;
 	InputRegistrationList _inputRegistrationList;
 	InputKeyMap _inputKeyMap;
-	std::list<InputEventEntry> _inputEvents;
+	std::atomic<bool> _inputKeyCodeMapped[KeyCodeCount];
+	std::atomic<bool> _inputKeyCodePressed[KeyCodeCount];
+	std::atomic<bool> _inputKeyCodeReleasePending[KeyCodeCount];
+	std::atomic<unsigned int> _inputReleasePendingCount;
+	InputEventQueue<InputEventEntry> _inputEvents;
+	std::vector<KeyCode> _inputReleasesPrepared;
+	unsigned int _inputEventsPreparedCount;
+	bool _inputEventsSent;
+	double _inputEventTime;
+	double _inputEventLastDeliveryTime;
+	std::chrono::steady_clock::time_point _inputEventLastHostTime;
+	double _inputEventPreparedDeliveryTime;
+	std::chrono::steady_clock::time_point _inputEventPreparedHostTime;
 
 	// System settings
 	std::wstring _capturePath;
 	bool _enableThrottling;
 	bool _runWhenProgramModuleLoaded;
 	bool _enablePersistentState;
+	bool _binarySavestateFormat;
+
+	// State checkpoint settings
+	mutable std::mutex _stateCheckpointMutex;
+	bool _stateCheckpointPresent;
+	StateCheckpointEntryList _stateCheckpointEntries;
+	HierarchicalStorageTree _stateCheckpointTree;
 
 	// Connector settings
 	mutable unsigned int _nextFreeConnectorID;
@@ -551,7 +599,6 @@ private:
 	mutable std::mutex _systemStateMutex;
 	mutable std::mutex _moduleLoadMutex;
 	mutable std::mutex _loadedElementMutex;
-	mutable std::mutex _eventLogMutex;
 	mutable std::mutex _embeddedROMMutex;
 	mutable std::recursive_mutex _moduleSettingMutex;
 
@@ -560,7 +607,7 @@ private:
 	std::condition_variable _notifySystemStarted;
 	std::condition_variable _notifySystemStopped;
 	volatile bool _stopSystem;
-	volatile bool _systemStopped;
+	std::atomic<bool> _systemStopped;
 	volatile bool _initialize;
 	volatile bool _rollback;
 	volatile float _loadSystemProgress;
@@ -581,9 +628,7 @@ private:
 	void* _rollbackParams;
 
 	// Event log settings
-	unsigned int _eventLogSize;
-	mutable unsigned int _eventLogLastModifiedToken;
-	mutable std::list<SystemLogEntry> _log;
+	mutable EventLogRing _eventLog;
 
 	// Notification settings
 	ObserverCollection _loadedModuleChangeObservers;
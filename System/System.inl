@@ -65,6 +65,19 @@ struct System::LoadedDeviceInfo
 	std::set<IExtension*> menuHandlers;
 };
 
+//----------------------------------------------------------------------------------------------------------------------
+struct System::PendingDeviceInfo
+{
+	IHierarchicalStorageNode* node;
+	IDevice* device;
+	DeviceContext* deviceContext;
+	std::wstring deviceName;
+	std::wstring name;
+	std::wstring displayName;
+	unsigned int moduleID;
+	bool constructed;
+};
+
 //----------------------------------------------------------------------------------------------------------------------
 struct System::ExportedDeviceInfo
 {
@@ -277,7 +290,7 @@ struct System::InputEventEntry
 {
 	InputEvent inputEvent;
 	KeyCode keyCode;
-	bool sent;
+	std::chrono::steady_clock::time_point hostTime;
 };
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -476,3 +489,17 @@ struct System::EmbeddedROMInfoInternal
 	unsigned int romEntryBitCount;
 	std::wstring filePath;
 };
+
+//----------------------------------------------------------------------------------------------------------------------
+struct System::StateCheckpointEntry
+{
+	StateCheckpointEntry()
+	:device(0), incrementalState(false), stateGeneration(0), stateNode(0)
+	{ }
+
+	IDevice* device;
+	bool incrementalState;
+	unsigned int stateGeneration;
+	std::vector<unsigned char> stateData;
+	IHierarchicalStorageNode* stateNode;
+};
@@ -0,0 +1,531 @@
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+#include "System/DataRemapTable.h"
+#include "System/InputEventQueue.h"
+#include <string>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <algorithm>
+#include <thread>
+
+struct TestMappingElement
+{
+	TestMappingElement(bool forcedBitElement, bool forcedBitValue, unsigned int sourceDataBitNumber)
+	:forcedBitElement(forcedBitElement), forcedBitValue(forcedBitValue), sourceDataBitNumber(sourceDataBitNumber)
+	{ }
+
+	bool forcedBitElement;
+	bool forcedBitValue;
+	unsigned int sourceDataBitNumber;
+};
+
+// This class performs the conversions described by a mapping one bit at a time, with no
+// attempt at optimization, to serve as a reference for the conversion methods selected
+// by DataRemapTable. Mapping elements are listed from the highest converted bit down to
+// the lowest, in the same order as they appear in a mapping string.
+class ReferenceRemapTable
+{
+public:
+	explicit ReferenceRemapTable(const std::vector<TestMappingElement>& elements)
+	:_elements(elements)
+	{ }
+
+	std::wstring BuildMappingString() const
+	{
+		std::wstring mappingString;
+		for (const TestMappingElement& element : _elements)
+		{
+			if (element.forcedBitElement)
+			{
+				mappingString += element.forcedBitValue? L"1": L"0";
+			}
+			else
+			{
+				mappingString += L"[" + std::to_wstring(element.sourceDataBitNumber) + L"]";
+			}
+		}
+		return mappingString;
+	}
+
+	unsigned int ConvertTo(unsigned int sourceData) const
+	{
+		unsigned int result = 0;
+		unsigned int convertedBitNumber = (unsigned int)_elements.size();
+		for (const TestMappingElement& element : _elements)
+		{
+			--convertedBitNumber;
+			bool bitValue = element.forcedBitElement? element.forcedBitValue: (((sourceData >> element.sourceDataBitNumber) & 1) != 0);
+			result |= bitValue? (1u << convertedBitNumber): 0;
+		}
+		return result;
+	}
+
+	unsigned int ConvertFrom(unsigned int sourceData) const
+	{
+		unsigned int result = 0;
+		unsigned int convertedBitNumber = (unsigned int)_elements.size();
+		for (const TestMappingElement& element : _elements)
+		{
+			--convertedBitNumber;
+			if (!element.forcedBitElement && (((sourceData >> convertedBitNumber) & 1) != 0))
+			{
+				result |= (1u << element.sourceDataBitNumber);
+			}
+		}
+		return result;
+	}
+
+private:
+	std::vector<TestMappingElement> _elements;
+};
+
+enum class TestMappingType
+{
+	Contiguous,
+	Segmented,
+	OrderPreserved,
+	Scattered
+};
+
+static std::vector<TestMappingElement> BuildRandomMapping(std::mt19937& generator, TestMappingType mappingType, unsigned int sourceBitCount)
+{
+	// Build a random mapping of the requested type. Contiguous mappings select the
+	// shift and mask method, segmented mappings select the bit segment method, order
+	// preserved mappings select the parallel bit extract method where the host supports it,
+	// and scattered mappings fall back to the byte lookup table method.
+	std::uniform_int_distribution<unsigned int> coinDistribution(0, 1);
+	std::vector<unsigned int> sourceBits;
+	switch (mappingType)
+	{
+	case TestMappingType::Contiguous:{
+		unsigned int firstBit = std::uniform_int_distribution<unsigned int>(0, sourceBitCount - 1)(generator);
+		unsigned int lastBit = std::uniform_int_distribution<unsigned int>(firstBit, sourceBitCount - 1)(generator);
+		for (unsigned int bitNo = firstBit; bitNo <= lastBit; ++bitNo)
+		{
+			sourceBits.push_back(bitNo);
+		}
+		break;}
+	case TestMappingType::Segmented:{
+		// Split the source bits into two to four runs, then reorder the runs.
+		unsigned int segmentCount = std::uniform_int_distribution<unsigned int>(2, 4)(generator);
+		std::vector<unsigned int> boundaries;
+		while (boundaries.size() < (segmentCount - 1))
+		{
+			unsigned int boundary = std::uniform_int_distribution<unsigned int>(1, sourceBitCount - 1)(generator);
+			if (std::find(boundaries.begin(), boundaries.end(), boundary) == boundaries.end())
+			{
+				boundaries.push_back(boundary);
+			}
+		}
+		boundaries.push_back(0);
+		boundaries.push_back(sourceBitCount);
+		std::sort(boundaries.begin(), boundaries.end());
+		std::vector<unsigned int> segmentOrder;
+		for (unsigned int i = 0; i < segmentCount; ++i)
+		{
+			segmentOrder.push_back(i);
+		}
+		while (segmentOrder.size() > 1)
+		{
+			std::shuffle(segmentOrder.begin(), segmentOrder.end(), generator);
+			if (!std::is_sorted(segmentOrder.begin(), segmentOrder.end()))
+			{
+				break;
+			}
+		}
+		for (unsigned int segmentNo : segmentOrder)
+		{
+			for (unsigned int bitNo = boundaries[segmentNo]; bitNo < boundaries[segmentNo + 1]; ++bitNo)
+			{
+				sourceBits.push_back(bitNo);
+			}
+		}
+		break;}
+	case TestMappingType::OrderPreserved:{
+		// Drop every second bit so that the mapped bits form more runs than the bit
+		// segment method supports, then randomly drop some further bits.
+		for (unsigned int bitNo = 0; bitNo < sourceBitCount; bitNo += 2)
+		{
+			if ((bitNo < 10) || (coinDistribution(generator) != 0))
+			{
+				sourceBits.push_back(bitNo);
+			}
+		}
+		break;}
+	case TestMappingType::Scattered:{
+		for (unsigned int bitNo = 0; bitNo < sourceBitCount; ++bitNo)
+		{
+			sourceBits.push_back(bitNo);
+		}
+		std::shuffle(sourceBits.begin(), sourceBits.end(), generator);
+		sourceBits.resize(std::uniform_int_distribution<unsigned int>((sourceBitCount / 2) + 1, sourceBitCount)(generator));
+		break;}
+	}
+
+	// Build the mapping elements from the highest converted bit down, optionally adding
+	// forced bits at the top and bottom of the converted value.
+	std::vector<TestMappingElement> elements;
+	unsigned int maxForcedBitCount = (32 - (unsigned int)sourceBits.size()) / 2;
+	unsigned int forcedTopBitCount = std::uniform_int_distribution<unsigned int>(0, std::min(maxForcedBitCount, 3u))(generator);
+	unsigned int forcedBottomBitCount = std::uniform_int_distribution<unsigned int>(0, std::min(maxForcedBitCount, 3u))(generator);
+	for (unsigned int i = 0; i < forcedTopBitCount; ++i)
+	{
+		elements.push_back(TestMappingElement(true, coinDistribution(generator) != 0, 0));
+	}
+	for (std::vector<unsigned int>::const_reverse_iterator i = sourceBits.rbegin(); i != sourceBits.rend(); ++i)
+	{
+		elements.push_back(TestMappingElement(false, false, *i));
+	}
+	for (unsigned int i = 0; i < forcedBottomBitCount; ++i)
+	{
+		elements.push_back(TestMappingElement(true, coinDistribution(generator) != 0, 0));
+	}
+	return elements;
+}
+
+static void CheckRemapTableAgainstReference(const DataRemapTable& remapTable, const ReferenceRemapTable& reference, unsigned int sourceBitCount, unsigned int convertedBitCount, std::mt19937& generator)
+{
+	unsigned int sourceMask = (sourceBitCount >= 32)? 0xFFFFFFFF: ((1u << sourceBitCount) - 1);
+	unsigned int convertedMask = (convertedBitCount >= 32)? 0xFFFFFFFF: ((1u << convertedBitCount) - 1);
+	std::uniform_int_distribution<unsigned int> valueDistribution(0, 0xFFFFFFFF);
+	std::vector<unsigned int> sourceValues = {0, sourceMask};
+	std::vector<unsigned int> convertedValues = {0, convertedMask};
+	for (unsigned int bitNo = 0; bitNo < 32; ++bitNo)
+	{
+		sourceValues.push_back((1u << bitNo) & sourceMask);
+		convertedValues.push_back((1u << bitNo) & convertedMask);
+	}
+	for (unsigned int i = 0; i < 256; ++i)
+	{
+		sourceValues.push_back(valueDistribution(generator) & sourceMask);
+		convertedValues.push_back(valueDistribution(generator) & convertedMask);
+	}
+	REQUIRE(remapTable.GetBitCountConverted() == convertedBitCount);
+	for (unsigned int sourceValue : sourceValues)
+	{
+		if (remapTable.ConvertTo(sourceValue) != reference.ConvertTo(sourceValue))
+		{
+			CAPTURE(sourceValue);
+			REQUIRE(remapTable.ConvertTo(sourceValue) == reference.ConvertTo(sourceValue));
+		}
+	}
+	for (unsigned int convertedValue : convertedValues)
+	{
+		if (remapTable.ConvertFrom(convertedValue) != reference.ConvertFrom(convertedValue))
+		{
+			CAPTURE(convertedValue);
+			REQUIRE(remapTable.ConvertFrom(convertedValue) == reference.ConvertFrom(convertedValue));
+		}
+	}
+}
+
+TEST_CASE("DataRemapTable conversion methods match a per-bit reference", "")
+{
+	std::mt19937 generator(0xDA7A);
+	const TestMappingType mappingTypes[] = {TestMappingType::Contiguous, TestMappingType::Segmented, TestMappingType::OrderPreserved, TestMappingType::Scattered};
+	const unsigned int sourceBitCounts[] = {8, 16, 24, 32};
+	const bool useConversionTableStates[] = {false, true};
+	for (TestMappingType mappingType : mappingTypes)
+	{
+		for (unsigned int sourceBitCount : sourceBitCounts)
+		{
+			for (bool useConversionTable : useConversionTableStates)
+			{
+				for (unsigned int i = 0; i < 16; ++i)
+				{
+					std::vector<TestMappingElement> elements = BuildRandomMapping(generator, mappingType, sourceBitCount);
+					ReferenceRemapTable reference(elements);
+					std::wstring mappingString = reference.BuildMappingString();
+					CAPTURE((int)mappingType);
+					CAPTURE(sourceBitCount);
+					CAPTURE(useConversionTable);
+					CAPTURE(std::string(mappingString.begin(), mappingString.end()));
+
+					// When conversion tables are requested, limit them to 16 bits, so that
+					// wider mappings also confirm the fallback to the selected method.
+					DataRemapTable remapTable;
+					if (useConversionTable)
+					{
+						remapTable.SetConversionTableState(true, true);
+						remapTable.SetConversionTableMaxBitCount(16, 16);
+					}
+					REQUIRE(remapTable.SetDataMapping(mappingString, sourceBitCount));
+					CheckRemapTableAgainstReference(remapTable, reference, sourceBitCount, (unsigned int)elements.size(), generator);
+				}
+			}
+		}
+	}
+}
+
+TEST_CASE("DataRemapTable mapping string parsing", "")
+{
+	DataRemapTable remapTable;
+
+	SECTION("Forced bits are set in converted values and ignored in original values", "")
+	{
+		REQUIRE(remapTable.SetDataMapping(L"10 [3][2] 01", 4));
+		REQUIRE(remapTable.GetBitCountConverted() == 6);
+		REQUIRE(remapTable.GetBitMaskOriginalLinesPreserved() == 0xC);
+		REQUIRE(remapTable.ConvertTo(0x0) == 0x21);
+		REQUIRE(remapTable.ConvertTo(0xF) == 0x2D);
+		REQUIRE(remapTable.ConvertTo(0x4) == 0x25);
+		REQUIRE(remapTable.ConvertFrom(0x3F) == 0xC);
+		REQUIRE(remapTable.ConvertFrom(0x33) == 0x0);
+	}
+
+	SECTION("Forced bits between mapped bits are handled", "")
+	{
+		REQUIRE(remapTable.SetDataMapping(L"[0]1[1]", 2));
+		REQUIRE(remapTable.GetBitCountConverted() == 3);
+		REQUIRE(remapTable.ConvertTo(0x0) == 0x2);
+		REQUIRE(remapTable.ConvertTo(0x1) == 0x6);
+		REQUIRE(remapTable.ConvertTo(0x2) == 0x3);
+		REQUIRE(remapTable.ConvertFrom(0x7) == 0x3);
+		REQUIRE(remapTable.ConvertFrom(0x2) == 0x0);
+	}
+
+	SECTION("Invalid mapping strings are rejected", "")
+	{
+		REQUIRE(!remapTable.SetDataMapping(L"[16]", 16));
+		REQUIRE(!remapTable.SetDataMapping(L"[3", 8));
+		REQUIRE(!remapTable.SetDataMapping(L"[3]x", 8));
+	}
+}
+
+TEST_CASE("DataRemapTable shipped module line maps", "")
+{
+	// These are the line maps used by the modules in Data\Modules, with the width of the
+	// bus each one is applied to.
+	DataRemapTable remapTable;
+
+	SECTION("Single M68K data line", "")
+	{
+		REQUIRE(remapTable.SetDataMapping(L"[08]", 16));
+		REQUIRE(remapTable.GetBitCountConverted() == 1);
+		REQUIRE(remapTable.ConvertTo(0x0100) == 0x1);
+		REQUIRE(remapTable.ConvertTo(0xFEFF) == 0x0);
+		REQUIRE(remapTable.ConvertFrom(0x1) == 0x0100);
+		REQUIRE(remapTable.ConvertFrom(0x0) == 0x0000);
+	}
+
+	SECTION("Single Z80 data line", "")
+	{
+		REQUIRE(remapTable.SetDataMapping(L"[00]", 8));
+		REQUIRE(remapTable.GetBitCountConverted() == 1);
+		REQUIRE(remapTable.ConvertTo(0xFF) == 0x1);
+		REQUIRE(remapTable.ConvertTo(0xFE) == 0x0);
+		REQUIRE(remapTable.ConvertFrom(0x1) == 0x01);
+	}
+
+	SECTION("Upper M68K data byte", "")
+	{
+		REQUIRE(remapTable.SetDataMapping(L"[15][14][13][12][11][10][09][08]", 16));
+		REQUIRE(remapTable.GetBitCountConverted() == 8);
+		REQUIRE(remapTable.GetBitMaskOriginalLinesPreserved() == 0xFF00);
+		REQUIRE(remapTable.ConvertTo(0x1234) == 0x12);
+		REQUIRE(remapTable.ConvertFrom(0xAB) == 0xAB00);
+	}
+
+	SECTION("Lower M68K data byte", "")
+	{
+		REQUIRE(remapTable.SetDataMapping(L"[07][06][05][04][03][02][01][00]", 16));
+		REQUIRE(remapTable.GetBitCountConverted() == 8);
+		REQUIRE(remapTable.GetBitMaskOriginalLinesPreserved() == 0x00FF);
+		REQUIRE(remapTable.ConvertTo(0x1234) == 0x34);
+		REQUIRE(remapTable.ConvertFrom(0xAB) == 0x00AB);
+	}
+
+	SECTION("Byte swapped M68K data bus", "")
+	{
+		REQUIRE(remapTable.SetDataMapping(L"[07][06][05][04][03][02][01][00][15][14][13][12][11][10][09][08]", 16));
+		REQUIRE(remapTable.GetBitCountConverted() == 16);
+		REQUIRE(remapTable.ConvertTo(0x1234) == 0x3412);
+		REQUIRE(remapTable.ConvertFrom(0x3412) == 0x1234);
+	}
+}
+
+TEST_CASE("DataRemapTable conversion timing", "")
+{
+	// Confirm that each conversion method is no slower than converting the same mapping one
+	// bit at a time. We allow a generous margin here so that scheduling noise can't fail
+	// the test.
+	std::mt19937 generator(0x7133);
+	const TestMappingType mappingTypes[] = {TestMappingType::Contiguous, TestMappingType::Segmented, TestMappingType::OrderPreserved, TestMappingType::Scattered};
+	const unsigned int conversionCount = 0x100000;
+	for (TestMappingType mappingType : mappingTypes)
+	{
+		std::vector<TestMappingElement> elements = BuildRandomMapping(generator, mappingType, 32);
+		ReferenceRemapTable reference(elements);
+		DataRemapTable remapTable;
+		REQUIRE(remapTable.SetDataMapping(reference.BuildMappingString(), 32));
+
+		unsigned int remapTableChecksum = 0;
+		unsigned int referenceChecksum = 0;
+		std::chrono::steady_clock::duration remapTableTime = std::chrono::steady_clock::duration::max();
+		std::chrono::steady_clock::duration referenceTime = std::chrono::steady_clock::duration::max();
+		for (unsigned int pass = 0; pass < 3; ++pass)
+		{
+			std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+			for (unsigned int i = 0; i < conversionCount; ++i)
+			{
+				remapTableChecksum += remapTable.ConvertTo(i * 0x9E3779B9);
+			}
+			std::chrono::steady_clock::time_point midTime = std::chrono::steady_clock::now();
+			for (unsigned int i = 0; i < conversionCount; ++i)
+			{
+				referenceChecksum += reference.ConvertTo(i * 0x9E3779B9);
+			}
+			std::chrono::steady_clock::time_point endTime = std::chrono::steady_clock::now();
+			remapTableTime = std::min(remapTableTime, midTime - startTime);
+			referenceTime = std::min(referenceTime, endTime - midTime);
+		}
+		long long remapTableMicroseconds = std::chrono::duration_cast<std::chrono::microseconds>(remapTableTime).count();
+		long long referenceMicroseconds = std::chrono::duration_cast<std::chrono::microseconds>(referenceTime).count();
+		CAPTURE((int)mappingType);
+		CAPTURE(remapTableMicroseconds);
+		CAPTURE(referenceMicroseconds);
+		REQUIRE(remapTableChecksum == referenceChecksum);
+		REQUIRE(remapTableMicroseconds <= ((referenceMicroseconds * 2) + 1000));
+	}
+}
+
+struct TestInputEventEntry
+{
+	unsigned int producerNo;
+	unsigned int eventNo;
+};
+
+TEST_CASE("InputEventQueue preserves the order of each producer's events", "")
+{
+	const unsigned int producerCount = 4;
+	const unsigned int eventsPerProducer = 20000;
+
+	// Write events from several threads at once, retrying any write which fails because the
+	// ring is full, while reading and releasing events on this thread.
+	InputEventQueue<TestInputEventEntry> queue;
+	std::vector<std::thread> producers;
+	for (unsigned int producerNo = 0; producerNo < producerCount; ++producerNo)
+	{
+		producers.push_back(std::thread([&queue, producerNo]()
+		{
+			for (unsigned int eventNo = 0; eventNo < eventsPerProducer; ++eventNo)
+			{
+				TestInputEventEntry entry;
+				entry.producerNo = producerNo;
+				entry.eventNo = eventNo;
+				while (!queue.WriteEntry(entry))
+				{
+					std::this_thread::yield();
+				}
+			}
+		}));
+	}
+
+	// Verify every event is received exactly once, and that the events from each producer
+	// are received in the order they were written.
+	std::vector<unsigned int> nextEventNo(producerCount, 0);
+	unsigned int receivedEventCount = 0;
+	unsigned int mismatchCount = 0;
+	while (receivedEventCount < (producerCount * eventsPerProducer))
+	{
+		unsigned int readableEntryCount = queue.GetReadableEntryCount();
+		for (unsigned int i = 0; i < readableEntryCount; ++i)
+		{
+			const TestInputEventEntry& entry = queue.GetEntry(i);
+			if ((entry.producerNo >= producerCount) || (entry.eventNo != nextEventNo[entry.producerNo]))
+			{
+				++mismatchCount;
+				continue;
+			}
+			++nextEventNo[entry.producerNo];
+		}
+		queue.ReleaseEntries(readableEntryCount);
+		receivedEventCount += readableEntryCount;
+	}
+	for (unsigned int producerNo = 0; producerNo < producerCount; ++producerNo)
+	{
+		producers[producerNo].join();
+	}
+	REQUIRE(mismatchCount == 0);
+	REQUIRE(queue.Empty());
+	for (unsigned int producerNo = 0; producerNo < producerCount; ++producerNo)
+	{
+		REQUIRE(nextEventNo[producerNo] == eventsPerProducer);
+	}
+}
+
+TEST_CASE("InputEventQueue rejects writes when the ring is full", "")
+{
+	// Fill the ring, and verify the next write fails without disturbing the stored events
+	InputEventQueue<TestInputEventEntry> queue;
+	const unsigned int entryCapacity = InputEventQueue<TestInputEventEntry>::GetEntryCapacity();
+	TestInputEventEntry entry;
+	entry.producerNo = 0;
+	for (unsigned int eventNo = 0; eventNo < entryCapacity; ++eventNo)
+	{
+		entry.eventNo = eventNo;
+		REQUIRE(queue.WriteEntry(entry));
+	}
+	entry.eventNo = entryCapacity;
+	REQUIRE(!queue.WriteEntry(entry));
+	REQUIRE(queue.GetReadableEntryCount() == entryCapacity);
+	REQUIRE(queue.GetEntry(0).eventNo == 0);
+	REQUIRE(queue.GetEntry(entryCapacity - 1).eventNo == (entryCapacity - 1));
+
+	// Release a single entry, and verify exactly one more write is accepted
+	queue.ReleaseEntries(1);
+	REQUIRE(queue.WriteEntry(entry));
+	REQUIRE(!queue.WriteEntry(entry));
+	REQUIRE(queue.GetReadableEntryCount() == entryCapacity);
+	REQUIRE(queue.GetEntry(0).eventNo == 1);
+	REQUIRE(queue.GetEntry(entryCapacity - 1).eventNo == entryCapacity);
+}
+
+TEST_CASE("InputEventQueue keeps events readable until they are released", "")
+{
+	InputEventQueue<TestInputEventEntry> queue;
+	REQUIRE(queue.Empty());
+	TestInputEventEntry entry;
+	entry.producerNo = 0;
+	for (unsigned int eventNo = 0; eventNo < 3; ++eventNo)
+	{
+		entry.eventNo = eventNo;
+		REQUIRE(queue.WriteEntry(entry));
+	}
+
+	// Reading events doesn't consume them, so a rolled back timeslice can deliver the same
+	// events again.
+	for (unsigned int pass = 0; pass < 2; ++pass)
+	{
+		REQUIRE(!queue.Empty());
+		REQUIRE(queue.GetReadableEntryCount() == 3);
+		for (unsigned int i = 0; i < 3; ++i)
+		{
+			REQUIRE(queue.GetEntry(i).eventNo == i);
+		}
+	}
+
+	// Releasing events once the timeslice is committed makes the following events readable
+	// from the front of the queue.
+	queue.ReleaseEntries(2);
+	REQUIRE(!queue.Empty());
+	REQUIRE(queue.GetReadableEntryCount() == 1);
+	REQUIRE(queue.GetEntry(0).eventNo == 2);
+	queue.ReleaseEntries(1);
+	REQUIRE(queue.Empty());
+	REQUIRE(queue.GetReadableEntryCount() == 0);
+
+	// Write enough events to wrap around the ring several times, and verify they're read
+	// back in order.
+	const unsigned int entryCapacity = InputEventQueue<TestInputEventEntry>::GetEntryCapacity();
+	for (unsigned int eventNo = 0; eventNo < (entryCapacity * 3); ++eventNo)
+	{
+		entry.eventNo = eventNo;
+		REQUIRE(queue.WriteEntry(entry));
+		REQUIRE(queue.GetReadableEntryCount() == 1);
+		REQUIRE(queue.GetEntry(0).eventNo == eventNo);
+		queue.ReleaseEntries(1);
+	}
+	REQUIRE(queue.Empty());
+}